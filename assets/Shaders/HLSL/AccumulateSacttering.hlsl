@@ -23,10 +23,17 @@ RWTexture3D<ShadingConvention::VolumetricLight::FrustumVolumeMapFormat> gio_Frus
 void CS(in uint3 DTid : SV_DispatchThreadID) {
 	uint3 dims;
 	gio_FrustumVolumeMap.GetDimensions(dims.x, dims.y, dims.z);
-	if (any(DTid >= dims)) return;
+	
+	// Only the columns scattered this frame are accumulated.
+	uint2 column = DTid.xy;
+	if (gCheckerboardEnabled) {
+		const bool IsEvenRow = (DTid.y & 1) == 0;
+		column.x = DTid.x * 2 + (IsEvenRow != gEvenColumnsActivated);
+	}
+	if (any(column >= dims.xy)) return;
 
 	float4 accum = float4(0.f, 0.f, 0.f, 1.f);
-	uint3 pos = uint3(DTid.xy, 0.f);
+	uint3 pos = uint3(column, 0.f);
 
 	[loop]
 	for (uint z = 0; z < dims.z; ++z) {
@@ -15,7 +15,7 @@
 Texture2D<ShadingConvention::ToneMapping::IntermediateMapFormat>	gi_BackBuffer	: register(t0);
 Texture2D<ShadingConvention::Bloom::HighlightMapFormat>				gi_BloomMap		: register(t1);
 
-Bloom_ExtractHighlights_RootConstants(b0)
+Bloom_ApplyBloom_RootConstants(b0)
 
 FitToScreenVertexOut
 
@@ -35,8 +35,10 @@ float3 ToneAwareBloom(in float3 hdr, in float3 bloom) {
 }
 
 ShadingConvention::ToneMapping::IntermediateMapFormat PS(VertexOut pin) : SV_TARGET {
-    const float3 Scene = gi_BackBuffer.SampleLevel(gsamLinearClamp, pin.TexC, 0).rgb;
-	const float3 Bloom = gi_BloomMap.SampleLevel(gsamLinearClamp, pin.TexC, 0).rgb;
+	const float2 TexC = pin.TexC * gUVScale;
+
+    const float3 Scene = gi_BackBuffer.SampleLevel(gsamLinearClamp, TexC, 0).rgb;
+	const float3 Bloom = gi_BloomMap.SampleLevel(gsamLinearClamp, TexC, 0).rgb;
 	
 	const float3 Color = SoftAddBloom(Scene, Bloom);
 	
@@ -35,7 +35,7 @@ PixelOut PS(VertexOut pin) {
 	uint3 dims;
 	gi_FrustumVolumeMap.GetDimensions(dims.x, dims.y, dims.z);
 
-	const float4 PosW = gi_PositionMap.SampleLevel(gsamLinearClamp, pin.TexC, 0);
+	const float4 PosW = gi_PositionMap.SampleLevel(gsamLinearClamp, pin.TexC * cbPass.UVScale, 0);
 	
 	float4 posV = mul(PosW, cbPass.View);
 	if (!ShadingConvention::GBuffer::IsValidPosition(PosW)) posV.z = dims.z - 1;
@@ -120,6 +120,21 @@ float3 ImportanceSampleGGX(in float2 Xi, in float3 N, in float roughness) {
     return normalize(sampleVec);
 }
 
+// Evaluates the order-2 irradiance coefficients baked by EnvironmentBaker.
+// They are already convolved with the cosine lobe and divided by PI.
+float3 EvaluateIrradianceSH(in float4 coeffs[9], in float3 n) {
+    float3 irradiance = coeffs[0].rgb * 0.282095f;
+    irradiance += coeffs[1].rgb * (0.488603f * n.y);
+    irradiance += coeffs[2].rgb * (0.488603f * n.z);
+    irradiance += coeffs[3].rgb * (0.488603f * n.x);
+    irradiance += coeffs[4].rgb * (1.092548f * n.x * n.y);
+    irradiance += coeffs[5].rgb * (1.092548f * n.y * n.z);
+    irradiance += coeffs[6].rgb * (0.315392f * (3.f * n.z * n.z - 1.f));
+    irradiance += coeffs[7].rgb * (1.092548f * n.x * n.z);
+    irradiance += coeffs[8].rgb * (0.546274f * (n.x * n.x - n.y * n.y));
+    return max(irradiance, 0.f);
+}
+
 #include "./../../../assets/Shaders/HLSL/BlinnPhong.hlsli"
 #include "./../../../assets/Shaders/HLSL/CookTorrance.hlsli"
 
@@ -0,0 +1,131 @@
+// [ Descriptions ]
+//  Brings a half-resolution map back to full resolution.
+//  Low-resolution texel i holds the value evaluated at full-resolution pixel 2i,
+//  so the four nearest values are weighted bilinearly and by how well the depth
+//  and normal at their source pixels agree with the target pixel.
+
+#ifndef __BILATERALUPSAMPLE_HLSL__
+#define __BILATERALUPSAMPLE_HLSL__
+
+#ifndef _HLSL
+#define _HLSL
+#endif
+
+#ifndef ValueType
+#define ValueType float
+#endif
+
+#include "./../../../inc/Render/DX/Foundation/HlslCompaction.h"
+#include "./../../../assets/Shaders/HLSL/Samplers.hlsli"
+#include "./../../../assets/Shaders/HLSL/ValuePackaging.hlsli"
+#include "./../../../assets/Shaders/HLSL/CrossBilateralWeights.hlsli"
+
+BlurFilter_BilateralUpsample_RootConstants(b0)
+
+Texture2D<ShadingConvention::GBuffer::NormalDepthMapFormat> gi_NormalDepthMap : register(t0);
+Texture2D<ValueType>                                        gi_InputMap       : register(t1);
+RWTexture2D<ValueType>                                      go_OutputMap      : register(u0);
+
+float LoadDepth(in int2 index) {
+    float depth;
+    ValuePackaging::DecodeDepth(gi_NormalDepthMap[clamp(index, 0, int2(gTexDim) - 1)], depth);
+    
+    return depth;
+}
+
+[numthreads(
+    ShadingConvention::BlurFilter::ThreadGroup::Default::Width,
+    ShadingConvention::BlurFilter::ThreadGroup::Default::Height,
+    ShadingConvention::BlurFilter::ThreadGroup::Default::Depth)]
+void CS(in uint2 DTid : SV_DispatchThreadID) {
+    if (!ShaderUtil::IsWithinBounds(DTid, gTexDim)) return;
+    
+    const uint2 TopLeftIndex = min(DTid >> 1, gLowResTexDim - 1);
+    
+    // Pixels off the geometry keep whatever their quad holds.
+    const uint NormalDepth = gi_NormalDepthMap[DTid];
+    if (!ShadingConvention::GBuffer::IsValidNormalDepth(NormalDepth)) {
+        go_OutputMap[DTid] = gi_InputMap[TopLeftIndex];
+        return;
+    }
+    
+    float3 normal;
+    float depth;
+    ValuePackaging::DecodeNormalDepth(NormalDepth, normal, depth);
+    
+    const uint2 SrcIndexOffsets[4] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } };
+    
+    uint2 srcIndices[4];
+    float3 sampleNormals[4];
+    float4 sampleDepths = 0.f;
+    bool4 isValid = false;
+    
+    [unroll]
+    for (uint i = 0; i < 4; ++i) {
+        srcIndices[i] = min(TopLeftIndex + SrcIndexOffsets[i], gLowResTexDim - 1);
+        
+        const uint SampleNormalDepth = gi_NormalDepthMap[min(srcIndices[i] * 2, gTexDim - 1)];
+        isValid[i] = ShadingConvention::GBuffer::IsValidNormalDepth(SampleNormalDepth);
+        
+        ValuePackaging::DecodeNormalDepth(SampleNormalDepth, sampleNormals[i], sampleDepths[i]);
+    }
+    
+    // Partial depth derivatives as the smaller of the backward and forward
+    // differences, the way the denoiser derives them.
+    const int2 Index = DTid;
+    const float2 BackwardDiff = depth - float2(LoadDepth(Index + int2(-1, 0)), LoadDepth(Index + int2(0, -1)));
+    const float2 ForwardDiff = float2(LoadDepth(Index + int2(1, 0)), LoadDepth(Index + int2(0, 1))) - depth;
+    
+    const float2 Ddx = float2(BackwardDiff.x, ForwardDiff.x);
+    const float2 Ddy = float2(BackwardDiff.y, ForwardDiff.y);
+    
+    float2 ddxy = float2(
+        Ddx[SVGF::GetIndexOfValueClosestToReference(0, Ddx)],
+        Ddy[SVGF::GetIndexOfValueClosestToReference(0, Ddy)]);
+    ddxy = sign(ddxy) * min(abs(ddxy), 1.f);
+    
+    CrossBilateral::BilinearDepthNormal::Parameters params;
+    params.Depth.Sigma = gDepthSigma;
+    params.Depth.WeightCutoff = 0.2f;
+    params.Depth.NumMantissaBits = gDepthNumMantissaBits;
+    params.Normal.Sigma = 1.1f;
+    params.Normal.SigmaExponent = 32;
+    
+    // Evaluated pixels sit two pixels apart.
+    const float2 TargetOffset = (DTid & 1) * 0.5f;
+    
+    float4 weights = CrossBilateral::BilinearDepthNormal::GetWeights(
+        depth,
+        normal,
+        TargetOffset,
+        ddxy,
+        sampleDepths,
+        sampleNormals,
+        2.f,
+        params);
+    weights = select(isValid, weights, 0.f);
+    
+    const float WeightSum = dot(1, weights);
+    
+    ValueType result;
+    if (WeightSum > 1e-3f) {
+        result = (ValueType)0.f;
+        
+        [unroll]
+        for (uint i = 0; i < 4; ++i) 
+            result += weights[i] * gi_InputMap[srcIndices[i]];
+        
+        result /= WeightSum;
+    }
+    else {
+        // No sample agrees with the target, so the closest one in depth stands in.
+        const float4 CandidateDepths = select(isValid, sampleDepths, 1e9f);
+        const uint Nearest = SVGF::GetIndexOfValueClosestToReference(depth, CandidateDepths);
+        
+        result = gi_InputMap[srcIndices[Nearest]];
+    }
+    
+    go_OutputMap[DTid] = result;
+}
+
+#endif // __BILATERALUPSAMPLE_HLSL__
\ No newline at end of file
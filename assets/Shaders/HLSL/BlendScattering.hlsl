@@ -8,6 +8,8 @@
 #include "./../../../inc/Render/DX/Foundation/HlslCompaction.h"
 #include "./../../../assets/Shaders/HLSL/Samplers.hlsli"
 
+VolumetricLight_BlendScattering_RootConstants(b0)
+
 Texture3D<ShadingConvention::VolumetricLight::FrustumVolumeMapFormat> gi_PreviousFrame : register(t0);
 
 RWTexture3D<ShadingConvention::VolumetricLight::FrustumVolumeMapFormat> gio_CurrentFrame : register(u0);
@@ -23,8 +25,19 @@ float4 ClampToNeighborhood(in float4 prev, in float4 curr, in float k) {
 	ShadingConvention::VolumetricLight::ThreadGroup::BlendScattering::Height, 
 	ShadingConvention::VolumetricLight::ThreadGroup::BlendScattering::Depth)]
 void CS(in uint3 DTid : SV_DispatchThreadId) {
-	const float4 CurrScattering = gio_CurrentFrame[DTid];	
 	float4 prevScattering = gi_PreviousFrame[DTid];
+	
+	// Columns skipped this frame keep the last frame's result.
+	if (gCheckerboardEnabled) {
+		const bool IsEvenRow = (DTid.y & 1) == 0;
+		const bool IsEvenColumn = (DTid.x & 1) == 0;
+		if (IsEvenColumn != (IsEvenRow == gEvenColumnsActivated)) {
+			gio_CurrentFrame[DTid] = prevScattering;
+			return;
+		}
+	}
+	
+	const float4 CurrScattering = gio_CurrentFrame[DTid];
 																																																																							
 	const float4 Delta = abs(CurrScattering - prevScattering);
 	
@@ -28,14 +28,17 @@ HDR_FORMAT PS(VertexOut pin) : SV_TARGET {
     const float dx = gBokehRadius * gInvTexDim.x;
     const float dy = gBokehRadius * gInvTexDim.y;
 
-	const float3 CenterColor = gi_BackBuffer.SampleLevel(gsamLinearClamp, pin.TexC, 0).rgb;
+	const float2 TexC = pin.TexC * gUVScale;
+	const float2 MaxTexC = gUVScale - 0.5f * gInvTexDim;
 
-    const float CenterCoC = abs(gi_CoCMap.SampleLevel(gsamLinearClamp, pin.TexC, 0));
+	const float3 CenterColor = gi_BackBuffer.SampleLevel(gsamLinearClamp, TexC, 0).rgb;
+
+    const float CenterCoC = abs(gi_CoCMap.SampleLevel(gsamLinearClamp, TexC, 0));
 	const uint BlurRadius = round(gSampleCount * CenterCoC);
 	if (BlurRadius < 1) return float4(CenterColor, 1.f);
 
 	float3 poweredSum = pow(CenterColor, gHighlightPower.xxx);
-	float3 colorSum = gi_BackBuffer.SampleLevel(gsamLinearClamp, pin.TexC, 0).rgb * poweredSum;
+	float3 colorSum = gi_BackBuffer.SampleLevel(gsamLinearClamp, TexC, 0).rgb * poweredSum;
 	[loop]
 	for (int i = -gSampleCount; i <= gSampleCount; ++i) {
 		[loop]
@@ -43,7 +46,7 @@ HDR_FORMAT PS(VertexOut pin) : SV_TARGET {
 			const float Radius = sqrt(i * i + j * j);
 			if ((i == 0 && j == 0) || Radius > BlurRadius) continue;
 
-			const float2 texc = pin.TexC + float2(i * dx, j * dy);
+			const float2 texc = clamp(TexC + float2(i * dx, j * dy), 0.f, MaxTexC);
 			const float NeighborCoC = abs(gi_CoCMap.SampleLevel(gsamLinearClamp, texc, 0));
 			if (NeighborCoC < gThreshold) continue;
 
@@ -42,7 +42,7 @@ void AddFilterContribution(
         in float2 uv,
         in float2 ddxy,
         in int2 offset) {
-    const float2 TexC = uv + ddxy * offset;
+    const float2 TexC = min(uv + ddxy * offset, gUVScale - 0.5f * gInvTexDim);
 
     if (all(TexC >= 0.f) && all(TexC <= gTexDim)) {
         const float2 d = float2(offset);
@@ -60,9 +60,11 @@ HDR_FORMAT PS(VertexOut pin) : SV_TARGET {
     float weightSum = 0.f;
     float3 weightedValueSum = (float3)0;
     
-    const float3 Center = gi_InputMap.SampleLevel(gsamLinearClamp, pin.TexC, 0).rgb;
+    const float2 TexC = pin.TexC * gUVScale;
     
-    const float CoC = gi_CoCMap.SampleLevel(gsamLinearClamp, pin.TexC, 0);
+    const float3 Center = gi_InputMap.SampleLevel(gsamLinearClamp, TexC, 0).rgb;
+    
+    const float CoC = gi_CoCMap.SampleLevel(gsamLinearClamp, TexC, 0);
     if (abs(CoC) < 0.08f) return float4(Center, 1.f);
 
     [unroll]
@@ -70,7 +72,7 @@ HDR_FORMAT PS(VertexOut pin) : SV_TARGET {
         [unroll]
         for (int x = -3; x <= 3; ++x) {
             AddFilterContribution(
-                weightedValueSum, weightSum, pin.TexC, gInvTexDim, int2(x, y));
+                weightedValueSum, weightSum, TexC, gInvTexDim, int2(x, y));
         }
     }
     
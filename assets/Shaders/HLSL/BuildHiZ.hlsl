@@ -0,0 +1,54 @@
+#ifndef __BUILDHIZ_HLSL__
+#define __BUILDHIZ_HLSL__
+
+#ifndef _HLSL
+#define _HLSL
+#endif
+
+#include "./../../../inc/Render/DX/Foundation/HlslCompaction.h"
+
+GpuCulling_BuildHiZ_RootConstants(b0)
+
+Texture2D<ShadingConvention::DepthStencilBuffer::DepthBufferFormat> gi_DepthMap : register(t0);
+
+RWTexture2D<ShadingConvention::GpuCulling::HiZMapFormat> gi_SrcMip : register(u0);
+RWTexture2D<ShadingConvention::GpuCulling::HiZMapFormat> go_DstMip : register(u1);
+
+[numthreads(
+    ShadingConvention::GpuCulling::ThreadGroup::BuildHiZ::Width,
+    ShadingConvention::GpuCulling::ThreadGroup::BuildHiZ::Height,
+    ShadingConvention::GpuCulling::ThreadGroup::BuildHiZ::Depth)]
+void CS_CopyDepth(in uint2 DTid : SV_DispatchThreadID) {
+    if (any(DTid >= gDstTexDim)) return;
+
+    go_DstMip[DTid] = gi_DepthMap.Load(uint3(DTid, 0));
+}
+
+// Keeps the farthest depth under each texel. The last row or column of an
+// odd-sized source folds into the last destination texel, so no depth is
+// dropped and the pyramid stays conservative.
+[numthreads(
+    ShadingConvention::GpuCulling::ThreadGroup::BuildHiZ::Width,
+    ShadingConvention::GpuCulling::ThreadGroup::BuildHiZ::Height,
+    ShadingConvention::GpuCulling::ThreadGroup::BuildHiZ::Depth)]
+void CS_Downsample(in uint2 DTid : SV_DispatchThreadID) {
+    if (any(DTid >= gDstTexDim)) return;
+
+    const uint2 Begin = DTid * 2;
+    const uint2 Last = gSrcTexDim - 1;
+
+    uint2 end = min(Begin + 1, Last);
+    if (DTid.x == gDstTexDim.x - 1) end.x = Last.x;
+    if (DTid.y == gDstTexDim.y - 1) end.y = Last.y;
+
+    float depth = 0.f;
+
+    for (uint y = Begin.y; y <= end.y; ++y) {
+        for (uint x = Begin.x; x <= end.x; ++x)
+            depth = max(depth, gi_SrcMip[uint2(x, y)]);
+    }
+
+    go_DstMip[DTid] = depth;
+}
+
+#endif // __BUILDHIZ_HLSL__
\ No newline at end of file
@@ -24,7 +24,8 @@ void CS(in uint2 DTid : SV_DispatchThreadID) {
     uint2 size;
     gi_PositionMap.GetDimensions(size.x, size.y);
     
-    const uint2 HalfSize = size * 0.5f;
+    // Focuses on the centre of the area rendered into.
+    const uint2 HalfSize = size * cbPass.UVScale * 0.5f;
     const uint2 Index = HalfSize + (DTid - 4);
     
     const float4 PosW = gi_PositionMap[Index];
@@ -17,8 +17,7 @@ ConstantBuffer<ConstantBuffers::LightCB> cbLight	: register(b1);
 
 VolumetricLight_CalculateScatteringAndDensity_RootConstants(b2)
 
-Texture2D<ShadingConvention::Shadow::ZDepthMapFormat>				    gi_ZDepthMaps[MaxLights]		: register(t0);
-Texture2DArray<ShadingConvention::Shadow::ZDepthMapFormat>			    gi_ZDepthCubeMaps[MaxLights]	: register(t0, space1);
+Texture2D<ShadingConvention::Shadow::ZDepthMapFormat>				    gi_ZDepthAtlas				    : register(t0);
 
 RWTexture3D<ShadingConvention::VolumetricLight::FrustumVolumeMapFormat>	go_FrustumVolumeMap			    : register(u0);
 
@@ -29,13 +28,21 @@ RWTexture3D<ShadingConvention::VolumetricLight::FrustumVolumeMapFormat>	go_Frust
 void CS(in uint3 DTid : SV_DispatchThreadId) {
 	uint3 dims;
 	go_FrustumVolumeMap.GetDimensions(dims.x, dims.y, dims.z);
-	if (any(DTid >= dims)) return;
 	
-	const uint Idx = Random::Hash3D(DTid) + gFrameCount;
+	// On checkerboard every other froxel column is evaluated, alternating
+	// each frame.
+	uint3 froxel = DTid;
+	if (gCheckerboardEnabled) {
+		const bool IsEvenRow = (DTid.y & 1) == 0;
+		froxel.x = DTid.x * 2 + (IsEvenRow != gEvenColumnsActivated);
+	}
+	if (any(froxel >= dims)) return;
+	
+	const uint Idx = Random::Hash3D(froxel) + gFrameCount;
 	const float Jitter = Random::HaltonSequence[Idx % MAX_HALTON_SEQUENCE].z - 0.5f;
 
 	const float3 PosW = ShaderUtil::ThreadIdToWorldPosition(
-		float3((float2)DTid.xy, (float)DTid.z + Jitter), 
+		float3((float2)froxel.xy, (float)froxel.z + Jitter), 
 			dims, gDepthExponent, gNearZ, gFarZ, cbPass.InvView, cbPass.InvProj);
 	const float3 ToEyeW = normalize(cbPass.EyePosW - PosW);
 
@@ -70,12 +77,26 @@ void CS(in uint3 DTid : SV_DispatchThreadId) {
 			
 			const float4x4 ViewProj = Shadow::GetViewProjMatrix(light, Index);
 			
-			if (any(ViewProj != 0.f)) visibility = Shadow::CalcShadowFactorCube(gi_ZDepthCubeMaps[i], gsamShadow, ViewProj, PosW.xyz, UV, Index);
+			if (any(ViewProj != 0.f)) 
+				visibility = Shadow::CalcShadowFactorCube(
+					gi_ZDepthAtlas, gsamShadow, ViewProj, PosW.xyz, UV, 
+					cbLight.ShadowPages[i * ShadingConvention::Shadow::MaxFaceCount + Index]);
 
 			falloff = CalcInverseSquareAttenuation(Ld, light.AttenuationRadius);
 		}
-		else if (light.Type == Common::Foundation::LightType::E_Directional || light.Type == Common::Foundation::LightType::E_Spot) {			
-			visibility = Shadow::CalcShadowFactor(gi_ZDepthMaps[i], gsamShadow, light.Mat1, PosW);
+		else if (light.Type == Common::Foundation::LightType::E_Directional) {
+			float2 uv;
+			const uint Cascade = Shadow::FindCascade(light, PosW, ShadingConvention::Shadow::CascadeCount, uv);
+			
+			if (Cascade < ShadingConvention::Shadow::CascadeCount) 
+				visibility = Shadow::CalcShadowFactorCube(
+					gi_ZDepthAtlas, gsamShadow, Shadow::GetViewProjMatrix(light, Cascade), PosW, uv, 
+					cbLight.ShadowPages[i * ShadingConvention::Shadow::MaxFaceCount + Cascade]);
+		}
+		else if (light.Type == Common::Foundation::LightType::E_Spot) {			
+			visibility = Shadow::CalcShadowFactor(
+				gi_ZDepthAtlas, gsamShadow, light.Mat1, PosW, 
+				cbLight.ShadowPages[i * ShadingConvention::Shadow::MaxFaceCount]);
 		}
 
 		const float PhaseFunction = VolumetricLight::HenyeyGreensteinPhaseFunction(direction, ToEyeW, gAnisotropicCoefficient);
@@ -83,7 +104,7 @@ void CS(in uint3 DTid : SV_DispatchThreadId) {
 		Li += visibility * light.Color * light.Intensity * falloff * PhaseFunction;
 	}
 	
-	go_FrustumVolumeMap[DTid] = float4(Li * gUniformDensity, gUniformDensity);
+	go_FrustumVolumeMap[froxel] = float4(Li * gUniformDensity, gUniformDensity);
 }
 
 #endif // __CALCULATESCATTERINGANDDENSITY_HLSL__
\ No newline at end of file
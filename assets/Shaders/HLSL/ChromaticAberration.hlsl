@@ -43,12 +43,15 @@ HDR_FORMAT PS(in VertexOut pin) : SV_Target {
     const float ShiftPixel = gMaxShiftPx * gStrength * mask;
     const float2 ShiftTexC = ShiftPixel * gInvTexDim * Direction;
 
-    // Sampler per channel
-    const float3 Scene = gi_BackBuffer.Sample(gsamLinearClamp, pin.TexC).rgb;
+    // Sampler per channel, within the area rendered into
+    const float2 TexC = pin.TexC * gUVScale;
+    const float2 MaxTexC = gUVScale - 0.5f * gInvTexDim;
+
+    const float3 Scene = gi_BackBuffer.Sample(gsamLinearClamp, TexC).rgb;
     
-    const float rC = gi_BackBuffer.Sample(gsamLinearClamp, pin.TexC + ShiftTexC).r; // Outward
-    const float gC = Scene.g;                                                       // Stable
-    const float bC = gi_BackBuffer.Sample(gsamLinearClamp, pin.TexC - ShiftTexC).b; // Inward
+    const float rC = gi_BackBuffer.Sample(gsamLinearClamp, min(TexC + ShiftTexC, MaxTexC)).r; // Outward
+    const float gC = Scene.g;                                                                 // Stable
+    const float bC = gi_BackBuffer.Sample(gsamLinearClamp, min(TexC - ShiftTexC, MaxTexC)).b; // Inward
 
     return float4(rC, gC, bC, 1.f);
 }
@@ -27,19 +27,55 @@ Texture2D<ShadingConvention::GBuffer::RoughnessMetalnessMapFormat>  gi_Roughness
 Texture2D<ShadingConvention::GBuffer::PositionMapFormat>            gi_PositionMap           : register(t5);
 Texture2D<ShadingConvention::Shadow::ShadowMapFormat>               gi_ShadowMap             : register(t6);
 
+StructuredBuffer<Common::Foundation::Light>                 gi_ClusteredLights     : register(t7);
+StructuredBuffer<ShadingConvention::LightCluster::Cluster>  gi_LightClusters       : register(t8);
+StructuredBuffer<uint>                                      gi_ClusterLightIndices : register(t9);
+
 FitToScreenVertexOut
 
 FitToScreenVertexShader
 
 FitToScreenMeshShader
 
+float3 ComputeClusteredLights(in Material mat, in float3 posW, in float3 normalW, in float3 viewW, in float2 texc) {
+    const float DepthV = max(mul(float4(posW, 1.f), cbPass.View).z, 1e-4f);
+    
+    const uint2 Tile = min(
+        (uint2)(texc * float2(ShadingConvention::LightCluster::ClusterCountX, ShadingConvention::LightCluster::ClusterCountY)),
+        uint2(ShadingConvention::LightCluster::ClusterCountX - 1, ShadingConvention::LightCluster::ClusterCountY - 1));
+    const uint Slice = (uint)clamp(
+        floor(log2(DepthV) * cbLight.ClusterDepthScale + cbLight.ClusterDepthBias), 
+        0.f, ShadingConvention::LightCluster::ClusterCountZ - 1);
+    
+    const ShadingConvention::LightCluster::Cluster Cluster = gi_LightClusters[
+        (Slice * ShadingConvention::LightCluster::ClusterCountY + Tile.y) * ShadingConvention::LightCluster::ClusterCountX + Tile.x];
+    
+    float3 result = 0;
+    
+    [loop]
+    for (uint i = 0; i < Cluster.Count; ++i) {
+        const Common::Foundation::Light light = gi_ClusteredLights[gi_ClusterLightIndices[Cluster.Offset + i]];
+        
+        if (light.Type == Common::Foundation::LightType_Point)
+            result += ComputePointLight(light, mat, posW, normalW, viewW);
+        else if (light.Type == Common::Foundation::LightType_Spot)
+            result += ComputeSpotLight(light, mat, posW, normalW, viewW);
+    }
+    
+    return result;
+}
+
 HDR_FORMAT PS(in VertexOut pin) : SV_Target {
-    const float4 Albedo = gi_AlbedoMap.Sample(gsamLinearClamp, pin.TexC);
+    // The GBuffer fills only the area rendered into; shadows and clusters
+    // stay indexed by the viewport.
+    const float2 TexC = pin.TexC * cbPass.UVScale;
+
+    const float4 Albedo = gi_AlbedoMap.Sample(gsamLinearClamp, TexC);
     if (Albedo.a < 1e-6f) return (float4)0;
                                                                                                                                                                                                                                                                             
-    const float4 PosW = gi_PositionMap.Sample(gsamLinearClamp, pin.TexC);    	
-    const float3 Specular = gi_SpecularMap.Sample(gsamLinearClamp, pin.TexC).rgb;
-    const float2 RoughnessMetalness = gi_RoughnessMetalnessMap.Sample(gsamLinearClamp, pin.TexC);
+    const float4 PosW = gi_PositionMap.Sample(gsamLinearClamp, TexC);    	
+    const float3 Specular = gi_SpecularMap.Sample(gsamLinearClamp, TexC).rgb;
+    const float2 RoughnessMetalness = gi_RoughnessMetalnessMap.Sample(gsamLinearClamp, TexC);
     
     const float Roughness = RoughnessMetalness.r;
     const float Metalness = RoughnessMetalness.g;
@@ -59,12 +95,14 @@ HDR_FORMAT PS(in VertexOut pin) : SV_Target {
             gi_ShadowMap, gTexDim, pin.TexC, cbLight.LightCount, shadowFactors);
     }
 
-    const float3 NormalW = normalize(gi_NormalMap.Sample(gsamLinearClamp, pin.TexC).xyz);
+    const float3 NormalW = normalize(gi_NormalMap.Sample(gsamLinearClamp, TexC).xyz);
 
     const float3 ViewW = normalize(cbPass.EyePosW - PosW.xyz);
-    const float3 Radiance = ComputeBRDF(cbLight.Lights, mat, PosW.xyz, NormalW, ViewW, shadowFactors, cbLight.LightCount);
+    float3 radiance = ComputeBRDF(cbLight.Lights, mat, PosW.xyz, NormalW, ViewW, shadowFactors, cbLight.LightCount);
+    if (cbLight.ClusteredLightCount > 0) 
+        radiance += ComputeClusteredLights(mat, PosW.xyz, NormalW, ViewW, pin.TexC);
         
-    return float4(Radiance, 1.f);
+    return float4(radiance, 1.f);
 }
 
 #endif // __COMPUTEBRDF_HLSL__
\ No newline at end of file
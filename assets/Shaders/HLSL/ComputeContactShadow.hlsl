@@ -71,7 +71,7 @@ void CS(in uint2 DTid : SV_DispatchThreadID) {
             rayTexC.y = 1.f - rayTexC.y;
             
             if (any(rayTexC < 0.f) || any(rayTexC > 1.f)) break;
-            const float ZSampleDepth = gi_DepthMap.SampleLevel(gsamLinearClamp, rayTexC, 0);
+            const float ZSampleDepth = gi_DepthMap.SampleLevel(gsamLinearClamp, rayTexC * cbPass.UVScale, 0);
             const float ZSampleDepthV = ShaderUtil::NdcDepthToViewDepth(ZSampleDepth, cbPass.Proj);
             
             const float RayDepthV = mul(float4(rayPos, 1.f), cbPass.View).z;       
@@ -96,8 +96,6 @@ RWTexture2D<ShadingConvention::RaySorting::RayIndexOffsetMapFormat> go_SortedToS
 
 ConstantBuffer<ConstantBuffers::RaySortingCB> cbRaySorting : register(b0);
 
-static const uint PixelStepX = 2;
-
 #define MIN_WAVE_LANE_COUNT 16
 #define MAX_WAVES ((MAX_RAYS + MIN_WAVE_LANE_COUNT - 1) / MIN_WAVE_LANE_COUNT)
 
@@ -442,16 +440,9 @@ void CalculatePartialRayDirectionHashKeyAndCacheDepth(in uint2 Gid, in uint GI)
         uint2 rayIndex = uint2(ray % RayGroupDim.x, ray / RayGroupDim.x);
         uint2 pixel = GroupStart + rayIndex;
 
-        uint2 pixelFullRes = pixel;
-        if (cbRaySorting.CheckerboardRayGenEnabled) {
-            const bool IsEvenPixelY = (pixelFullRes.y & 1) == 0;
-            const uint PixelOffsetX = IsEvenPixelY != cbRaySorting.CheckerboardGenerateRaysForEvenPixels;
-            pixelFullRes.x = pixelFullRes.x * PixelStepX + PixelOffsetX;
-        }
-        
         float2 encodedRayDirection;
         float rayOriginDepth;
-        ValuePackaging::UnpackEncodedNormalDepth(gi_RayDirectionOriginDepthMap[pixelFullRes], encodedRayDirection, rayOriginDepth);
+        ValuePackaging::UnpackEncodedNormalDepth(gi_RayDirectionOriginDepthMap[pixel], encodedRayDirection, rayOriginDepth);
         bool isRayValid = rayOriginDepth != INVALID_RAY_ORIGIN_DEPTH;
 
         // The ray direction hash key doesn't need to store if the ray value is valid for now, 
@@ -637,13 +628,6 @@ void ScatterWriteSortedIndicesToSharedMemory(in uint2 Gid, in uint GI, in float2
         uint2 rayIndex = uint2(ray % RayGroupDim.x, ray / RayGroupDim.x);
         uint2 pixel = GroupStart + rayIndex;
 
-        uint2 pixelFullRes = pixel;
-        if (cbRaySorting.CheckerboardRayGenEnabled) {
-            const bool IsEvenPixelY = (pixelFullRes.y & 1) == 0;
-            const uint PixelOffsetX = IsEvenPixelY != cbRaySorting.CheckerboardGenerateRaysForEvenPixels;
-            pixelFullRes.x = pixelFullRes.x * PixelStepX + PixelOffsetX;
-        }
-        
         // Get the key for the corresponding pixel.
         uint key;
         bool isRayValid;
@@ -659,7 +643,7 @@ void ScatterWriteSortedIndicesToSharedMemory(in uint2 Gid, in uint GI, in float2
         else { // The cached key has been already replaced with the ray's source index. Regenerate the key.
             float2 encodedRayDirection;
             float rayOriginDepth;
-            ValuePackaging::UnpackEncodedNormalDepth(gi_RayDirectionOriginDepthMap[pixelFullRes], encodedRayDirection, rayOriginDepth);
+            ValuePackaging::UnpackEncodedNormalDepth(gi_RayDirectionOriginDepthMap[pixel], encodedRayDirection, rayOriginDepth);
             isRayValid = rayOriginDepth != INVALID_RAY_ORIGIN_DEPTH;
 
             if (isRayValid) key = CreateRayHashKey(rayIndex, encodedRayDirection, rayOriginDepth, rayGroupMinMaxDepth);
@@ -0,0 +1,122 @@
+#ifndef __CULLINSTANCES_HLSL__
+#define __CULLINSTANCES_HLSL__
+
+#ifndef _HLSL
+#define _HLSL
+#endif
+
+#include "./../../../inc/Render/DX/Foundation/HlslCompaction.h"
+
+ConstantBuffer<ConstantBuffers::PassCB> cbPass : register(b0);
+
+GpuCulling_CullInstances_RootConstants(b1)
+
+StructuredBuffer<ShadingConvention::GpuCulling::InstanceBounds> gi_InstanceBounds : register(t0);
+ByteAddressBuffer gi_Commands : register(t1);
+
+Texture2D<ShadingConvention::GpuCulling::HiZMapFormat> gi_HiZMap : register(t2);
+
+RWByteAddressBuffer go_Commands     : register(u0);
+RWByteAddressBuffer go_CommandCount : register(u1);
+
+// Projects the corners of a world-space box. Returns false when all of them
+// lie outside the same clip plane. The NDC extents only cover the corners
+// in front of the camera; crossesNear tells whether any corner is behind.
+bool ProjectBox(
+        in float3 center, 
+        in float3 extents, 
+        in float4x4 viewProj, 
+        out float3 minNdc, 
+        out float3 maxNdc, 
+        out bool crossesNear) {
+    minNdc = (float3)1e30f;
+    maxNdc = (float3)-1e30f;
+    crossesNear = false;
+
+    uint outside = 0x3F;
+
+    [unroll]
+    for (uint i = 0; i < 8; ++i) {
+        const float3 Sign = float3(i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f);
+        const float4 PosH = mul(float4(center + extents * Sign, 1.f), viewProj);
+
+        uint code = 0;
+        code |= PosH.x < -PosH.w ? 0x01 : 0;
+        code |= PosH.x >  PosH.w ? 0x02 : 0;
+        code |= PosH.y < -PosH.w ? 0x04 : 0;
+        code |= PosH.y >  PosH.w ? 0x08 : 0;
+        code |= PosH.z < 0.f     ? 0x10 : 0;
+        code |= PosH.z >  PosH.w ? 0x20 : 0;
+        outside &= code;
+
+        if (PosH.w <= 0.f) {
+            crossesNear = true;
+            continue;
+        }
+
+        const float3 Ndc = PosH.xyz / PosH.w;
+        minNdc = min(minNdc, Ndc);
+        maxNdc = max(maxNdc, Ndc);
+    }
+
+    return outside == 0;
+}
+
+// The pyramid holds the previous frame's depth, so the box is projected
+// with the previous view-projection and tested against what was drawn
+// there. Boxes the previous camera did not fully see are kept.
+bool IsOccluded(in float3 center, in float3 extents) {
+    float3 minNdc, maxNdc;
+    bool crossesNear;
+    if (!ProjectBox(center, extents, cbPass.PrevViewProj, minNdc, maxNdc, crossesNear)) return false;
+    if (crossesNear) return false;
+
+    const float2 MinTexC = saturate(float2(minNdc.x, -maxNdc.y) * 0.5f + 0.5f);
+    const float2 MaxTexC = saturate(float2(maxNdc.x, -minNdc.y) * 0.5f + 0.5f);
+
+    // The mip where the footprint spans at most 2x2 texels.
+    const float2 SizePx = (MaxTexC - MinTexC) * gHiZTexDim;
+    const uint Mip = min(gHiZMipCount - 1, (uint)ceil(log2(max(max(SizePx.x, SizePx.y), 1.f))));
+
+    const uint2 MipDim = max(gHiZTexDim >> Mip, 1);
+    const uint2 MinTexel = min((uint2)(MinTexC * MipDim), MipDim - 1);
+    const uint2 MaxTexel = min((uint2)(MaxTexC * MipDim), MipDim - 1);
+
+    float farthest = 0.f;
+
+    for (uint y = MinTexel.y; y <= MaxTexel.y; ++y) {
+        for (uint x = MinTexel.x; x <= MaxTexel.x; ++x)
+            farthest = max(farthest, gi_HiZMap.Load(uint3(x, y, Mip)));
+    }
+
+    return minNdc.z > farthest;
+}
+
+[numthreads(
+    ShadingConvention::GpuCulling::ThreadGroup::CullInstances::Width,
+    ShadingConvention::GpuCulling::ThreadGroup::CullInstances::Height,
+    ShadingConvention::GpuCulling::ThreadGroup::CullInstances::Depth)]
+void CS(in uint DTid : SV_DispatchThreadID) {
+    if (DTid >= gInstanceCount) return;
+
+    const ShadingConvention::GpuCulling::InstanceBounds Bounds = gi_InstanceBounds[DTid];
+    if (!Bounds.Drawable) return;
+
+    float3 minNdc, maxNdc;
+    bool crossesNear;
+    if (!ProjectBox(Bounds.Center, Bounds.Extents, cbPass.ViewProj, minNdc, maxNdc, crossesNear)) return;
+
+    if (gOcclusionEnabled && IsOccluded(Bounds.Center, Bounds.Extents)) return;
+
+    uint slot;
+    go_CommandCount.InterlockedAdd(0, 1, slot);
+
+    // The records are copied verbatim; their layout is up to the consumer.
+    const uint Src = DTid * gCommandByteStride;
+    const uint Dst = slot * gCommandByteStride;
+
+    for (uint offset = 0; offset < gCommandByteStride; offset += 4)
+        go_Commands.Store(Dst + offset, gi_Commands.Load(Src + offset));
+}
+
+#endif // __CULLINSTANCES_HLSL__
\ No newline at end of file
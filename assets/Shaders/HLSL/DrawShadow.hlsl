@@ -14,8 +14,7 @@ ConstantBuffer<ConstantBuffers::LightCB> cbLight : register(b0);
 Shadow_DrawShadow_RootConstants(b1)
 
 Texture2D<ShadingConvention::GBuffer::PositionMapFormat>   gi_PositionMap   : register(t0);
-Texture2D<ShadingConvention::Shadow::ZDepthMapFormat>      gi_ZDepthMap     : register(t1);
-Texture2DArray<ShadingConvention::Shadow::ZDepthMapFormat> gi_ZDepthCubeMap : register(t2);
+Texture2D<ShadingConvention::Shadow::ZDepthMapFormat>      gi_ZDepthAtlas   : register(t1);
 
 RWTexture2D<ShadingConvention::Shadow::ShadowMapFormat>    gio_ShadowMap    : register(u0);
 
@@ -34,8 +33,23 @@ void CS(in uint2 DTid : SV_DispatchThreadID) {
         return;
     }
     
-    if (light.Type == Common::Foundation::LightType::E_Directional || light.Type == Common::Foundation::LightType::E_Spot) {
-        const float ShadowFactor = Shadow::CalcShadowFactor(gi_ZDepthMap, gsamShadow, light.Mat1, PosW.xyz);
+    if (light.Type == Common::Foundation::LightType::E_Directional) {
+        float2 uv;
+        const uint Cascade = Shadow::FindCascade(light, PosW.xyz, ShadingConvention::Shadow::CascadeCount, uv);
+        
+        // Past the last cascade nothing is shadowed.
+        float shadowFactor = 1.f;
+        if (Cascade < ShadingConvention::Shadow::CascadeCount) 
+            shadowFactor = Shadow::CalcShadowFactorCube(
+                gi_ZDepthAtlas, gsamShadow, Shadow::GetViewProjMatrix(light, Cascade), PosW.xyz, uv, 
+                cbLight.ShadowPages[gLightIndex * ShadingConvention::Shadow::MaxFaceCount + Cascade]);
+        
+        value = Shadow::CalcShiftedShadowValueF(shadowFactor, value, gLightIndex);
+    }
+    else if (light.Type == Common::Foundation::LightType::E_Spot) {
+        const float ShadowFactor = Shadow::CalcShadowFactor(
+            gi_ZDepthAtlas, gsamShadow, light.Mat1, PosW.xyz, 
+            cbLight.ShadowPages[gLightIndex * ShadingConvention::Shadow::MaxFaceCount]);
         value = Shadow::CalcShiftedShadowValueF(ShadowFactor, value, gLightIndex);
     }
     else if (light.Type == Common::Foundation::LightType::E_Point || light.Type == Common::Foundation::LightType::E_Tube) {
@@ -53,7 +67,9 @@ void CS(in uint2 DTid : SV_DispatchThreadID) {
         const float2 UV = ShaderUtil::ConvertDirectionToUV(Normalized);
 
         const float4x4 ViewProj = Shadow::GetViewProjMatrix(light, Index);
-        const float ShadowFactor = Shadow::CalcShadowFactorCube(gi_ZDepthCubeMap, gsamShadow, ViewProj, PosW.xyz, UV, Index);
+        const float ShadowFactor = Shadow::CalcShadowFactorCube(
+            gi_ZDepthAtlas, gsamShadow, ViewProj, PosW.xyz, UV, 
+            cbLight.ShadowPages[gLightIndex * ShadingConvention::Shadow::MaxFaceCount + Index]);
 
         value = Shadow::CalcShiftedShadowValueF(ShadowFactor, value, gLightIndex);
     }
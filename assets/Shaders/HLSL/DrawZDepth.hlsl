@@ -31,7 +31,8 @@ struct VertexOut {
 struct GeoOut {
     float4 PosH : SV_POSITION;
     float2 TexC : TEXCOORD;
-    uint ArrayIndex : SV_RenderTargetArrayIndex;
+    // Every face is a viewport onto its own atlas page.
+    uint ViewportIndex : SV_ViewportArrayIndex;
 };
 
 VertexOut VS(in VertexIn vin) {
@@ -45,40 +46,63 @@ VertexOut VS(in VertexIn vin) {
     return vout;
 }
 
+// A triangle wholly outside one clip plane of a face casts nothing into
+// its page, so the face is skipped before it is rasterized.
+bool IsOutsideFace(in float4 p0, in float4 p1, in float4 p2) {
+    const float3 MaxLo = max(max(
+        p0.xyz + float3(p0.w, p0.w, 0.f), 
+        p1.xyz + float3(p1.w, p1.w, 0.f)), 
+        p2.xyz + float3(p2.w, p2.w, 0.f));
+    const float3 MinHi = min(min(p0.xyz - p0.www, p1.xyz - p1.www), p2.xyz - p2.www);
+    
+    return any(MaxLo < 0.f) || any(MinHi > 0.f);
+}
+
+void AppendFace(
+        in VertexOut gin[3], 
+        in float4x4 viewProj, 
+        in uint face, 
+        inout TriangleStream<GeoOut> triStream) {
+    float4 posH[3];
+    
+    [unroll]
+    for (uint i = 0; i < 3; ++i) posH[i] = mul(gin[i].PosW, viewProj);
+    
+    if (IsOutsideFace(posH[0], posH[1], posH[2])) return;
+    
+    GeoOut gout = (GeoOut)0;
+    gout.ViewportIndex = face;
+    
+    [unroll]
+    for (uint j = 0; j < 3; ++j) {
+        gout.PosH = posH[j];
+        gout.TexC = gin[j].TexC;
+
+        triStream.Append(gout);
+    }
+
+    triStream.RestartStrip();
+}
+
 [maxvertexcount(18)]
 void GS(in triangle VertexOut gin[3], inout TriangleStream<GeoOut> triStream) {
-    GeoOut gout = (GeoOut) 0;
-	
     Common::Foundation::Light light = cbLight.Lights[gLightIndex];
 
-	// Directional light or spot light
-    if (light.Type == Common::Foundation::LightType::E_Directional || light.Type == Common::Foundation::LightType::E_Spot) {
-		[unroll]
-        for (uint i = 0; i < 3; ++i) {
-            gout.PosH = mul(gin[i].PosW, light.Mat0);
-            gout.TexC = gin[i].TexC;
-
-            triStream.Append(gout);
-        }
+	// Directional light, one face per cascade
+    if (light.Type == Common::Foundation::LightType::E_Directional) {
+		[loop]
+        for (uint cascade = 0; cascade < ShadingConvention::Shadow::CascadeCount; ++cascade) 
+            AppendFace(gin, Shadow::GetViewProjMatrix(light, cascade), cascade, triStream);
+    }
+	// Spot light
+    else if (light.Type == Common::Foundation::LightType::E_Spot) {
+        AppendFace(gin, light.Mat0, 0, triStream);
     }
 	// Point light or tube light
     else if (light.Type == Common::Foundation::LightType::E_Point || light.Type == Common::Foundation::LightType::E_Tube) {
 		[loop]
-        for (uint face = 0; face < 6; ++face) {
-            gout.ArrayIndex = face;
-
-            const float4x4 ViewProj = Shadow::GetViewProjMatrix(light, face);
-
-			[unroll]
-            for (uint i = 0; i < 3; ++i) {
-                gout.PosH = mul(gin[i].PosW, ViewProj);
-                gout.TexC = gin[i].TexC;
-
-                triStream.Append(gout);
-            }
-
-            triStream.RestartStrip();
-        }
+        for (uint face = 0; face < 6; ++face) 
+            AppendFace(gin, Shadow::GetViewProjMatrix(light, face), face, triStream);
     }
 }
 
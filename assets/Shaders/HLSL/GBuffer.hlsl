@@ -11,14 +11,18 @@
 #include "./../../../assets/Shaders/HLSL/GBuffer.hlsli"
 
 ConstantBuffer<ConstantBuffers::PassCB>     cbPass      : register(b0);
-ConstantBuffer<ConstantBuffers::ObjectCB>   cbObject    : register(b1);
-ConstantBuffer<ConstantBuffers::MaterialCB> cbMaterial  : register(b2);
+ConstantBuffer<ConstantBuffers::MaterialCB> cbMaterial  : register(b1);
 
-GBuffer_Default_RootConstants(b3)
+GBuffer_Default_RootConstants(b2)
 
 StructuredBuffer<Common::Foundation::Mesh::Vertex> gi_VertexBuffer : register(t0);
 ByteAddressBuffer gi_IndexBuffer : register(t1);
 
+// Objects of every instance, reached through the draw's slice of the
+// instance list.
+StructuredBuffer<ConstantBuffers::ObjectCB> gi_Objects : register(t2);
+StructuredBuffer<uint> gi_InstanceIndices : register(t3);
+
 Texture2D<float4> gi_Textures[ShadingConvention::GBuffer::MaxNumTextures] : register(t0, space1);
 
 VERTEX_IN
@@ -45,25 +49,27 @@ struct PixelOut {
     ShadingConvention::GBuffer::PositionMapFormat           Position           : SV_TARGET7;
 };
                                                                                                                                                                                                                                                                             
-VertexOut VS(in VertexIn vin) {
+VertexOut VS(in VertexIn vin, in uint InstanceID : SV_InstanceID) {
+    const ConstantBuffers::ObjectCB Object = gi_Objects[gi_InstanceIndices[gInstanceBase + InstanceID]];
+
     VertexOut vout = (VertexOut) 0;
     
     vout.PosL = vin.PosL;
     
-    const float4 PosW = mul(float4(vin.PosL, 1.f), cbObject.World);
+    const float4 PosW = mul(float4(vin.PosL, 1.f), Object.World);
     vout.PosW = PosW.xyz;
     
     const float4 PosH = mul(PosW, cbPass.ViewProj);
     vout.CurrPosH = PosH;
     vout.PosH = PosH + float4(cbPass.JitteredOffset * PosH.w, 0, 0);
     
-    const float4 PrevPosW = mul(float4(vin.PosL, 1), cbObject.PrevWorld);
+    const float4 PrevPosW = mul(float4(vin.PosL, 1), Object.PrevWorld);
     vout.PrevPosH = mul(PrevPosW, cbPass.PrevViewProj);
     
-    vout.NormalW = mul(vin.NormalL, (float3x3)cbObject.World);
-    vout.PrevNormalW = mul(vin.NormalL, (float3x3)cbObject.PrevWorld);
+    vout.NormalW = mul(vin.NormalL, (float3x3)Object.World);
+    vout.PrevNormalW = mul(vin.NormalL, (float3x3)Object.PrevWorld);
     
-    float4 TexC = mul(float4(vin.TexC, 0.f, 1.f), cbObject.TexTransform);
+    float4 TexC = mul(float4(vin.TexC, 0.f, 1.f), Object.TexTransform);
     vout.TexC = mul(TexC, cbMaterial.MatTransform).xy;
     
     return vout;
@@ -73,9 +79,13 @@ VertexOut VS(in VertexIn vin) {
 [numthreads(ShadingConvention::GBuffer::ThreadGroup::MeshShader::ThreadsPerGroup, 1, 1)]
 void MS(
         in uint GTid : SV_GroupThreadID,
-        in uint Gid : SV_GroupID,
+        in uint3 GroupID : SV_GroupID,
         out vertices VertexOut verts[MESH_SHADER_MAX_VERTICES],
         out indices uint3 prims[MESH_SHADER_MAX_PRIMITIVES]) {
+    // Instances are spread along the second dispatch dimension.
+    const uint Gid = GroupID.x;
+    const ConstantBuffers::ObjectCB Object = gi_Objects[gi_InstanceIndices[gInstanceBase + GroupID.y]];
+
     const uint TotalPrimCount = gIndexCount / 3;
     const uint GlobalPrimId = Gid * MESH_SHADER_MAX_PRIMITIVES + GTid;
     
@@ -109,20 +119,20 @@ void MS(
         VertexOut vout = (VertexOut) 0;
         vout.PosL = vin.Position;
         
-        float4 PosW = mul(float4(vout.PosL, 1.f), cbObject.World);
+        float4 PosW = mul(float4(vout.PosL, 1.f), Object.World);
         vout.PosW = PosW.xyz;
     
         const float4 PosH = mul(PosW, cbPass.ViewProj);
         vout.CurrPosH = PosH;
         vout.PosH = PosH + float4(cbPass.JitteredOffset * PosH.w, 0, 0);
     
-        const float4 PrevPosW = mul(float4(vin.Position, 1), cbObject.PrevWorld);
+        const float4 PrevPosW = mul(float4(vin.Position, 1), Object.PrevWorld);
         vout.PrevPosH = mul(PrevPosW, cbPass.PrevViewProj);
         
-        vout.NormalW = mul(vin.Normal, (float3x3)cbObject.World);
-        vout.PrevNormalW = mul(vin.Normal, (float3x3)cbObject.PrevWorld);
+        vout.NormalW = mul(vin.Normal, (float3x3)Object.World);
+        vout.PrevNormalW = mul(vin.Normal, (float3x3)Object.PrevWorld);
     
-        float4 TexC = mul(float4(vin.TexCoord, 0.f, 1.f), cbObject.TexTransform);
+        float4 TexC = mul(float4(vin.TexCoord, 0.f, 1.f), Object.TexTransform);
         vout.TexC = TexC.xy;
      
         verts[OutVert] = vout;
@@ -149,7 +159,10 @@ PixelOut PS(in VertexOut pin) {
     pin.PrevPosH /= pin.PrevPosH.w;
     const float2 Velocity = ShaderUtil::CalcVelocity(pin.CurrPosH, pin.PrevPosH);
     
-    pout.Color = cbMaterial.Albedo;
+    float4 albedo = cbMaterial.Albedo;
+    if (cbMaterial.AlbedoMapIndex != -1) albedo *= gi_Textures[cbMaterial.AlbedoMapIndex].Sample(gsamAnisotropicWrap, pin.TexC);
+    
+    pout.Color = albedo;
     pout.Normal = float4(normalize(pin.NormalW), 0.f);
     pout.NormalDepth = ValuePackaging::EncodeNormalDepth(pin.NormalW, pin.CurrPosH.z);
     pout.PrevNormalDepth = ValuePackaging::EncodeNormalDepth(pin.PrevNormalW, pin.PrevPosH.z);
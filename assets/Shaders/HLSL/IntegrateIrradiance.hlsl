@@ -17,6 +17,8 @@ ConstantBuffer<ConstantBuffers::PassCB> cbPass : register(b0);
 
 BRDF_IntegrateIrradiance_RootConstants(b1)
 
+ConstantBuffer<ConstantBuffers::IrradianceSHCB> cbIrradianceSH : register(b2);
+
 Texture2D<ShadingConvention::ToneMapping::IntermediateMapFormat>    gi_BackBuffer            : register(t0);
 Texture2D<ShadingConvention::GBuffer::AlbedoMapFormat>              gi_AlbedoMap             : register(t1);
 Texture2D<ShadingConvention::GBuffer::NormalMapFormat>              gi_NormalMap             : register(t2);
@@ -26,7 +28,6 @@ Texture2D<ShadingConvention::GBuffer::RoughnessMetalnessMapFormat>  gi_Roughness
 Texture2D<ShadingConvention::GBuffer::PositionMapFormat>            gi_PositionMap           : register(t6);
 Texture2D<ShadingConvention::SSAO::AOCoefficientMapFormat>          gi_AOMap                 : register(t7);
 Texture2D gi_ReflectionMap : register(t8);
-TextureCube<ShadingConvention::EnvironmentMap::DiffuseIrradianceCubeMapFormat>      gi_DiffuseIrradianceCubeEnv : register(t9);
 Texture2D<ShadingConvention::EnvironmentMap::BrdfLutMapFormat>                      gi_BrdfLutMap               : register(t10);
 TextureCube<ShadingConvention::EnvironmentMap::PrefilteredEnvironmentCubeMapFormat> gi_PrefilteredEnvCubeMap    : register(t11);
 
@@ -40,18 +41,20 @@ FitToScreenVertexShader
 FitToScreenMeshShader
 
 HDR_FORMAT PS(in VertexOut pin) : SV_Target {
-    const float4 PosW = gi_PositionMap.Sample(gsamLinearClamp, pin.TexC);
-    const float3 Radiance = gi_BackBuffer.Sample(gsamLinearClamp, pin.TexC).rgb;
+    const float2 TexC = pin.TexC * cbPass.UVScale;
+
+    const float4 PosW = gi_PositionMap.Sample(gsamLinearClamp, TexC);
+    const float3 Radiance = gi_BackBuffer.Sample(gsamLinearClamp, TexC).rgb;
 
     if (!ShadingConvention::GBuffer::IsValidPosition(PosW)) return float4(Radiance, 1.f);
 
-    const float3 NormalW = normalize(gi_NormalMap.Sample(gsamLinearClamp, pin.TexC).xyz);
+    const float3 NormalW = normalize(gi_NormalMap.Sample(gsamLinearClamp, TexC).xyz);
 
-    const float4 Albedo = gi_AlbedoMap.Sample(gsamLinearClamp, pin.TexC);
+    const float4 Albedo = gi_AlbedoMap.Sample(gsamLinearClamp, TexC);
     const float3 ViewW = normalize(cbPass.EyePosW - PosW.xyz);
     
-    const float3 Specular = gi_SpecularMap.Sample(gsamLinearClamp, pin.TexC).rgb;
-    const float2 RoughnessMetalness = gi_RoughnessMetalnessMap.Sample(gsamLinearClamp, pin.TexC);
+    const float3 Specular = gi_SpecularMap.Sample(gsamLinearClamp, TexC).rgb;
+    const float2 RoughnessMetalness = gi_RoughnessMetalnessMap.Sample(gsamLinearClamp, TexC);
     
     const float Roughness = RoughnessMetalness.r;
     const float Metalness = RoughnessMetalness.g;
@@ -74,7 +77,7 @@ HDR_FORMAT PS(in VertexOut pin) : SV_Target {
     const float2 Brdf = gi_BrdfLutMap.Sample(gsamLinearClamp, float2(NdotV, Roughness));
     const float3 SpecularBias = (kS * Brdf.x + Brdf.y);
     
-    //const float4 Reflection = gi_ReflectionMap.Sample(gsamLinearClamp, pin.TexC);
+    //const float4 Reflection = gi_ReflectionMap.Sample(gsamLinearClamp, TexC);
     const float4 Reflection = (float4) 0.f;
     const float Alpha = Reflection.a;
 
@@ -82,11 +85,11 @@ HDR_FORMAT PS(in VertexOut pin) : SV_Target {
 
     float ao = 1.f;
     if (gAoEnabled) {
-        const float AOValue = gi_AOMap.SampleLevel(gsamLinearClamp, pin.TexC, 0);
+        const float AOValue = gi_AOMap.SampleLevel(gsamLinearClamp, TexC, 0);
         if (AOValue != ShadingConvention::SSAO::InvalidAOValue) ao = AOValue;
     }
                                                                                                                                                                                                                                                                                             
-    const float3 DiffuseIrradiance = gi_DiffuseIrradianceCubeEnv.SampleLevel(gsamLinearClamp, NormalW, 0).rgb;
+    const float3 DiffuseIrradiance = EvaluateIrradianceSH(cbIrradianceSH.Coeffs, NormalW);
     const float3 AmbientDiffuse = kD * Albedo.rgb * DiffuseIrradiance * ao;
     const float3 AmbientSpecular = SpecularBias * SpecularIrradiance * ao;
     const float3 AmbientLight = AmbientDiffuse + AmbientSpecular;
@@ -25,7 +25,8 @@ FitToScreenVertexShader
 FitToScreenMeshShader
 
 SDR_FORMAT PS(VertexOut pin) : SV_TARGET {
-	float2 velocity = gi_VelocityMap.Sample(gsamPointWrap, pin.TexC);
+	// The back buffer spans the window; depth and velocity only the area rendered into.
+	float2 velocity = gi_VelocityMap.Sample(gsamPointWrap, pin.TexC * gUVScale);
 	float3 colorSum = gi_BackBuffer.Sample(gsamPointWrap, pin.TexC).rgb;
 
 	if (!ShadingConvention::GBuffer::IsValidVelocity(velocity)) velocity = (float2)0.f;
@@ -34,7 +35,7 @@ SDR_FORMAT PS(VertexOut pin) : SV_TARGET {
 	velocity *= gIntensity;
 	velocity = clamp(velocity, (float2)-gLimit,(float2)gLimit);
 	
-	const float centerDepth = gi_DepthMap.Sample(gsamDepthMap, pin.TexC);
+	const float centerDepth = gi_DepthMap.Sample(gsamDepthMap, pin.TexC * gUVScale);
 	
 	uint count = 1;
 	float2 forward = pin.TexC;
@@ -43,11 +44,11 @@ SDR_FORMAT PS(VertexOut pin) : SV_TARGET {
 		forward += velocity;
 		inverse -= velocity;
 	
-		if (centerDepth < gi_DepthMap.Sample(gsamDepthMap, forward) + gDepthBias) {
+		if (centerDepth < gi_DepthMap.Sample(gsamDepthMap, forward * gUVScale) + gDepthBias) {
 			colorSum += gi_BackBuffer.Sample(gsamLinearClamp, forward).rgb;
 			++count;
 		}
-		if (centerDepth < gi_DepthMap.Sample(gsamDepthMap, inverse) + gDepthBias) {
+		if (centerDepth < gi_DepthMap.Sample(gsamDepthMap, inverse * gUVScale) + gDepthBias) {
 			colorSum += gi_BackBuffer.Sample(gsamLinearClamp, inverse).rgb;
 			++count;
 		}
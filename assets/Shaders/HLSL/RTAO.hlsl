@@ -83,15 +83,26 @@ void RTAO_RayGen() {
     const uint2 LaunchIndex = DispatchRaysIndex().xy;
     const uint2 Dimensions = DispatchRaysDimensions().xy;
     
+    // Rays are launched for the evaluated pixels only.
+    uint2 pixel = LaunchIndex;
+    if (cbAO.CheckerboardRayGenEnabled) {
+        const bool IsEvenPixelY = (LaunchIndex.y & 1) == 0;
+        const uint PixelOffsetX = IsEvenPixelY != cbAO.EvenPixelsActivated;
+        pixel.x = LaunchIndex.x * PixelStepX + PixelOffsetX;
+    }
+    else if (cbAO.HalfResolutionEnabled) {
+        pixel = LaunchIndex * 2;
+    }
+    
     float3 surfaceNormal;
     float depth;
-    ValuePackaging::DecodeNormalDepth(gi_NormalDepthMap[LaunchIndex], surfaceNormal, depth);
+    ValuePackaging::DecodeNormalDepth(gi_NormalDepthMap[pixel], surfaceNormal, depth);
 
     float tHit = ShadingConvention::RTAO::RayHitDistanceOnMiss;
     float aoCoefficient = ShadingConvention::RTAO::InvalidAOCoefficientValue;
 
     if (depth != ShadingConvention::RTAO::RayHitDistanceOnMiss) {
-        float3 hitPosition = gi_PositionMap[LaunchIndex].xyz;
+        float3 hitPosition = gi_PositionMap[pixel].xyz;
 
         const uint Seed = Random::InitRand(LaunchIndex.x + LaunchIndex.y * Dimensions.x, cbAO.FrameCount);
 
@@ -103,15 +114,18 @@ void RTAO_RayGen() {
 
         for (int i = 0; i < cbAO.SampleCount; ++i) {
             Ray aoRay = { hitPosition, direction };
-            occlusionSum += CalculateAO(tHit, LaunchIndex, aoRay, surfaceNormal);
+            occlusionSum += CalculateAO(tHit, pixel, aoRay, surfaceNormal);
         }
 
         occlusionSum /= cbAO.SampleCount;
         aoCoefficient = 1.f - occlusionSum;
     }
 
-    go_AOCoefficientMap[LaunchIndex] = aoCoefficient;
-    go_RayHitDistanceMap[LaunchIndex] = ShadingConvention::RTAO::HasAORayHitAnyGeometry(tHit) ? tHit : cbAO.OcclusionRadius;
+    // Half resolution writes to the half-sized maps that are upsampled later.
+    const uint2 OutPixel = cbAO.HalfResolutionEnabled ? LaunchIndex : pixel;
+
+    go_AOCoefficientMap[OutPixel] = aoCoefficient;
+    go_RayHitDistanceMap[OutPixel] = ShadingConvention::RTAO::HasAORayHitAnyGeometry(tHit) ? tHit : cbAO.OcclusionRadius;
 }
 
 // Retrieves 2D source and sorted ray indices from a 1D ray index where
@@ -167,6 +181,9 @@ void RTAO_RayGen_RaySorted() {
         const uint PixelOffsetX = IsEvenPixelY != cbAO.EvenPixelsActivated;
         srcRayIndexFullRes.x = srcRayIndex.x * PixelStepX + PixelOffsetX;
     }
+    else if (cbAO.HalfResolutionEnabled) {
+        srcRayIndexFullRes = srcRayIndex * 2;
+    }
 
     float tHit = ShadingConvention::RTAO::RayHitDistanceOnMiss;
     float aoCoefficient = ShadingConvention::RTAO::InvalidAOCoefficientValue;
@@ -188,7 +205,7 @@ void RTAO_RayGen_RaySorted() {
         aoCoefficient = 1.f - aoCoefficient;
     }
 
-    const uint2 OutPixel = srcRayIndexFullRes;
+    const uint2 OutPixel = cbAO.HalfResolutionEnabled ? srcRayIndex : srcRayIndexFullRes;
     
     go_AOCoefficientMap[OutPixel] = aoCoefficient;
     go_RayHitDistanceMap[OutPixel] = ShadingConvention::RTAO::HasAORayHitAnyGeometry(tHit) ? tHit : cbAO.OcclusionRadius;
@@ -60,6 +60,7 @@ float3 GetRandomRayDirection(in uint2 srcRayIndex, in float3 surfaceNormal, in u
         const uint2 PixelZeroId = SampleSetId * cbRayGen.NumPixelsPerDimPerSet;
         uint2 PixelZeroIdFullRes = PixelZeroId;
         if (cbRayGen.CheckerboardRayGenEnabled) PixelZeroIdFullRes.x = PixelZeroIdFullRes.x * PixelStepX;
+        else if (cbRayGen.HalfResolutionEnabled) PixelZeroIdFullRes = PixelZeroIdFullRes * 2;
         
         const float3 PixelZeroHitPosition = gi_PositionMap[PixelZeroIdFullRes].xyz;        
         const uint SampleSetSeed = (SampleSetId.y * NumSampleSetsInX + SampleSetId.x) * ShaderUtil::Hash(PixelZeroHitPosition) + cbRayGen.Seed;
@@ -96,6 +97,9 @@ void CS(in uint2 DTid : SV_DispatchThreadID, in uint2 GTid : SV_GroupThreadID) {
         const uint PixelOffsetX = IsEvenPixelY != cbRayGen.CheckerboardGenerateRaysForEvenPixels;
         DTidFullRes.x = DTid.x * PixelStepX + PixelOffsetX;
     }
+    else if (cbRayGen.HalfResolutionEnabled) {
+        DTidFullRes = DTid * 2;
+    }
     
     float3 surfaceNormal;
     float rayOriginDepth;
@@ -33,15 +33,30 @@ RWTexture2D<ShadingConvention::SSAO::DebugMapFormat>            go_DebugMap
     ShadingConvention::SSAO::ThreadGroup::Default::Height,
     ShadingConvention::SSAO::ThreadGroup::Default::Depth)]
 void CS(in uint2 DTid : SV_DispatchThreadID) {    
-    const float2 TexC = (DTid + 0.5f) * gInvTexDim;
+    // Full-resolution pixel this thread evaluates. Half resolution takes the
+    // top-left pixel of each quad, so the upsample knows its exact depth.
+    uint2 pixel = DTid;
+    if (cbAO.CheckerboardRayGenEnabled) {
+        const bool IsEvenPixelY = (DTid.y & 1) == 0;
+        const uint PixelOffsetX = IsEvenPixelY != cbAO.EvenPixelsActivated;
+        pixel.x = DTid.x * 2 + PixelOffsetX;
+    }
+    else if (cbAO.HalfResolutionEnabled) {
+        pixel = DTid * 2;
+    }
+    
+    // Checkerboard writes in place; half resolution fills the smaller maps.
+    const uint2 OutIndex = cbAO.HalfResolutionEnabled ? DTid : pixel;
+    
+    const float2 TexC = (pixel + 0.5f) * gInvTexDim;
     
     const float4 PosW = gi_PositionMap.SampleLevel(gsamPointClamp, TexC, 0);
     if (!ShadingConvention::GBuffer::IsValidPosition(PosW)) {
-        go_AOMap[DTid] = ShadingConvention::SSAO::InvalidAOValue;
+        go_AOMap[OutIndex] = ShadingConvention::SSAO::InvalidAOValue;
         return;
     }
     
-    const uint NormalDepth = gi_NormalDepthMap[DTid];
+    const uint NormalDepth = gi_NormalDepthMap[pixel];
     
     float3 normalW;
     float dump;
@@ -133,8 +148,8 @@ void CS(in uint2 DTid : SV_DispatchThreadID) {
     const float Access = 1.f - occlusionSum;
 
 	// Sharpen the contrast of the SSAO map to make the SSAO affect more dramatic.
-    go_AOMap[DTid] = saturate(pow(Access, cbAO.OcclusionStrength));
-    go_RayHitDistMap[DTid] = dist;
+    go_AOMap[OutIndex] = saturate(pow(Access, cbAO.OcclusionStrength));
+    go_RayHitDistMap[OutIndex] = dist;
 }
 
 #endif // __SSAO_HLSL__
\ No newline at end of file
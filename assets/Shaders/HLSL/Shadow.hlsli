@@ -27,6 +27,57 @@ namespace Shadow {
         return depthMap.SampleCmpLevelZero(sampComp, shadowPosH.xy, Depth);
     }
     
+    // Maps a face UV into its atlas page, kept half a texel inside so the
+    // comparison filter never reads a neighbouring page.
+    float2 ToAtlasUV(in Texture2D<float> atlas, in float2 uv, in float4 page) {
+        float2 dims;
+        atlas.GetDimensions(dims.x, dims.y);
+        
+        const float2 HalfTexel = 0.5f / (page.xy * dims);
+        
+        return clamp(uv, HalfTexel, 1.f - HalfTexel) * page.xy + page.zw;
+    }
+    
+    float CalcShadowFactor(
+		    in Texture2D<float> atlas,
+		    in SamplerComparisonState sampComp,
+		    in float4x4 viewProjTex,
+		    in float3 fragPosW,
+		    in float4 page) {
+        if (page.x == 0.f) return 1.f;
+        
+        float4 shadowPosH = mul(float4(fragPosW, 1.f), viewProjTex);
+        shadowPosH /= shadowPosH.w;
+
+        const float Depth = shadowPosH.z;
+
+        return atlas.SampleCmpLevelZero(sampComp, ToAtlasUV(atlas, shadowPosH.xy, page), Depth);
+    }
+    
+    // Index of the first of a directional light's cascades whose window
+    // holds the point, or cascadeCount when none does. uv is the point's
+    // face UV in that cascade.
+    uint FindCascade(
+            in Common::Foundation::Light light, 
+            in float3 fragPosW, 
+            in uint cascadeCount, 
+            out float2 uv) {
+        uv = 0.f;
+        
+        [loop]
+        for (uint cascade = 0; cascade < cascadeCount; ++cascade) {
+            float4 shadowPosH = mul(float4(fragPosW, 1.f), GetViewProjMatrix(light, cascade));
+            shadowPosH /= shadowPosH.w;
+            
+            if (all(abs(shadowPosH.xy) < 1.f) && shadowPosH.z >= 0.f && shadowPosH.z <= 1.f) {
+                uv = shadowPosH.xy * float2(0.5f, -0.5f) + 0.5f;
+                return cascade;
+            }
+        }
+        
+        return cascadeCount;
+    }
+    
     uint CalcShiftedShadowValueF(in float percent, in uint value, in uint index) {
         const uint ShadowFactor = percent < 0.5f ? 0 : 1;
         const uint Shifted = ShadowFactor << index;
@@ -49,6 +100,23 @@ namespace Shadow {
         return depthMap.SampleCmpLevelZero(sampComp, float3(uv, index), Depth);
     }
     
+    float CalcShadowFactorCube(
+		    in Texture2D<float> atlas,
+		    in SamplerComparisonState sampComp,
+		    in float4x4 viewProj,
+		    in float3 fragPosW,
+		    in float2 uv,
+		    in float4 page) {
+        if (page.x == 0.f) return 1.f;
+        
+        float4 shadowPosH = mul(float4(fragPosW, 1.f), viewProj);
+        shadowPosH /= shadowPosH.w;
+
+        const float Depth = shadowPosH.z;
+
+        return atlas.SampleCmpLevelZero(sampComp, ToAtlasUV(atlas, uv, page), Depth);
+    }
+    
     uint GetShiftedShadowValue(in uint value, in uint index) {
         return (value >> index) & 1;
     }
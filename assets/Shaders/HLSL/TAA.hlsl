@@ -25,23 +25,26 @@ FitToScreenVertexShader
 FitToScreenMeshShader
 
 HDR_FORMAT PS(in VertexOut pin) : SV_TARGET {    
-    const float2 Velocity = gi_VelocityMap.Sample(gsamLinearClamp, pin.TexC);
-    const float3 BackBufferColor = gi_BackBuffer.SampleLevel(gsamLinearClamp, pin.TexC, 0).rgb;
+    // Velocities are in viewport UVs; the history was rendered into the
+    // previous frame's area.
+    const float2 TexC = pin.TexC * gUVScale;
+    const float2 Velocity = gi_VelocityMap.Sample(gsamLinearClamp, TexC);
+    const float3 BackBufferColor = gi_BackBuffer.SampleLevel(gsamLinearClamp, TexC, 0).rgb;
     
     if (!ShadingConvention::GBuffer::IsValidVelocity(Velocity)) return float4(BackBufferColor, 1.f);
     
     const float2 PrevTexC = pin.TexC - Velocity;
     if (any(PrevTexC < 0.f) || any(PrevTexC > 1.f)) return float4(BackBufferColor, 1.f);
 
-    float3 historyColor = gi_HistoryMap.SampleLevel(gsamPointClamp, PrevTexC, 0).rgb;
+    float3 historyColor = gi_HistoryMap.SampleLevel(gsamPointClamp, PrevTexC * gPrevUVScale, 0).rgb;
     const float3 Unclamped = historyColor;
         
     float3 minC = BackBufferColor;
     float3 maxC = BackBufferColor;
     [unroll] for(int oy = -1; oy <= 1; ++oy)
     [unroll] for(int ox = -1; ox <= 1; ++ox) {
-      const float2 uv = pin.TexC + float2(ox, oy) * gInvTexDim;
-      const float3 c = gi_BackBuffer.SampleLevel(gsamPointClamp, saturate(uv), 0).rgb;
+      const float2 uv = TexC + float2(ox, oy) * gInvTexDim;
+      const float3 c = gi_BackBuffer.SampleLevel(gsamPointClamp, clamp(uv, 0.f, gUVScale - 0.5f * gInvTexDim), 0).rgb;
       minC = min(minC, c);
       maxC = max(maxC, c);
     }
@@ -45,10 +45,10 @@ float4 BilateralResampleWeights(
 		in int2 cacheIndices[4],
 		in float2 ddxy) {
     const bool4 IsWithinBounds = bool4(
-		ShaderUtil::IsWithinBounds(cacheIndices[0], gTexDim),
-		ShaderUtil::IsWithinBounds(cacheIndices[1], gTexDim),
-		ShaderUtil::IsWithinBounds(cacheIndices[2], gTexDim),
-		ShaderUtil::IsWithinBounds(cacheIndices[3], gTexDim));
+		ShaderUtil::IsWithinBounds(cacheIndices[0], gPrevTexDim),
+		ShaderUtil::IsWithinBounds(cacheIndices[1], gPrevTexDim),
+		ShaderUtil::IsWithinBounds(cacheIndices[2], gPrevTexDim),
+		ShaderUtil::IsWithinBounds(cacheIndices[3], gPrevTexDim));
 
     CrossBilateral::BilinearDepthNormal::Parameters params;
     params.Depth.Sigma = cbReproject.DepthSigma;
@@ -89,15 +89,17 @@ void CS(in uint2 DTid : SV_DispatchThreadID) {
     float reprojDepth;
     ValuePackaging::DecodeNormalDepth(ReprojNormalDepth, reprojNormal, reprojDepth);
 
-    const float2 TexC = (DTid + 0.5f) * gInvTexDim;    
+    // Velocities are in viewport UVs, and the cache covers the area the
+    // previous frame rendered into.
+    const float2 TexC = (DTid + 0.5f) / gTexDim;
     const float2 CacheTexC = TexC - Velocity;
 
 	// Find the nearest integer index samller than the texture position.
 	// The floor() ensures the that value sign is taken into consideration.
-    const int2 TopLeftCacheIndex = floor(CacheTexC * gTexDim - 0.5f);
+    const int2 TopLeftCacheIndex = floor(CacheTexC * gPrevTexDim - 0.5f);
     const float2 AdjustedCacheTex = (TopLeftCacheIndex + 0.5f) * gInvTexDim;
 
-    const float2 CachePixelOffset = CacheTexC * gTexDim - 0.5f - TopLeftCacheIndex;
+    const float2 CachePixelOffset = CacheTexC * gPrevTexDim - 0.5f - TopLeftCacheIndex;
 
     const int2 SrcIndexOffsets[4] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } };
 
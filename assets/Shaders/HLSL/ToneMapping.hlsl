@@ -82,7 +82,14 @@ float3 TonemapLog(in float3 hdr, in float a = 1.f) {
 }
 
 SDR_FORMAT PS(in VertexOut pin) : SV_Target {
-    const float3 HDR = gi_IntermediateMap.SampleLevel(gsamLinearClamp, pin.TexC, 0).rgb;
+    float2 size;
+    gi_IntermediateMap.GetDimensions(size.x, size.y);
+
+    // Scales the area rendered into up to the back buffer, keeping the
+    // filter off the texels past its edge.
+    const float2 TexC = min(pin.TexC * gUVScale, gUVScale - 0.5f / size);
+
+    const float3 HDR = gi_IntermediateMap.SampleLevel(gsamLinearClamp, TexC, 0).rgb;
         
     const float Luminance = gi_Luminance[0];
     const float Exposure = exp2(-Luminance) * gMiddleGrayKey;
@@ -98,11 +98,26 @@ namespace Common::AccelerationStructure {
 
 		static const std::uint32_t InvalidAxis = std::numeric_limits<std::uint32_t>::max();
 
+	public:
+		CacheFriendlyBVH() = default;
+		CacheFriendlyBVH(const CacheFriendlyBVH& ref) = delete;
+		virtual ~CacheFriendlyBVH();
+
 	public:
 		// The single-point entrance to the BVH - call only this
 		void UpdateBoundingVolumeHierarchy();
 
+		// Builds the hierarchy over externally owned vertices and triangles,
+		// which must outlive the BVH. Triangle bounds are filled in here.
+		void Build(Vertex* pVertices, Triangle* pTriangles, std::uint32_t numTriangles);
+
+		// Appends the indices of all triangles whose bounds overlap the box.
+		void Query(const Vector3Df& bottom, const Vector3Df& top, std::vector<std::uint32_t>& triangles) const;
+
 	private:
+		void Release();
+		void DeleteBVH(BVHNode* root);
+
 		BVHNode* CreateBVH();
 
 		BVHNode* Recurse(BBoxEntries& work, std::uint32_t depth = 0);
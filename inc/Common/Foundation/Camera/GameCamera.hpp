@@ -40,6 +40,10 @@ namespace Common::Foundation {
 			void Pitch(float rad);
 			void Yaw(float rad);
 			void Roll(float rad);
+			// Replaces the orientation with absolute angles: roll about the
+			// forward axis, then pitch about the right axis, then yaw about
+			// the world up axis.
+			void SetRotation(float pitch, float yaw, float roll);
 
 			void AddPosition(const DirectX::XMVECTOR& pos);
 			void SetPosition(const DirectX::XMVECTOR& pos);
@@ -78,6 +78,14 @@ namespace Common::ImGuiManager {
 			Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet);
 		void ChromaticAberrationTree(
 			Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet);
+		void GpuCullingTree(
+			Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet);
+		void OcclusionCullingTree(
+			Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet);
+		void TextureStreamingTree(
+			Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet);
+		void DynamicResolutionTree(
+			Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet);
 
 	protected:
 		BOOL mbIsWin32Initialized{};
@@ -0,0 +1,16 @@
+#ifndef __EFFECTRESOLUTION_H__
+#define __EFFECTRESOLUTION_H__
+
+namespace Common {
+	namespace Render {
+		// Rate at which a screen-space effect is evaluated before it is
+		// brought back to the render resolution.
+		enum EffectResolution {
+			E_FullResolution = 0,
+			E_Checkerboard,
+			E_HalfResolution
+		};
+	}
+}
+
+#endif // __EFFECTRESOLUTION_H__
\ No newline at end of file
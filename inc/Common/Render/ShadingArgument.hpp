@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Common/Render/EffectResolution.h"
+
 namespace Common::Render {
 	namespace ShadingArgument {
 		struct GammaCorrectionArguments {
@@ -89,6 +91,11 @@ namespace Common::Render {
 			const std::uint32_t MinSampleCount = 1;
 			std::uint32_t SampleCount = 6;
 
+			// Checkerboard alternates the evaluated half of the pixels every
+			// frame; half resolution is brought back with a bilateral upsample.
+			std::uint32_t ResolutionType = E_FullResolution;
+			bool CheckerboardSampleEvenPixels = false;
+
 			BlendWithCurrentFrameArguments BlendWithCurrentFrame;
 			AtrousWaveletTransformFilterArguments AtrousWaveletTransformFilter;
 			DenoiserArguments Denoiser;
@@ -111,9 +118,12 @@ namespace Common::Render {
 			// RaySorting
 			bool RaySortingEnabled = true;
 			bool CheckerboardGenerateRaysForEvenPixels = false;
-			bool CheckboardRayGeneration = true;
 			bool RandomFrameSeed = true;
 
+			// Rays are traced for the evaluated pixels only, the same way SSAO
+			// samples them.
+			std::uint32_t ResolutionType = E_Checkerboard;
+
 			BlendWithCurrentFrameArguments BlendWithCurrentFrame;
 			AtrousWaveletTransformFilterArguments AtrousWaveletTransformFilter;
 			DenoiserArguments Denoiser;
@@ -145,6 +155,11 @@ namespace Common::Render {
 			float DensityScale = 0.01f;
 
 			bool TricubicSamplingEnabled = true;
+
+			// Checkerboard scatters half of the froxel columns per frame. There
+			// is no half resolution: the froxel grid does not follow the render
+			// size, a coarser grid is chosen by its dimensions instead.
+			std::uint32_t ResolutionType = E_FullResolution;
 		};
 
 		struct SSCSArguments {
@@ -210,6 +225,10 @@ namespace Common::Render {
 
 			float Threshold = 1.f;
 			float SoftKnee = 0.5f;
+
+			// Half resolution ends the upsampling chain one level early and
+			// skips its largest blur.
+			std::uint32_t ResolutionType = E_FullResolution;
 		};
 
 		struct DOFArguments {
@@ -260,6 +279,36 @@ namespace Common::Render {
 			float Exponent = 2.f;
 		};
 
+		struct GpuCullingArguments {
+			bool Enabled = true;
+			bool OcclusionEnabled = true;
+		};
+
+		struct OcclusionCullingArguments {
+			bool Enabled = true;
+		};
+
+		struct TextureStreamingArguments {
+			bool Enabled = true;
+
+			const std::uint32_t MaxBudgetMB = 4096;
+			const std::uint32_t MinBudgetMB = 64;
+			std::uint32_t BudgetMB = 1024;
+		};
+
+		struct DynamicResolutionArguments {
+			bool Enabled = false;
+
+			const std::uint32_t MaxTargetFrameRate = 240;
+			const std::uint32_t MinTargetFrameRate = 30;
+			std::uint32_t TargetFrameRate = 60;
+
+			// Bounds of the render scale, which applies to both sides.
+			const float LowestScale = 0.25f;
+			float MinScale = 0.5f;
+			float MaxScale = 1.f;
+		};
+
 		struct ShadingArgumentSet {
 			GammaCorrectionArguments GammaCorrection;			
 			ToneMappingArguments ToneMapping;
@@ -273,6 +322,10 @@ namespace Common::Render {
 			BloomArguments Bloom;
 			DOFArguments DOF;
 			ChromaticAberrationArguments ChromaticAberration;
+			GpuCullingArguments GpuCulling;
+			OcclusionCullingArguments OcclusionCulling;
+			TextureStreamingArguments TextureStreaming;
+			DynamicResolutionArguments DynamicResolution;
 
 			bool ShadowEnabled = true;
 			bool AOEnabled = true;
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+namespace Common::Util {
+	// Orders draws by a 64-bit state key and merges the draws that differ
+	// only in depth into instanced batches. From the highest bits down the
+	// key holds the pass, pipeline, material, geometry and quantized depth,
+	// so the sorted list switches the costlier state least often and keeps
+	// each state front to back.
+	class DrawBatcher {
+	public:
+		// A run of sorted draws sharing every state but depth.
+		struct Batch {
+			UINT First;
+			UINT Count;
+		};
+
+	public:
+		static const UINT PassBits = 4;
+		static const UINT PipelineBits = 8;
+		static const UINT MaterialBits = 16;
+		static const UINT GeometryBits = 16;
+		static const UINT DepthBits = 20;
+
+	public:
+		DrawBatcher() = default;
+		virtual ~DrawBatcher() = default;
+
+	public:
+		__forceinline UINT DrawCount() const;
+		// Payloads in draw order; batches index into this list.
+		__forceinline const std::vector<UINT>& SortedPayloads() const;
+		__forceinline const std::vector<Batch>& Batches() const;
+
+	public:
+		void Clear();
+		void Add(UINT64 key, UINT payload);
+
+		// Sorts the added draws and groups them into batches.
+		void Build();
+
+	public:
+		// Depth is expected in [0, 1] and clamped to it; the other fields
+		// are truncated to their widths.
+		static UINT64 MakeKey(UINT pass, UINT pipeline, UINT material, UINT geometry, FLOAT depth);
+
+	private:
+		// LSD radix sort over byte digits; passes whose digit is the same
+		// for every key are skipped.
+		void RadixSort();
+
+	private:
+		std::vector<UINT64> mKeys{};
+		std::vector<UINT> mPayloads{};
+
+		std::vector<UINT64> mScratchKeys{};
+		std::vector<UINT> mScratchPayloads{};
+
+		std::vector<Batch> mBatches{};
+	};
+}
+
+#include "DrawBatcher.inl"
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef __DRAWBATCHER_INL__
+#define __DRAWBATCHER_INL__
+
+UINT Common::Util::DrawBatcher::DrawCount() const {
+	return static_cast<UINT>(mKeys.size());
+}
+
+const std::vector<UINT>& Common::Util::DrawBatcher::SortedPayloads() const {
+	return mPayloads;
+}
+
+const std::vector<Common::Util::DrawBatcher::Batch>& Common::Util::DrawBatcher::Batches() const {
+	return mBatches;
+}
+
+#endif // __DRAWBATCHER_INL__
\ No newline at end of file
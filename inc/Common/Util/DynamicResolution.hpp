@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+namespace Common::Util {
+	// Picks the scale of the internal render resolution from measured frame
+	// times. The cost of a frame is taken to follow its pixel count, so the
+	// scale moves by the square root of the ratio between the target and the
+	// smoothed frame time. Scales snap to fixed steps and every change is
+	// followed by a cooldown whose samples are dropped, which keeps the
+	// hitch of applying a change out of the average and stops the scale
+	// from flapping. It only sees numbers, so recorded frame-time traces can
+	// be fed to it as they are.
+	class DynamicResolution {
+	public:
+		DynamicResolution() = default;
+		virtual ~DynamicResolution() = default;
+
+	public:
+		__forceinline constexpr FLOAT Scale() const;
+		// Zero until a sample has been taken since the last change.
+		__forceinline constexpr FLOAT AverageFrameTime() const;
+
+		// Both sides scaled and rounded, never below one pixel.
+		__forceinline UINT ScaledWidth(UINT width) const;
+		__forceinline UINT ScaledHeight(UINT height) const;
+
+	public:
+		// Bounds are kept inside (0, 1]; the scale starts at the upper one.
+		void Initialize(FLOAT minScale, FLOAT maxScale, FLOAT targetFrameTime);
+
+		// A scale outside the new bounds is pulled back in on the next Update.
+		void SetBounds(FLOAT minScale, FLOAT maxScale);
+		void SetTargetFrameTime(FLOAT targetFrameTime);
+
+		// Sets the scale right away and starts over the average.
+		void Reset(FLOAT scale);
+
+		// Takes the time the last frame took, in seconds, and returns the
+		// scale to render the next one at. Non-positive samples are ignored.
+		FLOAT Update(FLOAT frameTime);
+
+	private:
+		FLOAT Quantize(FLOAT scale) const;
+		void ChangeScale(FLOAT scale);
+
+	private:
+		FLOAT mMinScale{ 1.f };
+		FLOAT mMaxScale{ 1.f };
+		FLOAT mTargetFrameTime{};
+
+		FLOAT mScale{ 1.f };
+
+		FLOAT mAverageFrameTime{};
+		UINT mSampleCount{};
+		UINT mCooldownFrames{};
+	};
+}
+
+#include "DynamicResolution.inl"
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef __DYNAMICRESOLUTION_INL__
+#define __DYNAMICRESOLUTION_INL__
+
+constexpr FLOAT Common::Util::DynamicResolution::Scale() const {
+	return mScale;
+}
+
+constexpr FLOAT Common::Util::DynamicResolution::AverageFrameTime() const {
+	return mAverageFrameTime;
+}
+
+UINT Common::Util::DynamicResolution::ScaledWidth(UINT width) const {
+	const UINT Scaled = static_cast<UINT>(static_cast<FLOAT>(width) * mScale + 0.5f);
+	return Scaled > 0 ? Scaled : 1;
+}
+
+UINT Common::Util::DynamicResolution::ScaledHeight(UINT height) const {
+	const UINT Scaled = static_cast<UINT>(static_cast<FLOAT>(height) * mScale + 0.5f);
+	return Scaled > 0 ? Scaled : 1;
+}
+
+#endif // __DYNAMICRESOLUTION_INL__
\ No newline at end of file
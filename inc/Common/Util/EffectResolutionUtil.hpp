@@ -0,0 +1,77 @@
+#pragma once
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+#include <DirectXMath.h>
+
+#include "Common/Render/EffectResolution.h"
+
+namespace Common::Util {
+	// Index math of effects evaluated at a reduced rate. A checkerboard
+	// packs the active half of every row into a half-width grid and flips
+	// the active parity each frame; half resolution evaluates the top-left
+	// pixel of every quad. The upsample that brings half resolution back
+	// weights the four nearest evaluated texels bilinearly and by depth and
+	// normal agreement. The shaders follow these line for line
+	// (SSAO.hlsl, RTAO.hlsl, RayGen.hlsl, BilateralUpsample.hlsl and the
+	// fog passes), so the mapping can be checked on the CPU.
+	class EffectResolutionUtil {
+	public:
+		// What the upsample reads of an evaluated texel's source pixel.
+		struct UpsampleSample {
+			FLOAT Depth{};
+			DirectX::XMFLOAT3 Normal{};
+			BOOL Valid{};
+		};
+
+		struct UpsampleParams {
+			FLOAT DepthSigma{ 1.f };
+			UINT DepthNumMantissaBits{ 10 };
+			FLOAT DepthWeightCutoff{ 0.2f };
+			FLOAT NormalSigma{ 1.1f };
+			FLOAT NormalSigmaExponent{ 32.f };
+		};
+
+	public:
+		// Size of the grid of evaluated texels for a render size.
+		static DirectX::XMUINT2 EvaluatedDim(Render::EffectResolution type, UINT width, UINT height);
+
+		// Full-resolution pixel an evaluated texel stands for.
+		static DirectX::XMUINT2 EvaluatedPixel(
+			Render::EffectResolution type,
+			const DirectX::XMUINT2& index,
+			BOOL bEvenPixelsActivated);
+
+		// The four half-resolution texels around a full-resolution pixel,
+		// top-left first and row major, and the pixel's offset from the
+		// top-left one in units of the texel spacing.
+		static void UpsampleFootprint(
+			const DirectX::XMUINT2& pixel,
+			const DirectX::XMUINT2& lowResDim,
+			DirectX::XMUINT2 (&srcIndices)[4],
+			DirectX::XMFLOAT2& targetOffset);
+
+		// Unnormalized weights of the four texels. ddxy are the depth
+		// derivatives at the target pixel per full-resolution pixel.
+		static void BilateralUpsampleWeights(
+			FLOAT depth,
+			const DirectX::XMFLOAT3& normal,
+			const DirectX::XMFLOAT2& targetOffset,
+			const DirectX::XMFLOAT2& ddxy,
+			const UpsampleSample (&samples)[4],
+			const UpsampleParams& params,
+			FLOAT (&weights)[4]);
+
+		// Stand-in when no weight survives: the valid sample closest in depth.
+		static UINT NearestDepthSample(FLOAT depth, const UpsampleSample (&samples)[4]);
+
+		// Spacing of representable values around x with the given mantissa.
+		static FLOAT FloatPrecision(FLOAT x, UINT numMantissaBits);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+#include <DirectXMath.h>
+
+namespace Common::Util {
+	// Offline bakes of the image-based lighting terms that do not depend on
+	// the view. Diffuse irradiance is reduced to nine spherical harmonic
+	// coefficients, and the split-sum BRDF is integrated the same way as
+	// IntegrateBrdf.hlsl. Both loops run eight texels per AVX instruction,
+	// split across worker threads; the scalar path handles CPUs without
+	// AVX2.
+	class EnvironmentBaker {
+	public:
+		static const UINT SHCoeffCount = 9;
+
+		// Order-2 coefficients of the cosine-convolved radiance, scaled by
+		// 1/pi so that they evaluate to the value the diffuse term expects.
+		// Each coefficient is an RGB triple padded to a float4.
+		struct IrradianceSH {
+			DirectX::XMFLOAT4 Coeffs[SHCoeffCount]{};
+		};
+
+	public:
+		EnvironmentBaker() = default;
+		virtual ~EnvironmentBaker() = default;
+
+	public:
+		void Initialize(BOOL bAvx2Supported, UINT numThreads);
+
+		// Faces are in D3D cube order (+X, -X, +Y, -Y, +Z, -Z), each
+		// faceSize x faceSize RGBA texels stored row by row from the top.
+		void ProjectIrradianceSH(
+			const DirectX::XMFLOAT4* const pFaces[6],
+			UINT faceSize,
+			IrradianceSH& sh) const;
+
+		// Row y holds roughness (y + 0.5) / size and column x holds
+		// NdotV (x + 0.5) / size, matching the texture coordinates the
+		// LUT is sampled with.
+		void BakeBrdfLut(
+			UINT size,
+			UINT sampleCount,
+			std::vector<DirectX::XMFLOAT2>& lut) const;
+
+	public:
+		static DirectX::XMFLOAT3 EvaluateSH(const IrradianceSH& sh, const DirectX::XMFLOAT3& normal);
+
+	private:
+		template <typename Func>
+		void Dispatch(UINT count, Func&& func) const;
+
+		void ProjectRows(
+			const DirectX::XMFLOAT4* const pFaces[6],
+			UINT faceSize,
+			UINT begin, UINT end,
+			double sums[SHCoeffCount][3],
+			double& weight) const;
+		void ProjectRowsAVX(
+			const DirectX::XMFLOAT4* const pFaces[6],
+			UINT faceSize,
+			UINT begin, UINT end,
+			double sums[SHCoeffCount][3],
+			double& weight) const;
+
+		void IntegrateRows(
+			UINT size,
+			UINT sampleCount,
+			UINT begin, UINT end,
+			DirectX::XMFLOAT2* const pLut) const;
+		void IntegrateRowsAVX(
+			UINT size,
+			UINT sampleCount,
+			UINT begin, UINT end,
+			DirectX::XMFLOAT2* const pLut) const;
+
+	private:
+		BOOL mbAvx2Supported{};
+		UINT mNumThreads{ 1 };
+	};
+}
\ No newline at end of file
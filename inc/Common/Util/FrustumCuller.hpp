@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+namespace Common::Util {
+	// Batched view-frustum culling. World-space bounds are kept in
+	// structure-of-arrays form so that eight boxes or spheres can be tested
+	// against a plane per AVX instruction; the scalar path handles the tail
+	// and CPUs without AVX2.
+	class FrustumCuller {
+	public:
+		// Planes point into the frustum: a point p is inside a plane when
+		// dot(plane.xyz, p) + plane.w >= 0.
+		struct Frustum {
+			DirectX::XMFLOAT4 Planes[6];
+		};
+
+	public:
+		// Below this many objects the batch is tested on the calling thread.
+		static const UINT ParallelThreshold = 16384;
+
+	public:
+		FrustumCuller() = default;
+		virtual ~FrustumCuller() = default;
+
+	public:
+		__forceinline UINT BoxCount() const;
+		__forceinline UINT SphereCount() const;
+
+	public:
+		void Initialize(BOOL bAvx2Supported, UINT numThreads);
+		void Clear();
+
+		// Bounds are given in world space. Indices are assigned in
+		// insertion order and stay valid until Clear is called.
+		UINT AddBox(const DirectX::BoundingBox& box);
+		void UpdateBox(UINT index, const DirectX::BoundingBox& box);
+
+		UINT AddSphere(const DirectX::BoundingSphere& sphere);
+		void UpdateSphere(UINT index, const DirectX::BoundingSphere& sphere);
+
+		// Writes the indices of the objects that intersect the frustum, in
+		// ascending order.
+		void CullBoxes(const Frustum& frustum, std::vector<UINT>& visible);
+		void CullSpheres(const Frustum& frustum, std::vector<UINT>& visible);
+
+		// Tests a single stored box, for re-testing the few objects that
+		// moved since a batch was last culled.
+		BOOL IntersectsBox(const Frustum& frustum, UINT index) const;
+
+	public:
+		// Extracts world-space planes from the camera matrices.
+		static void BuildFrustum(
+			const DirectX::XMFLOAT4X4& view, 
+			const DirectX::XMFLOAT4X4& proj, 
+			Frustum& frustum);
+		static void BuildFrustum(const DirectX::XMFLOAT4X4& viewProj, Frustum& frustum);
+
+		// Conservative sphere-cone test for spot lights. The cone starts at
+		// apex, opens by halfAngle around direction and ends at range.
+		static BOOL SphereIntersectsCone(
+			const DirectX::BoundingSphere& sphere,
+			const DirectX::XMFLOAT3& apex,
+			const DirectX::XMFLOAT3& direction,
+			FLOAT halfAngle,
+			FLOAT range);
+
+		// Returns the world-space box enclosing a transformed local box.
+		static DirectX::BoundingBox TransformBox(
+			const DirectX::BoundingBox& box, 
+			const DirectX::XMFLOAT4X4& world);
+
+	private:
+		void CullBoxRange(const Frustum& frustum, UINT begin, UINT end, std::vector<UINT>& visible) const;
+		void CullSphereRange(const Frustum& frustum, UINT begin, UINT end, std::vector<UINT>& visible) const;
+
+		void CullBoxRangeAVX(const Frustum& frustum, UINT begin, UINT end, std::vector<UINT>& visible) const;
+		void CullSphereRangeAVX(const Frustum& frustum, UINT begin, UINT end, std::vector<UINT>& visible) const;
+
+		template <typename Func>
+		void Dispatch(UINT count, std::vector<UINT>& visible, Func&& func);
+
+	private:
+		BOOL mbAvx2Supported{};
+		UINT mNumThreads{ 1 };
+
+		std::vector<FLOAT> mBoxCenterX{};
+		std::vector<FLOAT> mBoxCenterY{};
+		std::vector<FLOAT> mBoxCenterZ{};
+		std::vector<FLOAT> mBoxExtentX{};
+		std::vector<FLOAT> mBoxExtentY{};
+		std::vector<FLOAT> mBoxExtentZ{};
+
+		std::vector<FLOAT> mSphereCenterX{};
+		std::vector<FLOAT> mSphereCenterY{};
+		std::vector<FLOAT> mSphereCenterZ{};
+		std::vector<FLOAT> mSphereRadius{};
+
+		std::vector<std::vector<UINT>> mChunkVisible{};
+	};
+}
+
+#include "FrustumCuller.inl"
\ No newline at end of file
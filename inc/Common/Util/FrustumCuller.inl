@@ -0,0 +1,12 @@
+#ifndef __FRUSTUMCULLER_INL__
+#define __FRUSTUMCULLER_INL__
+
+UINT Common::Util::FrustumCuller::BoxCount() const {
+	return static_cast<UINT>(mBoxCenterX.size());
+}
+
+UINT Common::Util::FrustumCuller::SphereCount() const {
+	return static_cast<UINT>(mSphereCenterX.size());
+}
+
+#endif // __FRUSTUMCULLER_INL__
\ No newline at end of file
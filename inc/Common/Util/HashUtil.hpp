@@ -8,5 +8,8 @@ namespace Common::Util {
 	class HashUtil {
 	public:
 		static Foundation::Hash HashCombine(Foundation::Hash seed, Foundation::Hash value);
+		// FNV-1a over raw bytes. Unlike std::hash it is stable across runs
+		// and builds, so it can key data persisted to disk.
+		static Foundation::Hash HashBytes(const void* const pData, size_t size);
 	};
 }
\ No newline at end of file
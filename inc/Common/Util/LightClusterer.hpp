@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+namespace Common::Util {
+	// Assigns bounded lights to the cells of a froxel grid: the screen is
+	// split into CountX x CountY tiles and the view depth between the near
+	// and far planes into CountZ exponential slices. Light bounds are kept
+	// in structure-of-arrays form so that the cell ranges of eight lights
+	// are found per AVX instruction; the scalar path handles the tail and
+	// CPUs without AVX2.
+	class LightClusterer {
+	public:
+		struct Grid {
+			UINT CountX{};
+			UINT CountY{};
+			UINT CountZ{};
+			FLOAT NearZ{};
+			FLOAT FarZ{};
+		};
+
+		// Range of the cluster in LightIndices.
+		struct Cluster {
+			UINT Offset{};
+			UINT Count{};
+		};
+
+	public:
+		// Below this many lights the grid is built on the calling thread.
+		static const UINT ParallelThreshold = 2048;
+
+	public:
+		LightClusterer() = default;
+		virtual ~LightClusterer() = default;
+
+	public:
+		__forceinline UINT LightCount() const;
+		__forceinline UINT ClusterCount() const;
+
+		__forceinline const std::vector<Cluster>& Clusters() const;
+		__forceinline const std::vector<UINT>& LightIndices() const;
+
+	public:
+		void Initialize(BOOL bAvx2Supported, UINT numThreads);
+		void Clear();
+
+		// Bounds are given in world space. Indices are assigned in
+		// insertion order and stay valid until Clear is called.
+		UINT AddLight(const DirectX::BoundingSphere& bounds);
+		void UpdateLight(UINT index, const DirectX::BoundingSphere& bounds);
+
+		// Rebuilds the per-cluster light lists for the camera. Clusters are
+		// stored x-major, then y, then z; the lights of a cluster are listed
+		// in ascending order.
+		void Build(
+			const Grid& grid,
+			const DirectX::XMFLOAT4X4& view,
+			const DirectX::XMFLOAT4X4& proj);
+
+	public:
+		// Smallest sphere around a cone of the given range and half angle.
+		static DirectX::BoundingSphere SpotLightBounds(
+			const DirectX::XMFLOAT3& position,
+			const DirectX::XMFLOAT3& direction,
+			FLOAT range,
+			FLOAT halfAngle);
+
+		// Slice of view depth z is floor(log2(z) * scale + bias).
+		static void DepthSliceParams(const Grid& grid, FLOAT& scale, FLOAT& bias);
+
+	private:
+		void ComputeRanges(UINT begin, UINT end);
+		void ComputeRangesAVX(UINT begin, UINT end);
+
+		void AssignSlices(UINT sliceBegin, UINT sliceEnd);
+
+		template <typename Func>
+		void Dispatch(UINT count, UINT granularity, BOOL bParallel, Func&& func);
+
+	private:
+		BOOL mbAvx2Supported{};
+		UINT mNumThreads{ 1 };
+
+		std::vector<FLOAT> mCenterX{};
+		std::vector<FLOAT> mCenterY{};
+		std::vector<FLOAT> mCenterZ{};
+		std::vector<FLOAT> mRadius{};
+
+		// Inclusive cell range of every light; empty in z when the light
+		// is off screen.
+		std::vector<INT> mMinX{};
+		std::vector<INT> mMaxX{};
+		std::vector<INT> mMinY{};
+		std::vector<INT> mMaxY{};
+		std::vector<INT> mMinZ{};
+		std::vector<INT> mMaxZ{};
+
+		// State of the build in progress.
+		Grid mGrid{};
+		DirectX::XMFLOAT4X4 mView{};
+		FLOAT mProjX{};
+		FLOAT mProjY{};
+		// View depth of the far side of every slice.
+		std::vector<FLOAT> mSliceFar{};
+
+		std::vector<std::vector<UINT>> mClusterLights{};
+		std::vector<Cluster> mClusters{};
+		std::vector<UINT> mLightIndices{};
+	};
+}
+
+#include "LightClusterer.inl"
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef __LIGHTCLUSTERER_INL__
+#define __LIGHTCLUSTERER_INL__
+
+UINT Common::Util::LightClusterer::LightCount() const {
+	return static_cast<UINT>(mCenterX.size());
+}
+
+UINT Common::Util::LightClusterer::ClusterCount() const {
+	return static_cast<UINT>(mClusters.size());
+}
+
+const std::vector<Common::Util::LightClusterer::Cluster>& Common::Util::LightClusterer::Clusters() const {
+	return mClusters;
+}
+
+const std::vector<UINT>& Common::Util::LightClusterer::LightIndices() const {
+	return mLightIndices;
+}
+
+#endif // __LIGHTCLUSTERER_INL__
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <vector>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+namespace Common::Util {
+	// Software occlusion culling after Hasselgren et al., "Masked Software
+	// Occlusion Culling". Occluder triangles are rasterized into a small
+	// depth buffer of 8x4-pixel tiles; a tile keeps a 32-bit coverage mask
+	// and two depths instead of its pixels. Depths are NDC z, growing away
+	// from the camera. Coverage of a tile row and the box test of eight
+	// tiles take one AVX instruction each; the scalar path handles CPUs
+	// without AVX2.
+	class MaskedOcclusionCuller {
+	public:
+		static const UINT TileWidth = 8;
+		static const UINT TileHeight = 4;
+
+	public:
+		MaskedOcclusionCuller() = default;
+		virtual ~MaskedOcclusionCuller() = default;
+
+	public:
+		__forceinline UINT Width() const;
+		__forceinline UINT Height() const;
+
+	public:
+		// The size is rounded up to whole tiles.
+		void Initialize(BOOL bAvx2Supported, UINT width, UINT height);
+
+		// Resets every tile to the far plane and takes the camera the
+		// following occluders and tests are projected with.
+		void Clear(const DirectX::XMFLOAT4X4& viewProj);
+
+		// Rasterizes an indexed triangle list. Positions are the first three
+		// floats of every vertexStride bytes. Triangles crossing the near
+		// plane are skipped, which only makes the buffer less occluding.
+		void RenderOccluder(
+			const void* const pVertices,
+			UINT vertexStride,
+			const UINT* const pIndices,
+			UINT indexCount,
+			const DirectX::XMFLOAT4X4& world);
+
+		// Returns FALSE only when the world-space box is hidden behind the
+		// occluders or off screen.
+		BOOL TestBox(const DirectX::BoundingBox& box) const;
+
+		// Writes the depth the buffer holds for every pixel, row by row, so
+		// it can be compared against a reference depth image.
+		void ResolveDepth(std::vector<FLOAT>& depth) const;
+
+	private:
+		struct ScreenVertex {
+			FLOAT X;
+			FLOAT Y;
+			FLOAT Z;
+		};
+
+	private:
+		void RasterizeTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2);
+
+		UINT CoverTile(
+			UINT tileX, UINT tileY,
+			const FLOAT edgeA[3], const FLOAT edgeB[3], const FLOAT edgeC[3]) const;
+		UINT CoverTileAVX(
+			UINT tileX, UINT tileY,
+			const FLOAT edgeA[3], const FLOAT edgeB[3], const FLOAT edgeC[3]) const;
+
+		void UpdateTile(UINT index, UINT coverage, FLOAT depth);
+
+	private:
+		BOOL mbAvx2Supported{};
+
+		UINT mWidth{};
+		UINT mHeight{};
+		UINT mTilesX{};
+		UINT mTilesY{};
+
+		DirectX::XMFLOAT4X4 mViewProj{};
+
+		// Per tile: the depth every pixel is known to be in front of, the
+		// farthest depth of the layer being built and the pixels that layer
+		// covers.
+		std::vector<FLOAT> mZMax0{};
+		std::vector<FLOAT> mZMax1{};
+		std::vector<UINT> mMask{};
+	};
+}
+
+#include "MaskedOcclusionCuller.inl"
\ No newline at end of file
@@ -0,0 +1,12 @@
+#ifndef __MASKEDOCCLUSIONCULLER_INL__
+#define __MASKEDOCCLUSIONCULLER_INL__
+
+UINT Common::Util::MaskedOcclusionCuller::Width() const {
+	return mWidth;
+}
+
+UINT Common::Util::MaskedOcclusionCuller::Height() const {
+	return mHeight;
+}
+
+#endif // __MASKEDOCCLUSIONCULLER_INL__
\ No newline at end of file
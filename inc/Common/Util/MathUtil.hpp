@@ -73,6 +73,12 @@ namespace Common::Util {
 		// Returns the polar angle of the point (x,y) in [0, 2*PI).
 		float AngleFromXY(float x, float y);
 
+		// Wraps an angle into [-PI, PI).
+		float WrapAngle(float rad);
+		// Interpolates along the shorter arc between two angles, so that
+		// blending across the -PI/PI seam does not spin the long way round.
+		float LerpAngle(float a, float b, float t);
+
 		DirectX::XMVECTOR SphericalToCartesian(float radius, float theta, float phi);
 		DirectX::XMMATRIX InverseTranspose(DirectX::CXMMATRIX M);
 		DirectX::XMFLOAT4X4 Identity4x4();
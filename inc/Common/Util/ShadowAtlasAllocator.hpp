@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+namespace Common::Util {
+	// Hands out square power-of-two pages of a shadow atlas. The atlas is
+	// a quadtree stored level by level: a free node is split into four
+	// quadrants when a smaller page is asked for, and the quadrants merge
+	// back into their parent once all four are free again.
+	class ShadowAtlasAllocator {
+	public:
+		static const UINT InvalidNode = 0xFFFFFFFF;
+
+	public:
+		struct Page {
+			UINT X{};
+			UINT Y{};
+			UINT Size{};
+			UINT Node{ InvalidNode };
+		};
+
+	public:
+		ShadowAtlasAllocator() = default;
+		virtual ~ShadowAtlasAllocator() = default;
+
+	public:
+		__forceinline constexpr UINT AtlasSize() const;
+		__forceinline constexpr UINT MinPageSize() const;
+
+		__forceinline static constexpr BOOL IsAllocated(const Page& page);
+
+	public:
+		// Both sizes are rounded up to powers of two.
+		void Initialize(UINT atlasSize, UINT minPageSize);
+		// Frees every page at once.
+		void Reset();
+
+		// The size is rounded up to a power of two and clamped to the
+		// atlas. Fails only when no free node of that size is left.
+		BOOL Allocate(UINT size, Page& page);
+		void Free(Page& page);
+
+	private:
+		enum NodeState : UINT8 {
+			E_Free = 0,
+			E_Split,
+			E_Used
+		};
+
+		BOOL Allocate(UINT node, UINT level, UINT x, UINT y, UINT targetLevel, Page& page);
+
+	private:
+		UINT mAtlasSize{};
+		UINT mMinPageSize{};
+		UINT mLevelCount{};
+
+		// Children of node n are 4n + 1 to 4n + 4.
+		std::vector<UINT8> mNodes{};
+	};
+}
+
+#include "ShadowAtlasAllocator.inl"
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef __SHADOWATLASALLOCATOR_INL__
+#define __SHADOWATLASALLOCATOR_INL__
+
+constexpr UINT Common::Util::ShadowAtlasAllocator::AtlasSize() const {
+	return mAtlasSize;
+}
+
+constexpr UINT Common::Util::ShadowAtlasAllocator::MinPageSize() const {
+	return mMinPageSize;
+}
+
+constexpr BOOL Common::Util::ShadowAtlasAllocator::IsAllocated(const Page& page) {
+	return page.Node != InvalidNode;
+}
+
+#endif // __SHADOWATLASALLOCATOR_INL__
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+namespace Common::Util {
+	// Cascade fitting for directional light shadows. Every function depends
+	// on its arguments only, so a camera that does not move yields the same
+	// matrices bit for bit.
+	class ShadowCascade {
+	public:
+		// Writes the far view depth of each of count cascades. lambda blends
+		// logarithmic (1) and uniform (0) splits.
+		static void ComputeSplits(
+			FLOAT nearZ,
+			FLOAT farZ,
+			FLOAT lambda,
+			UINT count,
+			FLOAT splits[]);
+
+		// Smallest view-space sphere around the camera frustum between two
+		// view depths. It depends only on the depths and the field of view,
+		// so its size stays the same however the camera turns.
+		static DirectX::BoundingSphere FitSliceSphere(
+			const DirectX::XMFLOAT4X4& proj,
+			FLOAT sliceNear,
+			FLOAT sliceFar);
+
+		// Light view-projection covering a world-space slice sphere on a
+		// resolution-texel square map. The window moves in whole texels, so
+		// static shadows do not shimmer, and reaches back to the scene
+		// bounds so casters between the light and the slice are kept.
+		static DirectX::XMFLOAT4X4 FitCascade(
+			const DirectX::BoundingSphere& slice,
+			const DirectX::XMFLOAT3& lightDir,
+			const DirectX::BoundingSphere& sceneBounds,
+			UINT resolution);
+	};
+}
\ No newline at end of file
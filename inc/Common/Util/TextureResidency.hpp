@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <Windows.h>
+
+namespace Common::Util {
+	// Decides which mips of streamed textures are resident. Every frame the
+	// renderer reports the most detailed mip it would sample per texture;
+	// Update then hands out one-mip loads for the textures seen that frame,
+	// the largest shortfall first, and drops mips of the least recently
+	// seen textures whenever a load would go past the budget. It knows
+	// nothing of the device or the disk, so any source of requests can
+	// drive it.
+	class TextureResidency {
+	public:
+		struct Change {
+			UINT Texture{};
+			// Most detailed resident mip once the change is applied.
+			UINT TopMip{};
+		};
+
+	public:
+		TextureResidency() = default;
+		virtual ~TextureResidency() = default;
+
+	public:
+		__forceinline constexpr UINT64 Budget() const;
+		// Includes the loads in flight.
+		__forceinline constexpr UINT64 ResidentBytes() const;
+		__forceinline constexpr UINT LoadsInFlight() const;
+
+		__forceinline UINT ResidentMip(UINT texture) const;
+
+	public:
+		void Initialize(UINT64 budget, UINT maxLoadsInFlight);
+		// A smaller budget is met by evictions on the next Update.
+		void SetBudget(UINT64 budget);
+
+		// Mip sizes go from the most detailed level down. The mips from
+		// tailMip on are resident from the start and never evicted.
+		UINT AddTexture(const UINT64* const pMipSizes, UINT mipCount, UINT tailMip);
+
+		// Requests of the same frame keep the most detailed mip.
+		void Request(UINT texture, UINT mip, UINT64 frame);
+
+		// Evictions are taken as applied; each texture shows up at most once.
+		// Loads count against the budget from the moment they are handed out.
+		void Update(UINT64 frame, std::vector<Change>& loads, std::vector<Change>& evictions);
+
+		// Lands the load handed out for the texture. A failed one gives its
+		// bytes back and caps the texture at the mips it already holds.
+		void OnLoaded(UINT texture, BOOL bSucceeded);
+
+	private:
+		struct Entry {
+			std::vector<UINT64> MipSizes{};
+			UINT TailMip{};
+			// Most detailed mip that may still be loaded.
+			UINT MinMip{};
+			UINT ResidentMip{};
+			UINT WantedMip{};
+			UINT64 LastUsedFrame{};
+			BOOL bUsed{};
+			BOOL bLoading{};
+		};
+
+		BOOL IsUsedIn(const Entry& entry, UINT64 frame) const;
+
+		// Evicts until bytes more fit in the budget. With bAllOrNothing set
+		// nothing is evicted unless that makes enough room.
+		BOOL MakeRoom(UINT64 bytes, UINT64 frame, BOOL bAllOrNothing, std::vector<Change>& evictions);
+
+	private:
+		UINT64 mBudget{};
+		UINT mMaxLoadsInFlight{ 1 };
+		UINT mLoadsInFlight{};
+		UINT64 mResidentBytes{};
+
+		std::vector<Entry> mEntries{};
+
+		// Scratch lists reused across updates.
+		std::vector<UINT> mCandidates{};
+		std::vector<UINT> mVictims{};
+	};
+}
+
+#include "TextureResidency.inl"
\ No newline at end of file
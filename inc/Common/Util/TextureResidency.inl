@@ -0,0 +1,20 @@
+#ifndef __TEXTURERESIDENCY_INL__
+#define __TEXTURERESIDENCY_INL__
+
+constexpr UINT64 Common::Util::TextureResidency::Budget() const {
+	return mBudget;
+}
+
+constexpr UINT64 Common::Util::TextureResidency::ResidentBytes() const {
+	return mResidentBytes;
+}
+
+constexpr UINT Common::Util::TextureResidency::LoadsInFlight() const {
+	return mLoadsInFlight;
+}
+
+UINT Common::Util::TextureResidency::ResidentMip(UINT texture) const {
+	return mEntries[texture].ResidentMip;
+}
+
+#endif // __TEXTURERESIDENCY_INL__
\ No newline at end of file
@@ -31,6 +31,8 @@ namespace GameWorld::Foundation {
 
 			DirectX::XMFLOAT4X4 View() const;
 
+			// Basis of the simulated orientation rather than the blended one
+			// the camera renders with, so movement in a step matches its look.
 			DirectX::XMVECTOR RightVector() const;
 			DirectX::XMVECTOR UpVector() const;
 			DirectX::XMVECTOR ForwardVector() const;
@@ -43,6 +45,9 @@ namespace GameWorld::Foundation {
 			void AddPosition(const DirectX::XMVECTOR& pos);
 			void SetPosition(const DirectX::XMVECTOR& pos);
 
+		private:
+			DirectX::XMVECTOR SimulatedRotation() const;
+
 		private:
 			std::unique_ptr<Common::Foundation::Camera::GameCamera> mCamera{};
 
@@ -50,6 +55,11 @@ namespace GameWorld::Foundation {
 			FLOAT mYaw{};
 			FLOAT mRoll{};
 
+			// Angles at the start of the current step.
+			FLOAT mPrevPitch{};
+			FLOAT mPrevYaw{};
+			FLOAT mPrevRoll{};
+
 			BOOL mbLimitPitch{ TRUE };
 			BOOL mbLimitYaw{};
 			BOOL mbLimitRoll{};
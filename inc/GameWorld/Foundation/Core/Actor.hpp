@@ -31,6 +31,10 @@ namespace GameWorld::Foundation::Core {
 	public:
 		__forceinline constexpr const std::string& Name() const;
 		__forceinline constexpr const Common::Foundation::Mesh::Transform& GetTransform() const;
+		// Transform blended between the last two simulation steps.
+		__forceinline constexpr const Common::Foundation::Mesh::Transform& GetRenderTransform() const;
+		// Blend factor the render transform was built with.
+		__forceinline constexpr FLOAT GetRenderAlpha() const;
 
 		__forceinline constexpr BOOL Initialized() const;
 		__forceinline constexpr BOOL IsDead() const;
@@ -49,7 +53,11 @@ namespace GameWorld::Foundation::Core {
 		void CleanUp();
 
 		BOOL ProcessInput(Common::Input::InputState* const pInputState);
+		// Advances the actor by one fixed simulation step.
 		BOOL Update(FLOAT delta);
+		// Blends the last two simulated transforms and pushes the result to
+		// the components. Called once per rendered frame.
+		BOOL Interpolate(FLOAT alpha);
 
 	public: // Associated with components
 		void AddComponent(Component* const pComponent);
@@ -80,10 +88,17 @@ namespace GameWorld::Foundation::Core {
 		BOOL mbInitialized{};
 		BOOL mbIsDead{};
 		BOOL mbNeedToUpdate{ TRUE };
+		// Set when the previous step moved the actor, so the render
+		// transform still has to catch up with the simulated one.
+		BOOL mbNeedToSettle{};
+
+		FLOAT mRenderAlpha{};
 
 		std::string mName{};
 
 		Common::Foundation::Mesh::Transform mTransform{};
+		Common::Foundation::Mesh::Transform mPrevTransform{};
+		Common::Foundation::Mesh::Transform mRenderTransform{};
 
 		std::vector<std::unique_ptr<Component>> mComponents{};
 	};
@@ -9,6 +9,14 @@ constexpr const Common::Foundation::Mesh::Transform& GameWorld::Foundation::Core
 	return mTransform;
 }
 
+constexpr const Common::Foundation::Mesh::Transform& GameWorld::Foundation::Core::Actor::GetRenderTransform() const {
+	return mRenderTransform;
+}
+
+constexpr FLOAT GameWorld::Foundation::Core::Actor::GetRenderAlpha() const {
+	return mRenderAlpha;
+}
+
 constexpr BOOL GameWorld::Foundation::Core::Actor::Initialized() const {
 	return mbInitialized;
 }
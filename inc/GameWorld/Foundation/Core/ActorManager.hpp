@@ -26,7 +26,10 @@ namespace GameWorld::Foundation::Core {
 		void CleanUp();
 
 		BOOL ProcessInput(Common::Input::InputState* const pInputState);
+		// Runs one fixed simulation step over all actors.
 		BOOL Update(FLOAT delta);
+		// Pushes transforms blended by alpha between the last two steps.
+		BOOL Interpolate(FLOAT alpha);
 
 		void AddActor(Actor* const pActor);
 		void RemoveActor(Actor* const pActor);
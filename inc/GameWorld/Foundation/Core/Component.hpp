@@ -31,6 +31,8 @@ namespace GameWorld::Foundation::Core {
 
 	protected:
 		const Common::Foundation::Mesh::Transform& ActorTransform();
+		const Common::Foundation::Mesh::Transform& ActorRenderTransform();
+		FLOAT ActorRenderAlpha();
 
 	protected:
 		Common::Debug::LogFile* mpLogFile{};
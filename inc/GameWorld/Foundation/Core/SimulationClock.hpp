@@ -0,0 +1,41 @@
+#pragma once
+
+namespace GameWorld::Foundation::Core {
+	// Accumulator-driven fixed-step clock. Frame time is fed in once per
+	// frame and converted into a whole number of fixed simulation steps;
+	// the leftover fraction is exposed as an interpolation factor so the
+	// render side can blend between the last two simulated states.
+	class SimulationClock {
+	public:
+		SimulationClock(FLOAT stepTime = 1.f / 60.f, UINT maxSubsteps = 8);
+		virtual ~SimulationClock() = default;
+
+	public:
+		__forceinline constexpr FLOAT StepTime() const;
+		__forceinline constexpr UINT MaxSubsteps() const;
+
+		// Fraction of a step left in the accumulator, in [0, 1).
+		__forceinline constexpr FLOAT Alpha() const;
+
+	public:
+		void SetStepTime(FLOAT stepTime);
+		void SetMaxSubsteps(UINT maxSubsteps);
+
+		void Reset();
+
+		// Adds the elapsed frame time and returns how many fixed steps to
+		// simulate this frame. If more than MaxSubsteps are due, the backlog
+		// is dropped instead of carried over, so a slow frame cannot make
+		// the next one slower still.
+		UINT Advance(FLOAT delta);
+
+	private:
+		FLOAT mStepTime;
+		UINT mMaxSubsteps;
+
+		DOUBLE mAccumulator{};
+		FLOAT mAlpha{};
+	};
+}
+
+#include "SimulationClock.inl"
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef __SIMULATIONCLOCK_INL__
+#define __SIMULATIONCLOCK_INL__
+
+constexpr FLOAT GameWorld::Foundation::Core::SimulationClock::StepTime() const {
+	return mStepTime;
+}
+
+constexpr UINT GameWorld::Foundation::Core::SimulationClock::MaxSubsteps() const {
+	return mMaxSubsteps;
+}
+
+constexpr FLOAT GameWorld::Foundation::Core::SimulationClock::Alpha() const {
+	return mAlpha;
+}
+
+#endif // __SIMULATIONCLOCK_INL__
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include "GameWorld/Foundation/Core/Component.hpp"
 
+namespace Physics::Cyclone {
+	class CollisionTriangleMesh;
+}
+
 namespace GameWorld::Foundation {
 	namespace Core {
 		class Actor;
@@ -11,7 +15,7 @@ namespace GameWorld::Foundation {
 		class MeshComponent : public Foundation::Core::Component {
 		public:
 			MeshComponent(Common::Debug::LogFile* const pLogFile, Core::Actor* const pOwner);
-			virtual ~MeshComponent() = default;
+			virtual ~MeshComponent();
 
 		public:
 			virtual BOOL OnInitialzing() override;
@@ -22,12 +26,16 @@ namespace GameWorld::Foundation {
 			virtual BOOL OnUpdateWorldTransform() override;
 
 		public:
-			BOOL LoadMesh(LPCSTR fileName, LPCSTR baseDir, LPCSTR extension);
+			// Collidable meshes are also added to the physics world as static
+			// geometry, baked with the actor transform at load time.
+			BOOL LoadMesh(LPCSTR fileName, LPCSTR baseDir, LPCSTR extension, BOOL bCollidable = TRUE);
 
 		private:
 			BOOL mbAddedMesh{};
 
 			Common::Foundation::Hash mMeshHash{};
+
+			std::unique_ptr<Physics::Cyclone::CollisionTriangleMesh> mCollisionMesh{};
 		};
 	}
 }
\ No newline at end of file
@@ -27,9 +27,14 @@ namespace Common {
 	}
 }
 
+namespace Physics::Cyclone {
+	class RigidBodyWorld;
+}
+
 namespace GameWorld {
 	namespace Foundation::Core {
 		class ActorManager;
+		class SimulationClock;
 	}
 
 	class GameWorldClass {
@@ -56,6 +61,7 @@ namespace GameWorld {
 		__forceinline Foundation::Core::ActorManager* ActorManager() const;
 		__forceinline Common::Input::InputProcessor* InputProcessor() const;
 		__forceinline Common::Render::Renderer* Renderer() const;
+		__forceinline Physics::Cyclone::RigidBodyWorld* PhysicsWorld() const;
 
 	public:
 		BOOL Initialize(Common::Debug::LogFile* const pLogFile, HINSTANCE hInstance);
@@ -109,6 +115,12 @@ namespace GameWorld {
 
 		// Timer
 		std::unique_ptr<Common::Foundation::Core::GameTimer> mGameTimer{};
+		// Fixed-step clock driving the actor simulation; rendering keeps
+		// running at the frame rate the timer allows.
+		std::unique_ptr<GameWorld::Foundation::Core::SimulationClock> mSimulationClock{};
+
+		// Physics, stepped on the simulation clock
+		std::unique_ptr<Physics::Cyclone::RigidBodyWorld> mPhysicsWorld{};
 
 		// Input processor
 		std::unique_ptr<Common::Input::InputProcessor, InputProcessorDeleter> mInputProcessor{ nullptr, nullptr };
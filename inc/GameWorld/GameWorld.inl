@@ -9,4 +9,6 @@ Common::Input::InputProcessor* GameWorld::GameWorldClass::InputProcessor() const
 
 Common::Render::Renderer* GameWorld::GameWorldClass::Renderer() const { return mRenderer.get(); }
 
+Physics::Cyclone::RigidBodyWorld* GameWorld::GameWorldClass::PhysicsWorld() const { return mPhysicsWorld.get(); }
+
 #endif // __GAMEWORLD_INL__
\ No newline at end of file
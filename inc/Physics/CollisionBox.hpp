@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CollisionPrimitive.hpp"
+
+namespace Physics::Cyclone {
+	class CollisionBox : public CollisionPrimitive {
+	public:
+		CollisionBox(RigidBody* pBody, const DirectX::SimpleMath::Vector3& halfExtents);
+		virtual ~CollisionBox() = default;
+
+	public:
+		__forceinline const DirectX::SimpleMath::Vector3& GetHalfExtents() const noexcept;
+
+	public:
+		virtual void ComputeBounds(DirectX::SimpleMath::Vector3& bottom, DirectX::SimpleMath::Vector3& top) const override;
+		virtual DirectX::SimpleMath::Vector3 Support(const DirectX::SimpleMath::Vector3& dir) const override;
+
+		// Writes the eight corners in world space.
+		void Vertices(std::array<DirectX::SimpleMath::Vector3, 8>& vertices) const;
+
+		// Tests a world-space point against the box grown by margin.
+		bool Contains(const DirectX::SimpleMath::Vector3& point, float margin) const;
+
+		// Box-to-world transform.
+		DirectX::SimpleMath::Matrix GetTransform() const;
+
+	private:
+		DirectX::SimpleMath::Vector3 mHalfExtents{};
+	};
+}
+
+#include "CollisionBox.inl"
\ No newline at end of file
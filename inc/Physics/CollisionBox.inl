@@ -0,0 +1,8 @@
+#ifndef __COLLISIONBOX_INL__
+#define __COLLISIONBOX_INL__
+
+namespace Physics::Cyclone {
+	const DirectX::SimpleMath::Vector3& CollisionBox::GetHalfExtents() const noexcept { return mHalfExtents; }
+}
+
+#endif // __COLLISIONBOX_INL__
\ No newline at end of file
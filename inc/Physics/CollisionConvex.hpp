@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CollisionPrimitive.hpp"
+
+namespace Physics::Cyclone {
+	// Convex hull given by its vertices in body space. Only the support
+	// mapping is needed, so the hull faces are never built.
+	class CollisionConvex : public CollisionPrimitive {
+	public:
+		CollisionConvex(RigidBody* pBody, const std::vector<DirectX::SimpleMath::Vector3>& vertices);
+		virtual ~CollisionConvex() = default;
+
+	public:
+		virtual void ComputeBounds(DirectX::SimpleMath::Vector3& bottom, DirectX::SimpleMath::Vector3& top) const override;
+		virtual DirectX::SimpleMath::Vector3 Support(const DirectX::SimpleMath::Vector3& dir) const override;
+
+	private:
+		DirectX::SimpleMath::Matrix Transform() const;
+
+	private:
+		std::vector<DirectX::SimpleMath::Vector3> mVertices;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Contact.hpp"
+
+namespace Physics::Cyclone {
+	class CollisionPrimitive;
+	class CollisionSphere;
+	class CollisionBox;
+	class CollisionTriangleMesh;
+
+	// Narrowphase. Sphere and box pairs use dedicated tests; every other
+	// convex pair goes through Minkowski portal refinement on the support
+	// mappings of the two primitives.
+	class CollisionDetector {
+	public:
+		// Appends the contacts between the two primitives and returns how
+		// many were written.
+		static UINT Collide(
+			const CollisionPrimitive* pFirst,
+			const CollisionPrimitive* pSecond,
+			std::vector<Contact>& contacts);
+
+	private:
+		static UINT SphereAndSphere(
+			const CollisionSphere* pFirst, const CollisionSphere* pSecond, std::vector<Contact>& contacts);
+		static UINT SphereAndBox(
+			const CollisionSphere* pFirst, const CollisionBox* pSecond, std::vector<Contact>& contacts);
+		static UINT BoxAndBox(
+			const CollisionBox* pFirst, const CollisionBox* pSecond, std::vector<Contact>& contacts);
+		static UINT ConvexAndConvex(
+			const CollisionPrimitive* pFirst, const CollisionPrimitive* pSecond, std::vector<Contact>& contacts);
+		static UINT PrimitiveAndTriangleMesh(
+			const CollisionPrimitive* pFirst, const CollisionTriangleMesh* pSecond, std::vector<Contact>& contacts);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+namespace Physics::Cyclone {
+	class RigidBody;
+
+	// Geometry attached to a rigid body for collision detection. Primitives
+	// without a body, or attached to a body of infinite mass, are static.
+	class CollisionPrimitive {
+	public:
+		enum Type {
+			E_Sphere = 0,
+			E_Box,
+			E_Convex,
+			E_TriangleMesh,
+			Count
+		};
+
+	public:
+		CollisionPrimitive(Type type, RigidBody* pBody);
+		virtual ~CollisionPrimitive() = default;
+
+	public:
+		__forceinline constexpr Type GetType() const noexcept;
+		__forceinline constexpr RigidBody* GetBody() const noexcept;
+
+		__forceinline constexpr float GetFriction() const noexcept;
+		__forceinline constexpr void SetFriction(float friction) noexcept;
+
+		__forceinline constexpr float GetRestitution() const noexcept;
+		__forceinline constexpr void SetRestitution(float restitution) noexcept;
+
+	public:
+		bool IsStatic() const;
+
+		// Centre of the primitive in world space.
+		DirectX::SimpleMath::Vector3 GetCenter() const;
+
+		// World-space bounds used by the broadphase.
+		virtual void ComputeBounds(DirectX::SimpleMath::Vector3& bottom, DirectX::SimpleMath::Vector3& top) const = 0;
+
+		// Furthest point of the primitive along dir, in world space. Any
+		// convex primitive implementing this can use the generic narrowphase.
+		virtual DirectX::SimpleMath::Vector3 Support(const DirectX::SimpleMath::Vector3& dir) const = 0;
+
+	protected:
+		Type mType;
+		RigidBody* mpBody{};
+
+		float mFriction{ 0.6f };
+		float mRestitution{};
+	};
+}
+
+#include "CollisionPrimitive.inl"
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef __COLLISIONPRIMITIVE_INL__
+#define __COLLISIONPRIMITIVE_INL__
+
+namespace Physics::Cyclone {
+	constexpr CollisionPrimitive::Type CollisionPrimitive::GetType() const noexcept {
+		return mType;
+	}
+
+	constexpr RigidBody* CollisionPrimitive::GetBody() const noexcept {
+		return mpBody;
+	}
+
+	constexpr float CollisionPrimitive::GetFriction() const noexcept {
+		return mFriction;
+	}
+
+	constexpr void CollisionPrimitive::SetFriction(float friction) noexcept {
+		mFriction = friction;
+	}
+
+	constexpr float CollisionPrimitive::GetRestitution() const noexcept {
+		return mRestitution;
+	}
+
+	constexpr void CollisionPrimitive::SetRestitution(float restitution) noexcept {
+		mRestitution = restitution;
+	}
+}
+
+#endif // __COLLISIONPRIMITIVE_INL__
\ No newline at end of file
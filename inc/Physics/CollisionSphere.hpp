@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CollisionPrimitive.hpp"
+
+namespace Physics::Cyclone {
+	class CollisionSphere : public CollisionPrimitive {
+	public:
+		CollisionSphere(RigidBody* pBody, float radius);
+		virtual ~CollisionSphere() = default;
+
+	public:
+		__forceinline constexpr float GetRadius() const noexcept;
+
+	public:
+		virtual void ComputeBounds(DirectX::SimpleMath::Vector3& bottom, DirectX::SimpleMath::Vector3& top) const override;
+		virtual DirectX::SimpleMath::Vector3 Support(const DirectX::SimpleMath::Vector3& dir) const override;
+
+	private:
+		float mRadius{};
+	};
+}
+
+#include "CollisionSphere.inl"
\ No newline at end of file
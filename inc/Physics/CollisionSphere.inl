@@ -0,0 +1,8 @@
+#ifndef __COLLISIONSPHERE_INL__
+#define __COLLISIONSPHERE_INL__
+
+namespace Physics::Cyclone {
+	constexpr float CollisionSphere::GetRadius() const noexcept { return mRadius; }
+}
+
+#endif // __COLLISIONSPHERE_INL__
\ No newline at end of file
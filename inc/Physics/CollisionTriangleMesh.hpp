@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Common/AccelerationStructure/BVH.h"
+
+#include "CollisionPrimitive.hpp"
+
+namespace Physics::Cyclone {
+	// Static triangle soup in world space, e.g. level geometry loaded
+	// through a MeshComponent. Triangles are found through a BVH so the
+	// narrowphase only visits the ones overlapping the other primitive.
+	class CollisionTriangleMesh : public CollisionPrimitive {
+	public:
+		CollisionTriangleMesh();
+		virtual ~CollisionTriangleMesh() = default;
+
+	public:
+		__forceinline UINT TriangleCount() const noexcept;
+
+	public:
+		// Positions are read with the given byte stride, so interleaved
+		// vertex arrays such as Mesh::Vertices() can be passed directly.
+		void Build(
+			const DirectX::XMFLOAT3* pPositions,
+			UINT stride,
+			UINT numVertices,
+			const UINT* pIndices,
+			UINT numIndices,
+			const DirectX::SimpleMath::Matrix& world);
+
+		void QueryTriangles(
+			const DirectX::SimpleMath::Vector3& bottom,
+			const DirectX::SimpleMath::Vector3& top,
+			std::vector<std::uint32_t>& triangles) const;
+
+		void TriangleVertices(UINT index, std::array<DirectX::SimpleMath::Vector3, 3>& vertices) const;
+
+	public:
+		virtual void ComputeBounds(DirectX::SimpleMath::Vector3& bottom, DirectX::SimpleMath::Vector3& top) const override;
+		virtual DirectX::SimpleMath::Vector3 Support(const DirectX::SimpleMath::Vector3& dir) const override;
+
+	private:
+		std::vector<Common::AccelerationStructure::Vertex> mVertices;
+		std::vector<Common::AccelerationStructure::Triangle> mTriangles;
+
+		Common::AccelerationStructure::CacheFriendlyBVH mBVH;
+
+		DirectX::SimpleMath::Vector3 mBottom{};
+		DirectX::SimpleMath::Vector3 mTop{};
+	};
+}
+
+#include "CollisionTriangleMesh.inl"
\ No newline at end of file
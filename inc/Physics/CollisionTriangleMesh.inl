@@ -0,0 +1,10 @@
+#ifndef __COLLISIONTRIANGLEMESH_INL__
+#define __COLLISIONTRIANGLEMESH_INL__
+
+namespace Physics::Cyclone {
+	UINT CollisionTriangleMesh::TriangleCount() const noexcept {
+		return static_cast<UINT>(mTriangles.size());
+	}
+}
+
+#endif // __COLLISIONTRIANGLEMESH_INL__
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace Physics::Cyclone {
+	class RigidBody;
+
+	// A contact represents two bodies in contact. Either body may be null
+	// when touching static geometry.
+	struct Contact {
+		RigidBody* Bodies[2];
+
+		// Position of the contact in world space.
+		DirectX::SimpleMath::Vector3 Point;
+		// Direction of the contact in world space, pointing from the
+		// second body toward the first.
+		DirectX::SimpleMath::Vector3 Normal;
+
+		// Depth of penetration at the contact point.
+		float Penetration;
+
+		float Friction;
+		float Restitution;
+	};
+}
\ No newline at end of file
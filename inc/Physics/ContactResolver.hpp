@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Contact.hpp"
+
+namespace Physics::Cyclone {
+	class RigidBody;
+
+	// Iterative sequential-impulse solver. Contacts are grouped into islands
+	// of bodies that touch each other through dynamic bodies; islands share
+	// no state, so they are solved in parallel. Impulses of the previous
+	// solve are reused as the starting point for matching contacts, without
+	// which stacks never converge within the iteration budget.
+	class ContactResolver {
+	public:
+		static const UINT ParallelThreshold = 64;
+
+	protected:
+		struct Constraint {
+			RigidBody* Bodies[2];
+			DirectX::SimpleMath::Vector3 Offsets[2];
+
+			DirectX::SimpleMath::Vector3 Normal;
+			DirectX::SimpleMath::Vector3 Tangents[2];
+
+			float NormalMass;
+			float TangentMass[2];
+
+			// Target normal velocity from restitution and penetration bias.
+			float Bias;
+			float Friction;
+
+			float NormalImpulse;
+			float TangentImpulse[2];
+
+			UINT Island;
+		};
+
+		// Contact of the previous solve, in the space of its reference body.
+		struct CachedImpulse {
+			RigidBody* Bodies[2];
+			DirectX::SimpleMath::Vector3 LocalPoint;
+			DirectX::SimpleMath::Vector3 Normal;
+
+			float NormalImpulse;
+			float TangentImpulse[2];
+		};
+
+	public:
+		ContactResolver(UINT iterations = 10);
+		virtual ~ContactResolver() = default;
+
+	public:
+		__forceinline constexpr UINT GetIterations() const noexcept;
+		__forceinline constexpr void SetIterations(UINT iterations) noexcept;
+
+	public:
+		// Resolves the contacts by changing the velocities of the bodies.
+		// Positions are corrected through a velocity bias, so bodies must
+		// be integrated afterwards.
+		void ResolveContacts(const std::vector<Contact>& contacts, float dt);
+
+	protected:
+		void PrepareConstraints(const std::vector<Contact>& contacts, float dt);
+		void BuildIslands();
+		void SolveIsland(UINT begin, UINT end);
+
+		void WarmStart(Constraint& constraint, const Contact& contact);
+		void CacheImpulses();
+
+		UINT FindRoot(UINT index);
+
+	protected:
+		UINT mIterations;
+
+		std::vector<Constraint> mConstraints;
+		// [begin, end) ranges into mConstraints, one per island.
+		std::vector<std::pair<UINT, UINT>> mIslands;
+
+		std::unordered_map<RigidBody*, UINT> mBodyIndices;
+		std::vector<UINT> mParents;
+
+		// Sorted by body pair; a cached entry is consumed by at most one contact.
+		std::vector<CachedImpulse> mCache;
+		std::vector<bool> mCacheUsed;
+	};
+}
+
+#include "ContactResolver.inl"
\ No newline at end of file
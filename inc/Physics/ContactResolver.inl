@@ -0,0 +1,14 @@
+#ifndef __CONTACTRESOLVER_INL__
+#define __CONTACTRESOLVER_INL__
+
+namespace Physics::Cyclone {
+	constexpr UINT ContactResolver::GetIterations() const noexcept {
+		return mIterations;
+	}
+
+	constexpr void ContactResolver::SetIterations(UINT iterations) noexcept {
+		mIterations = iterations;
+	}
+}
+
+#endif // __CONTACTRESOLVER_INL__
\ No newline at end of file
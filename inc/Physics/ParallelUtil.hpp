@@ -0,0 +1,11 @@
+#pragma once
+
+namespace Physics::Cyclone {
+	class ParallelUtil {
+	public:
+		// Splits [0, count) into one chunk per hardware thread and runs
+		// func(begin, end) on each. Below threshold the whole range is
+		// processed on the calling thread.
+		static void ParallelFor(UINT count, UINT threshold, const std::function<void(UINT, UINT)>& func);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ParticleSpatialHash.hpp"
+
+namespace Physics::Cyclone {
+	class Particle;
+	class ParticleForceGenerator;
+	class ParticlePairForceGenerator;
+
+	// Holds all the force generators and the particles they apply to.
+	// Generators are bound to contiguous particle ranges rather than to
+	// single particles, so one registration can drive a whole emitter.
+	class ParticleForceRegistry {
+	protected:
+		struct ParticleRange {
+			Particle* Particles;
+			UINT Count;
+		};
+
+		struct ParticleForceRegistration {
+			ParticleRange Range;
+			ParticleForceGenerator* Generator;
+		};
+
+		// Pairwise generators keep their own grid so that several of them
+		// can run over different ranges or with different interaction radii.
+		struct ParticlePairForceRegistration {
+			ParticleRange Range;
+			ParticlePairForceGenerator* Generator;
+			std::unique_ptr<ParticleSpatialHash> Grid;
+		};
+
+	public:
+		ParticleForceRegistry() = default;
+		virtual ~ParticleForceRegistry() = default;
+
+	public:
+		void Add(Particle* pParticle, ParticleForceGenerator* pGenerator);
+		void Add(Particle* pParticles, UINT count, ParticleForceGenerator* pGenerator);
+		void Add(Particle* pParticles, UINT count, ParticlePairForceGenerator* pGenerator);
+
+		// Removes the registration starting at the given particle. If the
+		// pair isn't registered, this method has no effect.
+		void Remove(Particle* pParticles, ParticleForceGenerator* pGenerator);
+		void Remove(Particle* pParticles, ParticlePairForceGenerator* pGenerator);
+
+		// Clears all registrations. This will not delete the particles
+		// or the force generators themselves, just the records of their
+		// connection.
+		void Clear();
+
+		// Calls all the force generators to update the forces of their
+		// corresponding particles. Grids for pairwise generators are
+		// rebuilt here, once per call.
+		void UpdateForces(float dt);
+
+	protected:
+		std::vector<ParticleForceRegistration> mRegistrations;
+		std::vector<ParticlePairForceRegistration> mPairRegistrations;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace Physics::Cyclone {
+	class Particle;
+
+	// Short-range force acting between two particles of the same range.
+	// Pairs are discovered through a spatial hash, so the generator must
+	// report the distance beyond which its force vanishes.
+	class ParticlePairForceGenerator {
+	public:
+		ParticlePairForceGenerator() = default;
+		virtual ~ParticlePairForceGenerator() = default;
+
+	public:
+		virtual float Range() const = 0;
+
+		// Applies the force exerted by pOther on pParticle only.
+		// Called concurrently from worker threads.
+		virtual void UpdateForce(Particle* pParticle, const Particle* pOther, float dt) = 0;
+	};
+}
\ No newline at end of file
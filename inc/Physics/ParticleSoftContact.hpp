@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ParticlePairForceGenerator.hpp"
+
+namespace Physics::Cyclone {
+	// Penalty force pushing overlapping particles apart. Particles are
+	// treated as spheres of equal radius.
+	class ParticleSoftContact : public ParticlePairForceGenerator {
+	public:
+		ParticleSoftContact(float radius, float stiffness);
+		virtual ~ParticleSoftContact() = default;
+
+	public:
+		virtual float Range() const override;
+
+		virtual void UpdateForce(Particle* pParticle, const Particle* pOther, float dt) override;
+
+	private:
+		float mRadius{};
+		float mStiffness{};
+	};
+}
\ No newline at end of file
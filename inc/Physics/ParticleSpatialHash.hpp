@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Particle.hpp"
+#include "ParallelUtil.hpp"
+
+namespace Physics::Cyclone {
+	// Uniform grid whose cells are hashed into a fixed-size bucket table.
+	// The grid is rebuilt from scratch every step: particle keys are computed
+	// in parallel and sorted by bucket, so neighbouring particles end up
+	// adjacent in memory and a neighbour query only visits nearby cells.
+	class ParticleSpatialHash {
+	public:
+		struct Entry {
+			UINT Bucket;
+			UINT Index;
+		};
+
+		struct Pair {
+			UINT First;
+			UINT Second;
+		};
+
+		static const UINT InvalidIndex = std::numeric_limits<UINT>::max();
+
+		// Below this many particles the work is done on the calling thread.
+		static const UINT ParallelThreshold = 4096;
+
+	public:
+		ParticleSpatialHash() = default;
+		virtual ~ParticleSpatialHash() = default;
+
+	public:
+		__forceinline constexpr float CellSize() const noexcept;
+		__forceinline constexpr UINT ParticleCount() const noexcept;
+
+	public:
+		// Rebuilds the grid over a contiguous particle range. The cell size
+		// should not be smaller than the query radius used afterwards,
+		// otherwise more than the 27 surrounding cells have to be visited.
+		void Build(Particle* pParticles, UINT count, float cellSize);
+
+		// Invokes func(i, j) for every ordered pair (i != j) closer than radius.
+		// The outer loop is split across worker threads, so func may only
+		// write to the i-th particle.
+		template <typename Func>
+		void ForEachNeighbour(float radius, Func&& func) const;
+
+		// Collects every unordered pair (i < j) closer than radius once,
+		// appended in ascending (i, j) order.
+		void GatherPairs(float radius, std::vector<Pair>& pairs) const;
+
+	private:
+		__forceinline INT CellCoord(float x) const noexcept;
+		__forceinline INT NeighbourReach(float radius) const noexcept;
+		__forceinline UINT CellBucket(INT x, INT y, INT z) const noexcept;
+
+		template <typename Func>
+		void VisitNeighbours(
+			UINT entry, float radiusSq, INT reach, std::vector<UINT>& visited, Func&& func) const;
+
+	private:
+		Particle* mpParticles{};
+		UINT mParticleCount{};
+
+		float mCellSize{ 1.f };
+		float mInvCellSize{ 1.f };
+
+		UINT mBucketMask{};
+
+		// Sorted by bucket, then by particle index.
+		std::vector<Entry> mEntries;
+		// Half-open entry ranges per bucket; InvalidIndex when empty.
+		std::vector<UINT> mBucketStart;
+		std::vector<UINT> mBucketEnd;
+	};
+}
+
+#include "ParticleSpatialHash.inl"
\ No newline at end of file
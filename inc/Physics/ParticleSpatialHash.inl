@@ -0,0 +1,87 @@
+#ifndef __PARTICLESPATIALHASH_INL__
+#define __PARTICLESPATIALHASH_INL__
+
+namespace Physics::Cyclone {
+	constexpr float ParticleSpatialHash::CellSize() const noexcept {
+		return mCellSize;
+	}
+
+	constexpr UINT ParticleSpatialHash::ParticleCount() const noexcept {
+		return mParticleCount;
+	}
+
+	INT ParticleSpatialHash::CellCoord(float x) const noexcept {
+		return static_cast<INT>(std::floor(x * mInvCellSize));
+	}
+
+	INT ParticleSpatialHash::NeighbourReach(float radius) const noexcept {
+		return std::max(1, static_cast<INT>(std::ceil(radius * mInvCellSize)));
+	}
+
+	UINT ParticleSpatialHash::CellBucket(INT x, INT y, INT z) const noexcept {
+		// Teschner et al., "Optimized Spatial Hashing for Collision Detection
+		// of Deformable Objects".
+		const UINT hash =
+			(static_cast<UINT>(x) * 73856093u) ^
+			(static_cast<UINT>(y) * 19349663u) ^
+			(static_cast<UINT>(z) * 83492791u);
+		return hash & mBucketMask;
+	}
+
+	template <typename Func>
+	void ParticleSpatialHash::VisitNeighbours(
+			UINT entry, float radiusSq, INT reach, std::vector<UINT>& visited, Func&& func) const {
+		const UINT i = mEntries[entry].Index;
+		const auto& pos = mpParticles[i].GetPosition();
+
+		const INT cx = CellCoord(pos.x);
+		const INT cy = CellCoord(pos.y);
+		const INT cz = CellCoord(pos.z);
+
+		// Different cells may share a bucket, so each bucket is visited only once.
+		visited.clear();
+
+		for (INT z = cz - reach; z <= cz + reach; ++z) {
+			for (INT y = cy - reach; y <= cy + reach; ++y) {
+				for (INT x = cx - reach; x <= cx + reach; ++x) {
+					const UINT bucket = CellBucket(x, y, z);
+
+					const UINT start = mBucketStart[bucket];
+					if (start == InvalidIndex) continue;
+					if (std::find(visited.begin(), visited.end(), bucket) != visited.end()) continue;
+					visited.push_back(bucket);
+
+					const UINT stop = mBucketEnd[bucket];
+					for (UINT k = start; k < stop; ++k) {
+						const UINT j = mEntries[k].Index;
+						if (j == i) continue;
+
+						const auto diff = pos - mpParticles[j].GetPosition();
+						if (diff.LengthSquared() >= radiusSq) continue;
+
+						func(i, j);
+					}
+				}
+			}
+		}
+	}
+
+	template <typename Func>
+	void ParticleSpatialHash::ForEachNeighbour(float radius, Func&& func) const {
+		if (mParticleCount == 0) return;
+
+		const float radiusSq = radius * radius;
+		const INT reach = NeighbourReach(radius);
+
+		ParallelUtil::ParallelFor(mParticleCount, ParallelThreshold, [&](UINT begin, UINT end) {
+			std::vector<UINT> visited;
+			visited.reserve((2 * reach + 1) * (2 * reach + 1) * (2 * reach + 1));
+
+			// Walk in sorted order so consecutive particles touch the same buckets.
+			for (UINT e = begin; e < end; ++e)
+				VisitNeighbours(e, radiusSq, reach, visited, func);
+		});
+	}
+}
+
+#endif // __PARTICLESPATIALHASH_INL__
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+namespace Physics::Cyclone {
+	// A rigid body is the basic simulation object in the physics core.
+	// Velocities are integrated before contacts are resolved and positions
+	// afterwards, so the solver always works on the velocities that will
+	// actually be used to move the body.
+	class RigidBody {
+	public:
+		RigidBody() = default;
+		virtual ~RigidBody() = default;
+
+	public:
+		__forceinline constexpr float GetMass() const noexcept;
+		__forceinline constexpr void SetMass(float mass) noexcept;
+
+		__forceinline constexpr float GetInverseMass() const noexcept;
+		__forceinline constexpr void SetInverseMass(float invMass) noexcept;
+
+		__forceinline constexpr bool HasFiniteMass() const;
+
+		__forceinline void SetDamping(float linearDamping, float angularDamping) noexcept;
+
+		__forceinline void SetAcceleration(const DirectX::SimpleMath::Vector3& accel);
+		__forceinline const DirectX::SimpleMath::Vector3& GetAcceleration() const;
+
+		__forceinline void SetPosition(const DirectX::SimpleMath::Vector3& pos);
+		__forceinline const DirectX::SimpleMath::Vector3& GetPosition() const;
+
+		__forceinline void SetOrientation(const DirectX::SimpleMath::Quaternion& orientation);
+		__forceinline const DirectX::SimpleMath::Quaternion& GetOrientation() const;
+
+		__forceinline void SetVelocity(const DirectX::SimpleMath::Vector3& vel);
+		__forceinline DirectX::SimpleMath::Vector3& GetVelocity();
+		__forceinline const DirectX::SimpleMath::Vector3& GetVelocity() const;
+
+		// Angular velocity in world space.
+		__forceinline void SetRotation(const DirectX::SimpleMath::Vector3& rot);
+		__forceinline DirectX::SimpleMath::Vector3& GetRotation();
+		__forceinline const DirectX::SimpleMath::Vector3& GetRotation() const;
+
+		// Body-to-world transform, valid after CalculateDerivedData.
+		__forceinline const DirectX::SimpleMath::Matrix& GetTransform() const;
+		__forceinline const DirectX::SimpleMath::Matrix& GetInverseInertiaTensorWorld() const;
+
+		__forceinline void ClearAccumulators() noexcept;
+
+	public:
+		// Sets the inertia tensor in body space. The tensor is stored
+		// inverted since that is the form every consumer needs.
+		void SetInertiaTensor(const DirectX::SimpleMath::Matrix& inertiaTensor);
+
+		// Recomputes the transform and world-space inverse inertia tensor
+		// from the current position and orientation.
+		void CalculateDerivedData();
+
+		// Applies accumulated forces, torques and damping to the velocities.
+		void IntegrateVelocity(float dt);
+		// Moves the body by its current velocities.
+		void IntegratePosition(float dt);
+
+		void AddForce(const DirectX::SimpleMath::Vector3& force);
+		// Both force and point are given in world space.
+		void AddForceAtPoint(const DirectX::SimpleMath::Vector3& force, const DirectX::SimpleMath::Vector3& point);
+		void AddTorque(const DirectX::SimpleMath::Vector3& torque);
+
+		// Applies an impulse at a world-space offset from the centre of mass.
+		void ApplyImpulse(const DirectX::SimpleMath::Vector3& impulse, const DirectX::SimpleMath::Vector3& offset);
+
+	public:
+		static DirectX::SimpleMath::Matrix SphereInertiaTensor(float mass, float radius);
+		static DirectX::SimpleMath::Matrix BoxInertiaTensor(float mass, const DirectX::SimpleMath::Vector3& halfExtents);
+
+	protected:
+		// Holds the inverse of the mass of the rigid body. Zero means
+		// the body is immovable.
+		float mInverseMass{};
+
+		// Inverse inertia tensor in body space and its world-space
+		// counterpart, refreshed by CalculateDerivedData.
+		DirectX::SimpleMath::Matrix mInverseInertiaTensor{};
+		DirectX::SimpleMath::Matrix mInverseInertiaTensorWorld{};
+
+		// Fraction of velocity kept per second.
+		float mLinearDamping{ 0.99f };
+		float mAngularDamping{ 0.99f };
+
+		DirectX::SimpleMath::Vector3 mPosition{};
+		DirectX::SimpleMath::Quaternion mOrientation{};
+
+		DirectX::SimpleMath::Vector3 mVelocity{};
+		DirectX::SimpleMath::Vector3 mRotation{};
+
+		// Constant acceleration, typically gravity.
+		DirectX::SimpleMath::Vector3 mAcceleration{};
+
+		DirectX::SimpleMath::Matrix mTransform{};
+
+		// Accumulated force and torque, zeroed at each velocity step.
+		DirectX::SimpleMath::Vector3 mForceAccum{};
+		DirectX::SimpleMath::Vector3 mTorqueAccum{};
+	};
+}
+
+#include "RigidBody.inl"
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef __RIGIDBODY_INL__
+#define __RIGIDBODY_INL__
+
+namespace Physics::Cyclone {
+	constexpr float RigidBody::GetMass() const noexcept {
+		return 1.f / mInverseMass;
+	}
+
+	constexpr void RigidBody::SetMass(float mass) noexcept {
+		mInverseMass = 1.f / std::max(mass, 1e-6f);
+	}
+
+	constexpr float RigidBody::GetInverseMass() const noexcept {
+		return mInverseMass;
+	}
+
+	constexpr void RigidBody::SetInverseMass(float invMass) noexcept {
+		mInverseMass = invMass;
+	}
+
+	constexpr bool RigidBody::HasFiniteMass() const { return mInverseMass > 0.f; }
+
+	void RigidBody::SetDamping(float linearDamping, float angularDamping) noexcept {
+		mLinearDamping = linearDamping;
+		mAngularDamping = angularDamping;
+	}
+
+	void RigidBody::SetAcceleration(const DirectX::SimpleMath::Vector3& accel) {
+		mAcceleration = accel;
+	}
+
+	const DirectX::SimpleMath::Vector3& RigidBody::GetAcceleration() const { return mAcceleration; }
+
+	void RigidBody::SetPosition(const DirectX::SimpleMath::Vector3& pos) {
+		mPosition = pos;
+	}
+
+	const DirectX::SimpleMath::Vector3& RigidBody::GetPosition() const { return mPosition; }
+
+	void RigidBody::SetOrientation(const DirectX::SimpleMath::Quaternion& orientation) {
+		mOrientation = orientation;
+		mOrientation.Normalize();
+	}
+
+	const DirectX::SimpleMath::Quaternion& RigidBody::GetOrientation() const { return mOrientation; }
+
+	void RigidBody::SetVelocity(const DirectX::SimpleMath::Vector3& vel) {
+		mVelocity = vel;
+	}
+
+	DirectX::SimpleMath::Vector3& RigidBody::GetVelocity() { return mVelocity; }
+
+	const DirectX::SimpleMath::Vector3& RigidBody::GetVelocity() const { return mVelocity; }
+
+	void RigidBody::SetRotation(const DirectX::SimpleMath::Vector3& rot) {
+		mRotation = rot;
+	}
+
+	DirectX::SimpleMath::Vector3& RigidBody::GetRotation() { return mRotation; }
+
+	const DirectX::SimpleMath::Vector3& RigidBody::GetRotation() const { return mRotation; }
+
+	const DirectX::SimpleMath::Matrix& RigidBody::GetTransform() const { return mTransform; }
+
+	const DirectX::SimpleMath::Matrix& RigidBody::GetInverseInertiaTensorWorld() const {
+		return mInverseInertiaTensorWorld;
+	}
+
+	void RigidBody::ClearAccumulators() noexcept {
+		mForceAccum = {};
+		mTorqueAccum = {};
+	}
+}
+
+#endif // __RIGIDBODY_INL__
\ No newline at end of file
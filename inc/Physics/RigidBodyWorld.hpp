@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Contact.hpp"
+#include "ContactResolver.hpp"
+#include "SweepAndPrune.hpp"
+
+namespace Physics::Cyclone {
+	class RigidBody;
+	class CollisionPrimitive;
+
+	// Keeps track of a set of rigid bodies and their collision primitives,
+	// and provides the means to update them all.
+	class RigidBodyWorld {
+	public:
+		static const UINT ParallelThreshold = 256;
+
+	public:
+		RigidBodyWorld(UINT iterations = 10);
+		virtual ~RigidBodyWorld() = default;
+
+	public:
+		__forceinline const std::vector<Contact>& Contacts() const noexcept;
+		__forceinline ContactResolver& Resolver() noexcept;
+
+	public:
+		// The world does not own bodies or primitives; they must outlive
+		// their registration.
+		void AddBody(RigidBody* pBody);
+		void RemoveBody(RigidBody* pBody);
+
+		void AddPrimitive(CollisionPrimitive* pPrimitive);
+		void RemovePrimitive(CollisionPrimitive* pPrimitive);
+
+		// Clears accumulated forces and refreshes derived data, so forces
+		// can be added for the coming step.
+		void StartFrame();
+
+		// Processes all the physics for the world: velocities, collision
+		// detection, contact resolution and positions, in that order.
+		void RunPhysics(float dt);
+
+	protected:
+		void GenerateContacts();
+
+	protected:
+		std::vector<RigidBody*> mBodies;
+		std::vector<CollisionPrimitive*> mPrimitives;
+
+		SweepAndPrune mBroadphase;
+		ContactResolver mResolver;
+
+		std::vector<SweepAndPrune::Pair> mPairs;
+		std::vector<Contact> mContacts;
+		std::vector<std::vector<Contact>> mChunkContacts;
+	};
+}
+
+#include "RigidBodyWorld.inl"
\ No newline at end of file
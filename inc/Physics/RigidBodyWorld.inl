@@ -0,0 +1,14 @@
+#ifndef __RIGIDBODYWORLD_INL__
+#define __RIGIDBODYWORLD_INL__
+
+namespace Physics::Cyclone {
+	const std::vector<Contact>& RigidBodyWorld::Contacts() const noexcept {
+		return mContacts;
+	}
+
+	ContactResolver& RigidBodyWorld::Resolver() noexcept {
+		return mResolver;
+	}
+}
+
+#endif // __RIGIDBODYWORLD_INL__
\ No newline at end of file
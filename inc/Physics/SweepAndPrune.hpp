@@ -0,0 +1,42 @@
+#pragma once
+
+namespace Physics::Cyclone {
+	class CollisionPrimitive;
+
+	// Sort-and-sweep broadphase. Bounds are sorted along the axis with the
+	// largest spread of centres, which keeps the sweep short for scenes that
+	// are wide rather than tall, such as stacks laid out on a floor.
+	class SweepAndPrune {
+	public:
+		struct Pair {
+			const CollisionPrimitive* First;
+			const CollisionPrimitive* Second;
+		};
+
+	public:
+		static const UINT ParallelThreshold = 1024;
+
+	protected:
+		struct Proxy {
+			float Min;
+			float Max;
+			DirectX::SimpleMath::Vector3 Bottom;
+			DirectX::SimpleMath::Vector3 Top;
+			const CollisionPrimitive* Primitive;
+		};
+
+	public:
+		SweepAndPrune() = default;
+		virtual ~SweepAndPrune() = default;
+
+	public:
+		// Rebuilds the proxies from the primitives and writes every pair
+		// whose bounds overlap. Pairs of static primitives and pairs on the
+		// same body are skipped. Output order is deterministic.
+		void FindPairs(const std::vector<CollisionPrimitive*>& primitives, std::vector<Pair>& pairs);
+
+	protected:
+		std::vector<Proxy> mProxies;
+		std::vector<std::vector<Pair>> mChunkPairs;
+	};
+}
\ No newline at end of file
@@ -3,8 +3,17 @@
 #include "Common/Foundation/Mesh/Mesh.hpp"
 #include "Common/Util/HashUtil.hpp"
 #include "Render/DX/DxLowRenderer.hpp"
+#include "Render/DX/Foundation/Util/TextureCooker.hpp"
 
 namespace Common {
+	namespace Util {
+		class FrustumCuller;
+		class DrawBatcher;
+		class LightClusterer;
+		class MaskedOcclusionCuller;
+		class DynamicResolution;
+	}
+
 	namespace Foundation {
 		struct Light;
 
@@ -33,11 +42,19 @@ namespace Render {
 		namespace Foundation {
 			struct RenderItem;
 
+			namespace Core {
+				class PipelineStateCache;
+				class RenderGraph;
+				class UploadQueue;
+				class TextureStreamer;
+			}
+
 			namespace Resource {
 				struct MeshGeometry;
 				struct SubmeshGeometry;
 
 				struct MaterialData;
+				struct Texture;
 
 				class FrameResource;
 			}
@@ -56,6 +73,21 @@ namespace Render {
 		}
 
 		class DxRenderer : public DxLowRenderer {
+		private:
+			// Caster membership of one light, reused while neither the
+			// light's matrices nor the set of render items change.
+			struct ShadowCasterCache {
+				std::array<DirectX::XMFLOAT4X4, 6> ViewProjs{};
+				UINT FaceCount{};
+				UINT64 BoundsVersion{ UINT64_MAX };
+
+				std::vector<UINT8> Membership{};
+				std::vector<UINT> Indices{};
+
+				// Casters the light's atlas pages were last checked against.
+				UINT CasterCount{ UINT_MAX };
+			};
+
 		public:
 			DxRenderer();
 			virtual ~DxRenderer();
@@ -87,10 +119,13 @@ namespace Render {
 		private:
 			BOOL UpdateConstantBuffers();
 			BOOL UpdateMainPassCB();
+			BOOL UpdateShadowPages();
 			BOOL UpdateLightCB();
+			BOOL UpdateLightClusters();
 			BOOL UpdateObjectCB();
 			BOOL UpdateMaterialCB();
 			BOOL UpdateProjectToCubeCB();
+			BOOL UpdateIrradianceSHCB();
 			BOOL UpdateAmbientOcclusionCB();
 			BOOL UpdateRayGenCB();
 			BOOL UpdateRaySortingCB();
@@ -99,29 +134,49 @@ namespace Render {
 			BOOL UpdateCrossBilateralFilterCB();
 			BOOL UpdateAtrousWaveletTransformFilterCB();
 			BOOL UpdateContactShadowCB();
+			BOOL ResolvePendingUploads();
+			BOOL SwapStreamedTextures();
 			BOOL ResolvePendingLights();
 			BOOL PopulateRendableItems();
+			void CullOccludedItems();
+			BOOL PopulateShadowCasters();
+			BOOL BuildDrawBatches();
+			BOOL StreamTextures();
+
+			// Lets the resolution controller pick the render size for the
+			// coming frame and hands the area to render into to every pass.
+			BOOL UpdateRenderResolution(FLOAT deltaTime);
+			void SetRenderResolution(UINT width, UINT height);
 
 		private:
 			BOOL BuildMeshGeometry(
-				ID3D12GraphicsCommandList6* const pCmdList,
 				Foundation::Resource::SubmeshGeometry* const pSubMesh,
 				const std::vector<Common::Foundation::Mesh::Vertex>& vertices, 
 				const std::vector<std::uint16_t>& indices,
 				const std::string& name,
 				Foundation::Resource::MeshGeometry*& pMeshGeo);
 			BOOL BuildMeshGeometry(
-				ID3D12GraphicsCommandList6* const pCmdList,
 				Common::Foundation::Mesh::Mesh* const pMesh,
 				Foundation::Resource::MeshGeometry*& pMeshGeo);
+			BOOL UploadGeometryBuffer(
+				const void* const pData,
+				UINT byteSize,
+				Microsoft::WRL::ComPtr<ID3D12Resource>& buffer);
 			BOOL BuildMeshMaterial(
-				ID3D12GraphicsCommandList6* const pCmdList,
 				Common::Foundation::Mesh::Material* const pMaterial,
 				Foundation::Resource::MaterialData*& pMatData);
 			BOOL BuildMeshTextures(
-				ID3D12GraphicsCommandList6* const pCmdList,
 				Common::Foundation::Mesh::Material* const pMaterial,
 				Foundation::Resource::MaterialData* const pMatData);
+			BOOL BuildMeshTexture(
+				const std::string& filePath,
+				Foundation::Util::TextureUsage::Type usage,
+				Foundation::Resource::MaterialData* const pMatData,
+				INT& mapIndex);
+			void BindStreamedTexture(
+				UINT texture,
+				Foundation::Resource::MaterialData* const pMatData,
+				INT& mapIndex);
 
 		private: // Functions that is called only once in Initialize
 			BOOL InitShadingObjects();
@@ -131,6 +186,7 @@ namespace Render {
 			BOOL BuildLights();
 			BOOL BuildScene();
 
+			BOOL BuildRenderGraph();
 			BOOL DrawImGui();
 
 			BOOL DrawShadow();
@@ -146,6 +202,16 @@ namespace Render {
 		private:
 			FLOAT mDeltaTime{};
 
+			// Render resolution; every pass up to tone mapping runs at it, in
+			// the top-left of targets kept at the window size, and the resolve
+			// stretches the result over the back buffer.
+			UINT mRenderWidth{};
+			UINT mRenderHeight{};
+			D3D12_VIEWPORT mRenderViewport{};
+			D3D12_RECT mRenderScissorRect{};
+			DirectX::XMFLOAT2 mRenderUVScale{ 1.f, 1.f };
+			std::unique_ptr<Common::Util::DynamicResolution> mDynamicResolution{};
+
 			// Frame resource
 			std::vector<std::unique_ptr<Foundation::Resource::FrameResource>> mFrameResources{};
 			Foundation::Resource::FrameResource* mpCurrentFrameResource{};
@@ -154,22 +220,81 @@ namespace Render {
 			// Shading objects
 			std::unique_ptr<Shading::Util::ShadingObjectManager> mShadingObjectManager{};
 			std::unique_ptr<Shading::Util::ShaderManager> mShaderManager{};
+			std::unique_ptr<Foundation::Core::PipelineStateCache> mPipelineStateCache{};
+
+			// Frame graph
+			std::unique_ptr<Foundation::Core::RenderGraph> mRenderGraph{};
+
+			// Upload queue
+			std::unique_ptr<Foundation::Core::UploadQueue> mUploadQueue{};
 
 			// Meshes
 			std::unordered_map<Common::Foundation::Hash, std::unique_ptr<Foundation::Resource::MeshGeometry>> mMeshGeometries{};
 			std::vector<std::unique_ptr<Foundation::Resource::MaterialData>> mMaterials{};
+			// Geometries by Mesh::Hash and materials by content, so meshes
+			// loaded more than once share both.
+			std::unordered_map<Common::Foundation::Hash, Foundation::Resource::MeshGeometry*> mMeshGeometryRefs{};
+			std::unordered_map<Common::Foundation::Hash, Foundation::Resource::MaterialData*> mMaterialRefs{};
+			// Ids of the distinct geometry subsets, see RenderItem::SubmeshId.
+			std::unordered_map<Common::Foundation::Hash, UINT> mSubmeshIds{};
+			// Material maps by file path; each holds a bindless slot.
+			std::unordered_map<std::string, std::unique_ptr<Foundation::Resource::Texture>> mTextures{};
+			// Geometries whose buffers are still on the copy queue.
+			std::vector<Foundation::Resource::MeshGeometry*> mUploadingGeometries{};
+			// Render items waiting for their geometry or material maps.
+			std::vector<Foundation::RenderItem*> mUploadingRenderItems{};
+
+			// Texture streaming
+			std::unique_ptr<Foundation::Core::TextureStreamer> mTextureStreamer{};
+			// Streamed material maps by file path, the map indices that follow
+			// each one's slot, and the streamed maps each material samples.
+			std::unordered_map<std::string, UINT> mStreamedTextures{};
+			std::vector<std::vector<std::pair<Foundation::Resource::MaterialData*, INT*>>> mStreamedMapRefs{};
+			std::unordered_map<Foundation::Resource::MaterialData*, std::vector<UINT>> mMaterialStreamedTextures{};
+			// Frames counted for the residency manager's LRU.
+			UINT64 mStreamingFrame{};
 
 			// Render items
 			std::vector<std::unique_ptr<Foundation::RenderItem>> mRenderItems{};
 			std::unordered_map<Common::Foundation::Hash, Foundation::RenderItem*> mRenderItemRefs{};
 			std::array<std::vector<Foundation::RenderItem*>, Common::Foundation::Mesh::RenderType::Count> mRenderItemGroups{};
 			std::array<std::vector<Foundation::RenderItem*>, Common::Foundation::Mesh::RenderType::Count> mRendableItems{};
+			// Rendable items that also pass the camera frustum test.
+			std::array<std::vector<Foundation::RenderItem*>, Common::Foundation::Mesh::RenderType::Count> mVisibleItems{};
 			std::unique_ptr<Foundation::RenderItem> mSkySphere{};
 			BOOL mbMeshGeometryAdded{};
 
 			// Scene bounds
 			DirectX::BoundingSphere mSceneBounds{};
 
+			// Frustum culling
+			std::unique_ptr<Common::Util::FrustumCuller> mFrustumCuller{};
+			std::vector<UINT> mVisibleIndices{};
+
+			// Draw batching
+			std::unique_ptr<Common::Util::DrawBatcher> mDrawBatcher{};
+			// Visible opaques in the batcher's draw order.
+			std::vector<Foundation::RenderItem*> mBatchedItems{};
+
+			// Light clustering
+			std::unique_ptr<Common::Util::LightClusterer> mLightClusterer{};
+			// Point and spot lights added past the shadowed ones; shaded
+			// without shadows through the cluster lists.
+			std::vector<std::shared_ptr<Common::Foundation::Light>> mClusteredLights{};
+
+			// Occlusion culling
+			std::unique_ptr<Common::Util::MaskedOcclusionCuller> mOcclusionCuller{};
+			// Occluders of the current frame with their screen coverage.
+			std::vector<std::pair<FLOAT, Foundation::RenderItem*>> mOccluders{};
+
+			// Shadow caster culling
+			std::array<ShadowCasterCache, MaxLights> mShadowCasterCaches{};
+			std::array<std::vector<Foundation::RenderItem*>, MaxLights> mShadowCasters{};
+			// Culling slots whose bounds changed since casters were last culled.
+			std::vector<UINT> mMovedCullingIndices{};
+			// Bumped when render items are added, which invalidates every cache.
+			UINT64 mShadowBoundsVersion{};
+
 			// Acceleration structure manager
 			std::unique_ptr<Shading::Util::AccelerationStructureManager> mAccelerationStructureManager{};
 
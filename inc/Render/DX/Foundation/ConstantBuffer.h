@@ -22,25 +22,40 @@ namespace ConstantBuffers {
 		FLOAT				__ConstantPad0__;
 
 		DirectX::XMFLOAT2	JitteredOffset;
+		// Maps viewport UVs onto the part of the targets rendered into,
+		// this frame and the previous one.
+		DirectX::XMFLOAT2	UVScale;
+
+		DirectX::XMFLOAT2	PrevUVScale;
 		FLOAT				__ConstantPad1__;
 		FLOAT				__ConstantPad2__;
 	};
 
 	struct LightCB {
 		UINT	LightCount;
-		FLOAT	__ConstantPad0__;
-		FLOAT	__ConstantPad1__;
-		FLOAT	__ConstantPad2__;
+		// Unshadowed lights read through the cluster lists.
+		UINT	ClusteredLightCount;
+		// Depth slice of view depth z is floor(log2(z) * scale + bias).
+		FLOAT	ClusterDepthScale;
+		FLOAT	ClusterDepthBias;
 
 		Common::Foundation::Light Lights[MaxLights];
+
+		// Shadow atlas page of face f of light i at [i * 6 + f]; xy scales
+		// and zw offsets the face UV. Zero for faces without a page.
+		DirectX::XMFLOAT4 ShadowPages[MaxLights * 6];
 	};
 
+	// Padded to the constant buffer stride, so the GBuffer can also read
+	// the whole array as a structured buffer.
 	struct ObjectCB {
 		DirectX::XMFLOAT4X4 World;
 		DirectX::XMFLOAT4X4 PrevWorld;
 		DirectX::XMFLOAT4X4 TexTransform;
 		DirectX::XMFLOAT4	Center;
 		DirectX::XMFLOAT4	Extents;
+		DirectX::XMFLOAT4	__ConstantPad0__;
+		DirectX::XMFLOAT4	__ConstantPad1__;
 	};
 
 	struct MaterialCB {
@@ -72,6 +87,10 @@ namespace ConstantBuffers {
 		DirectX::XMFLOAT4X4 Views[6];
 	};
 
+	struct IrradianceSHCB {
+		DirectX::XMFLOAT4 Coeffs[9];
+	};
+
 	struct AmbientOcclusionCB {
 		DirectX::XMFLOAT4X4	View;
 		DirectX::XMFLOAT4X4	Proj;
@@ -87,7 +106,7 @@ namespace ConstantBuffers {
 		UINT				SampleCount;
 		UINT				FrameCount;
 		FLOAT				OcclusionStrength;
-		FLOAT				__ConstantPad0__;
+		BOOL				HalfResolutionEnabled;
 
 		DirectX::XMUINT2	TextureDim;
 		BOOL				CheckerboardRayGenEnabled;
@@ -103,6 +122,11 @@ namespace ConstantBuffers {
 		UINT				NumSamplesPerSet;
 		UINT				NumPixelsPerDimPerSet;
 		UINT				Seed;
+
+		BOOL				HalfResolutionEnabled;
+		FLOAT				__ConstantPad0__;
+		FLOAT				__ConstantPad1__;
+		FLOAT				__ConstantPad2__;
 	};
 
 	struct RaySortingCB {
@@ -0,0 +1,47 @@
+#pragma once
+
+namespace Render::DX::Foundation::Core {
+	// Tracks what the compute work the direct queue has not waited for yet
+	// does to the graph's resources, and decides when the direct queue has
+	// to wait. Both queues may read a resource at once as long as neither
+	// changes its state; anything else on a resource the compute work uses
+	// has to wait. Resources are graph indices, so this needs no device.
+	class AsyncComputeTracker {
+	private:
+		enum Access {
+			E_None = 0,
+			E_Read,
+			E_Write
+		};
+
+	public:
+		AsyncComputeTracker() = default;
+		virtual ~AsyncComputeTracker() = default;
+
+	public:
+		__forceinline BOOL InFlight() const;
+
+	public:
+		// Drops all uses; nothing is in flight afterwards.
+		void Reset(UINT resourceCount);
+
+		// Whether an access of a later pass has to wait for the compute
+		// work. currState is the state the resource is in right now.
+		BOOL NeedsJoin(UINT resource, BOOL write, D3D12_RESOURCE_STATES state, D3D12_RESOURCE_STATES currState) const;
+
+		// The direct queue waited for the compute work.
+		void Join();
+
+		// Records an access of a pass sent to the compute queue. A resource
+		// the pass transitioned itself is recorded as written.
+		void Use(UINT resource, BOOL write);
+		// The recorded pass was submitted.
+		void Fork();
+
+	private:
+		std::vector<Access> mAccesses{};
+		BOOL mbInFlight{};
+	};
+}
+
+#include "Render/DX/Foundation/Core/AsyncComputeTracker.inl"
\ No newline at end of file
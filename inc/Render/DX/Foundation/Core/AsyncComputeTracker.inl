@@ -0,0 +1,8 @@
+#ifndef __ASYNCCOMPUTETRACKER_INL__
+#define __ASYNCCOMPUTETRACKER_INL__
+
+BOOL Render::DX::Foundation::Core::AsyncComputeTracker::InFlight() const {
+	return mbInFlight;
+}
+
+#endif // __ASYNCCOMPUTETRACKER_INL__
\ No newline at end of file
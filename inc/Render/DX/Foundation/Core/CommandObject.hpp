@@ -16,6 +16,19 @@ namespace Render::DX::Foundation {
 		private:
 			friend class Util::D3D12Util;
 
+		public:
+			// Records into the given list on behalf of the given worker.
+			using RecordFunc = std::function<BOOL(ID3D12GraphicsCommandList6* const, UINT)>;
+
+			// CPU time of the last RecordCommandLists call.
+			struct RecordStats {
+				UINT WorkerCount{};
+				// From the first reset until every worker finished.
+				FLOAT WallTime{};
+				// Sum of the time each worker spent recording.
+				FLOAT BusyTime{};
+			};
+
 		public:
 			CommandObject();
 			virtual ~CommandObject();
@@ -38,23 +51,66 @@ namespace Render::DX::Foundation {
 			BOOL ExecuteCommandLists();
 			BOOL ResetCommandLists(ID3D12CommandAllocator* const allocs[], ID3D12PipelineState* const pPipelineState = nullptr);
 
+			// Resets the first count lists and records them on count workers,
+			// list i on worker i, worker 0 being the calling thread. Pending
+			// barriers go to list 0. The lists stay open so the caller can
+			// append to them before submitting with ExecuteCommandLists(count).
+			BOOL RecordCommandLists(
+				ID3D12CommandAllocator* const allocs[],
+				UINT count,
+				ID3D12PipelineState* const pPipelineState,
+				const RecordFunc& func);
+			// Submits the first count lists in one batch, in index order.
+			BOOL ExecuteCommandLists(UINT count);
+
 			BOOL WaitCompletion(UINT64 fence);
 			UINT64 IncreaseFence();
 
 			BOOL Signal();
 
+			// Holds back work submitted afterwards until another queue, e.g.
+			// the copy queue, signals the fence. The CPU does not wait.
+			BOOL WaitOnQueue(ID3D12Fence* const pFence, UINT64 value);
+
+			// Deferred barriers and discards are recorded at the start of the
+			// next command list that is reset, so a render graph can place
+			// them between passes without submitting a list of its own.
+			void QueueBarriers(const std::vector<D3D12_RESOURCE_BARRIER>& barriers);
+			void QueueDiscard(ID3D12Resource* const pResource);
+
+			// Work recorded between BeginAsyncCompute and EndAsyncCompute goes
+			// to the compute queue: ResetCommandList, CommandList and
+			// ExecuteCommandList act on the compute list, backed by
+			// pComputeAlloc, whatever list and allocator are asked for.
+			// Pending barriers and discards are submitted on the direct queue
+			// first, with pDirectAlloc, and the compute queue waits for all
+			// the direct work submitted so far.
+			BOOL BeginAsyncCompute(ID3D12CommandAllocator* const pDirectAlloc, ID3D12CommandAllocator* const pComputeAlloc);
+			BOOL EndAsyncCompute();
+			// Holds back direct work submitted afterwards until the compute
+			// queue has run what was submitted to it. Does nothing when there
+			// is nothing to wait for.
+			BOOL JoinAsyncCompute();
+
 		private:
 #ifdef _DEBUG
 			BOOL CreateDebugObjects();
 #endif
+			void FlushPendingCommands(ID3D12GraphicsCommandList* const pCmdList);
+
+			BOOL FlushComputeQueue();
+
 			BOOL CreateCommandQueue();
 			BOOL CreateDirectCommandObjects();
 			BOOL CreateMultiCommandObjects(UINT numThreads);
+			BOOL CreateComputeCommandObjects();
 			BOOL CreateFence();
 
 		public:
 			__forceinline ID3D12GraphicsCommandList6* DirectCommandList() const;
 			__forceinline ID3D12GraphicsCommandList6* CommandList(UINT index) const;
+			__forceinline constexpr UINT ThreadCount() const noexcept;
+			__forceinline const RecordStats& LastRecordStats() const noexcept;
 
 			__forceinline constexpr UINT64 CurrentFence() const noexcept;
 
@@ -79,6 +135,27 @@ namespace Render::DX::Foundation {
 
 			Microsoft::WRL::ComPtr<ID3D12Fence> mFence{};
 			UINT64 mCurrentFence{};
+
+			// Async compute. The list is created from an allocator of its own
+			// and is reset with the one of the frame resource afterwards.
+			Microsoft::WRL::ComPtr<ID3D12CommandQueue> mComputeQueue{};
+			Microsoft::WRL::ComPtr<ID3D12CommandAllocator> mComputeCmdListAlloc{};
+			Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList6> mComputeCommandList{};
+			ID3D12CommandAllocator* mpComputeAlloc{};
+			BOOL mbAsyncCompute{};
+
+			// Signaled by the direct queue when compute work may start, and
+			// by the compute queue when it is done.
+			Microsoft::WRL::ComPtr<ID3D12Fence> mForkFence{};
+			UINT64 mForkFenceValue{};
+			Microsoft::WRL::ComPtr<ID3D12Fence> mComputeFence{};
+			UINT64 mComputeFenceValue{};
+			UINT64 mJoinedComputeFence{};
+
+			std::vector<D3D12_RESOURCE_BARRIER> mPendingBarriers{};
+			std::vector<ID3D12Resource*> mPendingDiscards{};
+
+			RecordStats mRecordStats{};
 		};
 	}
 }
@@ -6,7 +6,15 @@ ID3D12GraphicsCommandList6* Render::DX::Foundation::Core::CommandObject::DirectC
 }
 
 ID3D12GraphicsCommandList6* Render::DX::Foundation::Core::CommandObject::CommandList(UINT index) const {
-	return mMultiCommandLists[index].Get();
+	return mbAsyncCompute ? mComputeCommandList.Get() : mMultiCommandLists[index].Get();
+}
+
+constexpr UINT Render::DX::Foundation::Core::CommandObject::ThreadCount() const noexcept {
+	return mThreadCount;
+}
+
+const Render::DX::Foundation::Core::CommandObject::RecordStats& Render::DX::Foundation::Core::CommandObject::LastRecordStats() const noexcept {
+	return mRecordStats;
 }
 
 constexpr UINT64 Render::DX::Foundation::Core::CommandObject::CurrentFence() const noexcept {
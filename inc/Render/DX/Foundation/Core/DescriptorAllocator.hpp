@@ -0,0 +1,63 @@
+#pragma once
+
+namespace Render::DX::Foundation::Core {
+	// Hands out indices into one shader-visible descriptor heap split into
+	// three regions:
+	//
+	//   [ persistent ranges | slots | transient ring (one segment per frame) ]
+	//
+	// Persistent ranges live as long as the heap. Slots are freed one by
+	// one and are reused once the GPU is done with the frame that freed
+	// them, so a slot index can serve as a bindless table index. Transient
+	// descriptors are valid for one frame; a frame's segment is recycled
+	// when that frame resource comes around again.
+	//
+	// Only index bookkeeping lives here; no D3D12 object is touched.
+	class DescriptorAllocator {
+	public:
+		struct Layout {
+			UINT PersistentCount{};
+			UINT SlotCount{};
+			UINT TransientCountPerFrame{};
+			UINT FrameCount{ 1 };
+		};
+
+	public:
+		DescriptorAllocator() = default;
+		virtual ~DescriptorAllocator() = default;
+
+	public:
+		__forceinline constexpr UINT Capacity() const noexcept;
+		__forceinline constexpr UINT SlotBase() const noexcept;
+		__forceinline constexpr UINT TransientBase() const noexcept;
+		__forceinline UINT FreeSlotCount() const noexcept;
+
+	public:
+		void Initialize(const Layout& layout);
+
+		BOOL AllocateRange(UINT count, UINT& index);
+
+		// Slot indices are relative to SlotBase.
+		BOOL AllocateSlot(UINT& slot);
+		// The slot stays taken until ReleaseSlots sees fence completed.
+		// Fences have to be passed in non-decreasing order.
+		void FreeSlot(UINT slot, UINT64 fence);
+		void ReleaseSlots(UINT64 completedFence);
+
+		void BeginFrame(UINT frameIndex);
+		BOOL AllocateTransient(UINT count, UINT& index);
+
+	private:
+		Layout mLayout{};
+
+		UINT mNextPersistent{};
+
+		std::vector<UINT> mFreeSlots{};
+		std::queue<std::pair<UINT64, UINT>> mRetiredSlots{};
+
+		UINT mTransientBegin{};
+		UINT mNextTransient{};
+	};
+}
+
+#include "Render/DX/Foundation/Core/DescriptorAllocator.inl"
\ No newline at end of file
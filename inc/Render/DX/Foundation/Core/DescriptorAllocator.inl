@@ -0,0 +1,20 @@
+#ifndef __DESCRIPTORALLOCATOR_INL__
+#define __DESCRIPTORALLOCATOR_INL__
+
+constexpr UINT Render::DX::Foundation::Core::DescriptorAllocator::Capacity() const noexcept {
+	return mLayout.PersistentCount + mLayout.SlotCount + mLayout.TransientCountPerFrame * mLayout.FrameCount;
+}
+
+constexpr UINT Render::DX::Foundation::Core::DescriptorAllocator::SlotBase() const noexcept {
+	return mLayout.PersistentCount;
+}
+
+constexpr UINT Render::DX::Foundation::Core::DescriptorAllocator::TransientBase() const noexcept {
+	return mLayout.PersistentCount + mLayout.SlotCount;
+}
+
+UINT Render::DX::Foundation::Core::DescriptorAllocator::FreeSlotCount() const noexcept {
+	return static_cast<UINT>(mFreeSlots.size());
+}
+
+#endif // __DESCRIPTORALLOCATOR_INL__
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Render/DX/Foundation/Core/DescriptorAllocator.hpp"
+
 namespace Common::Debug {
 	struct LogFile;
 }
@@ -28,6 +30,11 @@ namespace Render::DX {
 			__forceinline D3D12_CPU_DESCRIPTOR_HANDLE RtvCpuOffset(UINT offset);
 			__forceinline D3D12_CPU_DESCRIPTOR_HANDLE DsvCpuOffset(UINT offset);
 
+			__forceinline D3D12_CPU_DESCRIPTOR_HANDLE TextureSlotCpuHandle(UINT slot) const;
+			// Start of the bindless texture table; material map indices are
+			// slots in it.
+			__forceinline D3D12_GPU_DESCRIPTOR_HANDLE TextureTableGpuHandle() const;
+
 		public:
 			BOOL Initialize(
 				Common::Debug::LogFile* const pLogFile,
@@ -36,11 +43,29 @@ namespace Render::DX {
 				DepthStencilBuffer* const pDepthStencilBuffer);
 			void CleanUp();
 
-			BOOL CreateDescriptorHeaps(UINT numCbvSrvUav, UINT numRtv, UINT numDsv);
+			// The CBV/SRV/UAV heap also gets numTextureSlots bindless slots
+			// and numTransientsPerFrame descriptors per frame resource behind
+			// the ones handed out through CbvSrvUavCpuOffset.
+			BOOL CreateDescriptorHeaps(
+				UINT numCbvSrvUav, UINT numRtv, UINT numDsv,
+				UINT numTextureSlots = 0, UINT numTransientsPerFrame = 0, UINT numFrames = 1);
 			BOOL BuildDescriptors();
 
 			BOOL SetDescriptorHeap(ID3D12GraphicsCommandList4* const pCmdList);
 
+			BOOL AllocateTextureSlot(UINT& slot);
+			// The slot is reused once the direct queue has passed fence.
+			void FreeTextureSlot(UINT slot, UINT64 fence);
+			void ReleaseTextureSlots(UINT64 completedFence);
+
+			// Transient descriptors are valid until the same frame resource
+			// begins again.
+			void BeginFrame(UINT frameIndex);
+			BOOL AllocateTransient(
+				UINT count, 
+				D3D12_CPU_DESCRIPTOR_HANDLE& hCpu, 
+				D3D12_GPU_DESCRIPTOR_HANDLE& hGpu);
+
 		private:
 			BOOL BuildDescriptorSizes();
 
@@ -68,6 +93,11 @@ namespace Render::DX {
 			CD3DX12_GPU_DESCRIPTOR_HANDLE mhGpuCbvSrvUav{};
 			CD3DX12_CPU_DESCRIPTOR_HANDLE mhCpuDsv{};
 			CD3DX12_CPU_DESCRIPTOR_HANDLE mhCpuRtv{};
+
+			// CBV/SRV/UAV heap layout
+			DescriptorAllocator mCbvSrvUavAllocator{};
+			D3D12_CPU_DESCRIPTOR_HANDLE mhCpuCbvSrvUavStart{};
+			D3D12_GPU_DESCRIPTOR_HANDLE mhGpuCbvSrvUavStart{};
 		};
 	}
 }
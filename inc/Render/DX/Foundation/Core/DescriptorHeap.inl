@@ -17,4 +17,14 @@ D3D12_CPU_DESCRIPTOR_HANDLE Render::DX::Foundation::Core::DescriptorHeap::DsvCpu
 	return mhCpuDsv.Offset(offset, mDsvDescriptorSize);
 }
 
+D3D12_CPU_DESCRIPTOR_HANDLE Render::DX::Foundation::Core::DescriptorHeap::TextureSlotCpuHandle(UINT slot) const {
+	return CD3DX12_CPU_DESCRIPTOR_HANDLE(
+		mhCpuCbvSrvUavStart, static_cast<INT>(mCbvSrvUavAllocator.SlotBase() + slot), mCbvSrvUavDescriptorSize);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE Render::DX::Foundation::Core::DescriptorHeap::TextureTableGpuHandle() const {
+	return CD3DX12_GPU_DESCRIPTOR_HANDLE(
+		mhGpuCbvSrvUavStart, static_cast<INT>(mCbvSrvUavAllocator.SlotBase()), mCbvSrvUavDescriptorSize);
+}
+
 #endif // __DESCRIPTORHEAP_INL__
\ No newline at end of file
@@ -22,10 +22,14 @@ namespace Render::DX {
 
 		namespace Core {
 			class Factory;
+			class PipelineStateCache;
+			class RenderGraph;
 
 			class Device {
 			private:
 				friend class Factory;
+				friend class PipelineStateCache;
+				friend class RenderGraph;
 				friend class Resource::GpuResource;
 				friend class Util::D3D12Util;
 				friend class ImGuiManager::DX::DxImGuiManager;
@@ -39,13 +43,22 @@ namespace Render::DX {
 				void CleanUp();
 
 			public:
+				// Pipeline states created through D3D12Util go through the
+				// cache while one is set.
+				__forceinline void SetPipelineStateCache(PipelineStateCache* const pCache);
+
 				BOOL QueryInterface(Microsoft::WRL::ComPtr<ID3D12InfoQueue1>& pInfoQueue);
 
-				BOOL CreateCommandQueue(Microsoft::WRL::ComPtr<ID3D12CommandQueue>& pCommandQueue);
-				BOOL CreateCommandAllocator(Microsoft::WRL::ComPtr<ID3D12CommandAllocator>& pCommandAllocator);
+				BOOL CreateCommandQueue(
+					Microsoft::WRL::ComPtr<ID3D12CommandQueue>& pCommandQueue,
+					D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT);
+				BOOL CreateCommandAllocator(
+					Microsoft::WRL::ComPtr<ID3D12CommandAllocator>& pCommandAllocator,
+					D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT);
 				BOOL CreateCommandList(
 					ID3D12CommandAllocator* const pCommandAllocator,
-					Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList6>& pCommandList);
+					Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList6>& pCommandList,
+					D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT);
 				BOOL CreateFence(Microsoft::WRL::ComPtr<ID3D12Fence>& pFence);
 
 				BOOL CreateRtvDescriptorHeap(Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>& pDescHeap, UINT numDescs);
@@ -108,6 +121,8 @@ namespace Render::DX {
 				Common::Debug::LogFile* mpLogFile{};
 
 				Microsoft::WRL::ComPtr<ID3D12Device5> md3dDevice{};
+
+				PipelineStateCache* mpPipelineStateCache{};
 			};
 		}
 	}
@@ -1,4 +1,8 @@
 #ifndef __DEVICE_INL__
 #define __DEVICE_INL__
 
+void Render::DX::Foundation::Core::Device::SetPipelineStateCache(PipelineStateCache* const pCache) {
+	mpPipelineStateCache = pCache;
+}
+
 #endif // __DEVICE_INL__
\ No newline at end of file
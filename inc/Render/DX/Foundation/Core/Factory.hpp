@@ -30,12 +30,16 @@ namespace Render::DX::Foundation {
 			BOOL SortAdapters();
 			BOOL GetAdapters(std::vector<std::wstring>& adapters);
 			BOOL SelectAdapter(Device* const pDevice, UINT adapterIndex, BOOL& bRaytracingSupported);
+			// Software rasterizer; lets GPU code run on machines without a
+			// capable adapter, e.g. test runners.
+			BOOL SelectWarpAdapter(Device* const pDevice, BOOL& bRaytracingSupported);
 
 		public:
 			__forceinline BOOL AllowTearing() const;
 
 		private:
 			BOOL CreateFactory();
+			BOOL CreateDevice(Device* const pDevice, IDXGIAdapter1* const pAdapter, BOOL& bRaytracingSupported);
 
 		private:
 			BOOL mbCleanedUp{};
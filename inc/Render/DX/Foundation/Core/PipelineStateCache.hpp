@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+
+#include "Common/Util/HashUtil.hpp"
+
+namespace Common::Debug {
+	struct LogFile;
+}
+
+namespace Render::DX::Foundation::Core {
+	class Device;
+
+	// Persists pipeline states between runs through ID3D12PipelineLibrary.
+	// Pipelines are stored under a hash of their full description, so a
+	// changed shader, root signature or fixed-function state misses instead
+	// of loading a stale pipeline. Creation is safe from several threads at
+	// once.
+	class PipelineStateCache {
+	public:
+		PipelineStateCache();
+		virtual ~PipelineStateCache();
+
+	public:
+		__forceinline UINT HitCount() const;
+		__forceinline UINT MissCount() const;
+
+	public:
+		BOOL Initialize(Common::Debug::LogFile* const pLogFile, Device* const pDevice, LPCWSTR filePath);
+		void CleanUp();
+
+		// Rewrites the library when this run created pipelines it lacked.
+		// The new library holds exactly the pipelines created this run.
+		BOOL Serialize();
+
+	public:
+		// Attaches the hash of the serialized blob a root signature was
+		// created from, since the runtime cannot give the blob back. Root
+		// signatures without one still work but only hit within a run.
+		static void TagRootSignature(
+			ID3D12RootSignature* const pRootSignature, 
+			const void* const pBlob, 
+			SIZE_T size);
+
+		// Library keys of the descriptions, exposed for testing.
+		static std::wstring PipelineKey(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, LPCWSTR name);
+		static std::wstring PipelineKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, LPCWSTR name);
+		static std::wstring PipelineKey(const D3DX12_MESH_SHADER_PIPELINE_STATE_DESC& desc, LPCWSTR name);
+
+	public:
+		BOOL CreateComputePipelineState(
+			const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+			const IID& riid,
+			void** const ppPipelineState,
+			LPCWSTR name);
+		BOOL CreateGraphicsPipelineState(
+			const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+			const IID& riid,
+			void** const ppPipelineState,
+			LPCWSTR name);
+		BOOL CreatePipelineState(
+			const D3DX12_MESH_SHADER_PIPELINE_STATE_DESC& desc,
+			const IID& riid,
+			void** const ppPipelineState,
+			LPCWSTR name);
+
+	private:
+		BOOL CreateLibrary(const void* const pData, size_t size);
+		void Track(const std::wstring& key, ID3D12PipelineState* const pPipelineState, BOOL bLoaded);
+
+	private:
+		BOOL mbCleanedUp{};
+		Common::Debug::LogFile* mpLogFile{};
+
+		Device* mpDevice{};
+		std::wstring mFilePath{};
+
+		// The library reads from this blob for its whole lifetime.
+		std::vector<CHAR> mLibraryData{};
+		Microsoft::WRL::ComPtr<ID3D12PipelineLibrary1> mLibrary{};
+
+		std::mutex mTrackMutex{};
+		std::unordered_map<std::wstring, Microsoft::WRL::ComPtr<ID3D12PipelineState>> mPipelineStates{};
+		BOOL mbDirty{};
+
+		std::atomic<UINT> mHitCount{};
+		std::atomic<UINT> mMissCount{};
+	};
+}
+
+#include "Render/DX/Foundation/Core/PipelineStateCache.inl"
\ No newline at end of file
@@ -0,0 +1,8 @@
+#ifndef __PIPELINESTATECACHE_INL__
+#define __PIPELINESTATECACHE_INL__
+
+UINT Render::DX::Foundation::Core::PipelineStateCache::HitCount() const { return mHitCount.load(); }
+
+UINT Render::DX::Foundation::Core::PipelineStateCache::MissCount() const { return mMissCount.load(); }
+
+#endif // __PIPELINESTATECACHE_INL__
\ No newline at end of file
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "Common/Util/HashUtil.hpp"
+
+namespace Common::Debug {
+	struct LogFile;
+}
+
+namespace Render::DX::Foundation {
+	namespace Resource {
+		class GpuResource;
+	}
+
+	namespace Core {
+		class Device;
+		class CommandObject;
+		class RenderGraph;
+
+		// Records what a pass touches. The state given for a resource is the
+		// one the pass expects on entry; passes may still transition it
+		// internally afterwards.
+		class RenderPassBuilder {
+		public:
+			using RealizeFunc = std::function<BOOL()>;
+
+		public:
+			RenderPassBuilder(RenderGraph* const pGraph, UINT pass);
+			virtual ~RenderPassBuilder() = default;
+
+		public:
+			RenderPassBuilder& Read(Resource::GpuResource* const pResource, D3D12_RESOURCE_STATES state);
+			RenderPassBuilder& Write(Resource::GpuResource* const pResource, D3D12_RESOURCE_STATES state);
+
+			// Backs the resource with graph-owned memory that is shared with
+			// other transients whose lifetimes do not overlap. The resource is
+			// written by this pass first. realizeFunc runs whenever the graph
+			// places the resource again, so views can be rebuilt.
+			RenderPassBuilder& Transient(
+				Resource::GpuResource* const pResource,
+				const D3D12_RESOURCE_DESC& desc,
+				D3D12_RESOURCE_STATES state,
+				LPCWSTR name,
+				RealizeFunc realizeFunc);
+
+			// Keeps the pass even when nothing reads what it writes.
+			RenderPassBuilder& SideEffect();
+
+			// Runs the pass on the compute queue, next to the direct passes
+			// that follow it, until one of them writes what the pass uses or
+			// needs a barrier on it. The pass may only dispatch and may not
+			// use transients. Its reads should be declared in the states it
+			// uses them in, since the compute queue cannot enter every state.
+			RenderPassBuilder& AsyncCompute();
+
+		private:
+			RenderGraph* mpGraph{};
+			UINT mPass{};
+		};
+
+		// Orders, culls and synchronizes the passes of one frame. Passes are
+		// declared again every frame; the placement of transients is kept
+		// for as long as the declared set of transients does not change.
+		class RenderGraph {
+		private:
+			friend class RenderPassBuilder;
+
+		public:
+			using ExecuteFunc = std::function<BOOL()>;
+
+			struct Stats {
+				UINT PassCount{};
+				UINT CulledPassCount{};
+				UINT AsyncPassCount{};
+				// Times the direct queue waited for the compute queue.
+				UINT JoinCount{};
+				UINT BarrierCount{};
+				UINT TransientCount{};
+				// Sum of transient sizes, i.e. what committed resources would take.
+				UINT64 TransientBytes{};
+				// What the shared heaps actually take.
+				UINT64 HeapBytes{};
+			};
+
+		private:
+			// Tier 1 heaps cannot mix these, so each gets its own heap.
+			enum HeapType {
+				E_Buffer = 0,
+				E_RtDsTexture,
+				E_Texture,
+				HeapTypeCount
+			};
+
+			struct Access {
+				UINT Resource{};
+				D3D12_RESOURCE_STATES State{};
+				BOOL Write{};
+			};
+
+			struct Pass {
+				std::wstring Name{};
+				ExecuteFunc Func{};
+				std::vector<Access> Accesses{};
+				BOOL SideEffect{};
+				BOOL AsyncCompute{};
+				BOOL Culled{};
+			};
+
+			struct ResourceNode {
+				Resource::GpuResource* Resource{};
+				BOOL Output{};
+
+				BOOL Transient{};
+				D3D12_RESOURCE_DESC Desc{};
+				std::wstring Name{};
+				RenderPassBuilder::RealizeFunc RealizeFunc{};
+				HeapType Heap{};
+				UINT64 Size{};
+				UINT64 Alignment{};
+				UINT64 Offset{};
+				UINT FirstPass{};
+				UINT LastPass{};
+				// Shares memory with another transient, so its first use in a
+				// frame needs an aliasing barrier.
+				BOOL Aliased{};
+			};
+
+		public:
+			RenderGraph();
+			virtual ~RenderGraph();
+
+		public:
+			__forceinline const Stats& FrameStats() const;
+
+		public:
+			BOOL Initialize(Common::Debug::LogFile* const pLogFile, Device* const pDevice, CommandObject* const pCommandObject);
+			void CleanUp();
+
+			// Drops the passes declared for the previous frame.
+			void Reset();
+
+			RenderPassBuilder AddPass(LPCWSTR name, ExecuteFunc func);
+
+			// Marks a resource whose contents are consumed outside the graph,
+			// e.g. the back buffer. Passes that do not contribute to an
+			// output, directly or through other passes, are culled.
+			void MarkOutput(Resource::GpuResource* const pResource);
+
+			// Culls passes, computes transient lifetimes and packs transients
+			// into heaps. Touches no D3D12 object.
+			BOOL Compile();
+
+			// Places transients when their packing changed, then runs the
+			// remaining passes with the barriers each one needs on entry.
+			// The allocators back the lists that fork work off to the compute
+			// queue and the compute lists themselves.
+			BOOL Execute(ID3D12CommandAllocator* const pDirectAlloc, ID3D12CommandAllocator* const pComputeAlloc);
+
+		private:
+			UINT ResourceIndex(Resource::GpuResource* const pResource);
+			void AddAccess(UINT pass, Resource::GpuResource* const pResource, D3D12_RESOURCE_STATES state, BOOL write);
+			BOOL AddTransient(
+				UINT pass,
+				Resource::GpuResource* const pResource,
+				const D3D12_RESOURCE_DESC& desc,
+				D3D12_RESOURCE_STATES state,
+				LPCWSTR name,
+				RenderPassBuilder::RealizeFunc realizeFunc);
+
+			void CullPasses();
+			void ComputeLifetimes();
+			void PackTransients();
+
+			BOOL RealizeTransients();
+
+		private:
+			BOOL mbCleanedUp{};
+			Common::Debug::LogFile* mpLogFile{};
+
+			Device* mpDevice{};
+			CommandObject* mpCommandObject{};
+
+			std::vector<Pass> mPasses{};
+			std::vector<ResourceNode> mResources{};
+			std::unordered_map<Resource::GpuResource*, UINT> mResourceIndices{};
+			BOOL mbInvalidTransient{};
+
+			std::array<UINT64, HeapTypeCount> mHeapSizes{};
+			Common::Foundation::Hash mLayoutHash{};
+
+			// Placement that is live on the GPU; survives Reset.
+			std::array<Microsoft::WRL::ComPtr<ID3D12Heap>, HeapTypeCount> mHeaps{};
+			Common::Foundation::Hash mRealizedLayoutHash{};
+			std::vector<Resource::GpuResource*> mRealizedResources{};
+
+			std::unordered_map<Common::Foundation::Hash, D3D12_RESOURCE_ALLOCATION_INFO> mAllocationInfos{};
+
+			Stats mStats{};
+		};
+	}
+}
+
+#include "Render/DX/Foundation/Core/RenderGraph.inl"
\ No newline at end of file
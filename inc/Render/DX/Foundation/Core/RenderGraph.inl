@@ -0,0 +1,8 @@
+#ifndef __RENDERGRAPH_INL__
+#define __RENDERGRAPH_INL__
+
+const Render::DX::Foundation::Core::RenderGraph::Stats& Render::DX::Foundation::Core::RenderGraph::FrameStats() const {
+	return mStats;
+}
+
+#endif // __RENDERGRAPH_INL__
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <future>
+
+#include "Common/Util/TextureResidency.hpp"
+
+namespace Common::Debug {
+	struct LogFile;
+}
+
+namespace Render::DX::Foundation::Core {
+	class Device;
+	class UploadQueue;
+	class DescriptorHeap;
+
+	// Streams the mip chains of block-compressed DDS textures. A texture
+	// starts out with its mip tail only; the mips above are read from disk
+	// on worker threads as the residency manager hands out loads. Whenever
+	// the resident mips change, a resource holding exactly those mips is
+	// filled through the upload queue and takes over a new bindless slot
+	// once the copy has landed, so the draw thread never waits on the disk
+	// or on the copy queue. A replacement copies the mips it shares with the
+	// current resource on the GPU and uploads only the newly read ones, whose
+	// CPU copies are dropped as soon as they are staged.
+	class TextureStreamer {
+	private:
+		struct StreamedTexture {
+			std::wstring FilePath{};
+			DirectX::TexMetadata Metadata{};
+
+			// File offset, row pitch and size of each mip.
+			std::vector<UINT64> MipOffsets{};
+			std::vector<UINT64> RowPitches{};
+			std::vector<UINT64> MipSizes{};
+			// Mips read from disk and not yet staged for upload.
+			std::vector<std::vector<BYTE>> MipData{};
+
+			Microsoft::WRL::ComPtr<ID3D12Resource> Resource{};
+			UINT Slot{};
+			UINT TopMip{};
+			// Upload-queue fence the resource lands with. Replacements copy
+			// from it, so none is started before it has passed.
+			UINT64 Fence{};
+
+			// Replacement still on the copy queue.
+			Microsoft::WRL::ComPtr<ID3D12Resource> Pending{};
+			UINT PendingTopMip{};
+			UINT64 PendingFence{};
+		};
+
+		struct MipRead {
+			UINT Texture{};
+			UINT Mip{};
+			std::future<std::vector<BYTE>> Data{};
+		};
+
+		struct RetiredResource {
+			UINT64 Fence{};
+			Microsoft::WRL::ComPtr<ID3D12Resource> Resource{};
+		};
+
+	public:
+		TextureStreamer();
+		virtual ~TextureStreamer();
+
+	public:
+		__forceinline UINT Slot(UINT texture) const;
+		__forceinline UINT TopMip(UINT texture) const;
+		// Texels along the longer side of the most detailed mip.
+		__forceinline UINT MaxExtent(UINT texture) const;
+
+		__forceinline constexpr UINT64 ResidentBytes() const;
+		// Textures whose slot changed in the last SwapLanded.
+		__forceinline constexpr const std::vector<UINT>& SwappedTextures() const;
+
+	public:
+		BOOL Initialize(
+			Common::Debug::LogFile* const pLogFile,
+			Device* const pDevice,
+			UploadQueue* const pUploadQueue,
+			DescriptorHeap* const pDescriptorHeap,
+			UINT64 budget,
+			UINT maxReadsInFlight);
+		void CleanUp();
+
+		void SetBudget(UINT64 budget);
+
+		// Reads the mip tail right away and gives it a slot. Fails without
+		// logging when the file does not stream; the caller loads it in
+		// full instead.
+		BOOL AddTexture(LPCWSTR filePath, UINT& texture);
+
+		void RequestMip(UINT texture, UINT mip, UINT64 frame);
+
+		// Lands finished reads, lets the residency manager trade loads
+		// against evictions and records uploads of the replacements.
+		BOOL Update(UINT64 frame);
+
+		// Moves the textures whose replacement has landed to new slots.
+		// fence is the last value the direct queue was asked to signal; the
+		// old slots and resources go once it has passed.
+		BOOL SwapLanded(UINT64 fence);
+
+		// Lets go of the resources the GPU has stopped reading.
+		void ReleaseRetired(UINT64 completedFence);
+
+	private:
+		BOOL ReadLayout(LPCWSTR filePath, StreamedTexture& texture) const;
+		BOOL CreateResidentResource(
+			StreamedTexture& texture,
+			UINT topMip,
+			Microsoft::WRL::ComPtr<ID3D12Resource>& resource);
+		void CreateShaderResourceView(ID3D12Resource* const pResource, UINT slot);
+
+	private:
+		BOOL mbCleanedUp{};
+		Common::Debug::LogFile* mpLogFile{};
+
+		Device* mpDevice{};
+		UploadQueue* mpUploadQueue{};
+		DescriptorHeap* mpDescriptorHeap{};
+
+		Common::Util::TextureResidency mResidency{};
+
+		std::vector<StreamedTexture> mTextures{};
+		std::vector<MipRead> mReads{};
+		std::vector<RetiredResource> mRetired{};
+
+		std::vector<Common::Util::TextureResidency::Change> mLoads{};
+		std::vector<Common::Util::TextureResidency::Change> mEvictions{};
+		std::vector<UINT> mSwapped{};
+	};
+}
+
+#include "Render/DX/Foundation/Core/TextureStreamer.inl"
\ No newline at end of file
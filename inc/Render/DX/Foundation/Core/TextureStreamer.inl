@@ -0,0 +1,25 @@
+#ifndef __TEXTURESTREAMER_INL__
+#define __TEXTURESTREAMER_INL__
+
+UINT Render::DX::Foundation::Core::TextureStreamer::Slot(UINT texture) const {
+	return mTextures[texture].Slot;
+}
+
+UINT Render::DX::Foundation::Core::TextureStreamer::TopMip(UINT texture) const {
+	return mTextures[texture].TopMip;
+}
+
+UINT Render::DX::Foundation::Core::TextureStreamer::MaxExtent(UINT texture) const {
+	const auto& metadata = mTextures[texture].Metadata;
+	return static_cast<UINT>(std::max(metadata.width, metadata.height));
+}
+
+constexpr UINT64 Render::DX::Foundation::Core::TextureStreamer::ResidentBytes() const {
+	return mResidency.ResidentBytes();
+}
+
+constexpr const std::vector<UINT>& Render::DX::Foundation::Core::TextureStreamer::SwappedTextures() const {
+	return mSwapped;
+}
+
+#endif // __TEXTURESTREAMER_INL__
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+namespace Common::Debug {
+	struct LogFile;
+}
+
+namespace Render::DX::Foundation::Core {
+	class Device;
+
+	// Streams buffer and texture data to default-heap resources on a copy
+	// queue. Source data is staged in one persistently mapped upload ring;
+	// ring space is handed back once the copy fence passes the batch that
+	// used it. Uploads recorded between two Submit calls go to the GPU as
+	// one batch. Meant to be fed by a single thread.
+	class UploadQueue {
+	private:
+		struct Batch {
+			UINT64 Fence{};
+			// Ring head when the batch was submitted; the tail moves here
+			// once the batch has landed.
+			UINT64 RingEnd{};
+			Microsoft::WRL::ComPtr<ID3D12CommandAllocator> Allocator{};
+			// Dedicated upload buffers for data too large for the ring.
+			std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> Temporaries{};
+		};
+
+	public:
+		UploadQueue();
+		virtual ~UploadQueue();
+
+	public:
+		__forceinline ID3D12Fence* Fence() const;
+		// Value the batch being recorded signals once it has landed.
+		__forceinline constexpr UINT64 PendingFence() const noexcept;
+		__forceinline constexpr UINT64 SubmittedFence() const noexcept;
+		// Value the most recently recorded upload lands with; the submitted
+		// one when nothing is being recorded.
+		__forceinline constexpr UINT64 LastFence() const noexcept;
+		// Times the ring ran full and the CPU had to wait for a batch.
+		__forceinline constexpr UINT StallCount() const noexcept;
+
+	public:
+		BOOL Initialize(Common::Debug::LogFile* const pLogFile, Device* const pDevice, UINT64 ringSize);
+		void CleanUp();
+
+		// Destination resources have to be in the common state; they decay
+		// back to it once the batch has landed.
+		BOOL UploadBuffer(ID3D12Resource* const pDest, UINT64 destOffset, const void* const pData, UINT64 byteSize);
+		BOOL UploadTexture(
+			ID3D12Resource* const pDest,
+			UINT firstSubresource,
+			UINT numSubresources,
+			const D3D12_SUBRESOURCE_DATA* const pSubresources);
+		// Copies one subresource into another of the same size. The source
+		// has to be in the common state as well, and has to stay alive
+		// until the batch has landed.
+		BOOL CopyTexture(
+			ID3D12Resource* const pDest,
+			UINT destSubresource,
+			ID3D12Resource* const pSrc,
+			UINT srcSubresource);
+
+		// Kicks off what was recorded since the last call. Does nothing
+		// when nothing was recorded.
+		BOOL Submit();
+
+		BOOL IsCompleted(UINT64 fence) const;
+
+		// Submits and waits until every batch has landed.
+		BOOL Flush();
+
+	private:
+		BOOL BeginBatch();
+		BOOL Allocate(UINT64 byteSize, UINT64 alignment, ID3D12Resource*& pBuffer, UINT64& offset, BYTE*& pMapped);
+		BOOL WaitCompletion(UINT64 fence);
+		void Retire();
+
+	private:
+		BOOL mbCleanedUp{};
+		Common::Debug::LogFile* mpLogFile{};
+
+		Device* mpDevice{};
+
+		Microsoft::WRL::ComPtr<ID3D12CommandQueue> mCommandQueue{};
+		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList6> mCommandList{};
+		Microsoft::WRL::ComPtr<ID3D12CommandAllocator> mAllocator{};
+		std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> mFreeAllocators{};
+		BOOL mbRecording{};
+
+		Microsoft::WRL::ComPtr<ID3D12Fence> mFence{};
+		UINT64 mNextFence{ 1 };
+		UINT64 mSubmittedFence{};
+
+		Microsoft::WRL::ComPtr<ID3D12Resource> mRing{};
+		BYTE* mpMappedRing{};
+		UINT64 mRingSize{};
+		// Offsets keep growing across wraps and the ring position is taken
+		// modulo the size. Both go back to zero whenever the ring drains.
+		UINT64 mRingHead{};
+		UINT64 mRingTail{};
+
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> mTemporaries{};
+		std::queue<Batch> mBatches{};
+
+		UINT mStallCount{};
+	};
+}
+
+#include "Render/DX/Foundation/Core/UploadQueue.inl"
\ No newline at end of file
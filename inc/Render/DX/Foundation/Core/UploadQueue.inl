@@ -0,0 +1,24 @@
+#ifndef __UPLOADQUEUE_INL__
+#define __UPLOADQUEUE_INL__
+
+ID3D12Fence* Render::DX::Foundation::Core::UploadQueue::Fence() const {
+	return mFence.Get();
+}
+
+constexpr UINT64 Render::DX::Foundation::Core::UploadQueue::PendingFence() const noexcept {
+	return mNextFence;
+}
+
+constexpr UINT64 Render::DX::Foundation::Core::UploadQueue::SubmittedFence() const noexcept {
+	return mSubmittedFence;
+}
+
+constexpr UINT64 Render::DX::Foundation::Core::UploadQueue::LastFence() const noexcept {
+	return mbRecording ? mNextFence : mSubmittedFence;
+}
+
+constexpr UINT Render::DX::Foundation::Core::UploadQueue::StallCount() const noexcept {
+	return mStallCount;
+}
+
+#endif // __UPLOADQUEUE_INL__
\ No newline at end of file
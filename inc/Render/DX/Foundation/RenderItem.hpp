@@ -41,8 +41,21 @@ namespace Render::DX::Foundation {
 
 		Resource::MaterialData* Material{};
 
+		// Shared by every item drawing the same subset of the same geometry;
+		// draw batching merges such items into one instanced draw.
+		UINT SubmeshId{};
+
+		// Local-space bounds of the submesh and the slot holding its
+		// world-space bounds in the renderer's frustum culler.
+		DirectX::BoundingBox Bounds{};
+		UINT CullingIndex{};
+
 		BOOL RebuildAccerationStructure{ TRUE };
 
+		// Upload-queue fence the geometry and material maps of the item
+		// land with. The item stays hidden until it is cleared.
+		UINT64 UploadFence{};
+
 	public:
 		static Common::Foundation::Hash Hash(const RenderItem* ptr);
 	};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Render/DX/Foundation/HlslCompaction.h"
 #include "Render/DX/Foundation/Util/UploadBufferWrapper.hpp"
 
 namespace Common::Debug {
@@ -23,6 +24,8 @@ namespace Render::DX::Foundation {
 		public:
 			__forceinline ID3D12CommandAllocator* CommandAllocator(UINT index) const;
 			__forceinline void CommandAllocators(std::vector<ID3D12CommandAllocator*>& allocs) const;
+			// Backs the lists recorded for the async compute queue.
+			__forceinline ID3D12CommandAllocator* ComputeCommandAllocator() const;
 
 		public:
 			BOOL Initialize(
@@ -53,6 +56,7 @@ namespace Render::DX::Foundation {
 			Core::Device* mpDevice{};
 
 			std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> mCmdAllocators{};
+			Microsoft::WRL::ComPtr<ID3D12CommandAllocator> mComputeCmdAllocator{};
 
 			UINT mThreadCount{};
 
@@ -62,6 +66,7 @@ namespace Render::DX::Foundation {
 			UploadBufferWrapper<ConstantBuffers::ObjectCB> ObjectCB{};
 			UploadBufferWrapper<ConstantBuffers::MaterialCB> MaterialCB{};
 			UploadBufferWrapper<ConstantBuffers::ProjectToCubeCB> ProjectToCubeCB{};
+			UploadBufferWrapper<ConstantBuffers::IrradianceSHCB> IrradianceSHCB{};
 			UploadBufferWrapper<ConstantBuffers::AmbientOcclusionCB> AmbientOcclusionCB{};
 			UploadBufferWrapper<ConstantBuffers::RayGenCB> RayGenCB{};
 			UploadBufferWrapper<ConstantBuffers::RaySortingCB> RaySortingCB{};
@@ -70,6 +75,19 @@ namespace Render::DX::Foundation {
 			UploadBufferWrapper<ConstantBuffers::SVGF::BlendWithCurrentFrameCB> BlendWithCurrentFrameCB{};
 			UploadBufferWrapper<ConstantBuffers::SVGF::AtrousWaveletTransformFilterCB> AtrousWaveletTransformFilterCB{};
 			UploadBufferWrapper<ConstantBuffers::ContactShadowCB> ContactShadowCB{};
+
+			// Object indices of the batched GBuffer draws, in draw order.
+			UploadBufferWrapper<UINT> InstanceIndices{};
+
+			// Read by the instance culling pass; one record per object.
+			UploadBufferWrapper<ShadingConvention::GpuCulling::InstanceBounds> InstanceBounds{};
+			UploadBufferWrapper<ShadingConvention::GBuffer::IndirectCommand> IndirectCommands{};
+
+			// Read by the deferred lighting pass; the index list names lights
+			// of ClusteredLights.
+			UploadBufferWrapper<Common::Foundation::Light> ClusteredLights{};
+			UploadBufferWrapper<ShadingConvention::LightCluster::Cluster> LightClusters{};
+			UploadBufferWrapper<UINT> ClusterLightIndices{};
 		};
 	}
 }
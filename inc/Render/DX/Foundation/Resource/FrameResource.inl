@@ -10,4 +10,8 @@ void Render::DX::Foundation::Resource::FrameResource::CommandAllocators(std::vec
 		allocs.push_back(mCmdAllocators[i].Get());
 }
 
+ID3D12CommandAllocator* Render::DX::Foundation::Resource::FrameResource::ComputeCommandAllocator() const {
+	return mComputeCmdAllocator.Get();
+}
+
 #endif // __FRAMERESOURCE_INL__
\ No newline at end of file
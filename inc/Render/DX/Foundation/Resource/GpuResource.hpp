@@ -27,6 +27,16 @@ namespace Render::DX::Foundation {
 				D3D12_RESOURCE_STATES initialState,
 				const D3D12_CLEAR_VALUE* const pOptClear,
 				LPCWSTR pName = nullptr);
+			// Places the resource in memory owned by someone else, e.g. a
+			// heap shared by render graph transients.
+			BOOL Initialize(
+				Core::Device* const pDevice,
+				ID3D12Heap* const pHeap,
+				UINT64 heapOffset,
+				const D3D12_RESOURCE_DESC* const pRscDesc,
+				D3D12_RESOURCE_STATES initialState,
+				const D3D12_CLEAR_VALUE* const pOptClear,
+				LPCWSTR pName = nullptr);
 			void CleanUp();
 
 			BOOL OnResize(IDXGISwapChain* const pSwapChain, UINT index);
@@ -34,6 +44,9 @@ namespace Render::DX::Foundation {
 			void Swap(Microsoft::WRL::ComPtr<ID3D12Resource>& srcResource);
 			void Swap(ID3D12GraphicsCommandList* const pCmdList, Microsoft::WRL::ComPtr<ID3D12Resource>& srcResource, D3D12_RESOURCE_STATES initialState);
 			void Transite(ID3D12GraphicsCommandList* const pCmdList, D3D12_RESOURCE_STATES state);
+			// Appends the transition instead of recording it so callers can
+			// submit several in one ResourceBarrier call.
+			void Transite(std::vector<D3D12_RESOURCE_BARRIER>& barriers, D3D12_RESOURCE_STATES state);
 
 			__forceinline void Reset();
 
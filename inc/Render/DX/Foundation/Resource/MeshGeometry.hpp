@@ -18,9 +18,6 @@ namespace Render::DX::Foundation::Resource {
 		Microsoft::WRL::ComPtr<ID3D12Resource> VertexBufferGPU{};
 		Microsoft::WRL::ComPtr<ID3D12Resource> IndexBufferGPU{};
 
-		Microsoft::WRL::ComPtr<ID3D12Resource> VertexBufferUploader{};
-		Microsoft::WRL::ComPtr<ID3D12Resource> IndexBufferUploader{};
-
 		UINT VertexByteStride{};
 		UINT VertexBufferByteSize{};
 
@@ -29,12 +26,13 @@ namespace Render::DX::Foundation::Resource {
 		UINT IndexByteStride{};
 
 		UINT64 Fence{};
+		// Upload-queue fence the buffers land with.
+		UINT64 UploadFence{};
 
 		std::unordered_map<std::string, SubmeshGeometry> Subsets{};
 
 		D3D12_VERTEX_BUFFER_VIEW VertexBufferView() const;
 		D3D12_INDEX_BUFFER_VIEW IndexBufferView() const;
-		void DisposeUploaders();
 
 		static Common::Foundation::Hash Hash(MeshGeometry* ptr);
 	};
@@ -83,7 +83,6 @@ namespace ShadingConvention{
 #ifdef _HLSL
 		typedef HDR_FORMAT EquirectangularMapFormat;
 		typedef HDR_FORMAT EnvironmentCubeMapFormat;
-		typedef HDR_FORMAT DiffuseIrradianceCubeMapFormat;
 		typedef HDR_FORMAT PrefilteredEnvironmentCubeMapFormat;
 		typedef float2 BrdfLutMapFormat;
 
@@ -97,7 +96,6 @@ namespace ShadingConvention{
 #else
 		const DXGI_FORMAT EquirectangularMapFormat = HDR_FORMAT;
 		const DXGI_FORMAT EnvironmentCubeMapFormat = HDR_FORMAT;
-		const DXGI_FORMAT DiffuseIrradianceCubeMapFormat = HDR_FORMAT;
 		const DXGI_FORMAT PrefilteredEnvironmentCubeMapFormat = HDR_FORMAT;
 		const DXGI_FORMAT BrdfLutMapFormat = DXGI_FORMAT_R16G16_FLOAT;
 
@@ -206,6 +204,8 @@ namespace ShadingConvention{
 		FLOAT gExposure;					\
 		FLOAT gMiddleGrayKey;				\
 		UINT gTonemapperType;				\
+		FLOAT __Padding__;					\
+		DirectX::XMFLOAT2 gUVScale;			\
 	};
 #endif
 
@@ -227,6 +227,9 @@ namespace ShadingConvention{
 				E_Exposure = 0,
 				E_MiddleGray,
 				E_TonemapperType,
+				E_Padding,
+				E_UVScale_X,
+				E_UVScale_Y,
 				Count
 			};
 		}
@@ -235,7 +238,7 @@ namespace ShadingConvention{
 	}
 
 	namespace GBuffer {
-		static const UINT MaxNumTextures = 32;
+		static const UINT MaxNumTextures = 128;
 
 		static const FLOAT	InvalidNormalWValue		= -1.f;
 		static const UINT	InvalidNormalDepthValue	= 0;
@@ -253,10 +256,12 @@ namespace ShadingConvention{
 #ifndef GBuffer_Default_RCSTRUCT
 #define GBuffer_Default_RCSTRUCT {	\
 		DirectX::XMUINT2 gTexDim;	\
-		UINT gVertexCount;			\
-		UINT gIndexCount;			\
 		FLOAT gDitheringMaxDist;	\
 		FLOAT gDitheringMinDist;	\
+		UINT gVertexCount;			\
+		UINT gIndexCount;			\
+		UINT gInstanceBase;			\
+		UINT __Padding__;			\
 	};
 #endif
 
@@ -311,17 +316,152 @@ namespace ShadingConvention{
 					enum {
 					E_TexDim_X = 0,
 					E_TexDim_Y,
-					E_VertexCount,
-					E_IndexCount,
 					E_MaxDitheringDist,
 					E_MinDitheringDist,
+					E_VertexCount,
+					E_IndexCount,
+					E_InstanceBase,
+					E_Padding,
 					Count
 				};
 			}
 		}
+
+		// One record of the GPU-driven draw. The counts up to the padding
+		// are written over the root constants from E_VertexCount on; the
+		// fields after them depend on the pipeline. Both layouts match the
+		// argument order of the command signatures built by the GBuffer.
+		struct IndirectCommand {
+			D3D12_GPU_VIRTUAL_ADDRESS MaterialCB;
+			UINT VertexCount;
+			UINT IndexCount;
+			UINT InstanceBase;
+			UINT __Padding__;
+			union {
+				struct {
+					D3D12_VERTEX_BUFFER_VIEW		VertexBufferView;
+					D3D12_INDEX_BUFFER_VIEW			IndexBufferView;
+					D3D12_DRAW_INDEXED_ARGUMENTS	DrawArguments;
+				} Draw;
+				struct {
+					D3D12_GPU_VIRTUAL_ADDRESS		VertexBuffer;
+					D3D12_GPU_VIRTUAL_ADDRESS		IndexBuffer;
+					D3D12_DISPATCH_MESH_ARGUMENTS	DispatchArguments;
+				} Mesh;
+			};
+		};
 #endif 
 	}
 
+	namespace GpuCulling {
+		// Enough for a 16K depth buffer.
+		static const UINT MaxHiZMipCount = 15;
+
+		namespace ThreadGroup {
+			namespace BuildHiZ {
+				enum {
+					Width	= 8,
+					Height	= 8,
+					Depth	= 1,
+					Size	= Width * Height * Depth
+				};
+			}
+
+			namespace CullInstances {
+				enum {
+					Width	= 64,
+					Height	= 1,
+					Depth	= 1,
+					Size	= Width * Height * Depth
+				};
+			}
+		}
+
+		// World-space box of one instance. Instances whose geometry is
+		// still uploading keep their record with Drawable cleared.
+		struct InstanceBounds {
+			DirectX::XMFLOAT3	Center;
+			UINT				Drawable;
+			DirectX::XMFLOAT3	Extents;
+			FLOAT				__Padding__;
+		};
+
+#ifndef GpuCulling_BuildHiZ_RCSTRUCT
+#define GpuCulling_BuildHiZ_RCSTRUCT {	\
+		DirectX::XMUINT2 gSrcTexDim;	\
+		DirectX::XMUINT2 gDstTexDim;	\
+	};
+#endif
+
+#ifndef GpuCulling_CullInstances_RCSTRUCT
+#define GpuCulling_CullInstances_RCSTRUCT {	\
+		UINT gInstanceCount;				\
+		UINT gCommandByteStride;			\
+		DirectX::XMUINT2 gHiZTexDim;		\
+		UINT gHiZMipCount;					\
+		BOOL gOcclusionEnabled;				\
+	};
+#endif
+
+#ifdef _HLSL
+		typedef float HiZMapFormat;
+
+#ifndef GpuCulling_BuildHiZ_RootConstants
+#define GpuCulling_BuildHiZ_RootConstants(reg) cbuffer cbRootConstant : register(reg) GpuCulling_BuildHiZ_RCSTRUCT
+#endif
+
+#ifndef GpuCulling_CullInstances_RootConstants
+#define GpuCulling_CullInstances_RootConstants(reg) cbuffer cbRootConstant : register(reg) GpuCulling_CullInstances_RCSTRUCT
+#endif
+#else
+		const DXGI_FORMAT HiZMapFormat = DXGI_FORMAT_R32_FLOAT;
+
+		namespace RootConstant {
+			namespace BuildHiZ {
+				struct Struct GpuCulling_BuildHiZ_RCSTRUCT
+					enum {
+					E_SrcTexDim_X = 0,
+					E_SrcTexDim_Y,
+					E_DstTexDim_X,
+					E_DstTexDim_Y,
+					Count
+				};
+			}
+
+			namespace CullInstances {
+				struct Struct GpuCulling_CullInstances_RCSTRUCT
+					enum {
+					E_InstanceCount = 0,
+					E_CommandByteStride,
+					E_HiZTexDim_X,
+					E_HiZTexDim_Y,
+					E_HiZMipCount,
+					E_OcclusionEnabled,
+					Count
+				};
+			}
+		}
+#endif
+	}
+
+	namespace LightCluster {
+		static const UINT ClusterCountX = 16;
+		static const UINT ClusterCountY = 9;
+		static const UINT ClusterCountZ = 24;
+		static const UINT ClusterCount = ClusterCountX * ClusterCountY * ClusterCountZ;
+
+		// Capacity of the per-frame buffers. Lights and list entries past
+		// it are dropped.
+		static const UINT MaxLightCount = 1024;
+		static const UINT MaxLightIndexCount = ClusterCount * 64;
+
+		// Range of the cluster in the light index list.
+		struct Cluster {
+			UINT Offset;
+			UINT Count;
+		};
+	}
+
 	namespace BRDF {
 #ifndef BRDF_ComputeBRDF_RCSTRUCT
 #define BRDF_ComputeBRDF_RCSTRUCT {	\
@@ -370,14 +510,9 @@ namespace ShadingConvention{
 	namespace Shadow {
 		static const UINT CascadeCount = 3;
 
-		namespace ShadowMap {
-			enum Type {
-				E_Texture2D = 0,
-				E_Texture2DArray,
-				E_CubeMap,
-				Count
-			};
-		}
+		// A point light renders a page per cube face and a directional
+		// light one per cascade; spot lights use the first one only.
+		static const UINT MaxFaceCount = 6;
 
 		namespace ThreadGroup {
 			namespace DrawShadow {
@@ -449,6 +584,9 @@ namespace ShadingConvention{
 #define TAA_Default_RCSTRUCT {					\
 		FLOAT			  gModulationFactor;	\
 		DirectX::XMFLOAT2 gInvTexDim;			\
+		FLOAT			  __Padding__;			\
+		DirectX::XMFLOAT2 gUVScale;				\
+		DirectX::XMFLOAT2 gPrevUVScale;			\
 	};
 #endif
 
@@ -464,6 +602,11 @@ namespace ShadingConvention{
 					E_ModulationFactor = 0,
 					E_InvTexDimX,
 					E_InvTexDimY,
+					E_Padding,
+					E_UVScaleX,
+					E_UVScaleY,
+					E_PrevUVScaleX,
+					E_PrevUVScaleY,
 					Count
 				};
 			}
@@ -552,6 +695,7 @@ namespace ShadingConvention{
 #define SVGF_TemporalSupersamplingReverseReproject_RCSTRUCT {	\
 		DirectX::XMFLOAT2 gTexDim;								\
 		DirectX::XMFLOAT2 gInvTexDim;							\
+		DirectX::XMFLOAT2 gPrevTexDim;							\
 	};
 #endif
 
@@ -631,6 +775,8 @@ namespace ShadingConvention{
 					E_TexDim_Y,
 					E_InvTexDim_X,
 					E_InvTexDim_Y,
+					E_PrevTexDim_X,
+					E_PrevTexDim_Y,
 					Count
 				};
 			}
@@ -756,10 +902,23 @@ namespace ShadingConvention{
 	};
 #endif
 
+#ifndef BlurFilter_BilateralUpsample_RCSTRUCT
+#define BlurFilter_BilateralUpsample_RCSTRUCT {	\
+		DirectX::XMUINT2 gTexDim;				\
+		DirectX::XMUINT2 gLowResTexDim;			\
+		FLOAT gDepthSigma;						\
+		UINT gDepthNumMantissaBits;				\
+	};
+#endif
+
 #ifdef _HLSL
 #ifndef BlurFilter_Default_RootConstants
 #define BlurFilter_Default_RootConstants(reg) cbuffer cbRootConstants : register(reg) BlurFilter_Default_RCSTRUCT
 #endif
+
+#ifndef BlurFilter_BilateralUpsample_RootConstants
+#define BlurFilter_BilateralUpsample_RootConstants(reg) cbuffer cbRootConstants : register(reg) BlurFilter_BilateralUpsample_RCSTRUCT
+#endif
 #else
 		namespace RootConstant {
 			namespace Default {
@@ -772,6 +931,19 @@ namespace ShadingConvention{
 					Count
 				};
 			}
+
+			namespace BilateralUpsample {
+				struct Struct BlurFilter_BilateralUpsample_RCSTRUCT
+				enum {
+					E_TexDimX = 0,
+					E_TexDimY,
+					E_LowResTexDimX,
+					E_LowResTexDimY,
+					E_DepthSigma,
+					E_DepthNumMantissaBits,
+					Count
+				};
+			}
 		}
 #endif
 	}
@@ -814,6 +986,8 @@ namespace ShadingConvention{
 		FLOAT gUniformDensity;									\
 		FLOAT gAnisotropicCoefficient;							\
 		UINT  gFrameCount;										\
+		BOOL  gCheckerboardEnabled;								\
+		BOOL  gEvenColumnsActivated;							\
 	};
 #endif
 
@@ -823,6 +997,15 @@ namespace ShadingConvention{
 		FLOAT gFarZ;									\
 		FLOAT gDepthExponent;							\
 		FLOAT gDensityScale;							\
+		BOOL  gCheckerboardEnabled;						\
+		BOOL  gEvenColumnsActivated;					\
+	};
+#endif
+
+#ifndef VolumetricLight_BlendScattering_RCSTRUCT 
+#define VolumetricLight_BlendScattering_RCSTRUCT {	\
+		BOOL gCheckerboardEnabled;					\
+		BOOL gEvenColumnsActivated;					\
 	};
 #endif
 
@@ -845,6 +1028,10 @@ namespace ShadingConvention{
 #define VolumetricLight_AccumulateScattering_RootConstants(reg) cbuffer cbRootConstants : register (reg) VolumetricLight_AccumulateScattering_RCSTRUCT
 #endif
 
+#ifndef VolumetricLight_BlendScattering_RootConstants
+#define VolumetricLight_BlendScattering_RootConstants(reg) cbuffer cbRootConstants : register (reg) VolumetricLight_BlendScattering_RCSTRUCT
+#endif
+
 #ifndef VolumetricLight_ApplyFog_RootConstants
 #define VolumetricLight_ApplyFog_RootConstants(reg) cbuffer cbRootConstants : register (reg) VolumetricLight_ApplyFog_RCSTRUCT
 #endif
@@ -862,6 +1049,8 @@ namespace ShadingConvention{
 					E_UniformDensity,
 					E_AnisotropicCoefficient,
 					E_FrameCount,
+					E_CheckerboardEnabled,
+					E_EvenColumnsActivated,
 					Count
 				};
 			}
@@ -873,6 +1062,17 @@ namespace ShadingConvention{
 					E_FarPlane,
 					E_DepthExponent,
 					E_DensityScale,
+					E_CheckerboardEnabled,
+					E_EvenColumnsActivated,
+					Count
+				};
+			}
+
+			namespace BlendScattering {
+				struct Struct VolumetricLight_BlendScattering_RCSTRUCT
+				enum {
+					E_CheckerboardEnabled = 0,
+					E_EvenColumnsActivated,
 					Count
 				};
 			}
@@ -926,6 +1126,7 @@ namespace ShadingConvention{
 		FLOAT gLimit;					\
 		FLOAT gDepthBias;				\
 		UINT  gSampleCount;				\
+		DirectX::XMFLOAT2 gUVScale;		\
 	};
 #endif
 
@@ -942,6 +1143,8 @@ namespace ShadingConvention{
 					E_Limit,
 					E_DepthBias,
 					E_SampleCount,
+					E_UVScale_X,
+					E_UVScale_Y,
 					Count
 				};
 			}
@@ -963,6 +1166,12 @@ namespace ShadingConvention{
 	};
 #endif
 
+#ifndef Bloom_ApplyBloom_RCSTRUCT
+#define Bloom_ApplyBloom_RCSTRUCT {		\
+		DirectX::XMFLOAT2 gUVScale;		\
+	};
+#endif
+
 		namespace ThreadGroup {
 			namespace Default {
 				enum {
@@ -981,6 +1190,10 @@ namespace ShadingConvention{
 
 	#ifndef Bloom_BlendBloomWithDownSampled_RootConstants
 	#define Bloom_BlendBloomWithDownSampled_RootConstants(reg) cbuffer cbRootConstants : register(reg) Bloom_BlendBloomWithDownSampled_RCSTRUCT
+	#endif
+
+	#ifndef Bloom_ApplyBloom_RootConstants
+	#define Bloom_ApplyBloom_RootConstants(reg) cbuffer cbRootConstants : register(reg) Bloom_ApplyBloom_RCSTRUCT
 	#endif
 
 		typedef HDR_FORMAT HighlightMapFormat;
@@ -1006,6 +1219,15 @@ namespace ShadingConvention{
 					Count
 				};
 			}
+
+			namespace ApplyBloom {
+				struct Struct Bloom_ApplyBloom_RCSTRUCT
+				enum {
+					E_UVScaleX = 0,
+					E_UVScaleY,
+					Count
+				};
+			}
 		}
 	}
 
@@ -1063,6 +1285,7 @@ namespace ShadingConvention{
 		FLOAT gBokehRadius;				\
 		FLOAT gThreshold;				\
 		FLOAT gHighlightPower;			\
+		DirectX::XMFLOAT2 gUVScale;		\
 	};
 #endif
 
@@ -1070,6 +1293,7 @@ namespace ShadingConvention{
 #define DOF_BokehBlur3x3_RCSTRUCT {		\
 		DirectX::XMUINT2 gTexDim;		\
 		DirectX::XMFLOAT2 gInvTexDim;	\
+		DirectX::XMFLOAT2 gUVScale;		\
 	};
 #endif
 
@@ -1120,6 +1344,8 @@ namespace ShadingConvention{
 					E_BokehRadius,
 					E_Threshold,
 					E_HighlightPower,
+					E_UVScale_X,
+					E_UVScale_Y,
 					Count
 				};
 			}
@@ -1131,6 +1357,8 @@ namespace ShadingConvention{
 					E_TexDim_Y,
 					E_InvTexDim_X,
 					E_InvTexDim_Y,
+					E_UVScale_X,
+					E_UVScale_Y,
 					Count
 				};
 			}
@@ -1254,6 +1482,8 @@ namespace ShadingConvention{
 		FLOAT  gFeather;	/* 0~1 : smooth transition width (e.g. 0.1)			*/\
 		UINT  gMaxShiftPx;	/* max shift in pixels at extreme edge (e.g. 2~8)	*/\
 		FLOAT  gExponent;	/* curve control (e.g. 1~3)							*/\
+		FLOAT  __Padding__;														  \
+		DirectX::XMFLOAT2 gUVScale;												  \
 	};
 #endif
 
@@ -1273,12 +1503,62 @@ namespace ShadingConvention{
 					E_Feather,
 					E_MaxShiftPx,
 					E_Exponent,
+					E_Padding,
+					E_UVScale_X,
+					E_UVScale_Y,
 					Count
 				};
 			}
 		}
 #endif
 	}
+
+#ifndef _HLSL
+	// Root constants are set as Count 32-bit values copied from Struct, so
+	// every enum has to name each 32-bit member of its struct, padding included.
+	#define CheckRootConstantCount(ns) \
+		static_assert(sizeof(ns::Struct) == ns::Count * sizeof(UINT), #ns " root constants do not match their struct.");
+
+	CheckRootConstantCount(EnvironmentMap::RootConstant::DrawSkySphere)
+	CheckRootConstantCount(EnvironmentMap::RootConstant::ConvoluteSpecularIrradiance)
+	CheckRootConstantCount(MipmapGenerator::RootConstant::Default)
+	CheckRootConstantCount(EquirectangularConverter::RootConstant::ConvCubeToEquirect)
+	CheckRootConstantCount(GammaCorrection::RootConstant::Default)
+	CheckRootConstantCount(ToneMapping::RootConstant::Default)
+	CheckRootConstantCount(GBuffer::RootConstant::Default)
+	CheckRootConstantCount(GpuCulling::RootConstant::BuildHiZ)
+	CheckRootConstantCount(GpuCulling::RootConstant::CullInstances)
+	CheckRootConstantCount(BRDF::RootConstant::ComputeBRDF)
+	CheckRootConstantCount(BRDF::RootConstant::IntegrateIrradiance)
+	CheckRootConstantCount(Shadow::RootConstant::DrawZDepth)
+	CheckRootConstantCount(Shadow::RootConstant::DrawShadow)
+	CheckRootConstantCount(TAA::RootConstant::Default)
+	CheckRootConstantCount(SVGF::RootConstant::TemporalSupersamplingReverseReproject)
+	CheckRootConstantCount(SVGF::RootConstant::CalcDepthPartialDerivative)
+	CheckRootConstantCount(SVGF::RootConstant::AtrousWaveletTransformFilter)
+	CheckRootConstantCount(SVGF::RootConstant::DisocclusionBlur)
+	CheckRootConstantCount(SSAO::RootConstant::Default)
+	CheckRootConstantCount(BlurFilter::RootConstant::Default)
+	CheckRootConstantCount(BlurFilter::RootConstant::BilateralUpsample)
+	CheckRootConstantCount(VolumetricLight::RootConstant::CalculateScatteringAndDensity)
+	CheckRootConstantCount(VolumetricLight::RootConstant::AccumulateScattering)
+	CheckRootConstantCount(VolumetricLight::RootConstant::BlendScattering)
+	CheckRootConstantCount(VolumetricLight::RootConstant::ApplyFog)
+	CheckRootConstantCount(MotionBlur::RootConstant::Default)
+	CheckRootConstantCount(Bloom::RootConstant::ExtractHighlights)
+	CheckRootConstantCount(Bloom::RootConstant::BlendBloomWithDownSampled)
+	CheckRootConstantCount(Bloom::RootConstant::ApplyBloom)
+	CheckRootConstantCount(TextureScaler::RootConstant::DownSample6x6)
+	CheckRootConstantCount(DOF::RootConstant::CircleOfConfusion)
+	CheckRootConstantCount(DOF::RootConstant::Bokeh)
+	CheckRootConstantCount(DOF::RootConstant::BokehBlur3x3)
+	CheckRootConstantCount(EyeAdaption::RootConstant::LuminanceHistogram)
+	CheckRootConstantCount(EyeAdaption::RootConstant::PercentileExtract)
+	CheckRootConstantCount(EyeAdaption::RootConstant::TemporalSmoothing)
+	CheckRootConstantCount(ChromaticAberration::RootConstant::Default)
+
+	#undef CheckRootConstantCount
+#endif
 }
 
 #endif // __SHADINGCONVENTION_H__
\ No newline at end of file
@@ -20,6 +20,8 @@ namespace Render::DX {
 			class Device;
 			class CommandObject;
 			class DescriptorHeap;
+			class RenderPassBuilder;
+			class UploadQueue;
 		}
 
 		namespace Resource {
@@ -41,7 +43,6 @@ namespace Render::DX {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData);
 			virtual void CleanUp();
 
-			virtual BOOL CompileShaders();
 			virtual BOOL BuildRootSignatures();
 			virtual BOOL BuildPipelineStates();
 			virtual BOOL BuildDescriptors(Core::DescriptorHeap* const pDescHeap);
@@ -49,9 +50,21 @@ namespace Render::DX {
 			virtual BOOL BuildShaderTables(UINT numRitems);
 			virtual BOOL Update();
 
+		public:
+			// Targets stay at the client size; each frame renders into the
+			// top-left width x height of them, which uvScale maps UVs onto.
+			void SetRenderArea(UINT width, UINT height, const DirectX::XMFLOAT2& uvScale);
+
 		protected:
 			BOOL mbCleanedUp{};
 			Common::Debug::LogFile* mpLogFile{};
+
+			UINT mRenderWidth{};
+			UINT mRenderHeight{};
+			DirectX::XMFLOAT2 mUVScale{ 1.f, 1.f };
+			// Scale of the area the previous frame rendered into, for
+			// passes that read last frame's results.
+			DirectX::XMFLOAT2 mPrevUVScale{ 1.f, 1.f };
 		};
 	}
 }
\ No newline at end of file
@@ -19,6 +19,7 @@ namespace Render::DX::Foundation {
 		class Factory;
 		class Device;
 		class CommandObject;
+		class UploadQueue;
 	}
 
 	namespace Resource {
@@ -122,13 +123,21 @@ namespace Render::DX::Foundation {
 				const D3D12_DEPTH_STENCIL_VIEW_DESC* const pDesc,
 				D3D12_CPU_DESCRIPTOR_HANDLE destDescriptor);
 
+			// Only records the upload; the texture is usable once the upload
+			// queue has submitted it and its fence has passed.
 			static BOOL CreateTexture(
 				Core::Device* const pDevice, 
-				Core::CommandObject* const pCmdObject, 
+				Core::UploadQueue* const pUploadQueue, 
 				Resource::Texture* const pTexture, 
 				LPCWSTR filePath,
-				BOOL bGenerateMipmapIfMissing = FALSE,
 				UINT maxSize = 0);
+			// Empty default-heap texture in the common state, ready to be
+			// filled through the upload queue.
+			static BOOL CreateTexture(
+				Core::Device* const pDevice,
+				const D3D12_RESOURCE_DESC& desc,
+				const IID& riid,
+				void** const ppResource);
 
 			static BOOL CreateRootSignature(
 				Core::Device* const pDevice,
@@ -166,6 +175,15 @@ namespace Render::DX::Foundation {
 				const D3D12_STATE_OBJECT_DESC* pDesc,
 				const IID& riid,
 				void** const ppStateObject);
+			// pRootSignature is required once the signature changes root
+			// arguments.
+			static BOOL CreateCommandSignature(
+				Core::Device* const pDevice,
+				const D3D12_COMMAND_SIGNATURE_DESC& desc,
+				ID3D12RootSignature* const pRootSignature,
+				const IID& riid,
+				void** const ppCommandSignature,
+				LPCWSTR name);
 
 			static D3D12_INPUT_LAYOUT_DESC InputLayoutDesc();
 
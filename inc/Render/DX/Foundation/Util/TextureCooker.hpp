@@ -0,0 +1,56 @@
+#pragma once
+
+#include <directxtex_desktop_win10.2025.10.28.1/include/DirectXTex.h>
+
+namespace Common::Debug {
+	struct LogFile;
+}
+
+namespace Render::DX::Foundation::Util {
+	namespace TextureUsage {
+		enum Type {
+			E_Color = 0,	// BC1 when opaque, BC7 otherwise; keeps sRGB
+			E_Normal,		// BC5; z is rebuilt from x and y when sampled
+			E_Mask,			// BC4 for single-channel maps
+			E_HDR			// BC6H for environment maps
+		};
+	}
+
+	// Offline block compression of textures. Source images get a full mip
+	// chain and are encoded into a DDS file next to them, which the
+	// renderer then uploads as is. A cooked file is reused until its source
+	// is modified.
+	class TextureCooker {
+	public:
+		static BOOL Initialize(Common::Debug::LogFile* const pLogFile);
+
+	public:
+		// Writes the path of the cooked texture to cookedPath, cooking it
+		// first when it is missing or out of date. DDS sources and images
+		// that cannot be block-compressed are returned unchanged.
+		static BOOL CookTexture(
+			LPCWSTR srcPath,
+			TextureUsage::Type usage,
+			std::wstring& cookedPath);
+
+		// Builds the mip chain when the image has a single level and
+		// replaces the image with its block-compressed form.
+		static BOOL Compress(
+			DirectX::ScratchImage& image,
+			TextureUsage::Type usage);
+
+		// Peak signal-to-noise ratio of the top level in decibels, over the
+		// channels the usage keeps.
+		static BOOL ComputePSNR(
+			const DirectX::Image& reference,
+			const DirectX::Image& cooked,
+			TextureUsage::Type usage,
+			FLOAT& psnr);
+
+	private:
+		static DXGI_FORMAT CompressedFormat(const DirectX::ScratchImage& image, TextureUsage::Type usage);
+
+	private:
+		static Common::Debug::LogFile* mpLogFile;
+	};
+}
\ No newline at end of file
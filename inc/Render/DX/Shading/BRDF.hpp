@@ -4,19 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace BRDF {
-		namespace Shader {
-			enum Type {
-				VS_ComputeBRDF = 0,
-				MS_ComputeBRDF,
-				PS_ComputeBRDF_BlinnPhong,
-				PS_ComputeBRDF_CookTorrance,
-				VS_IntegrateIrradiance,
-				MS_IntegrateIrradiance,
-				PS_IntegrateIrradiance,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_ComputeBRDF = 0,
@@ -36,6 +23,9 @@ namespace Render::DX::Shading {
 					SI_RoughnessMetalicMap,
 					SI_PositionMap,
 					SI_ShadowMap,
+					SI_ClusteredLights,
+					SI_LightClusters,
+					SI_ClusterLightIndices,
 					Count
 				};
 			}
@@ -43,6 +33,7 @@ namespace Render::DX::Shading {
 				enum {
 					CB_Pass = 0,
 					RC_Consts,
+					CB_IrradianceSH,
 					SI_BackBuffer,
 					SI_AlbedoMap,
 					SI_NormalMap,
@@ -52,7 +43,6 @@ namespace Render::DX::Shading {
 					SI_PositionMap,
 					SI_AOMap,
 					SI_ReflectionMap,
-					SI_DiffuseIrradianceCubeMap,
 					SI_BrdfLutMap,
 					SI_PrefilteredEnvCubeMap,
 					Count
@@ -97,7 +87,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL OnResize(UINT width, UINT height) override;
@@ -127,7 +116,6 @@ namespace Render::DX::Shading {
 				Foundation::Resource::GpuResource* const pRoughnessMetalnessMap, D3D12_GPU_DESCRIPTOR_HANDLE si_roughnessMetalnessMap,
 				Foundation::Resource::GpuResource* const pPositionMap, D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
 				Foundation::Resource::GpuResource* const pAOMap, D3D12_GPU_DESCRIPTOR_HANDLE si_aoMap,
-				Foundation::Resource::GpuResource* const pDiffuseIrradianceMap, D3D12_GPU_DESCRIPTOR_HANDLE si_diffuseIrradianceMap,
 				Foundation::Resource::GpuResource* const pBrdfLutMap, D3D12_GPU_DESCRIPTOR_HANDLE si_brdfLutMap,
 				Foundation::Resource::GpuResource* const pPrefilteredEnvCubeMap, D3D12_GPU_DESCRIPTOR_HANDLE si_prefilteredEnvCubeMap, 
 				BOOL bAoEnabled);
@@ -135,8 +123,6 @@ namespace Render::DX::Shading {
 		private:
 			InitData mInitData{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 		};
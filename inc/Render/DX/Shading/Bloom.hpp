@@ -4,17 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace Bloom {
-		namespace Shader {
-			enum Type {
-				CS_ExtractHighlights = 0,
-				CS_BlendBloomWithDownSampled,
-				VS_ApplyBloom,
-				MS_ApplyBloom,
-				PS_ApplyBloom,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_ExtractHighlights = 0,
@@ -42,7 +31,8 @@ namespace Render::DX::Shading {
 
 			namespace ApplyBloom {
 				enum {
-					SI_BackBuffer = 0,
+					RC_Consts = 0,
+					SI_BackBuffer,
 					SI_BloomMap,
 					Count
 				};
@@ -109,7 +99,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -122,10 +111,13 @@ namespace Render::DX::Shading {
 				D3D12_GPU_DESCRIPTOR_HANDLE si_backBuffer,
 				FLOAT threshold, FLOAT softknee,
 				DownSampleFunc downSampleFunc);
+			// On half resolution the upsampling chain stops at the 16th-res
+			// map, which is stretched over the back buffer by ApplyBloom.
 			BOOL BlurHighlights(
 				Foundation::Resource::FrameResource* const pFrameResource,
 				DownSampleFunc downSampleFunc, 
-				BlurFunc blurFunc);
+				BlurFunc blurFunc,
+				BOOL bHalfResolutionEnabled);
 			BOOL ApplyBloom(
 				Foundation::Resource::FrameResource* const pFrameResource,
 				D3D12_VIEWPORT viewport,
@@ -133,16 +125,23 @@ namespace Render::DX::Shading {
 				Foundation::Resource::GpuResource* const pBackBuffer,
 				D3D12_CPU_DESCRIPTOR_HANDLE ro_backBuffer,
 				Foundation::Resource::GpuResource* const pBackBufferCopy,
-				D3D12_GPU_DESCRIPTOR_HANDLE si_backBufferCopy);
+				D3D12_GPU_DESCRIPTOR_HANDLE si_backBufferCopy,
+				BOOL bHalfResolutionEnabled);
+
+			// The highlight and bloom chains are only needed while the effect
+			// runs, so they are placed by the render graph. Their views are
+			// written to the frame's transient descriptors each time the
+			// highlights are extracted.
+			void DeclareTransients(Foundation::Core::RenderPassBuilder& builder);
 
 		private:
-			BOOL BuildResources();
-			BOOL BuildDescriptors();
+			BOOL BuildTransientDescriptors();
 
 			BOOL DownSampling(DownSampleFunc downSampleFunc);
 			BOOL UpSamplingWithBlur(
 				Foundation::Resource::FrameResource* const pFrameResource,
-				BlurFunc blurFunc);
+				BlurFunc blurFunc,
+				Resource::Type topIndex);
 
 		private:
 			InitData mInitData{};
@@ -150,8 +149,6 @@ namespace Render::DX::Shading {
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::array<std::unique_ptr<Foundation::Resource::GpuResource>, Resource::Count> mHighlightMaps{};
 			std::array<D3D12_CPU_DESCRIPTOR_HANDLE, Resource::Count> mhHighlightMapCpuSrvs{};
 			std::array<D3D12_GPU_DESCRIPTOR_HANDLE, Resource::Count> mhHighlightMapGpuSrvs{};
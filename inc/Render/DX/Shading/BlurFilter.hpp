@@ -7,23 +7,13 @@ namespace Render::DX::Shading {
 		__forceinline INT CalcDiameter(FLOAT sigma);
 		__forceinline BOOL CalcGaussWeights(FLOAT sigma, FLOAT weights[]);
 
-		namespace Shader {
+		namespace RootSignature {
 			enum Type {
-				CS_GaussianBlurFilter3x3 = 0,
-				CS_GaussianBlurFilterRGBA3x3,
-				CS_GaussianBlurFilterNxN3x3,
-				CS_GaussianBlurFilterNxN5x5,
-				CS_GaussianBlurFilterNxN7x7,
-				CS_GaussianBlurFilterNxN9x9,
-				CS_GaussianBlurFilterRGBANxN3x3,
-				CS_GaussianBlurFilterRGBANxN5x5,
-				CS_GaussianBlurFilterRGBANxN7x7,
-				CS_GaussianBlurFilterRGBANxN9x9,
+				GR_Default = 0,
+				GR_BilateralUpsample,
 				Count
 			};
-		}
 
-		namespace RootSignature {
 			namespace Default {
 				enum {
 					RC_Consts = 0,
@@ -32,6 +22,16 @@ namespace Render::DX::Shading {
 					Count
 				};
 			}
+
+			namespace BilateralUpsample {
+				enum {
+					RC_Consts = 0,
+					SI_NormalDepthMap,
+					SI_InputMap,
+					UO_OutputMap,
+					Count
+				};
+			}
 		}
 
 		namespace PipelineState {
@@ -46,6 +46,7 @@ namespace Render::DX::Shading {
 				CP_GaussianBlurFilterRGBANxN5x5,
 				CP_GaussianBlurFilterRGBANxN7x7,
 				CP_GaussianBlurFilterRGBANxN9x9,
+				CP_BilateralUpsample,
 				Count
 			};
 		}
@@ -73,7 +74,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp();
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 
@@ -87,13 +87,25 @@ namespace Render::DX::Shading {
 				D3D12_GPU_DESCRIPTOR_HANDLE uo_outputMap,
 				UINT texWidth, UINT texHeight);
 
+			// Fills a full-resolution map from one evaluated at every other
+			// pixel in both directions; texWidth and texHeight are the full
+			// resolution.
+			BOOL BilateralUpsample(
+				Foundation::Resource::FrameResource* const pFrameResource,
+				Foundation::Resource::GpuResource* const pNormalDepthMap,
+				D3D12_GPU_DESCRIPTOR_HANDLE si_normalDepthMap,
+				Foundation::Resource::GpuResource* const pInputMap,
+				D3D12_GPU_DESCRIPTOR_HANDLE si_inputMap,
+				Foundation::Resource::GpuResource* const pOutputMap,
+				D3D12_GPU_DESCRIPTOR_HANDLE uo_outputMap,
+				UINT texWidth, UINT texHeight,
+				FLOAT depthSigma, UINT depthNumMantissaBits);
+
 		private:
 			InitData mInitData{};
 
-			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
+			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
-
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
 		};
 
 		using InitDataPtr = std::unique_ptr<BlurFilterClass::InitData>;
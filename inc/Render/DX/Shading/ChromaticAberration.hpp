@@ -4,15 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace ChromaticAberration {
-		namespace Shader {
-			enum Type {
-				VS_ChromaticAberration = 0,
-				MS_ChromaticAberration,
-				PS_ChromaticAberration,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			namespace Default {
 				enum {
@@ -56,7 +47,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 
@@ -75,8 +65,6 @@ namespace Render::DX::Shading {
 		private:
 			InitData mInitData{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 		};
@@ -4,20 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace DOF {
-		namespace Shader {
-			enum Type {
-				CS_CaclFocalDistance = 0,
-				CS_CircleOfConfusion,
-				VS_Bokeh,
-				MS_Bokeh,
-				PS_Bokeh,
-				VS_BokehBlurNxN,
-				MS_BokehBlurNxN,
-				PS_BokehBlurNxN,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_CalcFocalDistance = 0,
@@ -103,7 +89,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -137,9 +122,14 @@ namespace Render::DX::Shading {
 				Foundation::Resource::GpuResource* const pBackBufferCopy,
 				D3D12_GPU_DESCRIPTOR_HANDLE si_backBufferCopy);
 
+			// The circle of confusion map is only needed while the effect
+			// runs, so it is placed by the render graph. Its views are
+			// written to the frame's transient descriptors each time it is
+			// computed.
+			void DeclareTransients(Foundation::Core::RenderPassBuilder& builder);
+
 		private:
-			BOOL BuildResources();
-			BOOL BuildDescriptors();
+			BOOL BuildTransientDescriptors();
 
 			BOOL BuildFixedResources();
 
@@ -149,8 +139,6 @@ namespace Render::DX::Shading {
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::unique_ptr<Foundation::Resource::GpuResource> mFocalDistanceBuffer{};
 
 			std::unique_ptr<Foundation::Resource::GpuResource> mCircleOfConfusionMap{};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Render/DX/Foundation/ShadingObject.hpp"
+#include "Common/Util/EnvironmentBaker.hpp"
 
 namespace Render::DX::Shading {
 	namespace Util {
@@ -14,30 +15,10 @@ namespace Render::DX::Shading {
 	}
 
 	namespace EnvironmentMap {
-		namespace Shader {
-			enum Type {
-				VS_DrawSkySphere = 0,
-				MS_DrawSkySphere,
-				PS_DrawSkySphere,
-				VS_ConvoluteDiffuseIrradiance,
-				GS_ConvoluteDiffuseIrradiance,
-				PS_ConvoluteDiffuseIrradiance,
-				VS_ConvoluteSpecularIrradiance,
-				GS_ConvoluteSpecularIrradiance,
-				PS_ConvoluteSpecularIrradiance,
-				VS_IntegrateBrdf,
-				MS_IntegrateBrdf,
-				PS_IntegrateBrdf,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_DrawSkySphere = 0,
-				GR_ConvoluteDiffuseIrradiance,
 				GR_ConvoluteSpecularIrradiance,
-				GR_IntegrateBrdf,
 				Count
 			};
 
@@ -53,14 +34,6 @@ namespace Render::DX::Shading {
 				};
 			}
 
-			namespace ConvoluteDiffuseIrradiance {
-				enum {
-					CB_ProjectToCube = 0,
-					SI_CubeMap,
-					Count
-				};
-			}
-
 			namespace ConvoluteSpecularIrradiance {
 				enum {
 					CB_ProjectToCube = 0,
@@ -69,23 +42,13 @@ namespace Render::DX::Shading {
 					Count
 				};
 			}
-
-			namespace IntegrateBrdf {
-				enum {
-					CB_Pass = 0,
-					Count
-				};
-			}
 		}
 
 		namespace PipelineState {
 			enum Type {
 				GP_DrawSkySphere = 0,
 				MP_DrawSkySphere,
-				GP_ConvoluteDiffuseIrradiance,
 				GP_ConvoluteSpecularIrradiance,
-				GP_IntegrateBrdf,
-				MP_IntegrateBrdf,
 				Count
 			};
 		}
@@ -96,20 +59,22 @@ namespace Render::DX::Shading {
 				BOOL MeshShaderSupported{};
 				Foundation::Core::Device* Device{};
 				Foundation::Core::CommandObject* CommandObject{};
+				Foundation::Core::UploadQueue* UploadQueue{};
 				Foundation::Core::DescriptorHeap* DescriptorHeap{};
 				Util::ShaderManager* ShaderManager{};
+				BOOL Avx2Supported{};
+				UINT ThreadCount{};
 			};
 
 			enum TaskType {
 				E_None = 0,
 				E_NeedToSaveEnvCubeMap				 = 1 << 0,
-				E_NeedToSaveDiffuseIrradianceCubeMap = 1 << 1,
+				E_NeedToSaveIrradianceSH			 = 1 << 1,
 				E_NeedToSavePrefilteredEnvCubeMap	 = 1 << 2,
-				E_NeedToSaveBrdfLutMap				 = 1 << 3,
-				E_NeedToGenEnvCubeMap				 = 1 << 4,
-				E_NeedToGenDiffuseIrradianceCubeMap	 = 1 << 5,
-				E_NeedToGenPrefilteredEnvCubeMap	 = 1 << 6,
-				E_NeedToGenBrdfLutMap				 = 1 << 7
+				E_NeedToGenEnvCubeMap				 = 1 << 3,
+				E_NeedToGenIrradianceSH				 = 1 << 4,
+				E_NeedToGenPrefilteredEnvCubeMap	 = 1 << 5,
+				E_NeedToGenBrdfLutMap				 = 1 << 6
 			};
 
 		public:
@@ -117,8 +82,7 @@ namespace Render::DX::Shading {
 			virtual ~EnvironmentMapClass();
 
 		public:
-			__forceinline Foundation::Resource::GpuResource* DiffuseIrradianceCubeMap() const;
-			__forceinline D3D12_GPU_DESCRIPTOR_HANDLE DiffuseIrradianceCubeMapSrv() const;
+			__forceinline const Common::Util::EnvironmentBaker::IrradianceSH& IrradianceSH() const;
 
 			__forceinline Foundation::Resource::GpuResource* PrefilteredEnvironmentCubeMap() const;
 			__forceinline D3D12_GPU_DESCRIPTOR_HANDLE PrefilteredEnvironmentCubeMapSrv() const;
@@ -135,7 +99,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -166,29 +129,35 @@ namespace Render::DX::Shading {
 				LPCWSTR fileName, LPCWSTR baseDir);
 			BOOL Save(LPCWSTR fileName, LPCWSTR baseDir);
 
+			// Sends loaded textures to the copy queue in one batch and keeps
+			// later direct-queue work from reading them before they land.
+			BOOL WaitForUploads();
+
 			BOOL CreateEquirectangularMap();
 			BOOL BuildEquirectangularMapDescriptors();
 
 			BOOL CreateEnvironmentCubeMap();
 			BOOL BuildEnvironmentMapDescriptors(BOOL bNeedRtv);
 
-			BOOL CreateDiffuseIrradianceCubeMap();
-			BOOL BuildDiffuseIrradianceCubeMapDescriptors(BOOL bNeedRtv);
-
 			BOOL CreatePrefilteredEnvironmentCubeMap();
 			BOOL BuildPrefilteredEnvironmentCubeMapDescriptors(BOOL bNeedRtv);
 
-			BOOL CreateBrdfLutMap();
-			BOOL BuildBrdfLutMapDescriptors(BOOL bNeedRtv);
+			BOOL BuildBrdfLutMapDescriptors();
+
+			// The nine coefficients are kept in a small binary file next to
+			// the cube maps. A missing or stale file leaves bLoaded FALSE.
+			BOOL LoadIrradianceSH(LPCWSTR filePath, BOOL& bLoaded);
+			BOOL SaveIrradianceSH(LPCWSTR filePath);
+
+			BOOL BakeIrradianceSH();
+			BOOL BakeBrdfLutMap(LPCWSTR filePath);
 
 			BOOL GenerateMipmap(Util::MipmapGenerator::MipmapGeneratorClass* const pMipmapGenerator);
 			BOOL ConvertEquirectangularMapToCubeMap(
 				Util::EquirectangularConverter::EquirectangularConverterClass* const pEquirectangularConverter,
 				D3D12_GPU_VIRTUAL_ADDRESS cbProjectToCube);
 
-			BOOL DrawDiffuseIrradianceCubeMap(D3D12_GPU_VIRTUAL_ADDRESS cbProjectToCube);
 			BOOL DrawPrefilteredEnvironmentCubeMap(D3D12_GPU_VIRTUAL_ADDRESS cbProjectToCube);
-			BOOL DrawBrdfLutMap(D3D12_GPU_VIRTUAL_ADDRESS cbPass);
 
 		private:
 			InitData mInitData{};
@@ -198,8 +167,6 @@ namespace Render::DX::Shading {
 			D3D12_VIEWPORT mViewport{};
 			D3D12_RECT mScissorRect{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 
@@ -217,10 +184,8 @@ namespace Render::DX::Shading {
 			D3D12_GPU_DESCRIPTOR_HANDLE mhEnvironmentCubeMapGpuSrv{};
 			D3D12_CPU_DESCRIPTOR_HANDLE mhEnvironmentCubeMapCpuRtvs[ShadingConvention::MipmapGenerator::MaxMipLevel]{};
 
-			std::unique_ptr<Foundation::Resource::GpuResource> mDiffuseIrradianceCubeMap{};
-			D3D12_CPU_DESCRIPTOR_HANDLE mhDiffuseIrradianceCubeMapCpuSrv{};
-			D3D12_GPU_DESCRIPTOR_HANDLE mhDiffuseIrradianceCubeMapGpuSrv{};
-			D3D12_CPU_DESCRIPTOR_HANDLE mhDiffuseIrradianceCubeMapCpuRtv{};
+			std::unique_ptr<Common::Util::EnvironmentBaker> mEnvironmentBaker{};
+			Common::Util::EnvironmentBaker::IrradianceSH mIrradianceSH{};
 
 			std::unique_ptr<Foundation::Resource::GpuResource> mPrefilteredEnvironmentCubeMap{};
 			D3D12_CPU_DESCRIPTOR_HANDLE mhPrefilteredEnvironmentCubeMapCpuSrv{};
@@ -230,7 +195,6 @@ namespace Render::DX::Shading {
 			std::unique_ptr<Foundation::Resource::GpuResource> mBrdfLutMap{};
 			D3D12_CPU_DESCRIPTOR_HANDLE mhBrdfLutMapCpuSrv{};
 			D3D12_GPU_DESCRIPTOR_HANDLE mhBrdfLutMapGpuSrv{};
-			D3D12_CPU_DESCRIPTOR_HANDLE mhBrdfLutMapCpuRtv{};
 		};
 
 		using InitDataPtr = std::unique_ptr<EnvironmentMapClass::InitData>;
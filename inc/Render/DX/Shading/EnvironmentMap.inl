@@ -2,10 +2,8 @@
 #define __ENVIRONMENTMAP_INL__
 
 
-// DiffuseIrradianceMap
-Render::DX::Foundation::Resource::GpuResource* Render::DX::Shading::EnvironmentMap::EnvironmentMapClass::DiffuseIrradianceCubeMap() const { return mDiffuseIrradianceCubeMap.get(); }
-
-D3D12_GPU_DESCRIPTOR_HANDLE Render::DX::Shading::EnvironmentMap::EnvironmentMapClass::DiffuseIrradianceCubeMapSrv() const {	return mhDiffuseIrradianceCubeMapGpuSrv; }
+// IrradianceSH
+const Common::Util::EnvironmentBaker::IrradianceSH& Render::DX::Shading::EnvironmentMap::EnvironmentMapClass::IrradianceSH() const { return mIrradianceSH; }
 
 // PrefilteredEnvironmentCubeMap
 Render::DX::Foundation::Resource::GpuResource* Render::DX::Shading::EnvironmentMap::EnvironmentMapClass::PrefilteredEnvironmentCubeMap() const { return mPrefilteredEnvironmentCubeMap.get(); }
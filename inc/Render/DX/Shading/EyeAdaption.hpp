@@ -4,16 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace EyeAdaption {
-		namespace Shader {
-			enum Type {
-				CS_ClearHistogram = 0,
-				CS_LuminanceHistogram,
-				CS_PercentileExtract,
-				CS_TemporalSmoothing,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_LuminanceHistogram = 0,
@@ -91,7 +81,6 @@ namespace Render::DX::Shading {
 				void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL OnResize(UINT width, UINT height) override;
@@ -120,8 +109,6 @@ namespace Render::DX::Shading {
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, 
 				PipelineState::Count> mPipelineStates{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::unique_ptr<Foundation::Resource::GpuResource> mHistogramBuffer{};
 			std::unique_ptr<Foundation::Resource::GpuResource> mAvgLogLuminance{};
 			std::unique_ptr<Foundation::Resource::GpuResource> mPrevLuminance{};
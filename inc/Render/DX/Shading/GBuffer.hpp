@@ -2,24 +2,20 @@
 
 #include "Render/DX/Foundation/ShadingObject.hpp"
 
+namespace Common::Util {
+	class DrawBatcher;
+}
+
 namespace Render::DX::Shading {
 	namespace GBuffer {
-		namespace Shader {
-			enum Type {
-				VS_GBuffer = 0,
-				MS_GBuffer,
-				PS_GBuffer,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			namespace Default {
 				enum {
 					CB_Pass = 0,
-					CB_Object,
 					CB_Material,
 					RC_Consts,
+					SI_Objects,
+					SI_InstanceIndices,
 					SI_VertexBuffer,
 					SI_IndexBuffer,
 					SI_Textures,
@@ -135,13 +131,15 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
 			virtual BOOL OnResize(UINT width, UINT height) override;
 
 		public:
+			// Draws one instanced call per batch of the batcher. ritems are in
+			// the batcher's draw order, and pFrameResource->InstanceIndices
+			// holds their object indices in the same order.
 			BOOL DrawGBuffer(
 				Foundation::Resource::FrameResource* const pFrameResource,
 				D3D12_VIEWPORT viewport, 
@@ -151,26 +149,54 @@ namespace Render::DX::Shading {
 				Foundation::Resource::GpuResource* const depthBuffer, 
 				D3D12_CPU_DESCRIPTOR_HANDLE do_depthBuffer,
 				const std::vector<Render::DX::Foundation::RenderItem*>& ritems,
+				const Common::Util::DrawBatcher& batcher,
+				FLOAT ditheringMaxDist, FLOAT ditheringMinDist);
+			// Draws the records the culling pass compacted into
+			// pCommandBuffer with a single ExecuteIndirect. Each record
+			// names its object through instanceIndices.
+			BOOL DrawGBufferIndirect(
+				Foundation::Resource::FrameResource* const pFrameResource,
+				D3D12_VIEWPORT viewport,
+				D3D12_RECT scissorRect,
+				Foundation::Resource::GpuResource* const depthBuffer,
+				D3D12_CPU_DESCRIPTOR_HANDLE do_depthBuffer,
+				D3D12_GPU_VIRTUAL_ADDRESS instanceIndices,
+				Foundation::Resource::GpuResource* const pCommandBuffer,
+				Foundation::Resource::GpuResource* const pCommandCountBuffer,
+				UINT maxCommandCount,
 				FLOAT ditheringMaxDist, FLOAT ditheringMinDist);
 
+			// Fills the record DrawGBufferIndirect draws pRitem with.
+			void BuildIndirectCommand(
+				Foundation::Resource::FrameResource* const pFrameResource,
+				const Foundation::RenderItem* const pRitem,
+				ShadingConvention::GBuffer::IndirectCommand& command) const;
+
 		private:
 			BOOL BuildResources();
 			BOOL BuildDescriptors();
 
+			BOOL ClearGBuffer(
+				ID3D12GraphicsCommandList6* const pCmdList,
+				Foundation::Resource::GpuResource* const depthBuffer,
+				D3D12_CPU_DESCRIPTOR_HANDLE do_depthBuffer);
+			// Draws batches [begin, end) of the batcher.
 			BOOL DrawRenderItems(
 				Foundation::Resource::FrameResource* const pFrameResource,
 				ID3D12GraphicsCommandList6* const pCmdList,
 				const std::vector<Render::DX::Foundation::RenderItem*>& ritems,
+				const Common::Util::DrawBatcher& batcher,
+				UINT begin, UINT end,
 				FLOAT ditheringMaxDist, FLOAT ditheringMinDist);
 			BOOL CacheNormalDepth(ID3D12GraphicsCommandList6* const pCmdList);
+			BOOL BuildCommandSignature();
 
 		private:
 			InitData mInitData{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
+			Microsoft::WRL::ComPtr<ID3D12CommandSignature> mCommandSignature{};
 
 			std::array<std::unique_ptr<Foundation::Resource::GpuResource>, Resource::Count> mResources{};
 			std::array<D3D12_CPU_DESCRIPTOR_HANDLE, Descriptor::Srv::Count> mhCpuSrvs{};
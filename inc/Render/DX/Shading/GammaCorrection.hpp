@@ -3,15 +3,6 @@
 #include "Render/DX/Foundation/ShadingObject.hpp"
 
 namespace Render::DX::Shading {
-	namespace Shader {
-		enum Type {
-			VS_GammaCorrect = 0,
-			MS_GammaCorrect,
-			PS_GammaCorrect,
-			Count
-		};
-	}
-
 	namespace RootSignature {
 		namespace Default {
 			enum {
@@ -56,7 +47,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 
@@ -74,8 +64,6 @@ namespace Render::DX::Shading {
 		private:
 			InitData mInitData{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 		};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Render/DX/Foundation/ShadingObject.hpp"
+
+namespace Render::DX::Shading {
+	namespace GpuCulling {
+		namespace RootSignature {
+			enum Type {
+				GR_BuildHiZ = 0,
+				GR_CullInstances,
+				Count
+			};
+
+			namespace BuildHiZ {
+				enum {
+					RC_Consts = 0,
+					SI_DepthMap,
+					UI_SrcMip,
+					UO_DstMip,
+					Count
+				};
+			}
+
+			namespace CullInstances {
+				enum {
+					CB_Pass = 0,
+					RC_Consts,
+					SI_InstanceBounds,
+					SI_Commands,
+					SI_HiZMap,
+					UO_Commands,
+					UO_CommandCount,
+					Count
+				};
+			}
+		}
+
+		namespace PipelineState {
+			enum Type {
+				CP_CopyDepth = 0,
+				CP_DownsampleHiZ,
+				CP_CullInstances,
+				Count
+			};
+		}
+
+		// Culls the per-instance command records against the camera frustum
+		// and a depth pyramid of the previous frame, and compacts the
+		// survivors into an argument buffer for ExecuteIndirect.
+		class GpuCullingClass : public Foundation::ShadingObject {
+		public:
+			struct InitData {
+				Foundation::Core::Device* Device{};
+				Foundation::Core::CommandObject* CommandObject{};
+				Foundation::Core::DescriptorHeap* DescriptorHeap{};
+				Util::ShaderManager* ShaderManager{};
+				UINT ClientWidth{};
+				UINT ClientHeight{};
+				UINT MaxInstanceCount{};
+			};
+
+		public:
+			GpuCullingClass();
+			virtual ~GpuCullingClass();
+
+		public:
+			__forceinline Foundation::Resource::GpuResource* HiZMap() const;
+			__forceinline Foundation::Resource::GpuResource* CommandBuffer() const;
+			__forceinline Foundation::Resource::GpuResource* CommandCountBuffer() const;
+			__forceinline constexpr UINT MaxInstanceCount() const;
+			// Instance list the culled records name their objects through;
+			// entry i holds i.
+			__forceinline D3D12_GPU_VIRTUAL_ADDRESS InstanceIndices() const;
+
+			// The pyramid goes stale while nothing rebuilds it.
+			__forceinline void InvalidateHiZ() noexcept;
+
+		public:
+			virtual UINT CbvSrvUavDescCount() const override;
+			virtual UINT RtvDescCount() const override;
+			virtual UINT DsvDescCount() const override;
+
+		public:
+			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
+			virtual void CleanUp() override;
+
+			virtual BOOL BuildRootSignatures() override;
+			virtual BOOL BuildPipelineStates() override;
+			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
+			virtual BOOL OnResize(UINT width, UINT height) override;
+
+		public:
+			// Writes the visible records of pFrameResource->IndirectCommands
+			// to CommandBuffer and their number to CommandCountBuffer.
+			// Occlusion is tested only once a depth pyramid exists.
+			BOOL CullInstances(
+				Foundation::Resource::FrameResource* const pFrameResource,
+				UINT instanceCount,
+				BOOL occlusionEnabled);
+			// Reduces the depth buffer to the pyramid the next frame culls
+			// against.
+			BOOL BuildHiZ(
+				Foundation::Resource::FrameResource* const pFrameResource,
+				Foundation::Resource::GpuResource* const pDepthMap,
+				D3D12_GPU_DESCRIPTOR_HANDLE si_depthMap);
+
+		private:
+			BOOL BuildResources();
+			BOOL BuildDescriptors();
+
+		private:
+			InitData mInitData{};
+
+			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
+			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
+
+			std::unique_ptr<Foundation::Resource::GpuResource> mHiZMap{};
+			D3D12_CPU_DESCRIPTOR_HANDLE mhHiZMapCpuSrv{};
+			D3D12_GPU_DESCRIPTOR_HANDLE mhHiZMapGpuSrv{};
+			std::array<D3D12_CPU_DESCRIPTOR_HANDLE, ShadingConvention::GpuCulling::MaxHiZMipCount> mhHiZMipCpuUavs{};
+			std::array<D3D12_GPU_DESCRIPTOR_HANDLE, ShadingConvention::GpuCulling::MaxHiZMipCount> mhHiZMipGpuUavs{};
+			UINT mHiZMipCount{};
+			UINT mHiZWidth{};
+			UINT mHiZHeight{};
+			// Cleared whenever the pyramid no longer matches the depth buffer.
+			BOOL mbHiZValid{};
+
+			std::unique_ptr<Foundation::Resource::GpuResource> mCommandBuffer{};
+			std::unique_ptr<Foundation::Resource::GpuResource> mCommandCountBuffer{};
+			// Source of the zero the count is reset with every frame.
+			Microsoft::WRL::ComPtr<ID3D12Resource> mZeroBuffer{};
+			Microsoft::WRL::ComPtr<ID3D12Resource> mInstanceIndexBuffer{};
+		};
+
+		using InitDataPtr = std::unique_ptr<GpuCullingClass::InitData>;
+
+		InitDataPtr MakeInitData();
+	}
+}
+
+#include "GpuCulling.inl"
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef __GPUCULLING_INL__
+#define __GPUCULLING_INL__
+
+namespace Render::DX::Shading::GpuCulling {
+	Foundation::Resource::GpuResource* GpuCullingClass::HiZMap() const {
+		return mHiZMap.get(); }
+
+	Foundation::Resource::GpuResource* GpuCullingClass::CommandBuffer() const {
+		return mCommandBuffer.get(); }
+
+	Foundation::Resource::GpuResource* GpuCullingClass::CommandCountBuffer() const {
+		return mCommandCountBuffer.get(); }
+
+	constexpr UINT GpuCullingClass::MaxInstanceCount() const {
+		return mInitData.MaxInstanceCount; }
+
+	D3D12_GPU_VIRTUAL_ADDRESS GpuCullingClass::InstanceIndices() const {
+		return mInstanceIndexBuffer->GetGPUVirtualAddress(); }
+
+	void GpuCullingClass::InvalidateHiZ() noexcept {
+		mbHiZValid = FALSE; }
+}
+
+#endif // __GPUCULLING_INL__
\ No newline at end of file
@@ -4,15 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace MotionBlur {
-		namespace Shader {
-			enum Type {
-				VS_MotionBlur = 0,
-				MS_MotionBlur,
-				PS_MotionBlur,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_Default = 0,
@@ -63,7 +54,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 
@@ -87,8 +77,6 @@ namespace Render::DX::Shading {
 
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
-
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
 		};
 
 		using InitDataPtr = std::unique_ptr<MotionBlurClass::InitData>;
@@ -4,13 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace RTAO {
-		namespace Shader {
-			enum Type {
-				Lib_RTAO = 0,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum {
 				SI_AccelerationStructure = 0,
@@ -31,6 +24,8 @@ namespace Render::DX::Shading {
 				enum Type {
 					E_AOCoefficient = 0,
 					E_RayHitDistance,
+					E_HalfResAOCoefficient,
+					E_HalfResRayHitDistance,
 					Count
 				};
 			}
@@ -52,6 +47,10 @@ namespace Render::DX::Shading {
 					EU_AOCoefficient,
 					ES_RayHitDistance,
 					EU_RayHitDistance,
+					ES_HalfResAOCoefficient,
+					EU_HalfResAOCoefficient,
+					ES_HalfResRayHitDistance,
+					EU_HalfResRayHitDistance,
 					Count
 				};
 			}
@@ -126,7 +125,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -134,6 +132,9 @@ namespace Render::DX::Shading {
 			virtual BOOL BuildShaderTables(UINT numRitems) override;
 
 		public:
+			// On checkerboard only the active half of the full-resolution maps
+			// is written; at half resolution the half-resolution maps are,
+			// and the caller upsamples them.
 			BOOL DrawAO(
 				Foundation::Resource::FrameResource* const pFrameResource,
 				D3D12_GPU_VIRTUAL_ADDRESS accelStruct,
@@ -146,7 +147,8 @@ namespace Render::DX::Shading {
 				Foundation::Resource::GpuResource* const pRayInexOffsetMap,
 				D3D12_GPU_DESCRIPTOR_HANDLE si_rayIndexOffsetMap,
 				BOOL bRaySortingEnabled,
-				BOOL bCheckboardRayGeneration);
+				BOOL bCheckboardRayGeneration,
+				BOOL bHalfResolutionEnabled);
 
 			UINT MoveToNextTemporalCacheFrame();
 			UINT MoveToNextTemporalAOFrame();
@@ -158,8 +160,6 @@ namespace Render::DX::Shading {
 		private:
 			InitData mInitData{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			Microsoft::WRL::ComPtr<ID3D12StateObject> mStateObject{};
 			Microsoft::WRL::ComPtr<ID3D12StateObjectProperties> mStateObjectProp{};
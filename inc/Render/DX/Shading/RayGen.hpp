@@ -17,13 +17,6 @@ namespace Common {
 
 namespace Render::DX::Shading {
 	namespace RayGen {
-		namespace Shader {
-			enum Type {
-				CS_RayGen = 0,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			namespace Default {
 				enum {
@@ -71,7 +64,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -90,7 +82,8 @@ namespace Render::DX::Shading {
 				D3D12_GPU_DESCRIPTOR_HANDLE si_normalDepthMap,
 				Foundation::Resource::GpuResource* const pPositionMap,
 				D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
-				BOOL bCheckboardRayGeneration);
+				BOOL bCheckboardRayGeneration,
+				BOOL bHalfResolutionEnabled);
 
 		private:
 			void BuildSamples();
@@ -108,8 +101,6 @@ namespace Render::DX::Shading {
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			Microsoft::WRL::ComPtr<ID3D12PipelineState> mPipelineState{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			Foundation::Resource::StructuredBuffer<ShadingConvention::RayGen::AlignedUnitSquareSample2D> mSamplesGPUBuffer{};
 			Foundation::Resource::StructuredBuffer<ShadingConvention::RayGen::AlignedHemisphereSample3D> mHemisphereSamplesGPUBuffer{};
 
@@ -8,13 +8,6 @@ namespace Common::Render::ShadingArgument {
 
 namespace Render::DX::Shading {
 	namespace RaySorting {
-		namespace Shader {
-			enum Type {
-				CS_CountingSort = 0,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			namespace Default {
 				enum {
@@ -56,7 +49,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -78,8 +70,6 @@ namespace Render::DX::Shading {
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			Microsoft::WRL::ComPtr<ID3D12PipelineState> mPipelineState{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::unique_ptr<Foundation::Resource::GpuResource> mRayIndexOffsetMap{};
 			D3D12_CPU_DESCRIPTOR_HANDLE mhRayIndexOffsetMapCpuSrv{};
 			D3D12_GPU_DESCRIPTOR_HANDLE mhRayIndexOffsetMapGpuSrv{};
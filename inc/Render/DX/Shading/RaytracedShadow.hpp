@@ -4,13 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace RaytracedShadow {
-		namespace Shader {
-			enum Type {
-				Lib_RaytracedShadow = 0,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum {
 				CB_Light = 0,
@@ -61,7 +54,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -86,8 +78,6 @@ namespace Render::DX::Shading {
 		private:
 			InitData mInitData{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			Microsoft::WRL::ComPtr<ID3D12StateObject> mStateObject{};
 			Microsoft::WRL::ComPtr<ID3D12StateObjectProperties> mStateObjectProp{};
@@ -4,13 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace SSAO {
-		namespace Shader {
-			enum Type {
-				CS_SSAO = 0,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			namespace Default {
 				enum {
@@ -32,6 +25,8 @@ namespace Render::DX::Shading {
 				enum Type {
 					E_AOCoefficient = 0,
 					E_RayHitDistance,
+					E_HalfResAOCoefficient,
+					E_HalfResRayHitDistance,
 					Count
 				};
 			}
@@ -53,6 +48,10 @@ namespace Render::DX::Shading {
 					EU_AOCoefficient,
 					ES_RayHitDistance,
 					EU_RayHitDistance,
+					ES_HalfResAOCoefficient,
+					EU_HalfResAOCoefficient,
+					ES_HalfResRayHitDistance,
+					EU_HalfResRayHitDistance,
 					Count
 				};
 			}
@@ -118,7 +117,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -127,12 +125,17 @@ namespace Render::DX::Shading {
 		public:
 			BOOL BuildRandomVectorTexture();
 
+			// On checkerboard only the active half of the full-resolution maps
+			// is written; at half resolution the half-resolution maps are,
+			// and the caller upsamples them.
 			BOOL DrawAO(
 				Foundation::Resource::FrameResource* const pFrameResource,
 				Foundation::Resource::GpuResource* const pCurrNormalDepthMap,
 				D3D12_GPU_DESCRIPTOR_HANDLE si_currNormalDepthMap,
 				Foundation::Resource::GpuResource* const pPositionMap,
-				D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap);
+				D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
+				BOOL bCheckerboardEnabled,
+				BOOL bHalfResolutionEnabled);
 
 			UINT MoveToNextTemporalCacheFrame();
 			UINT MoveToNextTemporalAOFrame();
@@ -152,8 +155,6 @@ namespace Render::DX::Shading {
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			Microsoft::WRL::ComPtr<ID3D12PipelineState> mPipelineState{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::unique_ptr<Foundation::Resource::GpuResource> mRandomVectorMap{};
 			std::unique_ptr<Foundation::Resource::GpuResource> mRandomVectorMapUploadBuffer{};
 			D3D12_CPU_DESCRIPTOR_HANDLE mhRandomVectorMapCpuSrv{};
@@ -4,14 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace SSCS {
-		namespace Shader {
-			enum Type {
-				CS_ComputeContactShadow = 0,
-				CS_ApplyContactShadow,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_ComputeContactShadow = 0,
@@ -74,7 +66,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -94,10 +85,16 @@ namespace Render::DX::Shading {
 				Foundation::Resource::GpuResource* const pShadowMap,
 				D3D12_GPU_DESCRIPTOR_HANDLE uio_shadowMap);
 
+			// The contact shadow map only lives between computing and
+			// applying it, so it is placed by the render graph. Its views
+			// are written to the frame's transient descriptors each time it
+			// is computed.
+			void DeclareTransients(Foundation::Core::RenderPassBuilder& builder);
 
 		private:
 			BOOL BuildResources();
 			BOOL BuildDescriptors();
+			BOOL BuildTransientDescriptors();
 
 		private:
 			InitData mInitData{};
@@ -105,8 +102,6 @@ namespace Render::DX::Shading {
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::unique_ptr<Foundation::Resource::GpuResource> mDebugMap{};
 			D3D12_CPU_DESCRIPTOR_HANDLE mhDebugMapCpuUav{};
 			D3D12_GPU_DESCRIPTOR_HANDLE mhDebugMapGpuUav{};
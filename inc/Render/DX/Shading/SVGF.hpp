@@ -4,19 +4,6 @@
 
 namespace Render::DX::Shading {	
 	namespace SVGF {
-		namespace Shader {
-			enum Type {
-				CS_TemporalSupersamplingReverseReproject = 0,
-				CS_TemporalSupersamplingBlendWithCurrentFrame,
-				CS_CalcParticalDepthDerivative,
-				CS_CalcLocalMeanVariance,
-				CS_FillinCheckerboard,
-				CS_EdgeStoppingFilterGaussian3x3,
-				CS_DisocclusionBlur3x3,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_TemporalSupersamplingReverseReproject = 0,
@@ -223,7 +210,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -316,8 +302,6 @@ namespace Render::DX::Shading {
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array < Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::array<std::unique_ptr<Foundation::Resource::GpuResource>, Resource::Count> mResources{};
 			std::array<D3D12_CPU_DESCRIPTOR_HANDLE, Descriptor::Count> mhCpuDecs{};
 			std::array<D3D12_GPU_DESCRIPTOR_HANDLE, Descriptor::Count> mhGpuDecs{};
@@ -1,20 +1,11 @@
 #pragma once
 
 #include "Common/Foundation/Light.h"
+#include "Common/Util/ShadowAtlasAllocator.hpp"
 #include "Render/DX/Foundation/ShadingObject.hpp"
 
 namespace Render::DX::Shading {
 	namespace Shadow {
-		namespace Shader {
-			enum Type {
-				VS_DrawZDepth = 0,
-				GS_DrawZDepth,
-				PS_DrawZDepth,
-				CS_DrawShadow,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_DrawZDepth = 0,
@@ -38,8 +29,7 @@ namespace Render::DX::Shading {
 					CB_Light = 0,
 					RC_Consts,
 					SI_PositionMap,
-					SI_ZDepthMap,
-					SI_ZDepthCubeMap,
+					SI_ZDepthAtlas,
 					UIO_ShadowMap,
 					Count
 				};
@@ -54,6 +44,10 @@ namespace Render::DX::Shading {
 			};
 		}
 
+		// Every light renders its depth into pages of a single atlas. A
+		// light keeps its pages between frames and redraws them only after
+		// it was invalidated, so lights whose casters stand still cost no
+		// draws.
 		class ShadowClass : public Foundation::ShadingObject {
 		public:
 			struct InitData {
@@ -64,8 +58,18 @@ namespace Render::DX::Shading {
 				Util::ShaderManager* ShaderManager{};
 				UINT ClientWidth{};
 				UINT ClientHeight{};
-				UINT TexWidth{};
-				UINT TexHeight{};
+				UINT AtlasSize{};
+				UINT MinPageSize{};
+				UINT MaxPageSize{};
+			};
+
+		private:
+			struct LightPages {
+				std::array<Common::Util::ShadowAtlasAllocator::Page, ShadingConvention::Shadow::MaxFaceCount> Pages{};
+				UINT FaceCount{};
+				UINT PageSize{};
+				// The pages hold the light's current depth.
+				BOOL Cached{};
 			};
 
 		public:
@@ -77,12 +81,26 @@ namespace Render::DX::Shading {
 			__forceinline Common::Foundation::Light* Light(UINT index) const;
 			__forceinline constexpr UINT LightCount() const;
 
+			// Number of render items submitted to the z-depth passes during
+			// the last Run, summed over the lights that were redrawn.
+			__forceinline constexpr UINT SubmittedItemCount() const;
+			// Number of lights whose pages were redrawn during the last Run.
+			__forceinline constexpr UINT RedrawnLightCount() const;
+
 			__forceinline Foundation::Resource::GpuResource* ShadowMap() const;
 			__forceinline constexpr D3D12_GPU_DESCRIPTOR_HANDLE ShadowMapSrv() const;
 			__forceinline constexpr D3D12_GPU_DESCRIPTOR_HANDLE ShadowMapUav() const;
 
-			void ZDepthMaps(std::vector<Render::DX::Foundation::Resource::GpuResource*>& maps);
-			__forceinline constexpr D3D12_GPU_DESCRIPTOR_HANDLE ZDepthMapSrv() const;
+			__forceinline Foundation::Resource::GpuResource* ZDepthAtlas() const;
+			__forceinline constexpr D3D12_GPU_DESCRIPTOR_HANDLE ZDepthAtlasSrv() const;
+
+			__forceinline constexpr UINT MinPageSize() const;
+			__forceinline constexpr UINT MaxPageSize() const;
+			__forceinline constexpr UINT PageSize(UINT lightIndex) const;
+
+			// Scale in xy and offset in zw from the face UV into the atlas;
+			// zero when the face has no page.
+			DirectX::XMFLOAT4 PageScaleOffset(UINT lightIndex, UINT face) const;
 
 		public:
 			virtual UINT CbvSrvUavDescCount() const override;
@@ -93,37 +111,46 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
 			virtual BOOL OnResize(UINT width, UINT height) override;
 
 		public:
+			// Each light only draws the casters culled against its own
+			// frustum; casters[i] belongs to the i-th light.
 			BOOL Run(
 				Foundation::Resource::FrameResource* const pFrameResource, 
 				Foundation::Resource::GpuResource* const pPositionMap,
 				D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
-				const std::vector<Render::DX::Foundation::RenderItem*>& ritems);
+				const std::array<std::vector<Render::DX::Foundation::RenderItem*>, MaxLights>& casters);
 
 			BOOL AddLight(const std::shared_ptr<Common::Foundation::Light>& light);
 
+			// Moves the light to pages of the given size, rounded to a power
+			// of two within [MinPageSize, MaxPageSize]. Sizes that do not fit
+			// fall back to smaller pages.
+			BOOL ResizePages(UINT lightIndex, UINT pageSize);
+			// The light's pages are redrawn by the next Run.
+			__forceinline void InvalidateLight(UINT lightIndex);
+
 		private:
 			BOOL BuildResources();
 			BOOL BuildDescriptors();
 
-			BOOL BuildResource(ShadingConvention::Shadow::ShadowMap::Type type);
-			BOOL BuildDescriptor(ShadingConvention::Shadow::ShadowMap::Type type);
+			BOOL BuildAtlas();
+			BOOL AllocatePages(LightPages& lightPages, UINT pageSize);
 
 			BOOL DrawZDepth(
 				Foundation::Resource::FrameResource* const pFrameResource,
+				ID3D12GraphicsCommandList6* const pCmdList,
 				const std::vector<Render::DX::Foundation::RenderItem*>& ritems,
 				UINT lightIndex);
 			BOOL DrawShadow(
 				Foundation::Resource::FrameResource* const pFrameResource,
+				ID3D12GraphicsCommandList6* const pCmdList,
 				Foundation::Resource::GpuResource* const pPositionMap,
 				D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
-				const std::vector<Render::DX::Foundation::RenderItem*>& ritems,
 				UINT lightIndex);
 			BOOL DrawRenderItems(
 				Foundation::Resource::FrameResource* const pFrameResource,
@@ -133,18 +160,16 @@ namespace Render::DX::Shading {
 		public:
 			InitData mInitData{};
 
-			D3D12_VIEWPORT mViewport{};
-			D3D12_RECT mScissorRect{};
-
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 
-			std::array<std::unique_ptr<Foundation::Resource::GpuResource>, MaxLights> mZDepthMaps{};
-			std::array<D3D12_CPU_DESCRIPTOR_HANDLE, MaxLights> mhZDepthMapCpuSrvs{};
-			std::array<D3D12_GPU_DESCRIPTOR_HANDLE, MaxLights> mhZDepthMapGpuSrvs{};
-			std::array<D3D12_CPU_DESCRIPTOR_HANDLE, MaxLights> mhZDepthMapCpuDsvs{};
+			std::unique_ptr<Foundation::Resource::GpuResource> mZDepthAtlas{};
+			D3D12_CPU_DESCRIPTOR_HANDLE mhZDepthAtlasCpuSrv{};
+			D3D12_GPU_DESCRIPTOR_HANDLE mhZDepthAtlasGpuSrv{};
+			D3D12_CPU_DESCRIPTOR_HANDLE mhZDepthAtlasCpuDsv{};
+
+			Common::Util::ShadowAtlasAllocator mAtlasAllocator{};
+			std::array<LightPages, MaxLights> mLightPages{};
 
 			std::unique_ptr<Foundation::Resource::GpuResource> mShadowMap{};
 			D3D12_CPU_DESCRIPTOR_HANDLE mhShadowMapCpuSrv{};
@@ -155,6 +180,9 @@ namespace Render::DX::Shading {
 			// Lights
 			std::array<std::shared_ptr<Common::Foundation::Light>, MaxLights> mLights{};
 			UINT mLightCount{};
+
+			UINT mSubmittedItemCount{};
+			UINT mRedrawnLightCount{};
 		};
 
 		using InitDataPtr = std::unique_ptr<ShadowClass::InitData>;
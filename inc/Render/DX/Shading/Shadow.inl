@@ -9,6 +9,14 @@ constexpr UINT Render::DX::Shading::Shadow::ShadowClass::LightCount() const {
 	return mLightCount;
 }
 
+constexpr UINT Render::DX::Shading::Shadow::ShadowClass::SubmittedItemCount() const {
+	return mSubmittedItemCount;
+}
+
+constexpr UINT Render::DX::Shading::Shadow::ShadowClass::RedrawnLightCount() const {
+	return mRedrawnLightCount;
+}
+
 Render::DX::Foundation::Resource::GpuResource* Render::DX::Shading::Shadow::ShadowClass::ShadowMap() const {
 	return mShadowMap.get();
 }
@@ -21,8 +29,28 @@ constexpr D3D12_GPU_DESCRIPTOR_HANDLE Render::DX::Shading::Shadow::ShadowClass::
 	return mhShadowMapGpuUav;
 }
 
-constexpr D3D12_GPU_DESCRIPTOR_HANDLE Render::DX::Shading::Shadow::ShadowClass::ZDepthMapSrv() const {
-	return mhZDepthMapGpuSrvs[0];
+Render::DX::Foundation::Resource::GpuResource* Render::DX::Shading::Shadow::ShadowClass::ZDepthAtlas() const {
+	return mZDepthAtlas.get();
+}
+
+constexpr D3D12_GPU_DESCRIPTOR_HANDLE Render::DX::Shading::Shadow::ShadowClass::ZDepthAtlasSrv() const {
+	return mhZDepthAtlasGpuSrv;
+}
+
+constexpr UINT Render::DX::Shading::Shadow::ShadowClass::MinPageSize() const {
+	return mAtlasAllocator.MinPageSize();
+}
+
+constexpr UINT Render::DX::Shading::Shadow::ShadowClass::MaxPageSize() const {
+	return mInitData.MaxPageSize;
+}
+
+constexpr UINT Render::DX::Shading::Shadow::ShadowClass::PageSize(UINT lightIndex) const {
+	return mLightPages[lightIndex].PageSize;
+}
+
+void Render::DX::Shading::Shadow::ShadowClass::InvalidateLight(UINT lightIndex) {
+	mLightPages[lightIndex].Cached = FALSE;
 }
 
 #endif // __SHADOW_INL__
\ No newline at end of file
@@ -4,15 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace TAA {
-		namespace Shader {
-			enum Type {
-				VS_TAA = 0,
-				MS_TAA,
-				PS_TAA,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			namespace Default {
 				enum {
@@ -51,7 +42,7 @@ namespace Render::DX::Shading {
 
 		public:
 			__forceinline constexpr UINT HaltonSequenceSize() const;
-			__forceinline constexpr DirectX::XMFLOAT2 HaltonSequence(UINT index) const;
+			__forceinline DirectX::XMFLOAT2 HaltonSequence(UINT index) const;
 
 		public:
 			virtual UINT CbvSrvUavDescCount() const override;
@@ -62,7 +53,6 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
@@ -88,8 +78,6 @@ namespace Render::DX::Shading {
 		private:
 			InitData mInitData{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 
@@ -115,7 +103,6 @@ namespace Render::DX::Shading {
 				DirectX::XMFLOAT2(0.9375f, 0.259259f),
 				DirectX::XMFLOAT2(0.03125f, 0.592593f)
 			};
-			std::array<DirectX::XMFLOAT2, 16> mFittedToBakcBufferHaltonSequence{};
 		};
 
 		using InitDataPtr = std::unique_ptr<TAAClass::InitData>;
@@ -5,8 +5,12 @@ constexpr UINT Render::DX::Shading::TAA::TAAClass::HaltonSequenceSize() const {
 	return 16;
 }
 
-constexpr DirectX::XMFLOAT2 Render::DX::Shading::TAA::TAAClass::HaltonSequence(UINT index) const {
-	return mFittedToBakcBufferHaltonSequence[index];
+// Jitters by a sub-pixel of the area rendered into, in NDC.
+DirectX::XMFLOAT2 Render::DX::Shading::TAA::TAAClass::HaltonSequence(UINT index) const {
+	const auto& Offset = mHaltonSequence[index];
+	return DirectX::XMFLOAT2(
+		((Offset.x - 0.5f) / static_cast<FLOAT>(mRenderWidth)) * 2.f,
+		((Offset.y - 0.5f) / static_cast<FLOAT>(mRenderHeight)) * 2.f);
 }
 
 #endif // __TAA_INL__
\ No newline at end of file
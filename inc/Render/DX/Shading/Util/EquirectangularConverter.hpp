@@ -4,17 +4,6 @@
 
 namespace Render::DX::Shading::Util {
 	namespace EquirectangularConverter {
-		namespace Shader {
-			enum Type {
-				VS_ConvCubeToEquirect = 0,
-				PS_ConvCubeToEquirect,
-				VS_ConvEquirectToCube,
-				GS_ConvEquirectToCube,
-				PS_ConvEquirectToCube,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_ConvEquirectToCube = 0,
@@ -69,7 +58,6 @@ namespace Render::DX::Shading::Util {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 
@@ -103,8 +91,6 @@ namespace Render::DX::Shading::Util {
 		private:
 			InitData mInitData{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 		};
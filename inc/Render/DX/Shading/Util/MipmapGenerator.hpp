@@ -4,16 +4,6 @@
 
 namespace Render::DX::Shading::Util {
 	namespace MipmapGenerator {
-		namespace Shader {
-			enum Type {
-				VS_GenerateMipmap = 0,
-				MS_GenerateMipmap,
-				PS_GenerateMipmap,
-				PS_CopyMap,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			namespace Default {
 				enum {
@@ -57,7 +47,6 @@ namespace Render::DX::Shading::Util {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 
@@ -85,8 +74,6 @@ namespace Render::DX::Shading::Util {
 		private:
 			InitData mInitData{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 		};
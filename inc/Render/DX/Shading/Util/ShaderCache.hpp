@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+
+#include "Common/Util/HashUtil.hpp"
+
+namespace Common::Debug {
+	struct LogFile;
+}
+
+namespace Render::DX::Shading::Util {
+	// Keeps compiled shader bytecode on disk between runs. Keys are built
+	// from the contents of a source file and everything it includes, so
+	// an edited shader simply misses and its stale entry is left behind.
+	class ShaderCache {
+	public:
+		struct Dependency {
+			std::filesystem::path Path{};
+			std::filesystem::file_time_type WriteTime{};
+		};
+
+	private:
+		struct SourceFile {
+			std::filesystem::file_time_type WriteTime{};
+			Common::Foundation::Hash ContentHash{};
+			std::vector<std::filesystem::path> Includes{};
+		};
+
+	public:
+		ShaderCache() = default;
+		virtual ~ShaderCache() = default;
+
+	public:
+		__forceinline UINT HitCount() const;
+		__forceinline UINT MissCount() const;
+
+	public:
+		BOOL Initialize(Common::Debug::LogFile* const pLogFile, LPCWSTR cacheDir, UINT workerCount);
+		void CleanUp();
+
+		void ResetCounters();
+
+	public:
+		// Hashes the file and its transitive quoted includes. Every file
+		// that took part is appended to deps. Each worker reads through its
+		// own table of file hashes, so concurrent calls never contend.
+		BOOL HashSource(
+			UINT worker,
+			const std::filesystem::path& filePath,
+			Common::Foundation::Hash& hash,
+			std::vector<Dependency>& deps);
+
+		// Leaves blob empty on a miss; unreadable entries count as misses.
+		BOOL Load(
+			Common::Foundation::Hash key,
+			IDxcUtils* const pUtils,
+			Microsoft::WRL::ComPtr<IDxcBlob>& blob);
+		BOOL Store(Common::Foundation::Hash key, IDxcBlob* const pBlob);
+
+	private:
+		BOOL ReadSourceFile(UINT worker, const std::filesystem::path& filePath, SourceFile& file);
+		std::filesystem::path EntryPath(Common::Foundation::Hash key) const;
+
+	private:
+		Common::Debug::LogFile* mpLogFile{};
+
+		std::filesystem::path mCacheDir{};
+
+		std::vector<std::unordered_map<std::wstring, SourceFile>> mSourceFiles{};
+
+		std::atomic<UINT> mHitCount{};
+		std::atomic<UINT> mMissCount{};
+	};
+}
+
+#include "Render/DX/Shading/Util/ShaderCache.inl"
\ No newline at end of file
@@ -0,0 +1,8 @@
+#ifndef __SHADERCACHE_INL__
+#define __SHADERCACHE_INL__
+
+UINT Render::DX::Shading::Util::ShaderCache::HitCount() const { return mHitCount.load(); }
+
+UINT Render::DX::Shading::Util::ShaderCache::MissCount() const { return mMissCount.load(); }
+
+#endif // __SHADERCACHE_INL__
\ No newline at end of file
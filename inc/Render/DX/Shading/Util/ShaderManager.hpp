@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/Util/HashUtil.hpp"
+#include "Render/DX/Shading/Util/ShaderCache.hpp"
 
 namespace Common::Debug {
 	struct LogFile;
@@ -9,20 +10,64 @@ namespace Common::Debug {
 namespace Render::DX::Shading::Util {
 	class ShaderManager {
 	public:
+		// All strings live in one buffer owned by the info. It is move-only;
+		// registering a shader is the only place they are copied.
 		struct D3D12ShaderInfo {
-			LPCWSTR		FileName{};
-			LPCWSTR		EntryPoint{};
-			LPCWSTR		TargetProfile{};
-			DxcDefine*	Defines{};
-			UINT32		DefineCount{};
+			LPCWSTR				FileName{};
+			LPCWSTR				EntryPoint{};
+			LPCWSTR				TargetProfile{};
+			const DxcDefine*	Defines{};
+			UINT32				DefineCount{};
 
 			D3D12ShaderInfo() = default;
 			D3D12ShaderInfo(LPCWSTR fileName, LPCWSTR entryPoint, LPCWSTR profile);
-			D3D12ShaderInfo(LPCWSTR fileName, LPCWSTR entryPoint, LPCWSTR profile, DxcDefine* defines, UINT32 defCount);
-			D3D12ShaderInfo(const D3D12ShaderInfo& ref);
-			~D3D12ShaderInfo();
+			D3D12ShaderInfo(LPCWSTR fileName, LPCWSTR entryPoint, LPCWSTR profile, const DxcDefine* defines, UINT32 defCount);
+			D3D12ShaderInfo(const D3D12ShaderInfo&) = delete;
+			D3D12ShaderInfo(D3D12ShaderInfo&&) noexcept = default;
+			~D3D12ShaderInfo() = default;
 
-			D3D12ShaderInfo& operator=(const D3D12ShaderInfo& ref);
+			D3D12ShaderInfo& operator=(const D3D12ShaderInfo&) = delete;
+			D3D12ShaderInfo& operator=(D3D12ShaderInfo&&) noexcept = default;
+
+		private:
+			std::vector<WCHAR> mStrings{};
+			std::vector<DxcDefine> mDefines{};
+		};
+
+		// One manifest entry: a file and entry point compiled for every
+		// combination of the define values. Combinations are enumerated
+		// with the last axis varying fastest.
+		struct ShaderPermutations {
+			struct DefineAxis {
+				std::wstring Name{};
+				std::vector<std::wstring> Values{};
+			};
+
+			std::wstring Name{};
+			std::wstring FileName{};
+			std::wstring EntryPoint{};
+			std::wstring TargetProfile{};
+			std::vector<DefineAxis> Axes{};
+		};
+
+	private:
+		struct ArchiveEntry {
+			Common::Foundation::Hash ContentKey{};
+			UINT64 Offset{};
+			UINT64 Size{};
+		};
+
+		struct ShaderKey {
+			Common::Foundation::Hash ArchiveKey{};
+			Common::Foundation::Hash ContentKey{};
+		};
+
+		// Output of one compile, kept per worker until the pass commits.
+		struct StagedShader {
+			Common::Foundation::Hash Hash{};
+			ShaderKey Key{};
+			Microsoft::WRL::ComPtr<IDxcBlob> Blob{};
+			std::vector<ShaderCache::Dependency> Dependencies{};
 		};
 
 	public:
@@ -30,33 +75,81 @@ namespace Render::DX::Shading::Util {
 		virtual ~ShaderManager();
 
 	public:
-		__forceinline IDxcBlob* GetShader(Common::Foundation::Hash hash);
+		// Looks a shader up by its manifest name; permutation indexes the
+		// combinations of the entry's define values.
+		__forceinline IDxcBlob* GetShader(LPCWSTR name, UINT permutation = 0);
 
 	public:
-		BOOL Initialize(Common::Debug::LogFile* const pLogFile, UINT numThreads);
+		// Without bCompileSources no compiler is created and every shader
+		// must come from the archive; shipped builds run this way.
+		BOOL Initialize(
+			Common::Debug::LogFile* const pLogFile, 
+			UINT numThreads, 
+			LPCWSTR cacheDir, 
+			BOOL bCompileSources);
 		void CleanUp();
 
 	public:
-		BOOL AddShader(const D3D12ShaderInfo& shaderInfo, Common::Foundation::Hash& hash);
+		// Registers every shader the manifest lists. Each line holds a name,
+		// the file, the entry point ('-' for libraries), the profile and
+		// any number of NAME=value[,value...] define axes.
+		BOOL LoadManifest(LPCWSTR filePath);
+		BOOL AddShaders(const ShaderPermutations& permutations);
 		BOOL CompileShaders(LPCWSTR baseDir);
+		// Recompiles only the shaders whose source or includes were written
+		// since they were last compiled, and reports which ones changed.
+		BOOL ReloadModifiedShaders(LPCWSTR baseDir, std::vector<Common::Foundation::Hash>& reloaded);
+
+		// Archived shaders are used instead of compiling them. When
+		// compiling from sources, an entry is only used while its sources
+		// still match; otherwise it is used as-is.
+		BOOL LoadArchive(LPCWSTR filePath);
+		BOOL WriteArchive(LPCWSTR filePath);
 
 	private:
-		BOOL CompileShader(Common::Foundation::Hash hash, LPCWSTR baseDir);
+		static Common::Foundation::Hash NameKey(LPCWSTR name, UINT permutation);
+
+		BOOL AddShader(Common::Foundation::Hash hash, const D3D12ShaderInfo& shaderInfo);
+		BOOL CompileShader(UINT worker, Common::Foundation::Hash hash, LPCWSTR baseDir);
+		BOOL CompileShaders(const std::vector<Common::Foundation::Hash>& hashes, LPCWSTR baseDir);
+		// Leaves blob empty when the archive has no usable entry.
+		BOOL LoadFromArchive(
+			IDxcUtils* const pUtils,
+			ShaderKey& key,
+			BOOL bCheckContent,
+			Microsoft::WRL::ComPtr<IDxcBlob>& blob);
+
+		Common::Foundation::Hash BuildArchiveKey(const D3D12ShaderInfo& shaderInfo) const;
+		Common::Foundation::Hash BuildCacheKey(Common::Foundation::Hash archiveKey, Common::Foundation::Hash sourceHash) const;
 		BOOL CommitShaders();
+		BOOL ReportCompileErrors();
 		BOOL BuildPdb(IDxcResult* const result, LPCWSTR fileName);
 
 	private:
 		BOOL mbCleanedUp{};
 		Common::Debug::LogFile* mpLogFile{};
 		UINT mThreadCount{};
+		BOOL mbCompileSources{};
 
+		// Indexed by compile worker.
 		std::vector<Microsoft::WRL::ComPtr<IDxcUtils>> mUtils{};
 		std::vector<Microsoft::WRL::ComPtr<IDxcCompiler3>> mCompilers{};
-		std::vector<std::unique_ptr<std::mutex>> mCompileMutexes{};
+		std::vector<std::vector<StagedShader>> mStagingShaders{};
+		std::vector<std::vector<std::wstring>> mCompileErrors{};
 
 		std::unordered_map<Common::Foundation::Hash, D3D12ShaderInfo> mShaderInfos{};
 		std::unordered_map<Common::Foundation::Hash, Microsoft::WRL::ComPtr<IDxcBlob>> mShaders{};
-		std::vector<std::vector<std::pair<Common::Foundation::Hash, Microsoft::WRL::ComPtr<IDxcBlob>>>> mStagingShaders{};
+
+		std::unique_ptr<ShaderCache> mShaderCache{};
+		Common::Foundation::Hash mCompilerHash{};
+
+		// Files each shader was built from, as of its last compile.
+		std::unordered_map<Common::Foundation::Hash, std::vector<ShaderCache::Dependency>> mDependencies{};
+
+		std::vector<CHAR> mArchiveData{};
+		std::unordered_map<Common::Foundation::Hash, ArchiveEntry> mArchiveEntries{};
+		std::unordered_map<Common::Foundation::Hash, ShaderKey> mShaderKeys{};
+		std::atomic<UINT> mArchiveHitCount{};
 	};
 }
 
@@ -7,10 +7,6 @@ namespace Common::Debug {
 }
 
 namespace Render::DX {
-	namespace Shading::Util {
-		class ShaderManager;
-	}
-
 	namespace Foundation::Core {
 		class DescriptorHeap;
 	}
@@ -28,14 +24,16 @@ namespace Render::DX {
 				UINT DsvDescCount() const;
 
 			public:
-				BOOL CompileShaders(Shading::Util::ShaderManager* const pShaderManager, LPCWSTR baseDir);
 				BOOL BuildRootSignatures();
-				BOOL BuildPipelineStates();
+				// Objects build their pipeline states concurrently.
+				BOOL BuildPipelineStates(UINT numThreads);
 				BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap);
 				BOOL OnResize(UINT width, UINT height);
 				BOOL BuildShaderTables(UINT numRitems);
 				BOOL Update();
 
+				void SetRenderArea(UINT width, UINT height, const DirectX::XMFLOAT2& uvScale);
+
 			public:
 				BOOL Initialize(Common::Debug::LogFile* const pLogFile);
 				void CleanUp();
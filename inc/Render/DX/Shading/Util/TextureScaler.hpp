@@ -4,15 +4,6 @@
 
 namespace Render::DX::Shading::Util {
 	namespace TextureScaler {
-		namespace Shader {
-			enum Type {
-				CS_DownSample2x2 = 0,
-				CS_DownSample4x4,
-				CS_DownSample6x6,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_DownSample2Nx2N = 0,
@@ -60,7 +51,6 @@ namespace Render::DX::Shading::Util {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 
@@ -79,8 +69,6 @@ namespace Render::DX::Shading::Util {
 
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
-
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
 		};
 
 		using InitDataPtr = std::unique_ptr<TextureScalerClass::InitData>;
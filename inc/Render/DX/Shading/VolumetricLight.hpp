@@ -4,18 +4,6 @@
 
 namespace Render::DX::Shading {
 	namespace VolumetricLight {
-		namespace Shader {
-			enum Type {
-				CS_CalculateScatteringAndDensity = 0,
-				CS_AccumulateScattering,
-				CS_BlendScattering,
-				VS_ApplyFog,
-				PS_ApplyFog,
-				PS_ApplyFog_Tricubic,
-				Count
-			};
-		}
-
 		namespace RootSignature {
 			enum Type {
 				GR_CalculateScatteringAndDensity = 0,
@@ -30,8 +18,7 @@ namespace Render::DX::Shading {
 					CB_Pass = 0,
 					CB_Light,
 					RC_Consts,
-					SI_ZDepthMaps,
-					SI_ZDepthCubeMaps,
+					SI_ZDepthAtlas,
 					UO_FrustumVolumeMap,
 					Count
 				};
@@ -47,7 +34,8 @@ namespace Render::DX::Shading {
 
 			namespace BlendScattering {
 				enum {
-					SI_PreviousScattering = 0,
+					RC_Consts = 0,
+					SI_PreviousScattering,
 					UIO_CurrentScattering,
 					Count
 				};
@@ -108,20 +96,23 @@ namespace Render::DX::Shading {
 			virtual BOOL Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) override;
 			virtual void CleanUp() override;
 
-			virtual BOOL CompileShaders() override;
 			virtual BOOL BuildRootSignatures() override;
 			virtual BOOL BuildPipelineStates() override;
 			virtual BOOL BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) override;
 
 		public:
+			// On checkerboard half of the froxel columns are scattered and
+			// accumulated each frame, alternating; the others keep the
+			// previous frame's result.
 			BOOL BuildFog(
 				Foundation::Resource::FrameResource* const pFrameResource,
-				Foundation::Resource::GpuResource* ppDepthMaps[],
-				D3D12_GPU_DESCRIPTOR_HANDLE si_depthMaps,
+				Foundation::Resource::GpuResource* const pZDepthAtlas,
+				D3D12_GPU_DESCRIPTOR_HANDLE si_zDepthAtlas,
 				FLOAT nearZ, FLOAT farZ, FLOAT depth_exp,
 				FLOAT uniformDensity, FLOAT densityScale, 
 				FLOAT anisotropicCoeff,
-				UINT numLights);
+				UINT numLights,
+				BOOL bCheckerboardEnabled);
 			BOOL ApplyFog(
 				Foundation::Resource::FrameResource* const pFrameResource,				
 				Foundation::Resource::GpuResource* pBackBuffer,
@@ -138,15 +129,19 @@ namespace Render::DX::Shading {
 
 			BOOL CalculateScatteringAndDensity(
 				Foundation::Resource::FrameResource* const pFrameResource,
-				Foundation::Resource::GpuResource* ppDepthMaps[],
-				D3D12_GPU_DESCRIPTOR_HANDLE si_depthMaps,
+				Foundation::Resource::GpuResource* const pZDepthAtlas,
+				D3D12_GPU_DESCRIPTOR_HANDLE si_zDepthAtlas,
 				FLOAT nearZ, FLOAT farZ, FLOAT depth_exp,
 				FLOAT uniformDensity, FLOAT anisotropicCoeff,
-				UINT numLights);
+				UINT numLights,
+				BOOL bCheckerboardEnabled);
 			BOOL AccumulateScattering(
 				Foundation::Resource::FrameResource* const pFrameResource,
-				FLOAT nearZ, FLOAT farZ, FLOAT depth_exp, FLOAT densityScale);
-			BOOL BlendScattering(Foundation::Resource::FrameResource* const pFrameResource);
+				FLOAT nearZ, FLOAT farZ, FLOAT depth_exp, FLOAT densityScale,
+				BOOL bCheckerboardEnabled);
+			BOOL BlendScattering(
+				Foundation::Resource::FrameResource* const pFrameResource,
+				BOOL bCheckerboardEnabled);
 
 		private:
 			InitData mInitData{};
@@ -154,8 +149,6 @@ namespace Render::DX::Shading {
 			std::array<Microsoft::WRL::ComPtr<ID3D12RootSignature>, RootSignature::Count> mRootSignatures{};
 			std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, PipelineState::Count> mPipelineStates{};
 
-			std::array<Common::Foundation::Hash, Shader::Count> mShaderHashes{};
-
 			std::array<std::unique_ptr<Foundation::Resource::GpuResource>, 2> mFrustumVolumeMaps{};
 			std::array<std::array<D3D12_CPU_DESCRIPTOR_HANDLE, 2>, Descriptor::FrustumVolumeMap::Count> mhFrustumVolumeMapCpus{};
 			std::array<std::array<D3D12_GPU_DESCRIPTOR_HANDLE, 2>, Descriptor::FrustumVolumeMap::Count> mhFrustumVolumeMapGpus{};
@@ -20,6 +20,7 @@ namespace Render::VK::Foundation::Core {
 	public:
 		__forceinline VkPhysicalDevice PhysicalDevice() const;
 		__forceinline VkDevice LogicalDevice() const;
+		__forceinline VkPipelineCache PipelineCache() const;
 
 	public:
 		BOOL SortPhysicalDevices();
@@ -28,6 +29,8 @@ namespace Render::VK::Foundation::Core {
 
 	private:
 		BOOL CreateLogicalDevice();
+		BOOL CreatePipelineCache();
+		void SavePipelineCache();
 
 	private:
 		Common::Debug::LogFile* mpLogFile{};
@@ -39,6 +42,7 @@ namespace Render::VK::Foundation::Core {
 
 		VkPhysicalDevice mPhysicalDevice{};
 		VkDevice mDevice{};
+		VkPipelineCache mPipelineCache{};
 	};
 }
 
@@ -9,4 +9,8 @@ VkDevice Render::VK::Foundation::Core::Device::LogicalDevice() const {
 	return mDevice;
 }
 
+VkPipelineCache Render::VK::Foundation::Core::Device::PipelineCache() const {
+	return mPipelineCache;
+}
+
 #endif // __DEVICE_INL__
\ No newline at end of file
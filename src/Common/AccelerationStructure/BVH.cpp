@@ -57,6 +57,91 @@ void CacheFriendlyBVH::UpdateBoundingVolumeHierarchy() {
 	//}
 }
 
+CacheFriendlyBVH::~CacheFriendlyBVH() {
+	Release();
+}
+
+void CacheFriendlyBVH::Build(Vertex* pVertices, Triangle* pTriangles, std::uint32_t numTriangles) {
+	Release();
+
+	mpVertices = pVertices;
+	mpTriangles = pTriangles;
+	mNumTriIndexList = numTriangles;
+
+	if (numTriangles == 0) return;
+
+	for (std::uint32_t i = 0; i < numTriangles; ++i) {
+		Triangle& triangle = mpTriangles[i];
+		triangle.Bottom = min3(min3(mpVertices[triangle.Index1], mpVertices[triangle.Index2]), mpVertices[triangle.Index3]);
+		triangle.Top = max3(max3(mpVertices[triangle.Index1], mpVertices[triangle.Index2]), mpVertices[triangle.Index3]);
+	}
+
+	mpSceneBVH = CreateBVH();
+	CreateCFBVH();
+}
+
+void CacheFriendlyBVH::Query(
+		const Vector3Df& bottom, const Vector3Df& top, std::vector<std::uint32_t>& triangles) const {
+	if (mpCFBVH == nullptr) return;
+
+	const auto overlaps = [&](const Vector3Df& b, const Vector3Df& t) {
+		return b.x <= top.x && t.x >= bottom.x
+			&& b.y <= top.y && t.y >= bottom.y
+			&& b.z <= top.z && t.z >= bottom.z;
+	};
+
+	std::uint32_t stack[BVH_STACK_SIZE * 2];
+	std::uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const CacheFriendlyBVHNode& node = mpCFBVH[stack[--stackSize]];
+		if (!overlaps(node.Bottom, node.Top)) continue;
+
+		if (node.u.Leaf.Count & 0x80000000) {
+			const std::uint32_t count = node.u.Leaf.Count & 0x7fffffff;
+			for (std::uint32_t i = 0; i < count; ++i) {
+				const std::uint32_t index = mpTriIndexList[node.u.Leaf.StartIndexInTriIndexList + i];
+				const Triangle& triangle = mpTriangles[index];
+				if (overlaps(triangle.Bottom, triangle.Top)) triangles.push_back(index);
+			}
+		}
+		else {
+			// Depth is bounded by BVH_STACK_SIZE in CreateCFBVH.
+			stack[stackSize++] = node.u.Inner.IdxRight;
+			stack[stackSize++] = node.u.Inner.IdxLeft;
+		}
+	}
+}
+
+void CacheFriendlyBVH::Release() {
+	if (mpSceneBVH != nullptr) {
+		DeleteBVH(mpSceneBVH);
+		mpSceneBVH = nullptr;
+	}
+
+	delete[] mpCFBVH;
+	mpCFBVH = nullptr;
+	mpNumCFBVH = 0;
+
+	delete[] mpTriIndexList;
+	mpTriIndexList = nullptr;
+	mNumTriIndexList = 0;
+}
+
+void CacheFriendlyBVH::DeleteBVH(BVHNode* root) {
+	// BVHNode has no virtual destructor, so delete through the concrete type.
+	if (!root->IsLeaf()) {
+		BVHInner* p = dynamic_cast<BVHInner*>(root);
+		DeleteBVH(p->Left);
+		DeleteBVH(p->Right);
+		delete p;
+	}
+	else {
+		delete dynamic_cast<BVHLeaf*>(root);
+	}
+}
+
 CacheFriendlyBVH::BVHNode* CacheFriendlyBVH::CreateBVH() {
 	/* Summary:
 	1. Create work BBox
@@ -75,6 +75,16 @@ void GameCamera::Roll(float rad) {
 	mbViewDirty = true;
 }
 
+void GameCamera::SetRotation(float pitch, float yaw, float roll) {
+	const auto quat = XMQuaternionRotationRollPitchYaw(pitch, yaw, roll);
+
+	mRight = XMVector3Rotate(UnitVector::RightVector, quat);
+	mUp = XMVector3Rotate(UnitVector::UpVector, quat);
+	mForward = XMVector3Rotate(UnitVector::ForwardVector, quat);
+
+	mbViewDirty = true;
+}
+
 void GameCamera::AddPosition(const XMVECTOR& pos) {
 	mPosition += pos;
 
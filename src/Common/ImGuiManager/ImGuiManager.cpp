@@ -5,6 +5,7 @@
 #include "Common/Foundation/Light.h"
 #include "Common/Render/ShadingArgument.hpp"
 #include "Common/Render/TonemapperType.h"
+#include "Common/Render/EffectResolution.h"
 
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
@@ -317,6 +318,14 @@ void ImGuiManager::ShadingObjectHeader(Common::Render::ShadingArgument::ShadingA
 		DOFTree(pArgSet);
 		// ChromaticAberration
 		ChromaticAberrationTree(pArgSet);
+		// GpuCulling
+		GpuCullingTree(pArgSet);
+		// OcclusionCulling
+		OcclusionCullingTree(pArgSet);
+		// TextureStreaming
+		TextureStreamingTree(pArgSet);
+		// DynamicResolution
+		DynamicResolutionTree(pArgSet);
 	}
 }
 
@@ -404,6 +413,18 @@ void ImGuiManager::AOTree(Common::Render::ShadingArgument::ShadingArgumentSet* c
 		ImGui::Indent();
 		if (pArgSet->AOEnabled) {
 			if (pArgSet->RaytracingEnabled) {
+				ImGui::Text("Resolution");
+				ImGui::Indent();
+				{
+					ImGui::RadioButton("Full", reinterpret_cast<INT*>(&pArgSet->RTAO.ResolutionType),
+						Common::Render::EffectResolution::E_FullResolution); ImGui::SameLine();
+					ImGui::RadioButton("Checkerboard", reinterpret_cast<INT*>(&pArgSet->RTAO.ResolutionType),
+						Common::Render::EffectResolution::E_Checkerboard); ImGui::SameLine();
+					ImGui::RadioButton("Half", reinterpret_cast<INT*>(&pArgSet->RTAO.ResolutionType),
+						Common::Render::EffectResolution::E_HalfResolution);
+				}
+				ImGui::Unindent();
+
 				// Ray Sorting
 				{
 					ImGui::Text("Ray Sorting");
@@ -414,10 +435,8 @@ void ImGuiManager::AOTree(Common::Render::ShadingArgument::ShadingArgumentSet* c
 						{
 							if (RaySortingDisabled) ImGui::BeginDisabled();
 
-							if (ImGui::Checkbox("Ray Sorting", reinterpret_cast<bool*>(&pArgSet->RTAO.RaySortingEnabled))) {
+							if (ImGui::Checkbox("Ray Sorting", reinterpret_cast<bool*>(&pArgSet->RTAO.RaySortingEnabled)))
 								pArgSet->RTAO.RandomFrameSeed = FALSE;
-								pArgSet->RTAO.CheckboardRayGeneration = FALSE;
-							}
 							if (RaySortingDisabled) ImGui::SetItemTooltip("Enabled only when sample count is 1");
 
 							{
@@ -425,8 +444,6 @@ void ImGuiManager::AOTree(Common::Render::ShadingArgument::ShadingArgumentSet* c
 
 								ImGui::Checkbox("Random Frame Seed", reinterpret_cast<bool*>(&pArgSet->RTAO.RandomFrameSeed));
 								if (!pArgSet->RTAO.RaySortingEnabled) ImGui::SetItemTooltip("Enabled only when ray sorting is enabled");
-								ImGui::Checkbox("Checkboard Ray Generation", reinterpret_cast<bool*>(&pArgSet->RTAO.CheckboardRayGeneration));
-								if (!pArgSet->RTAO.RaySortingEnabled) ImGui::SetItemTooltip("Enabled only when ray sorting is enabled");
 
 								if (!pArgSet->RTAO.RaySortingEnabled) ImGui::EndDisabled();
 							}
@@ -479,7 +496,6 @@ void ImGuiManager::AOTree(Common::Render::ShadingArgument::ShadingArgumentSet* c
 							static_cast<int>(pArgSet->RTAO.MaxSampleCount))) {
 							if (pArgSet->RTAO.SampleCount > 1) {
 								pArgSet->RTAO.RaySortingEnabled = FALSE;
-								pArgSet->RTAO.CheckboardRayGeneration = FALSE;
 								pArgSet->RTAO.SampleSetSize = 1;
 							}
 						}
@@ -488,6 +504,18 @@ void ImGuiManager::AOTree(Common::Render::ShadingArgument::ShadingArgumentSet* c
 				}
 			}
 			else {
+				ImGui::Text("Resolution");
+				ImGui::Indent();
+				{
+					ImGui::RadioButton("Full", reinterpret_cast<INT*>(&pArgSet->SSAO.ResolutionType),
+						Common::Render::EffectResolution::E_FullResolution); ImGui::SameLine();
+					ImGui::RadioButton("Checkerboard", reinterpret_cast<INT*>(&pArgSet->SSAO.ResolutionType),
+						Common::Render::EffectResolution::E_Checkerboard); ImGui::SameLine();
+					ImGui::RadioButton("Half", reinterpret_cast<INT*>(&pArgSet->SSAO.ResolutionType),
+						Common::Render::EffectResolution::E_HalfResolution);
+				}
+				ImGui::Unindent();
+
 				ImGui::Text("Occlusion Radius");
 				ImGui::SliderFloat("##Occlusion Radius", &pArgSet->SSAO.OcclusionRadius, pArgSet->SSAO.MinOcclusionRadius, pArgSet->SSAO.MaxOcclusionRadius);
 
@@ -514,6 +542,16 @@ void ImGuiManager::VolumetricLightTree(Common::Render::ShadingArgument::ShadingA
 	if (ImGui::TreeNode("Volumetric Light")) {
 		ImGui::Checkbox("Tricubic Sampling", reinterpret_cast<bool*>(&pArgSet->VolumetricLight.TricubicSamplingEnabled));
 
+		ImGui::Text("Resolution");
+		ImGui::Indent();
+		{
+			ImGui::RadioButton("Full", reinterpret_cast<INT*>(&pArgSet->VolumetricLight.ResolutionType),
+				Common::Render::EffectResolution::E_FullResolution); ImGui::SameLine();
+			ImGui::RadioButton("Checkerboard", reinterpret_cast<INT*>(&pArgSet->VolumetricLight.ResolutionType),
+				Common::Render::EffectResolution::E_Checkerboard);
+		}
+		ImGui::Unindent();
+
 		ImGui::Text("Anisotropic Coefficient");
 		ImGui::SliderFloat(
 			"##Anisotropic Coefficient",
@@ -627,6 +665,16 @@ void ImGuiManager::BloomTree(Common::Render::ShadingArgument::ShadingArgumentSet
 	if (ImGui::TreeNode("Bloom")) {
 		ImGui::Checkbox("Enabled", reinterpret_cast<bool*>(&pArgSet->Bloom.Enabled));
 
+		ImGui::Text("Resolution");
+		ImGui::Indent();
+		{
+			ImGui::RadioButton("Full", reinterpret_cast<INT*>(&pArgSet->Bloom.ResolutionType),
+				Common::Render::EffectResolution::E_FullResolution); ImGui::SameLine();
+			ImGui::RadioButton("Half", reinterpret_cast<INT*>(&pArgSet->Bloom.ResolutionType),
+				Common::Render::EffectResolution::E_HalfResolution);
+		}
+		ImGui::Unindent();
+
 		ImGui::TreePop();
 	}
 }
@@ -709,6 +757,80 @@ void ImGuiManager::ChromaticAberrationTree(
 			pArgSet->ChromaticAberration.MinShiftPx,
 			pArgSet->ChromaticAberration.MaxShiftPx);
 
+		ImGui::TreePop();
+	}
+}
+
+void ImGuiManager::GpuCullingTree(
+	Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet) {
+	if (ImGui::TreeNode("GPU Culling")) {
+		ImGui::Checkbox("Enabled", reinterpret_cast<bool*>(&pArgSet->GpuCulling.Enabled));
+
+		if (pArgSet->GpuCulling.Enabled) {
+			ImGui::Indent();
+			{
+				ImGui::Checkbox("Occlusion", reinterpret_cast<bool*>(&pArgSet->GpuCulling.OcclusionEnabled));
+			}
+			ImGui::Unindent();
+		}
+
+		ImGui::TreePop();
+	}
+}
+
+void ImGuiManager::OcclusionCullingTree(
+	Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet) {
+	if (ImGui::TreeNode("CPU Occlusion Culling")) {
+		ImGui::Checkbox("Enabled", reinterpret_cast<bool*>(&pArgSet->OcclusionCulling.Enabled));
+
+		ImGui::TreePop();
+	}
+}
+
+void ImGuiManager::TextureStreamingTree(
+	Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet) {
+	if (ImGui::TreeNode("Texture Streaming")) {
+		ImGui::Checkbox("Enabled", reinterpret_cast<bool*>(&pArgSet->TextureStreaming.Enabled));
+
+		ImGui::Text("Budget (MB)");
+		ImGui::SliderInt("##Budget (MB)",
+			reinterpret_cast<int*>(&pArgSet->TextureStreaming.BudgetMB),
+			pArgSet->TextureStreaming.MinBudgetMB,
+			pArgSet->TextureStreaming.MaxBudgetMB);
+
+		ImGui::TreePop();
+	}
+}
+
+void ImGuiManager::DynamicResolutionTree(
+	Common::Render::ShadingArgument::ShadingArgumentSet* const pArgSet) {
+	if (ImGui::TreeNode("Dynamic Resolution")) {
+		ImGui::Checkbox("Enabled", reinterpret_cast<bool*>(&pArgSet->DynamicResolution.Enabled));
+
+		if (pArgSet->DynamicResolution.Enabled) {
+			ImGui::Indent();
+			{
+				ImGui::Text("Target Frame Rate");
+				ImGui::SliderInt("##Target Frame Rate",
+					reinterpret_cast<int*>(&pArgSet->DynamicResolution.TargetFrameRate),
+					pArgSet->DynamicResolution.MinTargetFrameRate,
+					pArgSet->DynamicResolution.MaxTargetFrameRate);
+
+				// Each bound stops at the other, so the range never inverts.
+				ImGui::Text("Min Scale");
+				ImGui::SliderFloat("##Min Scale",
+					&pArgSet->DynamicResolution.MinScale,
+					pArgSet->DynamicResolution.LowestScale,
+					pArgSet->DynamicResolution.MaxScale);
+				ImGui::Text("Max Scale");
+				ImGui::SliderFloat("##Max Scale",
+					&pArgSet->DynamicResolution.MaxScale,
+					pArgSet->DynamicResolution.MinScale,
+					1.f);
+			}
+			ImGui::Unindent();
+		}
+
 		ImGui::TreePop();
 	}
 }
\ No newline at end of file
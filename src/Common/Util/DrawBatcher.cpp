@@ -0,0 +1,95 @@
+#include "Common/Util/DrawBatcher.hpp"
+
+#include <algorithm>
+#include <array>
+
+using namespace Common::Util;
+
+namespace {
+	const UINT RadixBits = 8;
+	const UINT RadixSize = 1 << RadixBits;
+	const UINT RadixPassCount = 64 / RadixBits;
+
+	const UINT64 DepthMask = (1ull << DrawBatcher::DepthBits) - 1;
+
+	__forceinline UINT64 Field(UINT value, UINT bits) {
+		return static_cast<UINT64>(value) & ((1ull << bits) - 1);
+	}
+}
+
+void DrawBatcher::Clear() {
+	mKeys.clear();
+	mPayloads.clear();
+	mBatches.clear();
+}
+
+void DrawBatcher::Add(UINT64 key, UINT payload) {
+	mKeys.push_back(key);
+	mPayloads.push_back(payload);
+}
+
+void DrawBatcher::Build() {
+	mBatches.clear();
+	if (mKeys.empty()) return;
+
+	RadixSort();
+
+	const UINT Count = static_cast<UINT>(mKeys.size());
+
+	UINT first = 0;
+	for (UINT i = 1; i <= Count; ++i) {
+		if (i < Count && (mKeys[i] & ~DepthMask) == (mKeys[first] & ~DepthMask)) continue;
+
+		mBatches.push_back({ first, i - first });
+		first = i;
+	}
+}
+
+UINT64 DrawBatcher::MakeKey(UINT pass, UINT pipeline, UINT material, UINT geometry, FLOAT depth) {
+	const FLOAT Clamped = std::min(std::max(depth, 0.f), 1.f);
+
+	UINT64 key = Field(pass, PassBits);
+	key = (key << PipelineBits) | Field(pipeline, PipelineBits);
+	key = (key << MaterialBits) | Field(material, MaterialBits);
+	key = (key << GeometryBits) | Field(geometry, GeometryBits);
+	key = (key << DepthBits) | static_cast<UINT64>(Clamped * static_cast<FLOAT>(DepthMask));
+
+	return key;
+}
+
+void DrawBatcher::RadixSort() {
+	const size_t Count = mKeys.size();
+
+	mScratchKeys.resize(Count);
+	mScratchPayloads.resize(Count);
+
+	// Every digit's histogram comes out of a single read of the keys.
+	std::array<std::array<UINT, RadixSize>, RadixPassCount> histograms{};
+	for (const auto key : mKeys) {
+		for (UINT pass = 0; pass < RadixPassCount; ++pass)
+			++histograms[pass][(key >> (pass * RadixBits)) & (RadixSize - 1)];
+	}
+
+	for (UINT pass = 0; pass < RadixPassCount; ++pass) {
+		const UINT Shift = pass * RadixBits;
+		auto& offsets = histograms[pass];
+
+		if (offsets[(mKeys[0] >> Shift) & (RadixSize - 1)] == Count) continue;
+
+		UINT offset = 0;
+		for (auto& bucket : offsets) {
+			const UINT Size = bucket;
+			bucket = offset;
+			offset += Size;
+		}
+
+		for (size_t i = 0; i < Count; ++i) {
+			const UINT Dst = offsets[(mKeys[i] >> Shift) & (RadixSize - 1)]++;
+			mScratchKeys[Dst] = mKeys[i];
+			mScratchPayloads[Dst] = mPayloads[i];
+		}
+
+		mKeys.swap(mScratchKeys);
+		mPayloads.swap(mScratchPayloads);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "Common/Util/DynamicResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Common::Util;
+
+namespace {
+	const FLOAT ScaleStep = 0.05f;
+
+	// Weight of a new sample in the running average.
+	const FLOAT Smoothing = 0.1f;
+	// Samples taken after a change before the average is trusted.
+	const UINT MinSampleCount = 8;
+	// Frames dropped after a change while the new targets settle.
+	const UINT CooldownFrameCount = 30;
+
+	// The scale goes down once the average is this far past the target and
+	// up only with enough headroom, so noise around the target is ignored.
+	const FLOAT DownscaleThreshold = 1.05f;
+	const FLOAT UpscaleThreshold = 0.85f;
+}
+
+void DynamicResolution::Initialize(FLOAT minScale, FLOAT maxScale, FLOAT targetFrameTime) {
+	SetBounds(minScale, maxScale);
+	SetTargetFrameTime(targetFrameTime);
+
+	Reset(mMaxScale);
+}
+
+void DynamicResolution::SetBounds(FLOAT minScale, FLOAT maxScale) {
+	mMinScale = std::clamp(minScale, ScaleStep, 1.f);
+	mMaxScale = std::clamp(maxScale, mMinScale, 1.f);
+}
+
+void DynamicResolution::SetTargetFrameTime(FLOAT targetFrameTime) {
+	mTargetFrameTime = targetFrameTime;
+}
+
+void DynamicResolution::Reset(FLOAT scale) {
+	mScale = std::clamp(scale, mMinScale, mMaxScale);
+
+	mAverageFrameTime = 0.f;
+	mSampleCount = 0;
+	mCooldownFrames = 0;
+}
+
+FLOAT DynamicResolution::Update(FLOAT frameTime) {
+	const FLOAT Bounded = std::clamp(mScale, mMinScale, mMaxScale);
+	if (Bounded != mScale) {
+		ChangeScale(Bounded);
+		return mScale;
+	}
+
+	if (frameTime <= 0.f || mTargetFrameTime <= 0.f) return mScale;
+
+	if (mCooldownFrames > 0) {
+		--mCooldownFrames;
+		return mScale;
+	}
+
+	mAverageFrameTime = mSampleCount == 0 ?
+		frameTime : mAverageFrameTime + (frameTime - mAverageFrameTime) * Smoothing;
+	++mSampleCount;
+
+	if (mSampleCount < MinSampleCount) return mScale;
+
+	const FLOAT Wanted = mScale * std::sqrt(mTargetFrameTime / mAverageFrameTime);
+
+	// Over budget the scale drops straight to where the target should be
+	// met; under it, the scale climbs a step at a time.
+	if (mAverageFrameTime > mTargetFrameTime * DownscaleThreshold) {
+		const FLOAT Next = Quantize(Wanted);
+		if (Next < mScale) ChangeScale(Next);
+	}
+	else if (mAverageFrameTime < mTargetFrameTime * UpscaleThreshold) {
+		const FLOAT Next = std::min(Quantize(Wanted), Quantize(mScale + ScaleStep));
+		if (Next > mScale) ChangeScale(Next);
+	}
+
+	return mScale;
+}
+
+FLOAT DynamicResolution::Quantize(FLOAT scale) const {
+	// The bias keeps scales already on a step from falling to the one below.
+	const FLOAT Snapped = std::floor(scale / ScaleStep + 1e-3f) * ScaleStep;
+	return std::clamp(Snapped, mMinScale, mMaxScale);
+}
+
+void DynamicResolution::ChangeScale(FLOAT scale) {
+	mScale = scale;
+
+	mAverageFrameTime = 0.f;
+	mSampleCount = 0;
+	mCooldownFrames = CooldownFrameCount;
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "Common/Util/EffectResolutionUtil.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	UINT CeilHalf(UINT value) { return (value + 1) >> 1; }
+
+	UINT SmallestPowerOf2GreaterThan(UINT x) {
+		x |= x >> 1;
+		x |= x >> 2;
+		x |= x >> 4;
+		x |= x >> 8;
+		x |= x >> 16;
+
+		return x + 1;
+	}
+
+	// Depth derivatives at z0 moved from a one-pixel to a pixelOffset step,
+	// correcting for depth not interpolating linearly in screen space.
+	FLOAT RemapDdxy(FLOAT z0, FLOAT ddxy, FLOAT pixelOffset) {
+		const FLOAT z = (z0 + ddxy) / (1.f + ((1.f - pixelOffset) / z0) * ddxy);
+		const FLOAT Sign = pixelOffset > 0.f ? 1.f : pixelOffset < 0.f ? -1.f : 0.f;
+
+		return Sign * (z - z0);
+	}
+}
+
+XMUINT2 EffectResolutionUtil::EvaluatedDim(Render::EffectResolution type, UINT width, UINT height) {
+	switch (type) {
+	case Render::EffectResolution::E_Checkerboard:
+		return { CeilHalf(width), height };
+	case Render::EffectResolution::E_HalfResolution:
+		return { CeilHalf(width), CeilHalf(height) };
+	default:
+		return { width, height };
+	}
+}
+
+XMUINT2 EffectResolutionUtil::EvaluatedPixel(
+		Render::EffectResolution type,
+		const XMUINT2& index,
+		BOOL bEvenPixelsActivated) {
+	switch (type) {
+	case Render::EffectResolution::E_Checkerboard: {
+		// Even rows start on the active parity, odd rows on the other one.
+		const BOOL IsEvenPixelY = (index.y & 1) == 0;
+		const UINT PixelOffsetX = IsEvenPixelY != bEvenPixelsActivated ? 1 : 0;
+
+		return { index.x * 2 + PixelOffsetX, index.y };
+	}
+	case Render::EffectResolution::E_HalfResolution:
+		return { index.x * 2, index.y * 2 };
+	default:
+		return index;
+	}
+}
+
+void EffectResolutionUtil::UpsampleFootprint(
+		const XMUINT2& pixel,
+		const XMUINT2& lowResDim,
+		XMUINT2 (&srcIndices)[4],
+		XMFLOAT2& targetOffset) {
+	const XMUINT2 TopLeft = { std::min(pixel.x >> 1, lowResDim.x - 1), std::min(pixel.y >> 1, lowResDim.y - 1) };
+	const XMUINT2 Offsets[4] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } };
+
+	for (UINT i = 0; i < 4; ++i) {
+		srcIndices[i] = {
+			std::min(TopLeft.x + Offsets[i].x, lowResDim.x - 1),
+			std::min(TopLeft.y + Offsets[i].y, lowResDim.y - 1) };
+	}
+
+	// Evaluated texels sit two pixels apart.
+	targetOffset = { (pixel.x & 1) * 0.5f, (pixel.y & 1) * 0.5f };
+}
+
+void EffectResolutionUtil::BilateralUpsampleWeights(
+		FLOAT depth,
+		const XMFLOAT3& normal,
+		const XMFLOAT2& targetOffset,
+		const XMFLOAT2& ddxy,
+		const UpsampleSample (&samples)[4],
+		const UpsampleParams& params,
+		FLOAT (&weights)[4]) {
+	const FLOAT BilinearWeights[4] = {
+		(1.f - targetOffset.x) * (1.f - targetOffset.y),
+		targetOffset.x * (1.f - targetOffset.y),
+		(1.f - targetOffset.x) * targetOffset.y,
+		targetOffset.x * targetOffset.y };
+
+	// The derivatives are taken per pixel, the samples lie two apart.
+	const FLOAT DepthThreshold = std::abs(RemapDdxy(depth, ddxy.x, 2.f)) + std::abs(RemapDdxy(depth, ddxy.y, 2.f));
+	const FLOAT DepthPrecision = FloatPrecision(depth, params.DepthNumMantissaBits);
+	const FLOAT DepthTolerance = params.DepthSigma * DepthThreshold + DepthPrecision;
+
+	for (UINT i = 0; i < 4; ++i) {
+		const auto& sample = samples[i];
+		if (!sample.Valid) {
+			weights[i] = 0.f;
+			continue;
+		}
+
+		FLOAT depthWeight = std::min(DepthTolerance / (std::abs(sample.Depth - depth) + DepthPrecision), 1.f);
+		if (depthWeight < params.DepthWeightCutoff) depthWeight = 0.f;
+
+		const FLOAT NdotSampleN = normal.x * sample.Normal.x + normal.y * sample.Normal.y + normal.z * sample.Normal.z;
+		const FLOAT NormalWeight = std::pow(std::clamp(NdotSampleN * params.NormalSigma, 0.f, 1.f), params.NormalSigmaExponent);
+
+		weights[i] = BilinearWeights[i] * depthWeight * NormalWeight;
+	}
+}
+
+UINT EffectResolutionUtil::NearestDepthSample(FLOAT depth, const UpsampleSample (&samples)[4]) {
+	FLOAT delta[4];
+	for (UINT i = 0; i < 4; ++i)
+		delta[i] = std::abs(depth - (samples[i].Valid ? samples[i].Depth : 1e9f));
+
+	UINT index = delta[1] < delta[0] ? 1 : 0;
+	index = delta[2] < delta[index] ? 2 : index;
+	index = delta[3] < delta[index] ? 3 : index;
+
+	return index;
+}
+
+FLOAT EffectResolutionUtil::FloatPrecision(FLOAT x, UINT numMantissaBits) {
+	const UINT NextPowerOfTwo = SmallestPowerOf2GreaterThan(static_cast<UINT>(x));
+	const FLOAT ExponentRange = static_cast<FLOAT>(NextPowerOfTwo - (NextPowerOfTwo >> 1));
+
+	return ExponentRange / static_cast<FLOAT>(1u << numMantissaBits);
+}
\ No newline at end of file
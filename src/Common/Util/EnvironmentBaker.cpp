@@ -0,0 +1,438 @@
+#include "Common/Util/EnvironmentBaker.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <immintrin.h>
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	const UINT BatchSize = 8;
+
+	const FLOAT Pi = 3.14159265359f;
+
+	// Lower bound IntegrateBrdf.hlsl clamps the roughness to.
+	const FLOAT MinRoughness = 0.04f;
+
+	// Major axis and the directions of increasing u and v of each cube
+	// face, v running down the face.
+	const FLOAT FaceAxes[6][3][3] = {
+		{ {  1.f,  0.f,  0.f }, {  0.f, 0.f, -1.f }, { 0.f, -1.f,  0.f } },
+		{ { -1.f,  0.f,  0.f }, {  0.f, 0.f,  1.f }, { 0.f, -1.f,  0.f } },
+		{ {  0.f,  1.f,  0.f }, {  1.f, 0.f,  0.f }, { 0.f,  0.f,  1.f } },
+		{ {  0.f, -1.f,  0.f }, {  1.f, 0.f,  0.f }, { 0.f,  0.f, -1.f } },
+		{ {  0.f,  0.f,  1.f }, {  1.f, 0.f,  0.f }, { 0.f, -1.f,  0.f } },
+		{ {  0.f,  0.f, -1.f }, { -1.f, 0.f,  0.f }, { 0.f, -1.f,  0.f } }
+	};
+
+	// Cosine-lobe convolution per band, divided by pi.
+	const FLOAT BandScales[EnvironmentBaker::SHCoeffCount] = {
+		1.f,
+		2.f / 3.f, 2.f / 3.f, 2.f / 3.f,
+		0.25f, 0.25f, 0.25f, 0.25f, 0.25f
+	};
+
+	__forceinline void EvaluateBasis(FLOAT x, FLOAT y, FLOAT z, FLOAT basis[EnvironmentBaker::SHCoeffCount]) {
+		basis[0] = 0.282095f;
+		basis[1] = 0.488603f * y;
+		basis[2] = 0.488603f * z;
+		basis[3] = 0.488603f * x;
+		basis[4] = 1.092548f * x * y;
+		basis[5] = 1.092548f * y * z;
+		basis[6] = 0.315392f * (3.f * z * z - 1.f);
+		basis[7] = 1.092548f * x * z;
+		basis[8] = 0.546274f * (x * x - y * y);
+	}
+
+	__forceinline void EvaluateBasis(__m256 x, __m256 y, __m256 z, __m256 basis[EnvironmentBaker::SHCoeffCount]) {
+		const __m256 C1 = _mm256_set1_ps(0.488603f);
+		const __m256 C2 = _mm256_set1_ps(1.092548f);
+
+		basis[0] = _mm256_set1_ps(0.282095f);
+		basis[1] = _mm256_mul_ps(C1, y);
+		basis[2] = _mm256_mul_ps(C1, z);
+		basis[3] = _mm256_mul_ps(C1, x);
+		basis[4] = _mm256_mul_ps(C2, _mm256_mul_ps(x, y));
+		basis[5] = _mm256_mul_ps(C2, _mm256_mul_ps(y, z));
+		basis[6] = _mm256_mul_ps(_mm256_set1_ps(0.315392f),
+			_mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(3.f), _mm256_mul_ps(z, z)), _mm256_set1_ps(1.f)));
+		basis[7] = _mm256_mul_ps(C2, _mm256_mul_ps(x, z));
+		basis[8] = _mm256_mul_ps(_mm256_set1_ps(0.546274f),
+			_mm256_sub_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)));
+	}
+
+	__forceinline FLOAT HorizontalSum(__m256 v) {
+		const __m128 Sum4 = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+		const __m128 Sum2 = _mm_add_ps(Sum4, _mm_movehl_ps(Sum4, Sum4));
+		return _mm_cvtss_f32(_mm_add_ss(Sum2, _mm_shuffle_ps(Sum2, Sum2, 1)));
+	}
+
+	FLOAT RadicalInverse(UINT bits) {
+		bits = (bits << 16u) | (bits >> 16u);
+		bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+		bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+		bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+		bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+		return static_cast<FLOAT>(bits) * 2.3283064365386963e-10f;
+	}
+
+	// Half vectors of the GGX samples around N = +Z, as ImportanceSampleGGX
+	// turns them into the tangent frame. The y component is skipped since
+	// the view vector has none.
+	void SampleHalfVectors(FLOAT roughness, UINT sampleCount, std::vector<FLOAT>& hx, std::vector<FLOAT>& hz) {
+		hx.resize(sampleCount);
+		hz.resize(sampleCount);
+
+		const FLOAT a = roughness * roughness;
+
+		for (UINT i = 0; i < sampleCount; ++i) {
+			const FLOAT Phi = 2.f * Pi * (static_cast<FLOAT>(i) / static_cast<FLOAT>(sampleCount));
+			const FLOAT Xi = RadicalInverse(i);
+
+			const FLOAT CosTheta = sqrtf((1.f - Xi) / (1.f + (a * a - 1.f) * Xi));
+			const FLOAT SinTheta = sqrtf(1.f - CosTheta * CosTheta);
+
+			hx[i] = sinf(Phi) * SinTheta;
+			hz[i] = CosTheta;
+		}
+	}
+
+	__forceinline FLOAT RowRoughness(UINT y, UINT size) {
+		return std::max((y + 0.5f) / size, MinRoughness);
+	}
+
+	// Adds one texel of the cube face with the given axes; v is constant
+	// along the row.
+	__forceinline void AccumulateTexel(
+			const FLOAT axes[3][3],
+			FLOAT u, FLOAT v,
+			const XMFLOAT4& texel,
+			FLOAT sums[EnvironmentBaker::SHCoeffCount][3],
+			FLOAT& weight) {
+		const FLOAT InvLen = 1.f / sqrtf(1.f + u * u + v * v);
+		// Solid angle of the texel, up to a constant.
+		const FLOAT w = InvLen * InvLen * InvLen;
+
+		FLOAT basis[EnvironmentBaker::SHCoeffCount];
+		EvaluateBasis(
+			(axes[0][0] + axes[1][0] * u + axes[2][0] * v) * InvLen,
+			(axes[0][1] + axes[1][1] * u + axes[2][1] * v) * InvLen,
+			(axes[0][2] + axes[1][2] * u + axes[2][2] * v) * InvLen,
+			basis);
+
+		for (UINT i = 0; i < EnvironmentBaker::SHCoeffCount; ++i) {
+			const FLOAT bw = basis[i] * w;
+			sums[i][0] += texel.x * bw;
+			sums[i][1] += texel.y * bw;
+			sums[i][2] += texel.z * bw;
+		}
+		weight += w;
+	}
+
+	// Scale and bias of the split-sum for one LUT texel; k is the IBL
+	// remapping of the roughness.
+	XMFLOAT2 IntegratePixel(FLOAT NdotV, FLOAT k, const std::vector<FLOAT>& hx, const std::vector<FLOAT>& hz) {
+		const UINT SampleCount = static_cast<UINT>(hx.size());
+
+		const FLOAT Vx = sqrtf(1.f - NdotV * NdotV);
+		const FLOAT G1V = NdotV / (NdotV * (1.f - k) + k);
+
+		FLOAT a = 0.f, b = 0.f;
+		for (UINT i = 0; i < SampleCount; ++i) {
+			const FLOAT VdotH = Vx * hx[i] + NdotV * hz[i];
+			const FLOAT NdotL = 2.f * VdotH * hz[i] - NdotV;
+			if (NdotL <= 0.f) continue;
+
+			const FLOAT G = G1V * NdotL / (NdotL * (1.f - k) + k);
+			const FLOAT GVis = G * std::max(VdotH, 0.f) / (hz[i] * NdotV);
+
+			const FLOAT f = 1.f - std::max(VdotH, 0.f);
+			const FLOAT Fc = f * f * f * f * f;
+
+			a += (1.f - Fc) * GVis;
+			b += Fc * GVis;
+		}
+
+		const FLOAT InvCount = 1.f / SampleCount;
+		return XMFLOAT2(a * InvCount, b * InvCount);
+	}
+}
+
+void EnvironmentBaker::Initialize(BOOL bAvx2Supported, UINT numThreads) {
+	mbAvx2Supported = bAvx2Supported;
+	mNumThreads = std::max(numThreads, 1u);
+}
+
+template <typename Func>
+void EnvironmentBaker::Dispatch(UINT count, Func&& func) const {
+	std::vector<std::future<void>> tasks;
+	for (UINT i = 1; i < count; ++i) tasks.push_back(std::async(std::launch::async, func, i));
+
+	if (count > 0) func(0);
+
+	for (auto& task : tasks) task.wait();
+}
+
+void EnvironmentBaker::ProjectIrradianceSH(const XMFLOAT4* const pFaces[6], UINT faceSize, IrradianceSH& sh) const {
+	struct Partial {
+		double Sums[SHCoeffCount][3]{};
+		double Weight{};
+	};
+
+	const UINT RowCount = 6 * faceSize;
+	const UINT NumChunks = std::max(std::min(mNumThreads, RowCount), 1u);
+
+	std::vector<Partial> partials(NumChunks);
+
+	Dispatch(NumChunks, [&](UINT chunk) {
+		const UINT Begin = static_cast<UINT>(static_cast<UINT64>(RowCount) * chunk / NumChunks);
+		const UINT End = static_cast<UINT>(static_cast<UINT64>(RowCount) * (chunk + 1) / NumChunks);
+
+		auto& partial = partials[chunk];
+		if (mbAvx2Supported) ProjectRowsAVX(pFaces, faceSize, Begin, End, partial.Sums, partial.Weight);
+		else ProjectRows(pFaces, faceSize, Begin, End, partial.Sums, partial.Weight);
+	});
+
+	Partial total{};
+	for (const auto& partial : partials) {
+		for (UINT i = 0; i < SHCoeffCount; ++i)
+			for (UINT c = 0; c < 3; ++c) total.Sums[i][c] += partial.Sums[i][c];
+		total.Weight += partial.Weight;
+	}
+
+	// The texel weights are solid angles up to a constant factor; scaling
+	// their sum to the full sphere removes it along with the
+	// discretization error.
+	const double Norm = total.Weight > 0.0 ? 4.0 * Pi / total.Weight : 0.0;
+
+	for (UINT i = 0; i < SHCoeffCount; ++i) {
+		const double Scale = Norm * BandScales[i];
+		sh.Coeffs[i] = XMFLOAT4(
+			static_cast<FLOAT>(total.Sums[i][0] * Scale),
+			static_cast<FLOAT>(total.Sums[i][1] * Scale),
+			static_cast<FLOAT>(total.Sums[i][2] * Scale),
+			0.f);
+	}
+}
+
+void EnvironmentBaker::BakeBrdfLut(UINT size, UINT sampleCount, std::vector<XMFLOAT2>& lut) const {
+	lut.resize(static_cast<size_t>(size) * size);
+
+	const UINT NumChunks = std::max(std::min(mNumThreads, size), 1u);
+
+	Dispatch(NumChunks, [&](UINT chunk) {
+		const UINT Begin = size * chunk / NumChunks;
+		const UINT End = size * (chunk + 1) / NumChunks;
+
+		if (mbAvx2Supported) IntegrateRowsAVX(size, sampleCount, Begin, End, lut.data());
+		else IntegrateRows(size, sampleCount, Begin, End, lut.data());
+	});
+}
+
+XMFLOAT3 EnvironmentBaker::EvaluateSH(const IrradianceSH& sh, const XMFLOAT3& normal) {
+	FLOAT basis[SHCoeffCount];
+	EvaluateBasis(normal.x, normal.y, normal.z, basis);
+
+	XMFLOAT3 result(0.f, 0.f, 0.f);
+	for (UINT i = 0; i < SHCoeffCount; ++i) {
+		result.x += sh.Coeffs[i].x * basis[i];
+		result.y += sh.Coeffs[i].y * basis[i];
+		result.z += sh.Coeffs[i].z * basis[i];
+	}
+
+	return result;
+}
+
+void EnvironmentBaker::ProjectRows(
+		const XMFLOAT4* const pFaces[6],
+		UINT faceSize,
+		UINT begin, UINT end,
+		double sums[SHCoeffCount][3],
+		double& weight) const {
+	const FLOAT TexelScale = 2.f / faceSize;
+
+	for (UINT row = begin; row < end; ++row) {
+		const UINT Face = row / faceSize;
+		const UINT y = row % faceSize;
+
+		const auto& Axes = FaceAxes[Face];
+		const FLOAT v = (y + 0.5f) * TexelScale - 1.f;
+		const XMFLOAT4* const Texels = pFaces[Face] + static_cast<size_t>(y) * faceSize;
+
+		FLOAT rowSums[SHCoeffCount][3]{};
+		FLOAT rowWeight = 0.f;
+
+		for (UINT x = 0; x < faceSize; ++x)
+			AccumulateTexel(Axes, (x + 0.5f) * TexelScale - 1.f, v, Texels[x], rowSums, rowWeight);
+
+		for (UINT i = 0; i < SHCoeffCount; ++i)
+			for (UINT c = 0; c < 3; ++c) sums[i][c] += rowSums[i][c];
+		weight += rowWeight;
+	}
+}
+
+void EnvironmentBaker::ProjectRowsAVX(
+		const XMFLOAT4* const pFaces[6],
+		UINT faceSize,
+		UINT begin, UINT end,
+		double sums[SHCoeffCount][3],
+		double& weight) const {
+	const FLOAT TexelScale = 2.f / faceSize;
+	const UINT BatchEnd = faceSize / BatchSize * BatchSize;
+
+	const __m256 One = _mm256_set1_ps(1.f);
+	const __m256 Lane = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+	// Offsets of the red channel of eight consecutive RGBA texels.
+	const __m256i Gather = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+
+	for (UINT row = begin; row < end; ++row) {
+		const UINT Face = row / faceSize;
+		const UINT y = row % faceSize;
+
+		const auto& Axes = FaceAxes[Face];
+		const FLOAT v = (y + 0.5f) * TexelScale - 1.f;
+		const XMFLOAT4* const Texels = pFaces[Face] + static_cast<size_t>(y) * faceSize;
+
+		// Parts of the direction that are constant along the row.
+		const __m256 BaseX = _mm256_set1_ps(Axes[0][0] + Axes[2][0] * v);
+		const __m256 BaseY = _mm256_set1_ps(Axes[0][1] + Axes[2][1] * v);
+		const __m256 BaseZ = _mm256_set1_ps(Axes[0][2] + Axes[2][2] * v);
+		const __m256 AxisUX = _mm256_set1_ps(Axes[1][0]);
+		const __m256 AxisUY = _mm256_set1_ps(Axes[1][1]);
+		const __m256 AxisUZ = _mm256_set1_ps(Axes[1][2]);
+		const __m256 LenBase = _mm256_set1_ps(1.f + v * v);
+
+		__m256 rowSums[SHCoeffCount][3];
+		for (UINT i = 0; i < SHCoeffCount; ++i)
+			for (UINT c = 0; c < 3; ++c) rowSums[i][c] = _mm256_setzero_ps();
+		__m256 rowWeight = _mm256_setzero_ps();
+
+		for (UINT x = 0; x < BatchEnd; x += BatchSize) {
+			const __m256 u = _mm256_sub_ps(
+				_mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps(static_cast<FLOAT>(x)), Lane), _mm256_set1_ps(TexelScale)), One);
+
+			const __m256 InvLen = _mm256_div_ps(One, _mm256_sqrt_ps(_mm256_add_ps(LenBase, _mm256_mul_ps(u, u))));
+			const __m256 w = _mm256_mul_ps(InvLen, _mm256_mul_ps(InvLen, InvLen));
+
+			const __m256 dx = _mm256_mul_ps(_mm256_add_ps(BaseX, _mm256_mul_ps(AxisUX, u)), InvLen);
+			const __m256 dy = _mm256_mul_ps(_mm256_add_ps(BaseY, _mm256_mul_ps(AxisUY, u)), InvLen);
+			const __m256 dz = _mm256_mul_ps(_mm256_add_ps(BaseZ, _mm256_mul_ps(AxisUZ, u)), InvLen);
+
+			__m256 basis[SHCoeffCount];
+			EvaluateBasis(dx, dy, dz, basis);
+
+			const FLOAT* const Base = &Texels[x].x;
+			const __m256 Color[3] = {
+				_mm256_i32gather_ps(Base, Gather, 4),
+				_mm256_i32gather_ps(Base + 1, Gather, 4),
+				_mm256_i32gather_ps(Base + 2, Gather, 4)
+			};
+
+			for (UINT i = 0; i < SHCoeffCount; ++i) {
+				const __m256 bw = _mm256_mul_ps(basis[i], w);
+				for (UINT c = 0; c < 3; ++c)
+					rowSums[i][c] = _mm256_add_ps(rowSums[i][c], _mm256_mul_ps(Color[c], bw));
+			}
+			rowWeight = _mm256_add_ps(rowWeight, w);
+		}
+
+		// Faces narrower than a batch, or a ragged tail.
+		FLOAT tailSums[SHCoeffCount][3]{};
+		FLOAT tailWeight = 0.f;
+		for (UINT x = BatchEnd; x < faceSize; ++x)
+			AccumulateTexel(Axes, (x + 0.5f) * TexelScale - 1.f, v, Texels[x], tailSums, tailWeight);
+
+		for (UINT i = 0; i < SHCoeffCount; ++i)
+			for (UINT c = 0; c < 3; ++c) sums[i][c] += HorizontalSum(rowSums[i][c]) + tailSums[i][c];
+		weight += HorizontalSum(rowWeight) + tailWeight;
+	}
+}
+
+void EnvironmentBaker::IntegrateRows(
+		UINT size,
+		UINT sampleCount,
+		UINT begin, UINT end,
+		XMFLOAT2* const pLut) const {
+	std::vector<FLOAT> hx, hz;
+
+	for (UINT y = begin; y < end; ++y) {
+		const FLOAT Roughness = RowRoughness(y, size);
+		const FLOAT k = Roughness * Roughness * 0.5f;
+
+		SampleHalfVectors(Roughness, sampleCount, hx, hz);
+
+		XMFLOAT2* const Row = pLut + static_cast<size_t>(y) * size;
+		for (UINT x = 0; x < size; ++x) Row[x] = IntegratePixel((x + 0.5f) / size, k, hx, hz);
+	}
+}
+
+void EnvironmentBaker::IntegrateRowsAVX(
+		UINT size,
+		UINT sampleCount,
+		UINT begin, UINT end,
+		XMFLOAT2* const pLut) const {
+	std::vector<FLOAT> hx, hz;
+	const FLOAT InvCount = 1.f / sampleCount;
+	const UINT BatchEnd = size / BatchSize * BatchSize;
+
+	const __m256 Zero = _mm256_setzero_ps();
+	const __m256 One = _mm256_set1_ps(1.f);
+	const __m256 Two = _mm256_set1_ps(2.f);
+	const __m256 Lane = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+
+	for (UINT y = begin; y < end; ++y) {
+		const FLOAT Roughness = RowRoughness(y, size);
+		const FLOAT k = Roughness * Roughness * 0.5f;
+
+		SampleHalfVectors(Roughness, sampleCount, hx, hz);
+
+		const __m256 K = _mm256_set1_ps(k);
+		const __m256 OneMinusK = _mm256_set1_ps(1.f - k);
+
+		// Eight columns share every sample; only the view vector differs.
+		for (UINT x = 0; x < BatchEnd; x += BatchSize) {
+			const __m256 NdotV = _mm256_div_ps(
+				_mm256_add_ps(_mm256_set1_ps(static_cast<FLOAT>(x)), Lane), _mm256_set1_ps(static_cast<FLOAT>(size)));
+			const __m256 Vx = _mm256_sqrt_ps(_mm256_sub_ps(One, _mm256_mul_ps(NdotV, NdotV)));
+			const __m256 G1V = _mm256_div_ps(NdotV, _mm256_add_ps(_mm256_mul_ps(NdotV, OneMinusK), K));
+
+			__m256 a = Zero, b = Zero;
+			for (UINT i = 0; i < sampleCount; ++i) {
+				const __m256 Hx = _mm256_set1_ps(hx[i]);
+				const __m256 Hz = _mm256_set1_ps(hz[i]);
+
+				const __m256 VdotH = _mm256_add_ps(_mm256_mul_ps(Vx, Hx), _mm256_mul_ps(NdotV, Hz));
+				const __m256 NdotL = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(Two, VdotH), Hz), NdotV);
+				const __m256 Valid = _mm256_cmp_ps(NdotL, Zero, _CMP_GT_OQ);
+				if (_mm256_movemask_ps(Valid) == 0) continue;
+
+				const __m256 G = _mm256_div_ps(
+					_mm256_mul_ps(G1V, NdotL), _mm256_add_ps(_mm256_mul_ps(NdotL, OneMinusK), K));
+				const __m256 ClampedVdotH = _mm256_max_ps(VdotH, Zero);
+				const __m256 GVis = _mm256_and_ps(Valid, _mm256_div_ps(
+					_mm256_mul_ps(G, ClampedVdotH), _mm256_mul_ps(Hz, NdotV)));
+
+				const __m256 f = _mm256_sub_ps(One, ClampedVdotH);
+				const __m256 f2 = _mm256_mul_ps(f, f);
+				const __m256 Fc = _mm256_mul_ps(_mm256_mul_ps(f2, f2), f);
+
+				a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(One, Fc), GVis));
+				b = _mm256_add_ps(b, _mm256_mul_ps(Fc, GVis));
+			}
+
+			alignas(32) FLOAT resultA[BatchSize];
+			alignas(32) FLOAT resultB[BatchSize];
+			_mm256_store_ps(resultA, a);
+			_mm256_store_ps(resultB, b);
+
+			XMFLOAT2* const Texels = pLut + static_cast<size_t>(y) * size + x;
+			for (UINT lane = 0; lane < BatchSize; ++lane)
+				Texels[lane] = XMFLOAT2(resultA[lane] * InvCount, resultB[lane] * InvCount);
+		}
+
+		XMFLOAT2* const Row = pLut + static_cast<size_t>(y) * size;
+		for (UINT x = BatchEnd; x < size; ++x) Row[x] = IntegratePixel((x + 0.5f) / size, k, hx, hz);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include "Common/Util/FrustumCuller.hpp"
+
+#include <algorithm>
+#include <future>
+#include <immintrin.h>
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	const UINT BatchSize = 8;
+
+	// Appends base + i for every set bit i of the mask.
+	__forceinline void WriteVisible(UINT base, UINT mask, std::vector<UINT>& visible) {
+		while (mask) {
+			unsigned long bit;
+			_BitScanForward(&bit, mask);
+			visible.push_back(base + bit);
+			mask &= mask - 1;
+		}
+	}
+}
+
+void FrustumCuller::Initialize(BOOL bAvx2Supported, UINT numThreads) {
+	mbAvx2Supported = bAvx2Supported;
+	mNumThreads = std::max(numThreads, 1u);
+	mChunkVisible.resize(mNumThreads);
+}
+
+void FrustumCuller::Clear() {
+	mBoxCenterX.clear();
+	mBoxCenterY.clear();
+	mBoxCenterZ.clear();
+	mBoxExtentX.clear();
+	mBoxExtentY.clear();
+	mBoxExtentZ.clear();
+
+	mSphereCenterX.clear();
+	mSphereCenterY.clear();
+	mSphereCenterZ.clear();
+	mSphereRadius.clear();
+}
+
+UINT FrustumCuller::AddBox(const BoundingBox& box) {
+	const UINT index = BoxCount();
+
+	mBoxCenterX.push_back(box.Center.x);
+	mBoxCenterY.push_back(box.Center.y);
+	mBoxCenterZ.push_back(box.Center.z);
+	mBoxExtentX.push_back(box.Extents.x);
+	mBoxExtentY.push_back(box.Extents.y);
+	mBoxExtentZ.push_back(box.Extents.z);
+
+	return index;
+}
+
+void FrustumCuller::UpdateBox(UINT index, const BoundingBox& box) {
+	mBoxCenterX[index] = box.Center.x;
+	mBoxCenterY[index] = box.Center.y;
+	mBoxCenterZ[index] = box.Center.z;
+	mBoxExtentX[index] = box.Extents.x;
+	mBoxExtentY[index] = box.Extents.y;
+	mBoxExtentZ[index] = box.Extents.z;
+}
+
+UINT FrustumCuller::AddSphere(const BoundingSphere& sphere) {
+	const UINT index = SphereCount();
+
+	mSphereCenterX.push_back(sphere.Center.x);
+	mSphereCenterY.push_back(sphere.Center.y);
+	mSphereCenterZ.push_back(sphere.Center.z);
+	mSphereRadius.push_back(sphere.Radius);
+
+	return index;
+}
+
+void FrustumCuller::UpdateSphere(UINT index, const BoundingSphere& sphere) {
+	mSphereCenterX[index] = sphere.Center.x;
+	mSphereCenterY[index] = sphere.Center.y;
+	mSphereCenterZ[index] = sphere.Center.z;
+	mSphereRadius[index] = sphere.Radius;
+}
+
+template <typename Func>
+void FrustumCuller::Dispatch(UINT count, std::vector<UINT>& visible, Func&& func) {
+	visible.clear();
+	if (count == 0) return;
+
+	if (count < ParallelThreshold || mNumThreads == 1) {
+		func(0, count, visible);
+		return;
+	}
+
+	// Chunks are kept a multiple of the batch size so only the last one
+	// has a scalar tail; results are concatenated in chunk order.
+	UINT chunk = (count + mNumThreads - 1) / mNumThreads;
+	chunk = (chunk + BatchSize - 1) / BatchSize * BatchSize;
+
+	const UINT numChunks = (count + chunk - 1) / chunk;
+	mChunkVisible.resize(std::max(numChunks, static_cast<UINT>(mChunkVisible.size())));
+
+	std::vector<std::future<void>> tasks;
+	for (UINT c = 1; c < numChunks; ++c) {
+		tasks.emplace_back(std::async(std::launch::async, [&, c] {
+			auto& out = mChunkVisible[c];
+			out.clear();
+			func(c * chunk, std::min((c + 1) * chunk, count), out);
+		}));
+	}
+
+	func(0, std::min(chunk, count), visible);
+
+	for (UINT c = 1; c < numChunks; ++c) {
+		tasks[c - 1].get();
+		visible.insert(visible.end(), mChunkVisible[c].begin(), mChunkVisible[c].end());
+	}
+}
+
+void FrustumCuller::CullBoxes(const Frustum& frustum, std::vector<UINT>& visible) {
+	Dispatch(BoxCount(), visible, [&](UINT begin, UINT end, std::vector<UINT>& out) {
+		if (mbAvx2Supported) CullBoxRangeAVX(frustum, begin, end, out);
+		else CullBoxRange(frustum, begin, end, out);
+	});
+}
+
+void FrustumCuller::CullSpheres(const Frustum& frustum, std::vector<UINT>& visible) {
+	Dispatch(SphereCount(), visible, [&](UINT begin, UINT end, std::vector<UINT>& out) {
+		if (mbAvx2Supported) CullSphereRangeAVX(frustum, begin, end, out);
+		else CullSphereRange(frustum, begin, end, out);
+	});
+}
+
+BOOL FrustumCuller::IntersectsBox(const Frustum& frustum, UINT index) const {
+	for (UINT p = 0; p < 6; ++p) {
+		const auto& plane = frustum.Planes[p];
+
+		const FLOAT distance = plane.x * mBoxCenterX[index] + plane.y * mBoxCenterY[index] + plane.z * mBoxCenterZ[index] + plane.w;
+		const FLOAT radius = fabsf(plane.x) * mBoxExtentX[index] + fabsf(plane.y) * mBoxExtentY[index] + fabsf(plane.z) * mBoxExtentZ[index];
+
+		if (distance + radius < 0.f) return FALSE;
+	}
+
+	return TRUE;
+}
+
+void FrustumCuller::BuildFrustum(const XMFLOAT4X4& view, const XMFLOAT4X4& proj, Frustum& frustum) {
+	XMFLOAT4X4 viewProj;
+	XMStoreFloat4x4(&viewProj, XMMatrixMultiply(XMLoadFloat4x4(&view), XMLoadFloat4x4(&proj)));
+
+	BuildFrustum(viewProj, frustum);
+}
+
+void FrustumCuller::BuildFrustum(const XMFLOAT4X4& viewProj, Frustum& frustum) {
+	// Gribb and Hartmann. With row vectors the clip-space coordinates are
+	// the columns of the view-projection matrix.
+	const XMVECTOR col0 = XMVectorSet(viewProj._11, viewProj._21, viewProj._31, viewProj._41);
+	const XMVECTOR col1 = XMVectorSet(viewProj._12, viewProj._22, viewProj._32, viewProj._42);
+	const XMVECTOR col2 = XMVectorSet(viewProj._13, viewProj._23, viewProj._33, viewProj._43);
+	const XMVECTOR col3 = XMVectorSet(viewProj._14, viewProj._24, viewProj._34, viewProj._44);
+
+	const XMVECTOR planes[6] = {
+		col3 + col0, // Left
+		col3 - col0, // Right
+		col3 + col1, // Bottom
+		col3 - col1, // Top
+		col2,		 // Near
+		col3 - col2	 // Far
+	};
+
+	for (UINT i = 0; i < 6; ++i)
+		XMStoreFloat4(&frustum.Planes[i], XMPlaneNormalize(planes[i]));
+}
+
+BOOL FrustumCuller::SphereIntersectsCone(
+		const BoundingSphere& sphere, const XMFLOAT3& apex, const XMFLOAT3& direction, FLOAT halfAngle, FLOAT range) {
+	const XMVECTOR axis = XMVector3Normalize(XMLoadFloat3(&direction));
+	const XMVECTOR offset = XMLoadFloat3(&sphere.Center) - XMLoadFloat3(&apex);
+
+	const FLOAT along = XMVectorGetX(XMVector3Dot(offset, axis));
+	if (along < -sphere.Radius || along > range + sphere.Radius) return FALSE;
+
+	const FLOAT lengthSq = XMVectorGetX(XMVector3LengthSq(offset));
+	const FLOAT across = sqrtf(std::max(lengthSq - along * along, 0.f));
+
+	// Distance from the centre to the cone's side, measured perpendicular to it.
+	return cosf(halfAngle) * across - sinf(halfAngle) * along <= sphere.Radius;
+}
+
+BoundingBox FrustumCuller::TransformBox(const BoundingBox& box, const XMFLOAT4X4& world) {
+	// Arvo: the new extents are the old ones through the absolute matrix.
+	const XMFLOAT3 center{
+		box.Center.x * world._11 + box.Center.y * world._21 + box.Center.z * world._31 + world._41,
+		box.Center.x * world._12 + box.Center.y * world._22 + box.Center.z * world._32 + world._42,
+		box.Center.x * world._13 + box.Center.y * world._23 + box.Center.z * world._33 + world._43 };
+	const XMFLOAT3 extents{
+		box.Extents.x * fabsf(world._11) + box.Extents.y * fabsf(world._21) + box.Extents.z * fabsf(world._31),
+		box.Extents.x * fabsf(world._12) + box.Extents.y * fabsf(world._22) + box.Extents.z * fabsf(world._32),
+		box.Extents.x * fabsf(world._13) + box.Extents.y * fabsf(world._23) + box.Extents.z * fabsf(world._33) };
+
+	return BoundingBox(center, extents);
+}
+
+void FrustumCuller::CullBoxRange(const Frustum& frustum, UINT begin, UINT end, std::vector<UINT>& visible) const {
+	for (UINT i = begin; i < end; ++i) {
+		BOOL inside = TRUE;
+
+		for (UINT p = 0; p < 6 && inside; ++p) {
+			const auto& plane = frustum.Planes[p];
+
+			const FLOAT distance = plane.x * mBoxCenterX[i] + plane.y * mBoxCenterY[i] + plane.z * mBoxCenterZ[i] + plane.w;
+			const FLOAT radius = fabsf(plane.x) * mBoxExtentX[i] + fabsf(plane.y) * mBoxExtentY[i] + fabsf(plane.z) * mBoxExtentZ[i];
+
+			inside = distance + radius >= 0.f;
+		}
+
+		if (inside) visible.push_back(i);
+	}
+}
+
+void FrustumCuller::CullSphereRange(const Frustum& frustum, UINT begin, UINT end, std::vector<UINT>& visible) const {
+	for (UINT i = begin; i < end; ++i) {
+		BOOL inside = TRUE;
+
+		for (UINT p = 0; p < 6 && inside; ++p) {
+			const auto& plane = frustum.Planes[p];
+
+			const FLOAT distance = plane.x * mSphereCenterX[i] + plane.y * mSphereCenterY[i] + plane.z * mSphereCenterZ[i] + plane.w;
+
+			inside = distance + mSphereRadius[i] >= 0.f;
+		}
+
+		if (inside) visible.push_back(i);
+	}
+}
+
+void FrustumCuller::CullBoxRangeAVX(const Frustum& frustum, UINT begin, UINT end, std::vector<UINT>& visible) const {
+	__m256 nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+	for (UINT p = 0; p < 6; ++p) {
+		const auto& plane = frustum.Planes[p];
+		nx[p] = _mm256_set1_ps(plane.x);
+		ny[p] = _mm256_set1_ps(plane.y);
+		nz[p] = _mm256_set1_ps(plane.z);
+		nw[p] = _mm256_set1_ps(plane.w);
+		ax[p] = _mm256_set1_ps(fabsf(plane.x));
+		ay[p] = _mm256_set1_ps(fabsf(plane.y));
+		az[p] = _mm256_set1_ps(fabsf(plane.z));
+	}
+
+	const __m256 zero = _mm256_setzero_ps();
+
+	UINT i = begin;
+	for (; i + BatchSize <= end; i += BatchSize) {
+		const __m256 cx = _mm256_loadu_ps(&mBoxCenterX[i]);
+		const __m256 cy = _mm256_loadu_ps(&mBoxCenterY[i]);
+		const __m256 cz = _mm256_loadu_ps(&mBoxCenterZ[i]);
+		const __m256 ex = _mm256_loadu_ps(&mBoxExtentX[i]);
+		const __m256 ey = _mm256_loadu_ps(&mBoxExtentY[i]);
+		const __m256 ez = _mm256_loadu_ps(&mBoxExtentZ[i]);
+
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (UINT p = 0; p < 6; ++p) {
+			__m256 distance = _mm256_add_ps(_mm256_mul_ps(nx[p], cx), nw[p]);
+			distance = _mm256_add_ps(_mm256_mul_ps(ny[p], cy), distance);
+			distance = _mm256_add_ps(_mm256_mul_ps(nz[p], cz), distance);
+
+			__m256 radius = _mm256_mul_ps(ax[p], ex);
+			radius = _mm256_add_ps(_mm256_mul_ps(ay[p], ey), radius);
+			radius = _mm256_add_ps(_mm256_mul_ps(az[p], ez), radius);
+
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+		}
+
+		WriteVisible(i, static_cast<UINT>(_mm256_movemask_ps(inside)), visible);
+	}
+
+	if (i < end) CullBoxRange(frustum, i, end, visible);
+}
+
+void FrustumCuller::CullSphereRangeAVX(const Frustum& frustum, UINT begin, UINT end, std::vector<UINT>& visible) const {
+	__m256 nx[6], ny[6], nz[6], nw[6];
+	for (UINT p = 0; p < 6; ++p) {
+		const auto& plane = frustum.Planes[p];
+		nx[p] = _mm256_set1_ps(plane.x);
+		ny[p] = _mm256_set1_ps(plane.y);
+		nz[p] = _mm256_set1_ps(plane.z);
+		nw[p] = _mm256_set1_ps(plane.w);
+	}
+
+	UINT i = begin;
+	for (; i + BatchSize <= end; i += BatchSize) {
+		const __m256 cx = _mm256_loadu_ps(&mSphereCenterX[i]);
+		const __m256 cy = _mm256_loadu_ps(&mSphereCenterY[i]);
+		const __m256 cz = _mm256_loadu_ps(&mSphereCenterZ[i]);
+		const __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&mSphereRadius[i]));
+
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (UINT p = 0; p < 6; ++p) {
+			__m256 distance = _mm256_add_ps(_mm256_mul_ps(nx[p], cx), nw[p]);
+			distance = _mm256_add_ps(_mm256_mul_ps(ny[p], cy), distance);
+			distance = _mm256_add_ps(_mm256_mul_ps(nz[p], cz), distance);
+
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+		}
+
+		WriteVisible(i, static_cast<UINT>(_mm256_movemask_ps(inside)), visible);
+	}
+
+	if (i < end) CullSphereRange(frustum, i, end, visible);
+}
\ No newline at end of file
@@ -4,4 +4,16 @@ using namespace Common::Util;
 
 size_t HashUtil::HashCombine(size_t seed, size_t value) {
 	return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+size_t HashUtil::HashBytes(const void* const pData, size_t size) {
+	const auto Bytes = reinterpret_cast<const unsigned char*>(pData);
+
+	unsigned long long hash = 0xcbf29ce484222325ull;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= Bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+
+	return static_cast<size_t>(hash);
 }
\ No newline at end of file
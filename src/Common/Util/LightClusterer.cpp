@@ -0,0 +1,322 @@
+#include "Common/Util/LightClusterer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <immintrin.h>
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	const UINT BatchSize = 8;
+}
+
+void LightClusterer::Initialize(BOOL bAvx2Supported, UINT numThreads) {
+	mbAvx2Supported = bAvx2Supported;
+	mNumThreads = std::max(numThreads, 1u);
+}
+
+void LightClusterer::Clear() {
+	mCenterX.clear();
+	mCenterY.clear();
+	mCenterZ.clear();
+	mRadius.clear();
+}
+
+UINT LightClusterer::AddLight(const BoundingSphere& bounds) {
+	const UINT index = LightCount();
+
+	mCenterX.push_back(bounds.Center.x);
+	mCenterY.push_back(bounds.Center.y);
+	mCenterZ.push_back(bounds.Center.z);
+	mRadius.push_back(bounds.Radius);
+
+	return index;
+}
+
+void LightClusterer::UpdateLight(UINT index, const BoundingSphere& bounds) {
+	mCenterX[index] = bounds.Center.x;
+	mCenterY[index] = bounds.Center.y;
+	mCenterZ[index] = bounds.Center.z;
+	mRadius[index] = bounds.Radius;
+}
+
+template <typename Func>
+void LightClusterer::Dispatch(UINT count, UINT granularity, BOOL bParallel, Func&& func) {
+	if (count == 0) return;
+
+	if (!bParallel || mNumThreads == 1) {
+		func(0, count);
+		return;
+	}
+
+	UINT chunk = (count + mNumThreads - 1) / mNumThreads;
+	chunk = (chunk + granularity - 1) / granularity * granularity;
+
+	const UINT numChunks = (count + chunk - 1) / chunk;
+
+	std::vector<std::future<void>> tasks;
+	for (UINT c = 1; c < numChunks; ++c) {
+		tasks.emplace_back(std::async(std::launch::async, [&, c] {
+			func(c * chunk, std::min((c + 1) * chunk, count));
+		}));
+	}
+
+	func(0, std::min(chunk, count));
+
+	for (auto& task : tasks) task.get();
+}
+
+void LightClusterer::Build(const Grid& grid, const XMFLOAT4X4& view, const XMFLOAT4X4& proj) {
+	mGrid = grid;
+	mView = view;
+	mProjX = proj._11;
+	mProjY = proj._22;
+
+	mSliceFar.resize(grid.CountZ);
+	for (UINT k = 0; k < grid.CountZ; ++k)
+		mSliceFar[k] = grid.NearZ * powf(grid.FarZ / grid.NearZ, static_cast<FLOAT>(k + 1) / grid.CountZ);
+
+	const UINT NumLights = LightCount();
+	const BOOL Parallel = NumLights >= ParallelThreshold;
+
+	mMinX.resize(NumLights);
+	mMaxX.resize(NumLights);
+	mMinY.resize(NumLights);
+	mMaxY.resize(NumLights);
+	mMinZ.resize(NumLights);
+	mMaxZ.resize(NumLights);
+
+	// Chunks are kept a multiple of the batch size so only the last one
+	// has a scalar tail.
+	Dispatch(NumLights, BatchSize, Parallel, [&](UINT begin, UINT end) {
+		if (mbAvx2Supported) ComputeRangesAVX(begin, end);
+		else ComputeRanges(begin, end);
+	});
+
+	// Every worker owns a slab of slices, so no two of them touch the same
+	// cluster list.
+	const UINT NumClusters = grid.CountX * grid.CountY * grid.CountZ;
+	mClusterLights.resize(NumClusters);
+
+	Dispatch(grid.CountZ, 1, Parallel, [&](UINT begin, UINT end) {
+		AssignSlices(begin, end);
+	});
+
+	mClusters.resize(NumClusters);
+
+	UINT offset = 0;
+	for (UINT c = 0; c < NumClusters; ++c) {
+		const UINT Count = static_cast<UINT>(mClusterLights[c].size());
+		mClusters[c] = { offset, Count };
+		offset += Count;
+	}
+
+	mLightIndices.resize(offset);
+	for (UINT c = 0; c < NumClusters; ++c)
+		std::copy(mClusterLights[c].begin(), mClusterLights[c].end(), mLightIndices.begin() + mClusters[c].Offset);
+}
+
+BoundingSphere LightClusterer::SpotLightBounds(
+		const XMFLOAT3& position, const XMFLOAT3& direction, FLOAT range, FLOAT halfAngle) {
+	FLOAT distance, radius;
+
+	// A wide cone is bounded by the circle of its base; a narrow one by
+	// the sphere through its apex and that circle.
+	if (halfAngle > XM_PIDIV4) {
+		distance = cosf(halfAngle) * range;
+		radius = sinf(halfAngle) * range;
+	}
+	else {
+		radius = range / (2.f * cosf(halfAngle));
+		distance = radius;
+	}
+
+	const XMFLOAT3 center{
+		position.x + direction.x * distance,
+		position.y + direction.y * distance,
+		position.z + direction.z * distance };
+
+	return BoundingSphere(center, radius);
+}
+
+void LightClusterer::DepthSliceParams(const Grid& grid, FLOAT& scale, FLOAT& bias) {
+	const FLOAT LogRange = log2f(grid.FarZ / grid.NearZ);
+
+	scale = grid.CountZ / LogRange;
+	bias = -static_cast<FLOAT>(grid.CountZ) * log2f(grid.NearZ) / LogRange;
+}
+
+void LightClusterer::ComputeRanges(UINT begin, UINT end) {
+	const FLOAT MaxTileX = static_cast<FLOAT>(mGrid.CountX - 1);
+	const FLOAT MaxTileY = static_cast<FLOAT>(mGrid.CountY - 1);
+
+	const auto SliceBegin = mSliceFar.begin();
+	const auto SliceEnd = mSliceFar.end() - 1;
+
+	for (UINT i = begin; i < end; ++i) {
+		const FLOAT vx = mCenterX[i] * mView._11 + mCenterY[i] * mView._21 + mCenterZ[i] * mView._31 + mView._41;
+		const FLOAT vy = mCenterX[i] * mView._12 + mCenterY[i] * mView._22 + mCenterZ[i] * mView._32 + mView._42;
+		const FLOAT vz = mCenterX[i] * mView._13 + mCenterY[i] * mView._23 + mCenterZ[i] * mView._33 + mView._43;
+		const FLOAT r = mRadius[i];
+
+		mMinZ[i] = 1;
+		mMaxZ[i] = 0;
+
+		if (vz + r < mGrid.NearZ || vz - r > mGrid.FarZ) continue;
+
+		const FLOAT zNear = std::max(vz - r, mGrid.NearZ);
+		const FLOAT zFar = std::min(vz + r, mGrid.FarZ);
+
+		// x / z over the view-space box around the sphere is extremal at
+		// its corners.
+		const FLOAT x0 = vx - r, x1 = vx + r;
+		const FLOAT y0 = vy - r, y1 = vy + r;
+
+		const FLOAT ndcMinX = std::min(x0 / zNear, x0 / zFar) * mProjX;
+		const FLOAT ndcMaxX = std::max(x1 / zNear, x1 / zFar) * mProjX;
+		const FLOAT ndcMinY = std::min(y0 / zNear, y0 / zFar) * mProjY;
+		const FLOAT ndcMaxY = std::max(y1 / zNear, y1 / zFar) * mProjY;
+
+		if (ndcMaxX < -1.f || ndcMinX > 1.f || ndcMaxY < -1.f || ndcMinY > 1.f) continue;
+
+		mMinX[i] = static_cast<INT>(std::clamp(floorf((ndcMinX * 0.5f + 0.5f) * mGrid.CountX), 0.f, MaxTileX));
+		mMaxX[i] = static_cast<INT>(std::clamp(floorf((ndcMaxX * 0.5f + 0.5f) * mGrid.CountX), 0.f, MaxTileX));
+		// Texture v grows downwards.
+		mMinY[i] = static_cast<INT>(std::clamp(floorf((0.5f - ndcMaxY * 0.5f) * mGrid.CountY), 0.f, MaxTileY));
+		mMaxY[i] = static_cast<INT>(std::clamp(floorf((0.5f - ndcMinY * 0.5f) * mGrid.CountY), 0.f, MaxTileY));
+
+		mMinZ[i] = static_cast<INT>(std::upper_bound(SliceBegin, SliceEnd, zNear) - SliceBegin);
+		mMaxZ[i] = static_cast<INT>(std::upper_bound(SliceBegin, SliceEnd, zFar) - SliceBegin);
+	}
+}
+
+void LightClusterer::ComputeRangesAVX(UINT begin, UINT end) {
+	const __m256 v11 = _mm256_set1_ps(mView._11), v12 = _mm256_set1_ps(mView._12), v13 = _mm256_set1_ps(mView._13);
+	const __m256 v21 = _mm256_set1_ps(mView._21), v22 = _mm256_set1_ps(mView._22), v23 = _mm256_set1_ps(mView._23);
+	const __m256 v31 = _mm256_set1_ps(mView._31), v32 = _mm256_set1_ps(mView._32), v33 = _mm256_set1_ps(mView._33);
+	const __m256 v41 = _mm256_set1_ps(mView._41), v42 = _mm256_set1_ps(mView._42), v43 = _mm256_set1_ps(mView._43);
+
+	const __m256 nearZ = _mm256_set1_ps(mGrid.NearZ);
+	const __m256 farZ = _mm256_set1_ps(mGrid.FarZ);
+	const __m256 projX = _mm256_set1_ps(mProjX);
+	const __m256 projY = _mm256_set1_ps(mProjY);
+	const __m256 countX = _mm256_set1_ps(static_cast<FLOAT>(mGrid.CountX));
+	const __m256 countY = _mm256_set1_ps(static_cast<FLOAT>(mGrid.CountY));
+	const __m256 maxTileX = _mm256_set1_ps(static_cast<FLOAT>(mGrid.CountX - 1));
+	const __m256 maxTileY = _mm256_set1_ps(static_cast<FLOAT>(mGrid.CountY - 1));
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 one = _mm256_set1_ps(1.f);
+	const __m256 negOne = _mm256_set1_ps(-1.f);
+	const __m256 zero = _mm256_setzero_ps();
+
+	const __m256i emptyMin = _mm256_set1_epi32(1);
+	const __m256i emptyMax = _mm256_setzero_si256();
+
+	const UINT NumBoundaries = mGrid.CountZ - 1;
+
+	UINT i = begin;
+	for (; i + BatchSize <= end; i += BatchSize) {
+		const __m256 cx = _mm256_loadu_ps(&mCenterX[i]);
+		const __m256 cy = _mm256_loadu_ps(&mCenterY[i]);
+		const __m256 cz = _mm256_loadu_ps(&mCenterZ[i]);
+		const __m256 r = _mm256_loadu_ps(&mRadius[i]);
+
+		__m256 vx = _mm256_add_ps(_mm256_mul_ps(cx, v11), v41);
+		vx = _mm256_add_ps(_mm256_mul_ps(cy, v21), vx);
+		vx = _mm256_add_ps(_mm256_mul_ps(cz, v31), vx);
+
+		__m256 vy = _mm256_add_ps(_mm256_mul_ps(cx, v12), v42);
+		vy = _mm256_add_ps(_mm256_mul_ps(cy, v22), vy);
+		vy = _mm256_add_ps(_mm256_mul_ps(cz, v32), vy);
+
+		__m256 vz = _mm256_add_ps(_mm256_mul_ps(cx, v13), v43);
+		vz = _mm256_add_ps(_mm256_mul_ps(cy, v23), vz);
+		vz = _mm256_add_ps(_mm256_mul_ps(cz, v33), vz);
+
+		const __m256 zMin = _mm256_sub_ps(vz, r);
+		const __m256 zMax = _mm256_add_ps(vz, r);
+
+		__m256 visible = _mm256_and_ps(
+			_mm256_cmp_ps(zMax, nearZ, _CMP_GE_OQ),
+			_mm256_cmp_ps(zMin, farZ, _CMP_LE_OQ));
+
+		// Both depths are kept in front of the near plane, so culled lanes
+		// do not divide by zero either.
+		const __m256 zNear = _mm256_max_ps(zMin, nearZ);
+		const __m256 zFar = _mm256_max_ps(_mm256_min_ps(zMax, farZ), nearZ);
+
+		const __m256 invNear = _mm256_div_ps(one, zNear);
+		const __m256 invFar = _mm256_div_ps(one, zFar);
+
+		const __m256 x0 = _mm256_sub_ps(vx, r), x1 = _mm256_add_ps(vx, r);
+		const __m256 y0 = _mm256_sub_ps(vy, r), y1 = _mm256_add_ps(vy, r);
+
+		const __m256 ndcMinX = _mm256_mul_ps(_mm256_min_ps(_mm256_mul_ps(x0, invNear), _mm256_mul_ps(x0, invFar)), projX);
+		const __m256 ndcMaxX = _mm256_mul_ps(_mm256_max_ps(_mm256_mul_ps(x1, invNear), _mm256_mul_ps(x1, invFar)), projX);
+		const __m256 ndcMinY = _mm256_mul_ps(_mm256_min_ps(_mm256_mul_ps(y0, invNear), _mm256_mul_ps(y0, invFar)), projY);
+		const __m256 ndcMaxY = _mm256_mul_ps(_mm256_max_ps(_mm256_mul_ps(y1, invNear), _mm256_mul_ps(y1, invFar)), projY);
+
+		visible = _mm256_and_ps(visible, _mm256_cmp_ps(ndcMaxX, negOne, _CMP_GE_OQ));
+		visible = _mm256_and_ps(visible, _mm256_cmp_ps(ndcMinX, one, _CMP_LE_OQ));
+		visible = _mm256_and_ps(visible, _mm256_cmp_ps(ndcMaxY, negOne, _CMP_GE_OQ));
+		visible = _mm256_and_ps(visible, _mm256_cmp_ps(ndcMinY, one, _CMP_LE_OQ));
+
+		const auto ToTile = [&](const __m256& coord, const __m256& count, const __m256& maxTile) {
+			const __m256 tile = _mm256_floor_ps(_mm256_mul_ps(coord, count));
+			return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(tile, zero), maxTile));
+		};
+
+		const __m256i minX = ToTile(_mm256_add_ps(_mm256_mul_ps(ndcMinX, half), half), countX, maxTileX);
+		const __m256i maxX = ToTile(_mm256_add_ps(_mm256_mul_ps(ndcMaxX, half), half), countX, maxTileX);
+		const __m256i minY = ToTile(_mm256_sub_ps(half, _mm256_mul_ps(ndcMaxY, half)), countY, maxTileY);
+		const __m256i maxY = ToTile(_mm256_sub_ps(half, _mm256_mul_ps(ndcMinY, half)), countY, maxTileY);
+
+		// The slice of a depth is the number of slice boundaries at or in
+		// front of it; a set compare lane is -1.
+		__m256i minZ = _mm256_setzero_si256();
+		__m256i maxZ = _mm256_setzero_si256();
+		for (UINT k = 0; k < NumBoundaries; ++k) {
+			const __m256 boundary = _mm256_set1_ps(mSliceFar[k]);
+			minZ = _mm256_sub_epi32(minZ, _mm256_castps_si256(_mm256_cmp_ps(boundary, zNear, _CMP_LE_OQ)));
+			maxZ = _mm256_sub_epi32(maxZ, _mm256_castps_si256(_mm256_cmp_ps(boundary, zFar, _CMP_LE_OQ)));
+		}
+
+		const __m256i mask = _mm256_castps_si256(visible);
+		minZ = _mm256_blendv_epi8(emptyMin, minZ, mask);
+		maxZ = _mm256_blendv_epi8(emptyMax, maxZ, mask);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&mMinX[i]), minX);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&mMaxX[i]), maxX);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&mMinY[i]), minY);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&mMaxY[i]), maxY);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&mMinZ[i]), minZ);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&mMaxZ[i]), maxZ);
+	}
+
+	if (i < end) ComputeRanges(i, end);
+}
+
+void LightClusterer::AssignSlices(UINT sliceBegin, UINT sliceEnd) {
+	const UINT SliceSize = mGrid.CountX * mGrid.CountY;
+
+	for (UINT c = sliceBegin * SliceSize, end = sliceEnd * SliceSize; c < end; ++c)
+		mClusterLights[c].clear();
+
+	const INT First = static_cast<INT>(sliceBegin);
+	const INT Last = static_cast<INT>(sliceEnd) - 1;
+
+	for (UINT i = 0, numLights = LightCount(); i < numLights; ++i) {
+		const INT z0 = std::max(mMinZ[i], First);
+		const INT z1 = std::min(mMaxZ[i], Last);
+
+		for (INT z = z0; z <= z1; ++z) {
+			for (INT y = mMinY[i]; y <= mMaxY[i]; ++y) {
+				auto cluster = mClusterLights.begin() + (z * mGrid.CountY + y) * mGrid.CountX;
+				for (INT x = mMinX[i]; x <= mMaxX[i]; ++x)
+					cluster[x].push_back(i);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include "Common/Util/MaskedOcclusionCuller.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <immintrin.h>
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	const UINT FullCoverage = 0xFFFFFFFF;
+
+	// Row-vector product a * b.
+	XMFLOAT4X4 Multiply(const XMFLOAT4X4& a, const XMFLOAT4X4& b) {
+		XMFLOAT4X4 result;
+		for (UINT r = 0; r < 4; ++r) {
+			for (UINT c = 0; c < 4; ++c) {
+				FLOAT sum = 0.f;
+				for (UINT k = 0; k < 4; ++k) sum += a.m[r][k] * b.m[k][c];
+				result.m[r][c] = sum;
+			}
+		}
+		return result;
+	}
+
+	__forceinline XMFLOAT4 ToClip(FLOAT x, FLOAT y, FLOAT z, const XMFLOAT4X4& m) {
+		return XMFLOAT4(
+			x * m._11 + y * m._21 + z * m._31 + m._41,
+			x * m._12 + y * m._22 + z * m._32 + m._42,
+			x * m._13 + y * m._23 + z * m._33 + m._43,
+			x * m._14 + y * m._24 + z * m._34 + m._44);
+	}
+}
+
+void MaskedOcclusionCuller::Initialize(BOOL bAvx2Supported, UINT width, UINT height) {
+	mbAvx2Supported = bAvx2Supported;
+
+	mTilesX = std::max((width + TileWidth - 1) / TileWidth, 1u);
+	mTilesY = std::max((height + TileHeight - 1) / TileHeight, 1u);
+	mWidth = mTilesX * TileWidth;
+	mHeight = mTilesY * TileHeight;
+
+	const UINT TileCount = mTilesX * mTilesY;
+	mZMax0.resize(TileCount);
+	mZMax1.resize(TileCount);
+	mMask.resize(TileCount);
+}
+
+void MaskedOcclusionCuller::Clear(const XMFLOAT4X4& viewProj) {
+	mViewProj = viewProj;
+
+	std::fill(mZMax0.begin(), mZMax0.end(), 1.f);
+	std::fill(mZMax1.begin(), mZMax1.end(), 0.f);
+	std::fill(mMask.begin(), mMask.end(), 0u);
+}
+
+void MaskedOcclusionCuller::RenderOccluder(
+		const void* const pVertices,
+		UINT vertexStride,
+		const UINT* const pIndices,
+		UINT indexCount,
+		const XMFLOAT4X4& world) {
+	const XMFLOAT4X4 WorldViewProj = Multiply(world, mViewProj);
+	const BYTE* const Vertices = reinterpret_cast<const BYTE*>(pVertices);
+
+	for (UINT i = 0; i + 2 < indexCount; i += 3) {
+		ScreenVertex screen[3];
+		BOOL clipped = FALSE;
+
+		for (UINT v = 0; v < 3 && !clipped; ++v) {
+			const FLOAT* const Pos = reinterpret_cast<const FLOAT*>(Vertices + static_cast<size_t>(pIndices[i + v]) * vertexStride);
+			const XMFLOAT4 Clip = ToClip(Pos[0], Pos[1], Pos[2], WorldViewProj);
+
+			if (Clip.z < 0.f || Clip.w <= 0.f) {
+				clipped = TRUE;
+				break;
+			}
+
+			const FLOAT InvW = 1.f / Clip.w;
+			screen[v].X = (Clip.x * InvW * 0.5f + 0.5f) * mWidth;
+			screen[v].Y = (0.5f - Clip.y * InvW * 0.5f) * mHeight;
+			screen[v].Z = Clip.z * InvW;
+		}
+
+		if (!clipped) RasterizeTriangle(screen[0], screen[1], screen[2]);
+	}
+}
+
+BOOL MaskedOcclusionCuller::TestBox(const BoundingBox& box) const {
+	FLOAT minX = FLT_MAX, minY = FLT_MAX, minZ = FLT_MAX;
+	FLOAT maxX = -FLT_MAX, maxY = -FLT_MAX;
+
+	for (UINT corner = 0; corner < 8; ++corner) {
+		const FLOAT x = box.Center.x + ((corner & 1) ? box.Extents.x : -box.Extents.x);
+		const FLOAT y = box.Center.y + ((corner & 2) ? box.Extents.y : -box.Extents.y);
+		const FLOAT z = box.Center.z + ((corner & 4) ? box.Extents.z : -box.Extents.z);
+
+		const XMFLOAT4 Clip = ToClip(x, y, z, mViewProj);
+
+		// A box reaching past the near plane is taken as visible.
+		if (Clip.z < 0.f || Clip.w <= 0.f) return TRUE;
+
+		const FLOAT InvW = 1.f / Clip.w;
+		const FLOAT sx = (Clip.x * InvW * 0.5f + 0.5f) * mWidth;
+		const FLOAT sy = (0.5f - Clip.y * InvW * 0.5f) * mHeight;
+
+		minX = std::min(minX, sx);
+		maxX = std::max(maxX, sx);
+		minY = std::min(minY, sy);
+		maxY = std::max(maxY, sy);
+		minZ = std::min(minZ, Clip.z * InvW);
+	}
+
+	if (maxX < 0.f || maxY < 0.f || minX >= mWidth || minY >= mHeight || minZ > 1.f) return FALSE;
+
+	const UINT TileX0 = static_cast<UINT>(std::max(minX, 0.f)) / TileWidth;
+	const UINT TileY0 = static_cast<UINT>(std::max(minY, 0.f)) / TileHeight;
+	const UINT TileX1 = std::min(static_cast<UINT>(maxX) / TileWidth, mTilesX - 1);
+	const UINT TileY1 = std::min(static_cast<UINT>(maxY) / TileHeight, mTilesY - 1);
+
+	const __m256 Depth = _mm256_set1_ps(minZ);
+
+	// Visible as soon as one tile may hold a pixel behind the box.
+	for (UINT ty = TileY0; ty <= TileY1; ++ty) {
+		const FLOAT* const Row = &mZMax0[ty * mTilesX];
+
+		UINT tx = TileX0;
+		if (mbAvx2Supported) {
+			for (; tx + 8 <= TileX1 + 1; tx += 8)
+				if (_mm256_movemask_ps(_mm256_cmp_ps(Depth, _mm256_loadu_ps(Row + tx), _CMP_LE_OQ))) return TRUE;
+		}
+		for (; tx <= TileX1; ++tx)
+			if (minZ <= Row[tx]) return TRUE;
+	}
+
+	return FALSE;
+}
+
+void MaskedOcclusionCuller::ResolveDepth(std::vector<FLOAT>& depth) const {
+	depth.resize(static_cast<size_t>(mWidth) * mHeight);
+
+	for (UINT y = 0; y < mHeight; ++y) {
+		for (UINT x = 0; x < mWidth; ++x) {
+			const UINT Tile = (y / TileHeight) * mTilesX + x / TileWidth;
+			const UINT Bit = (y % TileHeight) * TileWidth + x % TileWidth;
+
+			const BOOL Covered = (mMask[Tile] >> Bit) & 1;
+			depth[static_cast<size_t>(y) * mWidth + x] = Covered ? std::min(mZMax1[Tile], mZMax0[Tile]) : mZMax0[Tile];
+		}
+	}
+}
+
+void MaskedOcclusionCuller::RasterizeTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2) {
+	FLOAT area = (v1.X - v0.X) * (v2.Y - v0.Y) - (v1.Y - v0.Y) * (v2.X - v0.X);
+	if (fabsf(area) < 1e-6f) return;
+
+	// Both windings are drawn; the edge functions expect a positive area.
+	const ScreenVertex& a = v0;
+	const ScreenVertex& b = area > 0.f ? v1 : v2;
+	const ScreenVertex& c = area > 0.f ? v2 : v1;
+	area = fabsf(area);
+
+	const FLOAT MinX = std::max(std::min({ a.X, b.X, c.X }), 0.f);
+	const FLOAT MinY = std::max(std::min({ a.Y, b.Y, c.Y }), 0.f);
+	const FLOAT MaxX = std::min(std::max({ a.X, b.X, c.X }), static_cast<FLOAT>(mWidth) - 1.f);
+	const FLOAT MaxY = std::min(std::max({ a.Y, b.Y, c.Y }), static_cast<FLOAT>(mHeight) - 1.f);
+	if (MinX > MaxX || MinY > MaxY) return;
+
+	// Edge i is A x + B y + C, positive on the inner side.
+	const ScreenVertex* const Verts[3] = { &a, &b, &c };
+	FLOAT edgeA[3], edgeB[3], edgeC[3];
+	for (UINT e = 0; e < 3; ++e) {
+		const auto& p = *Verts[e];
+		const auto& q = *Verts[(e + 1) % 3];
+
+		edgeA[e] = p.Y - q.Y;
+		edgeB[e] = q.X - p.X;
+		edgeC[e] = -(edgeA[e] * p.X + edgeB[e] * p.Y);
+	}
+
+	// Screen-space plane of the depth, which is affine in NDC.
+	const FLOAT InvArea = 1.f / area;
+	const FLOAT ZA = ((b.Z - a.Z) * (c.Y - a.Y) - (c.Z - a.Z) * (b.Y - a.Y)) * InvArea;
+	const FLOAT ZB = ((c.Z - a.Z) * (b.X - a.X) - (b.Z - a.Z) * (c.X - a.X)) * InvArea;
+	const FLOAT ZC = a.Z - ZA * a.X - ZB * a.Y;
+
+	const FLOAT TriMaxZ = std::min(std::max({ a.Z, b.Z, c.Z }), 1.f);
+	// Largest rise of the plane across a tile.
+	const FLOAT TileRise = std::max(ZA * TileWidth, 0.f) + std::max(ZB * TileHeight, 0.f);
+
+	const UINT TileX0 = static_cast<UINT>(MinX) / TileWidth;
+	const UINT TileY0 = static_cast<UINT>(MinY) / TileHeight;
+	const UINT TileX1 = static_cast<UINT>(MaxX) / TileWidth;
+	const UINT TileY1 = static_cast<UINT>(MaxY) / TileHeight;
+
+	for (UINT ty = TileY0; ty <= TileY1; ++ty) {
+		for (UINT tx = TileX0; tx <= TileX1; ++tx) {
+			const UINT Coverage = mbAvx2Supported ?
+				CoverTileAVX(tx, ty, edgeA, edgeB, edgeC) : CoverTile(tx, ty, edgeA, edgeB, edgeC);
+			if (Coverage == 0) continue;
+
+			// The plane is highest at a tile corner, and never beyond the
+			// farthest vertex.
+			const FLOAT CornerZ = ZA * (tx * TileWidth) + ZB * (ty * TileHeight) + ZC + TileRise;
+
+			UpdateTile(ty * mTilesX + tx, Coverage, std::min(CornerZ, TriMaxZ));
+		}
+	}
+}
+
+UINT MaskedOcclusionCuller::CoverTile(
+		UINT tileX, UINT tileY,
+		const FLOAT edgeA[3], const FLOAT edgeB[3], const FLOAT edgeC[3]) const {
+	UINT coverage = 0;
+
+	for (UINT row = 0; row < TileHeight; ++row) {
+		const FLOAT y = tileY * TileHeight + row + 0.5f;
+
+		for (UINT col = 0; col < TileWidth; ++col) {
+			const FLOAT x = tileX * TileWidth + col + 0.5f;
+
+			BOOL inside = TRUE;
+			for (UINT e = 0; e < 3 && inside; ++e)
+				inside = edgeA[e] * x + edgeB[e] * y + edgeC[e] >= 0.f;
+
+			if (inside) coverage |= 1u << (row * TileWidth + col);
+		}
+	}
+
+	return coverage;
+}
+
+UINT MaskedOcclusionCuller::CoverTileAVX(
+		UINT tileX, UINT tileY,
+		const FLOAT edgeA[3], const FLOAT edgeB[3], const FLOAT edgeC[3]) const {
+	const __m256 x = _mm256_add_ps(
+		_mm256_set1_ps(tileX * TileWidth + 0.5f),
+		_mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f));
+	const __m256 zero = _mm256_setzero_ps();
+
+	__m256 rowX[3];
+	for (UINT e = 0; e < 3; ++e) rowX[e] = _mm256_mul_ps(_mm256_set1_ps(edgeA[e]), x);
+
+	UINT coverage = 0;
+
+	for (UINT row = 0; row < TileHeight; ++row) {
+		const FLOAT y = tileY * TileHeight + row + 0.5f;
+
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (UINT e = 0; e < 3; ++e) {
+			const __m256 value = _mm256_add_ps(rowX[e], _mm256_set1_ps(edgeB[e] * y + edgeC[e]));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(value, zero, _CMP_GE_OQ));
+		}
+
+		coverage |= static_cast<UINT>(_mm256_movemask_ps(inside)) << (row * TileWidth);
+	}
+
+	return coverage;
+}
+
+void MaskedOcclusionCuller::UpdateTile(UINT index, UINT coverage, FLOAT depth) {
+	FLOAT& zMax0 = mZMax0[index];
+	FLOAT& zMax1 = mZMax1[index];
+	UINT& mask = mMask[index];
+
+	// Nothing behind what the tile already hides can tighten it.
+	if (depth >= zMax0) return;
+
+	// The triangle joins the working layer unless its depth is nearer the
+	// reference, each distance weighted by the pixels that layer holds;
+	// then the working layer is dropped and restarted from the triangle.
+	const UINT Coverage1 = std::popcount(mask);
+	const UINT Coverage0 = TileWidth * TileHeight - Coverage1;
+	if ((depth - zMax1) * Coverage1 > (zMax0 - depth) * Coverage0) {
+		zMax1 = 0.f;
+		mask = 0;
+	}
+
+	zMax1 = std::max(zMax1, depth);
+	mask |= coverage;
+
+	// A fully covered working layer becomes the reference.
+	if (mask == FullCoverage) {
+		zMax0 = zMax1;
+		zMax1 = 0.f;
+		mask = 0;
+	}
+}
\ No newline at end of file
@@ -23,6 +23,14 @@ float MathUtil::AngleFromXY(float x, float y) {
 	return theta;
 }
 
+float MathUtil::WrapAngle(float rad) {
+	return XMScalarModAngle(rad);
+}
+
+float MathUtil::LerpAngle(float a, float b, float t) {
+	return WrapAngle(a + WrapAngle(b - a) * t);
+}
+
 XMVECTOR MathUtil::SphericalToCartesian(float radius, float theta, float phi) {
 	return XMVectorSet(
 		radius * sinf(phi) * cosf(theta),
@@ -0,0 +1,98 @@
+#include "Common/Util/ShadowAtlasAllocator.hpp"
+
+#include <algorithm>
+
+using namespace Common::Util;
+
+namespace {
+	UINT CeilPowerOfTwo(UINT value) {
+		UINT power = 1;
+		while (power < value) power <<= 1;
+		return power;
+	}
+}
+
+void ShadowAtlasAllocator::Initialize(UINT atlasSize, UINT minPageSize) {
+	mAtlasSize = CeilPowerOfTwo(std::max(atlasSize, 1u));
+	mMinPageSize = std::min(CeilPowerOfTwo(std::max(minPageSize, 1u)), mAtlasSize);
+
+	mLevelCount = 1;
+	for (UINT size = mAtlasSize; size > mMinPageSize; size >>= 1) ++mLevelCount;
+
+	UINT nodeCount = 0;
+	for (UINT level = 0, count = 1; level < mLevelCount; ++level, count <<= 2) nodeCount += count;
+
+	mNodes.assign(nodeCount, E_Free);
+}
+
+void ShadowAtlasAllocator::Reset() {
+	std::fill(mNodes.begin(), mNodes.end(), static_cast<UINT8>(E_Free));
+}
+
+BOOL ShadowAtlasAllocator::Allocate(UINT size, Page& page) {
+	page.Node = InvalidNode;
+	if (mNodes.empty()) return FALSE;
+
+	const UINT Size = std::min(CeilPowerOfTwo(std::max(size, mMinPageSize)), mAtlasSize);
+
+	UINT targetLevel = 0;
+	while ((mAtlasSize >> targetLevel) > Size) ++targetLevel;
+
+	return Allocate(0, 0, 0, 0, targetLevel, page);
+}
+
+void ShadowAtlasAllocator::Free(Page& page) {
+	if (!IsAllocated(page)) return;
+
+	UINT node = page.Node;
+	mNodes[node] = E_Free;
+
+	while (node != 0) {
+		const UINT Parent = (node - 1) >> 2;
+		const UINT FirstChild = (Parent << 2) + 1;
+
+		for (UINT i = 0; i < 4; ++i)
+			if (mNodes[FirstChild + i] != E_Free) {
+				page.Node = InvalidNode;
+				return;
+			}
+
+		mNodes[Parent] = E_Free;
+		node = Parent;
+	}
+
+	page.Node = InvalidNode;
+}
+
+BOOL ShadowAtlasAllocator::Allocate(UINT node, UINT level, UINT x, UINT y, UINT targetLevel, Page& page) {
+	auto& state = mNodes[node];
+	if (state == E_Used) return FALSE;
+
+	if (level == targetLevel) {
+		if (state != E_Free) return FALSE;
+
+		state = E_Used;
+		page = { x, y, mAtlasSize >> level, node };
+
+		return TRUE;
+	}
+
+	// Children of a free node are all free as well.
+	if (state == E_Free) state = E_Split;
+
+	const UINT Half = mAtlasSize >> (level + 1);
+
+	// Quadrants that are already split go first, which keeps the free ones
+	// whole for larger pages.
+	for (UINT pass = 0; pass < 2; ++pass) {
+		for (UINT i = 0; i < 4; ++i) {
+			const UINT Child = (node << 2) + 1 + i;
+			if ((mNodes[Child] == E_Split) != (pass == 0)) continue;
+
+			if (Allocate(Child, level + 1, x + (i & 1) * Half, y + (i >> 1) * Half, targetLevel, page))
+				return TRUE;
+		}
+	}
+
+	return FALSE;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Common/Util/ShadowCascade.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Common::Util;
+using namespace DirectX;
+
+void ShadowCascade::ComputeSplits(FLOAT nearZ, FLOAT farZ, FLOAT lambda, UINT count, FLOAT splits[]) {
+	const FLOAT Ratio = farZ / nearZ;
+	const FLOAT Range = farZ - nearZ;
+
+	for (UINT i = 0; i < count; ++i) {
+		const FLOAT p = static_cast<FLOAT>(i + 1) / count;
+
+		const FLOAT LogSplit = nearZ * powf(Ratio, p);
+		const FLOAT UniformSplit = nearZ + Range * p;
+
+		splits[i] = lambda * LogSplit + (1.f - lambda) * UniformSplit;
+	}
+
+	// Guards the last split against rounding.
+	if (count > 0) splits[count - 1] = farZ;
+}
+
+BoundingSphere ShadowCascade::FitSliceSphere(const XMFLOAT4X4& proj, FLOAT sliceNear, FLOAT sliceFar) {
+	// Squared half extent of the frustum cross-section per unit of depth.
+	const FLOAT TanX = 1.f / proj._11;
+	const FLOAT TanY = 1.f / proj._22;
+	const FLOAT k = TanX * TanX + TanY * TanY;
+
+	// The center on the view axis that is as far from the near corners as
+	// from the far ones; past the far plane the far corners alone decide.
+	const FLOAT Center = std::min(0.5f * (sliceNear + sliceFar) * (1.f + k), sliceFar);
+	const FLOAT FarOffset = sliceFar - Center;
+	const FLOAT Radius = sqrtf(FarOffset * FarOffset + sliceFar * sliceFar * k);
+
+	return BoundingSphere(XMFLOAT3(0.f, 0.f, Center), Radius);
+}
+
+XMFLOAT4X4 ShadowCascade::FitCascade(
+		const BoundingSphere& slice,
+		const XMFLOAT3& lightDir,
+		const BoundingSphere& sceneBounds,
+		UINT resolution) {
+	const XMVECTOR Dir = XMVector3Normalize(XMLoadFloat3(&lightDir));
+	const XMVECTOR Up = fabsf(XMVectorGetY(Dir)) > 0.99f ?
+		XMVectorSet(0.f, 0.f, 1.f, 0.f) : XMVectorSet(0.f, 1.f, 0.f, 0.f);
+
+	// Rotation only, so the texel grid is fixed in world space.
+	const XMMATRIX LightView = XMMatrixLookToLH(XMVectorZero(), Dir, Up);
+
+	XMFLOAT3 centerL, sceneCenterL;
+	XMStoreFloat3(&centerL, XMVector3TransformCoord(XMLoadFloat3(&slice.Center), LightView));
+	XMStoreFloat3(&sceneCenterL, XMVector3TransformCoord(XMLoadFloat3(&sceneBounds.Center), LightView));
+
+	// Widened by a texel on each side, which the snapping below can shift
+	// the window by.
+	const FLOAT Res = static_cast<FLOAT>(std::max(resolution, 4u));
+	const FLOAT Radius = slice.Radius * Res / (Res - 2.f);
+	const FLOAT TexelSize = 2.f * Radius / Res;
+
+	const FLOAT x = floorf(centerL.x / TexelSize) * TexelSize;
+	const FLOAT y = floorf(centerL.y / TexelSize) * TexelSize;
+
+	const FLOAT zNear = std::min(centerL.z - Radius, sceneCenterL.z - sceneBounds.Radius);
+	const FLOAT zFar = centerL.z + Radius;
+
+	const XMMATRIX LightProj = XMMatrixOrthographicOffCenterLH(
+		x - Radius, x + Radius, y - Radius, y + Radius, zNear, zFar);
+
+	XMFLOAT4X4 viewProj;
+	XMStoreFloat4x4(&viewProj, XMMatrixMultiply(LightView, LightProj));
+
+	return viewProj;
+}
\ No newline at end of file
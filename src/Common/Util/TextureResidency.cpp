@@ -0,0 +1,167 @@
+#include "Common/Util/TextureResidency.hpp"
+
+#include <algorithm>
+
+using namespace Common::Util;
+
+void TextureResidency::Initialize(UINT64 budget, UINT maxLoadsInFlight) {
+	mBudget = budget;
+	mMaxLoadsInFlight = std::max(maxLoadsInFlight, 1u);
+}
+
+void TextureResidency::SetBudget(UINT64 budget) {
+	mBudget = budget;
+}
+
+UINT TextureResidency::AddTexture(const UINT64* const pMipSizes, UINT mipCount, UINT tailMip) {
+	Entry entry{};
+	entry.MipSizes.assign(pMipSizes, pMipSizes + mipCount);
+	entry.TailMip = std::min(tailMip, mipCount - 1);
+	entry.ResidentMip = entry.TailMip;
+	entry.WantedMip = entry.TailMip;
+
+	for (UINT mip = entry.TailMip; mip < mipCount; ++mip)
+		mResidentBytes += entry.MipSizes[mip];
+
+	mEntries.push_back(std::move(entry));
+
+	return static_cast<UINT>(mEntries.size() - 1);
+}
+
+void TextureResidency::Request(UINT texture, UINT mip, UINT64 frame) {
+	auto& entry = mEntries[texture];
+	const UINT Mip = std::clamp(mip, entry.MinMip, entry.TailMip);
+
+	if (IsUsedIn(entry, frame)) {
+		entry.WantedMip = std::min(entry.WantedMip, Mip);
+		return;
+	}
+
+	entry.WantedMip = Mip;
+	entry.LastUsedFrame = frame;
+	entry.bUsed = TRUE;
+}
+
+void TextureResidency::Update(UINT64 frame, std::vector<Change>& loads, std::vector<Change>& evictions) {
+	loads.clear();
+	evictions.clear();
+
+	// Meets a budget that shrank since the last update.
+	MakeRoom(0, frame, FALSE, evictions);
+
+	mCandidates.clear();
+	for (UINT i = 0, end = static_cast<UINT>(mEntries.size()); i < end; ++i) {
+		const auto& entry = mEntries[i];
+		if (!entry.bLoading && IsUsedIn(entry, frame) && entry.WantedMip < entry.ResidentMip)
+			mCandidates.push_back(i);
+	}
+
+	// The texture furthest from what it asks for goes first.
+	std::stable_sort(mCandidates.begin(), mCandidates.end(), [&](UINT lhs, UINT rhs) {
+		const auto& left = mEntries[lhs];
+		const auto& right = mEntries[rhs];
+		return left.ResidentMip - left.WantedMip > right.ResidentMip - right.WantedMip;
+	});
+
+	for (const auto texture : mCandidates) {
+		if (mLoadsInFlight >= mMaxLoadsInFlight) break;
+
+		auto& entry = mEntries[texture];
+
+		// One mip at a time, so detail comes in progressively and a single
+		// texture cannot hold up the queue.
+		const UINT Mip = entry.ResidentMip - 1;
+		const UINT64 Bytes = entry.MipSizes[Mip];
+		if (!MakeRoom(Bytes, frame, TRUE, evictions)) continue;
+
+		entry.bLoading = TRUE;
+		++mLoadsInFlight;
+		mResidentBytes += Bytes;
+
+		loads.push_back({ texture, Mip });
+	}
+
+	// A texture evicted by several passes is reported once, at its final mip.
+	std::sort(evictions.begin(), evictions.end(), [](const Change& lhs, const Change& rhs) {
+		return lhs.Texture < rhs.Texture;
+	});
+	evictions.erase(std::unique(evictions.begin(), evictions.end(), [](const Change& lhs, const Change& rhs) {
+		return lhs.Texture == rhs.Texture;
+	}), evictions.end());
+
+	for (auto& eviction : evictions)
+		eviction.TopMip = mEntries[eviction.Texture].ResidentMip;
+}
+
+void TextureResidency::OnLoaded(UINT texture, BOOL bSucceeded) {
+	auto& entry = mEntries[texture];
+	if (!entry.bLoading) return;
+
+	entry.bLoading = FALSE;
+	--mLoadsInFlight;
+
+	const UINT Mip = entry.ResidentMip - 1;
+	if (bSucceeded) {
+		entry.ResidentMip = Mip;
+	}
+	else {
+		mResidentBytes -= entry.MipSizes[Mip];
+		entry.MinMip = entry.ResidentMip;
+		entry.WantedMip = std::max(entry.WantedMip, entry.MinMip);
+	}
+}
+
+BOOL TextureResidency::IsUsedIn(const Entry& entry, UINT64 frame) const {
+	return entry.bUsed && entry.LastUsedFrame == frame;
+}
+
+BOOL TextureResidency::MakeRoom(UINT64 bytes, UINT64 frame, BOOL bAllOrNothing, std::vector<Change>& evictions) {
+	if (mResidentBytes + bytes <= mBudget) return TRUE;
+
+	// Textures not seen this frame may go down to their tail; the ones seen
+	// only give up the detail they no longer ask for.
+	const auto Floor = [&](const Entry& entry) {
+		return IsUsedIn(entry, frame) ? entry.WantedMip : entry.TailMip;
+	};
+
+	mVictims.clear();
+
+	UINT64 evictable = 0;
+	for (UINT i = 0, end = static_cast<UINT>(mEntries.size()); i < end; ++i) {
+		const auto& entry = mEntries[i];
+		if (entry.bLoading) continue;
+
+		const UINT Floored = Floor(entry);
+		if (entry.ResidentMip >= Floored) continue;
+
+		mVictims.push_back(i);
+		for (UINT mip = entry.ResidentMip; mip < Floored; ++mip)
+			evictable += entry.MipSizes[mip];
+	}
+
+	if (bAllOrNothing && mResidentBytes + bytes > mBudget + evictable) return FALSE;
+
+	// Least recently used first; textures never asked for come before all.
+	std::sort(mVictims.begin(), mVictims.end(), [&](UINT lhs, UINT rhs) {
+		const auto& left = mEntries[lhs];
+		const auto& right = mEntries[rhs];
+		if (left.bUsed != right.bUsed) return !left.bUsed;
+		return left.LastUsedFrame < right.LastUsedFrame;
+	});
+
+	for (const auto texture : mVictims) {
+		auto& entry = mEntries[texture];
+		const UINT Floored = Floor(entry);
+
+		while (entry.ResidentMip < Floored && mResidentBytes + bytes > mBudget) {
+			mResidentBytes -= entry.MipSizes[entry.ResidentMip];
+			++entry.ResidentMip;
+		}
+
+		evictions.push_back({ texture, entry.ResidentMip });
+
+		if (mResidentBytes + bytes <= mBudget) break;
+	}
+
+	return mResidentBytes + bytes <= mBudget;
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "GameWorld/Foundation/Camera/CameraComponent.hpp"
 #include "Common/Debug/Logger.hpp"
 #include "Common/Foundation/Camera/GameCamera.hpp"
+#include "Common/Util/MathUtil.hpp"
 #include "Common/Render/Renderer.hpp"
 #include "GameWorld/GameWorld.hpp"
 
@@ -25,10 +26,26 @@ void CameraComponent::OnCleaningUp() {}
 
 BOOL CameraComponent::ProcessInput(Common::Input::InputState* const pInput) { return TRUE; }
 
-BOOL CameraComponent::Update(FLOAT delta) { return TRUE; }
+BOOL CameraComponent::Update(FLOAT delta) {
+	// Runs before the owner's step, so these hold the state the step
+	// starts from.
+	mPrevPitch = mPitch;
+	mPrevYaw = mYaw;
+	mPrevRoll = mRoll;
+
+	return TRUE;
+}
 
 BOOL CameraComponent::OnUpdateWorldTransform() {
-	mCamera->SetPosition(ActorTransform().Position);
+	// Look input is applied per step, so the orientation is blended the
+	// same way as the actor transform to keep it from stepping at high
+	// frame rates.
+	const FLOAT alpha = ActorRenderAlpha();
+	mCamera->SetRotation(
+		Common::Util::MathUtil::LerpAngle(mPrevPitch, mPitch, alpha),
+		Common::Util::MathUtil::LerpAngle(mPrevYaw, mYaw, alpha),
+		Common::Util::MathUtil::LerpAngle(mPrevRoll, mRoll, alpha));
+	mCamera->SetPosition(ActorRenderTransform().Position);
 	mCamera->UpdateViewMatrix();
 
 	return TRUE;
@@ -40,11 +57,11 @@ XMVECTOR CameraComponent::Rotation() const { return mCamera->Rotation(); }
 
 XMFLOAT4X4 CameraComponent::View() const { return mCamera->View(); }
 
-XMVECTOR CameraComponent::RightVector() const { return mCamera->RightVector(); }
+XMVECTOR CameraComponent::RightVector() const { return XMVector3Rotate(UnitVector::RightVector, SimulatedRotation()); }
 
-XMVECTOR CameraComponent::UpVector() const { return mCamera->UpVector(); }
+XMVECTOR CameraComponent::UpVector() const { return XMVector3Rotate(UnitVector::UpVector, SimulatedRotation()); }
 
-XMVECTOR CameraComponent::ForwardVector() const { return mCamera->ForwardVector(); }
+XMVECTOR CameraComponent::ForwardVector() const { return XMVector3Rotate(UnitVector::ForwardVector, SimulatedRotation()); }
 
 void CameraComponent::Pitch(FLOAT rad) {
 	if (mbLimitPitch) {
@@ -54,19 +71,16 @@ void CameraComponent::Pitch(FLOAT rad) {
 		mPitch += rad;
 	}
 	else {
-		mPitch += rad;
-		if (mPitch >= XM_2PI) mPitch = 0.f;
-		else if (mPitch <= -XM_2PI) mPitch = 0.f;
+		mPitch = Common::Util::MathUtil::WrapAngle(mPitch + rad);
 	}
-	mCamera->Pitch(rad);
 }
 
 void CameraComponent::Yaw(FLOAT rad) {
-	mCamera->Yaw(rad);
+	mYaw = Common::Util::MathUtil::WrapAngle(mYaw + rad);
 }
 
 void CameraComponent::Roll(FLOAT rad) {
-	mCamera->Roll(rad);
+	mRoll = Common::Util::MathUtil::WrapAngle(mRoll + rad);
 }
 
 void CameraComponent::AddPosition(const XMVECTOR& pos) {
@@ -75,4 +89,8 @@ void CameraComponent::AddPosition(const XMVECTOR& pos) {
 
 void CameraComponent::SetPosition(const XMVECTOR& pos) {
 	mCamera->SetPosition(pos);
+}
+
+XMVECTOR CameraComponent::SimulatedRotation() const {
+	return XMQuaternionRotationRollPitchYaw(mPitch, mYaw, mRoll);
 }
\ No newline at end of file
@@ -19,6 +19,9 @@ Actor::Actor(
 	mTransform.Rotation = XMLoadFloat4(&rot);
 	mTransform.Scale = XMLoadFloat3(&scale);
 
+	mPrevTransform = mTransform;
+	mRenderTransform = mTransform;
+
 	GameWorld::GameWorldClass::spGameWorld->ActorManager()->AddActor(this);
 }
 
@@ -26,7 +29,7 @@ Actor::Actor(
 		Common::Debug::LogFile* const pLogFile, 
 		const std::string& name, 
 		const Common::Foundation::Mesh::Transform& trans)
-	: mpLogFile(pLogFile), mName(name), mTransform(trans) {
+	: mpLogFile(pLogFile), mName(name), mTransform(trans), mPrevTransform(trans), mRenderTransform(trans) {
 	GameWorld::GameWorldClass::spGameWorld->ActorManager()->AddActor(this);
 }
 
@@ -46,12 +49,13 @@ BOOL Actor::UpdateComponents(FLOAT delta) {
 }
 
 BOOL Actor::OnUpdateWorldTransform() {
-	if (!mbNeedToUpdate) return TRUE;
-
 	for (size_t i = 0, end = mComponents.size(); i < end; ++i)
 		CheckReturn(mpLogFile, mComponents[i]->OnUpdateWorldTransform());
 
-	mbNeedToUpdate = FALSE;
+	// Once a step that did not move the actor has been presented, the
+	// render transform has caught up and nothing needs pushing until the
+	// next move.
+	if (!mbNeedToUpdate) mbNeedToSettle = FALSE;
 
 	return TRUE;
 }
@@ -82,14 +86,29 @@ BOOL Actor::ProcessInput(Common::Input::InputState* const pInputState) {
 }
 
 BOOL Actor::Update(FLOAT delta) { 
-	CheckReturn(mpLogFile, OnUpdateWorldTransform());
+	mPrevTransform = mTransform;
+
+	mbNeedToSettle = mbNeedToUpdate;
+	mbNeedToUpdate = FALSE;
 
 	CheckReturn(mpLogFile, UpdateComponents(delta));
 	CheckReturn(mpLogFile, UpdateActor(delta));
 
+	return TRUE; 
+}
+
+BOOL Actor::Interpolate(FLOAT alpha) {
+	if (!mbNeedToUpdate && !mbNeedToSettle) return TRUE;
+
+	mRenderAlpha = alpha;
+
+	mRenderTransform.Position = XMVectorLerp(mPrevTransform.Position, mTransform.Position, alpha);
+	mRenderTransform.Rotation = XMQuaternionSlerp(mPrevTransform.Rotation, mTransform.Rotation, alpha);
+	mRenderTransform.Scale = XMVectorLerp(mPrevTransform.Scale, mTransform.Scale, alpha);
+
 	CheckReturn(mpLogFile, OnUpdateWorldTransform());
 
-	return TRUE; 
+	return TRUE;
 }
 
 void Actor::AddComponent(Component* const pComponent) {
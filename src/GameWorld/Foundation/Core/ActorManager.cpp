@@ -68,6 +68,16 @@ BOOL ActorManager::Update(FLOAT delta) {
 	return TRUE;
 }
 
+BOOL ActorManager::Interpolate(FLOAT alpha) {
+	for (size_t i = 0, end = mActors.size(); i < end; ++i) {
+		if (!mActors[i]->Initialized()) continue;
+
+		CheckReturn(mpLogFile, mActors[i]->Interpolate(alpha));
+	}
+
+	return TRUE;
+}
+
 
 void ActorManager::AddActor(Actor* const pActor) {
 	if (mbUpdating) {
@@ -13,4 +13,8 @@ Component::Component(Common::Debug::LogFile* const pLogFile, Actor* const pOwner
 
 Component::~Component() {}
 
-const Common::Foundation::Mesh::Transform& Component::ActorTransform() { return mpOwner->GetTransform(); }
\ No newline at end of file
+const Common::Foundation::Mesh::Transform& Component::ActorTransform() { return mpOwner->GetTransform(); }
+
+const Common::Foundation::Mesh::Transform& Component::ActorRenderTransform() { return mpOwner->GetRenderTransform(); }
+
+FLOAT Component::ActorRenderAlpha() { return mpOwner->GetRenderAlpha(); }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "GameWorld/Foundation/Core/pch_world.h"
+#include "GameWorld/Foundation/Core/SimulationClock.hpp"
+
+using namespace GameWorld::Foundation::Core;
+
+SimulationClock::SimulationClock(FLOAT stepTime, UINT maxSubsteps)
+	: mStepTime(stepTime), mMaxSubsteps(maxSubsteps) {}
+
+void SimulationClock::SetStepTime(FLOAT stepTime) {
+	mStepTime = stepTime;
+	Reset();
+}
+
+void SimulationClock::SetMaxSubsteps(UINT maxSubsteps) {
+	mMaxSubsteps = std::max(maxSubsteps, 1u);
+}
+
+void SimulationClock::Reset() {
+	mAccumulator = 0.;
+	mAlpha = 0.f;
+}
+
+UINT SimulationClock::Advance(FLOAT delta) {
+	mAccumulator += std::max(delta, 0.f);
+
+	UINT steps = static_cast<UINT>(mAccumulator / mStepTime);
+	if (steps > mMaxSubsteps) {
+		steps = mMaxSubsteps;
+		mAccumulator = std::fmod(mAccumulator, static_cast<DOUBLE>(mStepTime));
+	}
+	else {
+		mAccumulator -= steps * static_cast<DOUBLE>(mStepTime);
+	}
+
+	mAlpha = static_cast<FLOAT>(mAccumulator / mStepTime);
+
+	return steps;
+}
\ No newline at end of file
@@ -4,18 +4,31 @@
 #include "Common/Foundation/Mesh/Mesh.hpp"
 #include "Common/Render/Renderer.hpp"
 #include "GameWorld/GameWorld.hpp"
+#include "Physics/pch_cyclone.h"
+#include "Physics/CollisionTriangleMesh.hpp"
+#include "Physics/RigidBodyWorld.hpp"
 
 using namespace GameWorld::Foundation::Mesh;
+using namespace DirectX;
 
 MeshComponent::MeshComponent(Common::Debug::LogFile* const pLogFile, Core::Actor* const pOwner)
 	: Component(pLogFile, pOwner) {}
 
+MeshComponent::~MeshComponent() {}
+
 BOOL MeshComponent::OnInitialzing() {
 	return TRUE;
 }
 
 void MeshComponent::OnCleaningUp() {
 	if (mbAddedMesh) GameWorld::GameWorldClass::spGameWorld->Renderer()->RemoveMesh(mMeshHash);
+
+	if (mCollisionMesh) {
+		auto physicsWorld = GameWorld::GameWorldClass::spGameWorld->PhysicsWorld();
+		if (physicsWorld != nullptr) physicsWorld->RemovePrimitive(mCollisionMesh.get());
+
+		mCollisionMesh.reset();
+	}
 }
 
 BOOL MeshComponent::ProcessInput(Common::Input::InputState* const pInput) {
@@ -27,13 +40,13 @@ BOOL MeshComponent::Update(FLOAT delta) {
 }
 
 BOOL MeshComponent::OnUpdateWorldTransform() {
-	auto transform = ActorTransform();
+	auto transform = ActorRenderTransform();
 	if (mbAddedMesh) GameWorld::GameWorldClass::spGameWorld->Renderer()->UpdateMeshTransform(mMeshHash, &transform);
 
 	return TRUE;
 }
 
-BOOL MeshComponent::LoadMesh(LPCSTR fileName, LPCSTR baseDir, LPCSTR extension) {
+BOOL MeshComponent::LoadMesh(LPCSTR fileName, LPCSTR baseDir, LPCSTR extension, BOOL bCollidable) {
 	Common::Foundation::Mesh::Mesh mesh;
 
 	CheckReturn(mpLogFile, Common::Foundation::Mesh::Mesh::Load(mpLogFile, mesh, fileName, baseDir, extension));
@@ -43,5 +56,24 @@ BOOL MeshComponent::LoadMesh(LPCSTR fileName, LPCSTR baseDir, LPCSTR extension)
 
 	mbAddedMesh = TRUE;
 
+	if (bCollidable) {
+		const auto world = XMMatrixAffineTransformation(
+			transform.Scale,
+			XMVectorSet(0.f, 0.f, 0.f, 1.f),
+			transform.Rotation,
+			transform.Position);
+
+		mCollisionMesh = std::make_unique<Physics::Cyclone::CollisionTriangleMesh>();
+		mCollisionMesh->Build(
+			&mesh.Vertices()->Position,
+			sizeof(Common::Foundation::Mesh::Vertex),
+			mesh.VertexCount(),
+			mesh.Indices(),
+			mesh.IndexCount(),
+			world);
+
+		GameWorld::GameWorldClass::spGameWorld->PhysicsWorld()->AddPrimitive(mCollisionMesh.get());
+	}
+
 	return TRUE;
 }
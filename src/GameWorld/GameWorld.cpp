@@ -9,6 +9,9 @@
 #include "Common/Input/InputProcessor.hpp"
 #include "Common/ImGuiManager/ImGuiManager.hpp"
 #include "GameWorld/Foundation/Core/ActorManager.hpp"
+#include "GameWorld/Foundation/Core/SimulationClock.hpp"
+#include "Physics/pch_cyclone.h"
+#include "Physics/RigidBodyWorld.hpp"
 #include "GameWorld/Player/FreeLookActor.hpp"
 #include "GameWorld/Prefab/LampShade.hpp"
 #include "GameWorld/Prefab/FineDonut.hpp"
@@ -44,6 +47,8 @@ GameWorldClass::GameWorldClass() {
 	mActorManager = std::make_unique<GameWorld::Foundation::Core::ActorManager>();
 	mArgumentSet = std::make_unique<Common::Render::ShadingArgument::ShadingArgumentSet>();
 	mGameTimer = std::make_unique<Common::Foundation::Core::GameTimer>();
+	mSimulationClock = std::make_unique<GameWorld::Foundation::Core::SimulationClock>();
+	mPhysicsWorld = std::make_unique<Physics::Cyclone::RigidBodyWorld>();
 }
 
 GameWorldClass::~GameWorldClass() {
@@ -82,6 +87,7 @@ BOOL GameWorldClass::RunLoop() {
 	threads.emplace_back(&GameWorldClass::Draw, this);
 
 	mGameTimer->Reset();
+	mSimulationClock->Reset();
 
 	FLOAT currTime = 0.f;
 	FLOAT prevTime = 0.f;
@@ -146,6 +152,8 @@ void GameWorldClass::CleanUp() {
 		mActorManager->CleanUp();
 		mActorManager.reset();
 	}	
+	// Components unregister their primitives while the actors clean up.
+	mPhysicsWorld.reset();
 	if (mInputProcessor) {
 		mInputProcessor->CleanUp();
 		mInputProcessor.reset();
@@ -178,6 +186,7 @@ void GameWorldClass::CleanUp() {
 		mWindowsManager.reset();
 	}
 	if (mGameTimer) mGameTimer.reset();
+	if (mSimulationClock) mSimulationClock.reset();
 }
 
 BOOL GameWorldClass::BuildHWInfo() {
@@ -335,7 +344,17 @@ BOOL GameWorldClass::Update() {
 		if (mWindowsManager->Destroyed()) break;
 
 		const auto dt = mGameTimer->DeltaTime();
-		CheckReturn(mpLogFile, mActorManager->Update(dt));
+
+		const UINT steps = mSimulationClock->Advance(dt);
+		const auto stepTime = mSimulationClock->StepTime();
+		for (UINT i = 0; i < steps; ++i) {
+			// Forces actors add during their update are applied in this step.
+			mPhysicsWorld->StartFrame();
+			CheckReturn(mpLogFile, mActorManager->Update(stepTime));
+			mPhysicsWorld->RunPhysics(stepTime);
+		}
+		CheckReturn(mpLogFile, mActorManager->Interpolate(mSimulationClock->Alpha()));
+
 		CheckReturn(mpLogFile, mRenderer->Update(dt));
 
 		++UpdateFrameCount;
@@ -50,9 +50,6 @@ BOOL FreeLookActor::ProcessActorInput(Common::Input::InputState* const pInput) {
 	if (pInput->Keyboard.KeyValue(VK_A)) mStrapeSpeed += -1.f;
 	if (pInput->Keyboard.KeyValue(VK_D)) mStrapeSpeed += 1.f;
 
-	mLookUpSpeed = 0.f;
-	mTurnSpeed = 0.f;
-
 	if (pInput->Mouse.ButtonState(VK_RBUTTON) == Common::Input::ButtonStates::E_Pressed) {
 		const auto CurrMousePos = pInput->Mouse.MousePosition();
 		const auto CurrMousePosV = XMLoadFloat2(&CurrMousePos);
@@ -60,8 +57,10 @@ BOOL FreeLookActor::ProcessActorInput(Common::Input::InputState* const pInput) {
 
 		const auto Displacement = CurrMousePosV - PrevMousePosV;
 
-		mLookUpSpeed = Displacement.m128_f32[1];
-		mTurnSpeed = Displacement.m128_f32[0];
+		// Accumulated, since several frames may pass before the next
+		// simulation step consumes the displacement.
+		mLookUpSpeed += Displacement.m128_f32[1];
+		mTurnSpeed += Displacement.m128_f32[0];
 
 		XMStoreFloat2(&mPrevMousePos, CurrMousePosV);
 	}
@@ -87,5 +86,8 @@ BOOL FreeLookActor::UpdateActor(FLOAT delta) {
 	mpCameraComp->Yaw(yaw);
 	mpCameraComp->Pitch(pitch);
 
+	mLookUpSpeed = 0.f;
+	mTurnSpeed = 0.f;
+
 	return TRUE;
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/CollisionBox.hpp"
+#include "Physics/RigidBody.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX::SimpleMath;
+
+CollisionBox::CollisionBox(RigidBody* pBody, const Vector3& halfExtents)
+	: CollisionPrimitive(E_Box, pBody), mHalfExtents{ halfExtents } {}
+
+void CollisionBox::ComputeBounds(Vector3& bottom, Vector3& top) const {
+	const auto transform = GetTransform();
+
+	// Project the half extents onto each world axis.
+	const Vector3 extents{
+		std::abs(transform._11) * mHalfExtents.x + std::abs(transform._21) * mHalfExtents.y + std::abs(transform._31) * mHalfExtents.z,
+		std::abs(transform._12) * mHalfExtents.x + std::abs(transform._22) * mHalfExtents.y + std::abs(transform._32) * mHalfExtents.z,
+		std::abs(transform._13) * mHalfExtents.x + std::abs(transform._23) * mHalfExtents.y + std::abs(transform._33) * mHalfExtents.z };
+
+	const auto center = GetCenter();
+	bottom = center - extents;
+	top = center + extents;
+}
+
+Vector3 CollisionBox::Support(const Vector3& dir) const {
+	const auto transform = GetTransform();
+	const auto local = Vector3::TransformNormal(dir, transform.Transpose());
+
+	const Vector3 corner{
+		local.x >= 0.f ? mHalfExtents.x : -mHalfExtents.x,
+		local.y >= 0.f ? mHalfExtents.y : -mHalfExtents.y,
+		local.z >= 0.f ? mHalfExtents.z : -mHalfExtents.z };
+
+	return Vector3::Transform(corner, transform);
+}
+
+void CollisionBox::Vertices(std::array<Vector3, 8>& vertices) const {
+	const auto transform = GetTransform();
+
+	for (UINT i = 0; i < 8; ++i) {
+		const Vector3 corner{
+			(i & 1) ? mHalfExtents.x : -mHalfExtents.x,
+			(i & 2) ? mHalfExtents.y : -mHalfExtents.y,
+			(i & 4) ? mHalfExtents.z : -mHalfExtents.z };
+		vertices[i] = Vector3::Transform(corner, transform);
+	}
+}
+
+bool CollisionBox::Contains(const Vector3& point, float margin) const {
+	const auto local = Vector3::Transform(point, GetTransform().Invert());
+
+	return std::abs(local.x) <= mHalfExtents.x + margin
+		&& std::abs(local.y) <= mHalfExtents.y + margin
+		&& std::abs(local.z) <= mHalfExtents.z + margin;
+}
+
+Matrix CollisionBox::GetTransform() const {
+	return mpBody != nullptr ? mpBody->GetTransform() : Matrix::Identity;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/CollisionConvex.hpp"
+#include "Physics/RigidBody.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX::SimpleMath;
+
+CollisionConvex::CollisionConvex(RigidBody* pBody, const std::vector<Vector3>& vertices)
+	: CollisionPrimitive(E_Convex, pBody), mVertices{ vertices } {}
+
+void CollisionConvex::ComputeBounds(Vector3& bottom, Vector3& top) const {
+	const auto transform = Transform();
+
+	bottom = Vector3{ FLT_MAX, FLT_MAX, FLT_MAX };
+	top = Vector3{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	for (const auto& vertex : mVertices) {
+		const auto world = Vector3::Transform(vertex, transform);
+		bottom = Vector3::Min(bottom, world);
+		top = Vector3::Max(top, world);
+	}
+}
+
+Vector3 CollisionConvex::Support(const Vector3& dir) const {
+	const auto transform = Transform();
+	const auto local = Vector3::TransformNormal(dir, transform.Transpose());
+
+	Vector3 best{};
+	float bestDist = -FLT_MAX;
+	for (const auto& vertex : mVertices) {
+		const float dist = vertex.Dot(local);
+		if (dist > bestDist) {
+			bestDist = dist;
+			best = vertex;
+		}
+	}
+
+	return Vector3::Transform(best, transform);
+}
+
+Matrix CollisionConvex::Transform() const {
+	return mpBody != nullptr ? mpBody->GetTransform() : Matrix::Identity;
+}
\ No newline at end of file
@@ -0,0 +1,433 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/CollisionDetector.hpp"
+#include "Physics/CollisionSphere.hpp"
+#include "Physics/CollisionBox.hpp"
+#include "Physics/CollisionTriangleMesh.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	const UINT MprMaxIterations = 64;
+	const float MprTolerance = 1e-4f;
+
+	// Slack allowed when deciding whether a vertex belongs to a contact manifold.
+	const float ContactMargin = 0.01f;
+
+	struct MprResult {
+		// Points from the second shape toward the first.
+		Vector3 Normal;
+		Vector3 Point;
+		float Depth;
+	};
+
+	// Minkowski portal refinement (Snethen, "XenoCollide", Game Programming
+	// Gems 7) on the difference B - A.
+	template <typename SupportA, typename SupportB>
+	bool Mpr(
+			const SupportA& supportA,
+			const SupportB& supportB,
+			const Vector3& centerA,
+			const Vector3& centerB,
+			MprResult& result) {
+		// Phase 0: a point known to be inside the Minkowski difference.
+		const Vector3 v01 = centerA;
+		const Vector3 v02 = centerB;
+		Vector3 v0 = v02 - v01;
+		if (v0.LengthSquared() < 1e-12f) v0 = Vector3{ 1e-5f, 0.f, 0.f };
+
+		Vector3 n = -v0;
+		Vector3 v11 = supportA(-n);
+		Vector3 v12 = supportB(n);
+		Vector3 v1 = v12 - v11;
+		if (v1.Dot(n) <= 0.f) return false;
+
+		n = v1.Cross(v0);
+		if (n.LengthSquared() < 1e-12f) {
+			// The origin lies on the segment v0-v1.
+			n = v1 - v0;
+			n.Normalize();
+
+			result.Normal = n;
+			result.Point = (v11 + v12) * 0.5f;
+			result.Depth = v1.Dot(n);
+			return true;
+		}
+
+		Vector3 v21 = supportA(-n);
+		Vector3 v22 = supportB(n);
+		Vector3 v2 = v22 - v21;
+		if (v2.Dot(n) <= 0.f) return false;
+
+		n = (v1 - v0).Cross(v2 - v0);
+		if (n.Dot(v0) > 0.f) {
+			std::swap(v1, v2);
+			std::swap(v11, v21);
+			std::swap(v12, v22);
+			n = -n;
+		}
+
+		// Phase 1: find a portal that the origin ray passes through.
+		Vector3 v3, v31, v32;
+		for (UINT i = 0; ; ++i) {
+			if (i == MprMaxIterations) return false;
+
+			v31 = supportA(-n);
+			v32 = supportB(n);
+			v3 = v32 - v31;
+			if (v3.Dot(n) <= 0.f) return false;
+
+			if (v1.Cross(v3).Dot(v0) < 0.f) {
+				v2 = v3; v21 = v31; v22 = v32;
+				n = (v1 - v0).Cross(v3 - v0);
+				continue;
+			}
+			if (v3.Cross(v2).Dot(v0) < 0.f) {
+				v1 = v3; v11 = v31; v12 = v32;
+				n = (v3 - v0).Cross(v2 - v0);
+				continue;
+			}
+			break;
+		}
+
+		// Phase 2: refine the portal until it lies on the boundary.
+		bool hit = false;
+		for (UINT i = 0; i < MprMaxIterations; ++i) {
+			n = (v2 - v1).Cross(v3 - v1);
+			if (n.LengthSquared() < 1e-12f) return hit;
+			n.Normalize();
+
+			const float d = n.Dot(v1);
+			if (d >= 0.f) hit = true;
+
+			const Vector3 v41 = supportA(-n);
+			const Vector3 v42 = supportB(n);
+			const Vector3 v4 = v42 - v41;
+
+			const float delta = (v4 - v3).Dot(n);
+			const float separation = -v4.Dot(n);
+
+			if (delta <= MprTolerance || separation >= 0.f || i + 1 == MprMaxIterations) {
+				if (!hit) return false;
+
+				// Barycentric coordinates of the origin on the portal.
+				float b0 = v1.Cross(v2).Dot(v3);
+				float b1 = v3.Cross(v2).Dot(v0);
+				float b2 = v0.Cross(v1).Dot(v3);
+				float b3 = v2.Cross(v1).Dot(v0);
+				float sum = b0 + b1 + b2 + b3;
+				if (sum <= 0.f) {
+					b0 = 0.f;
+					b1 = v2.Cross(v3).Dot(n);
+					b2 = v3.Cross(v1).Dot(n);
+					b3 = v1.Cross(v2).Dot(n);
+					sum = b1 + b2 + b3;
+				}
+				const float inv = 1.f / sum;
+
+				const auto pointA = (v01 * b0 + v11 * b1 + v21 * b2 + v31 * b3) * inv;
+				const auto pointB = (v02 * b0 + v12 * b1 + v22 * b2 + v32 * b3) * inv;
+
+				result.Normal = n;
+				result.Point = (pointA + pointB) * 0.5f;
+				result.Depth = d;
+				return true;
+			}
+
+			const Vector3 temp = v4.Cross(v0);
+			if (v1.Dot(temp) >= 0.f) {
+				if (v2.Dot(temp) >= 0.f) { v1 = v4; v11 = v41; v12 = v42; }
+				else { v3 = v4; v31 = v41; v32 = v42; }
+			}
+			else {
+				if (v3.Dot(temp) >= 0.f) { v2 = v4; v21 = v41; v22 = v42; }
+				else { v1 = v4; v11 = v41; v12 = v42; }
+			}
+		}
+
+		return hit;
+	}
+
+	Contact MakeContact(
+			const CollisionPrimitive* pFirst,
+			const CollisionPrimitive* pSecond,
+			const Vector3& point,
+			const Vector3& normal,
+			float penetration) {
+		Contact contact{};
+		contact.Bodies[0] = pFirst->GetBody();
+		contact.Bodies[1] = pSecond->GetBody();
+		contact.Point = point;
+		contact.Normal = normal;
+		contact.Penetration = penetration;
+		contact.Friction = std::sqrt(pFirst->GetFriction() * pSecond->GetFriction());
+		contact.Restitution = std::max(pFirst->GetRestitution(), pSecond->GetRestitution());
+		return contact;
+	}
+
+	// Ericson, "Real-Time Collision Detection", 5.1.5.
+	Vector3 ClosestPointOnTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c) {
+		const auto ab = b - a;
+		const auto ac = c - a;
+		const auto ap = p - a;
+
+		const float d1 = ab.Dot(ap);
+		const float d2 = ac.Dot(ap);
+		if (d1 <= 0.f && d2 <= 0.f) return a;
+
+		const auto bp = p - b;
+		const float d3 = ab.Dot(bp);
+		const float d4 = ac.Dot(bp);
+		if (d3 >= 0.f && d4 <= d3) return b;
+
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) return a + ab * (d1 / (d1 - d3));
+
+		const auto cp = p - c;
+		const float d5 = ab.Dot(cp);
+		const float d6 = ac.Dot(cp);
+		if (d6 >= 0.f && d5 <= d6) return c;
+
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) return a + ac * (d2 / (d2 - d6));
+
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+			return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+		const float denom = 1.f / (va + vb + vc);
+		return a + ab * (vb * denom) + ac * (vc * denom);
+	}
+
+	bool IsInsideTriangle(const Vector3& p, const std::array<Vector3, 3>& tri, const Vector3& normal) {
+		for (UINT i = 0; i < 3; ++i) {
+			const auto& a = tri[i];
+			const auto& b = tri[(i + 1) % 3];
+			if ((b - a).Cross(p - a).Dot(normal) < 0.f) return false;
+		}
+		return true;
+	}
+}
+
+UINT CollisionDetector::Collide(
+		const CollisionPrimitive* pFirst,
+		const CollisionPrimitive* pSecond,
+		std::vector<Contact>& contacts) {
+	if (pFirst->IsStatic() && pSecond->IsStatic()) return 0;
+
+	if (pFirst->GetType() > pSecond->GetType()) std::swap(pFirst, pSecond);
+
+	if (pSecond->GetType() == CollisionPrimitive::E_TriangleMesh) {
+		if (pFirst->GetType() == CollisionPrimitive::E_TriangleMesh) return 0;
+		return PrimitiveAndTriangleMesh(pFirst, static_cast<const CollisionTriangleMesh*>(pSecond), contacts);
+	}
+
+	switch (pFirst->GetType()) {
+	case CollisionPrimitive::E_Sphere:
+		if (pSecond->GetType() == CollisionPrimitive::E_Sphere)
+			return SphereAndSphere(
+				static_cast<const CollisionSphere*>(pFirst), static_cast<const CollisionSphere*>(pSecond), contacts);
+		if (pSecond->GetType() == CollisionPrimitive::E_Box)
+			return SphereAndBox(
+				static_cast<const CollisionSphere*>(pFirst), static_cast<const CollisionBox*>(pSecond), contacts);
+		break;
+	case CollisionPrimitive::E_Box:
+		if (pSecond->GetType() == CollisionPrimitive::E_Box)
+			return BoxAndBox(
+				static_cast<const CollisionBox*>(pFirst), static_cast<const CollisionBox*>(pSecond), contacts);
+		break;
+	default:
+		break;
+	}
+
+	return ConvexAndConvex(pFirst, pSecond, contacts);
+}
+
+UINT CollisionDetector::SphereAndSphere(
+		const CollisionSphere* pFirst, const CollisionSphere* pSecond, std::vector<Contact>& contacts) {
+	const auto diff = pFirst->GetCenter() - pSecond->GetCenter();
+	const float radius = pFirst->GetRadius() + pSecond->GetRadius();
+
+	const float distSq = diff.LengthSquared();
+	if (distSq >= radius * radius) return 0;
+
+	const float dist = std::sqrt(distSq);
+	const auto normal = dist > 1e-6f ? diff / dist : Vector3::UnitY;
+	const auto point = pSecond->GetCenter() + normal * pSecond->GetRadius();
+
+	contacts.push_back(MakeContact(pFirst, pSecond, point, normal, radius - dist));
+	return 1;
+}
+
+UINT CollisionDetector::SphereAndBox(
+		const CollisionSphere* pFirst, const CollisionBox* pSecond, std::vector<Contact>& contacts) {
+	const auto transform = pSecond->GetTransform();
+	const auto& halfExtents = pSecond->GetHalfExtents();
+
+	const auto center = pFirst->GetCenter();
+	const auto local = Vector3::Transform(center, transform.Invert());
+
+	const Vector3 closestLocal{
+		std::clamp(local.x, -halfExtents.x, halfExtents.x),
+		std::clamp(local.y, -halfExtents.y, halfExtents.y),
+		std::clamp(local.z, -halfExtents.z, halfExtents.z) };
+	const auto closest = Vector3::Transform(closestLocal, transform);
+
+	const auto diff = center - closest;
+	const float distSq = diff.LengthSquared();
+	const float radius = pFirst->GetRadius();
+	if (distSq >= radius * radius) return 0;
+
+	// The centre is inside the box, so the closest point gives no direction.
+	if (distSq < 1e-12f) return ConvexAndConvex(pFirst, pSecond, contacts);
+
+	const float dist = std::sqrt(distSq);
+
+	contacts.push_back(MakeContact(pFirst, pSecond, closest, diff / dist, radius - dist));
+	return 1;
+}
+
+UINT CollisionDetector::BoxAndBox(
+		const CollisionBox* pFirst, const CollisionBox* pSecond, std::vector<Contact>& contacts) {
+	MprResult result;
+	if (!Mpr(
+			[&](const Vector3& dir) { return pFirst->Support(dir); },
+			[&](const Vector3& dir) { return pSecond->Support(dir); },
+			pFirst->GetCenter(),
+			pSecond->GetCenter(),
+			result)) return 0;
+
+	// A single MPR point makes stacked boxes rock, so build a manifold from
+	// the corners of each box that lie inside the other one.
+	const auto& normal = result.Normal;
+	const auto faceSecond = pSecond->Support(normal);
+	const auto faceFirst = pFirst->Support(-normal);
+	const float margin = result.Depth + ContactMargin;
+
+	std::array<Vector3, 8> vertices;
+	UINT count = 0;
+
+	pFirst->Vertices(vertices);
+	for (const auto& vertex : vertices) {
+		const float depth = (faceSecond - vertex).Dot(normal);
+		if (depth <= 0.f || !pSecond->Contains(vertex, margin)) continue;
+
+		contacts.push_back(MakeContact(pFirst, pSecond, vertex, normal, depth));
+		++count;
+	}
+
+	pSecond->Vertices(vertices);
+	for (const auto& vertex : vertices) {
+		const float depth = (vertex - faceFirst).Dot(normal);
+		if (depth <= 0.f || !pFirst->Contains(vertex, margin)) continue;
+
+		contacts.push_back(MakeContact(pFirst, pSecond, vertex, normal, depth));
+		++count;
+	}
+
+	// Edge-edge contacts have no corner inside the other box.
+	if (count == 0) {
+		contacts.push_back(MakeContact(pFirst, pSecond, result.Point, normal, result.Depth));
+		++count;
+	}
+
+	return count;
+}
+
+UINT CollisionDetector::ConvexAndConvex(
+		const CollisionPrimitive* pFirst, const CollisionPrimitive* pSecond, std::vector<Contact>& contacts) {
+	MprResult result;
+	if (!Mpr(
+			[&](const Vector3& dir) { return pFirst->Support(dir); },
+			[&](const Vector3& dir) { return pSecond->Support(dir); },
+			pFirst->GetCenter(),
+			pSecond->GetCenter(),
+			result)) return 0;
+
+	contacts.push_back(MakeContact(pFirst, pSecond, result.Point, result.Normal, result.Depth));
+	return 1;
+}
+
+UINT CollisionDetector::PrimitiveAndTriangleMesh(
+		const CollisionPrimitive* pFirst, const CollisionTriangleMesh* pSecond, std::vector<Contact>& contacts) {
+	Vector3 bottom, top;
+	pFirst->ComputeBounds(bottom, top);
+
+	const Vector3 margin{ ContactMargin, ContactMargin, ContactMargin };
+
+	std::vector<std::uint32_t> triangles;
+	pSecond->QueryTriangles(bottom - margin, top + margin, triangles);
+
+	const auto center = pFirst->GetCenter();
+
+	std::array<Vector3, 8> corners;
+	if (pFirst->GetType() == CollisionPrimitive::E_Box)
+		static_cast<const CollisionBox*>(pFirst)->Vertices(corners);
+
+	UINT count = 0;
+	std::array<Vector3, 3> tri;
+
+	for (const auto index : triangles) {
+		pSecond->TriangleVertices(index, tri);
+
+		auto normal = (tri[1] - tri[0]).Cross(tri[2] - tri[0]);
+		normal.Normalize();
+
+		if (pFirst->GetType() == CollisionPrimitive::E_Sphere) {
+			const float radius = static_cast<const CollisionSphere*>(pFirst)->GetRadius();
+
+			const auto closest = ClosestPointOnTriangle(center, tri[0], tri[1], tri[2]);
+			const auto diff = center - closest;
+
+			const float distSq = diff.LengthSquared();
+			if (distSq >= radius * radius) continue;
+
+			const float dist = std::sqrt(distSq);
+			contacts.push_back(MakeContact(
+				pFirst, pSecond, closest, dist > 1e-6f ? diff / dist : normal, radius - dist));
+			++count;
+			continue;
+		}
+
+		if (pFirst->GetType() == CollisionPrimitive::E_Box) {
+			// Triangles are one-sided; ignore the ones the box is behind.
+			if ((center - tri[0]).Dot(normal) < 0.f) continue;
+
+			const auto& halfExtents = static_cast<const CollisionBox*>(pFirst)->GetHalfExtents();
+			const float maxDepth = 2.f * std::max({ halfExtents.x, halfExtents.y, halfExtents.z });
+
+			UINT found = 0;
+			for (const auto& corner : corners) {
+				const float dist = (corner - tri[0]).Dot(normal);
+				if (dist >= 0.f || dist < -maxDepth) continue;
+				if (!IsInsideTriangle(corner - normal * dist, tri, normal)) continue;
+
+				contacts.push_back(MakeContact(pFirst, pSecond, corner, normal, -dist));
+				++found;
+			}
+
+			count += found;
+			if (found > 0) continue;
+		}
+
+		MprResult result;
+		if (!Mpr(
+				[&](const Vector3& dir) { return pFirst->Support(dir); },
+				[&](const Vector3& dir) {
+					const float d0 = tri[0].Dot(dir);
+					const float d1 = tri[1].Dot(dir);
+					const float d2 = tri[2].Dot(dir);
+					if (d0 >= d1 && d0 >= d2) return tri[0];
+					return d1 >= d2 ? tri[1] : tri[2];
+				},
+				center,
+				(tri[0] + tri[1] + tri[2]) / 3.f,
+				result)) continue;
+
+		contacts.push_back(MakeContact(pFirst, pSecond, result.Point, result.Normal, result.Depth));
+		++count;
+	}
+
+	return count;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/CollisionPrimitive.hpp"
+#include "Physics/RigidBody.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX::SimpleMath;
+
+CollisionPrimitive::CollisionPrimitive(Type type, RigidBody* pBody)
+	: mType{ type }, mpBody{ pBody } {}
+
+bool CollisionPrimitive::IsStatic() const {
+	return mpBody == nullptr || !mpBody->HasFiniteMass();
+}
+
+Vector3 CollisionPrimitive::GetCenter() const {
+	return mpBody != nullptr ? mpBody->GetPosition() : Vector3{};
+}
\ No newline at end of file
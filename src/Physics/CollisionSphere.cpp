@@ -0,0 +1,23 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/CollisionSphere.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX::SimpleMath;
+
+CollisionSphere::CollisionSphere(RigidBody* pBody, float radius)
+	: CollisionPrimitive(E_Sphere, pBody), mRadius{ radius } {}
+
+void CollisionSphere::ComputeBounds(Vector3& bottom, Vector3& top) const {
+	const auto center = GetCenter();
+	const Vector3 extents{ mRadius, mRadius, mRadius };
+
+	bottom = center - extents;
+	top = center + extents;
+}
+
+Vector3 CollisionSphere::Support(const Vector3& dir) const {
+	auto n = dir;
+	n.Normalize();
+
+	return GetCenter() + n * mRadius;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/CollisionTriangleMesh.hpp"
+
+using namespace Physics::Cyclone;
+using namespace Common::AccelerationStructure;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+CollisionTriangleMesh::CollisionTriangleMesh()
+	: CollisionPrimitive(E_TriangleMesh, nullptr) {}
+
+void CollisionTriangleMesh::Build(
+		const XMFLOAT3* pPositions,
+		UINT stride,
+		UINT numVertices,
+		const UINT* pIndices,
+		UINT numIndices,
+		const Matrix& world) {
+	mVertices.clear();
+	mVertices.reserve(numVertices);
+
+	mBottom = Vector3{ FLT_MAX, FLT_MAX, FLT_MAX };
+	mTop = Vector3{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	const auto pBytes = reinterpret_cast<const BYTE*>(pPositions);
+	for (UINT i = 0; i < numVertices; ++i) {
+		const auto& position = *reinterpret_cast<const XMFLOAT3*>(pBytes + static_cast<size_t>(i) * stride);
+		const auto pos = Vector3::Transform(Vector3{ position }, world);
+
+		mVertices.emplace_back(pos.x, pos.y, pos.z, 0.f, 0.f, 0.f);
+
+		mBottom = Vector3::Min(mBottom, pos);
+		mTop = Vector3::Max(mTop, pos);
+	}
+
+	mTriangles.clear();
+	mTriangles.reserve(numIndices / 3);
+
+	for (UINT i = 0; i + 2 < numIndices; i += 3) {
+		Triangle triangle{};
+		triangle.Index1 = pIndices[i + 0];
+		triangle.Index2 = pIndices[i + 1];
+		triangle.Index3 = pIndices[i + 2];
+
+		const Vector3Df& v0 = mVertices[triangle.Index1];
+		const Vector3Df& v1 = mVertices[triangle.Index2];
+		const Vector3Df& v2 = mVertices[triangle.Index3];
+
+		triangle.Center = (v0 + v1 + v2) / 3.f;
+		triangle.Normal = cross(v1 - v0, v2 - v0);
+
+		// Degenerate triangles would only produce NaN normals.
+		if (triangle.Normal.lengthsq() <= 1e-12f) continue;
+		triangle.Normal.normalize();
+
+		mTriangles.push_back(triangle);
+	}
+
+	mBVH.Build(mVertices.data(), mTriangles.data(), static_cast<std::uint32_t>(mTriangles.size()));
+}
+
+void CollisionTriangleMesh::QueryTriangles(
+		const Vector3& bottom, const Vector3& top, std::vector<std::uint32_t>& triangles) const {
+	mBVH.Query(Vector3Df(bottom.x, bottom.y, bottom.z), Vector3Df(top.x, top.y, top.z), triangles);
+}
+
+void CollisionTriangleMesh::TriangleVertices(UINT index, std::array<Vector3, 3>& vertices) const {
+	const auto& triangle = mTriangles[index];
+
+	const Vector3Df& v0 = mVertices[triangle.Index1];
+	const Vector3Df& v1 = mVertices[triangle.Index2];
+	const Vector3Df& v2 = mVertices[triangle.Index3];
+
+	vertices[0] = Vector3{ v0.x, v0.y, v0.z };
+	vertices[1] = Vector3{ v1.x, v1.y, v1.z };
+	vertices[2] = Vector3{ v2.x, v2.y, v2.z };
+}
+
+void CollisionTriangleMesh::ComputeBounds(Vector3& bottom, Vector3& top) const {
+	bottom = mBottom;
+	top = mTop;
+}
+
+Vector3 CollisionTriangleMesh::Support(const Vector3& dir) const {
+	Vector3 best{};
+	float bestDist = -FLT_MAX;
+	for (const auto& vertex : mVertices) {
+		const Vector3 pos{ vertex.x, vertex.y, vertex.z };
+		const float dist = pos.Dot(dir);
+		if (dist > bestDist) {
+			bestDist = dist;
+			best = pos;
+		}
+	}
+
+	return best;
+}
\ No newline at end of file
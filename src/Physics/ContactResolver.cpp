@@ -0,0 +1,296 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/ContactResolver.hpp"
+#include "Physics/RigidBody.hpp"
+#include "Physics/ParallelUtil.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	// Fraction of the remaining penetration removed per step.
+	const float BaumgarteFactor = 0.2f;
+	// Penetration tolerated before any positional correction kicks in.
+	const float PenetrationSlop = 0.01f;
+	// Closing speeds below this do not bounce, which keeps stacks at rest.
+	const float RestitutionThreshold = 1.f;
+
+	// How far a contact may move on its body and still reuse last step's impulse.
+	const float WarmStartDistance = 0.05f;
+	const float WarmStartNormalCosine = 0.95f;
+
+	bool IsDynamic(const RigidBody* pBody) {
+		return pBody != nullptr && pBody->HasFiniteMass();
+	}
+
+	Vector3 VelocityAt(const RigidBody* pBody, const Vector3& offset) {
+		if (pBody == nullptr) return Vector3::Zero;
+		return pBody->GetVelocity() + pBody->GetRotation().Cross(offset);
+	}
+
+	float EffectiveMass(const RigidBody* pBody, const Vector3& offset, const Vector3& dir) {
+		if (!IsDynamic(pBody)) return 0.f;
+
+		const auto angular = Vector3::TransformNormal(offset.Cross(dir), pBody->GetInverseInertiaTensorWorld());
+		return pBody->GetInverseMass() + angular.Cross(offset).Dot(dir);
+	}
+
+	void ApplyImpulse(RigidBody* pBody, const Vector3& offset, const Vector3& impulse) {
+		if (!IsDynamic(pBody)) return;
+		pBody->ApplyImpulse(impulse, offset);
+	}
+
+	// Contacts are matched in the space of the first body that exists, so
+	// they follow the body as it moves between steps.
+	Vector3 ToLocal(const RigidBody* const* ppBodies, const Vector3& point) {
+		const auto* pBody = ppBodies[0] != nullptr ? ppBodies[0] : ppBodies[1];
+		if (pBody == nullptr) return point;
+		return Vector3::TransformNormal(point - pBody->GetPosition(), pBody->GetTransform().Transpose());
+	}
+
+	bool PairLess(const RigidBody* const* a, const RigidBody* const* b) {
+		return a[0] != b[0] ? std::less<const RigidBody*>()(a[0], b[0]) : std::less<const RigidBody*>()(a[1], b[1]);
+	}
+}
+
+ContactResolver::ContactResolver(UINT iterations) : mIterations(iterations) {}
+
+void ContactResolver::ResolveContacts(const std::vector<Contact>& contacts, float dt) {
+	if (contacts.empty() || dt <= 0.f) {
+		mCache.clear();
+		return;
+	}
+
+	PrepareConstraints(contacts, dt);
+	BuildIslands();
+
+	const UINT numIslands = static_cast<UINT>(mIslands.size());
+	const UINT threshold = mConstraints.size() >= ParallelThreshold ? 2 : UINT_MAX;
+
+	ParallelUtil::ParallelFor(numIslands, threshold, [&](UINT begin, UINT end) {
+		for (UINT i = begin; i < end; ++i)
+			SolveIsland(mIslands[i].first, mIslands[i].second);
+	});
+
+	CacheImpulses();
+}
+
+void ContactResolver::PrepareConstraints(const std::vector<Contact>& contacts, float dt) {
+	mConstraints.resize(contacts.size());
+
+	const float invDt = 1.f / dt;
+
+	for (size_t i = 0, end = contacts.size(); i < end; ++i) {
+		const auto& contact = contacts[i];
+		auto& constraint = mConstraints[i];
+
+		constraint.Bodies[0] = contact.Bodies[0];
+		constraint.Bodies[1] = contact.Bodies[1];
+		constraint.Normal = contact.Normal;
+		constraint.Friction = contact.Friction;
+
+		for (UINT b = 0; b < 2; ++b) {
+			const auto* pBody = contact.Bodies[b];
+			constraint.Offsets[b] = pBody != nullptr ? contact.Point - pBody->GetPosition() : Vector3::Zero;
+		}
+
+		// Any orthonormal pair in the contact plane will do.
+		const auto& n = contact.Normal;
+		auto tangent = std::abs(n.x) > 0.57735f ? Vector3{ n.y, -n.x, 0.f } : Vector3{ 0.f, n.z, -n.y };
+		tangent.Normalize();
+		constraint.Tangents[0] = tangent;
+		constraint.Tangents[1] = n.Cross(tangent);
+
+		const auto effectiveMass = [&](const Vector3& dir) {
+			const float k =
+				EffectiveMass(constraint.Bodies[0], constraint.Offsets[0], dir) +
+				EffectiveMass(constraint.Bodies[1], constraint.Offsets[1], dir);
+			return k > 0.f ? 1.f / k : 0.f;
+		};
+
+		constraint.NormalMass = effectiveMass(n);
+		constraint.TangentMass[0] = effectiveMass(constraint.Tangents[0]);
+		constraint.TangentMass[1] = effectiveMass(constraint.Tangents[1]);
+
+		const auto relative =
+			VelocityAt(constraint.Bodies[0], constraint.Offsets[0]) -
+			VelocityAt(constraint.Bodies[1], constraint.Offsets[1]);
+		const float closing = relative.Dot(n);
+
+		const float bounce = closing < -RestitutionThreshold ? -contact.Restitution * closing : 0.f;
+		const float push = BaumgarteFactor * invDt * std::max(contact.Penetration - PenetrationSlop, 0.f);
+
+		constraint.Bias = std::max(bounce, push);
+		constraint.NormalImpulse = 0.f;
+		constraint.TangentImpulse[0] = constraint.TangentImpulse[1] = 0.f;
+
+		WarmStart(constraint, contact);
+	}
+}
+
+void ContactResolver::WarmStart(Constraint& constraint, const Contact& contact) {
+	const auto compare = [](const CachedImpulse& cached, RigidBody* const* bodies) {
+		return PairLess(cached.Bodies, bodies);
+	};
+
+	auto iter = std::lower_bound(mCache.begin(), mCache.end(), constraint.Bodies, compare);
+
+	const auto local = ToLocal(contact.Bodies, contact.Point);
+
+	size_t best = SIZE_MAX;
+	float bestDistSq = WarmStartDistance * WarmStartDistance;
+
+	for (; iter != mCache.end() && iter->Bodies[0] == constraint.Bodies[0] && iter->Bodies[1] == constraint.Bodies[1]; ++iter) {
+		const size_t index = static_cast<size_t>(iter - mCache.begin());
+		if (mCacheUsed[index] || iter->Normal.Dot(contact.Normal) < WarmStartNormalCosine) continue;
+
+		const float distSq = (iter->LocalPoint - local).LengthSquared();
+		if (distSq >= bestDistSq) continue;
+
+		best = index;
+		bestDistSq = distSq;
+	}
+
+	if (best == SIZE_MAX) return;
+	mCacheUsed[best] = true;
+
+	const auto& cached = mCache[best];
+	constraint.NormalImpulse = cached.NormalImpulse;
+	constraint.TangentImpulse[0] = cached.TangentImpulse[0];
+	constraint.TangentImpulse[1] = cached.TangentImpulse[1];
+}
+
+void ContactResolver::CacheImpulses() {
+	mCache.resize(mConstraints.size());
+
+	for (size_t i = 0, end = mConstraints.size(); i < end; ++i) {
+		const auto& constraint = mConstraints[i];
+		auto& cached = mCache[i];
+
+		cached.Bodies[0] = constraint.Bodies[0];
+		cached.Bodies[1] = constraint.Bodies[1];
+		cached.Normal = constraint.Normal;
+		cached.NormalImpulse = constraint.NormalImpulse;
+		cached.TangentImpulse[0] = constraint.TangentImpulse[0];
+		cached.TangentImpulse[1] = constraint.TangentImpulse[1];
+
+		// Offsets are still those of the solve, so the point is rebuilt from them.
+		const auto* pBody = constraint.Bodies[0] != nullptr ? constraint.Bodies[0] : constraint.Bodies[1];
+		const auto& offset = constraint.Bodies[0] != nullptr ? constraint.Offsets[0] : constraint.Offsets[1];
+		cached.LocalPoint = pBody != nullptr
+			? Vector3::TransformNormal(offset, pBody->GetTransform().Transpose())
+			: offset;
+	}
+
+	std::stable_sort(mCache.begin(), mCache.end(), [](const CachedImpulse& a, const CachedImpulse& b) {
+		return PairLess(a.Bodies, b.Bodies);
+	});
+
+	mCacheUsed.assign(mCache.size(), false);
+}
+
+UINT ContactResolver::FindRoot(UINT index) {
+	while (mParents[index] != index) {
+		mParents[index] = mParents[mParents[index]];
+		index = mParents[index];
+	}
+	return index;
+}
+
+void ContactResolver::BuildIslands() {
+	mBodyIndices.clear();
+	mParents.clear();
+
+	const auto indexOf = [&](RigidBody* pBody) {
+		const auto [iter, inserted] = mBodyIndices.try_emplace(pBody, static_cast<UINT>(mParents.size()));
+		if (inserted) mParents.push_back(iter->second);
+		return iter->second;
+	};
+
+	// Static bodies never carry impulses between their neighbours, so they
+	// do not join islands together.
+	for (const auto& constraint : mConstraints) {
+		const bool dynamic0 = IsDynamic(constraint.Bodies[0]);
+		const bool dynamic1 = IsDynamic(constraint.Bodies[1]);
+
+		if (dynamic0 && dynamic1) {
+			const UINT root0 = FindRoot(indexOf(constraint.Bodies[0]));
+			const UINT root1 = FindRoot(indexOf(constraint.Bodies[1]));
+			if (root0 != root1) mParents[std::max(root0, root1)] = std::min(root0, root1);
+		}
+		else if (dynamic0) {
+			indexOf(constraint.Bodies[0]);
+		}
+		else if (dynamic1) {
+			indexOf(constraint.Bodies[1]);
+		}
+	}
+
+	for (auto& constraint : mConstraints) {
+		auto* pBody = IsDynamic(constraint.Bodies[0]) ? constraint.Bodies[0] : constraint.Bodies[1];
+		constraint.Island = IsDynamic(pBody) ? FindRoot(mBodyIndices[pBody]) : UINT_MAX;
+	}
+
+	// Stable so that contacts keep their narrowphase order inside an island.
+	std::stable_sort(mConstraints.begin(), mConstraints.end(), [](const Constraint& a, const Constraint& b) {
+		return a.Island < b.Island;
+	});
+
+	mIslands.clear();
+	for (UINT begin = 0, count = static_cast<UINT>(mConstraints.size()); begin < count;) {
+		const UINT island = mConstraints[begin].Island;
+		if (island == UINT_MAX) break;
+
+		UINT end = begin + 1;
+		while (end < count && mConstraints[end].Island == island) ++end;
+
+		mIslands.emplace_back(begin, end);
+		begin = end;
+	}
+}
+
+void ContactResolver::SolveIsland(UINT begin, UINT end) {
+	// Applies the impulses carried over from the previous step.
+	for (UINT i = begin; i < end; ++i) {
+		const auto& c = mConstraints[i];
+
+		const auto impulse =
+			c.Normal * c.NormalImpulse +
+			c.Tangents[0] * c.TangentImpulse[0] +
+			c.Tangents[1] * c.TangentImpulse[1];
+		ApplyImpulse(c.Bodies[0], c.Offsets[0], impulse);
+		ApplyImpulse(c.Bodies[1], c.Offsets[1], -impulse);
+	}
+
+	for (UINT iter = 0; iter < mIterations; ++iter) {
+		for (UINT i = begin; i < end; ++i) {
+			auto& c = mConstraints[i];
+
+			// Friction first, bounded by the normal impulse of the last pass.
+			for (UINT t = 0; t < 2; ++t) {
+				const auto relative =
+					VelocityAt(c.Bodies[0], c.Offsets[0]) -
+					VelocityAt(c.Bodies[1], c.Offsets[1]);
+
+				const float limit = c.Friction * c.NormalImpulse;
+				const float previous = c.TangentImpulse[t];
+				c.TangentImpulse[t] = std::clamp(previous - relative.Dot(c.Tangents[t]) * c.TangentMass[t], -limit, limit);
+
+				const auto impulse = c.Tangents[t] * (c.TangentImpulse[t] - previous);
+				ApplyImpulse(c.Bodies[0], c.Offsets[0], impulse);
+				ApplyImpulse(c.Bodies[1], c.Offsets[1], -impulse);
+			}
+
+			const auto relative =
+				VelocityAt(c.Bodies[0], c.Offsets[0]) -
+				VelocityAt(c.Bodies[1], c.Offsets[1]);
+
+			const float previous = c.NormalImpulse;
+			c.NormalImpulse = std::max(previous + (c.Bias - relative.Dot(c.Normal)) * c.NormalMass, 0.f);
+
+			const auto impulse = c.Normal * (c.NormalImpulse - previous);
+			ApplyImpulse(c.Bodies[0], c.Offsets[0], impulse);
+			ApplyImpulse(c.Bodies[1], c.Offsets[1], -impulse);
+		}
+	}
+}
\ No newline at end of file
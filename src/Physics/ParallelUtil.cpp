@@ -0,0 +1,24 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/ParallelUtil.hpp"
+
+#include <future>
+
+using namespace Physics::Cyclone;
+
+void ParallelUtil::ParallelFor(UINT count, UINT threshold, const std::function<void(UINT, UINT)>& func) {
+	const UINT numThreads = std::max(1u, std::thread::hardware_concurrency());
+	if (count < threshold || numThreads == 1) {
+		func(0, count);
+		return;
+	}
+
+	const UINT chunk = (count + numThreads - 1) / numThreads;
+
+	std::vector<std::future<void>> tasks;
+	for (UINT begin = chunk; begin < count; begin += chunk)
+		tasks.emplace_back(std::async(std::launch::async, func, begin, std::min(begin + chunk, count)));
+
+	func(0, std::min(chunk, count));
+
+	for (auto& task : tasks) task.get();
+}
\ No newline at end of file
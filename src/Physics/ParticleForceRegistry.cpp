@@ -0,0 +1,61 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/ParticleForceRegistry.hpp"
+#include "Physics/ParticleForceGenerator.hpp"
+#include "Physics/ParticlePairForceGenerator.hpp"
+#include "Physics/Particle.hpp"
+
+using namespace Physics::Cyclone;
+
+void ParticleForceRegistry::Add(Particle* pParticle, ParticleForceGenerator* pGenerator) {
+	Add(pParticle, 1, pGenerator);
+}
+
+void ParticleForceRegistry::Add(Particle* pParticles, UINT count, ParticleForceGenerator* pGenerator) {
+	mRegistrations.push_back({ { pParticles, count }, pGenerator });
+}
+
+void ParticleForceRegistry::Add(Particle* pParticles, UINT count, ParticlePairForceGenerator* pGenerator) {
+	mPairRegistrations.push_back({ { pParticles, count }, pGenerator, std::make_unique<ParticleSpatialHash>() });
+}
+
+void ParticleForceRegistry::Remove(Particle* pParticles, ParticleForceGenerator* pGenerator) {
+	const auto end = std::remove_if(mRegistrations.begin(), mRegistrations.end(),
+		[&](const ParticleForceRegistration& reg) {
+			return reg.Range.Particles == pParticles && reg.Generator == pGenerator;
+		});
+	mRegistrations.erase(end, mRegistrations.end());
+}
+
+void ParticleForceRegistry::Remove(Particle* pParticles, ParticlePairForceGenerator* pGenerator) {
+	const auto end = std::remove_if(mPairRegistrations.begin(), mPairRegistrations.end(),
+		[&](const ParticlePairForceRegistration& reg) {
+			return reg.Range.Particles == pParticles && reg.Generator == pGenerator;
+		});
+	mPairRegistrations.erase(end, mPairRegistrations.end());
+}
+
+void ParticleForceRegistry::Clear() {
+	mRegistrations.clear();
+	mPairRegistrations.clear();
+}
+
+void ParticleForceRegistry::UpdateForces(float dt) {
+	// Single-particle generators may cache per-call state (see
+	// ParticlePointGravity), so they are driven on this thread.
+	for (const auto& reg : mRegistrations) {
+		for (UINT i = 0; i < reg.Range.Count; ++i)
+			reg.Generator->UpdateForce(&reg.Range.Particles[i], dt);
+	}
+
+	for (auto& reg : mPairRegistrations) {
+		const float range = reg.Generator->Range();
+
+		reg.Grid->Build(reg.Range.Particles, reg.Range.Count, range);
+
+		auto pParticles = reg.Range.Particles;
+		auto pGenerator = reg.Generator;
+		reg.Grid->ForEachNeighbour(range, [=](UINT i, UINT j) {
+			pGenerator->UpdateForce(&pParticles[i], &pParticles[j], dt);
+		});
+	}
+}
\ No newline at end of file
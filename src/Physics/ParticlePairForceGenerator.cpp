@@ -0,0 +1,2 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/ParticlePairForceGenerator.hpp"
\ No newline at end of file
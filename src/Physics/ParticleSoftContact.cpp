@@ -0,0 +1,24 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/ParticleSoftContact.hpp"
+#include "Physics/Particle.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX;
+
+ParticleSoftContact::ParticleSoftContact(float radius, float stiffness)
+	: mRadius{ radius }, mStiffness{ stiffness } {}
+
+float ParticleSoftContact::Range() const { return mRadius * 2.f; }
+
+void ParticleSoftContact::UpdateForce(Particle* pParticle, const Particle* pOther, float dt) {
+	auto diff = pParticle->GetPosition() - pOther->GetPosition();
+
+	const auto dist = diff.Length();
+	const auto penetration = Range() - dist;
+	if (penetration <= 0.f || dist <= 1e-6f) return;
+
+	auto force = diff / dist;
+	force *= mStiffness * penetration;
+
+	pParticle->AddForce(force);
+}
\ No newline at end of file
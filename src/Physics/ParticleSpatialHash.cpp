@@ -0,0 +1,82 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/ParticleSpatialHash.hpp"
+#include "Physics/ParallelUtil.hpp"
+
+#include <execution>
+
+using namespace Physics::Cyclone;
+using namespace DirectX;
+
+void ParticleSpatialHash::Build(Particle* pParticles, UINT count, float cellSize) {
+	mpParticles = pParticles;
+	mParticleCount = count;
+
+	mCellSize = std::max(cellSize, 1e-4f);
+	mInvCellSize = 1.f / mCellSize;
+
+	// Keep the table at least twice as large as the particle count so that
+	// unrelated cells rarely collide.
+	UINT bucketCount = 64;
+	while (bucketCount < count * 2) bucketCount <<= 1;
+	mBucketMask = bucketCount - 1;
+
+	mEntries.resize(count);
+	mBucketStart.assign(bucketCount, InvalidIndex);
+	mBucketEnd.assign(bucketCount, InvalidIndex);
+
+	if (count == 0) return;
+
+	ParallelUtil::ParallelFor(count, ParallelThreshold, [&](UINT begin, UINT end) {
+		for (UINT i = begin; i < end; ++i) {
+			const auto& pos = mpParticles[i].GetPosition();
+			mEntries[i].Bucket = CellBucket(CellCoord(pos.x), CellCoord(pos.y), CellCoord(pos.z));
+			mEntries[i].Index = i;
+		}
+	});
+
+	const auto compare = [](const Entry& a, const Entry& b) {
+		return a.Bucket < b.Bucket || (a.Bucket == b.Bucket && a.Index < b.Index);
+	};
+	if (count < ParallelThreshold) std::sort(mEntries.begin(), mEntries.end(), compare);
+	else std::sort(std::execution::par_unseq, mEntries.begin(), mEntries.end(), compare);
+
+	// Each bucket boundary is owned by exactly one entry, so the ranges can
+	// be written without synchronization.
+	ParallelUtil::ParallelFor(count, ParallelThreshold, [&](UINT begin, UINT end) {
+		for (UINT i = begin; i < end; ++i) {
+			const UINT bucket = mEntries[i].Bucket;
+			if (i == 0 || mEntries[i - 1].Bucket != bucket) mBucketStart[bucket] = i;
+			if (i + 1 == count || mEntries[i + 1].Bucket != bucket) mBucketEnd[bucket] = i + 1;
+		}
+	});
+}
+
+void ParticleSpatialHash::GatherPairs(float radius, std::vector<Pair>& pairs) const {
+	if (mParticleCount == 0) return;
+
+	const float radiusSq = radius * radius;
+	const INT reach = NeighbourReach(radius);
+
+	const size_t first = pairs.size();
+	std::mutex mutex;
+
+	ParallelUtil::ParallelFor(mParticleCount, ParallelThreshold, [&](UINT begin, UINT end) {
+		std::vector<UINT> visited;
+		std::vector<Pair> local;
+
+		for (UINT e = begin; e < end; ++e) {
+			VisitNeighbours(e, radiusSq, reach, visited, [&](UINT i, UINT j) {
+				if (i < j) local.push_back({ i, j });
+			});
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		pairs.insert(pairs.end(), local.begin(), local.end());
+	});
+
+	// Chunks land in whatever order the workers finish, so the pairs are
+	// sorted to keep the contact order the same from run to run.
+	std::sort(pairs.begin() + first, pairs.end(), [](const Pair& a, const Pair& b) {
+		return a.First < b.First || (a.First == b.First && a.Second < b.Second);
+	});
+}
\ No newline at end of file
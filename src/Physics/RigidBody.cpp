@@ -0,0 +1,99 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/RigidBody.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+void RigidBody::SetInertiaTensor(const Matrix& inertiaTensor) {
+	auto tensor = inertiaTensor;
+	tensor._14 = tensor._24 = tensor._34 = 0.f;
+	tensor._41 = tensor._42 = tensor._43 = 0.f;
+	tensor._44 = 1.f;
+
+	mInverseInertiaTensor = tensor.Invert();
+}
+
+void RigidBody::CalculateDerivedData() {
+	mOrientation.Normalize();
+
+	const auto rotation = Matrix::CreateFromQuaternion(mOrientation);
+	mTransform = rotation * Matrix::CreateTranslation(mPosition);
+
+	// Immovable bodies must not pick up angular velocity from contacts.
+	if (!HasFiniteMass()) {
+		mInverseInertiaTensorWorld = Matrix::Identity * 0.f;
+		return;
+	}
+
+	// Row vectors: world -> body -> inverse tensor -> world.
+	mInverseInertiaTensorWorld = rotation.Transpose() * mInverseInertiaTensor * rotation;
+}
+
+void RigidBody::IntegrateVelocity(float dt) {
+	if (!HasFiniteMass() || dt <= 0.f) {
+		ClearAccumulators();
+		return;
+	}
+
+	const auto linearAccel = mAcceleration + mForceAccum * mInverseMass;
+	const auto angularAccel = Vector3::TransformNormal(mTorqueAccum, mInverseInertiaTensorWorld);
+
+	mVelocity += linearAccel * dt;
+	mRotation += angularAccel * dt;
+
+	mVelocity *= std::powf(mLinearDamping, dt);
+	mRotation *= std::powf(mAngularDamping, dt);
+
+	ClearAccumulators();
+}
+
+void RigidBody::IntegratePosition(float dt) {
+	if (!HasFiniteMass() || dt <= 0.f) return;
+
+	mPosition += mVelocity * dt;
+
+	const float speed = mRotation.Length();
+	if (speed > 1e-6f) {
+		const auto delta = Quaternion::CreateFromAxisAngle(mRotation / speed, speed * dt);
+		mOrientation = mOrientation * delta;
+	}
+
+	CalculateDerivedData();
+}
+
+void RigidBody::AddForce(const Vector3& force) {
+	mForceAccum += force;
+}
+
+void RigidBody::AddForceAtPoint(const Vector3& force, const Vector3& point) {
+	const auto offset = point - mPosition;
+
+	mForceAccum += force;
+	mTorqueAccum += offset.Cross(force);
+}
+
+void RigidBody::AddTorque(const Vector3& torque) {
+	mTorqueAccum += torque;
+}
+
+void RigidBody::ApplyImpulse(const Vector3& impulse, const Vector3& offset) {
+	if (!HasFiniteMass()) return;
+
+	mVelocity += impulse * mInverseMass;
+	mRotation += Vector3::TransformNormal(offset.Cross(impulse), mInverseInertiaTensorWorld);
+}
+
+Matrix RigidBody::SphereInertiaTensor(float mass, float radius) {
+	const float i = 0.4f * mass * radius * radius;
+	return Matrix::CreateScale(i, i, i);
+}
+
+Matrix RigidBody::BoxInertiaTensor(float mass, const Vector3& halfExtents) {
+	const auto squares = halfExtents * halfExtents;
+	const float k = mass / 3.f;
+	return Matrix::CreateScale(
+		k * (squares.y + squares.z),
+		k * (squares.x + squares.z),
+		k * (squares.x + squares.y));
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/RigidBodyWorld.hpp"
+#include "Physics/RigidBody.hpp"
+#include "Physics/CollisionPrimitive.hpp"
+#include "Physics/CollisionDetector.hpp"
+#include "Physics/ParallelUtil.hpp"
+
+using namespace Physics::Cyclone;
+
+RigidBodyWorld::RigidBodyWorld(UINT iterations) : mResolver(iterations) {}
+
+void RigidBodyWorld::AddBody(RigidBody* pBody) {
+	mBodies.push_back(pBody);
+}
+
+void RigidBodyWorld::RemoveBody(RigidBody* pBody) {
+	const auto iter = std::find(mBodies.begin(), mBodies.end(), pBody);
+	if (iter != mBodies.end()) mBodies.erase(iter);
+}
+
+void RigidBodyWorld::AddPrimitive(CollisionPrimitive* pPrimitive) {
+	mPrimitives.push_back(pPrimitive);
+}
+
+void RigidBodyWorld::RemovePrimitive(CollisionPrimitive* pPrimitive) {
+	const auto iter = std::find(mPrimitives.begin(), mPrimitives.end(), pPrimitive);
+	if (iter != mPrimitives.end()) mPrimitives.erase(iter);
+}
+
+void RigidBodyWorld::StartFrame() {
+	for (auto body : mBodies) {
+		body->ClearAccumulators();
+		body->CalculateDerivedData();
+	}
+}
+
+void RigidBodyWorld::RunPhysics(float dt) {
+	const UINT numBodies = static_cast<UINT>(mBodies.size());
+
+	ParallelUtil::ParallelFor(numBodies, ParallelThreshold, [&](UINT begin, UINT end) {
+		for (UINT i = begin; i < end; ++i) mBodies[i]->IntegrateVelocity(dt);
+	});
+
+	GenerateContacts();
+
+	mResolver.ResolveContacts(mContacts, dt);
+
+	ParallelUtil::ParallelFor(numBodies, ParallelThreshold, [&](UINT begin, UINT end) {
+		for (UINT i = begin; i < end; ++i) mBodies[i]->IntegratePosition(dt);
+	});
+}
+
+void RigidBodyWorld::GenerateContacts() {
+	mContacts.clear();
+
+	mBroadphase.FindPairs(mPrimitives, mPairs);
+
+	const UINT numPairs = static_cast<UINT>(mPairs.size());
+	if (numPairs == 0) return;
+
+	const UINT numThreads = std::max(1u, std::thread::hardware_concurrency());
+	const UINT chunkSize = (numPairs + numThreads - 1) / numThreads;
+
+	mChunkContacts.resize(numThreads + 1);
+	for (auto& chunk : mChunkContacts) chunk.clear();
+
+	ParallelUtil::ParallelFor(numPairs, ParallelThreshold, [&](UINT begin, UINT end) {
+		auto& out = mChunkContacts[begin / chunkSize];
+		for (UINT i = begin; i < end; ++i)
+			CollisionDetector::Collide(mPairs[i].First, mPairs[i].Second, out);
+	});
+
+	// Concatenated in chunk order so the solver sees the same contact order
+	// regardless of thread timing.
+	for (const auto& chunk : mChunkContacts)
+		mContacts.insert(mContacts.end(), chunk.begin(), chunk.end());
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "Physics/pch_cyclone.h"
+#include "Physics/SweepAndPrune.hpp"
+#include "Physics/CollisionPrimitive.hpp"
+#include "Physics/ParallelUtil.hpp"
+
+#include <execution>
+
+using namespace Physics::Cyclone;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+void SweepAndPrune::FindPairs(const std::vector<CollisionPrimitive*>& primitives, std::vector<Pair>& pairs) {
+	pairs.clear();
+
+	const UINT count = static_cast<UINT>(primitives.size());
+	if (count < 2) return;
+
+	mProxies.resize(count);
+
+	Vector3 sum{}, sumSq{};
+	for (UINT i = 0; i < count; ++i) {
+		auto& proxy = mProxies[i];
+		proxy.Primitive = primitives[i];
+		proxy.Primitive->ComputeBounds(proxy.Bottom, proxy.Top);
+
+		const auto center = (proxy.Bottom + proxy.Top) * 0.5f;
+		sum += center;
+		sumSq += center * center;
+	}
+
+	const auto variance = sumSq - sum * sum / static_cast<float>(count);
+
+	UINT axis = 0;
+	if (variance.y > variance.x) axis = 1;
+	if (variance.z > (axis == 0 ? variance.x : variance.y)) axis = 2;
+
+	for (auto& proxy : mProxies) {
+		proxy.Min = (&proxy.Bottom.x)[axis];
+		proxy.Max = (&proxy.Top.x)[axis];
+	}
+
+	const auto compare = [](const Proxy& a, const Proxy& b) { return a.Min < b.Min; };
+	if (count >= ParallelThreshold) std::sort(std::execution::par_unseq, mProxies.begin(), mProxies.end(), compare);
+	else std::sort(mProxies.begin(), mProxies.end(), compare);
+
+	// Each thread sweeps from its own slice of proxies; results are kept per
+	// chunk and concatenated in chunk order so the pair list is stable.
+	const UINT numThreads = std::max(1u, std::thread::hardware_concurrency());
+	mChunkPairs.resize(numThreads + 1);
+	for (auto& chunk : mChunkPairs) chunk.clear();
+
+	const UINT chunkSize = (count + numThreads - 1) / numThreads;
+
+	ParallelUtil::ParallelFor(count, ParallelThreshold, [&](UINT begin, UINT end) {
+		auto& out = mChunkPairs[begin / chunkSize];
+
+		for (UINT i = begin; i < end; ++i) {
+			const auto& a = mProxies[i];
+			const bool staticA = a.Primitive->IsStatic();
+
+			for (UINT j = i + 1; j < count; ++j) {
+				const auto& b = mProxies[j];
+				if (b.Min > a.Max) break;
+
+				if (staticA && b.Primitive->IsStatic()) continue;
+				if (a.Primitive->GetBody() != nullptr && a.Primitive->GetBody() == b.Primitive->GetBody()) continue;
+
+				if (a.Bottom.x > b.Top.x || b.Bottom.x > a.Top.x ||
+					a.Bottom.y > b.Top.y || b.Bottom.y > a.Top.y ||
+					a.Bottom.z > b.Top.z || b.Bottom.z > a.Top.z) continue;
+
+				out.push_back({ a.Primitive, b.Primitive });
+			}
+		}
+	});
+
+	for (const auto& chunk : mChunkPairs)
+		pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+}
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "Render/DX/Foundation/Core/CommandObject.hpp"
 #include "Render/DX/Foundation/Resource/GpuResource.hpp"
 #include "Render/DX/Foundation/Util/D3D12Util.hpp"
+#include "Render/DX/Foundation/Util/TextureCooker.hpp"
 #include "ImGuiManager/DX/DxImGuiManager.hpp"
 
 using namespace Microsoft::WRL;
@@ -49,6 +50,7 @@ BOOL DxLowRenderer::Initialize(
 
 	CheckReturn(mpLogFile, Foundation::Resource::GpuResource::Initialize(mpLogFile));
 	CheckReturn(mpLogFile, Foundation::Util::D3D12Util::Initialize(mpLogFile));
+	CheckReturn(mpLogFile, Foundation::Util::TextureCooker::Initialize(mpLogFile));
 
 	CheckReturn(mpLogFile, GetHWInfo());
 	CheckReturn(mpLogFile, InitDirect3D());
@@ -94,6 +96,7 @@ void DxLowRenderer::CleanUp() {
 }
 
 BOOL DxLowRenderer::GetHWInfo() {
+	CheckReturn(mpLogFile, Common::Foundation::Core::HWInfo::GetInstructionSupport(mpLogFile, *mProcessor.get()));
 	CheckReturn(mpLogFile, Common::Foundation::Core::HWInfo::GetCoreInfo(mpLogFile, *mProcessor.get()));
 
 	return TRUE;
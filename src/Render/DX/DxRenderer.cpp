@@ -7,7 +7,17 @@
 #include "Common/Foundation/Mesh/Transform.hpp"
 #include "Common/Foundation/Light.h"
 #include "Common/Render/ShadingArgument.hpp"
+#include "Common/Render/EffectResolution.h"
 #include "Common/Util/MathUtil.hpp"
+#include "Common/Util/StringUtil.hpp"
+#include "Common/Util/HashUtil.hpp"
+#include "Common/Util/FrustumCuller.hpp"
+#include "Common/Util/DrawBatcher.hpp"
+#include "Common/Util/LightClusterer.hpp"
+#include "Common/Util/ShadowCascade.hpp"
+#include "Common/Util/MaskedOcclusionCuller.hpp"
+#include "Common/Util/DynamicResolution.hpp"
+#include "Common/Util/EffectResolutionUtil.hpp"
 #include "Render/DX/Foundation/ConstantBuffer.h"
 #include "Render/DX/Foundation/RenderItem.hpp"
 #include "Render/DX/Foundation/Core/Factory.hpp"
@@ -16,10 +26,15 @@
 #include "Render/DX/Foundation/Core/DescriptorHeap.hpp"
 #include "Render/DX/Foundation/Core/SwapChain.hpp"
 #include "Render/DX/Foundation/Core/DepthStencilBuffer.hpp"
+#include "Render/DX/Foundation/Core/PipelineStateCache.hpp"
+#include "Render/DX/Foundation/Core/RenderGraph.hpp"
+#include "Render/DX/Foundation/Core/UploadQueue.hpp"
+#include "Render/DX/Foundation/Core/TextureStreamer.hpp"
 #include "Render/DX/Foundation/Resource/GpuResource.hpp"
 #include "Render/DX/Foundation/Resource/FrameResource.hpp"
 #include "Render/DX/Foundation/Resource/MeshGeometry.hpp"
 #include "Render/DX/Foundation/Resource/MaterialData.hpp"
+#include "Render/DX/Foundation/Resource/Texture.hpp"
 #include "Render/DX/Foundation/Util/D3D12Util.hpp"
 #include "Render/DX/Shading/Util/ShadingObjectManager.hpp"
 #include "Render/DX/Shading/Util/ShaderManager.hpp"
@@ -49,6 +64,7 @@
 #include "Render/DX/Shading/EyeAdaption.hpp"
 #include "Render/DX/Shading/RaytracedShadow.hpp"
 #include "Render/DX/Shading/ChromaticAberration.hpp"
+#include "Render/DX/Shading/GpuCulling.hpp"
 #include "ImGuiManager/DX/DxImGuiManager.hpp"
 #include "FrankLuna/GeometryGenerator.h"
 
@@ -75,6 +91,111 @@
 using namespace Render::DX;
 using namespace DirectX;
 
+namespace {
+	// Cooked by the ShaderCooker project from the manifest; shipped instead
+	// of the HLSL sources. Only debug builds compile sources at run time.
+	const WCHAR* const ShaderArchivePath = L".\\Shaders.pak";
+	const WCHAR* const ShaderManifestPath = L".\\..\\..\\..\\assets\\Shaders\\HLSL\\ShaderManifest.txt";
+	const WCHAR* const ShaderSourceDir = L".\\..\\..\\..\\assets\\Shaders\\HLSL\\";
+#ifdef _DEBUG
+	const BOOL CompileShadersAtRuntime = TRUE;
+#else
+	const BOOL CompileShadersAtRuntime = FALSE;
+#endif
+	const WCHAR* const PipelineLibraryPath = L".\\PipelineLibrary.bin";
+
+	// Staging memory shared by every upload in flight.
+	const UINT64 UploadRingSize = 64ull * 1024 * 1024;
+
+	// Mip reads the texture streamer keeps on worker threads at once.
+	const UINT MaxTextureReadsInFlight = 8;
+
+	// Descriptors a frame may create on the fly.
+	const UINT TransientDescriptorCount = 256;
+
+	// Blend of logarithmic and uniform cascade splits, and the view depth
+	// past which directional lights cast no shadows.
+	const FLOAT CascadeSplitLambda = 0.8f;
+	const FLOAT MaxShadowDistance = 256.f;
+
+	// Object constants each frame resource holds; also the number of
+	// records the GPU culling pass can emit. Every buffer sized by it
+	// takes at most 256 bytes per object.
+	const UINT MaxObjectCount = 4096;
+
+	// Size of the software depth buffer the CPU path culls against, the
+	// most occluders drawn into it per frame and the smallest screen
+	// coverage, as a fraction of the view height, an occluder must have.
+	const UINT OcclusionBufferWidth = 320;
+	const UINT OcclusionBufferHeight = 180;
+	const UINT MaxOccluderCount = 8;
+	const FLOAT MinOccluderCoverage = 0.1f;
+
+	// Covers only what ends up in MaterialData; names may differ between
+	// otherwise identical materials.
+	Common::Foundation::Hash HashMaterial(const Common::Foundation::Mesh::Material& material) {
+		using Common::Util::HashUtil;
+
+		Common::Foundation::Hash hash = HashUtil::HashBytes(&material.Albedo, sizeof(material.Albedo));
+		hash = HashUtil::HashCombine(hash, HashUtil::HashBytes(&material.Specular, sizeof(material.Specular)));
+		hash = HashUtil::HashCombine(hash, HashUtil::HashBytes(&material.Roughness, sizeof(material.Roughness)));
+		hash = HashUtil::HashCombine(hash, HashUtil::HashBytes(&material.Metalness, sizeof(material.Metalness)));
+
+		for (const auto map : {
+				&material.AlbedoMap,
+				&material.NormalMap,
+				&material.AlphaMap,
+				&material.RoughnessMap,
+				&material.MetalnessMap,
+				&material.SpecularMap })
+			hash = HashUtil::HashCombine(hash, std::hash<std::string>()(*map));
+
+		return hash;
+	}
+
+	// Number of view-projection matrices a light renders its shadow with.
+	// Lights without a shadow frustum report zero.
+	UINT ShadowFaceCount(const Common::Foundation::Light* const pLight) {
+		switch (pLight->Type) {
+		case Common::Foundation::LightType::E_Directional:
+			return ShadingConvention::Shadow::CascadeCount;
+		case Common::Foundation::LightType::E_Spot:
+			return 1;
+		case Common::Foundation::LightType::E_Point:
+		case Common::Foundation::LightType::E_Tube:
+			return 6;
+		default:
+			return 0;
+		}
+	}
+
+	// Froxel grid the unshadowed lights are binned into.
+	Common::Util::LightClusterer::Grid ClusterGrid(const Common::Foundation::Camera::GameCamera* const pCamera) {
+		return {
+			ShadingConvention::LightCluster::ClusterCountX,
+			ShadingConvention::LightCluster::ClusterCountY,
+			ShadingConvention::LightCluster::ClusterCountZ,
+			pCamera->NearZ(),
+			pCamera->FarZ() };
+	}
+
+	// Sphere around the lit volume of a point or spot light.
+	BoundingSphere ClusteredLightBounds(const Common::Foundation::Light* const pLight) {
+		if (pLight->Type == Common::Foundation::LightType::E_Spot) {
+			XMFLOAT3 direction;
+			XMStoreFloat3(&direction, XMVector3Normalize(XMLoadFloat3(&pLight->Direction)));
+
+			return Common::Util::LightClusterer::SpotLightBounds(
+				pLight->Position, 
+				direction, 
+				pLight->AttenuationRadius, 
+				Common::Util::MathUtil::DegreesToRadians(pLight->OuterConeAngle));
+		}
+
+		return BoundingSphere(pLight->Position, pLight->AttenuationRadius);
+	}
+}
+
 extern "C" RendererAPI Common::Render::Renderer* Render::CreateRenderer() {
 	return new DxRenderer();
 }
@@ -87,6 +208,14 @@ DxRenderer::DxRenderer() {
 	// Shading objets
 	mShadingObjectManager = std::make_unique<Shading::Util::ShadingObjectManager>();
 	mShaderManager = std::make_unique<Shading::Util::ShaderManager>();
+	mPipelineStateCache = std::make_unique<Foundation::Core::PipelineStateCache>();
+	mRenderGraph = std::make_unique<Foundation::Core::RenderGraph>();
+
+	// Upload queue
+	mUploadQueue = std::make_unique<Foundation::Core::UploadQueue>();
+
+	// Texture streamer
+	mTextureStreamer = std::make_unique<Foundation::Core::TextureStreamer>();
 	
 	mShadingObjectManager->Add<Shading::Util::MipmapGenerator::MipmapGeneratorClass>();
 	mShadingObjectManager->Add<Shading::Util::EquirectangularConverter::EquirectangularConverterClass>();
@@ -112,9 +241,25 @@ DxRenderer::DxRenderer() {
 	mShadingObjectManager->Add<Shading::EyeAdaption::EyeAdaptionClass>();
 	mShadingObjectManager->Add<Shading::RaytracedShadow::RaytracedShadowClass>();
 	mShadingObjectManager->Add<Shading::ChromaticAberration::ChromaticAberrationClass>();
+	mShadingObjectManager->Add<Shading::GpuCulling::GpuCullingClass>();
 
 	// Accleration structure manager
 	mAccelerationStructureManager = std::make_unique<Shading::Util::AccelerationStructureManager>();
+
+	// Frustum culler
+	mFrustumCuller = std::make_unique<Common::Util::FrustumCuller>();
+
+	// Draw batcher
+	mDrawBatcher = std::make_unique<Common::Util::DrawBatcher>();
+
+	// Light clusterer
+	mLightClusterer = std::make_unique<Common::Util::LightClusterer>();
+
+	// Occlusion culler
+	mOcclusionCuller = std::make_unique<Common::Util::MaskedOcclusionCuller>();
+
+	// Resolution controller
+	mDynamicResolution = std::make_unique<Common::Util::DynamicResolution>();
 }
 
 DxRenderer::~DxRenderer() { CleanUp(); }
@@ -127,14 +272,36 @@ BOOL DxRenderer::Initialize(
 		UINT width, UINT height) {
 	CheckReturn(mpLogFile, DxLowRenderer::Initialize(pLogFile, pWndManager, pImGuiManager, pArgSet, width, height));
 
+	CheckReturn(mpLogFile, mUploadQueue->Initialize(mpLogFile, mDevice.get(), UploadRingSize));
+	CheckReturn(mpLogFile, mTextureStreamer->Initialize(
+		mpLogFile,
+		mDevice.get(),
+		mUploadQueue.get(),
+		mDescriptorHeap.get(),
+		static_cast<UINT64>(mpShadingArgumentSet->TextureStreaming.BudgetMB) * 1024 * 1024,
+		MaxTextureReadsInFlight));
+
+	const auto& resolution = mpShadingArgumentSet->DynamicResolution;
+	mDynamicResolution->Initialize(
+		resolution.MinScale,
+		resolution.MaxScale,
+		1.f / static_cast<FLOAT>(resolution.TargetFrameRate));
+	SetRenderResolution(mClientWidth, mClientHeight);
+
 	CheckReturn(mpLogFile, InitShadingObjects());
 	CheckReturn(mpLogFile, BuildFrameResources());
 
+	mShadingObjectManager->SetRenderArea(mRenderWidth, mRenderHeight, mRenderUVScale);
+
 	CheckReturn(mpLogFile, mpImGuiManager->InitializeD3D12(mDevice.get(), mDescriptorHeap.get()));
 	mpImGuiManager->HookMsgCallback(mpWindowsManager);
 
 	CheckReturn(mpLogFile, mAccelerationStructureManager->Initialize(mpLogFile, mDevice.get(), mCommandObject.get()));
 
+	mFrustumCuller->Initialize(mProcessor->SupportAVX2, static_cast<UINT>(mProcessor->Logical));
+	mLightClusterer->Initialize(mProcessor->SupportAVX2, static_cast<UINT>(mProcessor->Logical));
+	mOcclusionCuller->Initialize(mProcessor->SupportAVX2, OcclusionBufferWidth, OcclusionBufferHeight);
+
 	mSceneBounds.Center = XMFLOAT3(0.f, 0.f, 0.f);
 	const FLOAT WidthSquared = 128.f * 128.f;
 	mSceneBounds.Radius = sqrtf(WidthSquared + WidthSquared);
@@ -152,6 +319,20 @@ void DxRenderer::CleanUp() {
 
 	mCommandObject->FlushCommandQueue();
 
+	// Copies still in flight write into the buffers released below.
+	if (mUploadQueue) {
+		mUploadQueue->CleanUp();
+		mUploadQueue.reset();
+	}
+
+	if (mTextureStreamer) {
+		mTextureStreamer->CleanUp();
+		mTextureStreamer.reset();
+	}
+	mStreamedTextures.clear();
+	mStreamedMapRefs.clear();
+	mMaterialStreamedTextures.clear();
+
 	if (mAccelerationStructureManager) {
 		mAccelerationStructureManager->CleanUp();
 		mAccelerationStructureManager.reset();
@@ -161,8 +342,24 @@ void DxRenderer::CleanUp() {
 	mRenderItemRefs.clear();
 	mRenderItems.clear();
 
+	if (mFrustumCuller) mFrustumCuller.reset();
+	if (mDrawBatcher) mDrawBatcher.reset();
+	mBatchedItems.clear();
+
+	if (mLightClusterer) mLightClusterer.reset();
+	mClusteredLights.clear();
+
+	if (mOcclusionCuller) mOcclusionCuller.reset();
+	mOccluders.clear();
+
+	if (mDynamicResolution) mDynamicResolution.reset();
+
+	mSubmeshIds.clear();
+	mMaterialRefs.clear();
+	mMeshGeometryRefs.clear();
 	mMeshGeometries.clear();
 	mMaterials.clear();
+	mTextures.clear();
 
 	for (UINT i = 0; i < Foundation::Resource::FrameResource::Count; ++i) {
 		auto& resource = mFrameResources[i];
@@ -172,6 +369,11 @@ void DxRenderer::CleanUp() {
 		}
 	}
 
+	// Transients placed by the graph belong to shading objects.
+	if (mRenderGraph) {
+		mRenderGraph->CleanUp();
+		mRenderGraph.reset();
+	}
 	if (mShaderManager) {
 		mShaderManager->CleanUp();
 		mShaderManager.reset();
@@ -180,6 +382,13 @@ void DxRenderer::CleanUp() {
 		mShadingObjectManager->CleanUp();
 		mShadingObjectManager.reset();
 	}
+	if (mPipelineStateCache) {
+		// Catches pipelines created after initialization.
+		mPipelineStateCache->Serialize();
+		if (mDevice) mDevice->SetPipelineStateCache(nullptr);
+		mPipelineStateCache->CleanUp();
+		mPipelineStateCache.reset();
+	}
 
 	DxLowRenderer::CleanUp();
 }
@@ -187,8 +396,20 @@ void DxRenderer::CleanUp() {
 BOOL DxRenderer::OnResize(UINT width, UINT height) {
 	CheckReturn(mpLogFile, DxLowRenderer::OnResize(width, height));
 
+	// Targets are only reallocated here; the render area moves within them.
 	CheckReturn(mpLogFile, mShadingObjectManager->OnResize(width, height));
 
+	if (mpShadingArgumentSet->DynamicResolution.Enabled) {
+		SetRenderResolution(
+			mDynamicResolution->ScaledWidth(width),
+			mDynamicResolution->ScaledHeight(height));
+	}
+	else {
+		SetRenderResolution(width, height);
+	}
+
+	mShadingObjectManager->SetRenderArea(mRenderWidth, mRenderHeight, mRenderUVScale);
+
 #ifdef _DEBUG
 	std::cout << std::format("DxRenderer resized (Width: {}, Height: {}", width, height) << std::endl;
 #endif
@@ -197,15 +418,27 @@ BOOL DxRenderer::OnResize(UINT width, UINT height) {
 }
 
 BOOL DxRenderer::Update(FLOAT deltaTime) {
+	CheckReturn(mpLogFile, UpdateRenderResolution(deltaTime));
+
 	mCurrentFrameResourceIndex = (mCurrentFrameResourceIndex + 1) % Foundation::Resource::FrameResource::Count;
 	mpCurrentFrameResource = mFrameResources[mCurrentFrameResourceIndex].get();
 	CheckReturn(mpLogFile, mCommandObject->WaitCompletion(mpCurrentFrameResource->mFence));	
 	CheckReturn(mpLogFile, mpCurrentFrameResource->ResetCommandListAllocators());
 
+	mDescriptorHeap->ReleaseTextureSlots(mpCurrentFrameResource->mFence);
+	mDescriptorHeap->BeginFrame(mCurrentFrameResourceIndex);
+	mTextureStreamer->ReleaseRetired(mpCurrentFrameResource->mFence);
+
+	CheckReturn(mpLogFile, ResolvePendingUploads());
+	CheckReturn(mpLogFile, SwapStreamedTextures());
+
 	CheckReturn(mpLogFile, UpdateConstantBuffers());
 	CheckReturn(mpLogFile, ResolvePendingLights());
 
 	CheckReturn(mpLogFile, PopulateRendableItems());
+	CheckReturn(mpLogFile, PopulateShadowCasters());
+	CheckReturn(mpLogFile, BuildDrawBatches());
+	CheckReturn(mpLogFile, StreamTextures());
 
 	if (mbRaytracingSupported) {
 		const auto& rendableOpaques = mRendableItems[Common::Foundation::Mesh::RenderType::E_Opaque];
@@ -224,6 +457,8 @@ BOOL DxRenderer::Update(FLOAT deltaTime) {
 		mpShadingArgumentSet->RTAO.CheckerboardGenerateRaysForEvenPixels = !mpShadingArgumentSet->RTAO.CheckerboardGenerateRaysForEvenPixels;
 	}
 
+	mpShadingArgumentSet->SSAO.CheckerboardSampleEvenPixels = !mpShadingArgumentSet->SSAO.CheckerboardSampleEvenPixels;
+
 	CheckReturn(mpLogFile, mShadingObjectManager->Update());
 
 	mDeltaTime = deltaTime;
@@ -238,183 +473,28 @@ BOOL DxRenderer::Draw() {
 		CheckReturn(mpLogFile, BuildScene());
 	}
 
-	const auto& opaques = mRenderItemGroups[Common::Foundation::Mesh::RenderType::E_Opaque];
-
-	const auto gbuffer = mShadingObjectManager->Get<Shading::GBuffer::GBufferClass>();
-	const auto tone = mShadingObjectManager->Get<Shading::ToneMapping::ToneMappingClass>();
-	CheckReturn(mpLogFile, gbuffer->DrawGBuffer(
-		mpCurrentFrameResource,
-		mSwapChain->ScreenViewport(), 
-		mSwapChain->ScissorRect(),
-		tone->InterMediateMapResource(), 
-		tone->InterMediateMapRtv(),
-		mDepthStencilBuffer->GetDepthStencilBuffer(), 
-		mDepthStencilBuffer->DepthStencilBufferDsv(),
-		mRendableItems[Common::Foundation::Mesh::RenderType::E_Opaque],
-		0.4f, 0.1f));
-
-	CheckReturn(mpLogFile, DrawShadow());
-
-	if (mpShadingArgumentSet->SSCS.Enabled) 
-		CheckReturn(mpLogFile, ApplyContactShadow());
-
-	const auto svgf = mShadingObjectManager->Get<Shading::SVGF::SVGFClass>();
-	CheckReturn(mpLogFile, svgf->CalculateDepthParticalDerivative(
-		mpCurrentFrameResource,
-		mDepthStencilBuffer->GetDepthStencilBuffer(),
-		mDepthStencilBuffer->DepthStencilBufferSrv()));
-
-	if (mpShadingArgumentSet->AOEnabled)
-		CheckReturn(mpLogFile, DrawAO());
-
-	const auto brdf = mShadingObjectManager->Get<Shading::BRDF::BRDFClass>();
-	const auto shadow = mShadingObjectManager->Get<Shading::Shadow::ShadowClass>();
-	const auto rayShadow = mShadingObjectManager->Get<Shading::RaytracedShadow::RaytracedShadowClass>();
-	CheckReturn(mpLogFile, brdf->ComputeBRDF(
-		mpCurrentFrameResource,
-		mSwapChain->ScreenViewport(),
-		mSwapChain->ScissorRect(),
-		tone->InterMediateMapResource(),
-		tone->InterMediateMapRtv(),
-		gbuffer->AlbedoMap(),
-		gbuffer->AlbedoMapSrv(),
-		gbuffer->NormalMap(),
-		gbuffer->NormalMapSrv(),
-		mDepthStencilBuffer->GetDepthStencilBuffer(),
-		mDepthStencilBuffer->DepthStencilBufferSrv(),
-		gbuffer->SpecularMap(),
-		gbuffer->SpecularMapSrv(),
-		gbuffer->RoughnessMetalnessMap(),
-		gbuffer->RoughnessMetalnessMapSrv(),
-		gbuffer->PositionMap(),
-		gbuffer->PositionMapSrv(),
-		mpShadingArgumentSet->RaytracingEnabled ?
-			rayShadow->ShadowMap() : shadow->ShadowMap(),
-		mpShadingArgumentSet->RaytracingEnabled ?
-			rayShadow->ShadowMapSrv() : shadow->ShadowMapSrv(),
-		mpShadingArgumentSet->ShadowEnabled));
-
-	CheckReturn(mpLogFile, IntegrateIrradiance());
-
-	const auto env = mShadingObjectManager->Get<Shading::EnvironmentMap::EnvironmentMapClass>();
-	CheckReturn(mpLogFile, env->DrawSkySphere(
-		mpCurrentFrameResource,
-		mSwapChain->ScreenViewport(),
-		mSwapChain->ScissorRect(),
-		tone->InterMediateMapResource(),
-		tone->InterMediateMapRtv(),
-		mDepthStencilBuffer->GetDepthStencilBuffer(), 
-		mDepthStencilBuffer->DepthStencilBufferDsv(),
-		mSkySphere.get()));
-
-	CheckReturn(mpLogFile, ApplyVolumetricLight());
-
-	if (mpShadingArgumentSet->Bloom.Enabled)
-		CheckReturn(mpLogFile, ApplyBloom());
-
-	CheckReturn(mpLogFile, ApplyEyeAdaption());
-
-	if (mpShadingArgumentSet->ChromaticAberration.Enabled) {
-		const auto chromatic = mShadingObjectManager->Get<Shading::ChromaticAberration::ChromaticAberrationClass>();
-		CheckReturn(mpLogFile, chromatic->ApplyChromaticAberration(
-			mpCurrentFrameResource,
-			mSwapChain->ScreenViewport(),
-			mSwapChain->ScissorRect(),
-			tone->InterMediateMapResource(),
-			tone->InterMediateMapRtv(),
-			tone->InterMediateCopyMapResource(),
-			tone->InterMediateCopyMapSrv(),
-			mpShadingArgumentSet->ChromaticAberration.Strength,
-			mpShadingArgumentSet->ChromaticAberration.Threshold,
-			mpShadingArgumentSet->ChromaticAberration.Feather,
-			mpShadingArgumentSet->ChromaticAberration.ShiftPx,
-			mpShadingArgumentSet->ChromaticAberration.Exponent));
-	}
-
-	if (mpShadingArgumentSet->DOF.Enabled)
-		CheckReturn(mpLogFile, ApplyDOF());
-
-	if (mpShadingArgumentSet->TAA.Enabled) {
-		const auto taa = mShadingObjectManager->Get<Shading::TAA::TAAClass>();
-		CheckReturn(mpLogFile, taa->ApplyTAA(
-			mpCurrentFrameResource,
-			mSwapChain->ScreenViewport(),
-			mSwapChain->ScissorRect(),
-			tone->InterMediateMapResource(),
-			tone->InterMediateMapRtv(),
-			tone->InterMediateCopyMapResource(),
-			tone->InterMediateCopyMapSrv(),
-			gbuffer->VelocityMap(),
-			gbuffer->VelocityMapSrv(),
-			mpShadingArgumentSet->TAA.ModulationFactor));
-	}
-
-	const auto eye = mShadingObjectManager->Get<Shading::EyeAdaption::EyeAdaptionClass>();
-	CheckReturn(mpLogFile, tone->Resolve(
-		mpCurrentFrameResource,
-		mSwapChain->ScreenViewport(),
-		mSwapChain->ScissorRect(),
-		mSwapChain->BackBuffer(),
-		mSwapChain->BackBufferRtv(),
-		eye->Luminance(),
-		mpShadingArgumentSet->ToneMapping.Exposure,
-		mpShadingArgumentSet->ToneMapping.MiddleGrayKey,
-		mpShadingArgumentSet->ToneMapping.TonemapperType));
-	
-	if (mpShadingArgumentSet->GammaCorrection.Enabled) {
-		const auto gamma = mShadingObjectManager->Get<Shading::GammaCorrection::GammaCorrectionClass>();
-		CheckReturn(mpLogFile, gamma->ApplyCorrection(
-			mpCurrentFrameResource,
-			mSwapChain->ScreenViewport(),
-			mSwapChain->ScissorRect(),
-			mSwapChain->BackBuffer(),
-			mSwapChain->BackBufferRtv(),
-			mSwapChain->BackBufferCopy(),
-			mSwapChain->BackBufferCopySrv(),
-			mpShadingArgumentSet->GammaCorrection.Gamma));
-	}
+	mRenderGraph->Reset();
 
-	if (mpShadingArgumentSet->MotionBlur.Enabled) {
-		const auto motion = mShadingObjectManager->Get<Shading::MotionBlur::MotionBlurClass>();
-		motion->ApplyMotionBlur(
-			mpCurrentFrameResource,
-			mSwapChain->ScreenViewport(),
-			mSwapChain->ScissorRect(),
-			mSwapChain->BackBuffer(),
-			mSwapChain->BackBufferRtv(),
-			mSwapChain->BackBufferCopy(),
-			mSwapChain->BackBufferCopySrv(),
-			mDepthStencilBuffer->GetDepthStencilBuffer(),
-			mDepthStencilBuffer->DepthStencilBufferSrv(),
-			gbuffer->VelocityMap(),
-			gbuffer->VelocityMapSrv(),
-			mpShadingArgumentSet->MotionBlur.Intensity,
-			mpShadingArgumentSet->MotionBlur.Limit,
-			mpShadingArgumentSet->MotionBlur.DepthBias,
-			mpShadingArgumentSet->MotionBlur.SampleCount);
-	}
+	CheckReturn(mpLogFile, BuildRenderGraph());
+	CheckReturn(mpLogFile, mRenderGraph->Compile());
+	CheckReturn(mpLogFile, mRenderGraph->Execute(
+		mpCurrentFrameResource->CommandAllocator(0),
+		mpCurrentFrameResource->ComputeCommandAllocator()));
 
-	CheckReturn(mpLogFile, DrawImGui());		
 	CheckReturn(mpLogFile, PresentAndSignal());
 
 	return TRUE;
 }
 
 BOOL DxRenderer::AddMesh(Common::Foundation::Mesh::Mesh* const pMesh, Common::Foundation::Mesh::Transform* const pTransform, Common::Foundation::Hash& hash) {
-	CheckReturn(mpLogFile, mCommandObject->ResetCommandList(
-		mpCurrentFrameResource->CommandAllocator(0),
-		0));
-
-	const auto CmdList = mCommandObject->CommandList(0);
-
 	{
+		// Render items are added right away but stay hidden until the
+		// geometry and material maps have landed; see ResolvePendingUploads.
 		Foundation::Resource::MeshGeometry* meshGeo;
-		CheckReturn(mpLogFile, BuildMeshGeometry(CmdList, pMesh, meshGeo));
-
-		if (mbRaytracingSupported)
-			CheckReturn(mpLogFile, mAccelerationStructureManager->BuildBLAS(CmdList, meshGeo));
+		CheckReturn(mpLogFile, BuildMeshGeometry(pMesh, meshGeo));
 
-		mbMeshGeometryAdded = TRUE;
+		if (mRenderItems.size() + meshGeo->Subsets.size() > MaxObjectCount)
+			ReturnFalse(mpLogFile, L"Out of object constants; raise MaxObjectCount");
 
 		UINT count = 0;
 
@@ -428,6 +508,12 @@ BOOL DxRenderer::AddMesh(Common::Foundation::Mesh::Mesh* const pMesh, Common::Fo
 			ritem->IndexCount = meshGeo->Subsets[subset.first].IndexCount;
 			ritem->StartIndexLocation = meshGeo->Subsets[subset.first].StartIndexLocation;
 			ritem->BaseVertexLocation = meshGeo->Subsets[subset.first].BaseVertexLocation;
+			ritem->Bounds = meshGeo->Subsets[subset.first].Bounds;
+			{
+				const auto SubmeshHash = Common::Util::HashUtil::HashCombine(
+					Foundation::Resource::MeshGeometry::Hash(meshGeo), std::hash<std::string>()(subset.first));
+				ritem->SubmeshId = mSubmeshIds.emplace(SubmeshHash, static_cast<UINT>(mSubmeshIds.size())).first->second;
+			}
 			XMStoreFloat4x4(
 				&ritem->World,
 				XMMatrixAffineTransformation(
@@ -440,15 +526,24 @@ BOOL DxRenderer::AddMesh(Common::Foundation::Mesh::Mesh* const pMesh, Common::Fo
 			
 			auto material = pMesh->GetMaterial(count++);
 
-			CheckReturn(mpLogFile, BuildMeshMaterial(CmdList, &material, ritem->Material));
+			CheckReturn(mpLogFile, BuildMeshMaterial(&material, ritem->Material));
+
+			ritem->CullingIndex = mFrustumCuller->AddBox(
+				Common::Util::FrustumCuller::TransformBox(ritem->Bounds, ritem->World));
+			++mShadowBoundsVersion;
 
 			mRenderItemGroups[Common::Foundation::Mesh::RenderType::E_Opaque].push_back(ritem.get());
 			mRenderItemRefs[hash] = ritem.get();
+			mUploadingRenderItems.push_back(ritem.get());
 			mRenderItems.push_back(std::move(ritem));
 		}
-	}
 
-	CheckReturn(mpLogFile, mCommandObject->ExecuteCommandList(0));
+		// Taken after the material maps were recorded, so items of a shared
+		// geometry that has already landed still wait for new textures.
+		const UINT64 UploadFence = mUploadQueue->LastFence();
+		for (auto iter = mUploadingRenderItems.end() - count; iter != mUploadingRenderItems.end(); ++iter)
+			(*iter)->UploadFence = UploadFence;
+	}
 
 	return TRUE;
 }
@@ -471,6 +566,11 @@ BOOL DxRenderer::UpdateMeshTransform(Common::Foundation::Hash hash, Common::Foun
 	ritem->NumFramesDirty = Foundation::Resource::FrameResource::Count << 1;
 	ritem->RebuildAccerationStructure = TRUE;
 
+	mFrustumCuller->UpdateBox(
+		ritem->CullingIndex, 
+		Common::Util::FrustumCuller::TransformBox(ritem->Bounds, ritem->World));
+	mMovedCullingIndices.push_back(ritem->CullingIndex);
+
 	return TRUE;
 }
 
@@ -483,7 +583,11 @@ BOOL DxRenderer::CreateDescriptorHeaps() {
 	UINT rtvCount = mShadingObjectManager->RtvDescCount();
 	UINT dsvCount = mShadingObjectManager->DsvDescCount();
 
-	CheckReturn(mpLogFile, mDescriptorHeap->CreateDescriptorHeaps(cbvSrvUavCount, rtvCount, dsvCount));
+	CheckReturn(mpLogFile, mDescriptorHeap->CreateDescriptorHeaps(
+		cbvSrvUavCount, rtvCount, dsvCount,
+		ShadingConvention::GBuffer::MaxNumTextures,
+		TransientDescriptorCount,
+		Foundation::Resource::FrameResource::Count));
 
 	return TRUE;
 }
@@ -492,10 +596,13 @@ BOOL DxRenderer::UpdateConstantBuffers() {
 	if (mpCamera == nullptr) return TRUE;
 
 	CheckReturn(mpLogFile, UpdateMainPassCB());
+	CheckReturn(mpLogFile, UpdateShadowPages());
 	CheckReturn(mpLogFile, UpdateLightCB());
+	CheckReturn(mpLogFile, UpdateLightClusters());
 	CheckReturn(mpLogFile, UpdateObjectCB());
 	CheckReturn(mpLogFile, UpdateMaterialCB());
 	CheckReturn(mpLogFile, UpdateProjectToCubeCB());
+	CheckReturn(mpLogFile, UpdateIrradianceSHCB());
 	CheckReturn(mpLogFile, UpdateAmbientOcclusionCB());
 	CheckReturn(mpLogFile, UpdateRayGenCB());
 	CheckReturn(mpLogFile, UpdateRaySortingCB());
@@ -510,7 +617,8 @@ BOOL DxRenderer::UpdateConstantBuffers() {
 
 BOOL DxRenderer::UpdateMainPassCB() {
 	static ConstantBuffers::PassCB passCB{
-		.ViewProj = Common::Util::MathUtil::Identity4x4()
+		.ViewProj = Common::Util::MathUtil::Identity4x4(),
+		.UVScale = { 1.f, 1.f }
 	};
 
 	// Transform NDC space [-1 , +1]^2 to texture space [0, 1]^2
@@ -551,12 +659,57 @@ BOOL DxRenderer::UpdateMainPassCB() {
 	else {
 		passCB.JitteredOffset = { 0.f, 0.f };
 	}
+
+	passCB.PrevUVScale = passCB.UVScale;
+	passCB.UVScale = mRenderUVScale;
 	
 	mpCurrentFrameResource->MainPassCB.CopyCB(passCB);
 
 	return TRUE;
 }
 
+BOOL DxRenderer::UpdateShadowPages() {
+	const auto shadow = mShadingObjectManager->Get<Shading::Shadow::ShadowClass>();
+
+	const XMVECTOR EyePos = mpCamera->Position();
+	const FLOAT ProjScale = mpCamera->Proj()._22;
+	const UINT MaxPageSize = shadow->MaxPageSize();
+
+	for (UINT i = 0, end = shadow->LightCount(); i < end; ++i) {
+		const auto light = shadow->Light(i);
+
+		// Fraction of the view height the light's range spans; directional
+		// lights cover the whole view.
+		FLOAT coverage = 1.f;
+
+		if (light->Type == Common::Foundation::LightType::E_Point 
+				|| light->Type == Common::Foundation::LightType::E_Spot
+				|| light->Type == Common::Foundation::LightType::E_Tube) {
+			XMVECTOR center = XMLoadFloat3(&light->Position);
+			FLOAT radius = light->AttenuationRadius;
+
+			if (light->Type == Common::Foundation::LightType::E_Tube) {
+				const XMVECTOR End = XMLoadFloat3(&light->Position1);
+				radius += XMVectorGetX(XMVector3Length(End - center)) * 0.5f;
+				center = (center + End) * 0.5f;
+			}
+
+			const FLOAT Dist = XMVectorGetX(XMVector3Length(center - EyePos));
+			if (radius > 0.f && Dist > radius) coverage = std::min(radius * ProjScale / Dist, 1.f);
+		}
+
+		const UINT Wanted = std::max(static_cast<UINT>(coverage * MaxPageSize), 1u);
+		const UINT Current = shadow->PageSize(i);
+
+		// Pages grow at once but shrink only to a quarter, so a light near
+		// a size boundary does not flip between sizes and redraws.
+		if (Wanted > Current || Wanted * 4 <= Current)
+			CheckReturn(mpLogFile, shadow->ResizePages(i, Wanted));
+	}
+
+	return TRUE;
+}
+
 BOOL DxRenderer::UpdateLightCB() {
 	static ConstantBuffers::LightCB ligthCB{};
 
@@ -564,6 +717,9 @@ BOOL DxRenderer::UpdateLightCB() {
 	const auto LightCount = shadow->LightCount();
 
 	ligthCB.LightCount = LightCount;
+	ligthCB.ClusteredLightCount = static_cast<UINT>(mClusteredLights.size());
+	Common::Util::LightClusterer::DepthSliceParams(
+		ClusterGrid(mpCamera), ligthCB.ClusterDepthScale, ligthCB.ClusterDepthBias);
 
 	const XMMATRIX T(
 		0.5f,  0.f, 0.f, 0.f,
@@ -572,35 +728,46 @@ BOOL DxRenderer::UpdateLightCB() {
 		0.5f, 0.5f, 0.f, 1.f
 	);
 
+	// Cascade slices of the camera frustum, shared by every directional light.
+	std::array<BoundingSphere, ShadingConvention::Shadow::CascadeCount> cascadeSlices;
+	{
+		const auto CameraView = mpCamera->View();
+		const auto CameraProj = mpCamera->Proj();
+
+		const XMMATRIX View = XMLoadFloat4x4(&CameraView);
+		const XMMATRIX InvView = XMMatrixInverse(&XMMatrixDeterminant(View), View);
+
+		const FLOAT NearZ = mpCamera->NearZ();
+		const FLOAT FarZ = std::min(mpCamera->FarZ(), MaxShadowDistance);
+
+		std::array<FLOAT, ShadingConvention::Shadow::CascadeCount> splits;
+		Common::Util::ShadowCascade::ComputeSplits(
+			NearZ, FarZ, CascadeSplitLambda, ShadingConvention::Shadow::CascadeCount, splits.data());
+
+		FLOAT sliceNear = NearZ;
+		for (UINT cascade = 0; cascade < ShadingConvention::Shadow::CascadeCount; ++cascade) {
+			const auto SliceV = Common::Util::ShadowCascade::FitSliceSphere(CameraProj, sliceNear, splits[cascade]);
+			SliceV.Transform(cascadeSlices[cascade], InvView);
+
+			sliceNear = splits[cascade];
+		}
+	}
+
 	for (UINT i = 0; i < LightCount; ++i) {
 		const auto light = shadow->Light(i);
 
 		if (light->Type == Common::Foundation::LightType::E_Directional) {
 			const XMVECTOR lightDir = XMLoadFloat3(&light->Direction);
 			const XMVECTOR lightPos = -2.f * mSceneBounds.Radius * lightDir;
-			const XMVECTOR targetPos = XMLoadFloat3(&mSceneBounds.Center);
-			const XMVECTOR lightUp = UnitVector::UpVector;
-			const XMMATRIX lightView = XMMatrixLookAtLH(lightPos, targetPos, lightUp);
 
-			// Transform bounding sphere to light space.
-			XMFLOAT3 sphereCenterLS;
-			XMStoreFloat3(&sphereCenterLS, XMVector3TransformCoord(targetPos, lightView));
+			XMFLOAT4X4* const CascadeMats[ShadingConvention::Shadow::CascadeCount] = { 
+				&light->Mat0, &light->Mat1, &light->Mat2 };
 
-			// Ortho frustum in light space encloses scene.
-			const FLOAT l = sphereCenterLS.x - mSceneBounds.Radius;
-			const FLOAT b = sphereCenterLS.y - mSceneBounds.Radius;
-			const FLOAT n = sphereCenterLS.z - mSceneBounds.Radius;
-			const FLOAT r = sphereCenterLS.x + mSceneBounds.Radius;
-			const FLOAT t = sphereCenterLS.y + mSceneBounds.Radius;
-			const FLOAT f = sphereCenterLS.z + mSceneBounds.Radius;
-
-			const XMMATRIX lightProj = XMMatrixOrthographicOffCenterLH(l, r, b, t, n, f);
-
-			const XMMATRIX viewProj = XMMatrixMultiply(lightView, lightProj);
-			XMStoreFloat4x4(&light->Mat0, XMMatrixTranspose(viewProj));
-
-			const XMMATRIX S = lightView * lightProj * T;
-			XMStoreFloat4x4(&light->Mat1, XMMatrixTranspose(S));
+			for (UINT cascade = 0; cascade < ShadingConvention::Shadow::CascadeCount; ++cascade) {
+				const auto ViewProj = Common::Util::ShadowCascade::FitCascade(
+					cascadeSlices[cascade], light->Direction, mSceneBounds, shadow->PageSize(i));
+				XMStoreFloat4x4(CascadeMats[cascade], XMMatrixTranspose(XMLoadFloat4x4(&ViewProj)));
+			}
 
 			XMStoreFloat3(&light->Position, lightPos);
 		}
@@ -698,13 +865,53 @@ BOOL DxRenderer::UpdateLightCB() {
 		}
 
 		ligthCB.Lights[i] = *light;
-		mpCurrentFrameResource->LightCB.CopyCB(ligthCB);
+		for (UINT face = 0; face < ShadingConvention::Shadow::MaxFaceCount; ++face)
+			ligthCB.ShadowPages[i * ShadingConvention::Shadow::MaxFaceCount + face] = shadow->PageScaleOffset(i, face);
 	}
 
+	mpCurrentFrameResource->LightCB.CopyCB(ligthCB);
+
+	return TRUE;
+}
+
+BOOL DxRenderer::UpdateLightClusters() {
+	const UINT LightCount = static_cast<UINT>(mClusteredLights.size());
+	if (LightCount == 0) return TRUE;
+
+	// Lights may be edited at any time, so the bounds are gathered anew.
+	mLightClusterer->Clear();
+	for (UINT i = 0; i < LightCount; ++i) {
+		const auto& light = mClusteredLights[i];
+
+		mLightClusterer->AddLight(ClusteredLightBounds(light.get()));
+		mpCurrentFrameResource->ClusteredLights.CopyCB(*light, i);
+	}
+
+	mLightClusterer->Build(ClusterGrid(mpCamera), mpCamera->View(), mpCamera->Proj());
+
+	const auto& clusters = mLightClusterer->Clusters();
+	const auto& indices = mLightClusterer->LightIndices();
+
+	// Lists running past the end of the index buffer are cut short.
+	const UINT MaxIndexCount = ShadingConvention::LightCluster::MaxLightIndexCount;
+
+	for (UINT c = 0, end = mLightClusterer->ClusterCount(); c < end; ++c) {
+		ShadingConvention::LightCluster::Cluster cluster;
+		cluster.Offset = std::min(clusters[c].Offset, MaxIndexCount);
+		cluster.Count = std::min(clusters[c].Count, MaxIndexCount - cluster.Offset);
+
+		mpCurrentFrameResource->LightClusters.CopyCB(cluster, c);
+	}
+
+	for (UINT i = 0, end = std::min(static_cast<UINT>(indices.size()), MaxIndexCount); i < end; ++i)
+		mpCurrentFrameResource->ClusterLightIndices.CopyCB(indices[i], i);
+
 	return TRUE;
 }
 
 BOOL DxRenderer::UpdateObjectCB() {
+	const auto gbuffer = mShadingObjectManager->Get<Shading::GBuffer::GBufferClass>();
+
 	for (auto& ritem : mRenderItems) {
 		// Only update the cbuffer data if the constants have changed.  
 		// This needs to be tracked per frame resource.
@@ -721,6 +928,23 @@ BOOL DxRenderer::UpdateObjectCB() {
 
 			mpCurrentFrameResource->ObjectCB.CopyCB(objCB, ritem->ObjectCBIndex);
 
+			// Records of the GPU-driven path; items whose geometry is still
+			// uploading are written as not drawable and get dirtied again
+			// once it lands.
+			const auto WorldBounds = Common::Util::FrustumCuller::TransformBox(ritem->Bounds, ritem->World);
+
+			ShadingConvention::GpuCulling::InstanceBounds bounds;
+			bounds.Center = WorldBounds.Center;
+			bounds.Extents = WorldBounds.Extents;
+			bounds.Drawable = ritem->UploadFence == 0 && mpCurrentFrameResource->mFence >= ritem->Geometry->Fence;
+
+			mpCurrentFrameResource->InstanceBounds.CopyCB(bounds, ritem->ObjectCBIndex);
+
+			ShadingConvention::GBuffer::IndirectCommand command;
+			gbuffer->BuildIndirectCommand(mpCurrentFrameResource, ritem.get(), command);
+
+			mpCurrentFrameResource->IndirectCommands.CopyCB(command, ritem->ObjectCBIndex);
+
 			// Next FrameResource need to be updated too.
 			--ritem->NumFramesDirty;
 		}
@@ -824,6 +1048,18 @@ BOOL DxRenderer::UpdateProjectToCubeCB() {
 	return TRUE;
 }
 
+BOOL DxRenderer::UpdateIrradianceSHCB() {
+	const auto env = mShadingObjectManager->Get<Shading::EnvironmentMap::EnvironmentMapClass>();
+	const auto& sh = env->IrradianceSH();
+
+	ConstantBuffers::IrradianceSHCB irradSHCB{};
+	std::memcpy(irradSHCB.Coeffs, sh.Coeffs, sizeof(irradSHCB.Coeffs));
+
+	mpCurrentFrameResource->IrradianceSHCB.CopyCB(irradSHCB);
+
+	return TRUE;
+}
+
 BOOL DxRenderer::UpdateAmbientOcclusionCB() {
 	const auto ssao = mShadingObjectManager->Get<Shading::SSAO::SSAOClass>();
 
@@ -838,33 +1074,38 @@ BOOL DxRenderer::UpdateAmbientOcclusionCB() {
 	XMStoreFloat4x4(&aoCB.InvProj, XMMatrixTranspose(invProj));
 
 	const XMMATRIX P = XMLoadFloat4x4(&mpCamera->Proj());
-	// Transform NDC space [-1,+1]^2 to texture space [0,1]^2
+	// Transform NDC space [-1,+1]^2 to texture space [0,1]^2, scaled onto
+	// the area rendered into
+	const FLOAT ScaleX = 0.5f * mRenderUVScale.x;
+	const FLOAT ScaleY = 0.5f * mRenderUVScale.y;
 	const XMMATRIX T(
-		0.5f, 0.f, 0.f, 0.f,
-		0.f, -0.5f, 0.f, 0.f,
+		ScaleX, 0.f, 0.f, 0.f,
+		0.f, -ScaleY, 0.f, 0.f,
 		0.f, 0.f, 1.f, 0.f,
-		0.5f, 0.5f, 0.f, 1.f
+		ScaleX, ScaleY, 0.f, 1.f
 	);
 	XMStoreFloat4x4(&aoCB.ProjTex, XMMatrixTranspose(P * T));
 
 	ssao->GetOffsetVectors(aoCB.OffsetVectors);
 
 	if (mpShadingArgumentSet->RaytracingEnabled) {
-		const BOOL CheckboardRayGeneration = mpShadingArgumentSet->RTAO.CheckboardRayGeneration;
-		const UINT PixelStepX = CheckboardRayGeneration ? 2 : 1;
+		const auto ResolutionType = static_cast<Common::Render::EffectResolution>(mpShadingArgumentSet->RTAO.ResolutionType);
 
-		aoCB.TextureDim = { Foundation::Util::D3D12Util::CeilDivide(mClientWidth, PixelStepX), mClientHeight };
+		aoCB.TextureDim = Common::Util::EffectResolutionUtil::EvaluatedDim(ResolutionType, mRenderWidth, mRenderHeight);
 
 		aoCB.OcclusionRadius = mpShadingArgumentSet->RTAO.OcclusionRadius;
 		aoCB.OcclusionFadeStart = mpShadingArgumentSet->RTAO.OcclusionFadeStart;
 		aoCB.OcclusionFadeEnd = mpShadingArgumentSet->RTAO.OcclusionFadeEnd;
 		aoCB.SurfaceEpsilon = mpShadingArgumentSet->RTAO.SurfaceEpsilon;
 		aoCB.SampleCount = mpShadingArgumentSet->RTAO.SampleCount;
-		aoCB.CheckerboardRayGenEnabled = CheckboardRayGeneration;
+		aoCB.CheckerboardRayGenEnabled = ResolutionType == Common::Render::EffectResolution::E_Checkerboard;
 		aoCB.EvenPixelsActivated = mpShadingArgumentSet->RTAO.CheckerboardGenerateRaysForEvenPixels;
+		aoCB.HalfResolutionEnabled = ResolutionType == Common::Render::EffectResolution::E_HalfResolution;
 	}
 	else {
-		aoCB.TextureDim = { mClientWidth, mClientHeight };
+		const auto ResolutionType = static_cast<Common::Render::EffectResolution>(mpShadingArgumentSet->SSAO.ResolutionType);
+
+		aoCB.TextureDim = Common::Util::EffectResolutionUtil::EvaluatedDim(ResolutionType, mRenderWidth, mRenderHeight);
 
 		aoCB.OcclusionRadius = mpShadingArgumentSet->SSAO.OcclusionRadius;
 		aoCB.OcclusionFadeStart = mpShadingArgumentSet->SSAO.OcclusionFadeStart;
@@ -872,8 +1113,9 @@ BOOL DxRenderer::UpdateAmbientOcclusionCB() {
 		aoCB.OcclusionStrength = mpShadingArgumentSet->SSAO.OcclusionStrength;
 		aoCB.SurfaceEpsilon = mpShadingArgumentSet->SSAO.SurfaceEpsilon;
 		aoCB.SampleCount = mpShadingArgumentSet->SSAO.SampleCount;
-		aoCB.CheckerboardRayGenEnabled = FALSE;
-		aoCB.EvenPixelsActivated = FALSE;
+		aoCB.CheckerboardRayGenEnabled = ResolutionType == Common::Render::EffectResolution::E_Checkerboard;
+		aoCB.EvenPixelsActivated = mpShadingArgumentSet->SSAO.CheckerboardSampleEvenPixels;
+		aoCB.HalfResolutionEnabled = ResolutionType == Common::Render::EffectResolution::E_HalfResolution;
 	}
 
 	aoCB.FrameCount = static_cast<UINT>(mpCurrentFrameResource->mFence);
@@ -888,15 +1130,15 @@ BOOL DxRenderer::UpdateRayGenCB() {
 
 	ConstantBuffers::RayGenCB rayGenCB;
 
-	const BOOL CheckboardRayGeneration = mpShadingArgumentSet->RTAO.CheckboardRayGeneration;
-	const UINT PixelStepX = CheckboardRayGeneration ? 2 : 1;
+	const auto ResolutionType = static_cast<Common::Render::EffectResolution>(mpShadingArgumentSet->RTAO.ResolutionType);
 
-	rayGenCB.TextureDim = { Foundation::Util::D3D12Util::CeilDivide(mClientWidth, PixelStepX), mClientHeight };
+	rayGenCB.TextureDim = Common::Util::EffectResolutionUtil::EvaluatedDim(ResolutionType, mRenderWidth, mRenderHeight);
 	rayGenCB.NumSamplesPerSet = raygen->NumSamples();
 	rayGenCB.NumSampleSets = raygen->NumSampleSets();
 	rayGenCB.NumPixelsPerDimPerSet = mpShadingArgumentSet->RTAO.SampleSetSize;
-	rayGenCB.CheckerboardRayGenEnabled = CheckboardRayGeneration;
+	rayGenCB.CheckerboardRayGenEnabled = ResolutionType == Common::Render::EffectResolution::E_Checkerboard;
 	rayGenCB.CheckerboardGenerateRaysForEvenPixels = mpShadingArgumentSet->RTAO.CheckerboardGenerateRaysForEvenPixels;
+	rayGenCB.HalfResolutionEnabled = ResolutionType == Common::Render::EffectResolution::E_HalfResolution;
 	rayGenCB.Seed = mpShadingArgumentSet->RTAO.RandomFrameSeed ? raygen->Seed() : 1879;
 
 	mpCurrentFrameResource->RayGenCB.CopyCB(rayGenCB);
@@ -907,13 +1149,12 @@ BOOL DxRenderer::UpdateRayGenCB() {
 BOOL DxRenderer::UpdateRaySortingCB() {
 	ConstantBuffers::RaySortingCB raySortingCB;
 
-	const BOOL CheckboardRayGeneration = mpShadingArgumentSet->RTAO.CheckboardRayGeneration;
-	const UINT PixelStepX = CheckboardRayGeneration ? 2 : 1;
+	const auto ResolutionType = static_cast<Common::Render::EffectResolution>(mpShadingArgumentSet->RTAO.ResolutionType);
 
-	raySortingCB.TextureDim = { Foundation::Util::D3D12Util::CeilDivide(mClientWidth, PixelStepX), mClientHeight };
+	raySortingCB.TextureDim = Common::Util::EffectResolutionUtil::EvaluatedDim(ResolutionType, mRenderWidth, mRenderHeight);
 	raySortingCB.BinDepthSize = mpShadingArgumentSet->RTAO.OcclusionRadius * mpShadingArgumentSet->RaySorting.DepthBinSizeMultiplier;
 	raySortingCB.UseOctahedralRayDirectionQuantization = TRUE;
-	raySortingCB.CheckerboardRayGenEnabled = CheckboardRayGeneration;
+	raySortingCB.CheckerboardRayGenEnabled = ResolutionType == Common::Render::EffectResolution::E_Checkerboard;
 	raySortingCB.CheckerboardGenerateRaysForEvenPixels = mpShadingArgumentSet->RTAO.CheckerboardGenerateRaysForEvenPixels;
 
 	mpCurrentFrameResource->RaySortingCB.CopyCB(raySortingCB);
@@ -924,15 +1165,18 @@ BOOL DxRenderer::UpdateRaySortingCB() {
 BOOL DxRenderer::UpdateCalcLocalMeanVarianceCB() {
 	ConstantBuffers::SVGF::CalcLocalMeanVarianceCB localMeanCB;
 
-	const BOOL CheckboardRayGeneration = mpShadingArgumentSet->RaytracingEnabled ?
-		mpShadingArgumentSet->RTAO.CheckboardRayGeneration : FALSE;
+	const BOOL CheckboardRayGeneration = (mpShadingArgumentSet->RaytracingEnabled ?
+		mpShadingArgumentSet->RTAO.ResolutionType :
+		mpShadingArgumentSet->SSAO.ResolutionType) == Common::Render::EffectResolution::E_Checkerboard;
 	const UINT PixelStepY = CheckboardRayGeneration ? 2 : 1;
 
-	localMeanCB.TextureDim = { mClientWidth, mClientHeight };
+	localMeanCB.TextureDim = { mRenderWidth, mRenderHeight };
 	localMeanCB.KernelWidth = 9;
 	localMeanCB.KernelRadius = 9 >> 1;
 	localMeanCB.CheckerboardSamplingEnabled = CheckboardRayGeneration;
-	localMeanCB.EvenPixelActivated = mpShadingArgumentSet->RTAO.CheckerboardGenerateRaysForEvenPixels;
+	localMeanCB.EvenPixelActivated = mpShadingArgumentSet->RaytracingEnabled ?
+		mpShadingArgumentSet->RTAO.CheckerboardGenerateRaysForEvenPixels :
+		mpShadingArgumentSet->SSAO.CheckerboardSampleEvenPixels;
 	localMeanCB.PixelStepY = PixelStepY;
 
 	mpCurrentFrameResource->CalcLocalMeanVarianceCB.CopyCB(localMeanCB);
@@ -954,10 +1198,12 @@ BOOL DxRenderer::UpdateBlendWithCurrentFrameCB() {
 
 	blendFrameCB.BlurStrengthMaxTspp = mpShadingArgumentSet->RTAO.BlendWithCurrentFrame.LowTSPPMaxTSPP;
 	blendFrameCB.BlurDecayStrength = mpShadingArgumentSet->RTAO.BlendWithCurrentFrame.LowTSPPDecayConstant;
-	blendFrameCB.CheckerboardEnabled = mpShadingArgumentSet->RaytracingEnabled ? 
-		mpShadingArgumentSet->RTAO.CheckboardRayGeneration : FALSE;
+	blendFrameCB.CheckerboardEnabled = (mpShadingArgumentSet->RaytracingEnabled ? 
+		mpShadingArgumentSet->RTAO.ResolutionType :
+		mpShadingArgumentSet->SSAO.ResolutionType) == Common::Render::EffectResolution::E_Checkerboard;
 	blendFrameCB.CheckerboardEvenPixelActivated = mpShadingArgumentSet->RaytracingEnabled ?
-		mpShadingArgumentSet->RTAO.CheckerboardGenerateRaysForEvenPixels : FALSE;
+		mpShadingArgumentSet->RTAO.CheckerboardGenerateRaysForEvenPixels :
+		mpShadingArgumentSet->SSAO.CheckerboardSampleEvenPixels;
 
 	mpCurrentFrameResource->BlendWithCurrentFrameCB.CopyCB(blendFrameCB);
 
@@ -978,7 +1224,7 @@ BOOL DxRenderer::UpdateCrossBilateralFilterCB() {
 BOOL DxRenderer::UpdateAtrousWaveletTransformFilterCB() {
 	ConstantBuffers::SVGF::AtrousWaveletTransformFilterCB filterCB;
 
-	filterCB.TextureDim = { mClientWidth, mClientHeight };
+	filterCB.TextureDim = { mRenderWidth, mRenderHeight };
 	filterCB.DepthWeightCutoff = mpShadingArgumentSet->RTAO.AtrousWaveletTransformFilter.DepthWeightCutoff;
 	filterCB.UsingBilateralDownsamplingBuffers = FALSE;
 
@@ -993,7 +1239,7 @@ BOOL DxRenderer::UpdateAtrousWaveletTransformFilterCB() {
 	filterCB.UseAdaptiveKernelSize = mpShadingArgumentSet->RTAO.AtrousWaveletTransformFilter.UseAdaptiveKernelSize;
 	filterCB.KernelRadiusLerfCoef = kernelRadiusLerfCoef;
 	filterCB.MinKernelWidth = mpShadingArgumentSet->RTAO.AtrousWaveletTransformFilter.FilterMinKernelWidth;
-	filterCB.MaxKernelWidth = static_cast<UINT>((mpShadingArgumentSet->RTAO.AtrousWaveletTransformFilter.FilterMaxKernelWidthPercentage / 100.f) * mClientWidth);
+	filterCB.MaxKernelWidth = static_cast<UINT>((mpShadingArgumentSet->RTAO.AtrousWaveletTransformFilter.FilterMaxKernelWidthPercentage / 100.f) * mRenderWidth);
 
 	filterCB.PerspectiveCorrectDepthInterpolation = mpShadingArgumentSet->RTAO.AtrousWaveletTransformFilter.PerspectiveCorrectDepthInterpolation;
 	filterCB.MinVarianceToDenoise = mpShadingArgumentSet->RTAO.AtrousWaveletTransformFilter.MinVarianceToDenoise;
@@ -1028,7 +1274,7 @@ BOOL DxRenderer::UpdateContactShadowCB() {
 	csCB.ThicknessFarScale = mpShadingArgumentSet->SSCS.ThicknessFarScale;
 	csCB.StepScaleFarDist = mpShadingArgumentSet->SSCS.ThicknessFarDist;
 
-	csCB.TextureDimX = mClientWidth;
+	csCB.TextureDimX = mRenderWidth;
 	csCB.MaxSteps = mpShadingArgumentSet->SSCS.Steps;
 	csCB.FrameCount = frame++;
 
@@ -1037,12 +1283,97 @@ BOOL DxRenderer::UpdateContactShadowCB() {
 	return TRUE;
 }
 
+BOOL DxRenderer::ResolvePendingUploads() {
+	// Everything recorded since the last frame goes out as one batch.
+	CheckReturn(mpLogFile, mUploadQueue->Submit());
+
+	for (auto iter = mUploadingRenderItems.begin(); iter != mUploadingRenderItems.end();) {
+		const auto ritem = *iter;
+		if (!mUploadQueue->IsCompleted(ritem->UploadFence)) {
+			++iter;
+			continue;
+		}
+
+		// Rewrites the culling record that still marks it as not drawable.
+		ritem->UploadFence = 0;
+		ritem->NumFramesDirty = std::max(ritem->NumFramesDirty, static_cast<INT>(Foundation::Resource::FrameResource::Count));
+		iter = mUploadingRenderItems.erase(iter);
+	}
+
+	std::vector<Foundation::Resource::MeshGeometry*> landed{};
+	for (auto iter = mUploadingGeometries.begin(); iter != mUploadingGeometries.end();) {
+		if (mUploadQueue->IsCompleted((*iter)->UploadFence)) {
+			landed.push_back(*iter);
+			iter = mUploadingGeometries.erase(iter);
+		}
+		else {
+			++iter;
+		}
+	}
+
+	if (landed.empty()) return TRUE;
+
+	if (mbRaytracingSupported) {
+		CheckReturn(mpLogFile, mCommandObject->ResetCommandList(
+			mpCurrentFrameResource->CommandAllocator(0),
+			0));
+
+		const auto CmdList = mCommandObject->CommandList(0);
+
+		for (const auto geo : landed)
+			CheckReturn(mpLogFile, mAccelerationStructureManager->BuildBLAS(CmdList, geo));
+
+		CheckReturn(mpLogFile, mCommandObject->ExecuteCommandList(0));
+	}
+
+	// Direct-queue work of this frame is submitted after the builds above,
+	// so the geometry passes the fence test right away.
+	for (const auto geo : landed)
+		geo->Fence = 0;
+
+	// Rewrites the culling records that still mark them as not drawable.
+	for (auto& ritem : mRenderItems) {
+		if (std::find(landed.begin(), landed.end(), ritem->Geometry) != landed.end())
+			ritem->NumFramesDirty = std::max(ritem->NumFramesDirty, static_cast<INT>(Foundation::Resource::FrameResource::Count));
+	}
+
+	mbMeshGeometryAdded = TRUE;
+
+	return TRUE;
+}
+
+BOOL DxRenderer::SwapStreamedTextures() {
+	// Frames already submitted keep reading the old slots until the direct
+	// queue passes its current fence.
+	CheckReturn(mpLogFile, mTextureStreamer->SwapLanded(mCommandObject->CurrentFence()));
+
+	for (const auto texture : mTextureStreamer->SwappedTextures()) {
+		const INT Slot = static_cast<INT>(mTextureStreamer->Slot(texture));
+
+		for (const auto& ref : mStreamedMapRefs[texture]) {
+			*ref.second = Slot;
+			ref.first->NumFramesDirty = Foundation::Resource::FrameResource::Count;
+		}
+	}
+
+	return TRUE;
+}
+
 BOOL DxRenderer::ResolvePendingLights() {
 	const auto shadow = mShadingObjectManager->Get<Shading::Shadow::ShadowClass>();
 
 	for (UINT i = 0, end = static_cast<UINT>(mPendingLights.size()); i < end; ++i) {
 		const auto& light = mPendingLights.front();
-		shadow->AddLight(light);
+
+		// Point and spot lights past the shadowed ones are still shaded,
+		// only without shadows.
+		const BOOL Clustered = shadow->LightCount() >= MaxLights && (
+			light->Type == Common::Foundation::LightType::E_Point ||
+			light->Type == Common::Foundation::LightType::E_Spot);
+
+		if (!Clustered) shadow->AddLight(light);
+		else if (mClusteredLights.size() < ShadingConvention::LightCluster::MaxLightCount) mClusteredLights.push_back(light);
+		else WLogln(mpLogFile, L"Can not add light due to the clustered light count limit");
 
 		mPendingLights.pop();
 	}
@@ -1057,16 +1388,354 @@ BOOL DxRenderer::PopulateRendableItems() {
 	rendableOpaques.clear();
 
 	for (const auto opaque : opaques) {
-		if (mpCurrentFrameResource->mFence < opaque->Geometry->Fence) continue;
+		if (opaque->UploadFence != 0 || mpCurrentFrameResource->mFence < opaque->Geometry->Fence) continue;
 
 		rendableOpaques.push_back(opaque);
 	}
 
+	// Off-screen items stay rendable for ray tracing and shadows; only the
+	// camera passes draw the visible list.
+	auto& visibleOpaques = mVisibleItems[Common::Foundation::Mesh::RenderType::E_Opaque];
+	visibleOpaques.clear();
+
+	if (mpCamera == nullptr) {
+		visibleOpaques = rendableOpaques;
+		return TRUE;
+	}
+
+	// The GBuffer culls on the GPU and ignores the visible list.
+	if (mpShadingArgumentSet->GpuCulling.Enabled) return TRUE;
+
+	Common::Util::FrustumCuller::Frustum frustum;
+	Common::Util::FrustumCuller::BuildFrustum(mpCamera->View(), mpCamera->Proj(), frustum);
+
+	mFrustumCuller->CullBoxes(frustum, mVisibleIndices);
+
+	for (const auto index : mVisibleIndices) {
+		const auto opaque = opaques[index];
+		if (opaque->UploadFence != 0 || mpCurrentFrameResource->mFence < opaque->Geometry->Fence) continue;
+
+		visibleOpaques.push_back(opaque);
+	}
+
+	if (mpShadingArgumentSet->OcclusionCulling.Enabled) CullOccludedItems();
+
+	return TRUE;
+}
+
+void DxRenderer::CullOccludedItems() {
+	auto& visibleOpaques = mVisibleItems[Common::Foundation::Mesh::RenderType::E_Opaque];
+
+	const XMVECTOR EyePos = mpCamera->Position();
+	const FLOAT ProjScale = mpCamera->Proj()._22;
+	const FLOAT NearZ = mpCamera->NearZ();
+
+	// The items covering the most of the screen make the best occluders.
+	mOccluders.clear();
+	for (const auto ritem : visibleOpaques) {
+		if (ritem->Geometry->IndexFormat != DXGI_FORMAT_R32_UINT) continue;
+
+		const auto WorldBounds = Common::Util::FrustumCuller::TransformBox(ritem->Bounds, ritem->World);
+
+		const FLOAT Radius = XMVectorGetX(XMVector3Length(XMLoadFloat3(&WorldBounds.Extents)));
+		const FLOAT Dist = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&WorldBounds.Center), EyePos)));
+		const FLOAT Coverage = Radius * ProjScale / std::max(Dist, NearZ);
+
+		if (Coverage >= MinOccluderCoverage) mOccluders.emplace_back(Coverage, ritem);
+	}
+
+	if (mOccluders.empty()) return;
+
+	const size_t OccluderCount = std::min(mOccluders.size(), static_cast<size_t>(MaxOccluderCount));
+	std::partial_sort(
+		mOccluders.begin(), mOccluders.begin() + OccluderCount, mOccluders.end(),
+		[](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+	mOccluders.resize(OccluderCount);
+
+	XMFLOAT4X4 viewProj;
+	XMStoreFloat4x4(&viewProj, XMMatrixMultiply(
+		XMLoadFloat4x4(&mpCamera->View()), XMLoadFloat4x4(&mpCamera->Proj())));
+
+	mOcclusionCuller->Clear(viewProj);
+
+	for (const auto& occluder : mOccluders) {
+		const auto ritem = occluder.second;
+		const auto geo = ritem->Geometry;
+
+		const BYTE* const Vertices = reinterpret_cast<const BYTE*>(geo->VertexBufferCPU->GetBufferPointer()) +
+			static_cast<size_t>(ritem->BaseVertexLocation) * geo->VertexByteStride;
+		const UINT* const Indices = reinterpret_cast<const UINT*>(geo->IndexBufferCPU->GetBufferPointer()) +
+			ritem->StartIndexLocation;
+
+		mOcclusionCuller->RenderOccluder(Vertices, geo->VertexByteStride, Indices, ritem->IndexCount, ritem->World);
+	}
+
+	// Occluders stay; they would otherwise be tested against themselves.
+	const auto IsOccluder = [&](const Foundation::RenderItem* const ritem) {
+		return std::any_of(mOccluders.begin(), mOccluders.end(),
+			[&](const auto& occluder) { return occluder.second == ritem; });
+	};
+
+	visibleOpaques.erase(std::remove_if(visibleOpaques.begin(), visibleOpaques.end(),
+		[&](const Foundation::RenderItem* const ritem) {
+			if (IsOccluder(ritem)) return false;
+
+			return !mOcclusionCuller->TestBox(
+				Common::Util::FrustumCuller::TransformBox(ritem->Bounds, ritem->World));
+		}), visibleOpaques.end());
+}
+
+BOOL DxRenderer::PopulateShadowCasters() {
+	const auto shadow = mShadingObjectManager->Get<Shading::Shadow::ShadowClass>();
+
+	const auto& opaques = mRenderItemGroups[Common::Foundation::Mesh::RenderType::E_Opaque];
+	const auto& rendableOpaques = mRendableItems[Common::Foundation::Mesh::RenderType::E_Opaque];
+	const UINT ItemCount = static_cast<UINT>(opaques.size());
+
+	for (UINT i = 0, end = shadow->LightCount(); i < end; ++i) {
+		const auto light = shadow->Light(i);
+
+		auto& cache = mShadowCasterCaches[i];
+		auto& casters = mShadowCasters[i];
+		casters.clear();
+
+		const UINT FaceCount = ShadowFaceCount(light);
+		if (FaceCount == 0) {
+			casters = rendableOpaques;
+			continue;
+		}
+
+		// The light CB stores transposed view-projection matrices.
+		const XMFLOAT4X4* const LightMats[6] = { 
+			&light->Mat0, &light->Mat1, &light->Mat2, &light->Mat3, &light->Mat4, &light->Mat5 };
+
+		BOOL lightMoved = cache.FaceCount != FaceCount;
+
+		std::array<Common::Util::FrustumCuller::Frustum, 6> frustums;
+		for (UINT face = 0; face < FaceCount; ++face) {
+			XMFLOAT4X4 viewProj;
+			XMStoreFloat4x4(&viewProj, XMMatrixTranspose(XMLoadFloat4x4(LightMats[face])));
+
+			if (std::memcmp(&viewProj, &cache.ViewProjs[face], sizeof(XMFLOAT4X4)) != 0) {
+				cache.ViewProjs[face] = viewProj;
+				lightMoved = TRUE;
+			}
+
+			Common::Util::FrustumCuller::BuildFrustum(viewProj, frustums[face]);
+		}
+
+		const BOOL IsSpot = light->Type == Common::Foundation::LightType::E_Spot;
+		const auto InsideCone = [&](UINT index) {
+			BoundingSphere sphere;
+			BoundingSphere::CreateFromBoundingBox(
+				sphere, Common::Util::FrustumCuller::TransformBox(opaques[index]->Bounds, opaques[index]->World));
+			// The spot frustum alone keeps the corners of its square cross-section.
+			return Common::Util::FrustumCuller::SphereIntersectsCone(
+				sphere, 
+				light->Position, 
+				light->Direction, 
+				Common::Util::MathUtil::DegreesToRadians(light->OuterConeAngle), 
+				light->AttenuationRadius);
+		};
+
+		BOOL membershipChanged = FALSE;
+		// A caster moving inside the light stales its cached pages even
+		// when the membership stays the same.
+		BOOL casterMoved = FALSE;
+
+		if (lightMoved || cache.BoundsVersion != mShadowBoundsVersion) {
+			cache.Membership.assign(ItemCount, 0);
+
+			// A point light casts into all six faces and a directional one
+			// into every cascade, so the casters are the union of the face
+			// frustums; the geometry shader drops the faces a triangle misses.
+			for (UINT face = 0; face < FaceCount; ++face) {
+				mFrustumCuller->CullBoxes(frustums[face], mVisibleIndices);
+				for (const auto index : mVisibleIndices) cache.Membership[index] = 1;
+			}
+
+			if (IsSpot) {
+				for (UINT index = 0; index < ItemCount; ++index)
+					if (cache.Membership[index] && !InsideCone(index)) cache.Membership[index] = 0;
+			}
+
+			cache.FaceCount = FaceCount;
+			cache.BoundsVersion = mShadowBoundsVersion;
+			membershipChanged = TRUE;
+		}
+		else {
+			// Only the items that moved can have entered or left the light.
+			for (const auto index : mMovedCullingIndices) {
+				UINT8 inside = 0;
+				for (UINT face = 0; face < FaceCount && !inside; ++face)
+					inside = mFrustumCuller->IntersectsBox(frustums[face], index) ? 1 : 0;
+				if (inside && IsSpot && !InsideCone(index)) inside = 0;
+
+				if (inside || cache.Membership[index]) casterMoved = TRUE;
+
+				if (inside != cache.Membership[index]) {
+					cache.Membership[index] = inside;
+					membershipChanged = TRUE;
+				}
+			}
+		}
+
+		if (membershipChanged) {
+			cache.Indices.clear();
+			for (UINT index = 0; index < ItemCount; ++index)
+				if (cache.Membership[index]) cache.Indices.push_back(index);
+		}
+
+		for (const auto index : cache.Indices) {
+			const auto opaque = opaques[index];
+			if (opaque->UploadFence != 0 || mpCurrentFrameResource->mFence < opaque->Geometry->Fence) continue;
+
+			casters.push_back(opaque);
+		}
+
+		// Casters also join once their geometry has landed.
+		const UINT CasterCount = static_cast<UINT>(casters.size());
+		if (membershipChanged || casterMoved || CasterCount != cache.CasterCount) shadow->InvalidateLight(i);
+
+		cache.CasterCount = CasterCount;
+	}
+
+	mMovedCullingIndices.clear();
+
+	return TRUE;
+}
+
+BOOL DxRenderer::BuildDrawBatches() {
+	mDrawBatcher->Clear();
+	mBatchedItems.clear();
+
+	// The indirect path orders its own records.
+	if (mpCamera == nullptr || mpShadingArgumentSet->GpuCulling.Enabled) return TRUE;
+
+	const auto& visibleOpaques = mVisibleItems[Common::Foundation::Mesh::RenderType::E_Opaque];
+
+	const auto CameraView = mpCamera->View();
+	const XMMATRIX View = XMLoadFloat4x4(&CameraView);
+
+	for (UINT i = 0, end = static_cast<UINT>(visibleOpaques.size()); i < end; ++i) {
+		const auto ritem = visibleOpaques[i];
+
+		const XMVECTOR Center = XMVector3Transform(
+			XMVector3Transform(XMLoadFloat3(&ritem->Bounds.Center), XMLoadFloat4x4(&ritem->World)), View);
+
+		// Maps [0, inf) onto [0, 1) so near items keep most of the precision.
+		const FLOAT Dist = std::max(XMVectorGetZ(Center), 0.f);
+
+		mDrawBatcher->Add(
+			Common::Util::DrawBatcher::MakeKey(
+				0, // GBuffer
+				0, // The GBuffer draws everything with one pipeline.
+				static_cast<UINT>(ritem->Material->MaterialCBIndex),
+				ritem->SubmeshId,
+				Dist / (Dist + 1.f)),
+			i);
+	}
+
+	mDrawBatcher->Build();
+
+	const auto& payloads = mDrawBatcher->SortedPayloads();
+	mBatchedItems.reserve(payloads.size());
+
+	for (UINT i = 0, end = static_cast<UINT>(payloads.size()); i < end; ++i) {
+		const auto ritem = visibleOpaques[payloads[i]];
+
+		mBatchedItems.push_back(ritem);
+		mpCurrentFrameResource->InstanceIndices.CopyCB(static_cast<UINT>(ritem->ObjectCBIndex), i);
+	}
+
+	return TRUE;
+}
+
+BOOL DxRenderer::StreamTextures() {
+	const auto& args = mpShadingArgumentSet->TextureStreaming;
+	mTextureStreamer->SetBudget(static_cast<UINT64>(args.BudgetMB) * 1024 * 1024);
+
+	// Without requests residency holds still; reads in flight still land
+	// and a smaller budget is still met.
+	if (args.Enabled && mpCamera != nullptr) {
+		// The GPU culling path leaves the visible list empty.
+		const auto& items = mpShadingArgumentSet->GpuCulling.Enabled ?
+			mRendableItems[Common::Foundation::Mesh::RenderType::E_Opaque] :
+			mVisibleItems[Common::Foundation::Mesh::RenderType::E_Opaque];
+
+		const XMVECTOR EyePos = mpCamera->Position();
+		const FLOAT NearZ = mpCamera->NearZ();
+		// Pixels covered by a unit of view-space size at unit distance.
+		const FLOAT PixelScale = mpCamera->Proj()._22 * 0.5f * static_cast<FLOAT>(mRenderHeight);
+
+		for (const auto ritem : items) {
+			const auto Textures = mMaterialStreamedTextures.find(ritem->Material);
+			if (Textures == mMaterialStreamedTextures.end()) continue;
+
+			const auto WorldBounds = Common::Util::FrustumCuller::TransformBox(ritem->Bounds, ritem->World);
+
+			const FLOAT Radius = XMVectorGetX(XMVector3Length(XMLoadFloat3(&WorldBounds.Extents)));
+			const FLOAT Dist = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&WorldBounds.Center), EyePos)));
+			const FLOAT Diameter = std::max(2.f * Radius * PixelScale / std::max(Dist, NearZ), 1.f);
+
+			// Takes the map to span the item once and asks for the mip that
+			// puts about one texel on each pixel.
+			for (const auto texture : Textures->second) {
+				const FLOAT Extent = static_cast<FLOAT>(mTextureStreamer->MaxExtent(texture));
+				const UINT Mip = Extent > Diameter ? static_cast<UINT>(std::log2(Extent / Diameter)) : 0;
+
+				mTextureStreamer->RequestMip(texture, Mip, mStreamingFrame);
+			}
+		}
+	}
+
+	CheckReturn(mpLogFile, mTextureStreamer->Update(mStreamingFrame));
+
+	++mStreamingFrame;
+
+	return TRUE;
+}
+
+BOOL DxRenderer::UpdateRenderResolution(FLOAT deltaTime) {
+	const auto& args = mpShadingArgumentSet->DynamicResolution;
+
+	mDynamicResolution->SetBounds(args.MinScale, args.MaxScale);
+	mDynamicResolution->SetTargetFrameTime(1.f / static_cast<FLOAT>(args.TargetFrameRate));
+
+	UINT width = mClientWidth;
+	UINT height = mClientHeight;
+
+	if (args.Enabled) {
+		mDynamicResolution->Update(deltaTime);
+
+		width = mDynamicResolution->ScaledWidth(mClientWidth);
+		height = mDynamicResolution->ScaledHeight(mClientHeight);
+	}
+	else {
+		// Starts over from the upper bound once enabled again.
+		mDynamicResolution->Reset(args.MaxScale);
+	}
+
+	SetRenderResolution(width, height);
+
+	// Set every frame, since temporal passes track the previous area too.
+	mShadingObjectManager->SetRenderArea(mRenderWidth, mRenderHeight, mRenderUVScale);
+
 	return TRUE;
 }
 
+void DxRenderer::SetRenderResolution(UINT width, UINT height) {
+	mRenderWidth = width;
+	mRenderHeight = height;
+
+	mRenderViewport = { 0.f, 0.f, static_cast<FLOAT>(width), static_cast<FLOAT>(height), 0.f, 1.f };
+	mRenderScissorRect = { 0, 0, static_cast<LONG>(width), static_cast<LONG>(height) };
+	mRenderUVScale = {
+		static_cast<FLOAT>(width) / static_cast<FLOAT>(mClientWidth),
+		static_cast<FLOAT>(height) / static_cast<FLOAT>(mClientHeight) };
+}
+
 BOOL DxRenderer::BuildMeshGeometry(
-		ID3D12GraphicsCommandList6* const pCmdList,
 		Foundation::Resource::SubmeshGeometry* const pSubmesh,
 		const std::vector<Common::Foundation::Mesh::Vertex>& vertices,
 		const std::vector<std::uint16_t>& indices,
@@ -1084,25 +1753,9 @@ BOOL DxRenderer::BuildMeshGeometry(
 	CheckHRESULT(mpLogFile, D3DCreateBlob(IndicesByteSize, &geo->IndexBufferCPU));
 	CopyMemory(geo->IndexBufferCPU->GetBufferPointer(), indices.data(), IndicesByteSize);
 
-	const auto device = mDevice.get();
-
-	CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateDefaultBuffer(
-		device,
-		pCmdList,
-		vertices.data(),
-		VerticesByteSize,
-		geo->VertexBufferUploader,
-		geo->VertexBufferGPU)
-	);
-
-	CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateDefaultBuffer(
-		device,
-		pCmdList,
-		indices.data(),
-		IndicesByteSize,
-		geo->IndexBufferUploader,
-		geo->IndexBufferGPU)
-	);
+	CheckReturn(mpLogFile, UploadGeometryBuffer(vertices.data(), VerticesByteSize, geo->VertexBufferGPU));
+	CheckReturn(mpLogFile, UploadGeometryBuffer(indices.data(), IndicesByteSize, geo->IndexBufferGPU));
+	geo->UploadFence = mUploadQueue->PendingFence();
 		
 	geo->VertexByteStride = static_cast<UINT>(sizeof(Common::Foundation::Mesh::Vertex));
 	geo->VertexBufferByteSize = VerticesByteSize;
@@ -1118,9 +1771,16 @@ BOOL DxRenderer::BuildMeshGeometry(
 }
 
 BOOL DxRenderer::BuildMeshGeometry(
-		ID3D12GraphicsCommandList6* const pCmdList, 
 		Common::Foundation::Mesh::Mesh* const pMesh,
 		Foundation::Resource::MeshGeometry*& pMeshGeo) {
+	const auto MeshHash = Common::Foundation::Mesh::Mesh::Hash(*pMesh);
+
+	const auto Cached = mMeshGeometryRefs.find(MeshHash);
+	if (Cached != mMeshGeometryRefs.end()) {
+		pMeshGeo = Cached->second;
+		return TRUE;
+	}
+
 	auto geo = std::make_unique<Foundation::Resource::MeshGeometry>();
 	const auto Hash = Foundation::Resource::MeshGeometry::Hash(geo.get());
 
@@ -1136,33 +1796,17 @@ BOOL DxRenderer::BuildMeshGeometry(
 	CheckHRESULT(mpLogFile, D3DCreateBlob(IndicesByteSize, &geo->IndexBufferCPU));
 	CopyMemory(geo->IndexBufferCPU->GetBufferPointer(), Indices, IndicesByteSize);
 
-	CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateDefaultBuffer(
-		mDevice.get(),
-		pCmdList,
-		Vertices,
-		VerticesByteSize,
-		geo->VertexBufferUploader,
-		geo->VertexBufferGPU)
-	);
-	
-	CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateDefaultBuffer(
-		mDevice.get(),
-		pCmdList,
-		Indices,
-		IndicesByteSize,
-		geo->IndexBufferUploader,
-		geo->IndexBufferGPU)
-	);
-
-	const auto Fence = mCommandObject->IncreaseFence();
-	mpCurrentFrameResource->mFence = Fence;
+	CheckReturn(mpLogFile, UploadGeometryBuffer(Vertices, VerticesByteSize, geo->VertexBufferGPU));
+	CheckReturn(mpLogFile, UploadGeometryBuffer(Indices, IndicesByteSize, geo->IndexBufferGPU));
+	geo->UploadFence = mUploadQueue->PendingFence();
 
 	geo->VertexByteStride = static_cast<UINT>(sizeof(Common::Foundation::Mesh::Vertex));
 	geo->VertexBufferByteSize = VerticesByteSize;
 	geo->IndexFormat = DXGI_FORMAT_R32_UINT;
 	geo->IndexBufferByteSize = IndicesByteSize;
 	geo->IndexByteStride = sizeof(std::uint32_t);
-	geo->Fence = Fence;
+	// Fails the fence test of every frame until the upload has landed.
+	geo->Fence = UINT64_MAX;
 
 	std::vector<Common::Foundation::Mesh::Mesh::SubsetPair> subsets;
 	pMesh->Subsets(subsets);
@@ -1172,23 +1816,57 @@ BOOL DxRenderer::BuildMeshGeometry(
 		submesh.StartIndexLocation = subset.second.StartIndexLocation;
 		submesh.BaseVertexLocation = 0;
 		submesh.IndexCount = subset.second.Size;
+
+		XMVECTOR minPoint = XMVectorReplicate(FLT_MAX);
+		XMVECTOR maxPoint = XMVectorReplicate(-FLT_MAX);
+		for (UINT i = 0; i < subset.second.Size; ++i) {
+			const auto& pos = Vertices[Indices[subset.second.StartIndexLocation + i]].Position;
+			const XMVECTOR point = XMLoadFloat3(&pos);
+
+			minPoint = XMVectorMin(minPoint, point);
+			maxPoint = XMVectorMax(maxPoint, point);
+		}
+		if (subset.second.Size > 0) BoundingBox::CreateFromPoints(submesh.Bounds, minPoint, maxPoint);
+
 		geo->Subsets[subset.first] = submesh;
 	}
 
 	pMeshGeo = geo.get();
+	mUploadingGeometries.push_back(pMeshGeo);
+	mMeshGeometryRefs[MeshHash] = pMeshGeo;
 	mMeshGeometries[Hash] = std::move(geo);
 
 	return TRUE;
 }
 
+BOOL DxRenderer::UploadGeometryBuffer(
+		const void* const pData,
+		UINT byteSize,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& buffer) {
+	Foundation::Util::D3D12Util::D3D12BufferCreateInfo info(
+		byteSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_COMMON);
+	CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateBuffer(
+		mDevice.get(), info, IID_PPV_ARGS(&buffer)));
+
+	CheckReturn(mpLogFile, mUploadQueue->UploadBuffer(buffer.Get(), 0, pData, byteSize));
+
+	return TRUE;
+}
+
 BOOL DxRenderer::BuildMeshMaterial(
-		ID3D12GraphicsCommandList6* const pCmdList,
 		Common::Foundation::Mesh::Material* const pMaterial,
 		Foundation::Resource::MaterialData*& pMatData) {
+	const auto MaterialHash = HashMaterial(*pMaterial);
+
+	const auto Cached = mMaterialRefs.find(MaterialHash);
+	if (Cached != mMaterialRefs.end()) {
+		pMatData = Cached->second;
+		return TRUE;
+	}
+
 	auto matData = std::make_unique<Foundation::Resource::MaterialData>(Foundation::Resource::FrameResource::Count);
 
 	CheckReturn(mpLogFile, BuildMeshTextures(
-		pCmdList,
 		pMaterial,
 		matData.get()));
 
@@ -1200,40 +1878,113 @@ BOOL DxRenderer::BuildMeshMaterial(
 
 	pMatData = matData.get();
 
+	mMaterialRefs[MaterialHash] = pMatData;
 	mMaterials.push_back(std::move(matData));
 
 	return TRUE;
 }
 
 BOOL DxRenderer::BuildMeshTextures(
-		ID3D12GraphicsCommandList6* const pCmdList,
 		Common::Foundation::Mesh::Material* const pMaterial,
 		Foundation::Resource::MaterialData* const pMatData) {
-	if (!pMaterial->AlbedoMap.empty()) {
+	CheckReturn(mpLogFile, BuildMeshTexture(
+		pMaterial->AlbedoMap, Foundation::Util::TextureUsage::E_Color, pMatData, pMatData->AlbedoMapIndex));
+	CheckReturn(mpLogFile, BuildMeshTexture(
+		pMaterial->NormalMap, Foundation::Util::TextureUsage::E_Normal, pMatData, pMatData->NormalMapIndex));
+	CheckReturn(mpLogFile, BuildMeshTexture(
+		pMaterial->AlphaMap, Foundation::Util::TextureUsage::E_Mask, pMatData, pMatData->AlphaMapIndex));
+	CheckReturn(mpLogFile, BuildMeshTexture(
+		pMaterial->RoughnessMap, Foundation::Util::TextureUsage::E_Mask, pMatData, pMatData->RoughnessMapIndex));
+	CheckReturn(mpLogFile, BuildMeshTexture(
+		pMaterial->MetalnessMap, Foundation::Util::TextureUsage::E_Mask, pMatData, pMatData->MetalnessMapIndex));
+	CheckReturn(mpLogFile, BuildMeshTexture(
+		pMaterial->SpecularMap, Foundation::Util::TextureUsage::E_Color, pMatData, pMatData->SpecularMapIndex));
 
-	}
-	if (!pMaterial->NormalMap.empty()) {
+	return TRUE;
+}
 
-	}
-	if (!pMaterial->AlphaMap.empty()) {
+BOOL DxRenderer::BuildMeshTexture(
+		const std::string& filePath,
+		Foundation::Util::TextureUsage::Type usage,
+		Foundation::Resource::MaterialData* const pMatData,
+		INT& mapIndex) {
+	if (filePath.empty()) return TRUE;
 
+	const auto Streamed = mStreamedTextures.find(filePath);
+	if (Streamed != mStreamedTextures.end()) {
+		BindStreamedTexture(Streamed->second, pMatData, mapIndex);
+		return TRUE;
 	}
-	if (!pMaterial->RoughnessMap.empty()) {
 
-	}
-	if (!pMaterial->MetalnessMap.empty()) {
+	auto iter = mTextures.find(filePath);
+	if (iter == mTextures.end()) {
+		const auto path = Common::Util::StringUtil::StringToWString(filePath);
+
+		// A map that cannot be cooked is uploaded from its source as before.
+		std::wstring cookedPath{};
+		if (!Foundation::Util::TextureCooker::CookTexture(path.c_str(), usage, cookedPath))
+			cookedPath = path;
+
+		// Maps with a block-compressed mip chain stream in from their tail;
+		// the rest are uploaded in full.
+		UINT texture{};
+		if (mTextureStreamer->AddTexture(cookedPath.c_str(), texture)) {
+			mStreamedTextures[filePath] = texture;
+			BindStreamedTexture(texture, pMatData, mapIndex);
+			return TRUE;
+		}
 
-	}
-	if (!pMaterial->SpecularMap.empty()) {
+		auto tex = std::make_unique<Foundation::Resource::Texture>();
 
+		// A map that fails to load leaves the material untextured.
+		if (!Foundation::Util::D3D12Util::CreateTexture(mDevice.get(), mUploadQueue.get(), tex.get(), cookedPath.c_str())) 
+			return TRUE;
+		CheckHRESULT(mpLogFile, tex->Resource->SetName(path.c_str()));
+
+		CheckReturn(mpLogFile, mDescriptorHeap->AllocateTextureSlot(tex->DescriptorIndex));
+
+		const auto Desc = tex->Resource->GetDesc();
+
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+		srvDesc.Format = Desc.Format;
+		srvDesc.Texture2D.MostDetailedMip = 0;
+		srvDesc.Texture2D.MipLevels = Desc.MipLevels;
+
+		Foundation::Util::D3D12Util::CreateShaderResourceView(
+			mDevice.get(), 
+			tex->Resource.Get(), 
+			&srvDesc, 
+			mDescriptorHeap->TextureSlotCpuHandle(tex->DescriptorIndex));
+
+		iter = mTextures.emplace(filePath, std::move(tex)).first;
 	}
 
+	mapIndex = static_cast<INT>(iter->second->DescriptorIndex);
+
 	return TRUE;
 }
 
+void DxRenderer::BindStreamedTexture(
+		UINT texture,
+		Foundation::Resource::MaterialData* const pMatData,
+		INT& mapIndex) {
+	if (mStreamedMapRefs.size() <= texture) mStreamedMapRefs.resize(texture + 1);
+
+	mStreamedMapRefs[texture].emplace_back(pMatData, &mapIndex);
+	mMaterialStreamedTextures[pMatData].push_back(texture);
+
+	mapIndex = static_cast<INT>(mTextureStreamer->Slot(texture));
+}
+
 BOOL DxRenderer::InitShadingObjects() {
 	CheckReturn(mpLogFile, mShadingObjectManager->Initialize(mpLogFile));
-	CheckReturn(mpLogFile, mShaderManager->Initialize(mpLogFile, static_cast<UINT>(mProcessor->Logical)));
+	CheckReturn(mpLogFile, mShaderManager->Initialize(
+		mpLogFile, static_cast<UINT>(mProcessor->Logical), L".\\ShaderCache\\", CompileShadersAtRuntime));
+	CheckReturn(mpLogFile, mPipelineStateCache->Initialize(mpLogFile, mDevice.get(), PipelineLibraryPath));
+	mDevice->SetPipelineStateCache(mPipelineStateCache.get());
+	CheckReturn(mpLogFile, mRenderGraph->Initialize(mpLogFile, mDevice.get(), mCommandObject.get()));
 
 	// MipmapGenerator
 	{
@@ -1272,8 +2023,11 @@ BOOL DxRenderer::InitShadingObjects() {
 		initData->MeshShaderSupported = mbMeshShaderSupported;
 		initData->Device = mDevice.get();
 		initData->CommandObject = mCommandObject.get();
+		initData->UploadQueue = mUploadQueue.get();
 		initData->DescriptorHeap = mDescriptorHeap.get();
 		initData->ShaderManager = mShaderManager.get();
+		initData->Avx2Supported = mProcessor->SupportAVX2;
+		initData->ThreadCount = static_cast<UINT>(mProcessor->Logical);
 		const auto obj = mShadingObjectManager->Get<Shading::EnvironmentMap::EnvironmentMapClass>();
 		CheckReturn(mpLogFile, obj->Initialize(mpLogFile, initData.get()));
 	}
@@ -1339,8 +2093,9 @@ BOOL DxRenderer::InitShadingObjects() {
 		initData->ShaderManager = mShaderManager.get();
 		initData->ClientWidth = mClientWidth;
 		initData->ClientHeight = mClientHeight;
-		initData->TexWidth = 2048;
-		initData->TexHeight = 2048;
+		initData->AtlasSize = 8192;
+		initData->MinPageSize = 256;
+		initData->MaxPageSize = 2048;
 		const auto obj = mShadingObjectManager->Get<Shading::Shadow::ShadowClass>();
 		CheckReturn(mpLogFile, obj->Initialize(mpLogFile, initData.get()));
 	}
@@ -1536,10 +2291,28 @@ BOOL DxRenderer::InitShadingObjects() {
 		const auto obj = mShadingObjectManager->Get<Shading::ChromaticAberration::ChromaticAberrationClass>();
 		CheckReturn(mpLogFile, obj->Initialize(mpLogFile, initData.get()));
 	}
+	// GpuCulling
+	{
+		auto initData = Shading::GpuCulling::MakeInitData();
+		initData->Device = mDevice.get();
+		initData->CommandObject = mCommandObject.get();
+		initData->DescriptorHeap = mDescriptorHeap.get();
+		initData->ShaderManager = mShaderManager.get();
+		initData->ClientWidth = mClientWidth;
+		initData->ClientHeight = mClientHeight;
+		initData->MaxInstanceCount = MaxObjectCount;
+		const auto obj = mShadingObjectManager->Get<Shading::GpuCulling::GpuCullingClass>();
+		CheckReturn(mpLogFile, obj->Initialize(mpLogFile, initData.get()));
+	}
 
-	CheckReturn(mpLogFile, mShadingObjectManager->CompileShaders(mShaderManager.get(), L".\\..\\..\\..\\assets\\Shaders\\HLSL\\"));
+	CheckReturn(mpLogFile, mShaderManager->LoadManifest(ShaderManifestPath));
+	CheckReturn(mpLogFile, mShaderManager->LoadArchive(ShaderArchivePath));
+	CheckReturn(mpLogFile, mShaderManager->CompileShaders(ShaderSourceDir));
 	CheckReturn(mpLogFile, mShadingObjectManager->BuildRootSignatures());
-	CheckReturn(mpLogFile, mShadingObjectManager->BuildPipelineStates());
+	CheckReturn(mpLogFile, mShadingObjectManager->BuildPipelineStates(static_cast<UINT>(mProcessor->Logical)));
+	CheckReturn(mpLogFile, mPipelineStateCache->Serialize());
+	Logln(mpLogFile, std::format("Pipeline states: {} loaded from library, {} created", 
+		mPipelineStateCache->HitCount(), mPipelineStateCache->MissCount()));
 	CheckReturn(mpLogFile, mShadingObjectManager->BuildDescriptors(mDescriptorHeap.get()));
 
 	return TRUE;
@@ -1549,7 +2322,7 @@ BOOL DxRenderer::BuildFrameResources() {
 	for (UINT i = 0; i < Foundation::Resource::FrameResource::Count; i++) {
 		mFrameResources.push_back(std::make_unique<Foundation::Resource::FrameResource>());
 
-		CheckReturn(mpLogFile, mFrameResources.back()->Initialize(mpLogFile, mDevice.get(), static_cast<UINT>(mProcessor->Logical), 2, 32, 32));
+		CheckReturn(mpLogFile, mFrameResources.back()->Initialize(mpLogFile, mDevice.get(), static_cast<UINT>(mProcessor->Logical), 2, MaxObjectCount, 32));
 	}
 
 	mCurrentFrameResourceIndex = 0;
@@ -1587,12 +2360,12 @@ BOOL DxRenderer::BuildSkySphere() {
 
 	mSkySphere = std::make_unique<Foundation::RenderItem>(Foundation::Resource::FrameResource::Count);
 
-	CheckReturn(mpLogFile, mCommandObject->ResetDirectCommandList());
+	CheckReturn(mpLogFile, BuildMeshGeometry(&sphereSubmesh, vertices, indices, "SkySphere", mSkySphere->Geometry));
 
-	const auto CmdList = mCommandObject->DirectCommandList();
-	CheckReturn(mpLogFile, BuildMeshGeometry(CmdList, &sphereSubmesh, vertices, indices, "SkySphere", mSkySphere->Geometry));
-
-	CheckReturn(mpLogFile, mCommandObject->ExecuteDirectCommandList());
+	// The sky sphere is drawn without the fence test, so the direct queue
+	// waits for its copy instead.
+	CheckReturn(mpLogFile, mUploadQueue->Submit());
+	CheckReturn(mpLogFile, mCommandObject->WaitOnQueue(mUploadQueue->Fence(), mUploadQueue->SubmittedFence()));
 
 	mSkySphere->ObjectCBIndex = static_cast<INT>(mRenderItems.size());
 	mSkySphere->PrimitiveType = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
@@ -1641,6 +2414,412 @@ BOOL DxRenderer::BuildScene() {
 	return TRUE;
 }
 
+BOOL DxRenderer::BuildRenderGraph() {
+	const auto gbuffer = mShadingObjectManager->Get<Shading::GBuffer::GBufferClass>();
+	const auto tone = mShadingObjectManager->Get<Shading::ToneMapping::ToneMappingClass>();
+	const auto shadow = mShadingObjectManager->Get<Shading::Shadow::ShadowClass>();
+	const auto rayShadow = mShadingObjectManager->Get<Shading::RaytracedShadow::RaytracedShadowClass>();
+	const auto env = mShadingObjectManager->Get<Shading::EnvironmentMap::EnvironmentMapClass>();
+	const auto eye = mShadingObjectManager->Get<Shading::EyeAdaption::EyeAdaptionClass>();
+
+	const auto DepthBuffer = mDepthStencilBuffer->GetDepthStencilBuffer();
+	const auto Intermediate = tone->InterMediateMapResource();
+	const auto IntermediateCopy = tone->InterMediateCopyMapResource();
+	const auto BackBuffer = mSwapChain->BackBuffer();
+	const auto BackBufferCopy = mSwapChain->BackBufferCopy();
+	const auto ShadowMap = mpShadingArgumentSet->RaytracingEnabled ? rayShadow->ShadowMap() : shadow->ShadowMap();
+
+	const std::array<Foundation::Resource::GpuResource*, 6> GBufferMaps = {
+		gbuffer->AlbedoMap(),
+		gbuffer->NormalMap(),
+		gbuffer->SpecularMap(),
+		gbuffer->RoughnessMetalnessMap(),
+		gbuffer->VelocityMap(),
+		gbuffer->PositionMap()
+	};
+
+	const auto ZDepthAtlas = shadow->ZDepthAtlas();
+
+	const auto culling = mShadingObjectManager->Get<Shading::GpuCulling::GpuCullingClass>();
+	const BOOL GpuCullingEnabled = mpShadingArgumentSet->GpuCulling.Enabled;
+
+	// Instance culling
+	if (GpuCullingEnabled) {
+		auto pass = mRenderGraph->AddPass(L"CullInstances", [this, culling]() {
+			CheckReturn(mpLogFile, culling->CullInstances(
+				mpCurrentFrameResource,
+				std::min(static_cast<UINT>(mRenderItems.size()), culling->MaxInstanceCount()),
+				mpShadingArgumentSet->GpuCulling.OcclusionEnabled));
+
+			return TRUE;
+		});
+		pass.Read(culling->HiZMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.Write(culling->CommandBuffer(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+			.Write(culling->CommandCountBuffer(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	}
+	else {
+		culling->InvalidateHiZ();
+	}
+	// GBuffer
+	if (GpuCullingEnabled) {
+		auto pass = mRenderGraph->AddPass(L"GBuffer", [this, gbuffer, culling]() {
+			CheckReturn(mpLogFile, gbuffer->DrawGBufferIndirect(
+				mpCurrentFrameResource,
+				mRenderViewport,
+				mRenderScissorRect,
+				mDepthStencilBuffer->GetDepthStencilBuffer(),
+				mDepthStencilBuffer->DepthStencilBufferDsv(),
+				culling->InstanceIndices(),
+				culling->CommandBuffer(),
+				culling->CommandCountBuffer(),
+				culling->MaxInstanceCount(),
+				0.4f, 0.1f));
+
+			return TRUE;
+		});
+		for (const auto map : GBufferMaps)
+			pass.Write(map, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		pass.Read(culling->CommandBuffer(), D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT)
+			.Read(culling->CommandCountBuffer(), D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT)
+			.Write(gbuffer->NormalDepthMap(), D3D12_RESOURCE_STATE_RENDER_TARGET)
+			.Write(gbuffer->CachedNormalDepthMap(), D3D12_RESOURCE_STATE_COPY_DEST)
+			.Write(DepthBuffer, D3D12_RESOURCE_STATE_DEPTH_WRITE)
+			.Write(Intermediate, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	}
+	else {
+		auto pass = mRenderGraph->AddPass(L"GBuffer", [this, gbuffer, tone]() {
+			CheckReturn(mpLogFile, gbuffer->DrawGBuffer(
+				mpCurrentFrameResource,
+				mRenderViewport,
+				mRenderScissorRect,
+				tone->InterMediateMapResource(),
+				tone->InterMediateMapRtv(),
+				mDepthStencilBuffer->GetDepthStencilBuffer(),
+				mDepthStencilBuffer->DepthStencilBufferDsv(),
+				mBatchedItems,
+				*mDrawBatcher,
+				0.4f, 0.1f));
+
+			return TRUE;
+		});
+		for (const auto map : GBufferMaps)
+			pass.Write(map, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		pass.Write(gbuffer->NormalDepthMap(), D3D12_RESOURCE_STATE_RENDER_TARGET)
+			.Write(gbuffer->CachedNormalDepthMap(), D3D12_RESOURCE_STATE_COPY_DEST)
+			.Write(DepthBuffer, D3D12_RESOURCE_STATE_DEPTH_WRITE)
+			.Write(Intermediate, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	}
+	// Depth pyramid for the next frame's occlusion test
+	if (GpuCullingEnabled) {
+		auto pass = mRenderGraph->AddPass(L"BuildHiZ", [this, culling]() {
+			CheckReturn(mpLogFile, culling->BuildHiZ(
+				mpCurrentFrameResource,
+				mDepthStencilBuffer->GetDepthStencilBuffer(),
+				mDepthStencilBuffer->DepthStencilBufferSrv()));
+
+			return TRUE;
+		});
+		pass.Read(DepthBuffer, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.Write(culling->HiZMap(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		mRenderGraph->MarkOutput(culling->HiZMap());
+	}
+	// Ambient occlusion
+	if (mpShadingArgumentSet->AOEnabled) {
+		const auto rtao = mShadingObjectManager->Get<Shading::RTAO::RTAOClass>();
+		const auto ssao = mShadingObjectManager->Get<Shading::SSAO::SSAOClass>();
+
+		auto pass = mRenderGraph->AddPass(L"AmbientOcclusion", [this]() {
+			const auto svgf = mShadingObjectManager->Get<Shading::SVGF::SVGFClass>();
+			CheckReturn(mpLogFile, svgf->CalculateDepthParticalDerivative(
+				mpCurrentFrameResource,
+				mDepthStencilBuffer->GetDepthStencilBuffer(),
+				mDepthStencilBuffer->DepthStencilBufferSrv()));
+
+			CheckReturn(mpLogFile, DrawAO());
+
+			return TRUE;
+		});
+		// Runs on the compute queue next to the shadow pass, which reads
+		// the shared inputs in the same state.
+		pass.AsyncCompute();
+		pass.Read(gbuffer->PositionMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.Read(gbuffer->VelocityMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.Read(gbuffer->RoughnessMetalnessMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.Read(gbuffer->NormalDepthMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.Read(gbuffer->ReprojectedNormalDepthMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.Read(gbuffer->CachedNormalDepthMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.Read(DepthBuffer, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		// The denoiser ping-pongs between both temporal maps, so the one
+		// holding the result is only known once the pass ran.
+		for (UINT i = 0; i < 2; ++i) {
+			pass.Write(mpShadingArgumentSet->RaytracingEnabled ?
+				rtao->TemporalAOCoefficientResource(i) : ssao->TemporalAOCoefficientResource(i),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		}
+	}
+	// Shadow
+	{
+		auto pass = mRenderGraph->AddPass(L"Shadow", [this]() { return DrawShadow(); });
+		if (mpShadingArgumentSet->RaytracingEnabled) {
+			pass.Read(gbuffer->PositionMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+				.Read(gbuffer->NormalMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+				.Read(DepthBuffer, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+				.Write(rayShadow->ShadowMap(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		}
+		else {
+			pass.Read(gbuffer->PositionMap(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+				.Write(shadow->ShadowMap(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+				.Write(ZDepthAtlas, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+			// Cached pages are sampled again by later frames.
+			mRenderGraph->MarkOutput(ZDepthAtlas);
+		}
+	}
+	// Contact shadow
+	if (mpShadingArgumentSet->SSCS.Enabled) {
+		const auto sscs = mShadingObjectManager->Get<Shading::SSCS::SSCSClass>();
+
+		auto pass = mRenderGraph->AddPass(L"ContactShadow", [this]() { return ApplyContactShadow(); });
+		pass.Read(gbuffer->PositionMap(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Read(gbuffer->NormalMap(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Read(DepthBuffer, D3D12_RESOURCE_STATE_DEPTH_READ)
+			.Write(shadow->ShadowMap(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		sscs->DeclareTransients(pass);
+	}
+	// BRDF
+	{
+		auto pass = mRenderGraph->AddPass(L"BRDF", [this, gbuffer, tone, shadow, rayShadow]() {
+			const auto brdf = mShadingObjectManager->Get<Shading::BRDF::BRDFClass>();
+			CheckReturn(mpLogFile, brdf->ComputeBRDF(
+				mpCurrentFrameResource,
+				mRenderViewport,
+				mRenderScissorRect,
+				tone->InterMediateMapResource(),
+				tone->InterMediateMapRtv(),
+				gbuffer->AlbedoMap(),
+				gbuffer->AlbedoMapSrv(),
+				gbuffer->NormalMap(),
+				gbuffer->NormalMapSrv(),
+				mDepthStencilBuffer->GetDepthStencilBuffer(),
+				mDepthStencilBuffer->DepthStencilBufferSrv(),
+				gbuffer->SpecularMap(),
+				gbuffer->SpecularMapSrv(),
+				gbuffer->RoughnessMetalnessMap(),
+				gbuffer->RoughnessMetalnessMapSrv(),
+				gbuffer->PositionMap(),
+				gbuffer->PositionMapSrv(),
+				mpShadingArgumentSet->RaytracingEnabled ?
+					rayShadow->ShadowMap() : shadow->ShadowMap(),
+				mpShadingArgumentSet->RaytracingEnabled ?
+					rayShadow->ShadowMapSrv() : shadow->ShadowMapSrv(),
+				mpShadingArgumentSet->ShadowEnabled));
+
+			return TRUE;
+		});
+		for (const auto map : GBufferMaps)
+			pass.Read(map, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pass.Read(DepthBuffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Write(Intermediate, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		if (mpShadingArgumentSet->ShadowEnabled)
+			pass.Read(ShadowMap, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	}
+	// Irradiance
+	{
+		auto pass = mRenderGraph->AddPass(L"IntegrateIrradiance", [this]() { return IntegrateIrradiance(); });
+		for (const auto map : GBufferMaps)
+			pass.Read(map, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pass.Read(DepthBuffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Read(env->PrefilteredEnvironmentCubeMap(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Read(env->BrdfLutMap(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Write(Intermediate, D3D12_RESOURCE_STATE_COPY_SOURCE)
+			.Write(IntermediateCopy, D3D12_RESOURCE_STATE_COPY_DEST);
+		if (mpShadingArgumentSet->AOEnabled) {
+			const auto rtao = mShadingObjectManager->Get<Shading::RTAO::RTAOClass>();
+			const auto ssao = mShadingObjectManager->Get<Shading::SSAO::SSAOClass>();
+
+			for (UINT i = 0; i < 2; ++i) {
+				pass.Read(mpShadingArgumentSet->RaytracingEnabled ?
+					rtao->TemporalAOCoefficientResource(i) : ssao->TemporalAOCoefficientResource(i),
+					D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+			}
+		}
+	}
+	// Sky sphere
+	{
+		auto pass = mRenderGraph->AddPass(L"SkySphere", [this, env, tone]() {
+			CheckReturn(mpLogFile, env->DrawSkySphere(
+				mpCurrentFrameResource,
+				mRenderViewport,
+				mRenderScissorRect,
+				tone->InterMediateMapResource(),
+				tone->InterMediateMapRtv(),
+				mDepthStencilBuffer->GetDepthStencilBuffer(),
+				mDepthStencilBuffer->DepthStencilBufferDsv(),
+				mSkySphere.get()));
+
+			return TRUE;
+		});
+		pass.Write(Intermediate, D3D12_RESOURCE_STATE_RENDER_TARGET)
+			.Write(DepthBuffer, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+	}
+	// Volumetric light
+	{
+		auto pass = mRenderGraph->AddPass(L"VolumetricLight", [this]() { return ApplyVolumetricLight(); });
+		pass.Read(ZDepthAtlas, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Read(gbuffer->PositionMap(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Write(Intermediate, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	}
+	// Bloom
+	if (mpShadingArgumentSet->Bloom.Enabled) {
+		const auto bloom = mShadingObjectManager->Get<Shading::Bloom::BloomClass>();
+
+		auto pass = mRenderGraph->AddPass(L"Bloom", [this]() { return ApplyBloom(); });
+		pass.Write(Intermediate, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Write(IntermediateCopy, D3D12_RESOURCE_STATE_COPY_DEST);
+		bloom->DeclareTransients(pass);
+	}
+	// Eye adaption
+	{
+		auto pass = mRenderGraph->AddPass(L"EyeAdaption", [this]() { return ApplyEyeAdaption(); });
+		pass.Read(Intermediate, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Write(eye->Luminance(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	}
+	// Chromatic aberration
+	if (mpShadingArgumentSet->ChromaticAberration.Enabled) {
+		auto pass = mRenderGraph->AddPass(L"ChromaticAberration", [this, tone]() {
+			const auto chromatic = mShadingObjectManager->Get<Shading::ChromaticAberration::ChromaticAberrationClass>();
+			CheckReturn(mpLogFile, chromatic->ApplyChromaticAberration(
+				mpCurrentFrameResource,
+				mRenderViewport,
+				mRenderScissorRect,
+				tone->InterMediateMapResource(),
+				tone->InterMediateMapRtv(),
+				tone->InterMediateCopyMapResource(),
+				tone->InterMediateCopyMapSrv(),
+				mpShadingArgumentSet->ChromaticAberration.Strength,
+				mpShadingArgumentSet->ChromaticAberration.Threshold,
+				mpShadingArgumentSet->ChromaticAberration.Feather,
+				mpShadingArgumentSet->ChromaticAberration.ShiftPx,
+				mpShadingArgumentSet->ChromaticAberration.Exponent));
+
+			return TRUE;
+		});
+		pass.Write(Intermediate, D3D12_RESOURCE_STATE_COPY_SOURCE)
+			.Write(IntermediateCopy, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+	// Depth of field
+	if (mpShadingArgumentSet->DOF.Enabled) {
+		const auto dof = mShadingObjectManager->Get<Shading::DOF::DOFClass>();
+
+		auto pass = mRenderGraph->AddPass(L"DOF", [this]() { return ApplyDOF(); });
+		pass.Read(gbuffer->PositionMap(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Read(DepthBuffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Write(Intermediate, D3D12_RESOURCE_STATE_COPY_SOURCE)
+			.Write(IntermediateCopy, D3D12_RESOURCE_STATE_COPY_DEST);
+		dof->DeclareTransients(pass);
+	}
+	// TAA
+	if (mpShadingArgumentSet->TAA.Enabled) {
+		auto pass = mRenderGraph->AddPass(L"TAA", [this, gbuffer, tone]() {
+			const auto taa = mShadingObjectManager->Get<Shading::TAA::TAAClass>();
+			CheckReturn(mpLogFile, taa->ApplyTAA(
+				mpCurrentFrameResource,
+				mRenderViewport,
+				mRenderScissorRect,
+				tone->InterMediateMapResource(),
+				tone->InterMediateMapRtv(),
+				tone->InterMediateCopyMapResource(),
+				tone->InterMediateCopyMapSrv(),
+				gbuffer->VelocityMap(),
+				gbuffer->VelocityMapSrv(),
+				mpShadingArgumentSet->TAA.ModulationFactor));
+
+			return TRUE;
+		});
+		pass.Read(gbuffer->VelocityMap(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Write(Intermediate, D3D12_RESOURCE_STATE_COPY_SOURCE)
+			.Write(IntermediateCopy, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+	// Tone mapping
+	// Samples the area rendered into bilinearly across the back buffer,
+	// which scales the render resolution up to the window.
+	{
+		auto pass = mRenderGraph->AddPass(L"ToneMapping", [this, tone, eye]() {
+			CheckReturn(mpLogFile, tone->Resolve(
+				mpCurrentFrameResource,
+				mSwapChain->ScreenViewport(),
+				mSwapChain->ScissorRect(),
+				mSwapChain->BackBuffer(),
+				mSwapChain->BackBufferRtv(),
+				eye->Luminance(),
+				mpShadingArgumentSet->ToneMapping.Exposure,
+				mpShadingArgumentSet->ToneMapping.MiddleGrayKey,
+				mpShadingArgumentSet->ToneMapping.TonemapperType));
+
+			return TRUE;
+		});
+		pass.Read(Intermediate, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Read(eye->Luminance(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+			.Write(BackBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	}
+	// Gamma correction
+	if (mpShadingArgumentSet->GammaCorrection.Enabled) {
+		auto pass = mRenderGraph->AddPass(L"GammaCorrection", [this]() {
+			const auto gamma = mShadingObjectManager->Get<Shading::GammaCorrection::GammaCorrectionClass>();
+			CheckReturn(mpLogFile, gamma->ApplyCorrection(
+				mpCurrentFrameResource,
+				mSwapChain->ScreenViewport(),
+				mSwapChain->ScissorRect(),
+				mSwapChain->BackBuffer(),
+				mSwapChain->BackBufferRtv(),
+				mSwapChain->BackBufferCopy(),
+				mSwapChain->BackBufferCopySrv(),
+				mpShadingArgumentSet->GammaCorrection.Gamma));
+
+			return TRUE;
+		});
+		pass.Write(BackBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE)
+			.Write(BackBufferCopy, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+	// Motion blur
+	if (mpShadingArgumentSet->MotionBlur.Enabled) {
+		auto pass = mRenderGraph->AddPass(L"MotionBlur", [this, gbuffer]() {
+			const auto motion = mShadingObjectManager->Get<Shading::MotionBlur::MotionBlurClass>();
+			CheckReturn(mpLogFile, motion->ApplyMotionBlur(
+				mpCurrentFrameResource,
+				mSwapChain->ScreenViewport(),
+				mSwapChain->ScissorRect(),
+				mSwapChain->BackBuffer(),
+				mSwapChain->BackBufferRtv(),
+				mSwapChain->BackBufferCopy(),
+				mSwapChain->BackBufferCopySrv(),
+				mDepthStencilBuffer->GetDepthStencilBuffer(),
+				mDepthStencilBuffer->DepthStencilBufferSrv(),
+				gbuffer->VelocityMap(),
+				gbuffer->VelocityMapSrv(),
+				mpShadingArgumentSet->MotionBlur.Intensity,
+				mpShadingArgumentSet->MotionBlur.Limit,
+				mpShadingArgumentSet->MotionBlur.DepthBias,
+				mpShadingArgumentSet->MotionBlur.SampleCount));
+
+			return TRUE;
+		});
+		pass.Read(DepthBuffer, D3D12_RESOURCE_STATE_DEPTH_READ)
+			.Read(gbuffer->VelocityMap(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.Write(BackBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE)
+			.Write(BackBufferCopy, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+	// ImGui
+	{
+		auto pass = mRenderGraph->AddPass(L"ImGui", [this]() { return DrawImGui(); });
+		pass.Write(BackBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET)
+			.SideEffect();
+	}
+
+	mRenderGraph->MarkOutput(BackBuffer);
+
+	return TRUE;
+}
+
 BOOL DxRenderer::DrawImGui() {
 	CheckReturn(mpLogFile, mCommandObject->ResetCommandList(
 		mpCurrentFrameResource->CommandAllocator(0),
@@ -1698,7 +2877,7 @@ BOOL DxRenderer::DrawShadow() {
 			mpCurrentFrameResource,
 			gbuffer->PositionMap(),
 			gbuffer->PositionMapSrv(),
-			mRendableItems[Common::Foundation::Mesh::RenderType::E_Opaque]));
+			mShadowCasters));
 	}
 
 	return TRUE;
@@ -1735,6 +2914,10 @@ BOOL DxRenderer::DrawAO() {
 	const auto gbuffer = mShadingObjectManager->Get<Shading::GBuffer::GBufferClass>();
 
 	if (mpShadingArgumentSet->RaytracingEnabled) {		
+		const UINT ResolutionType = mpShadingArgumentSet->RTAO.ResolutionType;
+		const BOOL CheckerboardEnabled = ResolutionType == Common::Render::EffectResolution::E_Checkerboard;
+		const BOOL HalfResolutionEnabled = ResolutionType == Common::Render::EffectResolution::E_HalfResolution;
+
 		if (mpShadingArgumentSet->RTAO.RaySortingEnabled) {
 			CheckReturn(mpLogFile, raygen->GenerateRays(
 				mpCurrentFrameResource,
@@ -1742,7 +2925,8 @@ BOOL DxRenderer::DrawAO() {
 				gbuffer->NormalDepthMapSrv(),
 				gbuffer->PositionMap(),
 				gbuffer->PositionMapSrv(),
-				mpShadingArgumentSet->RTAO.CheckboardRayGeneration));
+				CheckerboardEnabled,
+				HalfResolutionEnabled));
 
 			CheckReturn(mpLogFile, raysorting->CalcRayIndexOffset(
 				mpCurrentFrameResource,
@@ -1762,7 +2946,36 @@ BOOL DxRenderer::DrawAO() {
 			raysorting->RayIndexOffsetMap(),
 			raysorting->RayIndexOffsetMapSrv(),
 			mpShadingArgumentSet->RTAO.RaySortingEnabled,
-			mpShadingArgumentSet->RTAO.CheckboardRayGeneration));
+			CheckerboardEnabled,
+			HalfResolutionEnabled));
+
+		// Brings the half-resolution maps back to the size the denoiser runs at.
+		if (HalfResolutionEnabled) {
+			const auto blurFilter = mShadingObjectManager->Get<Shading::BlurFilter::BlurFilterClass>();
+
+			CheckReturn(mpLogFile, blurFilter->BilateralUpsample(
+				mpCurrentFrameResource,
+				gbuffer->NormalDepthMap(),
+				gbuffer->NormalDepthMapSrv(),
+				rtao->AOCoefficientResource(Shading::RTAO::Resource::AO::E_HalfResAOCoefficient),
+				rtao->AOCoefficientDescriptor(Shading::RTAO::Descriptor::AO::ES_HalfResAOCoefficient),
+				rtao->AOCoefficientResource(Shading::RTAO::Resource::AO::E_AOCoefficient),
+				rtao->AOCoefficientDescriptor(Shading::RTAO::Descriptor::AO::EU_AOCoefficient),
+				mRenderWidth, mRenderHeight,
+				mpShadingArgumentSet->RTAO.BlendWithCurrentFrame.DepthSigma,
+				Shading::SVGF::NumMantissaBitsInFloatFormat(16)));
+			CheckReturn(mpLogFile, blurFilter->BilateralUpsample(
+				mpCurrentFrameResource,
+				gbuffer->NormalDepthMap(),
+				gbuffer->NormalDepthMapSrv(),
+				rtao->AOCoefficientResource(Shading::RTAO::Resource::AO::E_HalfResRayHitDistance),
+				rtao->AOCoefficientDescriptor(Shading::RTAO::Descriptor::AO::ES_HalfResRayHitDistance),
+				rtao->AOCoefficientResource(Shading::RTAO::Resource::AO::E_RayHitDistance),
+				rtao->AOCoefficientDescriptor(Shading::RTAO::Descriptor::AO::EU_RayHitDistance),
+				mRenderWidth, mRenderHeight,
+				mpShadingArgumentSet->RTAO.BlendWithCurrentFrame.DepthSigma,
+				Shading::SVGF::NumMantissaBitsInFloatFormat(16)));
+		}
 
 		// Denosing(Spatio - Temporal Variance Guided Filtering)
 		{
@@ -1807,12 +3020,12 @@ BOOL DxRenderer::DrawAO() {
 						rtao->AOCoefficientResource(Shading::RTAO::Resource::AO::E_AOCoefficient),
 						rtao->AOCoefficientDescriptor(Shading::RTAO::Descriptor::AO::ES_AOCoefficient),
 						Shading::SVGF::Value::E_Contrast,
-						mpShadingArgumentSet->RTAO.CheckboardRayGeneration));
+						CheckerboardEnabled));
 					// Interpolate the variance for the inactive cells from the valid checkerboard cells.
-					if (mpShadingArgumentSet->RTAO.CheckboardRayGeneration) {
+					if (CheckerboardEnabled) {
 						CheckReturn(mpLogFile, svgf->FillInCheckerboard(
 							mpCurrentFrameResource,
-							mpShadingArgumentSet->RTAO.CheckboardRayGeneration));
+							CheckerboardEnabled));
 					}
 					// Blends reprojected values with current frame values.
 					// Inactive pixels are filtered from active neighbors on checkerboard sampling before the blending operation.
@@ -1888,12 +3101,46 @@ BOOL DxRenderer::DrawAO() {
 		}
 	}
 	else {
+		const UINT ResolutionType = mpShadingArgumentSet->SSAO.ResolutionType;
+		const BOOL CheckerboardEnabled = ResolutionType == Common::Render::EffectResolution::E_Checkerboard;
+		const BOOL HalfResolutionEnabled = ResolutionType == Common::Render::EffectResolution::E_HalfResolution;
+
 		CheckReturn(mpLogFile, ssao->DrawAO(
 			mpCurrentFrameResource,
 			gbuffer->NormalDepthMap(),
 			gbuffer->NormalDepthMapSrv(),
 			gbuffer->PositionMap(),
-			gbuffer->PositionMapSrv()));
+			gbuffer->PositionMapSrv(),
+			CheckerboardEnabled,
+			HalfResolutionEnabled));
+
+		// Brings the half-resolution maps back to the size the denoiser runs at.
+		if (HalfResolutionEnabled) {
+			const auto blurFilter = mShadingObjectManager->Get<Shading::BlurFilter::BlurFilterClass>();
+
+			CheckReturn(mpLogFile, blurFilter->BilateralUpsample(
+				mpCurrentFrameResource,
+				gbuffer->NormalDepthMap(),
+				gbuffer->NormalDepthMapSrv(),
+				ssao->AOCoefficientResource(Shading::SSAO::Resource::AO::E_HalfResAOCoefficient),
+				ssao->AOCoefficientDescriptor(Shading::SSAO::Descriptor::AO::ES_HalfResAOCoefficient),
+				ssao->AOCoefficientResource(Shading::SSAO::Resource::AO::E_AOCoefficient),
+				ssao->AOCoefficientDescriptor(Shading::SSAO::Descriptor::AO::EU_AOCoefficient),
+				mRenderWidth, mRenderHeight,
+				mpShadingArgumentSet->SSAO.BlendWithCurrentFrame.DepthSigma,
+				Shading::SVGF::NumMantissaBitsInFloatFormat(16)));
+			CheckReturn(mpLogFile, blurFilter->BilateralUpsample(
+				mpCurrentFrameResource,
+				gbuffer->NormalDepthMap(),
+				gbuffer->NormalDepthMapSrv(),
+				ssao->AOCoefficientResource(Shading::SSAO::Resource::AO::E_HalfResRayHitDistance),
+				ssao->AOCoefficientDescriptor(Shading::SSAO::Descriptor::AO::ES_HalfResRayHitDistance),
+				ssao->AOCoefficientResource(Shading::SSAO::Resource::AO::E_RayHitDistance),
+				ssao->AOCoefficientDescriptor(Shading::SSAO::Descriptor::AO::EU_RayHitDistance),
+				mRenderWidth, mRenderHeight,
+				mpShadingArgumentSet->SSAO.BlendWithCurrentFrame.DepthSigma,
+				Shading::SVGF::NumMantissaBitsInFloatFormat(16)));
+		}
 
 		// Denosing(Spatio - Temporal Variance Guided Filtering)
 		{
@@ -1938,8 +3185,13 @@ BOOL DxRenderer::DrawAO() {
 						ssao->AOCoefficientResource(Shading::SSAO::Resource::AO::E_AOCoefficient),
 						ssao->AOCoefficientDescriptor(Shading::SSAO::Descriptor::AO::ES_AOCoefficient),
 						Shading::SVGF::Value::E_Contrast,
-						FALSE));
-					
+						CheckerboardEnabled));
+					// Interpolate the variance for the inactive cells from the valid checkerboard cells.
+					if (CheckerboardEnabled) {
+						CheckReturn(mpLogFile, svgf->FillInCheckerboard(
+							mpCurrentFrameResource,
+							CheckerboardEnabled));
+					}
 					// Blends reprojected values with current frame values.
 					// Inactive pixels are filtered from active neighbors on checkerboard sampling before the blending operation.
 					{
@@ -2035,8 +3287,8 @@ BOOL DxRenderer::IntegrateIrradiance() {
 
 	CheckReturn(mpLogFile, brdf->IntegrateIrradiance(
 		mpCurrentFrameResource,
-		mSwapChain->ScreenViewport(),
-		mSwapChain->ScissorRect(),
+		mRenderViewport,
+		mRenderScissorRect,
 		tone->InterMediateMapResource(),
 		tone->InterMediateMapRtv(),
 		tone->InterMediateCopyMapResource(),
@@ -2055,8 +3307,6 @@ BOOL DxRenderer::IntegrateIrradiance() {
 		gbuffer->PositionMapSrv(),
 		AOMap,
 		AOSrv,
-		env->DiffuseIrradianceCubeMap(),
-		env->DiffuseIrradianceCubeMapSrv(),
 		env->BrdfLutMap(),
 		env->BrdfLutMapSrv(),
 		env->PrefilteredEnvironmentCubeMap(),
@@ -2072,23 +3322,18 @@ BOOL DxRenderer::ApplyVolumetricLight() {
 	const auto tone = mShadingObjectManager->Get<Shading::ToneMapping::ToneMappingClass>();
 	const auto gbuffer = mShadingObjectManager->Get<Shading::GBuffer::GBufferClass>();
 
-	std::vector<Common::Foundation::Light*> lights;
-	std::vector<Foundation::Resource::GpuResource*> depthMaps;
-
-	shadow->Lights(lights);
-	shadow->ZDepthMaps(depthMaps);
-
 	CheckReturn(mpLogFile, volume->BuildFog(
 		mpCurrentFrameResource,
-		depthMaps.data(),
-		shadow->ZDepthMapSrv(),
+		shadow->ZDepthAtlas(),
+		shadow->ZDepthAtlasSrv(),
 		mpCamera->NearZ(),
 		mpCamera->FarZ(),
 		mpShadingArgumentSet->VolumetricLight.DepthExponent,
 		mpShadingArgumentSet->VolumetricLight.UniformDensity,
 		mpShadingArgumentSet->VolumetricLight.DensityScale,
 		mpShadingArgumentSet->VolumetricLight.AnisotropicCoefficient,
-		shadow->LightCount()));
+		shadow->LightCount(),
+		mpShadingArgumentSet->VolumetricLight.ResolutionType == Common::Render::EffectResolution::E_Checkerboard));
 
 	CheckReturn(mpLogFile, volume->ApplyFog(
 		mpCurrentFrameResource,
@@ -2096,8 +3341,8 @@ BOOL DxRenderer::ApplyVolumetricLight() {
 		tone->InterMediateMapRtv(),
 		gbuffer->PositionMap(),
 		gbuffer->PositionMapSrv(),
-		mSwapChain->ScreenViewport(),
-		mSwapChain->ScissorRect(),
+		mRenderViewport,
+		mRenderScissorRect,
 		mpCamera->NearZ(), mpCamera->FarZ(), mpShadingArgumentSet->VolumetricLight.DepthExponent,
 		mpShadingArgumentSet->VolumetricLight.TricubicSamplingEnabled));
 
@@ -2144,8 +3389,8 @@ BOOL DxRenderer::ApplyDOF() {
 
 	CheckReturn(mpLogFile, dof->Bokeh(
 		mpCurrentFrameResource,
-		mSwapChain->ScreenViewport(),
-		mSwapChain->ScissorRect(),
+		mRenderViewport,
+		mRenderScissorRect,
 		tone->InterMediateMapResource(),
 		tone->InterMediateMapRtv(),
 		tone->InterMediateCopyMapResource(),
@@ -2157,8 +3402,8 @@ BOOL DxRenderer::ApplyDOF() {
 
 	CheckReturn(mpLogFile, dof->BokehBlur(
 		mpCurrentFrameResource,
-		mSwapChain->ScreenViewport(),
-		mSwapChain->ScissorRect(),
+		mRenderViewport,
+		mRenderScissorRect,
 		tone->InterMediateMapResource(),
 		tone->InterMediateMapRtv(),
 		tone->InterMediateCopyMapResource(),
@@ -2218,17 +3463,21 @@ BOOL DxRenderer::ApplyBloom() {
 		mpShadingArgumentSet->Bloom.SoftKnee,
 		downSampleFunc));
 
+	const BOOL HalfResolutionEnabled = 
+		mpShadingArgumentSet->Bloom.ResolutionType == Common::Render::EffectResolution::E_HalfResolution;
+
 	CheckReturn(mpLogFile, bloom->BlurHighlights(
-		mpCurrentFrameResource, downSampleFunc, blurFunc));
+		mpCurrentFrameResource, downSampleFunc, blurFunc, HalfResolutionEnabled));
 
 	CheckReturn(mpLogFile, bloom->ApplyBloom(
 		mpCurrentFrameResource,
-		mSwapChain->ScreenViewport(),
-		mSwapChain->ScissorRect(),
+		mRenderViewport,
+		mRenderScissorRect,
 		tone->InterMediateMapResource(),
 		tone->InterMediateMapRtv(),
 		tone->InterMediateCopyMapResource(),
-		tone->InterMediateCopyMapSrv()));
+		tone->InterMediateCopyMapSrv(),
+		HalfResolutionEnabled));
 
 	return TRUE;
 }
@@ -0,0 +1,33 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/AsyncComputeTracker.hpp"
+
+using namespace Render::DX::Foundation::Core;
+
+void AsyncComputeTracker::Reset(UINT resourceCount) {
+	mAccesses.assign(resourceCount, E_None);
+	mbInFlight = FALSE;
+}
+
+BOOL AsyncComputeTracker::NeedsJoin(UINT resource, BOOL write, D3D12_RESOURCE_STATES state, D3D12_RESOURCE_STATES currState) const {
+	if (!mbInFlight) return FALSE;
+
+	const auto Access = mAccesses[resource];
+	if (Access == E_None) return FALSE;
+	if (Access == E_Write || write) return TRUE;
+
+	return state != currState;
+}
+
+void AsyncComputeTracker::Join() {
+	std::fill(mAccesses.begin(), mAccesses.end(), E_None);
+	mbInFlight = FALSE;
+}
+
+void AsyncComputeTracker::Use(UINT resource, BOOL write) {
+	if (write) mAccesses[resource] = E_Write;
+	else if (mAccesses[resource] == E_None) mAccesses[resource] = E_Read;
+}
+
+void AsyncComputeTracker::Fork() {
+	mbInFlight = TRUE;
+}
\ No newline at end of file
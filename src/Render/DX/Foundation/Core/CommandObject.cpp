@@ -1,5 +1,9 @@
 #include "Render/Dx/Foundation/Core/pch_d3d12.h"
 #include "Render/DX/Foundation/Core/CommandObject.hpp"
+
+#include <chrono>
+#include <future>
+
 #include "Common/Debug/Logger.hpp"
 #include "Render/DX/Foundation/Core/Device.hpp"
 #include "Render/DX/Foundation/Util/D3D12Util.hpp"
@@ -60,6 +64,7 @@ BOOL CommandObject::Initialize(Common::Debug::LogFile* const pLogFile, Device* c
 	CheckReturn(mpLogFile, CreateCommandQueue());
 	CheckReturn(mpLogFile, CreateDirectCommandObjects());
 	CheckReturn(mpLogFile, CreateMultiCommandObjects(mThreadCount));
+	CheckReturn(mpLogFile, CreateComputeCommandObjects());
 	CheckReturn(mpLogFile, CreateFence());
 
 	return TRUE;
@@ -68,9 +73,16 @@ BOOL CommandObject::Initialize(Common::Debug::LogFile* const pLogFile, Device* c
 void CommandObject::CleanUp() {
 	if (mpCleanedUp) return;
 
+	if (mComputeQueue && mComputeFence) FlushComputeQueue();
 	FlushCommandQueue();
 
 	if (mFence) mFence.Reset();
+	if (mForkFence) mForkFence.Reset();
+	if (mComputeFence) mComputeFence.Reset();
+
+	if (mComputeCommandList) mComputeCommandList.Reset();
+	if (mComputeCmdListAlloc) mComputeCmdListAlloc.Reset();
+	if (mComputeQueue) mComputeQueue.Reset();
 
 	for (UINT i = 0; i < mThreadCount; ++i) {
 		auto& cmdList = mMultiCommandLists[i];
@@ -129,11 +141,20 @@ BOOL CommandObject::ExecuteDirectCommandList() {
 
 BOOL CommandObject::ResetDirectCommandList(ID3D12PipelineState* const pPipelineState) {
 	CheckHRESULT(mpLogFile, mDirectCommandList->Reset(mDirectCmdListAlloc.Get(), pPipelineState));
+	FlushPendingCommands(mDirectCommandList.Get());
 
 	return TRUE;
 }
 
 BOOL CommandObject::ExecuteCommandList(UINT index) {
+	if (mbAsyncCompute) {
+		const auto cmdList = mComputeCommandList.Get();
+		CheckHRESULT(mpLogFile, cmdList->Close());
+		mComputeQueue->ExecuteCommandLists(1, reinterpret_cast<ID3D12CommandList* const*>(&cmdList));
+
+		return TRUE;
+	}
+
 	const auto cmdList = mMultiCommandLists[index].Get();
 	CheckHRESULT(mpLogFile, cmdList->Close());
 	mCommandQueue->ExecuteCommandLists(1, reinterpret_cast<ID3D12CommandList* const*>(&cmdList));
@@ -142,22 +163,21 @@ BOOL CommandObject::ExecuteCommandList(UINT index) {
 }
 
 BOOL CommandObject::ResetCommandList(ID3D12CommandAllocator* const pAlloc, UINT index, ID3D12PipelineState* const pPipelineState) {
+	if (mbAsyncCompute) {
+		CheckHRESULT(mpLogFile, mComputeCommandList->Reset(mpComputeAlloc, pPipelineState));
+		FlushPendingCommands(mComputeCommandList.Get());
+
+		return TRUE;
+	}
+
 	CheckHRESULT(mpLogFile, mMultiCommandLists[index]->Reset(pAlloc, pPipelineState));
+	FlushPendingCommands(mMultiCommandLists[index].Get());
 
 	return TRUE;
 }
 
 BOOL CommandObject::ExecuteCommandLists() {
-	std::vector<ID3D12CommandList*> cmdLists(mThreadCount);
-
-	for (UINT i = 0; i < mThreadCount; ++i) {
-		const auto cmdList = mMultiCommandLists[i].Get();
-		CheckHRESULT(mpLogFile, cmdList->Close());
-
-		cmdLists.push_back(cmdList);
-	}
-	
-	mCommandQueue->ExecuteCommandLists(mThreadCount, cmdLists.data());
+	CheckReturn(mpLogFile, ExecuteCommandLists(mThreadCount));
 
 	return TRUE;
 }
@@ -167,6 +187,74 @@ BOOL CommandObject::ResetCommandLists(ID3D12CommandAllocator* const allocs[], ID
 		const auto alloc = allocs[i];
 		CheckHRESULT(mpLogFile, mMultiCommandLists[i]->Reset(alloc, pPipelineState));
 	}
+	if (mThreadCount > 0) FlushPendingCommands(mMultiCommandLists[0].Get());
+
+	return TRUE;
+}
+
+BOOL CommandObject::RecordCommandLists(
+		ID3D12CommandAllocator* const allocs[],
+		UINT count,
+		ID3D12PipelineState* const pPipelineState,
+		const RecordFunc& func) {
+	using Clock = std::chrono::steady_clock;
+
+	count = std::max(1u, std::min(count, mThreadCount));
+
+	const auto Begin = Clock::now();
+
+	// The calling thread owns list 0, so the pending barriers are
+	// flushed before any worker starts.
+	CheckReturn(mpLogFile, ResetCommandList(allocs[0], 0, pPipelineState));
+
+	std::vector<FLOAT> busyTimes(count);
+	const auto Record = [&](UINT worker) -> BOOL {
+		const auto Start = Clock::now();
+		const auto CmdList = mMultiCommandLists[worker].Get();
+
+		if (worker != 0) CheckHRESULT(mpLogFile, CmdList->Reset(allocs[worker], pPipelineState));
+		const BOOL result = func(CmdList, worker);
+
+		busyTimes[worker] = std::chrono::duration<FLOAT, std::milli>(Clock::now() - Start).count();
+
+		return result;
+	};
+
+	std::vector<std::future<BOOL>> workers{};
+	workers.reserve(count - 1);
+
+	for (UINT i = 1; i < count; ++i)
+		workers.emplace_back(std::async(std::launch::async, Record, i));
+
+	BOOL status = Record(0);
+	for (auto& worker : workers)
+		status = worker.get() && status;
+
+	mRecordStats.WorkerCount = count;
+	mRecordStats.WallTime = std::chrono::duration<FLOAT, std::milli>(Clock::now() - Begin).count();
+	mRecordStats.BusyTime = 0.f;
+	for (const auto time : busyTimes)
+		mRecordStats.BusyTime += time;
+
+	if (!status) ReturnFalse(mpLogFile, L"Failed to record command lists");
+
+	return TRUE;
+}
+
+BOOL CommandObject::ExecuteCommandLists(UINT count) {
+	count = std::min(count, mThreadCount);
+
+	std::vector<ID3D12CommandList*> cmdLists{};
+	cmdLists.reserve(count);
+
+	for (UINT i = 0; i < count; ++i) {
+		const auto cmdList = mMultiCommandLists[i].Get();
+		CheckHRESULT(mpLogFile, cmdList->Close());
+
+		cmdLists.push_back(cmdList);
+	}
+
+	mCommandQueue->ExecuteCommandLists(count, cmdLists.data());
 
 	return TRUE;
 }
@@ -199,6 +287,72 @@ BOOL CommandObject::Signal() {
 	return TRUE;
 }
 
+BOOL CommandObject::WaitOnQueue(ID3D12Fence* const pFence, UINT64 value) {
+	if (value == 0) return TRUE;
+
+	CheckHRESULT(mpLogFile, mCommandQueue->Wait(pFence, value));
+
+	return TRUE;
+}
+
+void CommandObject::QueueBarriers(const std::vector<D3D12_RESOURCE_BARRIER>& barriers) {
+	mPendingBarriers.insert(mPendingBarriers.end(), barriers.begin(), barriers.end());
+}
+
+void CommandObject::QueueDiscard(ID3D12Resource* const pResource) {
+	mPendingDiscards.push_back(pResource);
+}
+
+BOOL CommandObject::BeginAsyncCompute(ID3D12CommandAllocator* const pDirectAlloc, ID3D12CommandAllocator* const pComputeAlloc) {
+	if (mbAsyncCompute) ReturnFalse(mpLogFile, L"Async compute recording has already begun");
+
+	// The compute queue cannot make most graphics transitions, so whatever
+	// is pending is recorded on the direct queue.
+	if (!mPendingBarriers.empty() || !mPendingDiscards.empty()) {
+		CheckReturn(mpLogFile, ResetCommandList(pDirectAlloc, 0));
+		CheckReturn(mpLogFile, ExecuteCommandList(0));
+	}
+
+	CheckHRESULT(mpLogFile, mCommandQueue->Signal(mForkFence.Get(), ++mForkFenceValue));
+	CheckHRESULT(mpLogFile, mComputeQueue->Wait(mForkFence.Get(), mForkFenceValue));
+
+	mpComputeAlloc = pComputeAlloc;
+	mbAsyncCompute = TRUE;
+
+	return TRUE;
+}
+
+BOOL CommandObject::EndAsyncCompute() {
+	if (!mbAsyncCompute) ReturnFalse(mpLogFile, L"Async compute recording has not begun");
+
+	mbAsyncCompute = FALSE;
+	mpComputeAlloc = nullptr;
+
+	CheckHRESULT(mpLogFile, mComputeQueue->Signal(mComputeFence.Get(), ++mComputeFenceValue));
+
+	return TRUE;
+}
+
+BOOL CommandObject::JoinAsyncCompute() {
+	if (mJoinedComputeFence == mComputeFenceValue) return TRUE;
+
+	CheckHRESULT(mpLogFile, mCommandQueue->Wait(mComputeFence.Get(), mComputeFenceValue));
+	mJoinedComputeFence = mComputeFenceValue;
+
+	return TRUE;
+}
+
+void CommandObject::FlushPendingCommands(ID3D12GraphicsCommandList* const pCmdList) {
+	if (!mPendingBarriers.empty()) {
+		pCmdList->ResourceBarrier(static_cast<UINT>(mPendingBarriers.size()), mPendingBarriers.data());
+		mPendingBarriers.clear();
+	}
+
+	for (const auto resource : mPendingDiscards)
+		pCmdList->DiscardResource(resource, nullptr);
+	mPendingDiscards.clear();
+}
+
 #ifdef _DEBUG
 BOOL CommandObject::CreateDebugObjects() {
 	CheckReturn(mpLogFile, mpDevice->QueryInterface(mInfoQueue));
@@ -208,8 +362,27 @@ BOOL CommandObject::CreateDebugObjects() {
 }
 #endif
 
+BOOL CommandObject::FlushComputeQueue() {
+	CheckHRESULT(mpLogFile, mComputeQueue->Signal(mComputeFence.Get(), ++mComputeFenceValue));
+
+	if (mComputeFence->GetCompletedValue() < mComputeFenceValue) {
+		const HANDLE eventHandle = CreateEventEx(nullptr, FALSE, FALSE, EVENT_ALL_ACCESS);
+		if (eventHandle == NULL) return FALSE;
+
+		CheckHRESULT(mpLogFile, mComputeFence->SetEventOnCompletion(mComputeFenceValue, eventHandle));
+
+		WaitForSingleObject(eventHandle, INFINITE);
+		CloseHandle(eventHandle);
+	}
+
+	mJoinedComputeFence = mComputeFenceValue;
+
+	return TRUE;
+}
+
 BOOL CommandObject::CreateCommandQueue() {
 	CheckReturn(mpLogFile, mpDevice->CreateCommandQueue(mCommandQueue));
+	CheckReturn(mpLogFile, mpDevice->CreateCommandQueue(mComputeQueue, D3D12_COMMAND_LIST_TYPE_COMPUTE));
 
 	return TRUE;
 }
@@ -228,8 +401,18 @@ BOOL CommandObject::CreateMultiCommandObjects(UINT numThreads) {
 	return TRUE;
 }
 
+BOOL CommandObject::CreateComputeCommandObjects() {
+	CheckReturn(mpLogFile, mpDevice->CreateCommandAllocator(mComputeCmdListAlloc, D3D12_COMMAND_LIST_TYPE_COMPUTE));
+	CheckReturn(mpLogFile, mpDevice->CreateCommandList(
+		mComputeCmdListAlloc.Get(), mComputeCommandList, D3D12_COMMAND_LIST_TYPE_COMPUTE));
+
+	return TRUE;
+}
+
 BOOL CommandObject::CreateFence() {
 	CheckReturn(mpLogFile, mpDevice->CreateFence(mFence));
+	CheckReturn(mpLogFile, mpDevice->CreateFence(mForkFence));
+	CheckReturn(mpLogFile, mpDevice->CreateFence(mComputeFence));
 
 	return TRUE;
 }
\ No newline at end of file
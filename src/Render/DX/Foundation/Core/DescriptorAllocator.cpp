@@ -0,0 +1,64 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/DescriptorAllocator.hpp"
+
+using namespace Render::DX::Foundation::Core;
+
+void DescriptorAllocator::Initialize(const Layout& layout) {
+	mLayout = layout;
+	if (mLayout.FrameCount == 0) mLayout.FrameCount = 1;
+
+	mNextPersistent = 0;
+
+	// Popped from the back, so the lowest slots go out first.
+	mFreeSlots.resize(mLayout.SlotCount);
+	for (UINT i = 0; i < mLayout.SlotCount; ++i)
+		mFreeSlots[i] = mLayout.SlotCount - 1 - i;
+
+	while (!mRetiredSlots.empty()) mRetiredSlots.pop();
+
+	mTransientBegin = TransientBase();
+	mNextTransient = mTransientBegin;
+}
+
+BOOL DescriptorAllocator::AllocateRange(UINT count, UINT& index) {
+	if (mNextPersistent + count > mLayout.PersistentCount) return FALSE;
+
+	index = mNextPersistent;
+	mNextPersistent += count;
+
+	return TRUE;
+}
+
+BOOL DescriptorAllocator::AllocateSlot(UINT& slot) {
+	if (mFreeSlots.empty()) return FALSE;
+
+	slot = mFreeSlots.back();
+	mFreeSlots.pop_back();
+
+	return TRUE;
+}
+
+void DescriptorAllocator::FreeSlot(UINT slot, UINT64 fence) {
+	mRetiredSlots.emplace(fence, slot);
+}
+
+void DescriptorAllocator::ReleaseSlots(UINT64 completedFence) {
+	while (!mRetiredSlots.empty() && mRetiredSlots.front().first <= completedFence) {
+		mFreeSlots.push_back(mRetiredSlots.front().second);
+		mRetiredSlots.pop();
+	}
+}
+
+void DescriptorAllocator::BeginFrame(UINT frameIndex) {
+	mTransientBegin = TransientBase() + (frameIndex % mLayout.FrameCount) * mLayout.TransientCountPerFrame;
+	mNextTransient = mTransientBegin;
+}
+
+BOOL DescriptorAllocator::AllocateTransient(UINT count, UINT& index) {
+	if (mNextTransient + count > mTransientBegin + mLayout.TransientCountPerFrame) return FALSE;
+
+	index = mNextTransient;
+	mNextTransient += count;
+
+	return TRUE;
+}
\ No newline at end of file
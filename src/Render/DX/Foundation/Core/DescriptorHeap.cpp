@@ -38,10 +38,20 @@ void DescriptorHeap::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL DescriptorHeap::CreateDescriptorHeaps(UINT numCbvSrvUav, UINT numRtv, UINT numDsv) {
+BOOL DescriptorHeap::CreateDescriptorHeaps(
+		UINT numCbvSrvUav, UINT numRtv, UINT numDsv,
+		UINT numTextureSlots, UINT numTransientsPerFrame, UINT numFrames) {
 	CheckReturn(mpLogFile, mDevice->CreateRtvDescriptorHeap(mRtvHeap, mpSwapChain->RtvDescCount() + mpDepthStencilBuffer->RtvDescCount() + numRtv));	
 	CheckReturn(mpLogFile, mDevice->CreateDsvDescriptorHeap(mDsvHeap, mpSwapChain->DsvDescCount() + mpDepthStencilBuffer->DsvDescCount() + numDsv));
-	CheckReturn(mpLogFile, mDevice->CreateCbvUavSrvDescriptorHeap(mCbvSrvUavHeap, mpSwapChain->CbvSrvUavDescCount() + mpDepthStencilBuffer->CbvSrvUavDescCount() + numCbvSrvUav));
+
+	DescriptorAllocator::Layout layout{};
+	layout.PersistentCount = mpSwapChain->CbvSrvUavDescCount() + mpDepthStencilBuffer->CbvSrvUavDescCount() + numCbvSrvUav;
+	layout.SlotCount = numTextureSlots;
+	layout.TransientCountPerFrame = numTransientsPerFrame;
+	layout.FrameCount = numFrames;
+	mCbvSrvUavAllocator.Initialize(layout);
+
+	CheckReturn(mpLogFile, mDevice->CreateCbvUavSrvDescriptorHeap(mCbvSrvUavHeap, mCbvSrvUavAllocator.Capacity()));
 
 	return TRUE;
 }
@@ -57,6 +67,25 @@ BOOL DescriptorHeap::BuildDescriptors() {
 	mhCpuRtv = CD3DX12_CPU_DESCRIPTOR_HANDLE(rtvCpuStart);
 	mhCpuDsv = CD3DX12_CPU_DESCRIPTOR_HANDLE(dsvCpuStart);
 
+	mhCpuCbvSrvUavStart = cpuStart;
+	mhGpuCbvSrvUavStart = gpuStart;
+
+	// CbvSrvUavCpuOffset walks these one by one.
+	UINT persistentBase{};
+	if (!mCbvSrvUavAllocator.AllocateRange(mCbvSrvUavAllocator.SlotBase(), persistentBase))
+		ReturnFalse(mpLogFile, L"Persistent descriptors are already reserved");
+
+	// Empty slots read as zero instead of whatever the heap held.
+	D3D12_SHADER_RESOURCE_VIEW_DESC nullDesc{};
+	nullDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	nullDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	nullDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	nullDesc.Texture2D.MipLevels = 1;
+
+	const UINT SlotCount = mCbvSrvUavAllocator.TransientBase() - mCbvSrvUavAllocator.SlotBase();
+	for (UINT i = 0; i < SlotCount; ++i)
+		mDevice->CreateShaderResourceView(nullptr, &nullDesc, TextureSlotCpuHandle(i));
+
 	return TRUE;
 }
 
@@ -68,6 +97,38 @@ BOOL DescriptorHeap::SetDescriptorHeap(ID3D12GraphicsCommandList4* const pCmdLis
 	return TRUE;
 }
 
+BOOL DescriptorHeap::AllocateTextureSlot(UINT& slot) {
+	if (!mCbvSrvUavAllocator.AllocateSlot(slot)) ReturnFalse(mpLogFile, L"Out of bindless texture slots");
+
+	return TRUE;
+}
+
+void DescriptorHeap::FreeTextureSlot(UINT slot, UINT64 fence) {
+	mCbvSrvUavAllocator.FreeSlot(slot, fence);
+}
+
+void DescriptorHeap::ReleaseTextureSlots(UINT64 completedFence) {
+	mCbvSrvUavAllocator.ReleaseSlots(completedFence);
+}
+
+void DescriptorHeap::BeginFrame(UINT frameIndex) {
+	mCbvSrvUavAllocator.BeginFrame(frameIndex);
+}
+
+BOOL DescriptorHeap::AllocateTransient(
+		UINT count,
+		D3D12_CPU_DESCRIPTOR_HANDLE& hCpu,
+		D3D12_GPU_DESCRIPTOR_HANDLE& hGpu) {
+	UINT index{};
+	if (!mCbvSrvUavAllocator.AllocateTransient(count, index)) 
+		ReturnFalse(mpLogFile, L"Out of transient descriptors for this frame");
+
+	hCpu = CD3DX12_CPU_DESCRIPTOR_HANDLE(mhCpuCbvSrvUavStart, static_cast<INT>(index), mCbvSrvUavDescriptorSize);
+	hGpu = CD3DX12_GPU_DESCRIPTOR_HANDLE(mhGpuCbvSrvUavStart, static_cast<INT>(index), mCbvSrvUavDescriptorSize);
+
+	return TRUE;
+}
+
 BOOL DescriptorHeap::BuildDescriptorSizes() {
 	mRtvDescriptorSize = mDevice->DescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 	mDsvDescriptorSize = mDevice->DescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
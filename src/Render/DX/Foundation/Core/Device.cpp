@@ -2,6 +2,7 @@
 #include "Render/DX/Foundation/Core/Device.hpp"
 #include "Common/Debug/Logger.hpp"
 #include "Render/DX/Foundation/Core/Factory.hpp"
+#include "Render/DX/Foundation/Core/PipelineStateCache.hpp"
 #include "Render/DX/Foundation/Resource/GpuResource.hpp"
 #include "Render/DX/Foundation/Util/D3D12Util.hpp"
 
@@ -34,27 +35,32 @@ BOOL Device::QueryInterface(Microsoft::WRL::ComPtr<ID3D12InfoQueue1>& pInfoQueue
 	return TRUE;
 }
 
-BOOL Device::CreateCommandQueue(Microsoft::WRL::ComPtr<ID3D12CommandQueue>& pCommandQueue) {
+BOOL Device::CreateCommandQueue(
+		Microsoft::WRL::ComPtr<ID3D12CommandQueue>& pCommandQueue,
+		D3D12_COMMAND_LIST_TYPE type) {
 	D3D12_COMMAND_QUEUE_DESC queueDesc = {};
-	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+	queueDesc.Type = type;
 	queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
 	CheckHRESULT(mpLogFile, md3dDevice->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&pCommandQueue)));
 
 	return TRUE;
 }
 
-BOOL Device::CreateCommandAllocator(Microsoft::WRL::ComPtr<ID3D12CommandAllocator>& pCommandAllocator) {
-	CheckHRESULT(mpLogFile, md3dDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&pCommandAllocator)));
+BOOL Device::CreateCommandAllocator(
+		Microsoft::WRL::ComPtr<ID3D12CommandAllocator>& pCommandAllocator,
+		D3D12_COMMAND_LIST_TYPE type) {
+	CheckHRESULT(mpLogFile, md3dDevice->CreateCommandAllocator(type, IID_PPV_ARGS(&pCommandAllocator)));
 
 	return TRUE;
 }
 
 BOOL Device::CreateCommandList(
 		ID3D12CommandAllocator* const pCommandAllocator,
-		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList6>& pCommandList) {
+		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList6>& pCommandList,
+		D3D12_COMMAND_LIST_TYPE type) {
 	CheckHRESULT(mpLogFile, md3dDevice->CreateCommandList(
 		0,
-		D3D12_COMMAND_LIST_TYPE_DIRECT,
+		type,
 		pCommandAllocator,	// Associated command allocator
 		nullptr,			// Initial PipelineStateObject
 		IID_PPV_ARGS(&pCommandList)
@@ -159,10 +165,11 @@ BOOL Device::CreateRootSignature(
 		riid,
 		ppRootSignature));
 
-	if (name != nullptr) {
-		auto rootSig = reinterpret_cast<ID3D12RootSignature*>(*ppRootSignature);
-		rootSig->SetName(name);
-	}
+	auto rootSig = reinterpret_cast<ID3D12RootSignature*>(*ppRootSignature);
+	PipelineStateCache::TagRootSignature(
+		rootSig, serializedRootSig->GetBufferPointer(), serializedRootSig->GetBufferSize());
+
+	if (name != nullptr) rootSig->SetName(name);
 
 	return TRUE;
 }
@@ -209,7 +216,12 @@ BOOL Device::CreateComputePipelineState(
 		const IID& riid,
 		void** const ppPipelineState,
 		LPCWSTR name) {
-	CheckHRESULT(mpLogFile, md3dDevice->CreateComputePipelineState(&desc, riid, ppPipelineState));
+	if (mpPipelineStateCache != nullptr) {
+		CheckReturn(mpLogFile, mpPipelineStateCache->CreateComputePipelineState(desc, riid, ppPipelineState, name));
+	}
+	else {
+		CheckHRESULT(mpLogFile, md3dDevice->CreateComputePipelineState(&desc, riid, ppPipelineState));
+	}
 
 	if (name != nullptr) {
 		auto pso = reinterpret_cast<ID3D12PipelineState*>(*ppPipelineState);
@@ -224,7 +236,12 @@ BOOL Device::CreateGraphicsPipelineState(
 		const IID& riid,
 		void** const ppPipelineState,
 		LPCWSTR name) {
-	CheckHRESULT(mpLogFile, md3dDevice->CreateGraphicsPipelineState(&desc, riid, ppPipelineState));
+	if (mpPipelineStateCache != nullptr) {
+		CheckReturn(mpLogFile, mpPipelineStateCache->CreateGraphicsPipelineState(desc, riid, ppPipelineState, name));
+	}
+	else {
+		CheckHRESULT(mpLogFile, md3dDevice->CreateGraphicsPipelineState(&desc, riid, ppPipelineState));
+	}
 
 	if (name != nullptr) {
 		auto pso = reinterpret_cast<ID3D12PipelineState*>(*ppPipelineState);
@@ -239,13 +256,18 @@ BOOL Device::CreatePipelineState(
 		const IID& riid,
 		void** const ppPipelineState,
 		LPCWSTR name) {
-	auto meshStreamDesc = CD3DX12_PIPELINE_MESH_STATE_STREAM(desc);
+	if (mpPipelineStateCache != nullptr) {
+		CheckReturn(mpLogFile, mpPipelineStateCache->CreatePipelineState(desc, riid, ppPipelineState, name));
+	}
+	else {
+		auto meshStreamDesc = CD3DX12_PIPELINE_MESH_STATE_STREAM(desc);
 
-	D3D12_PIPELINE_STATE_STREAM_DESC streamDesc = {};
-	streamDesc.SizeInBytes = sizeof(meshStreamDesc);
-	streamDesc.pPipelineStateSubobjectStream = &meshStreamDesc;
+		D3D12_PIPELINE_STATE_STREAM_DESC streamDesc = {};
+		streamDesc.SizeInBytes = sizeof(meshStreamDesc);
+		streamDesc.pPipelineStateSubobjectStream = &meshStreamDesc;
 
-	CheckHRESULT(mpLogFile, md3dDevice->CreatePipelineState(&streamDesc, riid, ppPipelineState));
+		CheckHRESULT(mpLogFile, md3dDevice->CreatePipelineState(&streamDesc, riid, ppPipelineState));
+	}
 
 	if (name != nullptr) {
 		auto pso = reinterpret_cast<ID3D12PipelineState*>(*ppPipelineState);
@@ -107,17 +107,29 @@ BOOL Factory::GetAdapters(std::vector<std::wstring>& adapters) {
 }
 
 BOOL Factory::SelectAdapter(Device* const pDevice, UINT adapterIndex, BOOL& bRaytracingSupported) {
-	const auto& adapter = mAdapters[adapterIndex].second;
+	CheckReturn(mpLogFile, CreateDevice(pDevice, mAdapters[adapterIndex].second.Get(), bRaytracingSupported));
 
-	// Try to create hardware device.
+	return TRUE;
+}
+
+BOOL Factory::SelectWarpAdapter(Device* const pDevice, BOOL& bRaytracingSupported) {
+	ComPtr<IDXGIAdapter1> adapter{};
+	CheckHRESULT(mpLogFile, mDxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter)));
+
+	CheckReturn(mpLogFile, CreateDevice(pDevice, adapter.Get(), bRaytracingSupported));
+
+	return TRUE;
+}
+
+BOOL Factory::CreateDevice(Device* const pDevice, IDXGIAdapter1* const pAdapter, BOOL& bRaytracingSupported) {
 	const HRESULT hr = D3D12CreateDevice(
-		adapter.Get(),
+		pAdapter,
 		D3D_FEATURE_LEVEL_12_1,
 		IID_PPV_ARGS(pDevice->md3dDevice.GetAddressOf()));		
 	if (FAILED(hr)) ReturnFalse(mpLogFile, L"Failed to create device");
 
 	DXGI_ADAPTER_DESC desc;
-	adapter->GetDesc(&desc);
+	pAdapter->GetDesc(&desc);
 
 #ifdef _DEBUG
 	WLogln(mpLogFile, desc.Description, L" is selected");
@@ -0,0 +1,349 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/PipelineStateCache.hpp"
+#include "Common/Debug/Logger.hpp"
+#include "Render/DX/Foundation/Core/Device.hpp"
+
+using namespace Render::DX::Foundation::Core;
+using namespace Microsoft::WRL;
+
+namespace {
+	// {4C6C1BF3-62DA-43F8-9D18-50854E9BBD02}
+	const GUID RootSignatureHashGuid = 
+		{ 0x4c6c1bf3, 0x62da, 0x43f8, { 0x9d, 0x18, 0x50, 0x85, 0x4e, 0x9b, 0xbd, 0x02 } };
+
+	// Descriptions are hashed field by field; hashing whole structs would
+	// pick up uninitialized padding and never hit.
+	template <typename T>
+	void HashValue(Common::Foundation::Hash& hash, const T& value) {
+		hash = Common::Util::HashUtil::HashCombine(hash, Common::Util::HashUtil::HashBytes(&value, sizeof(T)));
+	}
+
+	void HashString(Common::Foundation::Hash& hash, LPCWSTR str) {
+		if (str == nullptr) return;
+		hash = Common::Util::HashUtil::HashCombine(hash, Common::Util::HashUtil::HashBytes(str, wcslen(str) * sizeof(WCHAR)));
+	}
+
+	void HashBytecode(Common::Foundation::Hash& hash, const D3D12_SHADER_BYTECODE& bytecode) {
+		HashValue(hash, bytecode.BytecodeLength);
+		if (bytecode.BytecodeLength == 0) return;
+
+		hash = Common::Util::HashUtil::HashCombine(
+			hash, Common::Util::HashUtil::HashBytes(bytecode.pShaderBytecode, bytecode.BytecodeLength));
+	}
+
+	void HashRootSignature(Common::Foundation::Hash& hash, ID3D12RootSignature* const pRootSignature) {
+		if (pRootSignature == nullptr) {
+			HashValue(hash, 0);
+			return;
+		}
+
+		Common::Foundation::Hash blobHash = 0;
+		UINT size = sizeof(blobHash);
+		if (SUCCEEDED(pRootSignature->GetPrivateData(RootSignatureHashGuid, &size, &blobHash)) && size == sizeof(blobHash)) {
+			HashValue(hash, blobHash);
+			return;
+		}
+
+		// Untagged root signatures fall back to their address, which keeps
+		// distinct ones apart and only misses the library across runs.
+		HashValue(hash, reinterpret_cast<UINT_PTR>(pRootSignature));
+	}
+
+	void HashBlend(Common::Foundation::Hash& hash, const D3D12_BLEND_DESC& desc) {
+		HashValue(hash, desc.AlphaToCoverageEnable);
+		HashValue(hash, desc.IndependentBlendEnable);
+
+		for (const auto& target : desc.RenderTarget) {
+			HashValue(hash, target.BlendEnable);
+			HashValue(hash, target.LogicOpEnable);
+			HashValue(hash, target.SrcBlend);
+			HashValue(hash, target.DestBlend);
+			HashValue(hash, target.BlendOp);
+			HashValue(hash, target.SrcBlendAlpha);
+			HashValue(hash, target.DestBlendAlpha);
+			HashValue(hash, target.BlendOpAlpha);
+			HashValue(hash, target.LogicOp);
+			HashValue(hash, target.RenderTargetWriteMask);
+		}
+	}
+
+	void HashRasterizer(Common::Foundation::Hash& hash, const D3D12_RASTERIZER_DESC& desc) {
+		HashValue(hash, desc.FillMode);
+		HashValue(hash, desc.CullMode);
+		HashValue(hash, desc.FrontCounterClockwise);
+		HashValue(hash, desc.DepthBias);
+		HashValue(hash, desc.DepthBiasClamp);
+		HashValue(hash, desc.SlopeScaledDepthBias);
+		HashValue(hash, desc.DepthClipEnable);
+		HashValue(hash, desc.MultisampleEnable);
+		HashValue(hash, desc.AntialiasedLineEnable);
+		HashValue(hash, desc.ForcedSampleCount);
+		HashValue(hash, desc.ConservativeRaster);
+	}
+
+	void HashDepthStencil(Common::Foundation::Hash& hash, const D3D12_DEPTH_STENCIL_DESC& desc) {
+		HashValue(hash, desc.DepthEnable);
+		HashValue(hash, desc.DepthWriteMask);
+		HashValue(hash, desc.DepthFunc);
+		HashValue(hash, desc.StencilEnable);
+		HashValue(hash, desc.StencilReadMask);
+		HashValue(hash, desc.StencilWriteMask);
+		HashValue(hash, desc.FrontFace);
+		HashValue(hash, desc.BackFace);
+	}
+
+	void HashTargets(
+			Common::Foundation::Hash& hash,
+			UINT numRenderTargets,
+			const DXGI_FORMAT* const pRtvFormats,
+			DXGI_FORMAT dsvFormat,
+			const DXGI_SAMPLE_DESC& sampleDesc) {
+		HashValue(hash, numRenderTargets);
+		for (UINT i = 0; i < numRenderTargets; ++i)
+			HashValue(hash, pRtvFormats[i]);
+		HashValue(hash, dsvFormat);
+		HashValue(hash, sampleDesc.Count);
+		HashValue(hash, sampleDesc.Quality);
+	}
+
+	std::wstring LibraryKey(Common::Foundation::Hash hash) {
+		return std::format(L"{:016x}", static_cast<UINT64>(hash));
+	}
+}
+
+PipelineStateCache::PipelineStateCache() {}
+
+PipelineStateCache::~PipelineStateCache() { CleanUp(); }
+
+BOOL PipelineStateCache::Initialize(Common::Debug::LogFile* const pLogFile, Device* const pDevice, LPCWSTR filePath) {
+	mpLogFile = pLogFile;
+	mpDevice = pDevice;
+	mFilePath = filePath;
+
+	std::ifstream fin(mFilePath, std::ios::ate | std::ios::binary);
+	if (fin.is_open()) {
+		const size_t FileSize = static_cast<size_t>(fin.tellg());
+		mLibraryData.resize(FileSize);
+
+		fin.seekg(0);
+		fin.read(mLibraryData.data(), FileSize);
+		fin.close();
+	}
+
+	// A library from another adapter or driver is rejected by the runtime;
+	// start over with an empty one in that case.
+	if (mLibraryData.empty() || !CreateLibrary(mLibraryData.data(), mLibraryData.size())) {
+		mLibraryData.clear();
+		if (!CreateLibrary(nullptr, 0))
+			WLogln(mpLogFile, L"Pipeline libraries are not supported; pipeline states will not be cached");
+	}
+
+	return TRUE;
+}
+
+void PipelineStateCache::TagRootSignature(
+		ID3D12RootSignature* const pRootSignature, 
+		const void* const pBlob, 
+		SIZE_T size) {
+	const auto BlobHash = Common::Util::HashUtil::HashBytes(pBlob, size);
+	pRootSignature->SetPrivateData(RootSignatureHashGuid, sizeof(BlobHash), &BlobHash);
+}
+
+std::wstring PipelineStateCache::PipelineKey(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, LPCWSTR name) {
+	Common::Foundation::Hash hash = 0;
+	HashString(hash, name);
+	HashRootSignature(hash, desc.pRootSignature);
+	HashBytecode(hash, desc.CS);
+	HashValue(hash, desc.NodeMask);
+	HashValue(hash, desc.Flags);
+
+	return LibraryKey(hash);
+}
+
+std::wstring PipelineStateCache::PipelineKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, LPCWSTR name) {
+	Common::Foundation::Hash hash = 0;
+	HashString(hash, name);
+	HashRootSignature(hash, desc.pRootSignature);
+	HashBytecode(hash, desc.VS);
+	HashBytecode(hash, desc.PS);
+	HashBytecode(hash, desc.DS);
+	HashBytecode(hash, desc.HS);
+	HashBytecode(hash, desc.GS);
+	HashBlend(hash, desc.BlendState);
+	HashValue(hash, desc.SampleMask);
+	HashRasterizer(hash, desc.RasterizerState);
+	HashDepthStencil(hash, desc.DepthStencilState);
+	HashValue(hash, desc.InputLayout.NumElements);
+	for (UINT i = 0; i < desc.InputLayout.NumElements; ++i) {
+		const auto& element = desc.InputLayout.pInputElementDescs[i];
+		hash = Common::Util::HashUtil::HashCombine(hash, std::hash<std::string_view>()(element.SemanticName));
+		HashValue(hash, element.SemanticIndex);
+		HashValue(hash, element.Format);
+		HashValue(hash, element.InputSlot);
+		HashValue(hash, element.AlignedByteOffset);
+		HashValue(hash, element.InputSlotClass);
+		HashValue(hash, element.InstanceDataStepRate);
+	}
+	HashValue(hash, desc.IBStripCutValue);
+	HashValue(hash, desc.PrimitiveTopologyType);
+	HashTargets(hash, desc.NumRenderTargets, desc.RTVFormats, desc.DSVFormat, desc.SampleDesc);
+	HashValue(hash, desc.NodeMask);
+	HashValue(hash, desc.Flags);
+
+	return LibraryKey(hash);
+}
+
+std::wstring PipelineStateCache::PipelineKey(const D3DX12_MESH_SHADER_PIPELINE_STATE_DESC& desc, LPCWSTR name) {
+	Common::Foundation::Hash hash = 0;
+	HashString(hash, name);
+	HashRootSignature(hash, desc.pRootSignature);
+	HashBytecode(hash, desc.AS);
+	HashBytecode(hash, desc.MS);
+	HashBytecode(hash, desc.PS);
+	HashBlend(hash, desc.BlendState);
+	HashValue(hash, desc.SampleMask);
+	HashRasterizer(hash, desc.RasterizerState);
+	HashDepthStencil(hash, desc.DepthStencilState);
+	HashValue(hash, desc.PrimitiveTopologyType);
+	HashTargets(hash, desc.NumRenderTargets, desc.RTVFormats, desc.DSVFormat, desc.SampleDesc);
+	HashValue(hash, desc.NodeMask);
+	HashValue(hash, desc.Flags);
+
+	return LibraryKey(hash);
+}
+
+void PipelineStateCache::CleanUp() {
+	if (mbCleanedUp) return;
+
+	mPipelineStates.clear();
+	mLibrary.Reset();
+	mLibraryData.clear();
+
+	mpDevice = nullptr;
+	mpLogFile = nullptr;
+	mbCleanedUp = TRUE;
+}
+
+BOOL PipelineStateCache::Serialize() {
+	std::lock_guard<std::mutex> lock(mTrackMutex);
+
+	if (!mbDirty || mLibrary == nullptr) return TRUE;
+
+	// Storing into a fresh library drops entries that no longer match
+	// anything the renderer creates.
+	ComPtr<ID3D12PipelineLibrary1> library{};
+	CheckHRESULT(mpLogFile, mpDevice->md3dDevice->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&library)));
+
+	for (const auto& pipelineState : mPipelineStates)
+		CheckHRESULT(mpLogFile, library->StorePipeline(pipelineState.first.c_str(), pipelineState.second.Get()));
+
+	const SIZE_T Size = library->GetSerializedSize();
+	std::vector<CHAR> data(Size);
+	CheckHRESULT(mpLogFile, library->Serialize(data.data(), Size));
+
+	const std::wstring TempPath = mFilePath + L".tmp";
+	{
+		std::ofstream fout(TempPath, std::ios::binary | std::ios::trunc);
+		if (!fout.is_open()) {
+			std::wstring msg(L"Failed to open pipeline library: ");
+			msg.append(TempPath);
+			ReturnFalse(mpLogFile, msg);
+		}
+
+		fout.write(data.data(), data.size());
+	}
+
+	std::error_code ec{};
+	std::filesystem::rename(TempPath, mFilePath, ec);
+	if (ec) {
+		std::wstring msg(L"Failed to write pipeline library: ");
+		msg.append(mFilePath);
+		ReturnFalse(mpLogFile, msg);
+	}
+
+	mbDirty = FALSE;
+
+	return TRUE;
+}
+
+BOOL PipelineStateCache::CreateComputePipelineState(
+		const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+		const IID& riid,
+		void** const ppPipelineState,
+		LPCWSTR name) {
+	const auto Key = PipelineKey(desc, name);
+
+	ComPtr<ID3D12PipelineState> pipelineState{};
+	const BOOL Loaded = mLibrary != nullptr
+		&& SUCCEEDED(mLibrary->LoadComputePipeline(Key.c_str(), &desc, IID_PPV_ARGS(&pipelineState)));
+	if (!Loaded)
+		CheckHRESULT(mpLogFile, mpDevice->md3dDevice->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pipelineState)));
+
+	Track(Key, pipelineState.Get(), Loaded);
+
+	CheckHRESULT(mpLogFile, pipelineState->QueryInterface(riid, ppPipelineState));
+
+	return TRUE;
+}
+
+BOOL PipelineStateCache::CreateGraphicsPipelineState(
+		const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+		const IID& riid,
+		void** const ppPipelineState,
+		LPCWSTR name) {
+	const auto Key = PipelineKey(desc, name);
+
+	ComPtr<ID3D12PipelineState> pipelineState{};
+	const BOOL Loaded = mLibrary != nullptr
+		&& SUCCEEDED(mLibrary->LoadGraphicsPipeline(Key.c_str(), &desc, IID_PPV_ARGS(&pipelineState)));
+	if (!Loaded)
+		CheckHRESULT(mpLogFile, mpDevice->md3dDevice->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState)));
+
+	Track(Key, pipelineState.Get(), Loaded);
+
+	CheckHRESULT(mpLogFile, pipelineState->QueryInterface(riid, ppPipelineState));
+
+	return TRUE;
+}
+
+BOOL PipelineStateCache::CreatePipelineState(
+		const D3DX12_MESH_SHADER_PIPELINE_STATE_DESC& desc,
+		const IID& riid,
+		void** const ppPipelineState,
+		LPCWSTR name) {
+	const auto Key = PipelineKey(desc, name);
+
+	auto meshStreamDesc = CD3DX12_PIPELINE_MESH_STATE_STREAM(desc);
+
+	D3D12_PIPELINE_STATE_STREAM_DESC streamDesc = {};
+	streamDesc.SizeInBytes = sizeof(meshStreamDesc);
+	streamDesc.pPipelineStateSubobjectStream = &meshStreamDesc;
+
+	ComPtr<ID3D12PipelineState> pipelineState{};
+	const BOOL Loaded = mLibrary != nullptr
+		&& SUCCEEDED(mLibrary->LoadPipeline(Key.c_str(), &streamDesc, IID_PPV_ARGS(&pipelineState)));
+	if (!Loaded)
+		CheckHRESULT(mpLogFile, mpDevice->md3dDevice->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&pipelineState)));
+
+	Track(Key, pipelineState.Get(), Loaded);
+
+	CheckHRESULT(mpLogFile, pipelineState->QueryInterface(riid, ppPipelineState));
+
+	return TRUE;
+}
+
+BOOL PipelineStateCache::CreateLibrary(const void* const pData, size_t size) {
+	mLibrary.Reset();
+
+	return SUCCEEDED(mpDevice->md3dDevice->CreatePipelineLibrary(pData, size, IID_PPV_ARGS(&mLibrary)));
+}
+
+void PipelineStateCache::Track(const std::wstring& key, ID3D12PipelineState* const pPipelineState, BOOL bLoaded) {
+	if (bLoaded) ++mHitCount;
+	else ++mMissCount;
+
+	std::lock_guard<std::mutex> lock(mTrackMutex);
+
+	mPipelineStates[key] = pPipelineState;
+	if (!bLoaded) mbDirty = TRUE;
+}
\ No newline at end of file
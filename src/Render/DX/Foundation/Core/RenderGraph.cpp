@@ -0,0 +1,526 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/RenderGraph.hpp"
+#include "Render/DX/Foundation/Core/AsyncComputeTracker.hpp"
+#include "Common/Debug/Logger.hpp"
+#include "Render/DX/Foundation/Core/Device.hpp"
+#include "Render/DX/Foundation/Core/CommandObject.hpp"
+#include "Render/DX/Foundation/Resource/GpuResource.hpp"
+
+using namespace Render::DX::Foundation::Core;
+using namespace Microsoft::WRL;
+
+namespace {
+	template <typename T>
+	void HashValue(Common::Foundation::Hash& hash, const T& value) {
+		hash = Common::Util::HashUtil::HashCombine(hash, Common::Util::HashUtil::HashBytes(&value, sizeof(T)));
+	}
+
+	// Field by field; the struct has padding that is not guaranteed to be zero.
+	Common::Foundation::Hash HashDesc(const D3D12_RESOURCE_DESC& desc) {
+		Common::Foundation::Hash hash = 0;
+		HashValue(hash, desc.Dimension);
+		HashValue(hash, desc.Alignment);
+		HashValue(hash, desc.Width);
+		HashValue(hash, desc.Height);
+		HashValue(hash, desc.DepthOrArraySize);
+		HashValue(hash, desc.MipLevels);
+		HashValue(hash, desc.Format);
+		HashValue(hash, desc.SampleDesc.Count);
+		HashValue(hash, desc.SampleDesc.Quality);
+		HashValue(hash, desc.Layout);
+		HashValue(hash, desc.Flags);
+		return hash;
+	}
+
+	UINT64 AlignUp(UINT64 value, UINT64 alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	const D3D12_RESOURCE_FLAGS RtDsFlags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+}
+
+RenderPassBuilder::RenderPassBuilder(RenderGraph* const pGraph, UINT pass) : mpGraph(pGraph), mPass(pass) {}
+
+RenderPassBuilder& RenderPassBuilder::Read(Resource::GpuResource* const pResource, D3D12_RESOURCE_STATES state) {
+	mpGraph->AddAccess(mPass, pResource, state, FALSE);
+
+	return *this;
+}
+
+RenderPassBuilder& RenderPassBuilder::Write(Resource::GpuResource* const pResource, D3D12_RESOURCE_STATES state) {
+	mpGraph->AddAccess(mPass, pResource, state, TRUE);
+
+	return *this;
+}
+
+RenderPassBuilder& RenderPassBuilder::Transient(
+		Resource::GpuResource* const pResource,
+		const D3D12_RESOURCE_DESC& desc,
+		D3D12_RESOURCE_STATES state,
+		LPCWSTR name,
+		RealizeFunc realizeFunc) {
+	// Failures surface from Compile so declarations can be chained.
+	if (!mpGraph->AddTransient(mPass, pResource, desc, state, name, realizeFunc))
+		mpGraph->mbInvalidTransient = TRUE;
+
+	return *this;
+}
+
+RenderPassBuilder& RenderPassBuilder::SideEffect() {
+	mpGraph->mPasses[mPass].SideEffect = TRUE;
+
+	return *this;
+}
+
+RenderPassBuilder& RenderPassBuilder::AsyncCompute() {
+	mpGraph->mPasses[mPass].AsyncCompute = TRUE;
+
+	return *this;
+}
+
+RenderGraph::RenderGraph() {}
+
+RenderGraph::~RenderGraph() { CleanUp(); }
+
+BOOL RenderGraph::Initialize(Common::Debug::LogFile* const pLogFile, Device* const pDevice, CommandObject* const pCommandObject) {
+	mpLogFile = pLogFile;
+	mpDevice = pDevice;
+	mpCommandObject = pCommandObject;
+
+	return TRUE;
+}
+
+void RenderGraph::CleanUp() {
+	if (mbCleanedUp) return;
+
+	Reset();
+
+	for (const auto resource : mRealizedResources)
+		resource->CleanUp();
+	mRealizedResources.clear();
+
+	for (auto& heap : mHeaps)
+		heap.Reset();
+
+	mAllocationInfos.clear();
+
+	mbCleanedUp = TRUE;
+}
+
+void RenderGraph::Reset() {
+	mPasses.clear();
+	mResources.clear();
+	mResourceIndices.clear();
+	mbInvalidTransient = FALSE;
+
+	mStats = {};
+}
+
+RenderPassBuilder RenderGraph::AddPass(LPCWSTR name, ExecuteFunc func) {
+	const UINT Index = static_cast<UINT>(mPasses.size());
+
+	Pass pass{};
+	pass.Name = name;
+	pass.Func = func;
+	mPasses.push_back(std::move(pass));
+
+	return RenderPassBuilder(this, Index);
+}
+
+void RenderGraph::MarkOutput(Resource::GpuResource* const pResource) {
+	mResources[ResourceIndex(pResource)].Output = TRUE;
+}
+
+BOOL RenderGraph::Compile() {
+	if (mbInvalidTransient) ReturnFalse(mpLogFile, L"Render graph was given a transient resource it cannot allocate");
+
+	CullPasses();
+
+	// Lifetimes are counted in passes of the direct queue, so memory of an
+	// async pass could be handed to a pass running next to it.
+	for (const auto& pass : mPasses) {
+		if (pass.Culled || !pass.AsyncCompute) continue;
+
+		for (const auto& access : pass.Accesses) {
+			if (!mResources[access.Resource].Transient) continue;
+
+			std::wstring msg(L"Render graph cannot place transients used on the compute queue: ");
+			msg.append(pass.Name);
+			ReturnFalse(mpLogFile, msg);
+		}
+	}
+
+	ComputeLifetimes();
+	PackTransients();
+
+	mStats.PassCount = static_cast<UINT>(mPasses.size());
+	for (const auto& pass : mPasses) {
+		if (pass.Culled) ++mStats.CulledPassCount;
+		else if (pass.AsyncCompute) ++mStats.AsyncPassCount;
+	}
+
+	return TRUE;
+}
+
+BOOL RenderGraph::Execute(ID3D12CommandAllocator* const pDirectAlloc, ID3D12CommandAllocator* const pComputeAlloc) {
+	CheckReturn(mpLogFile, RealizeTransients());
+
+	std::vector<D3D12_RESOURCE_BARRIER> barriers{};
+
+	AsyncComputeTracker async{};
+	async.Reset(static_cast<UINT>(mResources.size()));
+	std::vector<D3D12_RESOURCE_STATES> statesBefore(mResources.size());
+
+	for (UINT i = 0, end = static_cast<UINT>(mPasses.size()); i < end; ++i) {
+		const auto& pass = mPasses[i];
+		if (pass.Culled) continue;
+
+		// Barriers are recorded on the direct queue, so one on a resource
+		// the compute queue may still be using has to wait for it.
+		if (async.InFlight()) {
+			BOOL join = pass.AsyncCompute;
+			for (const auto& access : pass.Accesses) {
+				const auto& node = mResources[access.Resource];
+				if (!async.NeedsJoin(access.Resource, access.Write, access.State, node.Resource->State())) continue;
+
+				join = TRUE;
+				break;
+			}
+
+			if (join) {
+				CheckReturn(mpLogFile, mpCommandObject->JoinAsyncCompute());
+				++mStats.JoinCount;
+
+				async.Join();
+			}
+		}
+
+		barriers.clear();
+
+		for (const auto& access : pass.Accesses) {
+			const auto& node = mResources[access.Resource];
+
+			const BOOL FirstUse = node.Transient && node.FirstPass == i;
+			if (FirstUse && node.Aliased)
+				barriers.push_back(CD3DX12_RESOURCE_BARRIER::Aliasing(nullptr, node.Resource->Resource()));
+
+			node.Resource->Transite(barriers, access.State);
+		}
+
+		mStats.BarrierCount += static_cast<UINT>(barriers.size());
+		mpCommandObject->QueueBarriers(barriers);
+
+		// Render targets and depth buffers in aliased memory must be
+		// initialized before use; the others are simply overwritten.
+		for (const auto& access : pass.Accesses) {
+			const auto& node = mResources[access.Resource];
+			if (!node.Transient || node.FirstPass != i || !node.Aliased) continue;
+			if ((node.Desc.Flags & RtDsFlags) == 0) continue;
+			if (access.State != D3D12_RESOURCE_STATE_RENDER_TARGET && access.State != D3D12_RESOURCE_STATE_DEPTH_WRITE) continue;
+
+			mpCommandObject->QueueDiscard(node.Resource->Resource());
+		}
+
+		if (!pass.AsyncCompute) {
+			CheckReturn(mpLogFile, pass.Func());
+			continue;
+		}
+
+		for (UINT r = 0, count = static_cast<UINT>(mResources.size()); r < count; ++r)
+			statesBefore[r] = mResources[r].Resource->State();
+
+		CheckReturn(mpLogFile, mpCommandObject->BeginAsyncCompute(pDirectAlloc, pComputeAlloc));
+		const BOOL Result = pass.Func();
+		CheckReturn(mpLogFile, mpCommandObject->EndAsyncCompute());
+		CheckReturn(mpLogFile, Result);
+
+		for (const auto& access : pass.Accesses)
+			async.Use(access.Resource, access.Write);
+
+		// The pass may transition resources itself, declared or not, on the
+		// compute list. Such a resource is changed by the compute work just
+		// as if it were written there.
+		for (UINT r = 0, count = static_cast<UINT>(mResources.size()); r < count; ++r)
+			if (mResources[r].Resource->State() != statesBefore[r]) async.Use(r, TRUE);
+		async.Fork();
+	}
+
+	// Whatever follows the graph expects the frame to be complete.
+	if (async.InFlight()) {
+		CheckReturn(mpLogFile, mpCommandObject->JoinAsyncCompute());
+		++mStats.JoinCount;
+	}
+
+	return TRUE;
+}
+
+UINT RenderGraph::ResourceIndex(Resource::GpuResource* const pResource) {
+	const auto iter = mResourceIndices.find(pResource);
+	if (iter != mResourceIndices.end()) return iter->second;
+
+	const UINT Index = static_cast<UINT>(mResources.size());
+
+	ResourceNode node{};
+	node.Resource = pResource;
+	mResources.push_back(std::move(node));
+
+	mResourceIndices[pResource] = Index;
+
+	return Index;
+}
+
+void RenderGraph::AddAccess(UINT pass, Resource::GpuResource* const pResource, D3D12_RESOURCE_STATES state, BOOL write) {
+	const UINT Index = ResourceIndex(pResource);
+
+	auto& accesses = mPasses[pass].Accesses;
+
+	// One entry per resource and pass. Read states combine; a write takes
+	// the state of the first write.
+	for (auto& access : accesses) {
+		if (access.Resource != Index) continue;
+
+		if (write) {
+			if (!access.Write) access.State = state;
+			access.Write = TRUE;
+		}
+		else if (!access.Write) {
+			access.State |= state;
+		}
+
+		return;
+	}
+
+	accesses.push_back({ Index, state, write });
+}
+
+BOOL RenderGraph::AddTransient(
+		UINT pass,
+		Resource::GpuResource* const pResource,
+		const D3D12_RESOURCE_DESC& desc,
+		D3D12_RESOURCE_STATES state,
+		LPCWSTR name,
+		RenderPassBuilder::RealizeFunc realizeFunc) {
+	const Common::Foundation::Hash DescHash = HashDesc(desc);
+
+	auto iter = mAllocationInfos.find(DescHash);
+	if (iter == mAllocationInfos.end()) {
+		const auto Info = mpDevice->md3dDevice->GetResourceAllocationInfo(0, 1, &desc);
+		if (Info.SizeInBytes == UINT64_MAX) {
+			std::wstring msg(L"Invalid description for transient resource: ");
+			msg.append(name);
+			ReturnFalse(mpLogFile, msg);
+		}
+
+		iter = mAllocationInfos.emplace(DescHash, Info).first;
+	}
+
+	const UINT Index = ResourceIndex(pResource);
+
+	auto& node = mResources[Index];
+	node.Transient = TRUE;
+	node.Desc = desc;
+	node.Name = name;
+	node.RealizeFunc = realizeFunc;
+	node.Size = iter->second.SizeInBytes;
+	node.Alignment = iter->second.Alignment;
+
+	if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) node.Heap = E_Buffer;
+	else if (desc.Flags & RtDsFlags) node.Heap = E_RtDsTexture;
+	else node.Heap = E_Texture;
+
+	AddAccess(pass, pResource, state, TRUE);
+
+	return TRUE;
+}
+
+void RenderGraph::CullPasses() {
+	std::vector<BOOL> needed(mResources.size());
+	for (size_t i = 0, end = mResources.size(); i < end; ++i)
+		needed[i] = mResources[i].Output;
+
+	// Walks backwards so every consumer is decided before its producers.
+	for (size_t i = mPasses.size(); i-- > 0;) {
+		auto& pass = mPasses[i];
+
+		BOOL live = pass.SideEffect;
+		for (const auto& access : pass.Accesses) {
+			if (access.Write && needed[access.Resource]) {
+				live = TRUE;
+				break;
+			}
+		}
+
+		pass.Culled = !live;
+		if (!live) continue;
+
+		// Writes may be partial (blending, read-modify-write), so whatever a
+		// live pass touches still depends on earlier writers.
+		for (const auto& access : pass.Accesses)
+			needed[access.Resource] = TRUE;
+	}
+}
+
+void RenderGraph::ComputeLifetimes() {
+	for (auto& node : mResources) {
+		node.FirstPass = UINT_MAX;
+		node.LastPass = 0;
+	}
+
+	for (UINT i = 0, end = static_cast<UINT>(mPasses.size()); i < end; ++i) {
+		const auto& pass = mPasses[i];
+		if (pass.Culled) continue;
+
+		for (const auto& access : pass.Accesses) {
+			auto& node = mResources[access.Resource];
+			node.FirstPass = std::min(node.FirstPass, i);
+			node.LastPass = std::max(node.LastPass, i);
+		}
+	}
+}
+
+void RenderGraph::PackTransients() {
+	mHeapSizes.fill(0);
+	mLayoutHash = 0;
+
+	std::vector<UINT> order{};
+	for (UINT i = 0, end = static_cast<UINT>(mResources.size()); i < end; ++i) {
+		const auto& node = mResources[i];
+		if (node.Transient && node.FirstPass != UINT_MAX) order.push_back(i);
+	}
+
+	// Largest first keeps the first-fit packing tight.
+	std::stable_sort(order.begin(), order.end(), [&](UINT a, UINT b) {
+		return mResources[a].Size > mResources[b].Size;
+	});
+
+	std::vector<UINT> placed{};
+	std::vector<std::pair<UINT64, UINT64>> taken{};
+
+	for (const auto index : order) {
+		auto& node = mResources[index];
+
+		// Memory held by transients that are alive at the same time.
+		taken.clear();
+		for (const auto other : placed) {
+			const auto& otherNode = mResources[other];
+			if (otherNode.Heap != node.Heap) continue;
+			if (otherNode.LastPass < node.FirstPass || node.LastPass < otherNode.FirstPass) continue;
+
+			taken.emplace_back(otherNode.Offset, otherNode.Offset + otherNode.Size);
+		}
+		std::sort(taken.begin(), taken.end());
+
+		UINT64 offset = 0;
+		for (const auto& range : taken) {
+			if (range.second <= offset) continue;
+			if (offset + node.Size <= range.first) break;
+
+			offset = AlignUp(range.second, node.Alignment);
+		}
+
+		node.Offset = offset;
+		mHeapSizes[node.Heap] = std::max(mHeapSizes[node.Heap], offset + node.Size);
+
+		placed.push_back(index);
+	}
+
+	for (size_t i = 0, end = placed.size(); i < end; ++i) {
+		auto& node = mResources[placed[i]];
+
+		for (size_t j = i + 1; j < end; ++j) {
+			auto& otherNode = mResources[placed[j]];
+			if (otherNode.Heap != node.Heap) continue;
+			if (otherNode.Offset + otherNode.Size <= node.Offset || node.Offset + node.Size <= otherNode.Offset) continue;
+
+			node.Aliased = TRUE;
+			otherNode.Aliased = TRUE;
+		}
+	}
+
+	// Placement depends only on which resources are transient, their
+	// descriptions and their offsets, so the hash tells when to re-place.
+	std::sort(placed.begin(), placed.end());
+	for (const auto index : placed) {
+		const auto& node = mResources[index];
+
+		HashValue(mLayoutHash, node.Resource);
+		HashValue(mLayoutHash, node.Offset);
+		mLayoutHash = Common::Util::HashUtil::HashCombine(mLayoutHash, HashDesc(node.Desc));
+
+		mStats.TransientBytes += node.Size;
+	}
+	for (const auto size : mHeapSizes) {
+		HashValue(mLayoutHash, size);
+
+		mStats.HeapBytes += size;
+	}
+
+	mStats.TransientCount = static_cast<UINT>(placed.size());
+}
+
+BOOL RenderGraph::RealizeTransients() {
+	if (mLayoutHash == mRealizedLayoutHash) return TRUE;
+
+	// Frames in flight may still use the old placement.
+	CheckReturn(mpLogFile, mpCommandObject->FlushCommandQueue());
+
+	for (const auto resource : mRealizedResources)
+		resource->CleanUp();
+	mRealizedResources.clear();
+
+	static const D3D12_HEAP_FLAGS HeapFlags[HeapTypeCount] = {
+		D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS,
+		D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES,
+		D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES
+	};
+
+	std::array<UINT64, HeapTypeCount> alignments{};
+	for (const auto& node : mResources) {
+		if (!node.Transient || node.FirstPass == UINT_MAX) continue;
+		alignments[node.Heap] = std::max(alignments[node.Heap], node.Alignment);
+	}
+
+	for (UINT i = 0; i < HeapTypeCount; ++i) {
+		mHeaps[i].Reset();
+		if (mHeapSizes[i] == 0) continue;
+
+		const auto Alignment = std::max<UINT64>(alignments[i], D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+		const CD3DX12_HEAP_DESC HeapDesc(
+			AlignUp(mHeapSizes[i], Alignment),
+			D3D12_HEAP_TYPE_DEFAULT,
+			Alignment,
+			HeapFlags[i]);
+
+		CheckHRESULT(mpLogFile, mpDevice->md3dDevice->CreateHeap(&HeapDesc, IID_PPV_ARGS(&mHeaps[i])));
+	}
+
+	for (const auto& node : mResources) {
+		if (!node.Transient || node.FirstPass == UINT_MAX) continue;
+
+		CheckReturn(mpLogFile, node.Resource->Initialize(
+			mpDevice,
+			mHeaps[node.Heap].Get(),
+			node.Offset,
+			&node.Desc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			node.Name.c_str()));
+
+		mRealizedResources.push_back(node.Resource);
+	}
+
+	// Views are rebuilt once everything is placed, as one callback may
+	// cover several transients of the same owner.
+	for (const auto& node : mResources) {
+		if (!node.Transient || node.FirstPass == UINT_MAX || !node.RealizeFunc) continue;
+
+		CheckReturn(mpLogFile, node.RealizeFunc());
+	}
+
+	mRealizedLayoutHash = mLayoutHash;
+
+	Logln(mpLogFile, std::format("Render graph placed {} transient resources in {} KB ({} KB unaliased)",
+		mStats.TransientCount, mStats.HeapBytes >> 10, mStats.TransientBytes >> 10));
+
+	return TRUE;
+}
\ No newline at end of file
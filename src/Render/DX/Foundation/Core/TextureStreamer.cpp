@@ -0,0 +1,324 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/TextureStreamer.hpp"
+#include "Common/Debug/Logger.hpp"
+#include "Render/DX/Foundation/Core/Device.hpp"
+#include "Render/DX/Foundation/Core/UploadQueue.hpp"
+#include "Render/DX/Foundation/Core/DescriptorHeap.hpp"
+#include "Render/DX/Foundation/Util/D3D12Util.hpp"
+
+using namespace Render::DX::Foundation::Core;
+using namespace Microsoft::WRL;
+using namespace DirectX;
+
+namespace {
+	// Mips up to this size along the longer side make up the tail that is
+	// read when a texture is added and stays resident for good.
+	const size_t MaxTailExtent = 64;
+
+	// Legacy header, and the same followed by the DX10 extension.
+	const UINT64 DdsHeaderSize = 128;
+	const UINT64 DdsDx10HeaderSize = 148;
+
+	// Runs on a worker thread; an empty result means the read failed.
+	std::vector<BYTE> ReadFileRange(const std::wstring& filePath, UINT64 offset, UINT64 size) {
+		std::vector<BYTE> data{};
+
+		std::ifstream file(filePath, std::ios::binary);
+		if (!file) return data;
+
+		data.resize(static_cast<size_t>(size));
+
+		file.seekg(static_cast<std::streamoff>(offset));
+		if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size))) data.clear();
+
+		return data;
+	}
+}
+
+TextureStreamer::TextureStreamer() {}
+
+TextureStreamer::~TextureStreamer() { CleanUp(); }
+
+BOOL TextureStreamer::Initialize(
+		Common::Debug::LogFile* const pLogFile,
+		Device* const pDevice,
+		UploadQueue* const pUploadQueue,
+		DescriptorHeap* const pDescriptorHeap,
+		UINT64 budget,
+		UINT maxReadsInFlight) {
+	mpLogFile = pLogFile;
+	mpDevice = pDevice;
+	mpUploadQueue = pUploadQueue;
+	mpDescriptorHeap = pDescriptorHeap;
+
+	mResidency.Initialize(budget, maxReadsInFlight);
+
+	return TRUE;
+}
+
+void TextureStreamer::CleanUp() {
+	if (mbCleanedUp) return;
+
+	// Futures of std::async wait for their read when destroyed.
+	mReads.clear();
+	mRetired.clear();
+	mTextures.clear();
+
+	mbCleanedUp = TRUE;
+}
+
+void TextureStreamer::SetBudget(UINT64 budget) {
+	mResidency.SetBudget(budget);
+}
+
+BOOL TextureStreamer::AddTexture(LPCWSTR filePath, UINT& texture) {
+	StreamedTexture tex{};
+	if (!ReadLayout(filePath, tex)) return FALSE;
+
+	const auto& Metadata = tex.Metadata;
+	const UINT MipCount = static_cast<UINT>(Metadata.mipLevels);
+
+	// Block-compressed resources need a top level made of whole 4x4
+	// blocks, which bounds how far down a resident set may start.
+	UINT tailMip = 0;
+	for (UINT mip = 1; mip < MipCount; ++mip) {
+		const size_t Width = Metadata.width >> mip;
+		const size_t Height = Metadata.height >> mip;
+		if (Width == 0 || Height == 0 || (Width % 4) != 0 || (Height % 4) != 0) break;
+
+		tailMip = mip;
+		if (std::max(Width, Height) <= MaxTailExtent) break;
+	}
+	if (tailMip == 0) return FALSE;
+
+	for (UINT mip = tailMip; mip < MipCount; ++mip) {
+		tex.MipData[mip] = ReadFileRange(tex.FilePath, tex.MipOffsets[mip], tex.MipSizes[mip]);
+		if (tex.MipData[mip].empty()) return FALSE;
+	}
+
+	// The slot comes first; a resource whose upload is already recorded
+	// must not be dropped on the way out.
+	CheckReturn(mpLogFile, mpDescriptorHeap->AllocateTextureSlot(tex.Slot));
+	if (!CreateResidentResource(tex, tailMip, tex.Resource)) {
+		// Never bound, so it can be handed out again right away.
+		mpDescriptorHeap->FreeTextureSlot(tex.Slot, 0);
+		ReturnFalse(mpLogFile, L"Failed to create the resident mips of " << tex.FilePath);
+	}
+	CreateShaderResourceView(tex.Resource.Get(), tex.Slot);
+	tex.TopMip = tailMip;
+	tex.Fence = mpUploadQueue->PendingFence();
+
+	texture = mResidency.AddTexture(tex.MipSizes.data(), MipCount, tailMip);
+	mTextures.push_back(std::move(tex));
+
+	return TRUE;
+}
+
+void TextureStreamer::RequestMip(UINT texture, UINT mip, UINT64 frame) {
+	mResidency.Request(texture, mip, frame);
+}
+
+BOOL TextureStreamer::Update(UINT64 frame) {
+	// Reads land as they finish; the rest are left running.
+	for (auto iter = mReads.begin(); iter != mReads.end();) {
+		if (iter->Data.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			++iter;
+			continue;
+		}
+
+		auto& tex = mTextures[iter->Texture];
+
+		auto data = iter->Data.get();
+		const BOOL Succeeded = !data.empty();
+		if (Succeeded) tex.MipData[iter->Mip] = std::move(data);
+		else WLogln(mpLogFile, L"[Warning] Failed to stream mip ", std::to_wstring(iter->Mip), L" of ", tex.FilePath);
+
+		mResidency.OnLoaded(iter->Texture, Succeeded);
+
+		iter = mReads.erase(iter);
+	}
+
+	mResidency.Update(frame, mLoads, mEvictions);
+
+	for (const auto& eviction : mEvictions) {
+		auto& tex = mTextures[eviction.Texture];
+		for (UINT mip = 0; mip < eviction.TopMip; ++mip)
+			std::vector<BYTE>().swap(tex.MipData[mip]);
+	}
+
+	for (const auto& load : mLoads) {
+		const auto& tex = mTextures[load.Texture];
+
+		MipRead read{};
+		read.Texture = load.Texture;
+		read.Mip = load.TopMip;
+		read.Data = std::async(std::launch::async, ReadFileRange,
+			tex.FilePath, tex.MipOffsets[load.TopMip], tex.MipSizes[load.TopMip]);
+
+		mReads.push_back(std::move(read));
+	}
+
+	// A texture has at most one replacement in flight; later changes are
+	// picked up once it has been swapped in.
+	for (UINT i = 0, end = static_cast<UINT>(mTextures.size()); i < end; ++i) {
+		auto& tex = mTextures[i];
+		if (tex.Pending || !mpUploadQueue->IsCompleted(tex.Fence)) continue;
+
+		const UINT ResidentMip = mResidency.ResidentMip(i);
+		if (ResidentMip == tex.TopMip) continue;
+
+		CheckReturn(mpLogFile, CreateResidentResource(tex, ResidentMip, tex.Pending));
+		tex.PendingTopMip = ResidentMip;
+		tex.PendingFence = mpUploadQueue->PendingFence();
+	}
+
+	return TRUE;
+}
+
+BOOL TextureStreamer::SwapLanded(UINT64 fence) {
+	mSwapped.clear();
+
+	for (UINT i = 0, end = static_cast<UINT>(mTextures.size()); i < end; ++i) {
+		auto& tex = mTextures[i];
+		if (!tex.Pending || !mpUploadQueue->IsCompleted(tex.PendingFence)) continue;
+
+		// Out of slots, the swap waits for the ones being given back.
+		UINT slot{};
+		if (!mpDescriptorHeap->AllocateTextureSlot(slot)) break;
+
+		CreateShaderResourceView(tex.Pending.Get(), slot);
+
+		mpDescriptorHeap->FreeTextureSlot(tex.Slot, fence);
+		mRetired.push_back({ fence, std::move(tex.Resource) });
+
+		tex.Resource = std::move(tex.Pending);
+		tex.Slot = slot;
+		tex.TopMip = tex.PendingTopMip;
+		tex.Fence = tex.PendingFence;
+
+		mSwapped.push_back(i);
+	}
+
+	return TRUE;
+}
+
+void TextureStreamer::ReleaseRetired(UINT64 completedFence) {
+	mRetired.erase(std::remove_if(mRetired.begin(), mRetired.end(),
+		[&](const RetiredResource& retired) { return retired.Fence <= completedFence; }), mRetired.end());
+}
+
+BOOL TextureStreamer::ReadLayout(LPCWSTR filePath, StreamedTexture& texture) const {
+	if (_wcsicmp(std::filesystem::path(filePath).extension().c_str(), L".dds") != 0) return FALSE;
+	if (FAILED(GetMetadataFromDDSFile(filePath, DDS_FLAGS_NONE, texture.Metadata))) return FALSE;
+
+	const auto& Metadata = texture.Metadata;
+	if (Metadata.dimension != TEX_DIMENSION_TEXTURE2D || Metadata.arraySize != 1 || Metadata.IsCubemap() ||
+		Metadata.mipLevels < 2 || !IsCompressed(Metadata.format)) return FALSE;
+
+	const UINT MipCount = static_cast<UINT>(Metadata.mipLevels);
+
+	texture.MipOffsets.resize(MipCount);
+	texture.RowPitches.resize(MipCount);
+	texture.MipSizes.resize(MipCount);
+	texture.MipData.resize(MipCount);
+
+	UINT64 dataSize = 0;
+	for (UINT mip = 0; mip < MipCount; ++mip) {
+		size_t rowPitch{}, slicePitch{};
+		if (FAILED(ComputePitch(
+			Metadata.format,
+			std::max<size_t>(Metadata.width >> mip, 1),
+			std::max<size_t>(Metadata.height >> mip, 1),
+			rowPitch,
+			slicePitch))) return FALSE;
+
+		texture.MipOffsets[mip] = dataSize;
+		texture.RowPitches[mip] = rowPitch;
+		texture.MipSizes[mip] = slicePitch;
+
+		dataSize += slicePitch;
+	}
+
+	// The mips follow the header back to back, most detailed first.
+	std::error_code ec{};
+	const UINT64 FileSize = std::filesystem::file_size(filePath, ec);
+	if (ec || FileSize < dataSize) return FALSE;
+
+	const UINT64 HeaderSize = FileSize - dataSize;
+	if (HeaderSize != DdsHeaderSize && HeaderSize != DdsDx10HeaderSize) return FALSE;
+
+	for (auto& offset : texture.MipOffsets) offset += HeaderSize;
+
+	texture.FilePath = filePath;
+
+	return TRUE;
+}
+
+BOOL TextureStreamer::CreateResidentResource(
+		StreamedTexture& texture,
+		UINT topMip,
+		ComPtr<ID3D12Resource>& resource) {
+	const auto& Metadata = texture.Metadata;
+	const UINT MipLevels = static_cast<UINT>(Metadata.mipLevels);
+	const UINT MipCount = MipLevels - topMip;
+
+	// Mips the current resource already holds are copied over on the GPU,
+	// so only the ones read since it was filled go through the ring.
+	ID3D12Resource* const pSource = texture.Resource.Get();
+	const UINT KeptMip = pSource ? std::max(texture.TopMip, topMip) : MipLevels;
+
+	const auto Desc = CD3DX12_RESOURCE_DESC::Tex2D(
+		Metadata.format,
+		std::max<UINT64>(Metadata.width >> topMip, 1),
+		std::max<UINT>(static_cast<UINT>(Metadata.height >> topMip), 1),
+		1,
+		static_cast<UINT16>(MipCount));
+
+	CheckReturn(mpLogFile, Util::D3D12Util::CreateTexture(
+		mpDevice, Desc, IID_PPV_ARGS(&resource)));
+	CheckHRESULT(mpLogFile, resource->SetName(texture.FilePath.c_str()));
+
+	const UINT UploadCount = KeptMip - topMip;
+	if (UploadCount > 0) {
+		std::vector<D3D12_SUBRESOURCE_DATA> subresources(UploadCount);
+		for (UINT i = 0; i < UploadCount; ++i) {
+			const UINT Mip = topMip + i;
+			if (texture.MipData[Mip].empty())
+				ReturnFalse(mpLogFile, L"Mip " << Mip << L" of " << texture.FilePath << L" has not been read");
+
+			subresources[i].pData = texture.MipData[Mip].data();
+			subresources[i].RowPitch = static_cast<LONG_PTR>(texture.RowPitches[Mip]);
+			subresources[i].SlicePitch = static_cast<LONG_PTR>(texture.MipSizes[Mip]);
+		}
+
+		CheckReturn(mpLogFile, mpUploadQueue->UploadTexture(
+			resource.Get(), 0, UploadCount, subresources.data()));
+
+		// Staged right away, so the CPU copies can go; the only mip data
+		// held on the CPU is what has been read but not uploaded yet.
+		for (UINT mip = topMip; mip < KeptMip; ++mip)
+			std::vector<BYTE>().swap(texture.MipData[mip]);
+	}
+
+	// The source stays alive until the copy has landed: it is only retired
+	// once this replacement has been swapped in.
+	for (UINT mip = KeptMip; mip < MipLevels; ++mip)
+		CheckReturn(mpLogFile, mpUploadQueue->CopyTexture(
+			resource.Get(), mip - topMip, pSource, mip - texture.TopMip));
+
+	return TRUE;
+}
+
+void TextureStreamer::CreateShaderResourceView(ID3D12Resource* const pResource, UINT slot) {
+	const auto Desc = pResource->GetDesc();
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Format = Desc.Format;
+	srvDesc.Texture2D.MostDetailedMip = 0;
+	srvDesc.Texture2D.MipLevels = Desc.MipLevels;
+
+	Util::D3D12Util::CreateShaderResourceView(
+		mpDevice, pResource, &srvDesc, mpDescriptorHeap->TextureSlotCpuHandle(slot));
+}
\ No newline at end of file
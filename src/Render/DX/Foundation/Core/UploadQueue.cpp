@@ -0,0 +1,256 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/UploadQueue.hpp"
+#include "Common/Debug/Logger.hpp"
+#include "Render/DX/Foundation/Core/Device.hpp"
+#include "Render/DX/Foundation/Util/D3D12Util.hpp"
+
+using namespace Render::DX::Foundation::Core;
+using namespace Microsoft::WRL;
+
+namespace {
+	const UINT64 BufferAlignment = 16;
+}
+
+UploadQueue::UploadQueue() {}
+
+UploadQueue::~UploadQueue() { CleanUp(); }
+
+BOOL UploadQueue::Initialize(Common::Debug::LogFile* const pLogFile, Device* const pDevice, UINT64 ringSize) {
+	mpLogFile = pLogFile;
+	mpDevice = pDevice;
+	mRingSize = ringSize;
+
+	CheckReturn(mpLogFile, mpDevice->CreateCommandQueue(mCommandQueue, D3D12_COMMAND_LIST_TYPE_COPY));
+	CheckHRESULT(mpLogFile, mCommandQueue->SetName(L"UploadQueue_CommandQueue"));
+
+	CheckReturn(mpLogFile, mpDevice->CreateCommandAllocator(mAllocator, D3D12_COMMAND_LIST_TYPE_COPY));
+	CheckReturn(mpLogFile, mpDevice->CreateCommandList(mAllocator.Get(), mCommandList, D3D12_COMMAND_LIST_TYPE_COPY));
+	mFreeAllocators.push_back(std::move(mAllocator));
+
+	CheckReturn(mpLogFile, mpDevice->CreateFence(mFence));
+
+	Util::D3D12Util::D3D12BufferCreateInfo ringInfo(
+		mRingSize, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+	CheckReturn(mpLogFile, Util::D3D12Util::CreateBuffer(
+		mpDevice, ringInfo, IID_PPV_ARGS(&mRing)));
+	CheckHRESULT(mpLogFile, mRing->SetName(L"UploadQueue_Ring"));
+
+	// Upload heaps may stay mapped for their whole lifetime.
+	CheckHRESULT(mpLogFile, mRing->Map(0, nullptr, reinterpret_cast<void**>(&mpMappedRing)));
+
+	return TRUE;
+}
+
+void UploadQueue::CleanUp() {
+	if (mbCleanedUp) return;
+
+	if (mFence) Flush();
+
+	if (mpMappedRing) {
+		mRing->Unmap(0, nullptr);
+		mpMappedRing = nullptr;
+	}
+	if (mRing) mRing.Reset();
+
+	mTemporaries.clear();
+	while (!mBatches.empty()) mBatches.pop();
+	mFreeAllocators.clear();
+
+	if (mFence) mFence.Reset();
+	if (mCommandList) mCommandList.Reset();
+	if (mAllocator) mAllocator.Reset();
+	if (mCommandQueue) mCommandQueue.Reset();
+
+	mbCleanedUp = TRUE;
+}
+
+BOOL UploadQueue::UploadBuffer(ID3D12Resource* const pDest, UINT64 destOffset, const void* const pData, UINT64 byteSize) {
+	CheckReturn(mpLogFile, BeginBatch());
+
+	ID3D12Resource* buffer{};
+	UINT64 offset{};
+	BYTE* mapped{};
+	CheckReturn(mpLogFile, Allocate(byteSize, BufferAlignment, buffer, offset, mapped));
+
+	std::memcpy(mapped, pData, static_cast<size_t>(byteSize));
+
+	mCommandList->CopyBufferRegion(pDest, destOffset, buffer, offset, byteSize);
+
+	return TRUE;
+}
+
+BOOL UploadQueue::UploadTexture(
+		ID3D12Resource* const pDest,
+		UINT firstSubresource,
+		UINT numSubresources,
+		const D3D12_SUBRESOURCE_DATA* const pSubresources) {
+	CheckReturn(mpLogFile, BeginBatch());
+
+	const UINT64 ByteSize = GetRequiredIntermediateSize(pDest, firstSubresource, numSubresources);
+
+	ID3D12Resource* buffer{};
+	UINT64 offset{};
+	BYTE* mapped{};
+	CheckReturn(mpLogFile, Allocate(
+		ByteSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, buffer, offset, mapped));
+
+	const UINT64 Copied = UpdateSubresources(
+		mCommandList.Get(), pDest, buffer, offset, firstSubresource, numSubresources, pSubresources);
+	if (Copied == 0) ReturnFalse(mpLogFile, L"Failed to record texture upload");
+
+	return TRUE;
+}
+
+BOOL UploadQueue::CopyTexture(
+		ID3D12Resource* const pDest,
+		UINT destSubresource,
+		ID3D12Resource* const pSrc,
+		UINT srcSubresource) {
+	CheckReturn(mpLogFile, BeginBatch());
+
+	const CD3DX12_TEXTURE_COPY_LOCATION Dest(pDest, destSubresource);
+	const CD3DX12_TEXTURE_COPY_LOCATION Src(pSrc, srcSubresource);
+	mCommandList->CopyTextureRegion(&Dest, 0, 0, 0, &Src, nullptr);
+
+	return TRUE;
+}
+
+BOOL UploadQueue::Submit() {
+	if (!mbRecording) return TRUE;
+
+	CheckHRESULT(mpLogFile, mCommandList->Close());
+
+	ID3D12CommandList* const cmdLists[] = { mCommandList.Get() };
+	mCommandQueue->ExecuteCommandLists(_countof(cmdLists), cmdLists);
+
+	const UINT64 Fence = mNextFence++;
+	CheckHRESULT(mpLogFile, mCommandQueue->Signal(mFence.Get(), Fence));
+
+	Batch batch{};
+	batch.Fence = Fence;
+	batch.RingEnd = mRingHead;
+	batch.Allocator = std::move(mAllocator);
+	batch.Temporaries = std::move(mTemporaries);
+	mBatches.push(std::move(batch));
+
+	mTemporaries.clear();
+	mSubmittedFence = Fence;
+	mbRecording = FALSE;
+
+	return TRUE;
+}
+
+BOOL UploadQueue::IsCompleted(UINT64 fence) const {
+	return mFence->GetCompletedValue() >= fence;
+}
+
+BOOL UploadQueue::Flush() {
+	CheckReturn(mpLogFile, Submit());
+	CheckReturn(mpLogFile, WaitCompletion(mSubmittedFence));
+
+	Retire();
+
+	return TRUE;
+}
+
+BOOL UploadQueue::BeginBatch() {
+	if (mbRecording) return TRUE;
+
+	Retire();
+
+	if (mFreeAllocators.empty()) {
+		CheckReturn(mpLogFile, mpDevice->CreateCommandAllocator(mAllocator, D3D12_COMMAND_LIST_TYPE_COPY));
+	}
+	else {
+		mAllocator = std::move(mFreeAllocators.back());
+		mFreeAllocators.pop_back();
+	}
+
+	CheckHRESULT(mpLogFile, mAllocator->Reset());
+	CheckHRESULT(mpLogFile, mCommandList->Reset(mAllocator.Get(), nullptr));
+
+	mbRecording = TRUE;
+
+	return TRUE;
+}
+
+BOOL UploadQueue::Allocate(UINT64 byteSize, UINT64 alignment, ID3D12Resource*& pBuffer, UINT64& offset, BYTE*& pMapped) {
+	// Uploads this large would stall the ring on almost every use, so
+	// they get a buffer of their own that is released with the batch.
+	if (byteSize > mRingSize / 2) {
+		ComPtr<ID3D12Resource> temporary{};
+
+		Util::D3D12Util::D3D12BufferCreateInfo info(
+			byteSize, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+		CheckReturn(mpLogFile, Util::D3D12Util::CreateBuffer(
+			mpDevice, info, IID_PPV_ARGS(&temporary)));
+		CheckHRESULT(mpLogFile, temporary->Map(0, nullptr, reinterpret_cast<void**>(&pMapped)));
+
+		pBuffer = temporary.Get();
+		offset = 0;
+		mTemporaries.push_back(std::move(temporary));
+
+		return TRUE;
+	}
+
+	UINT64 head{};
+	for (;;) {
+		head = Align(alignment, mRingHead);
+		// An allocation never straddles the end of the ring.
+		if (head % mRingSize + byteSize > mRingSize) head = Align(mRingSize, head);
+
+		if (head + byteSize <= mRingTail + mRingSize) break;
+
+		// The ring is full. The batch being recorded holds part of it, so
+		// it goes out first; then the oldest batch has to land.
+		++mStallCount;
+
+		CheckReturn(mpLogFile, Submit());
+		CheckReturn(mpLogFile, WaitCompletion(mBatches.front().Fence));
+		Retire();
+		CheckReturn(mpLogFile, BeginBatch());
+	}
+
+	mRingHead = head + byteSize;
+
+	pBuffer = mRing.Get();
+	offset = head % mRingSize;
+	pMapped = mpMappedRing + offset;
+
+	return TRUE;
+}
+
+BOOL UploadQueue::WaitCompletion(UINT64 fence) {
+	if (fence == 0 || mFence->GetCompletedValue() >= fence) return TRUE;
+
+	const HANDLE eventHandle = CreateEventEx(nullptr, FALSE, FALSE, EVENT_ALL_ACCESS);
+	if (eventHandle == NULL) return FALSE;
+
+	CheckHRESULT(mpLogFile, mFence->SetEventOnCompletion(fence, eventHandle));
+
+	const auto status = WaitForSingleObject(eventHandle, INFINITE);
+	if (status == WAIT_FAILED) ReturnFalse(mpLogFile, L"Calling \'WaitForSingleObject\' failed");
+
+	if (!CloseHandle(eventHandle)) ReturnFalse(mpLogFile, L"Failed to close handle");
+
+	return TRUE;
+}
+
+void UploadQueue::Retire() {
+	const UINT64 Completed = mFence->GetCompletedValue();
+
+	while (!mBatches.empty() && mBatches.front().Fence <= Completed) {
+		auto& batch = mBatches.front();
+
+		mRingTail = batch.RingEnd;
+		mFreeAllocators.push_back(std::move(batch.Allocator));
+
+		mBatches.pop();
+	}
+
+	// Nothing in flight or being recorded uses the ring any more.
+	if (mBatches.empty() && mRingTail == mRingHead) {
+		mRingHead = 0;
+		mRingTail = 0;
+	}
+}
\ No newline at end of file
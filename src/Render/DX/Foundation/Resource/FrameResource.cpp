@@ -37,6 +37,7 @@ void FrameResource::CleanUp() {
 		if (allocator) allocator.Reset();
 	}
 	mCmdAllocators.clear();
+	if (mComputeCmdAllocator) mComputeCmdAllocator.Reset();
 
 	mpDevice = nullptr;
 	mpLogFile = nullptr;
@@ -47,6 +48,7 @@ void FrameResource::CleanUp() {
 BOOL FrameResource::ResetCommandListAllocators() {
 	for (UINT i = 0; i < mThreadCount; ++i)
 		CheckHRESULT(mpLogFile, mCmdAllocators[i]->Reset());
+	CheckHRESULT(mpLogFile, mComputeCmdAllocator->Reset());
 
 	return TRUE;
 }
@@ -54,6 +56,7 @@ BOOL FrameResource::ResetCommandListAllocators() {
 BOOL FrameResource::CreateCommandListAllocators() {
 	for (UINT i = 0, end = static_cast<UINT>(mCmdAllocators.size()); i < end; ++i) 
 		CheckReturn(mpLogFile, mpDevice->CreateCommandAllocator(mCmdAllocators[i]));
+	CheckReturn(mpLogFile, mpDevice->CreateCommandAllocator(mComputeCmdAllocator, D3D12_COMMAND_LIST_TYPE_COMPUTE));
 
 	return TRUE;
 }
@@ -67,6 +70,7 @@ BOOL FrameResource::BuildConstantBuffres(
 	CheckReturn(mpLogFile, ObjectCB.Initialize(mpLogFile, mpDevice, numObjects, 1, TRUE));
 	CheckReturn(mpLogFile, MaterialCB.Initialize(mpLogFile, mpDevice, numMaterials, 1, TRUE));
 	CheckReturn(mpLogFile, ProjectToCubeCB.Initialize(mpLogFile, mpDevice, 1, 1, TRUE));
+	CheckReturn(mpLogFile, IrradianceSHCB.Initialize(mpLogFile, mpDevice, 1, 1, TRUE));
 	CheckReturn(mpLogFile, AmbientOcclusionCB.Initialize(mpLogFile, mpDevice, 1, 1, TRUE));
 	CheckReturn(mpLogFile, RayGenCB.Initialize(mpLogFile, mpDevice, 1, 1, TRUE));
 	CheckReturn(mpLogFile, RaySortingCB.Initialize(mpLogFile, mpDevice, 1, 1, TRUE));
@@ -75,6 +79,15 @@ BOOL FrameResource::BuildConstantBuffres(
 	CheckReturn(mpLogFile, BlendWithCurrentFrameCB.Initialize(mpLogFile, mpDevice, 1, 1, TRUE));
 	CheckReturn(mpLogFile, AtrousWaveletTransformFilterCB.Initialize(mpLogFile, mpDevice, 1, 1, TRUE));
 	CheckReturn(mpLogFile, ContactShadowCB.Initialize(mpLogFile, mpDevice, 1, 1, TRUE));
+	CheckReturn(mpLogFile, InstanceIndices.Initialize(mpLogFile, mpDevice, numObjects, 1, FALSE));
+	CheckReturn(mpLogFile, InstanceBounds.Initialize(mpLogFile, mpDevice, numObjects, 1, FALSE));
+	CheckReturn(mpLogFile, IndirectCommands.Initialize(mpLogFile, mpDevice, numObjects, 1, FALSE));
+	CheckReturn(mpLogFile, ClusteredLights.Initialize(
+		mpLogFile, mpDevice, ShadingConvention::LightCluster::MaxLightCount, 1, FALSE));
+	CheckReturn(mpLogFile, LightClusters.Initialize(
+		mpLogFile, mpDevice, ShadingConvention::LightCluster::ClusterCount, 1, FALSE));
+	CheckReturn(mpLogFile, ClusterLightIndices.Initialize(
+		mpLogFile, mpDevice, ShadingConvention::LightCluster::MaxLightIndexCount, 1, FALSE));
 
 	return TRUE;
 }
\ No newline at end of file
@@ -41,6 +41,31 @@ BOOL GpuResource::Initialize(
 	return TRUE;
 }
 
+BOOL GpuResource::Initialize(
+		Core::Device* const pDevice,
+		ID3D12Heap* const pHeap,
+		UINT64 heapOffset,
+		const D3D12_RESOURCE_DESC* const pRscDesc,
+		D3D12_RESOURCE_STATES initialState,
+		const D3D12_CLEAR_VALUE* const pOptClear,
+		LPCWSTR pName) {
+	mResource.Reset();
+
+	CheckHRESULT(mpLogFile, pDevice->md3dDevice->CreatePlacedResource(
+		pHeap,
+		heapOffset,
+		pRscDesc,
+		initialState,
+		pOptClear,
+		IID_PPV_ARGS(&mResource)
+	));
+	if (pName != nullptr) mResource->SetName(pName);
+
+	mCurrState = initialState;
+
+	return TRUE;
+}
+
 void GpuResource::CleanUp() {
 	if (mResource) mResource.Reset();
 }
@@ -74,5 +99,13 @@ void GpuResource::Transite(ID3D12GraphicsCommandList* const pCmdList, D3D12_RESO
 
 	pCmdList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(mResource.Get(), mCurrState, state));
 
+	mCurrState = state;
+}
+
+void GpuResource::Transite(std::vector<D3D12_RESOURCE_BARRIER>& barriers, D3D12_RESOURCE_STATES state) {
+	if (mCurrState == state) return;
+
+	barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(mResource.Get(), mCurrState, state));
+
 	mCurrState = state;
 }
\ No newline at end of file
@@ -21,11 +21,6 @@ D3D12_INDEX_BUFFER_VIEW MeshGeometry::IndexBufferView() const {
 	return ibv;
 }
 
-void MeshGeometry::DisposeUploaders() {
-	VertexBufferUploader = nullptr;
-	IndexBufferUploader = nullptr;
-}
-
 Common::Foundation::Hash Render::DX::Foundation::Resource::MeshGeometry::Hash(MeshGeometry* ptr) {
 	uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
 	return Common::Util::HashUtil::HashCombine(0, static_cast<Common::Foundation::Hash>(addr));
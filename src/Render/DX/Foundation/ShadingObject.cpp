@@ -18,8 +18,6 @@ BOOL ShadingObject::Initialize(Common::Debug::LogFile* const pLogFile, void* con
 
 void ShadingObject::CleanUp() {}
 
-BOOL ShadingObject::CompileShaders() { return TRUE; }
-
 BOOL ShadingObject::BuildRootSignatures() { return TRUE; }
 
 BOOL ShadingObject::BuildPipelineStates() { return TRUE; }
@@ -30,4 +28,12 @@ BOOL ShadingObject::OnResize(UINT width, UINT height) { return TRUE;  }
 
 BOOL ShadingObject::BuildShaderTables(UINT numRitems) { return TRUE; }
 
-BOOL ShadingObject::Update() { return TRUE; }
\ No newline at end of file
+BOOL ShadingObject::Update() { return TRUE; }
+
+void ShadingObject::SetRenderArea(UINT width, UINT height, const DirectX::XMFLOAT2& uvScale) {
+	mRenderWidth = width;
+	mRenderHeight = height;
+
+	mPrevUVScale = mUVScale;
+	mUVScale = uvScale;
+}
\ No newline at end of file
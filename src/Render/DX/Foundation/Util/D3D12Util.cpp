@@ -4,12 +4,13 @@
 #include "Common/Foundation/Mesh/Vertex.h"
 #include "Render/DX/Foundation/Core/Factory.hpp"
 #include "Render/DX/Foundation/Core/Device.hpp"
+#include "Render/DX/Foundation/Core/PipelineStateCache.hpp"
 #include "Render/DX/Foundation/Core/CommandObject.hpp"
+#include "Render/DX/Foundation/Core/UploadQueue.hpp"
 #include "Render/DX/Foundation/Resource/GpuResource.hpp"
 #include "Render/DX/Foundation/Resource/Texture.hpp"
 
 #include <DDSTextureLoader.h>
-#include <ResourceUploadBatch.h>
 
 namespace {
 	const D3D12_INPUT_ELEMENT_DESC gInputLayout[] = {
@@ -277,31 +278,67 @@ void D3D12Util::CreateDepthStencilView(
 
 BOOL D3D12Util::CreateTexture(
 		Core::Device* const pDevice, 
-		Core::CommandObject* const pCmdObject, 
+		Core::UploadQueue* const pUploadQueue, 
 		Resource::Texture* const pTexture, 
 		LPCWSTR filePath,
-		BOOL bGenerateMipmapIfMissing,
 		UINT maxSize) {
-	ResourceUploadBatch resourceUpload(pDevice->md3dDevice.Get());
-	resourceUpload.Begin();
-	
-	const HRESULT status = DirectX::CreateDDSTextureFromFile(
-		pDevice->md3dDevice.Get(),
-		resourceUpload,
-		filePath,
-		pTexture->Resource.ReleaseAndGetAddressOf(),
-		bGenerateMipmapIfMissing,
-		maxSize);
-	
-	auto finished = resourceUpload.End(pCmdObject->mCommandQueue.Get());
-	finished.wait();
-	
+	std::unique_ptr<uint8_t[]> ddsData{};
+	ScratchImage image{};
+	std::vector<D3D12_SUBRESOURCE_DATA> subresources{};
+
+	HRESULT status{};
+	if (_wcsicmp(std::filesystem::path(filePath).extension().c_str(), L".dds") == 0) {
+		status = DirectX::LoadDDSTextureFromFile(
+			pDevice->md3dDevice.Get(),
+			filePath,
+			pTexture->Resource.ReleaseAndGetAddressOf(),
+			ddsData,
+			subresources,
+			maxSize);
+	}
+	else {
+		// Material maps usually come as PNG or JPEG; maxSize does not
+		// apply to them.
+		TexMetadata metadata{};
+		status = LoadFromWICFile(filePath, WIC_FLAGS_NONE, &metadata, image);
+		if (SUCCEEDED(status)) 
+			status = DirectX::CreateTexture(pDevice->md3dDevice.Get(), metadata, pTexture->Resource.ReleaseAndGetAddressOf());
+		if (SUCCEEDED(status)) 
+			status = PrepareUpload(pDevice->md3dDevice.Get(), image.GetImages(), image.GetImageCount(), metadata, subresources);
+	}
+
 	if (FAILED(status)) {
 		std::wstringstream wsstream;
 		wsstream << L"Returned 0x" << std::hex << status << L"; when creating texture:  " << filePath;
 		ReturnFalse(mpLogFile, wsstream.str());
 	}
 
+	// The file data is staged right away, so it may go afterwards.
+	CheckReturn(mpLogFile, pUploadQueue->UploadTexture(
+		pTexture->Resource.Get(),
+		0,
+		static_cast<UINT>(subresources.size()),
+		subresources.data()));
+
+	return TRUE;
+}
+
+BOOL D3D12Util::CreateTexture(
+		Core::Device* const pDevice,
+		const D3D12_RESOURCE_DESC& desc,
+		const IID& riid,
+		void** const ppResource) {
+	const CD3DX12_HEAP_PROPERTIES HeapProp(D3D12_HEAP_TYPE_DEFAULT);
+
+	CheckHRESULT(mpLogFile, pDevice->md3dDevice->CreateCommittedResource(
+		&HeapProp,
+		D3D12_HEAP_FLAG_NONE,
+		&desc,
+		D3D12_RESOURCE_STATE_COMMON,
+		nullptr,
+		riid,
+		ppResource));
+
 	return TRUE;
 }
 
@@ -334,10 +371,12 @@ BOOL D3D12Util::CreateRootSignature(
 		riid,
 		ppRootSignature
 	));
-	if (name != nullptr) {
-		auto rootSig = reinterpret_cast<ID3D12RootSignature*>(*ppRootSignature);
-		rootSig->SetName(name);
-	}
+
+	auto rootSig = reinterpret_cast<ID3D12RootSignature*>(*ppRootSignature);
+	Core::PipelineStateCache::TagRootSignature(
+		rootSig, serializedRootSig->GetBufferPointer(), serializedRootSig->GetBufferSize());
+
+	if (name != nullptr) rootSig->SetName(name);
 
 	return TRUE;
 }
@@ -410,7 +449,12 @@ BOOL D3D12Util::CreateComputePipelineState(
 		const IID& riid,
 		void** const ppPipelineState,
 		LPCWSTR name) {
-	CheckHRESULT(mpLogFile, pDevice->md3dDevice->CreateComputePipelineState(&desc, riid, ppPipelineState));
+	if (pDevice->mpPipelineStateCache != nullptr) {
+		CheckReturn(mpLogFile, pDevice->mpPipelineStateCache->CreateComputePipelineState(desc, riid, ppPipelineState, name));
+	}
+	else {
+		CheckHRESULT(mpLogFile, pDevice->md3dDevice->CreateComputePipelineState(&desc, riid, ppPipelineState));
+	}
 
 	if (name != nullptr) {
 		auto pso = reinterpret_cast<ID3D12PipelineState*>(*ppPipelineState);
@@ -426,7 +470,12 @@ BOOL D3D12Util::CreateGraphicsPipelineState(
 		const IID& riid,
 		void** const ppPipelineState,
 		LPCWSTR name) {
-	CheckHRESULT(mpLogFile, pDevice->md3dDevice->CreateGraphicsPipelineState(&desc, riid, ppPipelineState));
+	if (pDevice->mpPipelineStateCache != nullptr) {
+		CheckReturn(mpLogFile, pDevice->mpPipelineStateCache->CreateGraphicsPipelineState(desc, riid, ppPipelineState, name));
+	}
+	else {
+		CheckHRESULT(mpLogFile, pDevice->md3dDevice->CreateGraphicsPipelineState(&desc, riid, ppPipelineState));
+	}
 
 	if (name != nullptr) {
 		auto pso = reinterpret_cast<ID3D12PipelineState*>(*ppPipelineState);
@@ -442,13 +491,18 @@ BOOL D3D12Util::CreatePipelineState(
 		const IID& riid,
 		void** const ppPipelineState,
 		LPCWSTR name) {
-	auto meshStreamDesc = CD3DX12_PIPELINE_MESH_STATE_STREAM(desc);
+	if (pDevice->mpPipelineStateCache != nullptr) {
+		CheckReturn(mpLogFile, pDevice->mpPipelineStateCache->CreatePipelineState(desc, riid, ppPipelineState, name));
+	}
+	else {
+		auto meshStreamDesc = CD3DX12_PIPELINE_MESH_STATE_STREAM(desc);
 
-	D3D12_PIPELINE_STATE_STREAM_DESC streamDesc = {};
-	streamDesc.SizeInBytes = sizeof(meshStreamDesc);
-	streamDesc.pPipelineStateSubobjectStream = &meshStreamDesc;
+		D3D12_PIPELINE_STATE_STREAM_DESC streamDesc = {};
+		streamDesc.SizeInBytes = sizeof(meshStreamDesc);
+		streamDesc.pPipelineStateSubobjectStream = &meshStreamDesc;
 
-	CheckHRESULT(mpLogFile, pDevice->md3dDevice->CreatePipelineState(&streamDesc, riid, ppPipelineState));
+		CheckHRESULT(mpLogFile, pDevice->md3dDevice->CreatePipelineState(&streamDesc, riid, ppPipelineState));
+	}
 
 	if (name != nullptr) {
 		auto pso = reinterpret_cast<ID3D12PipelineState*>(*ppPipelineState);
@@ -468,6 +522,23 @@ BOOL D3D12Util::CreateStateObject(
 	return TRUE;
 }
 
+BOOL D3D12Util::CreateCommandSignature(
+		Core::Device* const pDevice,
+		const D3D12_COMMAND_SIGNATURE_DESC& desc,
+		ID3D12RootSignature* const pRootSignature,
+		const IID& riid,
+		void** const ppCommandSignature,
+		LPCWSTR name) {
+	CheckHRESULT(mpLogFile, pDevice->md3dDevice->CreateCommandSignature(&desc, pRootSignature, riid, ppCommandSignature));
+
+	if (name != nullptr) {
+		auto signature = reinterpret_cast<ID3D12CommandSignature*>(*ppCommandSignature);
+		signature->SetName(name);
+	}
+
+	return TRUE;
+}
+
 D3D12_INPUT_LAYOUT_DESC D3D12Util::InputLayoutDesc() { return gInputLayoutDesc; }
 
 BOOL D3D12Util::CaptureTexture(
@@ -0,0 +1,167 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Util/TextureCooker.hpp"
+#include "Common/Debug/Logger.hpp"
+
+#include <filesystem>
+
+using namespace Render::DX::Foundation::Util;
+using namespace DirectX;
+
+namespace {
+	const WCHAR* const CookedFileExtension = L".bc.dds";
+
+	// A cooked map below this is reported, so a bad encode shows up in the
+	// log instead of on screen. HDR maps are not held to it.
+	const FLOAT MinPSNR = 30.f;
+
+	// D3D12 requires the top level of a block-compressed texture to be
+	// made of whole 4x4 blocks.
+	BOOL IsBlockAligned(const TexMetadata& metadata) {
+		return (metadata.width % 4) == 0 && (metadata.height % 4) == 0;
+	}
+}
+
+Common::Debug::LogFile* TextureCooker::mpLogFile = nullptr;
+
+BOOL TextureCooker::Initialize(Common::Debug::LogFile* const pLogFile) {
+	mpLogFile = pLogFile;
+
+	return TRUE;
+}
+
+BOOL TextureCooker::CookTexture(
+		LPCWSTR srcPath,
+		TextureUsage::Type usage,
+		std::wstring& cookedPath) {
+	cookedPath = srcPath;
+
+	const std::filesystem::path SrcPath(srcPath);
+	if (_wcsicmp(SrcPath.extension().c_str(), L".dds") == 0) return TRUE;
+
+	std::filesystem::path dstPath(SrcPath);
+	dstPath.replace_extension(CookedFileExtension);
+
+	std::error_code ec{};
+	if (std::filesystem::exists(dstPath, ec) &&
+			std::filesystem::last_write_time(dstPath, ec) >= std::filesystem::last_write_time(SrcPath, ec)) {
+		cookedPath = dstPath.wstring();
+		return TRUE;
+	}
+
+	TexMetadata metadata{};
+	ScratchImage source{};
+	CheckHRESULT(mpLogFile, LoadFromWICFile(srcPath, WIC_FLAGS_NONE, &metadata, source));
+
+	if (!IsBlockAligned(metadata)) {
+		WLogln(mpLogFile, L"Texture is not made of whole 4x4 blocks and stays uncompressed: ", srcPath);
+		return TRUE;
+	}
+
+	ScratchImage cooked{};
+	CheckHRESULT(mpLogFile, cooked.InitializeFromImage(*source.GetImage(0, 0, 0)));
+	CheckReturn(mpLogFile, Compress(cooked, usage));
+
+	FLOAT psnr = 0.f;
+	CheckReturn(mpLogFile, ComputePSNR(*source.GetImage(0, 0, 0), *cooked.GetImage(0, 0, 0), usage, psnr));
+
+	CheckHRESULT(mpLogFile, SaveToDDSFile(
+		cooked.GetImages(),
+		cooked.GetImageCount(),
+		cooked.GetMetadata(),
+		DDS_FLAGS_NONE,
+		dstPath.c_str()));
+
+	if (usage != TextureUsage::E_HDR && psnr < MinPSNR) {
+		WLogln(mpLogFile, L"[Warning] Cooked texture is below the PSNR floor (", std::to_wstring(psnr), L" dB): ", srcPath);
+	}
+	else {
+		WLogln(mpLogFile, L"Texture cooked (", std::to_wstring(psnr), L" dB): ", srcPath);
+	}
+
+	cookedPath = dstPath.wstring();
+
+	return TRUE;
+}
+
+BOOL TextureCooker::Compress(
+		ScratchImage& image,
+		TextureUsage::Type usage) {
+	if (image.GetMetadata().mipLevels == 1) {
+		ScratchImage mipChain{};
+		CheckHRESULT(mpLogFile, GenerateMipMaps(
+			image.GetImages(),
+			image.GetImageCount(),
+			image.GetMetadata(),
+			TEX_FILTER_DEFAULT,
+			0,
+			mipChain));
+
+		image = std::move(mipChain);
+	}
+
+	const DXGI_FORMAT Format = CompressedFormat(image, usage);
+
+	// Quick BC7 only tries mode 6, which keeps cooking a 2K map in the
+	// order of a second at little cost for material maps.
+	TEX_COMPRESS_FLAGS flags = TEX_COMPRESS_PARALLEL;
+	if (Format == DXGI_FORMAT_BC7_UNORM || Format == DXGI_FORMAT_BC7_UNORM_SRGB) flags |= TEX_COMPRESS_BC7_QUICK;
+
+	ScratchImage compressed{};
+	CheckHRESULT(mpLogFile, DirectX::Compress(
+		image.GetImages(),
+		image.GetImageCount(),
+		image.GetMetadata(),
+		Format,
+		flags,
+		TEX_THRESHOLD_DEFAULT,
+		compressed));
+
+	image = std::move(compressed);
+
+	return TRUE;
+}
+
+BOOL TextureCooker::ComputePSNR(
+		const Image& reference,
+		const Image& cooked,
+		TextureUsage::Type usage,
+		FLOAT& psnr) {
+	CMSE_FLAGS flags = CMSE_DEFAULT;
+	switch (usage) {
+	case TextureUsage::E_Normal:
+		flags = CMSE_IGNORE_BLUE | CMSE_IGNORE_ALPHA;
+		break;
+	case TextureUsage::E_Mask:
+		flags = CMSE_IGNORE_GREEN | CMSE_IGNORE_BLUE | CMSE_IGNORE_ALPHA;
+		break;
+	case TextureUsage::E_HDR:
+		flags = CMSE_IGNORE_ALPHA;
+		break;
+	default:
+		break;
+	}
+
+	FLOAT mse = 0.f;
+	CheckHRESULT(mpLogFile, ComputeMSE(reference, cooked, mse, nullptr, flags));
+
+	// Channels are compared as normalized values, so the peak is one.
+	psnr = mse > 0.f ? 10.f * std::log10(1.f / mse) : std::numeric_limits<FLOAT>::infinity();
+
+	return TRUE;
+}
+
+DXGI_FORMAT TextureCooker::CompressedFormat(const ScratchImage& image, TextureUsage::Type usage) {
+	switch (usage) {
+	case TextureUsage::E_Normal:
+		return DXGI_FORMAT_BC5_UNORM;
+	case TextureUsage::E_Mask:
+		return DXGI_FORMAT_BC4_UNORM;
+	case TextureUsage::E_HDR:
+		return DXGI_FORMAT_BC6H_UF16;
+	default:
+		break;
+	}
+
+	const DXGI_FORMAT Format = image.IsAlphaAllOpaque() ? DXGI_FORMAT_BC1_UNORM : DXGI_FORMAT_BC7_UNORM;
+	return IsSRGB(image.GetMetadata().format) ? MakeSRGB(Format) : Format;
+}
\ No newline at end of file
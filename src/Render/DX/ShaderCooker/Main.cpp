@@ -0,0 +1,52 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Shading/Util/ShaderManager.hpp"
+#include "Common/Debug/Logger.hpp"
+
+#include <thread>
+
+namespace {
+	// Directories are passed without a trailing separator; a quoted
+	// "dir\" would escape its closing quote.
+	std::wstring AsDirectory(LPCWSTR path) {
+		std::wstring dir(path);
+		if (!dir.empty() && dir.back() != L'\\' && dir.back() != L'/') dir.push_back(L'\\');
+		return dir;
+	}
+
+	BOOL Cook(Common::Debug::LogFile* const pLogFile, LPCWSTR manifest, LPCWSTR shaderDir, LPCWSTR archive, LPCWSTR cacheDir) {
+		const UINT ThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+		Render::DX::Shading::Util::ShaderManager shaderManager{};
+		CheckReturn(pLogFile, shaderManager.Initialize(pLogFile, ThreadCount, cacheDir, TRUE));
+		CheckReturn(pLogFile, shaderManager.LoadManifest(manifest));
+		// Entries whose sources did not change are carried over as they are.
+		CheckReturn(pLogFile, shaderManager.LoadArchive(archive));
+		CheckReturn(pLogFile, shaderManager.CompileShaders(shaderDir));
+		CheckReturn(pLogFile, shaderManager.WriteArchive(archive));
+
+		return TRUE;
+	}
+}
+
+// Compiles every shader the manifest lists into one archive, so that the
+// renderer never has to compile at run time outside of debug builds.
+//   ShaderCooker <manifest> <shader dir> <archive> [cache dir]
+INT wmain(INT argc, WCHAR* argv[]) {
+	Common::Debug::LogFile logFile{};
+	if (!Common::Debug::Logger::Initialize(&logFile, L"./ShaderCooker.log")) return -1;
+
+	if (argc < 4) {
+		WLogln(&logFile, L"Usage: ShaderCooker <manifest> <shader dir> <archive> [cache dir]");
+		return -1;
+	}
+
+	const auto ShaderDir = AsDirectory(argv[2]);
+	const auto CacheDir = AsDirectory(argc > 4 ? argv[4] : L".\\ShaderCache");
+
+	if (!Cook(&logFile, argv[1], ShaderDir.c_str(), argv[3], CacheDir.c_str())) {
+		WLogln(&logFile, L"Failed to cook shaders");
+		return -1;
+	}
+
+	return 0;
+}
\ No newline at end of file
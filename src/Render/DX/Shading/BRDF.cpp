@@ -12,11 +12,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_ComputeBRDF = L"ComputeBRDF.hlsl";
-	const WCHAR* const HLSL_IntegrateIrradiance = L"IntegrateIrradiance.hlsl";
-}
-
 BRDF::InitDataPtr BRDF::MakeInitData() {
 	return std::unique_ptr<BRDFClass::InitData>(new BRDFClass::InitData());
 }
@@ -52,47 +47,6 @@ void BRDF::BRDFClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL BRDF::BRDFClass::CompileShaders() {
-	// ComputeBRDF
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ComputeBRDF, L"VS", L"vs_6_5");
-		const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ComputeBRDF, L"MS", L"ms_6_5");
-
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_ComputeBRDF]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_ComputeBRDF]));
-
-		// BlinnPhong
-		{
-			DxcDefine defines[] = {
-				{ L"BLINN_PHONG", L"1" }
-			};
-
-			const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ComputeBRDF, L"PS", L"ps_6_5", defines, _countof(defines));
-			CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ComputeBRDF_BlinnPhong]));
-		}
-		// CookTorrance
-		{
-			DxcDefine defines[] = {
-				{ L"COOK_TORRANCE", L"1" }
-			};
-
-			const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ComputeBRDF, L"PS", L"ps_6_5", defines, _countof(defines));
-			CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ComputeBRDF_CookTorrance]));
-		}
-	}
-	// IntegrateIrradiance
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_IntegrateIrradiance, L"VS", L"vs_6_5");
-		const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_IntegrateIrradiance, L"MS", L"ms_6_5");
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_IntegrateIrradiance, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_IntegrateIrradiance]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_IntegrateIrradiance]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_IntegrateIrradiance]));
-	}
-
-	return TRUE;
-}
-
 BOOL BRDF::BRDFClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -120,6 +74,9 @@ BOOL BRDF::BRDFClass::BuildRootSignatures() {
 		slotRootParameter[RootSignature::ComputeBRDF::SI_RoughnessMetalicMap].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::ComputeBRDF::SI_PositionMap].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::ComputeBRDF::SI_ShadowMap].InitAsDescriptorTable(1, &texTables[index++]);
+		slotRootParameter[RootSignature::ComputeBRDF::SI_ClusteredLights].InitAsShaderResourceView(7);
+		slotRootParameter[RootSignature::ComputeBRDF::SI_LightClusters].InitAsShaderResourceView(8);
+		slotRootParameter[RootSignature::ComputeBRDF::SI_ClusterLightIndices].InitAsShaderResourceView(9);
 
 		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
 			_countof(slotRootParameter), slotRootParameter,
@@ -135,7 +92,7 @@ BOOL BRDF::BRDFClass::BuildRootSignatures() {
 	}
 	// IntegrateIrradiance
 	{
-		CD3DX12_DESCRIPTOR_RANGE texTables[12]{}; UINT index = 0;
+		CD3DX12_DESCRIPTOR_RANGE texTables[11]{}; UINT index = 0;
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 1, 0);
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 2, 0);
@@ -145,7 +102,6 @@ BOOL BRDF::BRDFClass::BuildRootSignatures() {
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 6, 0);
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 7, 0);
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 8, 0);
-		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 9, 0);
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 10, 0);
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 11, 0);
 
@@ -154,6 +110,7 @@ BOOL BRDF::BRDFClass::BuildRootSignatures() {
 		CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::IntegrateIrradiance::Count]{};
 		slotRootParameter[RootSignature::IntegrateIrradiance::CB_Pass].InitAsConstantBufferView(0);
 		slotRootParameter[RootSignature::IntegrateIrradiance::RC_Consts].InitAsConstants(ShadingConvention::BRDF::RootConstant::IntegrateIrradiance::Count, 1);
+		slotRootParameter[RootSignature::IntegrateIrradiance::CB_IrradianceSH].InitAsConstantBufferView(2);
 		slotRootParameter[RootSignature::IntegrateIrradiance::SI_BackBuffer].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::IntegrateIrradiance::SI_AlbedoMap].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::IntegrateIrradiance::SI_NormalMap].InitAsDescriptorTable(1, &texTables[index++]);
@@ -163,7 +120,6 @@ BOOL BRDF::BRDFClass::BuildRootSignatures() {
 		slotRootParameter[RootSignature::IntegrateIrradiance::SI_PositionMap].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::IntegrateIrradiance::SI_AOMap].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::IntegrateIrradiance::SI_ReflectionMap].InitAsDescriptorTable(1, &texTables[index++]);
-		slotRootParameter[RootSignature::IntegrateIrradiance::SI_DiffuseIrradianceCubeMap].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::IntegrateIrradiance::SI_BrdfLutMap].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::IntegrateIrradiance::SI_PrefilteredEnvCubeMap].InitAsDescriptorTable(1, &texTables[index++]);
 
@@ -190,7 +146,7 @@ BOOL BRDF::BRDFClass::BuildPipelineStates() {
 			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenMeshPsoDesc();
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ComputeBRDF].Get();
 			{
-				const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_ComputeBRDF]);
+				const auto MS = mInitData.ShaderManager->GetShader(L"BRDF.MS_ComputeBRDF");
 				NullCheck(mpLogFile, MS);
 				psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 			}
@@ -201,7 +157,7 @@ BOOL BRDF::BRDFClass::BuildPipelineStates() {
 			{
 				{
 					const auto PS = mInitData.ShaderManager->GetShader(
-						mShaderHashes[Shader::PS_ComputeBRDF_BlinnPhong]);
+						L"BRDF.PS_ComputeBRDF_BlinnPhong");
 					NullCheck(mpLogFile, PS);
 					psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
 				}
@@ -216,7 +172,7 @@ BOOL BRDF::BRDFClass::BuildPipelineStates() {
 			{
 				{
 					const auto PS = mInitData.ShaderManager->GetShader(
-						mShaderHashes[Shader::PS_ComputeBRDF_CookTorrance]);
+						L"BRDF.PS_ComputeBRDF_CookTorrance");
 					NullCheck(mpLogFile, PS);
 					psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
 				}
@@ -232,7 +188,7 @@ BOOL BRDF::BRDFClass::BuildPipelineStates() {
 			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ComputeBRDF].Get();
 			{
-				const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_ComputeBRDF]);
+				const auto VS = mInitData.ShaderManager->GetShader(L"BRDF.VS_ComputeBRDF");
 				NullCheck(mpLogFile, VS);
 				psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			}
@@ -243,7 +199,7 @@ BOOL BRDF::BRDFClass::BuildPipelineStates() {
 			{
 				{
 					const auto PS = mInitData.ShaderManager->GetShader(
-						mShaderHashes[Shader::PS_ComputeBRDF_BlinnPhong]);
+						L"BRDF.PS_ComputeBRDF_BlinnPhong");
 					NullCheck(mpLogFile, PS);
 					psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
 				}
@@ -258,7 +214,7 @@ BOOL BRDF::BRDFClass::BuildPipelineStates() {
 			{
 				{
 					const auto PS = mInitData.ShaderManager->GetShader(
-						mShaderHashes[Shader::PS_ComputeBRDF_CookTorrance]);
+						L"BRDF.PS_ComputeBRDF_CookTorrance");
 					NullCheck(mpLogFile, PS);
 					psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
 				}
@@ -278,9 +234,9 @@ BOOL BRDF::BRDFClass::BuildPipelineStates() {
 			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenMeshPsoDesc();
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_IntegrateIrradiance].Get();
 			{
-				const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_IntegrateIrradiance]);
+				const auto MS = mInitData.ShaderManager->GetShader(L"BRDF.MS_IntegrateIrradiance");
 				NullCheck(mpLogFile, MS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_IntegrateIrradiance]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"BRDF.PS_IntegrateIrradiance");
 				NullCheck(mpLogFile, PS);
 				psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -298,9 +254,9 @@ BOOL BRDF::BRDFClass::BuildPipelineStates() {
 			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_IntegrateIrradiance].Get();
 			{
-				const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_IntegrateIrradiance]);
+				const auto VS = mInitData.ShaderManager->GetShader(L"BRDF.VS_IntegrateIrradiance");
 				NullCheck(mpLogFile, VS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_IntegrateIrradiance]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"BRDF.PS_IntegrateIrradiance");
 				NullCheck(mpLogFile, PS);
 				psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -372,7 +328,7 @@ BOOL BRDF::BRDFClass::ComputeBRDF(
 			RootSignature::ComputeBRDF::CB_Light, pFrameResource->LightCB.CBAddress());
 
 		ShadingConvention::BRDF::RootConstant::ComputeBRDF::Struct rc;
-		rc.gTexDim = { mInitData.ClientWidth, mInitData.ClientHeight };
+		rc.gTexDim = { mRenderWidth, mRenderHeight };
 		rc.gShadowEnabled = bShadowEnabled;
 
 		std::array<std::uint32_t, ShadingConvention::BRDF::RootConstant::ComputeBRDF::Count> consts;
@@ -388,6 +344,13 @@ BOOL BRDF::BRDFClass::ComputeBRDF(
 		CmdList->SetGraphicsRootDescriptorTable(RootSignature::ComputeBRDF::SI_PositionMap, si_positionMap);
 		CmdList->SetGraphicsRootDescriptorTable(RootSignature::ComputeBRDF::SI_ShadowMap, si_shadowMap);
 
+		CmdList->SetGraphicsRootShaderResourceView(
+			RootSignature::ComputeBRDF::SI_ClusteredLights, pFrameResource->ClusteredLights.CBAddress());
+		CmdList->SetGraphicsRootShaderResourceView(
+			RootSignature::ComputeBRDF::SI_LightClusters, pFrameResource->LightClusters.CBAddress());
+		CmdList->SetGraphicsRootShaderResourceView(
+			RootSignature::ComputeBRDF::SI_ClusterLightIndices, pFrameResource->ClusterLightIndices.CBAddress());
+
 		if (mInitData.MeshShaderSupported) {
 			CmdList->DispatchMesh(1, 1, 1);
 		}
@@ -417,7 +380,6 @@ BOOL BRDF::BRDFClass::IntegrateIrradiance(
 		Foundation::Resource::GpuResource* const pRoughnessMetalnessMap, D3D12_GPU_DESCRIPTOR_HANDLE si_roughnessMetalnessMap,
 		Foundation::Resource::GpuResource* const pPositionMap, D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
 		Foundation::Resource::GpuResource* const pAOMap, D3D12_GPU_DESCRIPTOR_HANDLE si_aoMap,
-		Foundation::Resource::GpuResource* const pDiffuseIrradianceMap, D3D12_GPU_DESCRIPTOR_HANDLE si_diffuseIrradianceMap,
 		Foundation::Resource::GpuResource* const pBrdfLutMap, D3D12_GPU_DESCRIPTOR_HANDLE si_brdfLutMap,
 		Foundation::Resource::GpuResource* const pPrefilteredEnvCubeMap, D3D12_GPU_DESCRIPTOR_HANDLE si_prefilteredEnvCubeMap,
 		BOOL bAoEnabled) {
@@ -451,7 +413,6 @@ BOOL BRDF::BRDFClass::IntegrateIrradiance(
 		pRoughnessMetalnessMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 		pAOMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pDiffuseIrradianceMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 		pBrdfLutMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 		pPrefilteredEnvCubeMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
@@ -472,6 +433,10 @@ BOOL BRDF::BRDFClass::IntegrateIrradiance(
 			ShadingConvention::BRDF::RootConstant::IntegrateIrradiance::Count, 
 			consts.data(), 0);
 
+		CmdList->SetGraphicsRootConstantBufferView(
+			RootSignature::IntegrateIrradiance::CB_IrradianceSH,
+			pFrameResource->IrradianceSHCB.CBAddress());
+
 		CmdList->SetGraphicsRootDescriptorTable(
 			RootSignature::IntegrateIrradiance::SI_BackBuffer, si_backBufferCopy);
 		CmdList->SetGraphicsRootDescriptorTable(
@@ -488,8 +453,6 @@ BOOL BRDF::BRDFClass::IntegrateIrradiance(
 			RootSignature::IntegrateIrradiance::SI_PositionMap, si_positionMap);
 		CmdList->SetGraphicsRootDescriptorTable(
 			RootSignature::IntegrateIrradiance::SI_AOMap, si_aoMap);
-		CmdList->SetGraphicsRootDescriptorTable(
-			RootSignature::IntegrateIrradiance::SI_DiffuseIrradianceCubeMap, si_diffuseIrradianceMap);
 		CmdList->SetGraphicsRootDescriptorTable(
 			RootSignature::IntegrateIrradiance::SI_BrdfLutMap, si_brdfLutMap);
 		CmdList->SetGraphicsRootDescriptorTable(
@@ -5,6 +5,7 @@
 #include "Render/DX/Foundation/Core/Device.hpp"
 #include "Render/DX/Foundation/Core/CommandObject.hpp"
 #include "Render/DX/Foundation/Core/DescriptorHeap.hpp"
+#include "Render/DX/Foundation/Core/RenderGraph.hpp"
 #include "Render/DX/Foundation/Resource/FrameResource.hpp"
 #include "Render/DX/Foundation/Util/D3D12Util.hpp"
 #include "Render/DX/Shading/Util/ShaderManager.hpp"
@@ -12,12 +13,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_ExtractHighlights = L"ExtractHighlights.hlsl";
-	const WCHAR* const HLSL_BlendBloomWithDownSampled = L"BlendBloomWithDownSampled.hlsl";
-	const WCHAR* const HLSL_ApplyBloom = L"ApplyBloom.hlsl";
-}
-
 Bloom::InitDataPtr Bloom::MakeInitData() {
 	return std::unique_ptr<BloomClass::InitData>(new BloomClass::InitData());
 }
@@ -31,12 +26,7 @@ Bloom::BloomClass::BloomClass() {
 
 Bloom::BloomClass::~BloomClass() { CleanUp(); }
 
-UINT Bloom::BloomClass::CbvSrvUavDescCount() const { return 0 +
-	Resource::Count +	// HightlightMap Srvs
-	Resource::Count +	// HightlightMap Uavs
-	Resource::Count +	// BloomMap Srvs
-	Resource::Count;	// BloomMap Uavs
-}
+UINT Bloom::BloomClass::CbvSrvUavDescCount() const { return 0; }
 
 UINT Bloom::BloomClass::RtvDescCount() const { return 0; }
 
@@ -48,8 +38,6 @@ BOOL Bloom::BloomClass::Initialize(Common::Debug::LogFile* const pLogFile, void*
 	const auto initData = reinterpret_cast<InitData*>(pData);
 	mInitData = *initData;
 
-	CheckReturn(mpLogFile, BuildResources());
-
 	return TRUE;
 }
 
@@ -71,30 +59,6 @@ void Bloom::BloomClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL Bloom::BloomClass::CompileShaders() {
-	// ExtractHighlights
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ExtractHighlights, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_ExtractHighlights]));
-	}
-	// BlendBloomWithDownSampled
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_BlendBloomWithDownSampled, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_BlendBloomWithDownSampled]));
-	}
-	// ApplyBloom
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ApplyBloom, L"VS", L"vs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_ApplyBloom]));
-		const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ApplyBloom, L"MS", L"ms_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_ApplyBloom]));
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ApplyBloom, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ApplyBloom]));
-	}
-
-	return TRUE;
-}
-
 BOOL Bloom::BloomClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 	// ExtractHighlights
@@ -162,6 +126,8 @@ BOOL Bloom::BloomClass::BuildRootSignatures() {
 		index = 0;
 
 		CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::ApplyBloom::Count]{};
+		slotRootParameter[RootSignature::ApplyBloom::RC_Consts].InitAsConstants(
+			ShadingConvention::Bloom::RootConstant::ApplyBloom::Count, 0);
 		slotRootParameter[RootSignature::ApplyBloom::SI_BackBuffer].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::ApplyBloom::SI_BloomMap].InitAsDescriptorTable(1, &texTables[index++]);
 
@@ -187,7 +153,7 @@ BOOL Bloom::BloomClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ExtractHighlights].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_ExtractHighlights]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"Bloom.CS_ExtractHighlights");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -204,7 +170,7 @@ BOOL Bloom::BloomClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_BlendBloomWithDownSampled].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_BlendBloomWithDownSampled]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"Bloom.CS_BlendBloomWithDownSampled");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -221,9 +187,9 @@ BOOL Bloom::BloomClass::BuildPipelineStates() {
 			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenMeshPsoDesc();
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ApplyBloom].Get();
 			{
-				const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_ApplyBloom]);
+				const auto MS = mInitData.ShaderManager->GetShader(L"Bloom.MS_ApplyBloom");
 				NullCheck(mpLogFile, MS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ApplyBloom]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"Bloom.PS_ApplyBloom");
 				NullCheck(mpLogFile, PS);
 				psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -240,9 +206,9 @@ BOOL Bloom::BloomClass::BuildPipelineStates() {
 			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ApplyBloom].Get();
 			{
-				const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_ApplyBloom]);
+				const auto VS = mInitData.ShaderManager->GetShader(L"Bloom.VS_ApplyBloom");
 				NullCheck(mpLogFile, VS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ApplyBloom]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"Bloom.PS_ApplyBloom");
 				NullCheck(mpLogFile, PS);
 				psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -260,38 +226,12 @@ BOOL Bloom::BloomClass::BuildPipelineStates() {
 	return TRUE;
 }
 
-BOOL Bloom::BloomClass::BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) {
-	for (UINT i = 0; i < Resource::Count; ++i) {
-		// HighlightMap
-		{
-			mhHighlightMapCpuSrvs[i] = pDescHeap->CbvSrvUavCpuOffset(1);
-			mhHighlightMapGpuSrvs[i] = pDescHeap->CbvSrvUavGpuOffset(1);
-
-			mhHighlightMapCpuUavs[i] = pDescHeap->CbvSrvUavCpuOffset(1);
-			mhHighlightMapGpuUavs[i] = pDescHeap->CbvSrvUavGpuOffset(1);
-		}
-		// BloomMap
-		{
-			mhBloomMapCpuSrvs[i] = pDescHeap->CbvSrvUavCpuOffset(1);
-			mhBloomMapGpuSrvs[i] = pDescHeap->CbvSrvUavGpuOffset(1);
-
-			mhBloomMapCpuUavs[i] = pDescHeap->CbvSrvUavCpuOffset(1);
-			mhBloomMapGpuUavs[i] = pDescHeap->CbvSrvUavGpuOffset(1);
-		}
-	}
-
-	CheckReturn(mpLogFile, BuildDescriptors());
-
-	return TRUE;
-}
+BOOL Bloom::BloomClass::BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) { return TRUE; }
 
 BOOL Bloom::BloomClass::OnResize(UINT width, UINT height) {
 	mInitData.ClientWidth = width;
 	mInitData.ClientHeight = height;
 
-	CheckReturn(mpLogFile, BuildResources());
-	CheckReturn(mpLogFile, BuildDescriptors());
-
 	return TRUE;
 }
 
@@ -301,16 +241,18 @@ BOOL Bloom::BloomClass::ExtractHighlights(
 		D3D12_GPU_DESCRIPTOR_HANDLE si_backBuffer,
 		FLOAT threshold, FLOAT softknee,
 		DownSampleFunc downSampleFunc) {
-	const auto QuarterWidth = mInitData.ClientWidth >> 1;
-	const auto QuarterHeight = mInitData.ClientHeight >> 1;
+	CheckReturn(mpLogFile, BuildTransientDescriptors());
+
+	const auto QuarterWidth = mRenderWidth >> 1;
+	const auto QuarterHeight = mRenderHeight >> 1;
 
 	CheckReturn(mpLogFile, downSampleFunc(
 		pBackBuffer,
 		si_backBuffer,
 		mHighlightMaps[Resource::E_4thRes].get(),
 		mhHighlightMapGpuUavs[Resource::E_4thRes],
-		mInitData.ClientWidth,
-		mInitData.ClientHeight,
+		mRenderWidth,
+		mRenderHeight,
 		QuarterWidth,
 		QuarterHeight,
 		2));
@@ -362,9 +304,13 @@ BOOL Bloom::BloomClass::ExtractHighlights(
 BOOL Bloom::BloomClass::BlurHighlights(
 		Foundation::Resource::FrameResource* const pFrameResource, 
 		DownSampleFunc downSampleFunc, 
-		BlurFunc blurFunc) {
+		BlurFunc blurFunc,
+		BOOL bHalfResolutionEnabled) {
 	CheckReturn(mpLogFile, DownSampling(downSampleFunc));
-	CheckReturn(mpLogFile, UpSamplingWithBlur(pFrameResource, blurFunc))
+	CheckReturn(mpLogFile, UpSamplingWithBlur(
+		pFrameResource, 
+		blurFunc, 
+		bHalfResolutionEnabled ? Resource::E_16thRes : Resource::E_4thRes))
 
 	return TRUE;
 }
@@ -376,7 +322,8 @@ BOOL Bloom::BloomClass::ApplyBloom(
 		Foundation::Resource::GpuResource* const pBackBuffer,
 		D3D12_CPU_DESCRIPTOR_HANDLE ro_backBuffer,
 		Foundation::Resource::GpuResource* const pBackBufferCopy,
-		D3D12_GPU_DESCRIPTOR_HANDLE si_backBufferCopy) {
+		D3D12_GPU_DESCRIPTOR_HANDLE si_backBufferCopy,
+		BOOL bHalfResolutionEnabled) {
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
 		0,
@@ -397,14 +344,26 @@ BOOL Bloom::BloomClass::ApplyBloom(
 
 		CmdList->CopyResource(pBackBufferCopy->Resource(), pBackBuffer->Resource());
 
-		const auto BloomMap = mBloomMaps[0].get();
+		const auto BloomIndex = bHalfResolutionEnabled ? Resource::E_16thRes : Resource::E_4thRes;
+		const auto BloomMap = mBloomMaps[BloomIndex].get();
 		pBackBuffer->Transite(CmdList, D3D12_RESOURCE_STATE_RENDER_TARGET);
 		BloomMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
 		CmdList->OMSetRenderTargets(1, &ro_backBuffer, TRUE, nullptr);
 
+		ShadingConvention::Bloom::RootConstant::ApplyBloom::Struct rc;
+		rc.gUVScale = mUVScale;
+
+		Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::Bloom::RootConstant::ApplyBloom::Struct>(
+			RootSignature::ApplyBloom::RC_Consts,
+			ShadingConvention::Bloom::RootConstant::ApplyBloom::Count,
+			&rc,
+			0,
+			CmdList,
+			FALSE);
+
 		CmdList->SetGraphicsRootDescriptorTable(RootSignature::ApplyBloom::SI_BackBuffer, si_backBufferCopy);
-		CmdList->SetGraphicsRootDescriptorTable(RootSignature::ApplyBloom::SI_BloomMap, mhBloomMapGpuSrvs[0]);
+		CmdList->SetGraphicsRootDescriptorTable(RootSignature::ApplyBloom::SI_BloomMap, mhBloomMapGpuSrvs[BloomIndex]);
 
 		if (mInitData.MeshShaderSupported) {
 			CmdList->DispatchMesh(1, 1, 1);
@@ -422,7 +381,7 @@ BOOL Bloom::BloomClass::ApplyBloom(
 	return TRUE;
 }
 
-BOOL Bloom::BloomClass::BuildResources() {
+void Bloom::BloomClass::DeclareTransients(Foundation::Core::RenderPassBuilder& builder) {
 	D3D12_RESOURCE_DESC texDesc;
 	ZeroMemory(&texDesc, sizeof(D3D12_RESOURCE_DESC));
 	texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
@@ -450,14 +409,12 @@ BOOL Bloom::BloomClass::BuildResources() {
 
 				name << L"Bloom_HighlightMap_" << i;
 
-				CheckReturn(mpLogFile, mHighlightMaps[i]->Initialize(
-					mInitData.Device,
-					&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-					D3D12_HEAP_FLAG_NONE,
-					&texDesc,
-					D3D12_RESOURCE_STATE_COMMON,
-					nullptr,
-					name.str().c_str()));
+				builder.Transient(
+					mHighlightMaps[i].get(),
+					texDesc,
+					D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+					name.str().c_str(),
+					nullptr);
 			}
 			// BloomMap
 			{
@@ -465,25 +422,30 @@ BOOL Bloom::BloomClass::BuildResources() {
 
 				name << L"Bloom_BloomMap_" << i;
 
-				CheckReturn(mpLogFile, mBloomMaps[i]->Initialize(
-					mInitData.Device,
-					&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-					D3D12_HEAP_FLAG_NONE,
-					&texDesc,
-					D3D12_RESOURCE_STATE_COMMON,
-					nullptr,
-					name.str().c_str()));
+				builder.Transient(
+					mBloomMaps[i].get(),
+					texDesc,
+					D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+					name.str().c_str(),
+					nullptr);
 			}
 
 			texW = texW >> 1;
 			texH = texH >> 1;
 		}
 	}
-
-	return TRUE;
 }
 
-BOOL Bloom::BloomClass::BuildDescriptors() {
+BOOL Bloom::BloomClass::BuildTransientDescriptors() {
+	const auto descHeap = mInitData.DescriptorHeap;
+
+	for (UINT i = 0; i < Resource::Count; ++i) {
+		CheckReturn(mpLogFile, descHeap->AllocateTransient(1, mhHighlightMapCpuSrvs[i], mhHighlightMapGpuSrvs[i]));
+		CheckReturn(mpLogFile, descHeap->AllocateTransient(1, mhHighlightMapCpuUavs[i], mhHighlightMapGpuUavs[i]));
+		CheckReturn(mpLogFile, descHeap->AllocateTransient(1, mhBloomMapCpuSrvs[i], mhBloomMapGpuSrvs[i]));
+		CheckReturn(mpLogFile, descHeap->AllocateTransient(1, mhBloomMapCpuUavs[i], mhBloomMapGpuUavs[i]));
+	}
+
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
@@ -529,10 +491,10 @@ BOOL Bloom::BloomClass::DownSampling(DownSampleFunc downSampleFunc) {
 	auto srcIndex = Resource::E_4thRes;
 	auto dstIndex = Resource::E_16thRes;
 
-	UINT srcTexDimX = mInitData.ClientWidth;
-	UINT srcTexDimY = mInitData.ClientHeight;
-	UINT dstTexDimX = mInitData.ClientWidth >> 1;
-	UINT dstTexDimY = mInitData.ClientHeight >> 1;
+	UINT srcTexDimX = mRenderWidth >> 1;
+	UINT srcTexDimY = mRenderHeight >> 1;
+	UINT dstTexDimX = mRenderWidth >> 2;
+	UINT dstTexDimY = mRenderHeight >> 2;
 
 	for (UINT i = 1; i < Resource::Count; ++i) {
 		CheckReturn(mpLogFile, downSampleFunc(
@@ -560,22 +522,27 @@ BOOL Bloom::BloomClass::DownSampling(DownSampleFunc downSampleFunc) {
 
 BOOL Bloom::BloomClass::UpSamplingWithBlur(
 		Foundation::Resource::FrameResource* const pFrameResource,
-		BlurFunc blurFunc) {
+		BlurFunc blurFunc,
+		Resource::Type topIndex) {
 	CheckReturn(mpLogFile, blurFunc(
 		mHighlightMaps[Resource::E_256thRes].get(),
 		mhHighlightMapGpuSrvs[Resource::E_256thRes],
 		mBloomMaps[Resource::E_256thRes].get(),
 		mhBloomMapGpuUavs[Resource::E_256thRes],
-		mInitData.ClientWidth >> 4,
-		mInitData.ClientHeight >> 4));
+		mRenderWidth >> 4,
+		mRenderHeight >> 4));
 
 	auto highSampIndex = Resource::E_64thRes;
 	auto lowSampIndex = Resource::E_256thRes;
 
-	auto texWidth = mInitData.ClientWidth >> 3;
-	auto texHeight = mInitData.ClientHeight >> 3;
+	auto texWidth = mRenderWidth >> 3;
+	auto texHeight = mRenderHeight >> 3;
+
+	// Only the area rendered into is blended, but UVs map onto the whole map.
+	auto allocWidth = mInitData.ClientWidth >> 3;
+	auto allocHeight = mInitData.ClientHeight >> 3;
 
-	for (UINT i = 0, end = Resource::Count - 1; i < end; ++i) {
+	for (UINT i = 0, end = Resource::Count - 1 - topIndex; i < end; ++i) {
 		{
 			CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 				pFrameResource->CommandAllocator(0),
@@ -597,7 +564,7 @@ BOOL Bloom::BloomClass::UpSamplingWithBlur(
 				Foundation::Util::D3D12Util::UavBarrier(CmdList, HighSampMap);
 
 				ShadingConvention::Bloom::RootConstant::BlendBloomWithDownSampled::Struct rc;
-				rc.gInvTexDim = { static_cast<FLOAT>(1.f / texWidth), static_cast<FLOAT>(1.f / texHeight) };
+				rc.gInvTexDim = { static_cast<FLOAT>(1.f / allocWidth), static_cast<FLOAT>(1.f / allocHeight) };
 
 				Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::Bloom::RootConstant::BlendBloomWithDownSampled::Struct>(
 					RootSignature::BlendBloomWithDownSampled::RC_Consts,
@@ -635,6 +602,8 @@ BOOL Bloom::BloomClass::UpSamplingWithBlur(
 
 		texWidth = texWidth << 1;
 		texHeight = texHeight << 1;
+		allocWidth = allocWidth << 1;
+		allocHeight = allocHeight << 1;
 	}
 
 	return TRUE;
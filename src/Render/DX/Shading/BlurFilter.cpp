@@ -13,11 +13,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_GaussianBlurFilter3x3 = L"GaussianBlurFilter3x3.hlsl";
-	const WCHAR* const HLSL_GaussianBlurFilterNxN = L"GaussianBlurFilterNxN.hlsl";
-}
-
 BlurFilter::InitDataPtr BlurFilter::MakeInitData() {
 	return std::unique_ptr<BlurFilterClass::InitData>(new BlurFilterClass::InitData());
 }
@@ -47,175 +42,81 @@ void BlurFilter::BlurFilterClass::CleanUp() {
 	for (UINT i = 0; i < PipelineState::Count; ++i)
 		mPipelineStates[i].Reset();
 
-	mRootSignature.Reset();
+	for (UINT i = 0; i < RootSignature::Count; ++i)
+		mRootSignatures[i].Reset();
 
 	mbCleanedUp = TRUE;
 }
 
-BOOL BlurFilter::BlurFilterClass::CompileShaders() {
-	// GaussianBlurFilter3x3
-	{
-		DxcDefine defines[] = { { L"ValueType", L"float" } };
-
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_GaussianBlurFilter3x3, L"CS", L"cs_6_5", defines, _countof(defines));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_GaussianBlurFilter3x3]));
-	}
-	// GaussianBlurFilterRGBA3x3
-	{
-		DxcDefine defines[] = { { L"ValueType", L"float4" } };
-
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_GaussianBlurFilter3x3, L"CS", L"cs_6_5", defines, _countof(defines));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_GaussianBlurFilterRGBA3x3]));
-	}
-	// GaussianBlurFilterNxN
-	{
-		// R
-		{
-			// 3x3
-			{
-				DxcDefine defines[] = { 
-					{ L"KERNEL_RADIUS", L"1" },
-					{ L"ValueType", L"float" }
-				};
-
-				const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-					HLSL_GaussianBlurFilterNxN, L"CS", L"cs_6_5", defines, _countof(defines));
-				CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-					CS, mShaderHashes[Shader::CS_GaussianBlurFilterNxN3x3]));
-			}
-			// 5x5
-			{
-				DxcDefine defines[] = {
-					{ L"KERNEL_RADIUS", L"2" },
-					{ L"ValueType", L"float" }
-				};
-
-				const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-					HLSL_GaussianBlurFilterNxN, L"CS", L"cs_6_5", defines, _countof(defines));
-				CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-					CS, mShaderHashes[Shader::CS_GaussianBlurFilterNxN5x5]));
-			}
-			// 7x7
-			{
-				DxcDefine defines[] = {
-					{ L"KERNEL_RADIUS", L"3" },
-					{ L"ValueType", L"float" }
-				};
-
-				const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-					HLSL_GaussianBlurFilterNxN, L"CS", L"cs_6_5", defines, _countof(defines));
-				CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-					CS, mShaderHashes[Shader::CS_GaussianBlurFilterNxN7x7]));
-			}
-			// 9x9
-			{
-				DxcDefine defines[] = {
-					{ L"KERNEL_RADIUS", L"4" },
-					{ L"ValueType", L"float" }
-				};
-
-				const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-					HLSL_GaussianBlurFilterNxN, L"CS", L"cs_6_5", defines, _countof(defines));
-				CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-					CS, mShaderHashes[Shader::CS_GaussianBlurFilterNxN9x9]));
-			}
-		}
-		// RGBA
-		{
-			// 3x3
-			{
-				DxcDefine defines[] = {
-					{ L"KERNEL_RADIUS", L"1" },
-					{ L"ValueType", L"float4" }
-				};
-
-				const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-					HLSL_GaussianBlurFilterNxN, L"CS", L"cs_6_5", defines, _countof(defines));
-				CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-					CS, mShaderHashes[Shader::CS_GaussianBlurFilterRGBANxN3x3]));
-			}
-			// 5x5
-			{
-				DxcDefine defines[] = {
-					{ L"KERNEL_RADIUS", L"2" },
-					{ L"ValueType", L"float4" }
-				};
-
-				const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-					HLSL_GaussianBlurFilterNxN, L"CS", L"cs_6_5", defines, _countof(defines));
-				CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-					CS, mShaderHashes[Shader::CS_GaussianBlurFilterRGBANxN5x5]));
-			}
-			// 7x7
-			{
-				DxcDefine defines[] = {
-					{ L"KERNEL_RADIUS", L"3" },
-					{ L"ValueType", L"float4" }
-				};
-
-				const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-					HLSL_GaussianBlurFilterNxN, L"CS", L"cs_6_5", defines, _countof(defines));
-				CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-					CS, mShaderHashes[Shader::CS_GaussianBlurFilterRGBANxN7x7]));
-			}
-			// 9x9
-			{
-				DxcDefine defines[] = {
-					{ L"KERNEL_RADIUS", L"4" },
-					{ L"ValueType", L"float4" }
-				};
-
-				const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-					HLSL_GaussianBlurFilterNxN, L"CS", L"cs_6_5", defines, _countof(defines));
-				CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-					CS, mShaderHashes[Shader::CS_GaussianBlurFilterRGBANxN9x9]));
-			}
-		}
-	}
-
-	return TRUE;
-}
-
 BOOL BlurFilter::BlurFilterClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
-	CD3DX12_DESCRIPTOR_RANGE texTables[2]{}; UINT index = 0;
-	texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
-	texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0, 0);
+	// Default
+	{
+		CD3DX12_DESCRIPTOR_RANGE texTables[2]{}; UINT index = 0;
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0, 0);
 
-	index = 0;
+		index = 0;
 
-	CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::Default::Count]{};
-	slotRootParameter[RootSignature::Default::RC_Consts].InitAsConstants(ShadingConvention::BlurFilter::RootConstant::Default::Count, 0);
-	slotRootParameter[RootSignature::Default::SI_InputMap].InitAsDescriptorTable(1, &texTables[index++]);
-	slotRootParameter[RootSignature::Default::UO_OutputMap].InitAsDescriptorTable(1, &texTables[index++]);
+		CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::Default::Count]{};
+		slotRootParameter[RootSignature::Default::RC_Consts].InitAsConstants(ShadingConvention::BlurFilter::RootConstant::Default::Count, 0);
+		slotRootParameter[RootSignature::Default::SI_InputMap].InitAsDescriptorTable(1, &texTables[index++]);
+		slotRootParameter[RootSignature::Default::UO_OutputMap].InitAsDescriptorTable(1, &texTables[index++]);
 
-	CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
-		_countof(slotRootParameter), slotRootParameter,
-		Util::StaticSamplerCount, samplers,
-		D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT
-	);
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
+			_countof(slotRootParameter), slotRootParameter,
+			Util::StaticSamplerCount, samplers,
+			D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT
+		);
 
-	CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateRootSignature(
-		mInitData.Device,
-		rootSigDesc,
-		IID_PPV_ARGS(&mRootSignature),
-		L"BlurFilter_GR_Default"));
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateRootSignature(
+			mInitData.Device,
+			rootSigDesc,
+			IID_PPV_ARGS(&mRootSignatures[RootSignature::GR_Default]),
+			L"BlurFilter_GR_Default"));
+	}
+	// BilateralUpsample
+	{
+		CD3DX12_DESCRIPTOR_RANGE texTables[3]{}; UINT index = 0;
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 1, 0);
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0, 0);
+
+		index = 0;
+
+		CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::BilateralUpsample::Count]{};
+		slotRootParameter[RootSignature::BilateralUpsample::RC_Consts].InitAsConstants(
+			ShadingConvention::BlurFilter::RootConstant::BilateralUpsample::Count, 0);
+		slotRootParameter[RootSignature::BilateralUpsample::SI_NormalDepthMap].InitAsDescriptorTable(1, &texTables[index++]);
+		slotRootParameter[RootSignature::BilateralUpsample::SI_InputMap].InitAsDescriptorTable(1, &texTables[index++]);
+		slotRootParameter[RootSignature::BilateralUpsample::UO_OutputMap].InitAsDescriptorTable(1, &texTables[index++]);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
+			_countof(slotRootParameter), slotRootParameter,
+			Util::StaticSamplerCount, samplers,
+			D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT
+		);
+
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateRootSignature(
+			mInitData.Device,
+			rootSigDesc,
+			IID_PPV_ARGS(&mRootSignatures[RootSignature::GR_BilateralUpsample]),
+			L"BlurFilter_GR_BilateralUpsample"));
+	}
 
 	return TRUE;
 }
 
 BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 	D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
-	psoDesc.pRootSignature = mRootSignature.Get();
+	psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_Default].Get();
 	psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
 	// GaussianBlurFilter3x3
 	{
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilter3x3]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilter3x3", 0);
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -229,7 +130,7 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 	// GaussianBlurFilterRGBA3x3
 	{
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilterRGBA3x3]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilter3x3", 1);
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -247,7 +148,7 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 			// 3x3
 			{
 				{
-					const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilterNxN3x3]);
+					const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilterNxN", 0);
 					NullCheck(mpLogFile, CS);
 					psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 				}
@@ -261,7 +162,7 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 			// 5x5
 			{
 				{
-					const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilterNxN5x5]);
+					const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilterNxN", 1);
 					NullCheck(mpLogFile, CS);
 					psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 				}
@@ -275,7 +176,7 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 			// 7x7
 			{
 				{
-					const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilterNxN7x7]);
+					const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilterNxN", 2);
 					NullCheck(mpLogFile, CS);
 					psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 				}
@@ -289,7 +190,7 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 			// 9x9
 			{
 				{
-					const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilterNxN9x9]);
+					const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilterNxN", 3);
 					NullCheck(mpLogFile, CS);
 					psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 				}
@@ -306,7 +207,7 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 			// 3x3
 			{
 				{
-					const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilterRGBANxN3x3]);
+					const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilterNxN", 4);
 					NullCheck(mpLogFile, CS);
 					psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 				}
@@ -320,7 +221,7 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 			// 5x5
 			{
 				{
-					const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilterRGBANxN5x5]);
+					const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilterNxN", 5);
 					NullCheck(mpLogFile, CS);
 					psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 				}
@@ -334,7 +235,7 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 			// 7x7
 			{
 				{
-					const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilterRGBANxN7x7]);
+					const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilterNxN", 6);
 					NullCheck(mpLogFile, CS);
 					psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 				}
@@ -348,7 +249,7 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 			// 9x9
 			{
 				{
-					const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_GaussianBlurFilterRGBANxN9x9]);
+					const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_GaussianBlurFilterNxN", 7);
 					NullCheck(mpLogFile, CS);
 					psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 				}
@@ -361,6 +262,21 @@ BOOL BlurFilter::BlurFilterClass::BuildPipelineStates() {
 			}
 		}
 	}
+	// BilateralUpsample
+	{
+		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_BilateralUpsample].Get();
+		{
+			const auto CS = mInitData.ShaderManager->GetShader(L"BlurFilter.CS_BilateralUpsample");
+			NullCheck(mpLogFile, CS);
+			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
+		}
+
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateComputePipelineState(
+			mInitData.Device,
+			psoDesc,
+			IID_PPV_ARGS(&mPipelineStates[PipelineState::CP_BilateralUpsample]),
+			L"BlurFilter_CP_BilateralUpsample"));
+	}
 	
 	return TRUE;
 }
@@ -382,7 +298,7 @@ BOOL BlurFilter::BlurFilterClass::GaussianBlur(
 	mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
 
 	{
-		CmdList->SetComputeRootSignature(mRootSignature.Get());
+		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_Default].Get());
 
 		ShadingConvention::BlurFilter::RootConstant::Default::Struct rc;
 		rc.gTexDim.x = static_cast<FLOAT>(texWidth);
@@ -398,7 +314,7 @@ BOOL BlurFilter::BlurFilterClass::GaussianBlur(
 			CmdList,
 			TRUE);
 
-		pInputMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pInputMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 		pOutputMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, pOutputMap);
@@ -414,5 +330,63 @@ BOOL BlurFilter::BlurFilterClass::GaussianBlur(
 
 	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandList(0));
 
+	return TRUE;
+}
+
+BOOL BlurFilter::BlurFilterClass::BilateralUpsample(
+		Foundation::Resource::FrameResource* const pFrameResource,
+		Foundation::Resource::GpuResource* const pNormalDepthMap,
+		D3D12_GPU_DESCRIPTOR_HANDLE si_normalDepthMap,
+		Foundation::Resource::GpuResource* const pInputMap,
+		D3D12_GPU_DESCRIPTOR_HANDLE si_inputMap,
+		Foundation::Resource::GpuResource* const pOutputMap,
+		D3D12_GPU_DESCRIPTOR_HANDLE uo_outputMap,
+		UINT texWidth, UINT texHeight,
+		FLOAT depthSigma, UINT depthNumMantissaBits) {
+	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
+		pFrameResource->CommandAllocator(0),
+		0,
+		mPipelineStates[PipelineState::CP_BilateralUpsample].Get()));
+
+	const auto CmdList = mInitData.CommandObject->CommandList(0);
+	mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
+
+	{
+		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_BilateralUpsample].Get());
+
+		ShadingConvention::BlurFilter::RootConstant::BilateralUpsample::Struct rc;
+		rc.gTexDim = { texWidth, texHeight };
+		rc.gLowResTexDim = {
+			Foundation::Util::D3D12Util::CeilDivide(texWidth, 2),
+			Foundation::Util::D3D12Util::CeilDivide(texHeight, 2) };
+		rc.gDepthSigma = depthSigma;
+		rc.gDepthNumMantissaBits = depthNumMantissaBits;
+
+		Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::BlurFilter::RootConstant::BilateralUpsample::Struct>(
+			RootSignature::BilateralUpsample::RC_Consts,
+			ShadingConvention::BlurFilter::RootConstant::BilateralUpsample::Count,
+			&rc,
+			0,
+			CmdList,
+			TRUE);
+
+		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pInputMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+		pOutputMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		Foundation::Util::D3D12Util::UavBarrier(CmdList, pOutputMap);
+
+		CmdList->SetComputeRootDescriptorTable(RootSignature::BilateralUpsample::SI_NormalDepthMap, si_normalDepthMap);
+		CmdList->SetComputeRootDescriptorTable(RootSignature::BilateralUpsample::SI_InputMap, si_inputMap);
+		CmdList->SetComputeRootDescriptorTable(RootSignature::BilateralUpsample::UO_OutputMap, uo_outputMap);
+
+		CmdList->Dispatch(
+			Foundation::Util::D3D12Util::CeilDivide(texWidth, ShadingConvention::BlurFilter::ThreadGroup::Default::Width),
+			Foundation::Util::D3D12Util::CeilDivide(texHeight, ShadingConvention::BlurFilter::ThreadGroup::Default::Height),
+			ShadingConvention::BlurFilter::ThreadGroup::Default::Depth);
+	}
+
+	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandList(0));
+
 	return TRUE;
 }
\ No newline at end of file
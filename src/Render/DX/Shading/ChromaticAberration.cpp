@@ -12,10 +12,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_ChromaticAberrationClass = L"ChromaticAberration.hlsl";
-}
-
 ChromaticAberration::InitDataPtr ChromaticAberration::MakeInitData() {
 	return std::unique_ptr<ChromaticAberrationClass::InitData>(
 		new ChromaticAberrationClass::InitData());
@@ -52,23 +48,6 @@ void ChromaticAberration::ChromaticAberrationClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL ChromaticAberration::ChromaticAberrationClass::CompileShaders() {
-	const auto VS = Util::ShaderManager::D3D12ShaderInfo(
-		HLSL_ChromaticAberrationClass, L"VS", L"vs_6_5");
-	const auto MS = Util::ShaderManager::D3D12ShaderInfo(
-		HLSL_ChromaticAberrationClass, L"MS", L"ms_6_5");
-	const auto PS = Util::ShaderManager::D3D12ShaderInfo(
-		HLSL_ChromaticAberrationClass, L"PS", L"ps_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-		VS, mShaderHashes[Shader::VS_ChromaticAberration]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-		MS, mShaderHashes[Shader::MS_ChromaticAberration]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-		PS, mShaderHashes[Shader::PS_ChromaticAberration]));
-
-	return TRUE;
-}
-
 BOOL ChromaticAberration::ChromaticAberrationClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -104,10 +83,10 @@ BOOL ChromaticAberration::ChromaticAberrationClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
 			const auto MS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::MS_ChromaticAberration]);
+				L"ChromaticAberration.MS_ChromaticAberration");
 			NullCheck(mpLogFile, MS);
 			const auto PS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::PS_ChromaticAberration]);
+				L"ChromaticAberration.PS_ChromaticAberration");
 			NullCheck(mpLogFile, PS);
 			psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -125,10 +104,10 @@ BOOL ChromaticAberration::ChromaticAberrationClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
 			const auto VS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::VS_ChromaticAberration]);
+				L"ChromaticAberration.VS_ChromaticAberration");
 			NullCheck(mpLogFile, VS);
 			const auto PS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::PS_ChromaticAberration]);
+				L"ChromaticAberration.PS_ChromaticAberration");
 			NullCheck(mpLogFile, PS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -189,6 +168,7 @@ BOOL ChromaticAberration::ChromaticAberrationClass::ApplyChromaticAberration(
 		rc.gFeather = feather;
 		rc.gMaxShiftPx = maxShiftPx;
 		rc.gExponent = exponent;
+		rc.gUVScale = mUVScale;
 
 		Foundation::Util::D3D12Util::SetRoot32BitConstants<
 			ShadingConvention::ChromaticAberration::RootConstant::Default::Struct>(
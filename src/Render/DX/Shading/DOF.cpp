@@ -5,6 +5,7 @@
 #include "Render/DX/Foundation/Core/Device.hpp"
 #include "Render/DX/Foundation/Core/CommandObject.hpp"
 #include "Render/DX/Foundation/Core/DescriptorHeap.hpp"
+#include "Render/DX/Foundation/Core/RenderGraph.hpp"
 #include "Render/DX/Foundation/Resource/FrameResource.hpp"
 #include "Render/DX/Foundation/Util/D3D12Util.hpp"
 #include "Render/DX/Shading/Util/ShaderManager.hpp"
@@ -12,13 +13,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_CalcFocalDistance = L"CalcFocalDistance.hlsl";
-	const WCHAR* const HLSL_CircleOfConfusion = L"CircleOfConfusion.hlsl";
-	const WCHAR* const HLSL_Bokeh = L"Bokeh.hlsl";
-	const WCHAR* const HLSL_BokehBlurNxN = L"BokehBlurNxN.hlsl";
-}
-
 DOF::InitDataPtr DOF::MakeInitData() {
 	return std::unique_ptr<DOFClass::InitData>(new DOFClass::InitData());
 }
@@ -30,10 +24,7 @@ DOF::DOFClass::DOFClass() {
 
 DOF::DOFClass::~DOFClass() { CleanUp(); }
 
-UINT DOF::DOFClass::CbvSrvUavDescCount() const { return 0 
-	+ 2 // CircleOfConfusionMap Srv Uav
-	; 
-}
+UINT DOF::DOFClass::CbvSrvUavDescCount() const { return 0; }
 
 UINT DOF::DOFClass::RtvDescCount() const { return 0; }
 
@@ -45,7 +36,6 @@ BOOL DOF::DOFClass::Initialize(Common::Debug::LogFile* const pLogFile, void* con
 	const auto initData = reinterpret_cast<InitData*>(pData);
 	mInitData = *initData;
 
-	CheckReturn(mpLogFile, BuildResources());
 	CheckReturn(mpLogFile, BuildFixedResources());
 
 	return TRUE;
@@ -66,55 +56,6 @@ void DOF::DOFClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL DOF::DOFClass::CompileShaders() {
-	// CaclFocalDistance
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_CalcFocalDistance, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			CS, mShaderHashes[Shader::CS_CaclFocalDistance]));
-	}
-	// CircleOfConfusion
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_CircleOfConfusion, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			CS, mShaderHashes[Shader::CS_CircleOfConfusion]));
-	}
-	// Bokeh
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_Bokeh, L"VS", L"vs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			VS, mShaderHashes[Shader::VS_Bokeh]));
-		const auto MS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_Bokeh, L"MS", L"ms_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			MS, mShaderHashes[Shader::MS_Bokeh]));
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_Bokeh, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			PS, mShaderHashes[Shader::PS_Bokeh]));
-	}
-	// BokehBlur3x3
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_BokehBlurNxN, L"VS", L"vs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			VS, mShaderHashes[Shader::VS_BokehBlurNxN]));
-		const auto MS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_BokehBlurNxN, L"MS", L"ms_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			MS, mShaderHashes[Shader::MS_BokehBlurNxN]));
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_BokehBlurNxN, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			PS, mShaderHashes[Shader::PS_BokehBlurNxN]));
-	}
-
-	return TRUE;
-}
-
 BOOL DOF::DOFClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -240,7 +181,7 @@ BOOL DOF::DOFClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_CalcFocalDistance].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_CaclFocalDistance]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"DOF.CS_CaclFocalDistance");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -257,7 +198,7 @@ BOOL DOF::DOFClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_CircleOfConfusion].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_CircleOfConfusion]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"DOF.CS_CircleOfConfusion");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -275,10 +216,10 @@ BOOL DOF::DOFClass::BuildPipelineStates() {
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_Bokeh].Get();
 			{
 				const auto MS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::MS_Bokeh]);
+					L"DOF.MS_Bokeh");
 				NullCheck(mpLogFile, MS);
 				const auto PS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::PS_Bokeh]);
+					L"DOF.PS_Bokeh");
 				NullCheck(mpLogFile, PS);
 				psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -297,10 +238,10 @@ BOOL DOF::DOFClass::BuildPipelineStates() {
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_Bokeh].Get();
 			{
 				const auto VS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::VS_Bokeh]);
+					L"DOF.VS_Bokeh");
 				NullCheck(mpLogFile, VS);
 				const auto PS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::PS_Bokeh]);
+					L"DOF.PS_Bokeh");
 				NullCheck(mpLogFile, PS);
 				psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -322,10 +263,10 @@ BOOL DOF::DOFClass::BuildPipelineStates() {
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_BokehBlurNxN].Get();
 			{
 				const auto MS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::MS_BokehBlurNxN]);
+					L"DOF.MS_BokehBlurNxN");
 				NullCheck(mpLogFile, MS);
 				const auto PS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::PS_BokehBlurNxN]);
+					L"DOF.PS_BokehBlurNxN");
 				NullCheck(mpLogFile, PS);
 				psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -344,10 +285,10 @@ BOOL DOF::DOFClass::BuildPipelineStates() {
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_BokehBlurNxN].Get();
 			{
 				const auto VS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::VS_BokehBlurNxN]);
+					L"DOF.VS_BokehBlurNxN");
 				NullCheck(mpLogFile, VS);
 				const auto PS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::PS_BokehBlurNxN]);
+					L"DOF.PS_BokehBlurNxN");
 				NullCheck(mpLogFile, PS);
 				psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -365,24 +306,12 @@ BOOL DOF::DOFClass::BuildPipelineStates() {
 	return TRUE;
 }
 
-BOOL DOF::DOFClass::BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) {
-	mhCircleOfConfusionMapCpuUav = pDescHeap->CbvSrvUavCpuOffset(1);
-	mhCircleOfConfusionMapGpuUav = pDescHeap->CbvSrvUavGpuOffset(1);
-	mhCircleOfConfusionMapCpuSrv = pDescHeap->CbvSrvUavCpuOffset(1);
-	mhCircleOfConfusionMapGpuSrv = pDescHeap->CbvSrvUavGpuOffset(1);
-
-	CheckReturn(mpLogFile, BuildDescriptors());
-
-	return TRUE;
-}
+BOOL DOF::DOFClass::BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) { return TRUE; }
 
 BOOL DOF::DOFClass::OnResize(UINT width, UINT height) {
 	mInitData.ClientWidth = width;
 	mInitData.ClientHeight = height;
 
-	CheckReturn(mpLogFile, BuildResources());
-	CheckReturn(mpLogFile, BuildDescriptors());
-
 	return TRUE;
 }
 
@@ -436,6 +365,8 @@ BOOL DOF::DOFClass::CircleOfConfusion(
 		Foundation::Resource::GpuResource* const pDepthMap,
 		D3D12_GPU_DESCRIPTOR_HANDLE si_depthMap,
 		FLOAT focusRange) {
+	CheckReturn(mpLogFile, BuildTransientDescriptors());
+
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
 		0,
@@ -481,9 +412,9 @@ BOOL DOF::DOFClass::CircleOfConfusion(
 
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth, ShadingConvention::DOF::ThreadGroup::Default::Width),
+				mRenderWidth, ShadingConvention::DOF::ThreadGroup::Default::Width),
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::DOF::ThreadGroup::Default::Height),
+				mRenderHeight, ShadingConvention::DOF::ThreadGroup::Default::Height),
 			ShadingConvention::DOF::ThreadGroup::Default::Depth);
 	}
 
@@ -535,6 +466,7 @@ BOOL DOF::DOFClass::Bokeh(
 		rc.gBokehRadius = bokehRadius;
 		rc.gThreshold = threshold;
 		rc.gHighlightPower = highlightPower;
+		rc.gUVScale = mUVScale;
 
 		Foundation::Util::D3D12Util::SetRoot32BitConstants<
 			ShadingConvention::DOF::RootConstant::Bokeh::Struct>(
@@ -606,6 +538,7 @@ BOOL DOF::DOFClass::BokehBlur(
 			1.f / static_cast<FLOAT>(mInitData.ClientWidth), 
 			1.f / static_cast<FLOAT>(mInitData.ClientHeight) 
 		};
+		rc.gUVScale = mUVScale;
 
 		Foundation::Util::D3D12Util::SetRoot32BitConstants<
 			ShadingConvention::DOF::RootConstant::BokehBlur3x3::Struct>(
@@ -639,7 +572,7 @@ BOOL DOF::DOFClass::BokehBlur(
 	return TRUE;
 }
 
-BOOL DOF::DOFClass::BuildResources() {
+void DOF::DOFClass::DeclareTransients(Foundation::Core::RenderPassBuilder& builder) {
 	D3D12_RESOURCE_DESC texDesc;
 	ZeroMemory(&texDesc, sizeof(D3D12_RESOURCE_DESC));
 	texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
@@ -657,20 +590,19 @@ BOOL DOF::DOFClass::BuildResources() {
 	{
 		texDesc.Format = ShadingConvention::DOF::CircleOfConfusionMapFormat;
 
-		CheckReturn(mpLogFile, mCircleOfConfusionMap->Initialize(
-			mInitData.Device,
-			&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-			D3D12_HEAP_FLAG_NONE,
-			&texDesc,
-			D3D12_RESOURCE_STATE_COMMON,
-			nullptr,
-			L"DOF_CircleOfConfusionMap"));
+		builder.Transient(
+			mCircleOfConfusionMap.get(),
+			texDesc,
+			D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			L"DOF_CircleOfConfusionMap",
+			nullptr);
 	}
-
-	return TRUE;
 }
 
-BOOL DOF::DOFClass::BuildDescriptors() {
+BOOL DOF::DOFClass::BuildTransientDescriptors() {
+	CheckReturn(mpLogFile, mInitData.DescriptorHeap->AllocateTransient(1, mhCircleOfConfusionMapCpuSrv, mhCircleOfConfusionMapGpuSrv));
+	CheckReturn(mpLogFile, mInitData.DescriptorHeap->AllocateTransient(1, mhCircleOfConfusionMapCpuUav, mhCircleOfConfusionMapGpuUav));
+
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
@@ -3,36 +3,49 @@
 #include "Common/Debug/Logger.hpp"
 #include "Common/Foundation/Mesh/Vertex.h"
 #include "Common/Util/StringUtil.hpp"
+#include "Common/Util/EnvironmentBaker.hpp"
 #include "Render/DX/Foundation/RenderItem.hpp"
 #include "Render/DX/Foundation/Core/Device.hpp"
 #include "Render/DX/Foundation/Core/CommandObject.hpp"
 #include "Render/DX/Foundation/Core/DescriptorHeap.hpp"
+#include "Render/DX/Foundation/Core/UploadQueue.hpp"
 #include "Render/DX/Foundation/Resource/FrameResource.hpp"
 #include "Render/DX/Foundation/Resource/GpuResource.hpp"
 #include "Render/DX/Foundation/Resource/MeshGeometry.hpp"
 #include "Render/DX/Foundation/Resource/Texture.hpp"
 #include "Render/DX/Foundation/Util/D3D12Util.hpp"
+#include "Render/DX/Foundation/Util/TextureCooker.hpp"
 #include "Render/DX/Shading/Util/ShaderManager.hpp"
 #include "Render/DX/Shading/Util/SamplerUtil.hpp"
 #include "Render/DX/Shading/Util/MipmapGenerator.hpp"
 #include "Render/DX/Shading/Util/EquirectangularConverter.hpp"
 
+#include <DirectXPackedVector.h>
+
 using namespace Render::DX::Shading;
 using namespace DirectX;
 
 namespace {
-	const WCHAR* const HLSL_DrawSkySphere = L"DrawSkySphere.hlsl";
-	const WCHAR* const HLSL_ConvoluteDiffuseIrradiance = L"ConvoluteDiffuseIrradiance.hlsl";
-	const WCHAR* const HLSL_ConvoluteSpecularIrradiance = L"ConvoluteSpecularIrradiance.hlsl";
-	const WCHAR* const HLSL_IntegrateBrdf = L"IntegrateBrdf.hlsl";
-
 	const WCHAR* const EnvironmentCubeMapFileNameSuffix = L"_env_cube_map";
-	const WCHAR* const DiffuseIrradianceCubeMapFileNameSuffix = L"_diff_irrad_cube_map";
+	const WCHAR* const IrradianceSHFileNameSuffix = L"_irrad_sh";
 	const WCHAR* const PrefilteredEnvironmentCubeMapFileNameSuffix = L"_prefiltered_env_cube_map";
 	const WCHAR* const BrdfLutMapFileName = L"brdf_lut_map";
 
 	const UINT CubeMapSize = 1024;
-	const UINT BrdfLutMapSize = 1024;
+	const UINT BrdfLutMapSize = 256;
+	const UINT BrdfLutSampleCount = 8192;
+
+	// The projection reads the first mip of the environment cube at or
+	// below this size; irradiance keeps nothing finer anyway.
+	const UINT IrradianceSHFaceSize = 128;
+
+	const UINT32 IrradianceSHMagic = 0x48534944; // "DISH"
+	const UINT32 IrradianceSHVersion = 1;
+
+	struct IrradianceSHHeader {
+		UINT32 Magic;
+		UINT32 Version;
+	};
 
 	BOOL FileExists(const std::wstring& filePath) {		
 		const auto& filePathStr = Common::Util::StringUtil::WStringToString(filePath);
@@ -49,7 +62,7 @@ namespace {
 	BOOL GetTextureResource(
 			Common::Debug::LogFile* const pLogFile, 
 			Render::DX::Foundation::Core::Device* const pDevice,
-			Render::DX::Foundation::Core::CommandObject* const pCmdObject,
+			Render::DX::Foundation::Core::UploadQueue* const pUploadQueue,
 			Render::DX::Foundation::Resource::GpuResource* const pResource,
 			LPCWSTR filePath,
 			LPCWSTR texName) {
@@ -57,7 +70,7 @@ namespace {
 		
 		CheckReturn(pLogFile, Render::DX::Foundation::Util::D3D12Util::CreateTexture(
 			pDevice,
-			pCmdObject,
+			pUploadQueue,
 			tex.get(),
 			filePath));
 
@@ -77,7 +90,6 @@ UINT EnvironmentMap::EnvironmentMapClass::CbvSrvUavDescCount() const {
 		+ 1 // TemporaryEquirectangularMapSrv
 		+ 1 // EquirectangularMapSrv
 		+ 1 // EnvironmentMapSrv
-		+ 1 // DiffuseIrradianceCubeMapSrv
 		+ 1 // SpecularIrradianceCubeMapSrv
 		+ 1 // BrdfLutMapSrv
 		; 
@@ -87,9 +99,7 @@ UINT EnvironmentMap::EnvironmentMapClass::RtvDescCount() const {
 	return 0
 		+ ShadingConvention::MipmapGenerator::MaxMipLevel // EquirectangularMapRtvs
 		+ ShadingConvention::MipmapGenerator::MaxMipLevel // EnvironmentMapRtvs
-		+ 1 // DiffuseIrradianceCubeMapRtv
 		+ ShadingConvention::MipmapGenerator::MaxMipLevel // SpecularIrradianceCubeMapRtvs
-		+ 1 // EnvironmentMapRtv
 		; 
 }
 
@@ -99,9 +109,9 @@ EnvironmentMap::EnvironmentMapClass::EnvironmentMapClass() {
 	mTemporaryEquirectangularMap = std::make_unique<Foundation::Resource::GpuResource>();
 	mEquirectangularMap = std::make_unique<Foundation::Resource::GpuResource>();
 	mEnvironmentCubeMap = std::make_unique<Foundation::Resource::GpuResource>();
-	mDiffuseIrradianceCubeMap = std::make_unique<Foundation::Resource::GpuResource>();
 	mPrefilteredEnvironmentCubeMap = std::make_unique<Foundation::Resource::GpuResource>();
 	mBrdfLutMap = std::make_unique<Foundation::Resource::GpuResource>();
+	mEnvironmentBaker = std::make_unique<Common::Util::EnvironmentBaker>();
 }
 
 EnvironmentMap::EnvironmentMapClass::~EnvironmentMapClass() { CleanUp(); }
@@ -115,15 +125,17 @@ BOOL EnvironmentMap::EnvironmentMapClass::Initialize(Common::Debug::LogFile* con
 	mViewport = { 0.f, 0.f, static_cast<FLOAT>(CubeMapSize), static_cast<FLOAT>(CubeMapSize), 0.f, 1.f };
 	mScissorRect = { 0, 0, static_cast<INT>(CubeMapSize), static_cast<INT>(CubeMapSize) };
 
+	mEnvironmentBaker->Initialize(mInitData.Avx2Supported, mInitData.ThreadCount);
+
 	return TRUE;
 }
 
 void EnvironmentMap::EnvironmentMapClass::CleanUp() {
 	if (mbCleanedUp) return;
 
+	if (mEnvironmentBaker) mEnvironmentBaker.reset();
 	if (mBrdfLutMap) mBrdfLutMap.reset();
 	if (mPrefilteredEnvironmentCubeMap) mPrefilteredEnvironmentCubeMap.reset();
-	if (mDiffuseIrradianceCubeMap) mDiffuseIrradianceCubeMap.reset();
 	if (mEnvironmentCubeMap) mEnvironmentCubeMap.reset();
 	if (mEquirectangularMap) mEquirectangularMap.reset();
 	if (mTemporaryEquirectangularMap) mTemporaryEquirectangularMap.reset();
@@ -137,47 +149,6 @@ void EnvironmentMap::EnvironmentMapClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL EnvironmentMap::EnvironmentMapClass::CompileShaders() {
-	// DrawSkySphere
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_DrawSkySphere, L"VS", L"vs_6_5");
-		const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_DrawSkySphere, L"MS", L"ms_6_5");
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_DrawSkySphere, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_DrawSkySphere]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_DrawSkySphere]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_DrawSkySphere]));
-	}
-	// ConvoluteDiffuseIrradiance
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvoluteDiffuseIrradiance, L"VS", L"vs_6_5");
-		const auto GS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvoluteDiffuseIrradiance, L"GS", L"gs_6_5");
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvoluteDiffuseIrradiance, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_ConvoluteDiffuseIrradiance]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(GS, mShaderHashes[Shader::GS_ConvoluteDiffuseIrradiance]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ConvoluteDiffuseIrradiance]));
-	}
-	// ConvoluteSpecularIrradiance
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvoluteSpecularIrradiance, L"VS", L"vs_6_5");
-		const auto GS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvoluteSpecularIrradiance, L"GS", L"gs_6_5");
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvoluteSpecularIrradiance, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_ConvoluteSpecularIrradiance]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(GS, mShaderHashes[Shader::GS_ConvoluteSpecularIrradiance]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ConvoluteSpecularIrradiance]));
-	}
-	// IntegrateBrdf
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_IntegrateBrdf, L"VS", L"vs_6_5");
-		const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_IntegrateBrdf, L"MS", L"ms_6_5");
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_IntegrateBrdf, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_IntegrateBrdf]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_IntegrateBrdf]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_IntegrateBrdf]));
-	}
-
-	return TRUE;
-}
-
 BOOL EnvironmentMap::EnvironmentMapClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -207,28 +178,6 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildRootSignatures() {
 			IID_PPV_ARGS(&mRootSignatures[RootSignature::GR_DrawSkySphere]),
 			L"EnvironmentMap_GR_DrawSkySphere"));
 	}
-	// ConvoluteDiffuseIrradiance
-	{
-		CD3DX12_DESCRIPTOR_RANGE texTables[1]{}; UINT index = 0;
-		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
-
-		index = 0;
-
-		CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::ConvoluteDiffuseIrradiance::Count]{};
-		slotRootParameter[RootSignature::ConvoluteDiffuseIrradiance::CB_ProjectToCube].InitAsConstantBufferView(0);
-		slotRootParameter[RootSignature::ConvoluteDiffuseIrradiance::SI_CubeMap].InitAsDescriptorTable(1, &texTables[index++]);
-
-		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
-			_countof(slotRootParameter), slotRootParameter,
-			Util::StaticSamplerCount, samplers,
-			D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
-
-		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateRootSignature(
-			mInitData.Device,
-			rootSigDesc,
-			IID_PPV_ARGS(&mRootSignatures[RootSignature::GR_ConvoluteDiffuseIrradiance]),
-			L"EnvironmentMap_GR_ConvoluteDiffuseIrradiance"));
-	}
 	// ConvoluteSpecularIrradiance
 	{
 		CD3DX12_DESCRIPTOR_RANGE texTables[1]{}; UINT index = 0;
@@ -252,22 +201,6 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildRootSignatures() {
 			IID_PPV_ARGS(&mRootSignatures[RootSignature::GR_ConvoluteSpecularIrradiance]),
 			L"EnvironmentMap_GR_ConvoluteSpecularIrradiance"));
 	}
-	// IntegrateBrdf
-	{
-		CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::IntegrateBrdf::Count]{};
-		slotRootParameter[RootSignature::IntegrateBrdf::CB_Pass].InitAsConstantBufferView(0);
-
-		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
-			_countof(slotRootParameter), slotRootParameter,
-			Util::StaticSamplerCount, samplers,
-			D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
-
-		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateRootSignature(
-			mInitData.Device,
-			rootSigDesc,
-			IID_PPV_ARGS(&mRootSignatures[RootSignature::GR_IntegrateBrdf]),
-			L"EnvironmentMap_GR_IntegrateBrdf"));
-	}
 
 	return TRUE;
 }
@@ -280,9 +213,9 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildPipelineStates() {
 
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_DrawSkySphere].Get();
 			{
-				const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_DrawSkySphere]);
+				const auto MS = mInitData.ShaderManager->GetShader(L"EnvironmentMap.MS_DrawSkySphere");
 				NullCheck(mpLogFile, MS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_DrawSkySphere]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"EnvironmentMap.PS_DrawSkySphere");
 				NullCheck(mpLogFile, PS);
 				psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -305,9 +238,9 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildPipelineStates() {
 
 			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_DrawSkySphere].Get();
 			{
-				const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_DrawSkySphere]);
+				const auto VS = mInitData.ShaderManager->GetShader(L"EnvironmentMap.VS_DrawSkySphere");
 				NullCheck(mpLogFile, VS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_DrawSkySphere]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"EnvironmentMap.PS_DrawSkySphere");
 				NullCheck(mpLogFile, PS);
 				psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -325,44 +258,17 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildPipelineStates() {
 				L"EnvironmentMap_GP_DrawSkySphere"));
 		}
 	}
-	// ConvoluteDiffuseIrradiance
-	{
-		const auto inputLayout = Foundation::Util::D3D12Util::InputLayoutDesc();
-		auto psoDesc = Foundation::Util::D3D12Util::DefaultPsoDesc(inputLayout, ShadingConvention::DepthStencilBuffer::DepthStencilBufferFormat);
-		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ConvoluteDiffuseIrradiance].Get();
-		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_ConvoluteDiffuseIrradiance]);
-			NullCheck(mpLogFile, VS);
-			const auto GS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::GS_ConvoluteDiffuseIrradiance]);
-			NullCheck(mpLogFile, GS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ConvoluteDiffuseIrradiance]);
-			NullCheck(mpLogFile, PS);
-			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
-			psoDesc.GS = { reinterpret_cast<BYTE*>(GS->GetBufferPointer()), GS->GetBufferSize() };
-			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
-		}
-		psoDesc.RasterizerState.CullMode = D3D12_CULL_MODE_FRONT;
-		psoDesc.NumRenderTargets = 1;
-		psoDesc.RTVFormats[0] = HDR_FORMAT;
-		psoDesc.DepthStencilState.DepthEnable = FALSE;
-
-		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateGraphicsPipelineState(
-			mInitData.Device,
-			psoDesc,
-			IID_PPV_ARGS(&mPipelineStates[PipelineState::GP_ConvoluteDiffuseIrradiance]),
-			L"EnvironmentMap_GP_ConvoluteDiffuseIrradiance"));
-	}
 	// ConvoluteSpecularIrradiance
 	{
 		const auto inputLayout = Foundation::Util::D3D12Util::InputLayoutDesc();
 		auto psoDesc = Foundation::Util::D3D12Util::DefaultPsoDesc(inputLayout, ShadingConvention::DepthStencilBuffer::DepthStencilBufferFormat);
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ConvoluteSpecularIrradiance].Get();
 		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_ConvoluteSpecularIrradiance]);
+			const auto VS = mInitData.ShaderManager->GetShader(L"EnvironmentMap.VS_ConvoluteSpecularIrradiance");
 			NullCheck(mpLogFile, VS);
-			const auto GS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::GS_ConvoluteSpecularIrradiance]);
+			const auto GS = mInitData.ShaderManager->GetShader(L"EnvironmentMap.GS_ConvoluteSpecularIrradiance");
 			NullCheck(mpLogFile, GS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ConvoluteSpecularIrradiance]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"EnvironmentMap.PS_ConvoluteSpecularIrradiance");
 			NullCheck(mpLogFile, PS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			psoDesc.GS = { reinterpret_cast<BYTE*>(GS->GetBufferPointer()), GS->GetBufferSize() };
@@ -379,61 +285,6 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildPipelineStates() {
 			IID_PPV_ARGS(&mPipelineStates[PipelineState::GP_ConvoluteSpecularIrradiance]),
 			L"EnvironmentMap_GP_ConvoluteSpecularIrradiance"));
 	}
-	// IntegrateBrdf
-	{
-		if (mInitData.MeshShaderSupported) {
-			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenMeshPsoDesc();
-
-			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_IntegrateBrdf].Get();
-			{
-				const auto MS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::MS_IntegrateBrdf]);
-				NullCheck(mpLogFile, MS);
-				const auto PS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::PS_IntegrateBrdf]);
-				NullCheck(mpLogFile, PS);
-				psoDesc.MS = { 
-					reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
-				psoDesc.PS = { 
-					reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
-			}
-			psoDesc.NumRenderTargets = 1;
-			psoDesc.RTVFormats[0] = ShadingConvention::EnvironmentMap::BrdfLutMapFormat;
-			psoDesc.DepthStencilState.DepthEnable = FALSE;
-
-			CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreatePipelineState(
-				mInitData.Device,
-				psoDesc,
-				IID_PPV_ARGS(&mPipelineStates[PipelineState::MP_IntegrateBrdf]),
-				L"EnvironmentMap_MP_IntegrateBrdf"));
-		}
-		else {
-			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
-
-			psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_IntegrateBrdf].Get();
-			{
-				const auto VS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::VS_IntegrateBrdf]);
-				NullCheck(mpLogFile, VS);
-				const auto PS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::PS_IntegrateBrdf]);
-				NullCheck(mpLogFile, PS);
-				psoDesc.VS = { 
-					reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
-				psoDesc.PS = { 
-					reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
-			}
-			psoDesc.NumRenderTargets = 1;
-			psoDesc.RTVFormats[0] = ShadingConvention::EnvironmentMap::BrdfLutMapFormat;
-			psoDesc.DepthStencilState.DepthEnable = FALSE;
-
-			CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateGraphicsPipelineState(
-				mInitData.Device,
-				psoDesc,
-				IID_PPV_ARGS(&mPipelineStates[PipelineState::GP_IntegrateBrdf]),
-				L"EnvironmentMap_GP_IntegrateBrdf"));
-		}				
-	}
 
 	return TRUE;
 }
@@ -458,12 +309,6 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildDescriptors(Foundation::Core::Des
 		for (UINT i = 0; i < ShadingConvention::MipmapGenerator::MaxMipLevel; ++i)
 			mhEnvironmentCubeMapCpuRtvs[i] = pDescHeap->RtvCpuOffset(1);
 	}
-	// DiffuseIrradianceCubeMap
-	{
-		mhDiffuseIrradianceCubeMapCpuSrv = pDescHeap->CbvSrvUavCpuOffset(1);
-		mhDiffuseIrradianceCubeMapGpuSrv = pDescHeap->CbvSrvUavGpuOffset(1);
-		mhDiffuseIrradianceCubeMapCpuRtv = pDescHeap->RtvCpuOffset(1);
-	}
 	// PrefilteredEnvironmentCubeMap
 	{
 		mhPrefilteredEnvironmentCubeMapCpuSrv = pDescHeap->CbvSrvUavCpuOffset(1);
@@ -475,7 +320,6 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildDescriptors(Foundation::Core::Des
 	{
 		mhBrdfLutMapCpuSrv = pDescHeap->CbvSrvUavCpuOffset(1);
 		mhBrdfLutMapGpuSrv = pDescHeap->CbvSrvUavGpuOffset(1);
-		mhBrdfLutMapCpuRtv = pDescHeap->RtvCpuOffset(1);
 	}
 
 	return TRUE;
@@ -590,7 +434,7 @@ BOOL EnvironmentMap::EnvironmentMapClass::Load(LPCWSTR fileName, LPCWSTR baseDir
 			CheckReturn(mpLogFile, GetTextureResource(
 				mpLogFile,
 				mInitData.Device,
-				mInitData.CommandObject,
+				mInitData.UploadQueue,
 				mEnvironmentCubeMap.get(),
 				filePath.str().c_str(),
 				L"EnvironmentMap_EnvironmentCubeMap"));
@@ -603,28 +447,20 @@ BOOL EnvironmentMap::EnvironmentMapClass::Load(LPCWSTR fileName, LPCWSTR baseDir
 			WLogln(mpLogFile, L"Environment cube-map not found. Generating new one...");
 		}
 	}
-	// Load diffuse irradiance cube map if one exists
+	// Load irradiance SH coefficients if they exist
 	{
 		std::wstringstream filePath;
-		filePath << baseDir << fileName << DiffuseIrradianceCubeMapFileNameSuffix << L".dds";
+		filePath << baseDir << fileName << IrradianceSHFileNameSuffix << L".bin";
 
-		if (FileExists(filePath.str())) {
-			WLogln(mpLogFile, L"Diffuse irradiance cube-map detected. Loading it...");
+		BOOL bLoaded = FALSE;
+		CheckReturn(mpLogFile, LoadIrradianceSH(filePath.str().c_str(), bLoaded));
 
-			CheckReturn(mpLogFile, GetTextureResource(
-				mpLogFile,
-				mInitData.Device,
-				mInitData.CommandObject,
-				mDiffuseIrradianceCubeMap.get(),
-				filePath.str().c_str(),
-				L"EnvironmentMap_DiffuseIrradianceCubeMap"));
-			CheckReturn(mpLogFile, BuildDiffuseIrradianceCubeMapDescriptors(FALSE));
-
-			WLogln(mpLogFile, L"Loading diffuse irradiance cube-map completed");
+		if (bLoaded) {
+			WLogln(mpLogFile, L"Irradiance SH coefficients loaded");
 		}
 		else {
-			mTasks = static_cast<TaskType>(mTasks | TaskType::E_NeedToGenDiffuseIrradianceCubeMap);
-			WLogln(mpLogFile, L"Diffuse irradiance cube-map not found. Generating new one...");
+			mTasks = static_cast<TaskType>(mTasks | TaskType::E_NeedToGenIrradianceSH);
+			WLogln(mpLogFile, L"Irradiance SH coefficients not found. Baking new ones...");
 		}
 	}
 	// Load prefiltered environment cube map if one exists
@@ -638,7 +474,7 @@ BOOL EnvironmentMap::EnvironmentMapClass::Load(LPCWSTR fileName, LPCWSTR baseDir
 			CheckReturn(mpLogFile, GetTextureResource(
 				mpLogFile,
 				mInitData.Device,
-				mInitData.CommandObject,
+				mInitData.UploadQueue,
 				mPrefilteredEnvironmentCubeMap.get(),
 				filePath.str().c_str(),
 				L"EnvironmentMap_PrefilteredEnvironmentCubeMap"));
@@ -662,20 +498,22 @@ BOOL EnvironmentMap::EnvironmentMapClass::Load(LPCWSTR fileName, LPCWSTR baseDir
 			CheckReturn(mpLogFile, GetTextureResource(
 				mpLogFile,
 				mInitData.Device,
-				mInitData.CommandObject,
+				mInitData.UploadQueue,
 				mBrdfLutMap.get(),
 				filePath.str().c_str(),
 				L"EnvironmentMap_BrdfLutMap"));
-			CheckReturn(mpLogFile, BuildBrdfLutMapDescriptors(FALSE));
+			CheckReturn(mpLogFile, BuildBrdfLutMapDescriptors());
 
 			WLogln(mpLogFile, L"Loading BRDF-LUT map completed");
 		}
 		else {
 			mTasks = static_cast<TaskType>(mTasks | TaskType::E_NeedToGenBrdfLutMap);
-			WLogln(mpLogFile, L"BRDF-LUT map not found. Generating new one...");
+			WLogln(mpLogFile, L"BRDF-LUT map not found. Baking new one...");
 		}
 	}
 
+	CheckReturn(mpLogFile, WaitForUploads());
+
 	return TRUE;
 }
 
@@ -692,11 +530,12 @@ BOOL EnvironmentMap::EnvironmentMapClass::Generate(
 			CheckReturn(mpLogFile, GetTextureResource(
 				mpLogFile,
 				mInitData.Device,
-				mInitData.CommandObject,
+				mInitData.UploadQueue,
 				mTemporaryEquirectangularMap.get(),
 				filePath.str().c_str(),
 				L"EnvironmentMap_TemporaryEquirectangularMap"));
 		}
+		CheckReturn(mpLogFile, WaitForUploads());
 
 		CheckReturn(mpLogFile, CreateEquirectangularMap());
 		CheckReturn(mpLogFile, BuildEquirectangularMapDescriptors());
@@ -711,15 +550,11 @@ BOOL EnvironmentMap::EnvironmentMapClass::Generate(
 		mTasks = static_cast<TaskType>(mTasks | TaskType::E_NeedToSaveEnvCubeMap);
 		WLogln(mpLogFile, L"Generating environment cube-map completed");
 	}
-	if (mTasks & TaskType::E_NeedToGenDiffuseIrradianceCubeMap) {
-		CheckReturn(mpLogFile, CreateDiffuseIrradianceCubeMap());
-		CheckReturn(mpLogFile, BuildDiffuseIrradianceCubeMapDescriptors(TRUE));
-
-		CheckReturn(mpLogFile, DrawDiffuseIrradianceCubeMap(
-			pFrameResource->ProjectToCubeCB.CBAddress()));
+	if (mTasks & TaskType::E_NeedToGenIrradianceSH) {
+		CheckReturn(mpLogFile, BakeIrradianceSH());
 
-		mTasks = static_cast<TaskType>(mTasks | TaskType::E_NeedToSaveDiffuseIrradianceCubeMap);
-		WLogln(mpLogFile, L"Generating diffuse irradiance cube-map completed");
+		mTasks = static_cast<TaskType>(mTasks | TaskType::E_NeedToSaveIrradianceSH);
+		WLogln(mpLogFile, L"Baking irradiance SH coefficients completed");
 	}
 	if (mTasks & TaskType::E_NeedToGenPrefilteredEnvCubeMap) {
 		CheckReturn(mpLogFile, CreatePrefilteredEnvironmentCubeMap());
@@ -732,13 +567,24 @@ BOOL EnvironmentMap::EnvironmentMapClass::Generate(
 		WLogln(mpLogFile, L"Generating prefiltered environment cube-map completed");
 	}
 	if (mTasks & TaskType::E_NeedToGenBrdfLutMap) {
-		CheckReturn(mpLogFile, CreateBrdfLutMap());
-		CheckReturn(mpLogFile, BuildBrdfLutMapDescriptors(TRUE));
+		std::wstringstream filePath;
+		filePath << baseDir << BrdfLutMapFileName << L".dds";
 
-		CheckReturn(mpLogFile, DrawBrdfLutMap(pFrameResource->MainPassCB.CBAddress()));
+		// The texture is created from the saved file, so the LUT is written
+		// out as soon as it is baked rather than in Save.
+		CheckReturn(mpLogFile, BakeBrdfLutMap(filePath.str().c_str()));
 
-		mTasks = static_cast<TaskType>(mTasks | TaskType::E_NeedToSaveBrdfLutMap);
-		WLogln(mpLogFile, L"Generating BRDF-LUT map completed");
+		CheckReturn(mpLogFile, GetTextureResource(
+			mpLogFile,
+			mInitData.Device,
+			mInitData.UploadQueue,
+			mBrdfLutMap.get(),
+			filePath.str().c_str(),
+			L"EnvironmentMap_BrdfLutMap"));
+		CheckReturn(mpLogFile, BuildBrdfLutMapDescriptors());
+		CheckReturn(mpLogFile, WaitForUploads());
+
+		WLogln(mpLogFile, L"Baking BRDF-LUT map completed");
 	}
 
 	return TRUE;
@@ -756,6 +602,9 @@ BOOL EnvironmentMap::EnvironmentMapClass::Save(LPCWSTR fileName, LPCWSTR baseDir
 			image,
 			mEnvironmentCubeMap->State(),
 			mEnvironmentCubeMap->State()));
+
+		CheckReturn(mpLogFile, Foundation::Util::TextureCooker::Compress(
+			image, Foundation::Util::TextureUsage::E_HDR));
 		
 		std::wstringstream filePath;
 		filePath << baseDir << fileName << EnvironmentCubeMapFileNameSuffix << L".dds";
@@ -769,29 +618,14 @@ BOOL EnvironmentMap::EnvironmentMapClass::Save(LPCWSTR fileName, LPCWSTR baseDir
 
 		WLogln(mpLogFile, L"Environment cube-map saved");
 	}
-	// Save diffuse irradiance cube map
-	if (mTasks & TaskType::E_NeedToSaveDiffuseIrradianceCubeMap) {
-		ScratchImage image;
-
-		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CaptureTexture(
-			mInitData.CommandObject,
-			mDiffuseIrradianceCubeMap->Resource(),
-			TRUE,
-			image,
-			mDiffuseIrradianceCubeMap->State(),
-			mDiffuseIrradianceCubeMap->State()));
-
+	// Save irradiance SH coefficients
+	if (mTasks & TaskType::E_NeedToSaveIrradianceSH) {
 		std::wstringstream filePath;
-		filePath << baseDir << fileName << DiffuseIrradianceCubeMapFileNameSuffix << L".dds";
+		filePath << baseDir << fileName << IrradianceSHFileNameSuffix << L".bin";
 
-		CheckHRESULT(mpLogFile, SaveToDDSFile(
-			image.GetImages(),
-			image.GetImageCount(),
-			image.GetMetadata(),
-			DDS_FLAGS_NONE,
-			filePath.str().c_str()));
+		CheckReturn(mpLogFile, SaveIrradianceSH(filePath.str().c_str()));
 
-		WLogln(mpLogFile, L"Diffuse irradiance cube-map saved");
+		WLogln(mpLogFile, L"Irradiance SH coefficients saved");
 	}
 	// Save prefiltered environment cube map
 	if (mTasks & TaskType::E_NeedToSavePrefilteredEnvCubeMap) {
@@ -804,6 +638,9 @@ BOOL EnvironmentMap::EnvironmentMapClass::Save(LPCWSTR fileName, LPCWSTR baseDir
 			image,
 			mPrefilteredEnvironmentCubeMap->State(),
 			mPrefilteredEnvironmentCubeMap->State()));
+
+		CheckReturn(mpLogFile, Foundation::Util::TextureCooker::Compress(
+			image, Foundation::Util::TextureUsage::E_HDR));
 	
 		std::wstringstream filePath;
 		filePath << baseDir << fileName << PrefilteredEnvironmentCubeMapFileNameSuffix << L".dds";
@@ -817,30 +654,15 @@ BOOL EnvironmentMap::EnvironmentMapClass::Save(LPCWSTR fileName, LPCWSTR baseDir
 	
 		WLogln(mpLogFile, L"Prefiltered environment cube-map saved");
 	}
-	// Save BRDF-LUT map
-	if (mTasks & TaskType::E_NeedToSaveBrdfLutMap) {
-		ScratchImage image;
 
-		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CaptureTexture(
-			mInitData.CommandObject,
-			mBrdfLutMap->Resource(),
-			FALSE,
-			image,
-			mBrdfLutMap->State(),
-			mBrdfLutMap->State()));
-
-		std::wstringstream filePath;
-		filePath << baseDir << BrdfLutMapFileName << L".dds";
+	return TRUE;
+}
 
-		CheckHRESULT(mpLogFile, SaveToDDSFile(
-			image.GetImages(),
-			image.GetImageCount(),
-			image.GetMetadata(),
-			DDS_FLAGS_NONE,
-			filePath.str().c_str()));
+BOOL EnvironmentMap::EnvironmentMapClass::WaitForUploads() {
+	const auto uploadQueue = mInitData.UploadQueue;
 
-		WLogln(mpLogFile, L"BRDF-LUT map saved");
-	}
+	CheckReturn(mpLogFile, uploadQueue->Submit());
+	CheckReturn(mpLogFile, mInitData.CommandObject->WaitOnQueue(uploadQueue->Fence(), uploadQueue->SubmittedFence()));
 
 	return TRUE;
 }
@@ -970,7 +792,8 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildEnvironmentMapDescriptors(BOOL bN
 		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
 		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
-		srvDesc.Format = HDR_FORMAT;
+		// A cube loaded from disk is block-compressed.
+		srvDesc.Format = mEnvironmentCubeMap->Desc().Format;
 		srvDesc.TextureCube.MostDetailedMip = 0;
 		srvDesc.TextureCube.ResourceMinLODClamp = 0.0f;
 		srvDesc.TextureCube.MipLevels = ShadingConvention::MipmapGenerator::MaxMipLevel;
@@ -1004,70 +827,6 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildEnvironmentMapDescriptors(BOOL bN
 	return TRUE;
 }
 
-BOOL EnvironmentMap::EnvironmentMapClass::CreateDiffuseIrradianceCubeMap() {
-	D3D12_RESOURCE_DESC rscDesc;
-	ZeroMemory(&rscDesc, sizeof(D3D12_RESOURCE_DESC));
-	rscDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-	rscDesc.Alignment = 0;
-	rscDesc.Format = ShadingConvention::EnvironmentMap::DiffuseIrradianceCubeMapFormat;
-	rscDesc.Width = CubeMapSize;
-	rscDesc.Height = CubeMapSize;
-	rscDesc.DepthOrArraySize = 6;
-	rscDesc.MipLevels = 1;
-	rscDesc.SampleDesc.Count = 1;
-	rscDesc.SampleDesc.Quality = 0;
-	rscDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-	rscDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-
-	CheckReturn(mpLogFile, mDiffuseIrradianceCubeMap->Initialize(
-		mInitData.Device,
-		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-		D3D12_HEAP_FLAG_NONE,
-		&rscDesc,
-		D3D12_RESOURCE_STATE_COMMON,
-		nullptr,
-		L"EnvironmentMap_DiffuseIrradianceCubeMap"));
-
-	return TRUE;
-}
-
-BOOL EnvironmentMap::EnvironmentMapClass::BuildDiffuseIrradianceCubeMapDescriptors(BOOL bNeedRtv) {
-	// Srv
-	{
-		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
-		srvDesc.Format = ShadingConvention::EnvironmentMap::DiffuseIrradianceCubeMapFormat;
-		srvDesc.TextureCube.MipLevels = 1;
-		srvDesc.TextureCube.MostDetailedMip = 0;
-		srvDesc.TextureCube.ResourceMinLODClamp = 0.0f;
-
-		Foundation::Util::D3D12Util::CreateShaderResourceView(
-			mInitData.Device,
-			mDiffuseIrradianceCubeMap->Resource(),
-			&srvDesc,
-			mhDiffuseIrradianceCubeMapCpuSrv);
-	}
-	// Rtv
-	if (bNeedRtv) {
-		D3D12_RENDER_TARGET_VIEW_DESC rtvDesc = {};
-		rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
-		rtvDesc.Format = ShadingConvention::EnvironmentMap::DiffuseIrradianceCubeMapFormat;
-		rtvDesc.Texture2DArray.ArraySize = 6;
-		rtvDesc.Texture2DArray.MipSlice = 0;
-		rtvDesc.Texture2DArray.PlaneSlice = 0;
-		rtvDesc.Texture2DArray.FirstArraySlice = 0;
-
-		Foundation::Util::D3D12Util::CreateRenderTargetView(
-			mInitData.Device,
-			mDiffuseIrradianceCubeMap->Resource(),
-			&rtvDesc,
-			mhDiffuseIrradianceCubeMapCpuRtv);
-	}
-
-	return TRUE;
-}
-
 BOOL EnvironmentMap::EnvironmentMapClass::CreatePrefilteredEnvironmentCubeMap() {
 	D3D12_RESOURCE_DESC rscDesc;
 	ZeroMemory(&rscDesc, sizeof(D3D12_RESOURCE_DESC));
@@ -1101,7 +860,7 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildPrefilteredEnvironmentCubeMapDesc
 		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
 		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
-		srvDesc.Format = ShadingConvention::EnvironmentMap::PrefilteredEnvironmentCubeMapFormat;
+		srvDesc.Format = mPrefilteredEnvironmentCubeMap->Desc().Format;
 		srvDesc.TextureCube.MipLevels = ShadingConvention::MipmapGenerator::MaxMipLevel;
 		srvDesc.TextureCube.MostDetailedMip = 0;
 		srvDesc.TextureCube.ResourceMinLODClamp = 0.0f;
@@ -1135,66 +894,141 @@ BOOL EnvironmentMap::EnvironmentMapClass::BuildPrefilteredEnvironmentCubeMapDesc
 	return TRUE;
 }
 
-BOOL EnvironmentMap::EnvironmentMapClass::CreateBrdfLutMap() {
-	D3D12_RESOURCE_DESC rscDesc;
-	ZeroMemory(&rscDesc, sizeof(D3D12_RESOURCE_DESC));
-	rscDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-	rscDesc.Alignment = 0;
-	rscDesc.Format = ShadingConvention::EnvironmentMap::BrdfLutMapFormat;
-	rscDesc.Width = BrdfLutMapSize;
-	rscDesc.Height = BrdfLutMapSize;
-	rscDesc.MipLevels = 1;
-	rscDesc.DepthOrArraySize = 1;
-	rscDesc.SampleDesc.Count = 1;
-	rscDesc.SampleDesc.Quality = 0;
-	rscDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-	rscDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-
-	CheckReturn(mpLogFile, mBrdfLutMap->Initialize(
+BOOL EnvironmentMap::EnvironmentMapClass::BuildBrdfLutMapDescriptors() {
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Format = ShadingConvention::EnvironmentMap::BrdfLutMapFormat;
+	srvDesc.Texture2D.MostDetailedMip = 0;
+	srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
+	srvDesc.Texture2D.PlaneSlice = 0;
+	srvDesc.Texture2D.MipLevels = 1;
+
+	Foundation::Util::D3D12Util::CreateShaderResourceView(
 		mInitData.Device,
-		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-		D3D12_HEAP_FLAG_NONE,
-		&rscDesc,
-		D3D12_RESOURCE_STATE_COMMON,
-		nullptr,
-		L"EnvironmentMap_BrdfLutMap"));
+		mBrdfLutMap->Resource(),
+		&srvDesc,
+		mhBrdfLutMapCpuSrv);
 
 	return TRUE;
 }
 
-BOOL EnvironmentMap::EnvironmentMapClass::BuildBrdfLutMapDescriptors(BOOL bNeedRtv) {
-	// Srv
-	{
-		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Format = ShadingConvention::EnvironmentMap::BrdfLutMapFormat;
-		srvDesc.Texture2D.MostDetailedMip = 0;
-		srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-		srvDesc.Texture2D.PlaneSlice = 0;
-		srvDesc.Texture2D.MipLevels = 1;
+BOOL EnvironmentMap::EnvironmentMapClass::LoadIrradianceSH(LPCWSTR filePath, BOOL& bLoaded) {
+	bLoaded = FALSE;
 
-		Foundation::Util::D3D12Util::CreateShaderResourceView(
-			mInitData.Device,
-			mBrdfLutMap->Resource(),
-			&srvDesc,
-			mhBrdfLutMapCpuSrv);
+	std::ifstream fin(filePath, std::ios::ate | std::ios::binary);
+	if (!fin.is_open()) return TRUE;
+
+	const size_t FileSize = static_cast<size_t>(fin.tellg());
+
+	// Coefficients from an older layout are simply baked again.
+	if (FileSize != sizeof(IrradianceSHHeader) + sizeof(Common::Util::EnvironmentBaker::IrradianceSH)) return TRUE;
+
+	IrradianceSHHeader header{};
+
+	fin.seekg(0);
+	fin.read(reinterpret_cast<CHAR*>(&header), sizeof(IrradianceSHHeader));
+	if (header.Magic != IrradianceSHMagic || header.Version != IrradianceSHVersion) return TRUE;
+
+	fin.read(reinterpret_cast<CHAR*>(&mIrradianceSH), sizeof(Common::Util::EnvironmentBaker::IrradianceSH));
+	fin.close();
+
+	bLoaded = TRUE;
+
+	return TRUE;
+}
+
+BOOL EnvironmentMap::EnvironmentMapClass::SaveIrradianceSH(LPCWSTR filePath) {
+	std::ofstream fout(filePath, std::ios::binary | std::ios::trunc);
+	if (!fout.is_open()) {
+		std::wstring msg(L"Failed to open irradiance SH file: ");
+		msg.append(filePath);
+		ReturnFalse(mpLogFile, msg);
 	}
-	// Rtv
-	if (bNeedRtv) {
-		D3D12_RENDER_TARGET_VIEW_DESC rtvDesc = {};
-		rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
-		rtvDesc.Format = ShadingConvention::EnvironmentMap::BrdfLutMapFormat;
-		rtvDesc.Texture2D.PlaneSlice = 0;
-		rtvDesc.Texture2D.MipSlice = 0;
 
-		Foundation::Util::D3D12Util::CreateRenderTargetView(
-			mInitData.Device,
-			mBrdfLutMap->Resource(),
-			&rtvDesc,
-			mhBrdfLutMapCpuRtv);
+	IrradianceSHHeader header{};
+	header.Magic = IrradianceSHMagic;
+	header.Version = IrradianceSHVersion;
+
+	fout.write(reinterpret_cast<const CHAR*>(&header), sizeof(IrradianceSHHeader));
+	fout.write(reinterpret_cast<const CHAR*>(&mIrradianceSH), sizeof(Common::Util::EnvironmentBaker::IrradianceSH));
+	fout.close();
+
+	return TRUE;
+}
+
+BOOL EnvironmentMap::EnvironmentMapClass::BakeIrradianceSH() {
+	ScratchImage image;
+
+	CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CaptureTexture(
+		mInitData.CommandObject,
+		mEnvironmentCubeMap->Resource(),
+		TRUE,
+		image,
+		mEnvironmentCubeMap->State(),
+		mEnvironmentCubeMap->State()));
+
+	const auto& metadata = image.GetMetadata();
+
+	size_t mipLevel = 0;
+	while (mipLevel + 1 < metadata.mipLevels && (metadata.width >> mipLevel) > IrradianceSHFaceSize) ++mipLevel;
+
+	const UINT FaceSize = static_cast<UINT>(std::max<size_t>(metadata.width >> mipLevel, 1));
+
+	ScratchImage faces[6];
+	const XMFLOAT4* pFaces[6]{};
+
+	for (size_t face = 0; face < 6; ++face) {
+		const auto src = image.GetImage(mipLevel, face, 0);
+		NullCheck(mpLogFile, src);
+
+		// A cube loaded from disk is BC6H and has to be decoded instead.
+		if (IsCompressed(src->format)) {
+			CheckHRESULT(mpLogFile, Decompress(*src, DXGI_FORMAT_R32G32B32A32_FLOAT, faces[face]));
+		}
+		else {
+			CheckHRESULT(mpLogFile, Convert(
+				*src,
+				DXGI_FORMAT_R32G32B32A32_FLOAT,
+				TEX_FILTER_DEFAULT,
+				TEX_THRESHOLD_DEFAULT,
+				faces[face]));
+		}
+
+		pFaces[face] = reinterpret_cast<const XMFLOAT4*>(faces[face].GetPixels());
 	}
 
+	mEnvironmentBaker->ProjectIrradianceSH(pFaces, FaceSize, mIrradianceSH);
+
+	return TRUE;
+}
+
+BOOL EnvironmentMap::EnvironmentMapClass::BakeBrdfLutMap(LPCWSTR filePath) {
+	std::vector<XMFLOAT2> lut{};
+	mEnvironmentBaker->BakeBrdfLut(BrdfLutMapSize, BrdfLutSampleCount, lut);
+
+	ScratchImage image;
+	CheckHRESULT(mpLogFile, image.Initialize2D(
+		ShadingConvention::EnvironmentMap::BrdfLutMapFormat, BrdfLutMapSize, BrdfLutMapSize, 1, 1));
+
+	const auto dst = image.GetImage(0, 0, 0);
+	for (UINT y = 0; y < BrdfLutMapSize; ++y) {
+		auto row = reinterpret_cast<PackedVector::HALF*>(dst->pixels + y * dst->rowPitch);
+
+		for (UINT x = 0; x < BrdfLutMapSize; ++x) {
+			const auto& texel = lut[y * BrdfLutMapSize + x];
+			row[x * 2 + 0] = PackedVector::XMConvertFloatToHalf(texel.x);
+			row[x * 2 + 1] = PackedVector::XMConvertFloatToHalf(texel.y);
+		}
+	}
+
+	CheckHRESULT(mpLogFile, SaveToDDSFile(
+		image.GetImages(),
+		image.GetImageCount(),
+		image.GetMetadata(),
+		DDS_FLAGS_NONE,
+		filePath));
+
 	return TRUE;
 }
 
@@ -1231,36 +1065,6 @@ BOOL EnvironmentMap::EnvironmentMapClass::ConvertEquirectangularMapToCubeMap(
 	return TRUE;
 }
 
-BOOL EnvironmentMap::EnvironmentMapClass::DrawDiffuseIrradianceCubeMap(D3D12_GPU_VIRTUAL_ADDRESS cbProjectToCube) {
-	CheckReturn(mpLogFile, mInitData.CommandObject->ResetDirectCommandList(
-		mPipelineStates[PipelineState::GP_ConvoluteDiffuseIrradiance].Get()));
-
-	const auto CmdList = mInitData.CommandObject->DirectCommandList();
-	mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
-
-	CmdList->SetGraphicsRootSignature(mRootSignatures[RootSignature::GR_ConvoluteDiffuseIrradiance].Get());
-
-	CmdList->RSSetViewports(1, &mViewport);
-	CmdList->RSSetScissorRects(1, &mScissorRect);
-
-	mDiffuseIrradianceCubeMap->Transite(CmdList, D3D12_RESOURCE_STATE_RENDER_TARGET);
-	mEnvironmentCubeMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-
-	CmdList->OMSetRenderTargets(1, &mhDiffuseIrradianceCubeMapCpuRtv, TRUE, nullptr);
-
-	CmdList->SetGraphicsRootConstantBufferView(RootSignature::ConvoluteDiffuseIrradiance::CB_ProjectToCube, cbProjectToCube);
-	CmdList->SetGraphicsRootDescriptorTable(RootSignature::ConvoluteDiffuseIrradiance::SI_CubeMap, mhEnvironmentCubeMapGpuSrv);
-
-	CmdList->IASetVertexBuffers(0, 0, nullptr);
-	CmdList->IASetIndexBuffer(nullptr);
-	CmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	CmdList->DrawInstanced(36, 1, 0, 0);
-
-	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteDirectCommandList());
-
-	return TRUE;
-}
-
 BOOL EnvironmentMap::EnvironmentMapClass::DrawPrefilteredEnvironmentCubeMap(D3D12_GPU_VIRTUAL_ADDRESS cbProjectToCube) {
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetDirectCommandList(
 		mPipelineStates[PipelineState::GP_ConvoluteSpecularIrradiance].Get()));
@@ -1312,39 +1116,5 @@ BOOL EnvironmentMap::EnvironmentMapClass::DrawPrefilteredEnvironmentCubeMap(D3D1
 
 	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteDirectCommandList());
 
-	return TRUE;
-}
-
-BOOL EnvironmentMap::EnvironmentMapClass::DrawBrdfLutMap(D3D12_GPU_VIRTUAL_ADDRESS cbPass) {
-	CheckReturn(mpLogFile, mInitData.CommandObject->ResetDirectCommandList(
-		mPipelineStates[mInitData.MeshShaderSupported ? 
-		PipelineState::MP_IntegrateBrdf : PipelineState::GP_IntegrateBrdf].Get()));
-
-	const auto CmdList = mInitData.CommandObject->DirectCommandList();
-	mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
-
-	CmdList->SetGraphicsRootSignature(mRootSignatures[RootSignature::GR_IntegrateBrdf].Get());
-
-	CmdList->RSSetViewports(1, &mViewport);
-	CmdList->RSSetScissorRects(1, &mScissorRect);
-
-	mBrdfLutMap->Transite(CmdList, D3D12_RESOURCE_STATE_RENDER_TARGET);
-
-	CmdList->OMSetRenderTargets(1, &mhBrdfLutMapCpuRtv, TRUE, nullptr);
-
-	CmdList->SetGraphicsRootConstantBufferView(RootSignature::IntegrateBrdf::CB_Pass, cbPass);
-
-	if (mInitData.MeshShaderSupported) {
-		CmdList->DispatchMesh(1, 1, 1);
-	}
-	else {
-		CmdList->IASetVertexBuffers(0, 0, nullptr);
-		CmdList->IASetIndexBuffer(nullptr);
-		CmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-		CmdList->DrawInstanced(6, 1, 0, 0);
-	}
-
-	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteDirectCommandList());
-
 	return TRUE;
 }
\ No newline at end of file
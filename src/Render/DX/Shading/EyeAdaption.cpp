@@ -12,13 +12,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_ClearHistogram = L"ClearHistogram.hlsl";
-	const WCHAR* const HLSL_LuminanceHistogram = L"LuminanceHistogram.hlsl";
-	const WCHAR* const HLSL_PercentileExtract = L"PercentileExtract.hlsl";
-	const WCHAR* const HLSL_TemporalSmoothing = L"TemporalSmoothing.hlsl";
-}
-
 EyeAdaption::InitDataPtr EyeAdaption::MakeInitData() {
 	return std::unique_ptr<EyeAdaptionClass::InitData>(new EyeAdaptionClass::InitData());
 }
@@ -68,38 +61,6 @@ void EyeAdaption::EyeAdaptionClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL EyeAdaption::EyeAdaptionClass::CompileShaders() {
-	// ClearHistogram
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_ClearHistogram, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			CS, mShaderHashes[Shader::CS_ClearHistogram]));
-	}
-	// LuminanceHistogram
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_LuminanceHistogram, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			CS, mShaderHashes[Shader::CS_LuminanceHistogram]));
-	}
-	// PercentileExtract
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_PercentileExtract, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			CS, mShaderHashes[Shader::CS_PercentileExtract]));
-	}
-	// TemporalSmoothing
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_TemporalSmoothing, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			CS, mShaderHashes[Shader::CS_TemporalSmoothing]));
-	}
-	return TRUE;
-}
-
 BOOL EyeAdaption::EyeAdaptionClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -192,7 +153,7 @@ BOOL EyeAdaption::EyeAdaptionClass::BuildPipelineStates() {
 			psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 			{
 				const auto CS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::CS_ClearHistogram]);
+					L"EyeAdaption.CS_ClearHistogram");
 				NullCheck(mpLogFile, CS);
 				psoDesc.CS = {
 					reinterpret_cast<BYTE*>(CS->GetBufferPointer()),
@@ -213,7 +174,7 @@ BOOL EyeAdaption::EyeAdaptionClass::BuildPipelineStates() {
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
 			const auto CS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::CS_LuminanceHistogram]);
+				L"EyeAdaption.CS_LuminanceHistogram");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { 
 				reinterpret_cast<BYTE*>(CS->GetBufferPointer()), 
@@ -234,7 +195,7 @@ BOOL EyeAdaption::EyeAdaptionClass::BuildPipelineStates() {
 			psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 			{
 				const auto CS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::CS_PercentileExtract]);
+					L"EyeAdaption.CS_PercentileExtract");
 				NullCheck(mpLogFile, CS);
 				psoDesc.CS = {
 					reinterpret_cast<BYTE*>(CS->GetBufferPointer()),
@@ -255,7 +216,7 @@ BOOL EyeAdaption::EyeAdaptionClass::BuildPipelineStates() {
 			psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 			{
 				const auto CS = mInitData.ShaderManager->GetShader(
-					mShaderHashes[Shader::CS_TemporalSmoothing]);
+					L"EyeAdaption.CS_TemporalSmoothing");
 				NullCheck(mpLogFile, CS);
 				psoDesc.CS = {
 					reinterpret_cast<BYTE*>(CS->GetBufferPointer()),
@@ -298,7 +259,7 @@ BOOL EyeAdaption::EyeAdaptionClass::ClearHistogram(
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, Histogram);
 
 		ShadingConvention::EyeAdaption::RootConstant::LuminanceHistogram::Struct rc;
-		rc.gTexDim = { mInitData.ClientWidth, mInitData.ClientHeight };
+		rc.gTexDim = { mRenderWidth, mRenderHeight };
 		rc.gMinLogLum = -8.f;
 		rc.gMaxLogLum = 4.f;
 		rc.gBinCount = 64;
@@ -346,7 +307,7 @@ BOOL EyeAdaption::EyeAdaptionClass::BuildLuminanceHistogram(
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, Histogram);
 
 		ShadingConvention::EyeAdaption::RootConstant::LuminanceHistogram::Struct rc;
-		rc.gTexDim = { mInitData.ClientWidth >> 1, mInitData.ClientHeight >> 1 };
+		rc.gTexDim = { mRenderWidth >> 1, mRenderHeight >> 1 };
 		rc.gMinLogLum = -8.f;
 		rc.gMaxLogLum = 4.f;
 		rc.gBinCount = 64;
@@ -367,10 +328,10 @@ BOOL EyeAdaption::EyeAdaptionClass::BuildLuminanceHistogram(
 
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth >> 1, 
+				mRenderWidth >> 1, 
 				ShadingConvention::EyeAdaption::ThreadGroup::Default::Width),
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight >> 1, 
+				mRenderHeight >> 1, 
 				ShadingConvention::EyeAdaption::ThreadGroup::Default::Height),
 			ShadingConvention::EyeAdaption::ThreadGroup::Default::Depth);
 	}
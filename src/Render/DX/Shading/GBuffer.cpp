@@ -1,6 +1,7 @@
 #include "Render/DX/Foundation/Core/pch_d3d12.h"
 #include "Render/DX/Shading/GBuffer.hpp"
 #include "Common/Debug/Logger.hpp"
+#include "Common/Util/DrawBatcher.hpp"
 #include "Render/DX/Foundation/RenderItem.hpp"
 #include "Render/DX/Foundation/Resource/GpuResource.hpp"
 #include "Render/DX/Foundation/Resource/MeshGeometry.hpp"
@@ -18,7 +19,9 @@ using namespace Render::DX::Shading;
 namespace {
 	const UINT NumRenderTargtes = 8;
 
-	const WCHAR* const HLSL_GBuffer = L"GBuffer.hlsl";
+	// Below this many batches per list, a worker costs more than it records.
+	const UINT MinItemsPerWorker = 128;
+
 }
 
 GBuffer::InitDataPtr GBuffer::MakeInitData() {
@@ -61,22 +64,12 @@ void GBuffer::GBufferClass::CleanUp() {
 	for (UINT i = 0; i < PipelineState::Count; ++i)
 		mPipelineStates[i].Reset();
 
+	mCommandSignature.Reset();
 	mRootSignature.Reset();
 
 	mbCleanedUp = TRUE;
 }
 
-BOOL GBuffer::GBufferClass::CompileShaders() {
-	const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_GBuffer, L"VS", L"vs_6_5");
-	const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_GBuffer, L"MS", L"ms_6_5");
-	const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_GBuffer, L"PS", L"ps_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_GBuffer]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_GBuffer]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_GBuffer]));
-
-	return TRUE;
-}
-
 BOOL GBuffer::GBufferClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -87,9 +80,10 @@ BOOL GBuffer::GBufferClass::BuildRootSignatures() {
 
 	CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::Default::Count]{};
 	slotRootParameter[RootSignature::Default::CB_Pass].InitAsConstantBufferView(0);
-	slotRootParameter[RootSignature::Default::CB_Object].InitAsConstantBufferView(1);
-	slotRootParameter[RootSignature::Default::CB_Material].InitAsConstantBufferView(2);
-	slotRootParameter[RootSignature::Default::RC_Consts].InitAsConstants(ShadingConvention::GBuffer::RootConstant::Default::Count, 3);
+	slotRootParameter[RootSignature::Default::CB_Material].InitAsConstantBufferView(1);
+	slotRootParameter[RootSignature::Default::RC_Consts].InitAsConstants(ShadingConvention::GBuffer::RootConstant::Default::Count, 2);
+	slotRootParameter[RootSignature::Default::SI_Objects].InitAsShaderResourceView(2);
+	slotRootParameter[RootSignature::Default::SI_InstanceIndices].InitAsShaderResourceView(3);
 	slotRootParameter[RootSignature::Default::SI_VertexBuffer].InitAsShaderResourceView(0);
 	slotRootParameter[RootSignature::Default::SI_IndexBuffer].InitAsShaderResourceView(1);
 	slotRootParameter[RootSignature::Default::SI_Textures].InitAsDescriptorTable(1, &texTables[index++]);
@@ -114,9 +108,9 @@ BOOL GBuffer::GBufferClass::BuildPipelineStates() {
 		auto psoDesc = Foundation::Util::D3D12Util::DefaultMeshPsoDesc(ShadingConvention::DepthStencilBuffer::DepthStencilBufferFormat);
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
-			const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_GBuffer]);
+			const auto MS = mInitData.ShaderManager->GetShader(L"GBuffer.MS_GBuffer");
 			NullCheck(mpLogFile, MS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_GBuffer]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"GBuffer.PS_GBuffer");
 			NullCheck(mpLogFile, PS);
 			psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -142,9 +136,9 @@ BOOL GBuffer::GBufferClass::BuildPipelineStates() {
 		auto psoDesc = Foundation::Util::D3D12Util::DefaultPsoDesc(inputLayout, ShadingConvention::DepthStencilBuffer::DepthStencilBufferFormat);
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_GBuffer]);
+			const auto VS = mInitData.ShaderManager->GetShader(L"GBuffer.VS_GBuffer");
 			NullCheck(mpLogFile, VS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_GBuffer]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"GBuffer.PS_GBuffer");
 			NullCheck(mpLogFile, PS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -166,6 +160,8 @@ BOOL GBuffer::GBufferClass::BuildPipelineStates() {
 			L"GBuffer_GP_Default"));
 	}
 
+	CheckReturn(mpLogFile, BuildCommandSignature());
+
 	return TRUE;
 }
 
@@ -229,6 +225,82 @@ BOOL GBuffer::GBufferClass::DrawGBuffer(
 		Foundation::Resource::GpuResource* const depthBuffer, 
 		D3D12_CPU_DESCRIPTOR_HANDLE do_depthBuffer,
 		const std::vector<Render::DX::Foundation::RenderItem*>& ritems,
+		const Common::Util::DrawBatcher& batcher,
+		FLOAT ditheringMaxDist, FLOAT ditheringMinDist) {
+	std::array<D3D12_CPU_DESCRIPTOR_HANDLE, NumRenderTargtes> renderTargets = {
+		mhCpuRtvs[Descriptor::Rtv::E_Albedo],
+		mhCpuRtvs[Descriptor::Rtv::E_Normal],
+		mhCpuRtvs[Descriptor::Rtv::E_NormalDepth],
+		mhCpuRtvs[Descriptor::Rtv::E_ReprojNormalDepth],
+		mhCpuRtvs[Descriptor::Rtv::E_Specular],
+		mhCpuRtvs[Descriptor::Rtv::E_RoughnessMetalness],
+		mhCpuRtvs[Descriptor::Rtv::E_Velocity],
+		mhCpuRtvs[Descriptor::Rtv::E_Position]
+	};
+
+	std::vector<ID3D12CommandAllocator*> allocs{};
+	pFrameResource->CommandAllocators(allocs);
+
+	const UINT ItemCount = static_cast<UINT>(batcher.Batches().size());
+	const UINT WorkerCount = std::max(1u, std::min(
+		mInitData.CommandObject->ThreadCount(), ItemCount / MinItemsPerWorker));
+	const UINT ItemsPerWorker = Foundation::Util::D3D12Util::CeilDivide(ItemCount, WorkerCount);
+
+	// Worker 0 also clears the targets; the lists are submitted in order,
+	// so the other workers only have to bind them.
+	CheckReturn(mpLogFile, mInitData.CommandObject->RecordCommandLists(
+		allocs.data(),
+		WorkerCount,
+		mPipelineStates[mInitData.MeshShaderSupported ? PipelineState::MP_GBuffer : PipelineState::GP_GBuffer].Get(),
+		[&](ID3D12GraphicsCommandList6* const CmdList, UINT worker) -> BOOL {
+			mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
+
+			if (worker == 0) CheckReturn(mpLogFile, ClearGBuffer(CmdList, depthBuffer, do_depthBuffer));
+
+			CmdList->SetGraphicsRootSignature(mRootSignature.Get());
+			CmdList->SetGraphicsRootDescriptorTable(
+				RootSignature::Default::SI_Textures,
+				mInitData.DescriptorHeap->TextureTableGpuHandle());
+
+			CmdList->RSSetViewports(1, &viewport);
+			CmdList->RSSetScissorRects(1, &scissorRect);
+
+			CmdList->OMSetRenderTargets(static_cast<UINT>(renderTargets.size()), renderTargets.data(), TRUE, &do_depthBuffer);
+
+			CmdList->SetGraphicsRootConstantBufferView(
+				RootSignature::Default::CB_Pass,
+				pFrameResource->MainPassCB.CBAddress());
+			CmdList->SetGraphicsRootShaderResourceView(
+				RootSignature::Default::SI_Objects,
+				pFrameResource->ObjectCB.CBAddress());
+			CmdList->SetGraphicsRootShaderResourceView(
+				RootSignature::Default::SI_InstanceIndices,
+				pFrameResource->InstanceIndices.CBAddress());
+
+			const UINT Begin = std::min(ItemCount, worker * ItemsPerWorker);
+			const UINT End = std::min(ItemCount, Begin + ItemsPerWorker);
+
+			CheckReturn(mpLogFile, DrawRenderItems(
+				pFrameResource, CmdList, ritems, batcher, Begin, End, ditheringMaxDist, ditheringMinDist));
+
+			return TRUE;
+		}));
+
+	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandLists(WorkerCount));
+
+	return TRUE;
+}
+
+BOOL GBuffer::GBufferClass::DrawGBufferIndirect(
+		Foundation::Resource::FrameResource* const pFrameResource,
+		D3D12_VIEWPORT viewport,
+		D3D12_RECT scissorRect,
+		Foundation::Resource::GpuResource* const depthBuffer,
+		D3D12_CPU_DESCRIPTOR_HANDLE do_depthBuffer,
+		D3D12_GPU_VIRTUAL_ADDRESS instanceIndices,
+		Foundation::Resource::GpuResource* const pCommandBuffer,
+		Foundation::Resource::GpuResource* const pCommandCountBuffer,
+		UINT maxCommandCount,
 		FLOAT ditheringMaxDist, FLOAT ditheringMinDist) {
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
@@ -238,14 +310,118 @@ BOOL GBuffer::GBufferClass::DrawGBuffer(
 	const auto CmdList = mInitData.CommandObject->CommandList(0);
 	mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
 
-	CheckReturn(mpLogFile, CacheNormalDepth(CmdList));
+	CheckReturn(mpLogFile, ClearGBuffer(CmdList, depthBuffer, do_depthBuffer));
 
 	{
+		std::array<D3D12_CPU_DESCRIPTOR_HANDLE, NumRenderTargtes> renderTargets = {
+			mhCpuRtvs[Descriptor::Rtv::E_Albedo],
+			mhCpuRtvs[Descriptor::Rtv::E_Normal],
+			mhCpuRtvs[Descriptor::Rtv::E_NormalDepth],
+			mhCpuRtvs[Descriptor::Rtv::E_ReprojNormalDepth],
+			mhCpuRtvs[Descriptor::Rtv::E_Specular],
+			mhCpuRtvs[Descriptor::Rtv::E_RoughnessMetalness],
+			mhCpuRtvs[Descriptor::Rtv::E_Velocity],
+			mhCpuRtvs[Descriptor::Rtv::E_Position]
+		};
+
 		CmdList->SetGraphicsRootSignature(mRootSignature.Get());
+		CmdList->SetGraphicsRootDescriptorTable(
+			RootSignature::Default::SI_Textures,
+			mInitData.DescriptorHeap->TextureTableGpuHandle());
 
 		CmdList->RSSetViewports(1, &viewport);
 		CmdList->RSSetScissorRects(1, &scissorRect);
-		
+
+		CmdList->OMSetRenderTargets(static_cast<UINT>(renderTargets.size()), renderTargets.data(), TRUE, &do_depthBuffer);
+
+		CmdList->SetGraphicsRootConstantBufferView(
+			RootSignature::Default::CB_Pass,
+			pFrameResource->MainPassCB.CBAddress());
+		CmdList->SetGraphicsRootShaderResourceView(
+			RootSignature::Default::SI_Objects,
+			pFrameResource->ObjectCB.CBAddress());
+		CmdList->SetGraphicsRootShaderResourceView(
+			RootSignature::Default::SI_InstanceIndices,
+			instanceIndices);
+
+		// The counts and the instance base are set by each record.
+		ShadingConvention::GBuffer::RootConstant::Default::Struct rc{};
+		rc.gTexDim = { mRenderWidth, mRenderHeight };
+		rc.gDitheringMaxDist = ditheringMaxDist;
+		rc.gDitheringMinDist = ditheringMinDist;
+
+		std::array<std::uint32_t, ShadingConvention::GBuffer::RootConstant::Default::Count> consts;
+		std::memcpy(consts.data(), &rc, sizeof(ShadingConvention::GBuffer::RootConstant::Default::Struct));
+
+		Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::GBuffer::RootConstant::Default::Struct>(
+			RootSignature::Default::RC_Consts,
+			ShadingConvention::GBuffer::RootConstant::Default::Count,
+			consts.data(),
+			0,
+			CmdList,
+			FALSE);
+
+		if (!mInitData.MeshShaderSupported) 
+			CmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+		pCommandBuffer->Transite(CmdList, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+		pCommandCountBuffer->Transite(CmdList, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+
+		CmdList->ExecuteIndirect(
+			mCommandSignature.Get(),
+			maxCommandCount,
+			pCommandBuffer->Resource(),
+			0,
+			pCommandCountBuffer->Resource(),
+			0);
+	}
+
+	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandList(0));
+
+	return TRUE;
+}
+
+void GBuffer::GBufferClass::BuildIndirectCommand(
+		Foundation::Resource::FrameResource* const pFrameResource,
+		const Foundation::RenderItem* const pRitem,
+		ShadingConvention::GBuffer::IndirectCommand& command) const {
+	const auto Geometry = pRitem->Geometry;
+
+	command = {};
+	command.MaterialCB = pFrameResource->MaterialCB.CBAddress(pRitem->Material->MaterialCBIndex);
+	command.VertexCount = Geometry->VertexBufferByteSize / Geometry->VertexByteStride;
+	command.IndexCount = Geometry->IndexBufferByteSize / Geometry->IndexByteStride;
+	// Resolved through an identity list, so the base is the object itself.
+	command.InstanceBase = static_cast<UINT>(pRitem->ObjectCBIndex);
+
+	if (mInitData.MeshShaderSupported) {
+		command.Mesh.VertexBuffer = Geometry->VertexBufferGPU->GetGPUVirtualAddress();
+		command.Mesh.IndexBuffer = Geometry->IndexBufferGPU->GetGPUVirtualAddress();
+
+		command.Mesh.DispatchArguments.ThreadGroupCountX = Foundation::Util::D3D12Util::CeilDivide(
+			command.IndexCount / 3, ShadingConvention::GBuffer::ThreadGroup::MeshShader::ThreadsPerGroup);
+		command.Mesh.DispatchArguments.ThreadGroupCountY = 1;
+		command.Mesh.DispatchArguments.ThreadGroupCountZ = 1;
+	}
+	else {
+		command.Draw.VertexBufferView = Geometry->VertexBufferView();
+		command.Draw.IndexBufferView = Geometry->IndexBufferView();
+
+		command.Draw.DrawArguments.IndexCountPerInstance = pRitem->IndexCount;
+		command.Draw.DrawArguments.InstanceCount = 1;
+		command.Draw.DrawArguments.StartIndexLocation = pRitem->StartIndexLocation;
+		command.Draw.DrawArguments.BaseVertexLocation = static_cast<INT>(pRitem->BaseVertexLocation);
+		command.Draw.DrawArguments.StartInstanceLocation = 0;
+	}
+}
+
+BOOL GBuffer::GBufferClass::ClearGBuffer(
+		ID3D12GraphicsCommandList6* const CmdList,
+		Foundation::Resource::GpuResource* const depthBuffer,
+		D3D12_CPU_DESCRIPTOR_HANDLE do_depthBuffer) {
+	CheckReturn(mpLogFile, CacheNormalDepth(CmdList));
+
+	{
 		mResources[Resource::E_Albedo]->Transite(CmdList, D3D12_RESOURCE_STATE_RENDER_TARGET);
 		mResources[Resource::E_Normal]->Transite(CmdList, D3D12_RESOURCE_STATE_RENDER_TARGET);
 		mResources[Resource::E_NormalDepth]->Transite(CmdList, D3D12_RESOURCE_STATE_RENDER_TARGET);
@@ -270,29 +446,8 @@ BOOL GBuffer::GBufferClass::DrawGBuffer(
 			ShadingConvention::DepthStencilBuffer::InvalidDepthValue, 
 			ShadingConvention::DepthStencilBuffer::InvalidStencilValue,
 			0, nullptr);
-
-		std::array<D3D12_CPU_DESCRIPTOR_HANDLE, NumRenderTargtes> renderTargets = {
-			mhCpuRtvs[Descriptor::Rtv::E_Albedo],
-			mhCpuRtvs[Descriptor::Rtv::E_Normal],
-			mhCpuRtvs[Descriptor::Rtv::E_NormalDepth],
-			mhCpuRtvs[Descriptor::Rtv::E_ReprojNormalDepth],
-			mhCpuRtvs[Descriptor::Rtv::E_Specular],
-			mhCpuRtvs[Descriptor::Rtv::E_RoughnessMetalness],
-			mhCpuRtvs[Descriptor::Rtv::E_Velocity],
-			mhCpuRtvs[Descriptor::Rtv::E_Position]
-		};
-
-		CmdList->OMSetRenderTargets(static_cast<UINT>(renderTargets.size()), renderTargets.data(), TRUE, &do_depthBuffer);
-
-		CmdList->SetGraphicsRootConstantBufferView(
-			RootSignature::Default::CB_Pass, 
-			pFrameResource->MainPassCB.CBAddress());
-
-		CheckReturn(mpLogFile, DrawRenderItems(pFrameResource, CmdList, ritems, ditheringMaxDist, ditheringMinDist));
 	}
 
-	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandList(0));
-
 	return TRUE;
 }
 
@@ -588,22 +743,25 @@ BOOL GBuffer::GBufferClass::DrawRenderItems(
 		Foundation::Resource::FrameResource* const pFrameResource,
 		ID3D12GraphicsCommandList6* const pCmdList,
 		const std::vector<Render::DX::Foundation::RenderItem*>& ritems,
+		const Common::Util::DrawBatcher& batcher,
+		UINT begin, UINT end,
 		FLOAT ditheringMaxDist, FLOAT ditheringMinDist) {
-	for (size_t i = 0, end = ritems.size(); i < end; ++i) {
-		const auto ri = ritems[i];
+	const auto& Batches = batcher.Batches();
+
+	for (UINT i = begin; i < end; ++i) {
+		// Every item of a batch shares the geometry and material of the first.
+		const auto& batch = Batches[i];
+		const auto ri = ritems[batch.First];
 
-		pCmdList->SetGraphicsRootConstantBufferView(
-			RootSignature::Default::CB_Object, 
-			pFrameResource->ObjectCB.CBAddress(ri->ObjectCBIndex));
-		
 		pCmdList->SetGraphicsRootConstantBufferView(
 			RootSignature::Default::CB_Material, 
 			pFrameResource->MaterialCB.CBAddress(ri->Material->MaterialCBIndex));
 
-		ShadingConvention::GBuffer::RootConstant::Default::Struct rc;
-		rc.gTexDim = { mInitData.ClientWidth, mInitData.ClientHeight };
+		ShadingConvention::GBuffer::RootConstant::Default::Struct rc{};
+		rc.gTexDim = { mRenderWidth, mRenderHeight };
 		rc.gVertexCount = ri->Geometry->VertexBufferByteSize / ri->Geometry->VertexByteStride;
 		rc.gIndexCount = ri->Geometry->IndexBufferByteSize / ri->Geometry->IndexByteStride;
+		rc.gInstanceBase = batch.First;
 		rc.gDitheringMaxDist = ditheringMaxDist;
 		rc.gDitheringMinDist = ditheringMinDist;
 
@@ -626,7 +784,7 @@ BOOL GBuffer::GBufferClass::DrawRenderItems(
 
 			pCmdList->DispatchMesh(
 				Foundation::Util::D3D12Util::CeilDivide(PrimCount, ShadingConvention::GBuffer::ThreadGroup::MeshShader::ThreadsPerGroup),
-				1,
+				batch.Count,
 				1);
 		}
 		else {
@@ -634,13 +792,59 @@ BOOL GBuffer::GBufferClass::DrawRenderItems(
 			pCmdList->IASetIndexBuffer(&ri->Geometry->IndexBufferView());
 			pCmdList->IASetPrimitiveTopology(ri->PrimitiveType);
 
-			pCmdList->DrawIndexedInstanced(ri->IndexCount, 1, ri->StartIndexLocation, ri->BaseVertexLocation, 0);
+			pCmdList->DrawIndexedInstanced(ri->IndexCount, batch.Count, ri->StartIndexLocation, ri->BaseVertexLocation, 0);
 		}
 	}
 
 	return TRUE;
 }
 
+BOOL GBuffer::GBufferClass::BuildCommandSignature() {
+	// Argument order has to match ShadingConvention::GBuffer::IndirectCommand.
+	std::array<D3D12_INDIRECT_ARGUMENT_DESC, 6> args{};
+	UINT count = 0;
+
+	args[count].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT_BUFFER_VIEW;
+	args[count++].ConstantBufferView.RootParameterIndex = RootSignature::Default::CB_Material;
+
+	args[count].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+	args[count].Constant.RootParameterIndex = RootSignature::Default::RC_Consts;
+	args[count].Constant.DestOffsetIn32BitValues = ShadingConvention::GBuffer::RootConstant::Default::E_VertexCount;
+	args[count++].Constant.Num32BitValuesToSet = 
+		ShadingConvention::GBuffer::RootConstant::Default::Count - ShadingConvention::GBuffer::RootConstant::Default::E_VertexCount;
+
+	if (mInitData.MeshShaderSupported) {
+		args[count].Type = D3D12_INDIRECT_ARGUMENT_TYPE_SHADER_RESOURCE_VIEW;
+		args[count++].ShaderResourceView.RootParameterIndex = RootSignature::Default::SI_VertexBuffer;
+		args[count].Type = D3D12_INDIRECT_ARGUMENT_TYPE_SHADER_RESOURCE_VIEW;
+		args[count++].ShaderResourceView.RootParameterIndex = RootSignature::Default::SI_IndexBuffer;
+
+		args[count++].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_MESH;
+	}
+	else {
+		args[count].Type = D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW;
+		args[count++].VertexBuffer.Slot = 0;
+
+		args[count++].Type = D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW;
+		args[count++].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+	}
+
+	D3D12_COMMAND_SIGNATURE_DESC desc{};
+	desc.ByteStride = sizeof(ShadingConvention::GBuffer::IndirectCommand);
+	desc.NumArgumentDescs = count;
+	desc.pArgumentDescs = args.data();
+	desc.NodeMask = 0;
+
+	CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateCommandSignature(
+		mInitData.Device,
+		desc,
+		mRootSignature.Get(),
+		IID_PPV_ARGS(&mCommandSignature),
+		L"GBuffer_CS_Default"));
+
+	return TRUE;
+}
+
 BOOL GBuffer::GBufferClass::CacheNormalDepth(ID3D12GraphicsCommandList6* const pCmdList) {
 	const auto normalDepth = mResources[Resource::E_NormalDepth].get();
 	const auto cached = mResources[Resource::E_CachedNormalDepth].get();
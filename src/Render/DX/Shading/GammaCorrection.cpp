@@ -12,10 +12,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_GammaCorrection = L"GammaCorrection.hlsl";
-}
-
 GammaCorrection::InitDataPtr GammaCorrection::MakeInitData() {
 	return std::unique_ptr<GammaCorrectionClass::InitData>(new GammaCorrectionClass::InitData());
 }
@@ -50,23 +46,6 @@ void GammaCorrection::GammaCorrectionClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL GammaCorrection::GammaCorrectionClass::CompileShaders() {
-	const auto VS = Util::ShaderManager::D3D12ShaderInfo(
-		HLSL_GammaCorrection, L"VS", L"vs_6_5");
-	const auto MS = Util::ShaderManager::D3D12ShaderInfo(
-		HLSL_GammaCorrection, L"MS", L"ms_6_5");
-	const auto PS = Util::ShaderManager::D3D12ShaderInfo(
-		HLSL_GammaCorrection, L"PS", L"ps_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-		VS, mShaderHashes[Shader::VS_GammaCorrect]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-		MS, mShaderHashes[Shader::MS_GammaCorrect]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-		PS, mShaderHashes[Shader::PS_GammaCorrect]));
-
-	return TRUE;
-}
-
 BOOL GammaCorrection::GammaCorrectionClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -102,10 +81,10 @@ BOOL GammaCorrection::GammaCorrectionClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
 			const auto MS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::MS_GammaCorrect]);
+				L"GammaCorrection.MS_GammaCorrect");
 			NullCheck(mpLogFile, MS);
 			const auto PS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::PS_GammaCorrect]);
+				L"GammaCorrection.PS_GammaCorrect");
 			NullCheck(mpLogFile, PS);
 			psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -122,9 +101,9 @@ BOOL GammaCorrection::GammaCorrectionClass::BuildPipelineStates() {
 		auto psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_GammaCorrect]);
+			const auto VS = mInitData.ShaderManager->GetShader(L"GammaCorrection.VS_GammaCorrect");
 			NullCheck(mpLogFile, VS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_GammaCorrect]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"GammaCorrection.PS_GammaCorrect");
 			NullCheck(mpLogFile, PS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -0,0 +1,476 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Shading/GpuCulling.hpp"
+#include "Common/Debug/Logger.hpp"
+#include "Render/DX/Foundation/Resource/GpuResource.hpp"
+#include "Render/DX/Foundation/Core/Device.hpp"
+#include "Render/DX/Foundation/Core/CommandObject.hpp"
+#include "Render/DX/Foundation/Core/DescriptorHeap.hpp"
+#include "Render/DX/Foundation/Resource/FrameResource.hpp"
+#include "Render/DX/Foundation/Util/D3D12Util.hpp"
+#include "Render/DX/Shading/Util/ShaderManager.hpp"
+#include "Render/DX/Shading/Util/SamplerUtil.hpp"
+
+using namespace Render::DX::Shading;
+
+namespace {
+	const UINT CommandByteStride = sizeof(ShadingConvention::GBuffer::IndirectCommand);
+}
+
+GpuCulling::InitDataPtr GpuCulling::MakeInitData() {
+	return std::unique_ptr<GpuCullingClass::InitData>(new GpuCullingClass::InitData());
+}
+
+GpuCulling::GpuCullingClass::GpuCullingClass() {
+	mHiZMap = std::make_unique<Foundation::Resource::GpuResource>();
+	mCommandBuffer = std::make_unique<Foundation::Resource::GpuResource>();
+	mCommandCountBuffer = std::make_unique<Foundation::Resource::GpuResource>();
+}
+
+GpuCulling::GpuCullingClass::~GpuCullingClass() { CleanUp(); }
+
+UINT GpuCulling::GpuCullingClass::CbvSrvUavDescCount() const { return 1 // HiZMap
+	+ ShadingConvention::GpuCulling::MaxHiZMipCount // HiZMap mips
+	;
+}
+
+UINT GpuCulling::GpuCullingClass::RtvDescCount() const { return 0; }
+
+UINT GpuCulling::GpuCullingClass::DsvDescCount() const { return 0; }
+
+BOOL GpuCulling::GpuCullingClass::Initialize(Common::Debug::LogFile* const pLogFile, void* const pData) {
+	CheckReturn(pLogFile, Foundation::ShadingObject::Initialize(pLogFile, pData));
+
+	const auto initData = reinterpret_cast<InitData*>(pData);
+	mInitData = *initData;
+
+	CheckReturn(mpLogFile, BuildResources());
+
+	// Command records and their count
+	{
+		CheckReturn(mpLogFile, mCommandBuffer->Initialize(
+			mInitData.Device,
+			&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+			D3D12_HEAP_FLAG_NONE,
+			&CD3DX12_RESOURCE_DESC::Buffer(
+				static_cast<UINT64>(mInitData.MaxInstanceCount) * CommandByteStride,
+				D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS),
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			L"GpuCulling_CommandBuffer"));
+
+		CheckReturn(mpLogFile, mCommandCountBuffer->Initialize(
+			mInitData.Device,
+			&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+			D3D12_HEAP_FLAG_NONE,
+			&CD3DX12_RESOURCE_DESC::Buffer(sizeof(UINT), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS),
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			L"GpuCulling_CommandCountBuffer"));
+
+		Foundation::Util::D3D12Util::D3D12BufferCreateInfo zeroInfo(
+			sizeof(UINT), D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateBuffer(
+			mInitData.Device, zeroInfo, IID_PPV_ARGS(&mZeroBuffer)));
+		CheckHRESULT(mpLogFile, mZeroBuffer->SetName(L"GpuCulling_ZeroBuffer"));
+
+		void* mapped{};
+		CheckHRESULT(mpLogFile, mZeroBuffer->Map(0, nullptr, &mapped));
+		std::memset(mapped, 0, sizeof(UINT));
+		mZeroBuffer->Unmap(0, nullptr);
+	}
+	// Identity instance list
+	{
+		Foundation::Util::D3D12Util::D3D12BufferCreateInfo info(
+			static_cast<UINT64>(mInitData.MaxInstanceCount) * sizeof(UINT), 
+			D3D12_HEAP_TYPE_UPLOAD, 
+			D3D12_RESOURCE_STATE_GENERIC_READ);
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateBuffer(
+			mInitData.Device, info, IID_PPV_ARGS(&mInstanceIndexBuffer)));
+		CheckHRESULT(mpLogFile, mInstanceIndexBuffer->SetName(L"GpuCulling_InstanceIndexBuffer"));
+
+		UINT* mapped{};
+		CheckHRESULT(mpLogFile, mInstanceIndexBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mapped)));
+		for (UINT i = 0; i < mInitData.MaxInstanceCount; ++i)
+			mapped[i] = i;
+		mInstanceIndexBuffer->Unmap(0, nullptr);
+	}
+
+	return TRUE;
+}
+
+void GpuCulling::GpuCullingClass::CleanUp() {
+	if (mbCleanedUp) return;
+
+	if (mInstanceIndexBuffer) mInstanceIndexBuffer.Reset();
+	if (mZeroBuffer) mZeroBuffer.Reset();
+	if (mCommandCountBuffer) mCommandCountBuffer.reset();
+	if (mCommandBuffer) mCommandBuffer.reset();
+	if (mHiZMap) mHiZMap.reset();
+
+	for (UINT i = 0; i < PipelineState::Count; ++i)
+		mPipelineStates[i].Reset();
+
+	for (UINT i = 0; i < RootSignature::Count; ++i)
+		mRootSignatures[i].Reset();
+
+	mbCleanedUp = TRUE;
+}
+
+BOOL GpuCulling::GpuCullingClass::BuildRootSignatures() {
+	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
+
+	// BuildHiZ
+	{
+		CD3DX12_DESCRIPTOR_RANGE texTables[3]{}; UINT index = 0;
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0, 0);
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 1, 0);
+
+		index = 0;
+
+		CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::BuildHiZ::Count]{};
+		slotRootParameter[RootSignature::BuildHiZ::RC_Consts]
+			.InitAsConstants(ShadingConvention::GpuCulling::RootConstant::BuildHiZ::Count, 0);
+		slotRootParameter[RootSignature::BuildHiZ::SI_DepthMap]
+			.InitAsDescriptorTable(1, &texTables[index++]);
+		slotRootParameter[RootSignature::BuildHiZ::UI_SrcMip]
+			.InitAsDescriptorTable(1, &texTables[index++]);
+		slotRootParameter[RootSignature::BuildHiZ::UO_DstMip]
+			.InitAsDescriptorTable(1, &texTables[index++]);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
+			_countof(slotRootParameter), slotRootParameter,
+			Util::StaticSamplerCount, samplers,
+			D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateRootSignature(
+			mInitData.Device,
+			rootSigDesc,
+			IID_PPV_ARGS(&mRootSignatures[RootSignature::GR_BuildHiZ]),
+			L"GpuCulling_GR_BuildHiZ"));
+	}
+	// CullInstances
+	{
+		CD3DX12_DESCRIPTOR_RANGE texTables[1]{}; UINT index = 0;
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 2, 0);
+
+		index = 0;
+
+		CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::CullInstances::Count]{};
+		slotRootParameter[RootSignature::CullInstances::CB_Pass]
+			.InitAsConstantBufferView(0);
+		slotRootParameter[RootSignature::CullInstances::RC_Consts]
+			.InitAsConstants(ShadingConvention::GpuCulling::RootConstant::CullInstances::Count, 1);
+		slotRootParameter[RootSignature::CullInstances::SI_InstanceBounds]
+			.InitAsShaderResourceView(0);
+		slotRootParameter[RootSignature::CullInstances::SI_Commands]
+			.InitAsShaderResourceView(1);
+		slotRootParameter[RootSignature::CullInstances::SI_HiZMap]
+			.InitAsDescriptorTable(1, &texTables[index++]);
+		slotRootParameter[RootSignature::CullInstances::UO_Commands]
+			.InitAsUnorderedAccessView(0);
+		slotRootParameter[RootSignature::CullInstances::UO_CommandCount]
+			.InitAsUnorderedAccessView(1);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
+			_countof(slotRootParameter), slotRootParameter,
+			Util::StaticSamplerCount, samplers,
+			D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateRootSignature(
+			mInitData.Device,
+			rootSigDesc,
+			IID_PPV_ARGS(&mRootSignatures[RootSignature::GR_CullInstances]),
+			L"GpuCulling_GR_CullInstances"));
+	}
+
+	return TRUE;
+}
+
+BOOL GpuCulling::GpuCullingClass::BuildPipelineStates() {
+	// CopyDepth
+	{
+		D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
+		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_BuildHiZ].Get();
+		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+		{
+			const auto CS = mInitData.ShaderManager->GetShader(L"GpuCulling.CS_CopyDepth");
+			NullCheck(mpLogFile, CS);
+			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
+		}
+
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateComputePipelineState(
+			mInitData.Device,
+			psoDesc,
+			IID_PPV_ARGS(&mPipelineStates[PipelineState::CP_CopyDepth]),
+			L"GpuCulling_CP_CopyDepth"));
+	}
+	// DownsampleHiZ
+	{
+		D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
+		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_BuildHiZ].Get();
+		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+		{
+			const auto CS = mInitData.ShaderManager->GetShader(L"GpuCulling.CS_DownsampleHiZ");
+			NullCheck(mpLogFile, CS);
+			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
+		}
+
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateComputePipelineState(
+			mInitData.Device,
+			psoDesc,
+			IID_PPV_ARGS(&mPipelineStates[PipelineState::CP_DownsampleHiZ]),
+			L"GpuCulling_CP_DownsampleHiZ"));
+	}
+	// CullInstances
+	{
+		D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
+		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_CullInstances].Get();
+		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+		{
+			const auto CS = mInitData.ShaderManager->GetShader(L"GpuCulling.CS_CullInstances");
+			NullCheck(mpLogFile, CS);
+			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
+		}
+
+		CheckReturn(mpLogFile, Foundation::Util::D3D12Util::CreateComputePipelineState(
+			mInitData.Device,
+			psoDesc,
+			IID_PPV_ARGS(&mPipelineStates[PipelineState::CP_CullInstances]),
+			L"GpuCulling_CP_CullInstances"));
+	}
+
+	return TRUE;
+}
+
+BOOL GpuCulling::GpuCullingClass::BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) {
+	mhHiZMapCpuSrv = pDescHeap->CbvSrvUavCpuOffset(1);
+	mhHiZMapGpuSrv = pDescHeap->CbvSrvUavGpuOffset(1);
+
+	for (UINT i = 0; i < ShadingConvention::GpuCulling::MaxHiZMipCount; ++i) {
+		mhHiZMipCpuUavs[i] = pDescHeap->CbvSrvUavCpuOffset(1);
+		mhHiZMipGpuUavs[i] = pDescHeap->CbvSrvUavGpuOffset(1);
+	}
+
+	CheckReturn(mpLogFile, BuildDescriptors());
+
+	return TRUE;
+}
+
+BOOL GpuCulling::GpuCullingClass::OnResize(UINT width, UINT height) {
+	mInitData.ClientWidth = width;
+	mInitData.ClientHeight = height;
+
+	CheckReturn(mpLogFile, BuildResources());
+	CheckReturn(mpLogFile, BuildDescriptors());
+
+	return TRUE;
+}
+
+BOOL GpuCulling::GpuCullingClass::CullInstances(
+		Foundation::Resource::FrameResource* const pFrameResource,
+		UINT instanceCount,
+		BOOL occlusionEnabled) {
+	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
+		pFrameResource->CommandAllocator(0),
+		0,
+		mPipelineStates[PipelineState::CP_CullInstances].Get()));
+
+	const auto CmdList = mInitData.CommandObject->CommandList(0);
+	mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
+
+	{
+		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_CullInstances].Get());
+
+		mCommandCountBuffer->Transite(CmdList, D3D12_RESOURCE_STATE_COPY_DEST);
+		CmdList->CopyBufferRegion(mCommandCountBuffer->Resource(), 0, mZeroBuffer.Get(), 0, sizeof(UINT));
+
+		mCommandCountBuffer->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		mCommandBuffer->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		mHiZMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+		CmdList->SetComputeRootConstantBufferView(
+			RootSignature::CullInstances::CB_Pass, pFrameResource->MainPassCB.CBAddress());
+
+		ShadingConvention::GpuCulling::RootConstant::CullInstances::Struct rc;
+		rc.gInstanceCount = std::min(instanceCount, mInitData.MaxInstanceCount);
+		rc.gCommandByteStride = CommandByteStride;
+		rc.gHiZTexDim = { mHiZWidth, mHiZHeight };
+		rc.gHiZMipCount = mHiZMipCount;
+		rc.gOcclusionEnabled = occlusionEnabled && mbHiZValid;
+
+		std::array<std::uint32_t, ShadingConvention::GpuCulling::RootConstant::CullInstances::Count> consts;
+		std::memcpy(consts.data(), &rc, sizeof(ShadingConvention::GpuCulling::RootConstant::CullInstances::Struct));
+
+		Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::GpuCulling::RootConstant::CullInstances::Struct>(
+			RootSignature::CullInstances::RC_Consts,
+			ShadingConvention::GpuCulling::RootConstant::CullInstances::Count,
+			consts.data(),
+			0,
+			CmdList,
+			TRUE);
+
+		CmdList->SetComputeRootShaderResourceView(
+			RootSignature::CullInstances::SI_InstanceBounds, pFrameResource->InstanceBounds.CBAddress());
+		CmdList->SetComputeRootShaderResourceView(
+			RootSignature::CullInstances::SI_Commands, pFrameResource->IndirectCommands.CBAddress());
+		CmdList->SetComputeRootDescriptorTable(
+			RootSignature::CullInstances::SI_HiZMap, mhHiZMapGpuSrv);
+		CmdList->SetComputeRootUnorderedAccessView(
+			RootSignature::CullInstances::UO_Commands, mCommandBuffer->Resource()->GetGPUVirtualAddress());
+		CmdList->SetComputeRootUnorderedAccessView(
+			RootSignature::CullInstances::UO_CommandCount, mCommandCountBuffer->Resource()->GetGPUVirtualAddress());
+
+		if (rc.gInstanceCount > 0) {
+			CmdList->Dispatch(
+				Foundation::Util::D3D12Util::CeilDivide(
+					rc.gInstanceCount, ShadingConvention::GpuCulling::ThreadGroup::CullInstances::Width),
+				ShadingConvention::GpuCulling::ThreadGroup::CullInstances::Height,
+				ShadingConvention::GpuCulling::ThreadGroup::CullInstances::Depth);
+		}
+	}
+
+	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandList(0));
+
+	return TRUE;
+}
+
+BOOL GpuCulling::GpuCullingClass::BuildHiZ(
+		Foundation::Resource::FrameResource* const pFrameResource,
+		Foundation::Resource::GpuResource* const pDepthMap,
+		D3D12_GPU_DESCRIPTOR_HANDLE si_depthMap) {
+	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
+		pFrameResource->CommandAllocator(0),
+		0,
+		mPipelineStates[PipelineState::CP_CopyDepth].Get()));
+
+	const auto CmdList = mInitData.CommandObject->CommandList(0);
+	mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
+
+	{
+		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_BuildHiZ].Get());
+
+		pDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		mHiZMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+		CmdList->SetComputeRootDescriptorTable(RootSignature::BuildHiZ::SI_DepthMap, si_depthMap);
+
+		// Only the area rendered into is reduced; the next frame's test maps
+		// onto it through the dimensions recorded here.
+		mHiZWidth = mRenderWidth;
+		mHiZHeight = mRenderHeight;
+
+		UINT srcWidth = mHiZWidth;
+		UINT srcHeight = mHiZHeight;
+
+		for (UINT mip = 0; mip < mHiZMipCount; ++mip) {
+			const UINT DstWidth = std::max(1u, mHiZWidth >> mip);
+			const UINT DstHeight = std::max(1u, mHiZHeight >> mip);
+
+			// Mip 0 mirrors the depth buffer; every other mip reduces the
+			// one above it.
+			if (mip == 1) CmdList->SetPipelineState(mPipelineStates[PipelineState::CP_DownsampleHiZ].Get());
+			if (mip > 0) Foundation::Util::D3D12Util::UavBarrier(CmdList, mHiZMap.get());
+
+			ShadingConvention::GpuCulling::RootConstant::BuildHiZ::Struct rc;
+			rc.gSrcTexDim = { srcWidth, srcHeight };
+			rc.gDstTexDim = { DstWidth, DstHeight };
+
+			std::array<std::uint32_t, ShadingConvention::GpuCulling::RootConstant::BuildHiZ::Count> consts;
+			std::memcpy(consts.data(), &rc, sizeof(ShadingConvention::GpuCulling::RootConstant::BuildHiZ::Struct));
+
+			Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::GpuCulling::RootConstant::BuildHiZ::Struct>(
+				RootSignature::BuildHiZ::RC_Consts,
+				ShadingConvention::GpuCulling::RootConstant::BuildHiZ::Count,
+				consts.data(),
+				0,
+				CmdList,
+				TRUE);
+
+			CmdList->SetComputeRootDescriptorTable(
+				RootSignature::BuildHiZ::UI_SrcMip, mhHiZMipGpuUavs[mip == 0 ? 0 : mip - 1]);
+			CmdList->SetComputeRootDescriptorTable(
+				RootSignature::BuildHiZ::UO_DstMip, mhHiZMipGpuUavs[mip]);
+
+			CmdList->Dispatch(
+				Foundation::Util::D3D12Util::CeilDivide(
+					DstWidth, ShadingConvention::GpuCulling::ThreadGroup::BuildHiZ::Width),
+				Foundation::Util::D3D12Util::CeilDivide(
+					DstHeight, ShadingConvention::GpuCulling::ThreadGroup::BuildHiZ::Height),
+				ShadingConvention::GpuCulling::ThreadGroup::BuildHiZ::Depth);
+
+			srcWidth = DstWidth;
+			srcHeight = DstHeight;
+		}
+	}
+
+	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandList(0));
+
+	mbHiZValid = TRUE;
+
+	return TRUE;
+}
+
+BOOL GpuCulling::GpuCullingClass::BuildResources() {
+	const UINT LargerDim = std::max(mInitData.ClientWidth, mInitData.ClientHeight);
+
+	mHiZMipCount = 1;
+	while ((LargerDim >> mHiZMipCount) > 0 && mHiZMipCount < ShadingConvention::GpuCulling::MaxHiZMipCount)
+		++mHiZMipCount;
+
+	D3D12_RESOURCE_DESC texDesc;
+	ZeroMemory(&texDesc, sizeof(D3D12_RESOURCE_DESC));
+	texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	texDesc.Width = mInitData.ClientWidth;
+	texDesc.Height = mInitData.ClientHeight;
+	texDesc.Alignment = 0;
+	texDesc.DepthOrArraySize = 1;
+	texDesc.MipLevels = static_cast<UINT16>(mHiZMipCount);
+	texDesc.SampleDesc.Count = 1;
+	texDesc.SampleDesc.Quality = 0;
+	texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	texDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+	texDesc.Format = ShadingConvention::GpuCulling::HiZMapFormat;
+
+	CheckReturn(mpLogFile, mHiZMap->Initialize(
+		mInitData.Device,
+		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+		D3D12_HEAP_FLAG_NONE,
+		&texDesc,
+		D3D12_RESOURCE_STATE_COMMON,
+		nullptr,
+		L"GpuCulling_HiZMap"));
+
+	// The new pyramid holds no depth until the next BuildHiZ.
+	mbHiZValid = FALSE;
+
+	return TRUE;
+}
+
+BOOL GpuCulling::GpuCullingClass::BuildDescriptors() {
+	const auto resource = mHiZMap->Resource();
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Format = ShadingConvention::GpuCulling::HiZMapFormat;
+	srvDesc.Texture2D.MostDetailedMip = 0;
+	srvDesc.Texture2D.MipLevels = mHiZMipCount;
+
+	Foundation::Util::D3D12Util::CreateShaderResourceView(
+		mInitData.Device, resource, &srvDesc, mhHiZMapCpuSrv);
+
+	D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+	uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+	uavDesc.Format = ShadingConvention::GpuCulling::HiZMapFormat;
+	uavDesc.Texture2D.PlaneSlice = 0;
+
+	for (UINT mip = 0; mip < mHiZMipCount; ++mip) {
+		uavDesc.Texture2D.MipSlice = mip;
+
+		Foundation::Util::D3D12Util::CreateUnorderedAccessView(
+			mInitData.Device, resource, nullptr, &uavDesc, mhHiZMipCpuUavs[mip]);
+	}
+
+	return TRUE;
+}
\ No newline at end of file
@@ -12,10 +12,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_MotionBlur = L"MotionBlur.hlsl";
-}
-
 MotionBlur::InitDataPtr MotionBlur::MakeInitData() {
 	return std::unique_ptr<MotionBlurClass::InitData>(new MotionBlurClass::InitData());
 }
@@ -51,19 +47,6 @@ void MotionBlur::MotionBlurClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL MotionBlur::MotionBlurClass::CompileShaders() {
-	const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_MotionBlur, L"VS", L"vs_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_MotionBlur]));
-
-	const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_MotionBlur, L"MS", L"ms_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_MotionBlur]));
-
-	const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_MotionBlur, L"PS", L"ps_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_MotionBlur]));
-
-	return TRUE;
-}
-
 BOOL MotionBlur::MotionBlurClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -100,9 +83,9 @@ BOOL MotionBlur::MotionBlurClass::BuildPipelineStates() {
 		auto psoDesc = Foundation::Util::D3D12Util::FitToScreenMeshPsoDesc();
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
-			const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_MotionBlur]);
+			const auto MS = mInitData.ShaderManager->GetShader(L"MotionBlur.MS_MotionBlur");
 			NullCheck(mpLogFile, MS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_MotionBlur]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"MotionBlur.PS_MotionBlur");
 			NullCheck(mpLogFile, PS);
 			psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -120,9 +103,9 @@ BOOL MotionBlur::MotionBlurClass::BuildPipelineStates() {
 		auto psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_MotionBlur]);
+			const auto VS = mInitData.ShaderManager->GetShader(L"MotionBlur.VS_MotionBlur");
 			NullCheck(mpLogFile, VS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_MotionBlur]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"MotionBlur.PS_MotionBlur");
 			NullCheck(mpLogFile, PS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -184,6 +167,7 @@ BOOL MotionBlur::MotionBlurClass::ApplyMotionBlur(
 		rc.gLimit = limit;
 		rc.gDepthBias = depthBias;
 		rc.gSampleCount = sampleCount;
+		rc.gUVScale = mUVScale;
 
 		Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::MotionBlur::RootConstant::Default::Struct>(
 			RootSignature::Default::RC_Consts,
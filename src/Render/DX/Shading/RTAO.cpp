@@ -16,8 +16,6 @@ using namespace Render::DX::Shading;
 using namespace DirectX;
 
 namespace {
-	const WCHAR* const HLSL_RTAO				= L"RTAO.hlsl";
-
 	const WCHAR* const RTAO_RayGenName			= L"RTAO_RayGen";
 	const WCHAR* const RTAO_RayGenRaySortedName = L"RTAO_RayGen_RaySorted";
 	const WCHAR* const RTAO_ClosestHitName		= L"RTAO_ClosestHit";
@@ -102,15 +100,6 @@ void RTAO::RTAOClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL RTAO::RTAOClass::CompileShaders() {
-	const auto Lib = Util::ShaderManager::D3D12ShaderInfo(
-		HLSL_RTAO, L"", L"lib_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-		Lib, mShaderHashes[Shader::Lib_RTAO]));
-
-	return TRUE;
-}
-
 BOOL RTAO::RTAOClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -158,7 +147,7 @@ BOOL RTAO::RTAOClass::BuildPipelineStates() {
 
 	// RTAO-Library
 	const auto rtaoLib = rtaoStateObject.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
-	const auto rtaoShader = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::Lib_RTAO]);
+	const auto rtaoShader = mInitData.ShaderManager->GetShader(L"RTAO.Lib_RTAO");
 	const D3D12_SHADER_BYTECODE rtaoLibDxil = CD3DX12_SHADER_BYTECODE(rtaoShader->GetBufferPointer(), rtaoShader->GetBufferSize());
 	rtaoLib->SetDXILLibrary(&rtaoLibDxil);
 	LPCWSTR rtaoExports[] = { RTAO_RayGenName, RTAO_RayGenRaySortedName, RTAO_ClosestHitName, RTAO_MissName };
@@ -204,6 +193,16 @@ BOOL RTAO::RTAOClass::BuildDescriptors(Foundation::Core::DescriptorHeap* const p
 		mhAOResourceGpus[Descriptor::AO::ES_RayHitDistance] = pDescHeap->CbvSrvUavGpuOffset(1);
 		mhAOResourceCpus[Descriptor::AO::EU_RayHitDistance] = pDescHeap->CbvSrvUavCpuOffset(1);
 		mhAOResourceGpus[Descriptor::AO::EU_RayHitDistance] = pDescHeap->CbvSrvUavGpuOffset(1);
+		// HalfResAOCoefficient
+		mhAOResourceCpus[Descriptor::AO::ES_HalfResAOCoefficient] = pDescHeap->CbvSrvUavCpuOffset(1);
+		mhAOResourceGpus[Descriptor::AO::ES_HalfResAOCoefficient] = pDescHeap->CbvSrvUavGpuOffset(1);
+		mhAOResourceCpus[Descriptor::AO::EU_HalfResAOCoefficient] = pDescHeap->CbvSrvUavCpuOffset(1);
+		mhAOResourceGpus[Descriptor::AO::EU_HalfResAOCoefficient] = pDescHeap->CbvSrvUavGpuOffset(1);
+		// HalfResRayHitDistance
+		mhAOResourceCpus[Descriptor::AO::ES_HalfResRayHitDistance] = pDescHeap->CbvSrvUavCpuOffset(1);
+		mhAOResourceGpus[Descriptor::AO::ES_HalfResRayHitDistance] = pDescHeap->CbvSrvUavGpuOffset(1);
+		mhAOResourceCpus[Descriptor::AO::EU_HalfResRayHitDistance] = pDescHeap->CbvSrvUavCpuOffset(1);
+		mhAOResourceGpus[Descriptor::AO::EU_HalfResRayHitDistance] = pDescHeap->CbvSrvUavGpuOffset(1);
 	}
 	// TemporalCache
 	for (UINT frame = 0; frame < 2; ++frame) {
@@ -379,6 +378,41 @@ BOOL RTAO::RTAOClass::BuildResources() {
 				L"RTAO_RayHitDistanceMap"));
 		}
 	}
+	// HalfResAO
+	{
+		texDesc.Width = Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientWidth, 2);
+		texDesc.Height = Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientHeight, 2);
+
+		// HalfResAOCoefficientMap
+		{
+			texDesc.Format = ShadingConvention::RTAO::AOCoefficientMapFormat;
+
+			CheckReturn(mpLogFile, mAOResources[Resource::AO::E_HalfResAOCoefficient]->Initialize(
+				mInitData.Device,
+				&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+				D3D12_HEAP_FLAG_NONE,
+				&texDesc,
+				D3D12_RESOURCE_STATE_COMMON,
+				nullptr,
+				L"RTAO_HalfResAOCoefficientMap"));
+		}
+		// HalfResRayHitDistanceMap
+		{
+			texDesc.Format = ShadingConvention::RTAO::RayHitDistanceMapFormat;
+
+			CheckReturn(mpLogFile, mAOResources[Resource::AO::E_HalfResRayHitDistance]->Initialize(
+				mInitData.Device,
+				&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+				D3D12_HEAP_FLAG_NONE,
+				&texDesc,
+				D3D12_RESOURCE_STATE_COMMON,
+				nullptr,
+				L"RTAO_HalfResRayHitDistanceMap"));
+		}
+
+		texDesc.Width = mInitData.ClientWidth;
+		texDesc.Height = mInitData.ClientHeight;
+	}
 	for (UINT frame = 0; frame < 2; ++frame) {
 		// TemporalCache
 		{
@@ -497,6 +531,24 @@ BOOL RTAO::RTAOClass::BuildDescriptors() {
 			Foundation::Util::D3D12Util::CreateShaderResourceView(mInitData.Device, resource, &srvDesc, mhAOResourceCpus[Descriptor::AO::ES_RayHitDistance]);
 			Foundation::Util::D3D12Util::CreateUnorderedAccessView(mInitData.Device, resource, nullptr , &uavDesc, mhAOResourceCpus[Descriptor::AO::EU_RayHitDistance]);
 		}
+		// HalfResAOCoefficientMap
+		{
+			srvDesc.Format = ShadingConvention::RTAO::AOCoefficientMapFormat;
+			uavDesc.Format = ShadingConvention::RTAO::AOCoefficientMapFormat;
+
+			const auto resource = mAOResources[Resource::AO::E_HalfResAOCoefficient]->Resource();
+			Foundation::Util::D3D12Util::CreateShaderResourceView(mInitData.Device, resource, &srvDesc, mhAOResourceCpus[Descriptor::AO::ES_HalfResAOCoefficient]);
+			Foundation::Util::D3D12Util::CreateUnorderedAccessView(mInitData.Device, resource, nullptr, &uavDesc, mhAOResourceCpus[Descriptor::AO::EU_HalfResAOCoefficient]);
+		}
+		// HalfResRayHitDistanceMap
+		{
+			srvDesc.Format = ShadingConvention::RTAO::RayHitDistanceMapFormat;
+			uavDesc.Format = ShadingConvention::RTAO::RayHitDistanceMapFormat;
+
+			const auto resource = mAOResources[Resource::AO::E_HalfResRayHitDistance]->Resource();
+			Foundation::Util::D3D12Util::CreateShaderResourceView(mInitData.Device, resource, &srvDesc, mhAOResourceCpus[Descriptor::AO::ES_HalfResRayHitDistance]);
+			Foundation::Util::D3D12Util::CreateUnorderedAccessView(mInitData.Device, resource, nullptr, &uavDesc, mhAOResourceCpus[Descriptor::AO::EU_HalfResRayHitDistance]);
+		}
 	}
 	for (UINT frame = 0; frame < 2; ++frame) {
 		// TemporalCache
@@ -562,7 +614,8 @@ BOOL RTAO::RTAOClass::DrawAO(
 		Foundation::Resource::GpuResource* const pRayInexOffsetMap,
 		D3D12_GPU_DESCRIPTOR_HANDLE si_rayIndexOffsetMap,
 		BOOL bRaySortingEnabled,
-		BOOL bCheckboardRayGeneration) {
+		BOOL bCheckboardRayGeneration,
+		BOOL bHalfResolutionEnabled) {
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
 		0,
@@ -575,11 +628,13 @@ BOOL RTAO::RTAOClass::DrawAO(
 		CmdList->SetPipelineState1(mStateObject.Get());
 		CmdList->SetComputeRootSignature(mRootSignature.Get());
 
-		const auto& ao = mAOResources[RTAO::Resource::AO::E_AOCoefficient].get();
+		const auto& ao = mAOResources[bHalfResolutionEnabled ?
+			RTAO::Resource::AO::E_HalfResAOCoefficient : RTAO::Resource::AO::E_AOCoefficient].get();
 		ao->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, ao);
 
-		const auto& rayHitDist = mAOResources[RTAO::Resource::AO::E_RayHitDistance].get();
+		const auto& rayHitDist = mAOResources[bHalfResolutionEnabled ?
+			RTAO::Resource::AO::E_HalfResRayHitDistance : RTAO::Resource::AO::E_RayHitDistance].get();
 		rayHitDist->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, rayHitDist);
 
@@ -587,9 +642,9 @@ BOOL RTAO::RTAOClass::DrawAO(
 		debugMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, debugMap);
 
-		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pRayDirectionOriginDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pRayDirectionOriginDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 		CmdList->SetComputeRootShaderResourceView(
 			RootSignature::SI_AccelerationStructure, accelStruct);
@@ -604,9 +659,11 @@ BOOL RTAO::RTAOClass::DrawAO(
 		CmdList->SetComputeRootDescriptorTable(
 			RootSignature::SI_RayIndexOffsetMap, si_rayIndexOffsetMap);
 		CmdList->SetComputeRootDescriptorTable(
-			RootSignature::UO_AOCoefficientMap, mhAOResourceGpus[RTAO::Descriptor::AO::EU_AOCoefficient]);
+			RootSignature::UO_AOCoefficientMap, mhAOResourceGpus[bHalfResolutionEnabled ?
+				RTAO::Descriptor::AO::EU_HalfResAOCoefficient : RTAO::Descriptor::AO::EU_AOCoefficient]);
 		CmdList->SetComputeRootDescriptorTable(
-			RootSignature::UO_RayHitDistanceMap, mhAOResourceGpus[RTAO::Descriptor::AO::EU_RayHitDistance]);
+			RootSignature::UO_RayHitDistanceMap, mhAOResourceGpus[bHalfResolutionEnabled ?
+				RTAO::Descriptor::AO::EU_HalfResRayHitDistance : RTAO::Descriptor::AO::EU_RayHitDistance]);
 		CmdList->SetComputeRootDescriptorTable(
 			RootSignature::UO_DebugMap, mhDebugMapGpuUav);
 
@@ -624,19 +681,21 @@ BOOL RTAO::RTAOClass::DrawAO(
 		dispatchDesc.HitGroupTable.SizeInBytes = hitGroup->GetDesc().Width;
 		dispatchDesc.HitGroupTable.StrideInBytes = mHitGroupShaderTableStrideInBytes;
 		
-		if (bRaySortingEnabled) {
-			const UINT ActvieWidth =
-				bCheckboardRayGeneration ?
-				Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientWidth, 2)
-				: mInitData.ClientWidth;
+		// One ray per evaluated pixel.
+		const UINT PixelStepX = bCheckboardRayGeneration || bHalfResolutionEnabled ? 2 : 1;
+		const UINT PixelStepY = bHalfResolutionEnabled ? 2 : 1;
 
-			dispatchDesc.Width = ActvieWidth * mInitData.ClientHeight;
+		const UINT ActvieWidth = Foundation::Util::D3D12Util::CeilDivide(mRenderWidth, PixelStepX);
+		const UINT ActvieHeight = Foundation::Util::D3D12Util::CeilDivide(mRenderHeight, PixelStepY);
+
+		if (bRaySortingEnabled) {
+			dispatchDesc.Width = ActvieWidth * ActvieHeight;
 			dispatchDesc.Height = 1;
 			dispatchDesc.Depth = 1;
 		}
 		else {
-			dispatchDesc.Width = mInitData.ClientWidth;
-			dispatchDesc.Height = mInitData.ClientHeight;
+			dispatchDesc.Width = ActvieWidth;
+			dispatchDesc.Height = ActvieHeight;
 			dispatchDesc.Depth = 1;
 		}
 		
@@ -18,7 +18,6 @@ using namespace DirectX;
 namespace {
 	const UINT gcNumSampleSets = 83;
 
-	const WCHAR* const HLSL_RayGen = L"RayGen.hlsl";
 }
 
 RayGen::InitDataPtr RayGen::MakeInitData() {
@@ -91,13 +90,6 @@ void RayGen::RayGenClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL RayGen::RayGenClass::CompileShaders() {
-	const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_RayGen, L"CS", L"cs_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_RayGen]));
-
-	return TRUE;
-}
-
 BOOL RayGen::RayGenClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -137,7 +129,7 @@ BOOL RayGen::RayGenClass::BuildPipelineStates() {
 	psoDesc.pRootSignature = mRootSignature.Get();
 	psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 	{
-		const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_RayGen]);
+		const auto CS = mInitData.ShaderManager->GetShader(L"RayGen.CS_RayGen");
 		NullCheck(mpLogFile, CS);
 		psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 	}
@@ -207,7 +199,8 @@ BOOL RayGen::RayGenClass::GenerateRays(
 		D3D12_GPU_DESCRIPTOR_HANDLE si_normalDepthMap,
 		Foundation::Resource::GpuResource* const pPositionMap,
 		D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
-		BOOL bCheckboardRayGeneration) {
+		BOOL bCheckboardRayGeneration,
+		BOOL bHalfResolutionEnabled) {
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
 		0,
@@ -223,8 +216,8 @@ BOOL RayGen::RayGenClass::GenerateRays(
 			RootSignature::Default::CB_RayGen, 
 			pFrameResource->RayGenCB.CBAddress());
 	
-		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 	
 		mRayDirectionOriginDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, mRayDirectionOriginDepthMap.get());
@@ -245,14 +238,15 @@ BOOL RayGen::RayGenClass::GenerateRays(
 		CmdList->SetComputeRootDescriptorTable(
 			RootSignature::Default::UO_DebugMap, mhDebugMapGpuUav);
 
-		const UINT ActvieWidth = 
-			bCheckboardRayGeneration ? 
-			Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientWidth, 2) 
-			: mInitData.ClientWidth;
+		const UINT PixelStepX = bCheckboardRayGeneration || bHalfResolutionEnabled ? 2 : 1;
+		const UINT PixelStepY = bHalfResolutionEnabled ? 2 : 1;
+
+		const UINT ActvieWidth = Foundation::Util::D3D12Util::CeilDivide(mRenderWidth, PixelStepX);
+		const UINT ActvieHeight = Foundation::Util::D3D12Util::CeilDivide(mRenderHeight, PixelStepY);
 	
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(ActvieWidth, ShadingConvention::RayGen::ThreadGroup::Default::Width),
-			Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientHeight, ShadingConvention::RayGen::ThreadGroup::Default::Height),
+			Foundation::Util::D3D12Util::CeilDivide(ActvieHeight, ShadingConvention::RayGen::ThreadGroup::Default::Height),
 			ShadingConvention::RayGen::ThreadGroup::Default::Depth);
 	}
 
@@ -13,10 +13,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_CountingSort_Rays_64x128 = L"CountingSort_Rays_64x128.hlsl";
-}
-
 RaySorting::InitDataPtr RaySorting::MakeInitData() {
 	return std::unique_ptr<RaySortingClass::InitData>(new RaySortingClass::InitData());
 }
@@ -55,13 +51,6 @@ void RaySorting::RaySortingClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL RaySorting::RaySortingClass::CompileShaders() {
-	const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_CountingSort_Rays_64x128, L"CS", L"cs_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_CountingSort]));
-
-	return TRUE;
-}
-
 BOOL RaySorting::RaySortingClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -95,7 +84,7 @@ BOOL RaySorting::RaySortingClass::BuildPipelineStates() {
 	psoDesc.pRootSignature = mRootSignature.Get();
 	psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 	{
-		const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_CountingSort]);
+		const auto CS = mInitData.ShaderManager->GetShader(L"RaySorting.CS_CountingSort");
 		NullCheck(mpLogFile, CS);
 		psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 	}
@@ -145,7 +134,7 @@ BOOL RaySorting::RaySortingClass::CalcRayIndexOffset(
 	{
 		CmdList->SetComputeRootSignature(mRootSignature.Get());
 		
-		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 		mRayIndexOffsetMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, mRayIndexOffsetMap.get());
@@ -159,16 +148,19 @@ BOOL RaySorting::RaySortingClass::CalcRayIndexOffset(
 		CmdList->SetComputeRootDescriptorTable(
 			RootSignature::Default::UO_RayIndexOffsetMap, mhRayIndexOffsetMapGpuUav);
 		
-		const UINT ActvieWidth =
-			mInitData.ShadingArgumentSet->RTAO.CheckboardRayGeneration ?
-			Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientWidth, 2)
-			: mInitData.ClientWidth;
+		const UINT ResolutionType = mInitData.ShadingArgumentSet->RTAO.ResolutionType;
+		const BOOL HalfResolutionEnabled = ResolutionType == Common::Render::EffectResolution::E_HalfResolution;
+		const UINT PixelStepX = ResolutionType == Common::Render::EffectResolution::E_FullResolution ? 1 : 2;
+		const UINT PixelStepY = HalfResolutionEnabled ? 2 : 1;
+
+		const UINT ActvieWidth = Foundation::Util::D3D12Util::CeilDivide(mRenderWidth, PixelStepX);
+		const UINT ActvieHeight = Foundation::Util::D3D12Util::CeilDivide(mRenderHeight, PixelStepY);
 
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(
 				ActvieWidth, ShadingConvention::RaySorting::RayGroup::Width),
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::RaySorting::RayGroup::Height),
+				ActvieHeight, ShadingConvention::RaySorting::RayGroup::Height),
 			ShadingConvention::RaySorting::RayGroup::Depth);
 		
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, mRayIndexOffsetMap.get());
@@ -14,8 +14,6 @@
 using namespace Render::DX::Shading;
 
 namespace {
-	const WCHAR* const HLSL_RaytracedShadow = L"RaytracedShadow.hlsl";
-
 	const WCHAR* const RaytracedShadow_RayGenName = L"RaytracedShadow_RayGen";
 	const WCHAR* const RaytracedShadow_ClosestHitName = L"RaytracedShadow_ClosestHit";
 	const WCHAR* const RaytracedShadow_MissName = L"RaytracedShadow_Miss";
@@ -65,15 +63,6 @@ void RaytracedShadow::RaytracedShadowClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL RaytracedShadow::RaytracedShadowClass::CompileShaders() {
-	const auto Lib = Util::ShaderManager::D3D12ShaderInfo(
-		HLSL_RaytracedShadow, L"", L"lib_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-		Lib, mShaderHashes[Shader::Lib_RaytracedShadow]));
-
-	return TRUE;
-}
-
 BOOL RaytracedShadow::RaytracedShadowClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -123,7 +112,7 @@ BOOL RaytracedShadow::RaytracedShadowClass::BuildPipelineStates() {
 	// RaytraceShadow-Library
 	const auto library = stateObject.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
 	const auto shader = mInitData.ShaderManager->
-		GetShader(mShaderHashes[Shader::Lib_RaytracedShadow]);
+		GetShader(L"RaytracedShadow.Lib_RaytracedShadow");
 	const D3D12_SHADER_BYTECODE rtaoLibDxil = CD3DX12_SHADER_BYTECODE(
 		shader->GetBufferPointer(), shader->GetBufferSize());
 	library->SetDXILLibrary(&rtaoLibDxil);
@@ -289,9 +278,9 @@ BOOL RaytracedShadow::RaytracedShadowClass::CalcShadow(
 		shadow->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, shadow);
 
-		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pNormalMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pNormalMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 		CmdList->SetComputeRootConstantBufferView(
 			RootSignature::CB_Light, pFrameResource->LightCB.CBAddress());
@@ -320,8 +309,8 @@ BOOL RaytracedShadow::RaytracedShadowClass::CalcShadow(
 		dispatchDesc.HitGroupTable.SizeInBytes = hitGroup->GetDesc().Width;
 		dispatchDesc.HitGroupTable.StrideInBytes = mHitGroupShaderTableStrideInBytes;
 
-		dispatchDesc.Width = mInitData.ClientWidth;
-		dispatchDesc.Height = mInitData.ClientHeight;
+		dispatchDesc.Width = mRenderWidth;
+		dispatchDesc.Height = mRenderHeight;
 		dispatchDesc.Depth = 1;
 
 		CmdList->DispatchRays(&dispatchDesc);
@@ -15,10 +15,6 @@ using namespace Render::DX::Shading;
 using namespace DirectX;
 using namespace DirectX::PackedVector;
 
-namespace {
-	const WCHAR* const HLSL_SSAO = L"SSAO.hlsl";
-}
-
 SSAO::InitDataPtr SSAO::MakeInitData() {
 	return std::unique_ptr<SSAOClass::InitData>(new SSAOClass::InitData());
 }
@@ -103,13 +99,6 @@ void SSAO::SSAOClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL SSAO::SSAOClass::CompileShaders() {
-	const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_SSAO, L"CS", L"cs_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_SSAO]));
-
-	return TRUE;
-}
-
 BOOL SSAO::SSAOClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -153,7 +142,7 @@ BOOL SSAO::SSAOClass::BuildPipelineStates() {
 	psoDesc.pRootSignature = mRootSignature.Get();
 	psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 	{
-		const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_SSAO]);
+		const auto CS = mInitData.ShaderManager->GetShader(L"SSAO.CS_SSAO");
 		NullCheck(mpLogFile, CS);
 		psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 	}
@@ -182,6 +171,16 @@ BOOL SSAO::SSAOClass::BuildDescriptors(Foundation::Core::DescriptorHeap* const p
 		mhAOResourceGpus[Descriptor::AO::ES_RayHitDistance] = pDescHeap->CbvSrvUavGpuOffset(1);
 		mhAOResourceCpus[Descriptor::AO::EU_RayHitDistance] = pDescHeap->CbvSrvUavCpuOffset(1);
 		mhAOResourceGpus[Descriptor::AO::EU_RayHitDistance] = pDescHeap->CbvSrvUavGpuOffset(1);
+		// HalfResAOCoefficient
+		mhAOResourceCpus[Descriptor::AO::ES_HalfResAOCoefficient] = pDescHeap->CbvSrvUavCpuOffset(1);
+		mhAOResourceGpus[Descriptor::AO::ES_HalfResAOCoefficient] = pDescHeap->CbvSrvUavGpuOffset(1);
+		mhAOResourceCpus[Descriptor::AO::EU_HalfResAOCoefficient] = pDescHeap->CbvSrvUavCpuOffset(1);
+		mhAOResourceGpus[Descriptor::AO::EU_HalfResAOCoefficient] = pDescHeap->CbvSrvUavGpuOffset(1);
+		// HalfResRayHitDistance
+		mhAOResourceCpus[Descriptor::AO::ES_HalfResRayHitDistance] = pDescHeap->CbvSrvUavCpuOffset(1);
+		mhAOResourceGpus[Descriptor::AO::ES_HalfResRayHitDistance] = pDescHeap->CbvSrvUavGpuOffset(1);
+		mhAOResourceCpus[Descriptor::AO::EU_HalfResRayHitDistance] = pDescHeap->CbvSrvUavCpuOffset(1);
+		mhAOResourceGpus[Descriptor::AO::EU_HalfResRayHitDistance] = pDescHeap->CbvSrvUavGpuOffset(1);
 	}
 	// TemporalCache
 	for (UINT frame = 0; frame < 2; ++frame) {
@@ -292,7 +291,9 @@ BOOL SSAO::SSAOClass::DrawAO(
 		Foundation::Resource::GpuResource* const pCurrNormalDepthMap,
 		D3D12_GPU_DESCRIPTOR_HANDLE si_currNormalDepthMap,
 		Foundation::Resource::GpuResource* const pPositionMap,
-		D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap) {
+		D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
+		BOOL bCheckerboardEnabled,
+		BOOL bHalfResolutionEnabled) {
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
 		0,
@@ -320,30 +321,41 @@ BOOL SSAO::SSAOClass::DrawAO(
 			CmdList,
 			TRUE);
 
-		const auto AOCoefficient = mAOResources[Resource::AO::E_AOCoefficient].get();
+		const auto AOCoefficient = mAOResources[bHalfResolutionEnabled ?
+			Resource::AO::E_HalfResAOCoefficient : Resource::AO::E_AOCoefficient].get();
 		AOCoefficient->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, AOCoefficient);
 
-		const auto RayHitDistance = mAOResources[Resource::AO::E_RayHitDistance].get();
+		const auto RayHitDistance = mAOResources[bHalfResolutionEnabled ?
+			Resource::AO::E_HalfResRayHitDistance : Resource::AO::E_RayHitDistance].get();
 		RayHitDistance->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, RayHitDistance);
 
-		pCurrNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		mRandomVectorMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pCurrNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		mRandomVectorMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 		CmdList->SetComputeRootDescriptorTable(RootSignature::Default::SI_NormalDepthMap, si_currNormalDepthMap);
 		CmdList->SetComputeRootDescriptorTable(RootSignature::Default::SI_PositionMap, si_positionMap);
 		CmdList->SetComputeRootDescriptorTable(RootSignature::Default::SI_RandomVectorMap, mhRandomVectorMapGpuSrv);
 		CmdList->SetComputeRootDescriptorTable(
-			RootSignature::Default::UO_AOCoefficientMap, mhAOResourceGpus[Descriptor::AO::EU_AOCoefficient]);
+			RootSignature::Default::UO_AOCoefficientMap, mhAOResourceGpus[bHalfResolutionEnabled ?
+				Descriptor::AO::EU_HalfResAOCoefficient : Descriptor::AO::EU_AOCoefficient]);
 		CmdList->SetComputeRootDescriptorTable(
-			RootSignature::Default::UO_RayHitDistMap, mhAOResourceGpus[Descriptor::AO::EU_RayHitDistance]);
+			RootSignature::Default::UO_RayHitDistMap, mhAOResourceGpus[bHalfResolutionEnabled ?
+				Descriptor::AO::EU_HalfResRayHitDistance : Descriptor::AO::EU_RayHitDistance]);
 		CmdList->SetComputeRootDescriptorTable(RootSignature::Default::UO_DebugMap, mhDebugMapGpuUav);
 
+		// One thread per evaluated pixel.
+		const UINT PixelStepX = bCheckerboardEnabled || bHalfResolutionEnabled ? 2 : 1;
+		const UINT PixelStepY = bHalfResolutionEnabled ? 2 : 1;
+
+		const UINT TexWidth = Foundation::Util::D3D12Util::CeilDivide(mRenderWidth, PixelStepX);
+		const UINT TexHeight = Foundation::Util::D3D12Util::CeilDivide(mRenderHeight, PixelStepY);
+
 		CmdList->Dispatch(
-			Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientWidth, ShadingConvention::SSAO::ThreadGroup::Default::Width),
-			Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientHeight, ShadingConvention::SSAO::ThreadGroup::Default::Height),
+			Foundation::Util::D3D12Util::CeilDivide(TexWidth, ShadingConvention::SSAO::ThreadGroup::Default::Width),
+			Foundation::Util::D3D12Util::CeilDivide(TexHeight, ShadingConvention::SSAO::ThreadGroup::Default::Height),
 			ShadingConvention::SSAO::ThreadGroup::Default::Depth);
 	}
 
@@ -449,6 +461,41 @@ BOOL SSAO::SSAOClass::BuildResources() {
 				L"SSAO_RayHitDistanceMap"));
 		}
 	}
+	// HalfResAO
+	{
+		texDesc.Width = Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientWidth, 2);
+		texDesc.Height = Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientHeight, 2);
+
+		// HalfResAOCoefficientMap
+		{
+			texDesc.Format = ShadingConvention::SSAO::AOCoefficientMapFormat;
+
+			CheckReturn(mpLogFile, mAOResources[Resource::AO::E_HalfResAOCoefficient]->Initialize(
+				mInitData.Device,
+				&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+				D3D12_HEAP_FLAG_NONE,
+				&texDesc,
+				D3D12_RESOURCE_STATE_COMMON,
+				nullptr,
+				L"SSAO_HalfResAOCoefficientMap"));
+		}
+		// HalfResRayHitDistanceMap
+		{
+			texDesc.Format = ShadingConvention::SVGF::RayHitDistanceMapFormat;
+
+			CheckReturn(mpLogFile, mAOResources[Resource::AO::E_HalfResRayHitDistance]->Initialize(
+				mInitData.Device,
+				&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+				D3D12_HEAP_FLAG_NONE,
+				&texDesc,
+				D3D12_RESOURCE_STATE_COMMON,
+				nullptr,
+				L"SSAO_HalfResRayHitDistanceMap"));
+		}
+
+		texDesc.Width = mInitData.ClientWidth;
+		texDesc.Height = mInitData.ClientHeight;
+	}
 	for (UINT frame = 0; frame < 2; ++frame) {
 		// TemporalCache
 		{
@@ -565,6 +612,24 @@ BOOL SSAO::SSAOClass::BuildDescriptors() {
 			Foundation::Util::D3D12Util::CreateShaderResourceView(mInitData.Device, resource, &srvDesc, mhAOResourceCpus[Descriptor::AO::ES_RayHitDistance]);
 			Foundation::Util::D3D12Util::CreateUnorderedAccessView(mInitData.Device, resource, nullptr, &uavDesc, mhAOResourceCpus[Descriptor::AO::EU_RayHitDistance]);
 		}
+		// HalfResAOCoefficientMap
+		{
+			srvDesc.Format = ShadingConvention::SSAO::AOCoefficientMapFormat;
+			uavDesc.Format = ShadingConvention::SSAO::AOCoefficientMapFormat;
+	
+			const auto resource = mAOResources[Resource::AO::E_HalfResAOCoefficient]->Resource();
+			Foundation::Util::D3D12Util::CreateShaderResourceView(mInitData.Device, resource, &srvDesc, mhAOResourceCpus[Descriptor::AO::ES_HalfResAOCoefficient]);
+			Foundation::Util::D3D12Util::CreateUnorderedAccessView(mInitData.Device, resource, nullptr, &uavDesc, mhAOResourceCpus[Descriptor::AO::EU_HalfResAOCoefficient]);
+		}
+		// HalfResRayHitDistanceMap
+		{
+			srvDesc.Format = ShadingConvention::SVGF::RayHitDistanceMapFormat;
+			uavDesc.Format = ShadingConvention::SVGF::RayHitDistanceMapFormat;
+	
+			const auto resource = mAOResources[Resource::AO::E_HalfResRayHitDistance]->Resource();
+			Foundation::Util::D3D12Util::CreateShaderResourceView(mInitData.Device, resource, &srvDesc, mhAOResourceCpus[Descriptor::AO::ES_HalfResRayHitDistance]);
+			Foundation::Util::D3D12Util::CreateUnorderedAccessView(mInitData.Device, resource, nullptr, &uavDesc, mhAOResourceCpus[Descriptor::AO::EU_HalfResRayHitDistance]);
+		}
 	}
 	for (UINT frame = 0; frame < 2; ++frame) {
 		// TemporalCache
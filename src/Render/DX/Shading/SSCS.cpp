@@ -5,6 +5,7 @@
 #include "Render/DX/Foundation/Core/Device.hpp"
 #include "Render/DX/Foundation/Core/CommandObject.hpp"
 #include "Render/DX/Foundation/Core/DescriptorHeap.hpp"
+#include "Render/DX/Foundation/Core/RenderGraph.hpp"
 #include "Render/DX/Foundation/Resource/FrameResource.hpp"
 #include "Render/DX/Foundation/Util/D3D12Util.hpp"
 #include "Render/DX/Shading/Util/ShaderManager.hpp"
@@ -12,11 +13,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_ComputeContactShadow = L"ComputeContactShadow.hlsl";
-	const WCHAR* const HLSL_ApplyContactShadow = L"ApplyContactShadow.hlsl";
-}
-
 SSCS::InitDataPtr SSCS::MakeInitData() {
 	return std::unique_ptr<SSCSClass::InitData>(new SSCSClass::InitData());
 }
@@ -28,7 +24,7 @@ SSCS::SSCSClass::SSCSClass() {
 
 SSCS::SSCSClass::~SSCSClass() { CleanUp(); }
 
-UINT SSCS::SSCSClass::CbvSrvUavDescCount() const { return 3; }
+UINT SSCS::SSCSClass::CbvSrvUavDescCount() const { return 1; }
 
 UINT SSCS::SSCSClass::RtvDescCount() const { return 0; }
 
@@ -60,21 +56,6 @@ void SSCS::SSCSClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL SSCS::SSCSClass::CompileShaders() {
-	// ComputeContactShadow
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ComputeContactShadow, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_ComputeContactShadow]));
-	}
-	// ApplyContactShadow
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ApplyContactShadow, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_ApplyContactShadow]));
-	}
-
-	return TRUE;
-}
-
 BOOL SSCS::SSCSClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -154,7 +135,7 @@ BOOL SSCS::SSCSClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ComputeContactShadow].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_ComputeContactShadow]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"SSCS.CS_ComputeContactShadow");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -171,7 +152,7 @@ BOOL SSCS::SSCSClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ApplyContactShadow].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_ApplyContactShadow]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"SSCS.CS_ApplyContactShadow");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -190,12 +171,6 @@ BOOL SSCS::SSCSClass::BuildDescriptors(Foundation::Core::DescriptorHeap* const p
 	mhDebugMapCpuUav = pDescHeap->CbvSrvUavCpuOffset(1);
 	mhDebugMapGpuUav = pDescHeap->CbvSrvUavGpuOffset(1);
 
-	mhContactShadowMapCpuSrv = pDescHeap->CbvSrvUavCpuOffset(1);
-	mhContactShadowMapGpuSrv = pDescHeap->CbvSrvUavGpuOffset(1);
-
-	mhContactShadowMapCpuUav = pDescHeap->CbvSrvUavCpuOffset(1);
-	mhContactShadowMapGpuUav = pDescHeap->CbvSrvUavGpuOffset(1);
-
 	CheckReturn(mpLogFile, BuildDescriptors());
 
 	return TRUE;
@@ -219,6 +194,8 @@ BOOL SSCS::SSCSClass::ComputeContactShadow(
 		D3D12_GPU_DESCRIPTOR_HANDLE si_normalMap,
 		Foundation::Resource::GpuResource* const pDepthMap,
 		D3D12_GPU_DESCRIPTOR_HANDLE si_depthMap) {
+	CheckReturn(mpLogFile, BuildTransientDescriptors());
+
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
 		0,
@@ -264,9 +241,9 @@ BOOL SSCS::SSCSClass::ComputeContactShadow(
 		
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth, ShadingConvention::SSCS::ThreadGroup::ComputeContactShadow::Width),
+				mRenderWidth, ShadingConvention::SSCS::ThreadGroup::ComputeContactShadow::Width),
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::SSCS::ThreadGroup::ComputeContactShadow::Height),
+				mRenderHeight, ShadingConvention::SSCS::ThreadGroup::ComputeContactShadow::Height),
 			ShadingConvention::SSCS::ThreadGroup::ComputeContactShadow::Depth);
 	}
 
@@ -301,9 +278,9 @@ BOOL SSCS::SSCSClass::ApplyContactShadow(
 
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth, ShadingConvention::SSCS::ThreadGroup::ApplyContactShadow::Width),
+				mRenderWidth, ShadingConvention::SSCS::ThreadGroup::ApplyContactShadow::Width),
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::SSCS::ThreadGroup::ApplyContactShadow::Height),
+				mRenderHeight, ShadingConvention::SSCS::ThreadGroup::ApplyContactShadow::Height),
 			ShadingConvention::SSCS::ThreadGroup::ApplyContactShadow::Depth);
 	}
 
@@ -312,6 +289,29 @@ BOOL SSCS::SSCSClass::ApplyContactShadow(
 	return TRUE;
 }
 
+void SSCS::SSCSClass::DeclareTransients(Foundation::Core::RenderPassBuilder& builder) {
+	D3D12_RESOURCE_DESC texDesc;
+	ZeroMemory(&texDesc, sizeof(D3D12_RESOURCE_DESC));
+	texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	texDesc.Width = mInitData.ClientWidth;
+	texDesc.Height = mInitData.ClientHeight;
+	texDesc.Alignment = 0;
+	texDesc.DepthOrArraySize = 1;
+	texDesc.MipLevels = 1;
+	texDesc.SampleDesc.Count = 1;
+	texDesc.SampleDesc.Quality = 0;
+	texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	texDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+	texDesc.Format = ShadingConvention::SSCS::ContactShadowMapFormat;
+
+	builder.Transient(
+		mContactShadowMap.get(),
+		texDesc,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+		L"SSCS_ContactShadowMap",
+		nullptr);
+}
+
 BOOL SSCS::SSCSClass::BuildResources() {
 	D3D12_RESOURCE_DESC texDesc;
 	ZeroMemory(&texDesc, sizeof(D3D12_RESOURCE_DESC));
@@ -339,30 +339,11 @@ BOOL SSCS::SSCSClass::BuildResources() {
 			nullptr,
 			L"SSCS_DebugMap"));
 	}
-	// ContactShadowMap
-	{
-		texDesc.Format = ShadingConvention::SSCS::ContactShadowMapFormat;
-
-		CheckReturn(mpLogFile, mContactShadowMap->Initialize(
-			mInitData.Device,
-			&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-			D3D12_HEAP_FLAG_NONE,
-			&texDesc,
-			D3D12_RESOURCE_STATE_COMMON,
-			nullptr,
-			L"SSCS_ContactShadowMap"));
-	}
 
 	return TRUE;
 }
 
 BOOL SSCS::SSCSClass::BuildDescriptors() {
-	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-	srvDesc.Texture2D.MostDetailedMip = 0;
-	srvDesc.Texture2D.MipLevels = 1;	
-
 	D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
 	uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
 	uavDesc.Texture2D.MipSlice = 0;
@@ -377,6 +358,25 @@ BOOL SSCS::SSCSClass::BuildDescriptors() {
 		Foundation::Util::D3D12Util::CreateUnorderedAccessView(
 			mInitData.Device, resource, nullptr, &uavDesc, mhDebugMapCpuUav);
 	}
+
+	return TRUE;
+}
+
+BOOL SSCS::SSCSClass::BuildTransientDescriptors() {
+	CheckReturn(mpLogFile, mInitData.DescriptorHeap->AllocateTransient(1, mhContactShadowMapCpuSrv, mhContactShadowMapGpuSrv));
+	CheckReturn(mpLogFile, mInitData.DescriptorHeap->AllocateTransient(1, mhContactShadowMapCpuUav, mhContactShadowMapGpuUav));
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Texture2D.MostDetailedMip = 0;
+	srvDesc.Texture2D.MipLevels = 1;	
+
+	D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+	uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+	uavDesc.Texture2D.MipSlice = 0;
+	uavDesc.Texture2D.PlaneSlice = 0;	
+
 	// ContactShadowMap
 	{
 		srvDesc.Format = ShadingConvention::SSCS::ContactShadowMapFormat;
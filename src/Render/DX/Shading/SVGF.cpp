@@ -13,16 +13,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_CalcPartialDepthDerivative = L"CalcPartialDepthDerivative.hlsl";
-	const WCHAR* const HLSL_CalcLocalMeanVariance = L"CalcLocalMeanVariance.hlsl";
-	const WCHAR* const HLSL_FillInCheckboard = L"FillInCheckerboard_CrossBox4TapFilter.hlsl";
-	const WCHAR* const HLSL_TemporalSupersamplingReverseReproject = L"TemporalSupersamplingReverseReproject.hlsl";
-	const WCHAR* const HLSL_TemporalSupersamplingBlendWithCurrentFrame = L"TemporalSupersamplingBlendWithCurrentFrame.hlsl";
-	const WCHAR* const HLSL_EdgeStoppingFilterGaussian3x3 = L"EdgeStoppingFilter_Gaussian3x3.hlsl";
-	const WCHAR* const HLSL_DisocclusionBlur3x3 = L"DisocclusionBlur3x3.hlsl";
-}
-
 SVGF::InitDataPtr SVGF::MakeInitData() {
 	return std::unique_ptr<SVGFClass::InitData>(new SVGFClass::InitData());
 }
@@ -80,52 +70,6 @@ void SVGF::SVGFClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL SVGF::SVGFClass::CompileShaders() {
-	// CalcParticalDepthDerivative
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_CalcPartialDepthDerivative, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			CS, mShaderHashes[Shader::CS_CalcParticalDepthDerivative]));
-	}
-	// CalcLocalMeanVariance
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_CalcLocalMeanVariance, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_CalcLocalMeanVariance]));
-	}
-	// FillInCheckerboard
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_FillInCheckboard, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_FillinCheckerboard]));
-	}
-	// TemporalSupersamplingReverseReproject
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_TemporalSupersamplingReverseReproject, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			CS, mShaderHashes[Shader::CS_TemporalSupersamplingReverseReproject]));
-	}
-	// TemporalSupersamplingBlendWithCurrentFrame
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_TemporalSupersamplingBlendWithCurrentFrame, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(
-			CS, mShaderHashes[Shader::CS_TemporalSupersamplingBlendWithCurrentFrame]));
-	}
-	// EdgeStoppingFilterGaussian3x3_Contrast
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_EdgeStoppingFilterGaussian3x3, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_EdgeStoppingFilterGaussian3x3]));
-	}
-	// DisocclusionBlur3x3
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_DisocclusionBlur3x3, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_DisocclusionBlur3x3]));
-	}
-	
-	return TRUE;
-}
-
 BOOL SVGF::SVGFClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -371,7 +315,7 @@ BOOL SVGF::SVGFClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_CalcDepthPartialDerivative].Get();
 		{
 			const auto CS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::CS_CalcParticalDepthDerivative]);
+				L"SVGF.CS_CalcParticalDepthDerivative");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -387,7 +331,7 @@ BOOL SVGF::SVGFClass::BuildPipelineStates() {
 		D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_CalcLocalMeanVariance].Get();
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_CalcLocalMeanVariance]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"SVGF.CS_CalcLocalMeanVariance");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -403,7 +347,7 @@ BOOL SVGF::SVGFClass::BuildPipelineStates() {
 		D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_FillInCheckerboard].Get();
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_FillinCheckerboard]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"SVGF.CS_FillinCheckerboard");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -420,7 +364,7 @@ BOOL SVGF::SVGFClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_TemporalSupersamplingReverseReproject].Get();
 		{
 			const auto CS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::CS_TemporalSupersamplingReverseReproject]);
+				L"SVGF.CS_TemporalSupersamplingReverseReproject");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -437,7 +381,7 @@ BOOL SVGF::SVGFClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_TemporalSupersamplingBlendWithCurrentFrame].Get();
 		{
 			const auto CS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::CS_TemporalSupersamplingBlendWithCurrentFrame]);
+				L"SVGF.CS_TemporalSupersamplingBlendWithCurrentFrame");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -454,7 +398,7 @@ BOOL SVGF::SVGFClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_AtrousWaveletTransformFilter].Get();
 		{
 			const auto CS = mInitData.ShaderManager->GetShader(
-				mShaderHashes[Shader::CS_EdgeStoppingFilterGaussian3x3]);
+				L"SVGF.CS_EdgeStoppingFilterGaussian3x3");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -470,7 +414,7 @@ BOOL SVGF::SVGFClass::BuildPipelineStates() {
 		D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_DisocclusionBlur].Get();
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_DisocclusionBlur3x3]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"SVGF.CS_DisocclusionBlur3x3");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -549,9 +493,9 @@ BOOL SVGF::SVGFClass::CalculateDepthParticalDerivative(
 	
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
+				mRenderWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height), 
+				mRenderHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height), 
 			ShadingConvention::SVGF::ThreadGroup::Default::Depth);
 	}
 	
@@ -594,9 +538,9 @@ BOOL SVGF::SVGFClass::CalculateLocalMeanVariance(
 		const INT PixelStepY = bCheckerboardSamplingEnabled ? 2 : 1;
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
+				mRenderWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height * PixelStepY),
+				mRenderHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height * PixelStepY),
 			ShadingConvention::SVGF::ThreadGroup::Default::Depth);
 	}
 
@@ -633,9 +577,9 @@ BOOL SVGF::SVGFClass::FillInCheckerboard(
 		const INT PixelStepY = bCheckerboardSamplingEnabled ? 2 : 1;
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
+				mRenderWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
 			Foundation::Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height * PixelStepY),
+				mRenderHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height * PixelStepY),
 			ShadingConvention::SVGF::ThreadGroup::Default::Depth);
 	}
 
@@ -676,14 +620,14 @@ BOOL SVGF::SVGFClass::ReverseReprojectPreviousFrame(
 	{
 		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_TemporalSupersamplingReverseReproject].Get());
 
-		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pReprojNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pCachedNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pVelocityMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pCachedValueMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pCachedValueSquaredMeanMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pCachedRayHitDistMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pCachedTSPPMap0->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pReprojNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pCachedNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pVelocityMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pCachedValueMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pCachedValueSquaredMeanMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pCachedRayHitDistMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pCachedTSPPMap0->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 		pCachedTSPPMap0->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, pCachedTSPPMap0);
@@ -741,8 +685,12 @@ BOOL SVGF::SVGFClass::ReverseReprojectPreviousFrame(
 			mhDebugMapGpuUavs[1]);
 
 		ShadingConvention::SVGF::RootConstant::TemporalSupersamplingReverseReproject::Struct rc;
-		rc.gTexDim = { static_cast<FLOAT>(mInitData.ClientWidth), static_cast<FLOAT>(mInitData.ClientHeight) };
+		rc.gTexDim = { static_cast<FLOAT>(mRenderWidth), static_cast<FLOAT>(mRenderHeight) };
 		rc.gInvTexDim = { 1.f / static_cast<FLOAT>(mInitData.ClientWidth), 1.f / static_cast<FLOAT>(mInitData.ClientHeight) };
+		// The cache holds the area the previous frame rendered into.
+		rc.gPrevTexDim = {
+			std::round(mPrevUVScale.x * static_cast<FLOAT>(mInitData.ClientWidth)),
+			std::round(mPrevUVScale.y * static_cast<FLOAT>(mInitData.ClientHeight)) };
 
 		std::array<std::uint32_t, ShadingConvention::SVGF::RootConstant::TemporalSupersamplingReverseReproject::Count> consts;
 		std::memcpy(consts.data(), &rc, sizeof(ShadingConvention::SVGF::RootConstant::TemporalSupersamplingReverseReproject::Struct));
@@ -755,9 +703,9 @@ BOOL SVGF::SVGFClass::ReverseReprojectPreviousFrame(
 
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
+				mRenderWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height),
+				mRenderHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height),
 			ShadingConvention::SVGF::ThreadGroup::Default::Depth);
 	}
 
@@ -792,8 +740,8 @@ BOOL SVGF::SVGFClass::BlendWithCurrentFrame(
 	{
 		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_TemporalSupersamplingBlendWithCurrentFrame].Get());
 
-		pValueMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pRayHitDistanceMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pValueMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pRayHitDistanceMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 		pTemporalCacheValueMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, pTemporalCacheValueMap);
@@ -843,9 +791,9 @@ BOOL SVGF::SVGFClass::BlendWithCurrentFrame(
 
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
+				mRenderWidth, ShadingConvention::SVGF::ThreadGroup::Default::Width),
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height),
+				mRenderHeight, ShadingConvention::SVGF::ThreadGroup::Default::Height),
 			ShadingConvention::SVGF::ThreadGroup::Default::Depth);
 	}
 
@@ -880,8 +828,8 @@ BOOL SVGF::SVGFClass::ApplyAtrousWaveletTransformFilter(
 	{
 		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_AtrousWaveletTransformFilter].Get());
 
-		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pTemporalCacheHitDistanceMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pNormalDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pTemporalCacheHitDistanceMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 		pTemporalCacheTSPPMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		pTemporalValueMap_Input->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 
@@ -924,9 +872,9 @@ BOOL SVGF::SVGFClass::ApplyAtrousWaveletTransformFilter(
 
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
-				mInitData.ClientWidth, ShadingConvention::SVGF::ThreadGroup::Atrous::Width),
+				mRenderWidth, ShadingConvention::SVGF::ThreadGroup::Atrous::Width),
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
-				mInitData.ClientHeight, ShadingConvention::SVGF::ThreadGroup::Atrous::Height),
+				mRenderHeight, ShadingConvention::SVGF::ThreadGroup::Atrous::Height),
 			ShadingConvention::SVGF::ThreadGroup::Atrous::Depth);
 	}
 
@@ -956,8 +904,8 @@ BOOL SVGF::SVGFClass::BlurDisocclusion(
 	{
 		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_DisocclusionBlur].Get());
 
-		pDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-		pRoughnessMetalnessMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pDepthMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		pRoughnessMetalnessMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 		pTemporalValueMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, pTemporalValueMap);
@@ -972,8 +920,8 @@ BOOL SVGF::SVGFClass::BlurDisocclusion(
 			RootSignature::DisocclusionBlur::UIO_AOCoefficient, uio_temporalValueMap);
 
 		ShadingConvention::SVGF::RootConstant::DisocclusionBlur::Struct rc;
-		rc.gTextureDim.x = mInitData.ClientWidth;
-		rc.gTextureDim.y = mInitData.ClientHeight;
+		rc.gTextureDim.x = mRenderWidth;
+		rc.gTextureDim.y = mRenderHeight;
 		rc.gMaxStep = numLowTSPPBlurPasses;
 
 		const UINT ThreadGroupX = ShadingConvention::SVGF::ThreadGroup::Default::Width;
@@ -994,9 +942,9 @@ BOOL SVGF::SVGFClass::BlurDisocclusion(
 
 			// Account for interleaved Group execution
 			const UINT WidthCS = filterStep * ThreadGroupX * 
-				Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientWidth, filterStep * ThreadGroupX);
+				Foundation::Util::D3D12Util::CeilDivide(mRenderWidth, filterStep * ThreadGroupX);
 			const UINT HeightCS = filterStep * ThreadGroupY * 
-				Foundation::Util::D3D12Util::CeilDivide(mInitData.ClientHeight, filterStep * ThreadGroupY);
+				Foundation::Util::D3D12Util::CeilDivide(mRenderHeight, filterStep * ThreadGroupY);
 
 			CmdList->Dispatch(
 				Foundation::Util::D3D12Util::D3D12Util::CeilDivide(WidthCS, ThreadGroupX),
@@ -19,19 +19,25 @@
 using namespace Render::DX::Shading;
 
 namespace {
-	const WCHAR* const HLSL_DrawZDepth = L"DrawZDepth.hlsl";
-	const WCHAR* const HLSL_DrawShadow = L"DrawShadow.hlsl";
-
-	ShadingConvention::Shadow::ShadowMap::Type ResolveShadowMapType(
-			const Common::Foundation::Light* const light) {
-		if (light->Type == Common::Foundation::LightType::E_Point
-			|| light->Type == Common::Foundation::LightType::E_Tube)
-			return ShadingConvention::Shadow::ShadowMap::E_CubeMap;
-		//else if (light->Type == Common::Render::LightType::E_Directional)
-		//	return Shadow::ShadowMap::E_Texture2DArray;
-		else
-			return ShadingConvention::Shadow::ShadowMap::E_Texture2D;
+	// Number of atlas pages a light renders its depth into.
+	UINT ResolveFaceCount(const Common::Foundation::Light* const light) {
+		switch (light->Type) {
+		case Common::Foundation::LightType::E_Directional:
+			return ShadingConvention::Shadow::CascadeCount;
+		case Common::Foundation::LightType::E_Spot:
+			return 1;
+		case Common::Foundation::LightType::E_Point:
+		case Common::Foundation::LightType::E_Tube:
+			return 6;
+		default:
+			return 0;
+		}
+	}
 
+	UINT ResolvePageSize(UINT size, UINT minSize, UINT maxSize) {
+		UINT power = minSize;
+		while (power < size && power < maxSize) power <<= 1;
+		return power;
 	}
 }
 
@@ -40,8 +46,7 @@ Shadow::InitDataPtr Shadow::MakeInitData() {
 }
 
 Shadow::ShadowClass::ShadowClass() {
-	for (UINT i = 0; i < MaxLights; ++i) 
-		mZDepthMaps[i] = std::make_unique<Foundation::Resource::GpuResource>();
+	mZDepthAtlas = std::make_unique<Foundation::Resource::GpuResource>();
 	mShadowMap = std::make_unique<Foundation::Resource::GpuResource>();
 }
 
@@ -52,24 +57,30 @@ void Shadow::ShadowClass::Lights(std::vector<Common::Foundation::Light*>& lights
 		lights.push_back(mLights[i].get());
 }
 
-void Shadow::ShadowClass::ZDepthMaps(std::vector<Render::DX::Foundation::Resource::GpuResource*>& maps) {
-	for (UINT i = 0; i < mLightCount; ++i)
-		maps.push_back(mZDepthMaps[i].get());
+DirectX::XMFLOAT4 Shadow::ShadowClass::PageScaleOffset(UINT lightIndex, UINT face) const {
+	const auto& lightPages = mLightPages[lightIndex];
+	if (face >= lightPages.FaceCount) return {};
+
+	const auto& page = lightPages.Pages[face];
+	if (!Common::Util::ShadowAtlasAllocator::IsAllocated(page)) return {};
+
+	const FLOAT InvAtlasSize = 1.f / static_cast<FLOAT>(mAtlasAllocator.AtlasSize());
+	const FLOAT Scale = static_cast<FLOAT>(page.Size) * InvAtlasSize;
+
+	return { Scale, Scale, static_cast<FLOAT>(page.X) * InvAtlasSize, static_cast<FLOAT>(page.Y) * InvAtlasSize };
 }
 
 UINT Shadow::ShadowClass::CbvSrvUavDescCount() const { return 0
-	+ MaxLights // ZDepthMapSrvs
-	+ MaxLights // ZDepthCubeMapSrvs
-	+ 1			// ShadowMapSrv
-	+ 1			// ShadowMapUav
+	+ 1 // ZDepthAtlasSrv
+	+ 1	// ShadowMapSrv
+	+ 1	// ShadowMapUav
 	; 
 }
 
 UINT Shadow::ShadowClass::RtvDescCount() const { return 0; }
 
 UINT Shadow::ShadowClass::DsvDescCount() const { return 0
-	+ MaxLights // ZDepthMaps
-	+ MaxLights // ZDepthCubeMaps
+	+ 1 // ZDepthAtlas
 	; 
 }
 
@@ -79,9 +90,9 @@ BOOL Shadow::ShadowClass::Initialize(Common::Debug::LogFile* const pLogFile, voi
 	const auto initData = reinterpret_cast<InitData*>(pData);
 	mInitData = *initData;
 
-	mViewport = { 0.0f, 0.0f, static_cast<FLOAT>(mInitData.TexWidth), static_cast<FLOAT>(mInitData.TexHeight), 0.0f, 1.0f };
-	mScissorRect = { 0, 0, static_cast<INT>(mInitData.TexWidth), static_cast<INT>(mInitData.TexHeight) };
+	mAtlasAllocator.Initialize(mInitData.AtlasSize, mInitData.MinPageSize);
 
+	CheckReturn(mpLogFile, BuildAtlas());
 	CheckReturn(mpLogFile, BuildResources());
 
 	return TRUE;
@@ -91,11 +102,7 @@ void Shadow::ShadowClass::CleanUp() {
 	if (mbCleanedUp) return;
 
 	if (mShadowMap) mShadowMap.reset();
-
-	for (UINT i = 0; i < MaxLights; ++i) {
-		auto& resource = mZDepthMaps[i];
-		if (resource) resource.reset();
-	}
+	if (mZDepthAtlas) mZDepthAtlas.reset();
 
 	for (UINT i = 0; i < PipelineState::Count; ++i)
 		mPipelineStates[i].Reset();
@@ -106,32 +113,13 @@ void Shadow::ShadowClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL Shadow::ShadowClass::CompileShaders() {
-	// DrawZDepth
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_DrawZDepth, L"VS", L"vs_6_5");
-		const auto GS = Util::ShaderManager::D3D12ShaderInfo(HLSL_DrawZDepth, L"GS", L"gs_6_5");
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_DrawZDepth, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_DrawZDepth]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(GS, mShaderHashes[Shader::GS_DrawZDepth]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_DrawZDepth]));
-	}
-	// DrawShadow
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_DrawShadow, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_DrawShadow]));
-	}
-
-	return TRUE;
-}
-
 BOOL Shadow::ShadowClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
 	// DrawZDepth
 	{
 		CD3DX12_DESCRIPTOR_RANGE texTables[1]{}; UINT index = 0;
-		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, ShadingConvention::GBuffer::MaxNumTextures, 0, 0);
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, ShadingConvention::GBuffer::MaxNumTextures, 0, 1);
 
 		index = 0;
 
@@ -155,10 +143,9 @@ BOOL Shadow::ShadowClass::BuildRootSignatures() {
 	}
 	// DrawShadow
 	{
-		CD3DX12_DESCRIPTOR_RANGE texTables[4]{}; UINT index = 0;
+		CD3DX12_DESCRIPTOR_RANGE texTables[3]{}; UINT index = 0;
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 1, 0);
-		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 2, 0);
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0, 0);
 
 		index = 0;
@@ -167,8 +154,7 @@ BOOL Shadow::ShadowClass::BuildRootSignatures() {
 		slotRootParameter[RootSignature::DrawShadow::CB_Light].InitAsConstantBufferView(0);
 		slotRootParameter[RootSignature::DrawShadow::RC_Consts].InitAsConstants(ShadingConvention::Shadow::RootConstant::DrawShadow::Count, 1);
 		slotRootParameter[RootSignature::DrawShadow::SI_PositionMap].InitAsDescriptorTable(1, &texTables[index++]);
-		slotRootParameter[RootSignature::DrawShadow::SI_ZDepthMap].InitAsDescriptorTable(1, &texTables[index++]);
-		slotRootParameter[RootSignature::DrawShadow::SI_ZDepthCubeMap].InitAsDescriptorTable(1, &texTables[index++]);
+		slotRootParameter[RootSignature::DrawShadow::SI_ZDepthAtlas].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::DrawShadow::UIO_ShadowMap].InitAsDescriptorTable(1, &texTables[index++]);
 
 		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
@@ -193,11 +179,11 @@ BOOL Shadow::ShadowClass::BuildPipelineStates() {
 		auto psoDesc = Foundation::Util::D3D12Util::DefaultPsoDesc(inputLayout, ShadingConvention::DepthStencilBuffer::DepthStencilBufferFormat);
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_DrawZDepth].Get();
 		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_DrawZDepth]);
+			const auto VS = mInitData.ShaderManager->GetShader(L"Shadow.VS_DrawZDepth");
 			NullCheck(mpLogFile, VS);
-			const auto GS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::GS_DrawZDepth]);
+			const auto GS = mInitData.ShaderManager->GetShader(L"Shadow.GS_DrawZDepth");
 			NullCheck(mpLogFile, GS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_DrawZDepth]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"Shadow.PS_DrawZDepth");
 			NullCheck(mpLogFile, PS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			psoDesc.GS = { reinterpret_cast<BYTE*>(GS->GetBufferPointer()), GS->GetBufferSize() };
@@ -222,7 +208,7 @@ BOOL Shadow::ShadowClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_DrawShadow].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_DrawShadow]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"Shadow.CS_DrawShadow");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -238,11 +224,9 @@ BOOL Shadow::ShadowClass::BuildPipelineStates() {
 }
 
 BOOL Shadow::ShadowClass::BuildDescriptors(Foundation::Core::DescriptorHeap* const pDescHeap) {
-	for (UINT i = 0; i < MaxLights; ++i) {
-		mhZDepthMapCpuSrvs[i] = pDescHeap->CbvSrvUavCpuOffset(1);
-		mhZDepthMapGpuSrvs[i] = pDescHeap->CbvSrvUavGpuOffset(1);
-		mhZDepthMapCpuDsvs[i] = pDescHeap->DsvCpuOffset(1);
-	}
+	mhZDepthAtlasCpuSrv = pDescHeap->CbvSrvUavCpuOffset(1);
+	mhZDepthAtlasGpuSrv = pDescHeap->CbvSrvUavGpuOffset(1);
+	mhZDepthAtlasCpuDsv = pDescHeap->DsvCpuOffset(1);
 	
 	mhShadowMapCpuSrv = pDescHeap->CbvSrvUavCpuOffset(1);
 	mhShadowMapGpuSrv = pDescHeap->CbvSrvUavGpuOffset(1);
@@ -268,28 +252,86 @@ BOOL Shadow::ShadowClass::Run(
 		Foundation::Resource::FrameResource* const pFrameResource, 
 		Foundation::Resource::GpuResource* const pPositionMap,
 		D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
-		const std::vector<Render::DX::Foundation::RenderItem*>& ritems) {
+		const std::array<std::vector<Render::DX::Foundation::RenderItem*>, MaxLights>& casters) {
+	mSubmittedItemCount = 0;
+	mRedrawnLightCount = 0;
+
+	if (mLightCount == 0) return TRUE;
+
+	std::array<UINT, MaxLights> staleLights{};
+	UINT staleCount = 0;
+
 	for (UINT i = 0; i < mLightCount; ++i) {
-		CheckReturn(mpLogFile, DrawZDepth(pFrameResource, ritems, i));
-		CheckReturn(mpLogFile, DrawShadow(pFrameResource, pPositionMap, si_positionMap, ritems, i));
+		const auto& lightPages = mLightPages[i];
+		if (!lightPages.Cached && lightPages.FaceCount > 0) staleLights[staleCount++] = i;
 	}
 
+	std::vector<ID3D12CommandAllocator*> allocs{};
+	pFrameResource->CommandAllocators(allocs);
+
+	// Stale lights are dealt round-robin to the workers. They share the
+	// atlas but never a page of it, and the render graph has put the atlas
+	// into the depth-write state before the lists are recorded.
+	const UINT WorkerCount = std::max(1u, std::min(staleCount, mInitData.CommandObject->ThreadCount()));
+
+	CheckReturn(mpLogFile, mInitData.CommandObject->RecordCommandLists(
+		allocs.data(),
+		WorkerCount,
+		mPipelineStates[PipelineState::GP_DrawZDepth].Get(),
+		[&](ID3D12GraphicsCommandList6* const pCmdList, UINT worker) -> BOOL {
+			for (UINT i = worker; i < staleCount; i += WorkerCount)
+				CheckReturn(mpLogFile, DrawZDepth(pFrameResource, pCmdList, casters[staleLights[i]], staleLights[i]));
+
+			return TRUE;
+		}));
+
+	// All lights accumulate into the one shadow map, so these dispatches
+	// stay serial. The last list is submitted after every z-depth list.
+	const auto CmdList = mInitData.CommandObject->CommandList(WorkerCount - 1);
+
+	for (UINT i = 0; i < mLightCount; ++i)
+		CheckReturn(mpLogFile, DrawShadow(pFrameResource, CmdList, pPositionMap, si_positionMap, i));
+
+	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandLists(WorkerCount));
+
+	for (UINT i = 0; i < staleCount; ++i) {
+		mLightPages[staleLights[i]].Cached = TRUE;
+		mSubmittedItemCount += static_cast<UINT>(casters[staleLights[i]].size());
+	}
+	mRedrawnLightCount = staleCount;
+
 	return TRUE;
 }
 
 BOOL Shadow::ShadowClass::AddLight(const std::shared_ptr<Common::Foundation::Light>& light) {
 	if (mLightCount >= MaxLights) ReturnFalse(mpLogFile, L"Can not add light due to the light count limit");
 
-	const auto ShadowMapType = ResolveShadowMapType(light.get());
+	auto& lightPages = mLightPages[mLightCount];
+	lightPages = {};
+	lightPages.FaceCount = ResolveFaceCount(light.get());
 
-	CheckReturn(mpLogFile, BuildResource(ShadowMapType));
-	CheckReturn(mpLogFile, BuildDescriptor(ShadowMapType));
+	CheckReturn(mpLogFile, AllocatePages(
+		lightPages, ResolvePageSize(mInitData.MaxPageSize, mAtlasAllocator.MinPageSize(), mInitData.MaxPageSize)));
 
 	mLights[mLightCount++] = light;
 
 	return TRUE;
 }
 
+BOOL Shadow::ShadowClass::ResizePages(UINT lightIndex, UINT pageSize) {
+	auto& lightPages = mLightPages[lightIndex];
+
+	const UINT Size = ResolvePageSize(pageSize, mAtlasAllocator.MinPageSize(), mInitData.MaxPageSize);
+	if (lightPages.FaceCount == 0 || lightPages.PageSize == Size) return TRUE;
+
+	for (UINT face = 0; face < lightPages.FaceCount; ++face)
+		mAtlasAllocator.Free(lightPages.Pages[face]);
+
+	CheckReturn(mpLogFile, AllocatePages(lightPages, Size));
+
+	return TRUE;
+}
+
 BOOL Shadow::ShadowClass::BuildResources() {
 	D3D12_RESOURCE_DESC rscDesc;
 	ZeroMemory(&rscDesc, sizeof(D3D12_RESOURCE_DESC));
@@ -347,18 +389,33 @@ BOOL Shadow::ShadowClass::BuildDescriptors() {
 		Foundation::Util::D3D12Util::CreateShaderResourceView(mInitData.Device, shadowMap, &srvDesc, mhShadowMapCpuSrv);
 		Foundation::Util::D3D12Util::CreateUnorderedAccessView(mInitData.Device, shadowMap, nullptr, &uavDesc, mhShadowMapCpuUav);
 	}
+	// ZDepthAtlas
+	{
+		srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
+
+		D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc;
+		dsvDesc.Format = ShadingConvention::Shadow::ZDepthMapFormat;
+		dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
+		dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+		dsvDesc.Texture2D.MipSlice = 0;
+
+		const auto atlas = mZDepthAtlas->Resource();
+		Foundation::Util::D3D12Util::CreateShaderResourceView(mInitData.Device, atlas, &srvDesc, mhZDepthAtlasCpuSrv);
+		Foundation::Util::D3D12Util::CreateDepthStencilView(mInitData.Device, atlas, &dsvDesc, mhZDepthAtlasCpuDsv);
+	}
 	
 	return TRUE;
 }
 
-BOOL Shadow::ShadowClass::BuildResource(ShadingConvention::Shadow::ShadowMap::Type type) {
+BOOL Shadow::ShadowClass::BuildAtlas() {
 	D3D12_RESOURCE_DESC rscDesc;
 	ZeroMemory(&rscDesc, sizeof(D3D12_RESOURCE_DESC));
 	rscDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
 	rscDesc.Alignment = 0;
 	rscDesc.Format = ShadingConvention::Shadow::ZDepthMapFormat;
-	rscDesc.Width = mInitData.TexWidth;
-	rscDesc.Height = mInitData.TexHeight;
+	rscDesc.Width = mAtlasAllocator.AtlasSize();
+	rscDesc.Height = mAtlasAllocator.AtlasSize();
+	rscDesc.DepthOrArraySize = 1;
 	rscDesc.MipLevels = 1;
 	rscDesc.SampleDesc.Count = 1;
 	rscDesc.SampleDesc.Quality = 0;
@@ -370,113 +427,76 @@ BOOL Shadow::ShadowClass::BuildResource(ShadingConvention::Shadow::ShadowMap::Ty
 	zdepthOptClear.DepthStencil.Depth = 1.f;
 	zdepthOptClear.DepthStencil.Stencil = 0;
 
-	std::wstring name;
-	if (type == ShadingConvention::Shadow::ShadowMap::E_CubeMap) {
-		rscDesc.DepthOrArraySize = 6;
-		name = std::format(L"Shadow_ZDepthCubeMap_{}", mLightCount);
-	}
-	else if (type == ShadingConvention::Shadow::ShadowMap::E_Texture2DArray) {
-		rscDesc.DepthOrArraySize = ShadingConvention::Shadow::CascadeCount;
-		name = std::format(L"Shadow_ZDepthArray_{}", mLightCount);
-	}
-	else {
-		rscDesc.DepthOrArraySize = 1;		
-		name = std::format(L"Shadow_ZDepthMap_{}", mLightCount);
-	}
-
-	CheckReturn(mpLogFile, mZDepthMaps[mLightCount]->Initialize(
+	CheckReturn(mpLogFile, mZDepthAtlas->Initialize(
 		mInitData.Device,
 		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
 		D3D12_HEAP_FLAG_NONE,
 		&rscDesc,
 		D3D12_RESOURCE_STATE_DEPTH_READ,
 		&zdepthOptClear,
-		name.c_str()));
+		L"Shadow_ZDepthAtlas"));
 
 	return TRUE;
 }
 
-BOOL Shadow::ShadowClass::BuildDescriptor(ShadingConvention::Shadow::ShadowMap::Type type) {
-	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-	srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
-
-	D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc;
-	dsvDesc.Format = ShadingConvention::Shadow::ZDepthMapFormat;
-	dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
-
-	if (type == ShadingConvention::Shadow::ShadowMap::E_CubeMap) {
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
-		srvDesc.Texture2DArray.ArraySize = 6;
-		srvDesc.Texture2DArray.FirstArraySlice = 0;
-		srvDesc.Texture2DArray.MipLevels = 1;
-		srvDesc.Texture2DArray.MostDetailedMip = 0;
-		srvDesc.Texture2DArray.PlaneSlice = 0;
-		srvDesc.Texture2DArray.ResourceMinLODClamp = 0.f;
-		
-		dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
-		dsvDesc.Texture2DArray.ArraySize = 6;
-		dsvDesc.Texture2DArray.FirstArraySlice = 0;
-		dsvDesc.Texture2DArray.MipSlice = 0;		
-	}
-	else if (type == ShadingConvention::Shadow::ShadowMap::E_Texture2DArray) {
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
-		srvDesc.Texture2DArray.ArraySize = ShadingConvention::Shadow::CascadeCount;
-		srvDesc.Texture2DArray.FirstArraySlice = 0;
-		srvDesc.Texture2DArray.MipLevels = 1;
-		srvDesc.Texture2DArray.MostDetailedMip = 0;
-		srvDesc.Texture2DArray.PlaneSlice = 0;
-		srvDesc.Texture2DArray.ResourceMinLODClamp = 0.f;
-
-		dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
-		dsvDesc.Texture2DArray.ArraySize = ShadingConvention::Shadow::CascadeCount;
-		dsvDesc.Texture2DArray.FirstArraySlice = 0;
-		dsvDesc.Texture2DArray.MipSlice = 0;
-	}
-	else {
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Texture2D.MostDetailedMip = 0;
-		srvDesc.Texture2D.MipLevels = 1;
-		srvDesc.Texture2D.ResourceMinLODClamp = 0.f;
-		srvDesc.Texture2D.PlaneSlice = 0;
+BOOL Shadow::ShadowClass::AllocatePages(LightPages& lightPages, UINT pageSize) {
+	lightPages.Cached = FALSE;
+	lightPages.PageSize = 0;
 
-		dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
-		dsvDesc.Texture2D.MipSlice = 0;
-	}
+	if (lightPages.FaceCount == 0) return TRUE;
 
-	const auto depthMap = mZDepthMaps[mLightCount]->Resource();
-	Foundation::Util::D3D12Util::CreateShaderResourceView(
-		mInitData.Device, depthMap, &srvDesc, mhZDepthMapCpuSrvs[mLightCount]);
-	Foundation::Util::D3D12Util::CreateDepthStencilView(
-		mInitData.Device, depthMap, &dsvDesc, mhZDepthMapCpuDsvs[mLightCount]);
+	// Falls back to smaller pages until every face fits.
+	for (UINT size = pageSize; size >= mAtlasAllocator.MinPageSize(); size >>= 1) {
+		UINT face = 0;
+		for (; face < lightPages.FaceCount; ++face)
+			if (!mAtlasAllocator.Allocate(size, lightPages.Pages[face])) break;
 
-	return TRUE;
+		if (face == lightPages.FaceCount) {
+			lightPages.PageSize = size;
+			return TRUE;
+		}
+
+		while (face > 0) mAtlasAllocator.Free(lightPages.Pages[--face]);
+	}
+
+	ReturnFalse(mpLogFile, L"Shadow atlas has no room left for the light's pages");
 }
 
 BOOL Shadow::ShadowClass::DrawZDepth(
 		Foundation::Resource::FrameResource* const pFrameResource,
+		ID3D12GraphicsCommandList6* const CmdList,
 		const std::vector<Render::DX::Foundation::RenderItem*>& ritems,
 		UINT lightIndex) {
-	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
-		pFrameResource->CommandAllocator(0),
-		0,
-		mPipelineStates[PipelineState::GP_DrawZDepth].Get()));
-
-	const auto CmdList = mInitData.CommandObject->CommandList(0);
 	mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
 
 	{
 		CmdList->SetPipelineState(mPipelineStates[PipelineState::GP_DrawZDepth].Get());
 		CmdList->SetGraphicsRootSignature(mRootSignatures[RootSignature::GR_DrawZDepth].Get());
 
-		CmdList->RSSetViewports(1, &mViewport);
-		CmdList->RSSetScissorRects(1, &mScissorRect);
-		
-		mZDepthMaps[lightIndex]->Transite(CmdList, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+		// The geometry shader picks a face's page through its viewport
+		// index; the scissors keep every face inside its page.
+		const auto& lightPages = mLightPages[lightIndex];
+
+		std::array<D3D12_VIEWPORT, ShadingConvention::Shadow::MaxFaceCount> viewports{};
+		std::array<D3D12_RECT, ShadingConvention::Shadow::MaxFaceCount> scissorRects{};
+
+		for (UINT face = 0; face < lightPages.FaceCount; ++face) {
+			const auto& page = lightPages.Pages[face];
+
+			viewports[face] = { 
+				static_cast<FLOAT>(page.X), static_cast<FLOAT>(page.Y), 
+				static_cast<FLOAT>(page.Size), static_cast<FLOAT>(page.Size), 0.f, 1.f };
+			scissorRects[face] = { 
+				static_cast<LONG>(page.X), static_cast<LONG>(page.Y), 
+				static_cast<LONG>(page.X + page.Size), static_cast<LONG>(page.Y + page.Size) };
+		}
 
-		const auto dsv = mhZDepthMapCpuDsvs[lightIndex];
+		CmdList->RSSetViewports(lightPages.FaceCount, viewports.data());
+		CmdList->RSSetScissorRects(lightPages.FaceCount, scissorRects.data());
 
-		CmdList->ClearDepthStencilView(dsv, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+		const auto dsv = mhZDepthAtlasCpuDsv;
+
+		CmdList->ClearDepthStencilView(dsv, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, lightPages.FaceCount, scissorRects.data());
 		CmdList->OMSetRenderTargets(0, nullptr, FALSE, &dsv);
 
 		CmdList->SetGraphicsRootConstantBufferView(
@@ -493,38 +513,33 @@ BOOL Shadow::ShadowClass::DrawZDepth(
 			CmdList,
 			FALSE);
 
-		//CmdList->SetGraphicsRootDescriptorTable(RootSignature::DrawZDepth::SI_Textures, si_textures);
+		CmdList->SetGraphicsRootDescriptorTable(
+			RootSignature::DrawZDepth::SI_Textures,
+			mInitData.DescriptorHeap->TextureTableGpuHandle());
 
 		CheckReturn(mpLogFile, DrawRenderItems(pFrameResource, CmdList, ritems));
 	}
 
-	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandList(0));
-
 	return TRUE;
 }
 
 BOOL Shadow::ShadowClass::DrawShadow(
 		Foundation::Resource::FrameResource* const pFrameResource,
+		ID3D12GraphicsCommandList6* const CmdList,
 		Foundation::Resource::GpuResource* const pPositionMap,
 		D3D12_GPU_DESCRIPTOR_HANDLE si_positionMap,
-		const std::vector<Render::DX::Foundation::RenderItem*>& ritems,
 		UINT lightIndex) {
-	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
-		pFrameResource->CommandAllocator(0),
-		0,
-		mPipelineStates[PipelineState::CP_DrawShadow].Get()));
-
-	const auto CmdList = mInitData.CommandObject->CommandList(0);
 	mInitData.DescriptorHeap->SetDescriptorHeap(CmdList);
 
 	{
+		CmdList->SetPipelineState(mPipelineStates[PipelineState::CP_DrawShadow].Get());
 		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_DrawShadow].Get());
 
 		mShadowMap->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, mShadowMap.get());
 
-		mZDepthMaps[lightIndex]->Transite(CmdList, D3D12_RESOURCE_STATE_DEPTH_READ);
-		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		mZDepthAtlas->Transite(CmdList, D3D12_RESOURCE_STATE_DEPTH_READ);
+		pPositionMap->Transite(CmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 		CmdList->SetComputeRootConstantBufferView(
 			RootSignature::DrawShadow::CB_Light, pFrameResource->LightCB.CBAddress());
@@ -544,34 +559,21 @@ BOOL Shadow::ShadowClass::DrawShadow(
 			RootSignature::DrawShadow::SI_PositionMap, si_positionMap);
 		CmdList->SetComputeRootDescriptorTable(
 			RootSignature::DrawShadow::UIO_ShadowMap, mhShadowMapGpuUav);
-
-		const auto ShadowMapType = ResolveShadowMapType(mLights[lightIndex].get());
-
-		if (ShadowMapType == ShadingConvention::Shadow::ShadowMap::E_CubeMap) 
-			CmdList->SetComputeRootDescriptorTable(
-				RootSignature::DrawShadow::SI_ZDepthCubeMap, 
-				mhZDepthMapGpuSrvs[lightIndex]);
-		else if (ShadowMapType == ShadingConvention::Shadow::ShadowMap::E_Texture2DArray)
-			;
-		else CmdList->SetComputeRootDescriptorTable(
-			RootSignature::DrawShadow::SI_ZDepthMap, 
-			mhZDepthMapGpuSrvs[lightIndex]);
-
+		CmdList->SetComputeRootDescriptorTable(
+			RootSignature::DrawShadow::SI_ZDepthAtlas, mhZDepthAtlasGpuSrv);
 
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(
-				static_cast<UINT>(mInitData.ClientWidth), 
+				static_cast<UINT>(mRenderWidth), 
 				ShadingConvention::Shadow::ThreadGroup::DrawShadow::Width),
 			Foundation::Util::D3D12Util::CeilDivide(
-				static_cast<UINT>(mInitData.ClientHeight), 
+				static_cast<UINT>(mRenderHeight), 
 				ShadingConvention::Shadow::ThreadGroup::DrawShadow::Height), 
 			ShadingConvention::Shadow::ThreadGroup::DrawShadow::Depth);
 
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, mShadowMap.get());
 	}
 
-	CheckReturn(mpLogFile, mInitData.CommandObject->ExecuteCommandList(0));
-
 	return TRUE;
 }
 
@@ -16,10 +16,6 @@
 using namespace Render::DX::Shading;
 using namespace DirectX;
 
-namespace {
-	const WCHAR* const HLSL_TAA = L"TAA.hlsl";
-}
-
 TAA::InitDataPtr TAA::MakeInitData() {
 	return std::unique_ptr<TAAClass::InitData>(new TAAClass::InitData());
 }
@@ -42,11 +38,6 @@ BOOL TAA::TAAClass::Initialize(Common::Debug::LogFile* const pLogFile, void* con
 	const auto initData = reinterpret_cast<InitData*>(pData);
 	mInitData = *initData;
 
-	for (size_t i = 0, end = mHaltonSequence.size(); i < end; ++i) {
-		auto offset = mHaltonSequence[i];
-		mFittedToBakcBufferHaltonSequence[i] = XMFLOAT2(((offset.x - 0.5f) / mInitData.ClientWidth) * 2.f, ((offset.y - 0.5f) / mInitData.ClientHeight) * 2.f);
-	}
-
 	CheckReturn(mpLogFile, BuildResources());
 
 	return TRUE;
@@ -65,17 +56,6 @@ void TAA::TAAClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL TAA::TAAClass::CompileShaders() {
-	const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_TAA, L"VS", L"vs_6_5");
-	const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_TAA, L"MS", L"ms_6_5");
-	const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_TAA, L"PS", L"ps_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_TAA]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_TAA]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_TAA]));
-
-	return TRUE;
-}
-
 BOOL TAA::TAAClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -113,9 +93,9 @@ BOOL TAA::TAAClass::BuildPipelineStates() {
 		auto psoDesc = Foundation::Util::D3D12Util::FitToScreenMeshPsoDesc();
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
-			const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_TAA]);
+			const auto MS = mInitData.ShaderManager->GetShader(L"TAA.MS_TAA");
 			NullCheck(mpLogFile, MS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_TAA]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"TAA.PS_TAA");
 			NullCheck(mpLogFile, PS);
 			psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -132,9 +112,9 @@ BOOL TAA::TAAClass::BuildPipelineStates() {
 		auto psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
 		psoDesc.pRootSignature = mRootSignature.Get();
 		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_TAA]);
+			const auto VS = mInitData.ShaderManager->GetShader(L"TAA.VS_TAA");
 			NullCheck(mpLogFile, VS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_TAA]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"TAA.PS_TAA");
 			NullCheck(mpLogFile, PS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -164,13 +144,6 @@ BOOL TAA::TAAClass::OnResize(UINT width, UINT height) {
 	mInitData.ClientWidth = width;
 	mInitData.ClientHeight = height;
 
-	for (size_t i = 0, end = mHaltonSequence.size(); i < end; ++i) {
-		auto offset = mHaltonSequence[i];
-		mFittedToBakcBufferHaltonSequence[i] = XMFLOAT2(
-			((offset.x - 0.5f) / mInitData.ClientWidth) * 2.f, 
-			((offset.y - 0.5f) / mInitData.ClientHeight) * 2.f);
-	}
-
 	CheckReturn(mpLogFile, BuildResources());
 	CheckReturn(mpLogFile, BuildDescriptors());
 
@@ -217,6 +190,8 @@ BOOL TAA::TAAClass::ApplyTAA(
 		rc.gModulationFactor = factor;
 		rc.gInvTexDim.x = 1.f / static_cast<FLOAT>(mInitData.ClientWidth);
 		rc.gInvTexDim.y = 1.f / static_cast<FLOAT>(mInitData.ClientHeight);
+		rc.gUVScale = mUVScale;
+		rc.gPrevUVScale = mPrevUVScale;
 
 		Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::TAA::RootConstant::Default::Struct>(
 			RootSignature::Default::RC_Consts,
@@ -12,10 +12,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_ToneMapping = L"ToneMapping.hlsl";
-}
-
 ToneMapping::InitDataPtr ToneMapping::MakeInitData() {
 	return std::unique_ptr<ToneMappingClass::InitData>(new ToneMappingClass::InitData());
 }
@@ -62,17 +58,6 @@ void ToneMapping::ToneMappingClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL ToneMapping::ToneMappingClass::CompileShaders() {
-	const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ToneMapping, L"VS", L"vs_6_5");
-	const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ToneMapping, L"MS", L"ms_6_5");
-	const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ToneMapping, L"PS", L"ps_6_5");
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_ToneMapping]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_ToneMapping]));
-	CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ToneMapping]));
-	
-	return TRUE;
-}
-
 BOOL ToneMapping::ToneMappingClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -111,9 +96,9 @@ BOOL ToneMapping::ToneMappingClass::BuildPipelineStates() {
 			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenMeshPsoDesc();
 			psoDesc.pRootSignature = mRootSignature.Get();
 			{
-				const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_ToneMapping]);
+				const auto MS = mInitData.ShaderManager->GetShader(L"ToneMapping.MS_ToneMapping");
 				NullCheck(mpLogFile, MS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ToneMapping]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"ToneMapping.PS_ToneMapping");
 				NullCheck(mpLogFile, PS);
 				psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -130,9 +115,9 @@ BOOL ToneMapping::ToneMappingClass::BuildPipelineStates() {
 			auto psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
 			psoDesc.pRootSignature = mRootSignature.Get();
 			{
-				const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_ToneMapping]);
+				const auto VS = mInitData.ShaderManager->GetShader(L"ToneMapping.VS_ToneMapping");
 				NullCheck(mpLogFile, VS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ToneMapping]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"ToneMapping.PS_ToneMapping");
 				NullCheck(mpLogFile, PS);
 				psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -204,6 +189,7 @@ BOOL ToneMapping::ToneMappingClass::Resolve(
 		rc.gExposure = exposure;
 		rc.gMiddleGrayKey = middleGrayKey;
 		rc.gTonemapperType = tonemapperType;
+		rc.gUVScale = mUVScale;
 
 		std::array<std::uint32_t, ShadingConvention::ToneMapping::RootConstant::Default::Count> consts;
 		std::memcpy(consts.data(), &rc, sizeof(ShadingConvention::ToneMapping::RootConstant::Default::Struct));
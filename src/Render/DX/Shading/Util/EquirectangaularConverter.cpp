@@ -12,11 +12,6 @@
 
 using namespace Render::DX::Shading::Util;
 
-namespace {
-	const WCHAR* const HLSL_ConvertEquirectangularToCubeMap = L"ConvertEquirectangularToCubeMap.hlsl";
-	const WCHAR* const HLSL_ConvertCubeMapToEquirectangular = L"ConvertCubeToEquirectangularMap.hlsl";
-}
-
 EquirectangularConverter::InitDataPtr EquirectangularConverter::MakeInitData() {
 	return std::unique_ptr<EquirectangularConverterClass::InitData>(new EquirectangularConverterClass::InitData());
 }
@@ -52,27 +47,6 @@ void EquirectangularConverter::EquirectangularConverterClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL EquirectangularConverter::EquirectangularConverterClass::CompileShaders() {
-	// ConvertEquirectangularToCubeMap
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvertEquirectangularToCubeMap, L"VS", L"vs_6_5");
-		const auto GS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvertEquirectangularToCubeMap, L"GS", L"gs_6_5");
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvertEquirectangularToCubeMap, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_ConvEquirectToCube]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(GS, mShaderHashes[Shader::GS_ConvEquirectToCube]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ConvEquirectToCube]));
-	}
-	// ConvertCubeMapToEquirectangular
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvertCubeMapToEquirectangular, L"VS", L"vs_6_5");
-		const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ConvertCubeMapToEquirectangular, L"PS", L"ps_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_ConvCubeToEquirect]));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ConvCubeToEquirect]));
-	}
-
-	return TRUE;
-}
-
 BOOL EquirectangularConverter::EquirectangularConverterClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -130,11 +104,11 @@ BOOL EquirectangularConverter::EquirectangularConverterClass::BuildPipelineState
 		D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = Foundation::Util::D3D12Util::DefaultPsoDesc({ nullptr, 0 }, DXGI_FORMAT_UNKNOWN);
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ConvEquirectToCube].Get();
 		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_ConvEquirectToCube]);
+			const auto VS = mInitData.ShaderManager->GetShader(L"EquirectangularConverter.VS_ConvEquirectToCube");
 			NullCheck(mpLogFile, VS);
-			const auto GS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::GS_ConvEquirectToCube]);
+			const auto GS = mInitData.ShaderManager->GetShader(L"EquirectangularConverter.GS_ConvEquirectToCube");
 			NullCheck(mpLogFile, GS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ConvEquirectToCube]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"EquirectangularConverter.PS_ConvEquirectToCube");
 			NullCheck(mpLogFile, PS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			psoDesc.GS = { reinterpret_cast<BYTE*>(GS->GetBufferPointer()), GS->GetBufferSize() };
@@ -156,9 +130,9 @@ BOOL EquirectangularConverter::EquirectangularConverterClass::BuildPipelineState
 		D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ConvCubeToEquirect].Get();
 		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_ConvCubeToEquirect]);
+			const auto VS = mInitData.ShaderManager->GetShader(L"EquirectangularConverter.VS_ConvCubeToEquirect");
 			NullCheck(mpLogFile, VS);
-			const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ConvCubeToEquirect]);
+			const auto PS = mInitData.ShaderManager->GetShader(L"EquirectangularConverter.PS_ConvCubeToEquirect");
 			NullCheck(mpLogFile, PS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 			psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -12,10 +12,6 @@
 
 using namespace Render::DX::Shading::Util;
 
-namespace {
-	const WCHAR* const HLSL_GenerateMipmap = L"GenerateMipmap.hlsl";
-}
-
 MipmapGenerator::InitDataPtr MipmapGenerator::MakeInitData() {
 	return std::unique_ptr<MipmapGeneratorClass::InitData>(new MipmapGeneratorClass::InitData());
 }
@@ -51,28 +47,6 @@ void MipmapGenerator::MipmapGeneratorClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL MipmapGenerator::MipmapGeneratorClass::CompileShaders() {
-	// GenerateMipmap
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_GenerateMipmap, L"VS", L"vs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_GenerateMipmap]));
-
-		const auto MS = Util::ShaderManager::D3D12ShaderInfo(HLSL_GenerateMipmap, L"MS", L"ms_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(MS, mShaderHashes[Shader::MS_GenerateMipmap]));
-
-		{
-			const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_GenerateMipmap, L"PS_GenerateMipmap", L"ps_6_5");
-			CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_GenerateMipmap]));
-		}
-		{
-			const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_GenerateMipmap, L"PS_CopyMap", L"ps_6_5");
-			CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_CopyMap]));
-		}
-	}
-
-	return TRUE;
-}
-
 BOOL MipmapGenerator::MipmapGeneratorClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -113,9 +87,9 @@ BOOL MipmapGenerator::MipmapGeneratorClass::BuildPipelineStates() {
 			psoDesc.RTVFormats[0] = HDR_FORMAT;
 
 			{
-				const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_GenerateMipmap]);
+				const auto MS = mInitData.ShaderManager->GetShader(L"MipmapGenerator.MS_GenerateMipmap");
 				NullCheck(mpLogFile, MS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_GenerateMipmap]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"MipmapGenerator.PS_GenerateMipmap");
 				NullCheck(mpLogFile, PS);
 				psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -134,9 +108,9 @@ BOOL MipmapGenerator::MipmapGeneratorClass::BuildPipelineStates() {
 			psoDesc.RTVFormats[0] = HDR_FORMAT;
 
 			{
-				const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_GenerateMipmap]);
+				const auto VS = mInitData.ShaderManager->GetShader(L"MipmapGenerator.VS_GenerateMipmap");
 				NullCheck(mpLogFile, VS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_GenerateMipmap]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"MipmapGenerator.PS_GenerateMipmap");
 				NullCheck(mpLogFile, PS);
 				psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -158,9 +132,9 @@ BOOL MipmapGenerator::MipmapGeneratorClass::BuildPipelineStates() {
 			psoDesc.RTVFormats[0] = HDR_FORMAT;
 
 			{
-				const auto MS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::MS_GenerateMipmap]);
+				const auto MS = mInitData.ShaderManager->GetShader(L"MipmapGenerator.MS_GenerateMipmap");
 				NullCheck(mpLogFile, MS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_CopyMap]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"MipmapGenerator.PS_CopyMap");
 				NullCheck(mpLogFile, PS);
 				psoDesc.MS = { reinterpret_cast<BYTE*>(MS->GetBufferPointer()), MS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
@@ -179,9 +153,9 @@ BOOL MipmapGenerator::MipmapGeneratorClass::BuildPipelineStates() {
 			psoDesc.RTVFormats[0] = HDR_FORMAT;
 
 			{
-				const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_GenerateMipmap]);
+				const auto VS = mInitData.ShaderManager->GetShader(L"MipmapGenerator.VS_GenerateMipmap");
 				NullCheck(mpLogFile, VS);
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_CopyMap]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"MipmapGenerator.PS_CopyMap");
 				NullCheck(mpLogFile, PS);
 				psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
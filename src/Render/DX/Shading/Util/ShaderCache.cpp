@@ -0,0 +1,245 @@
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Shading/Util/ShaderCache.hpp"
+#include "Common/Debug/Logger.hpp"
+
+using namespace Render::DX::Shading::Util;
+using namespace Microsoft::WRL;
+
+namespace {
+	const UINT32 EntryMagic = 0x43534D44; // "DMSC"
+	const UINT32 EntryVersion = 1;
+
+	struct EntryHeader {
+		UINT32 Magic;
+		UINT32 Version;
+		UINT64 Key;
+		UINT64 Size;
+	};
+
+	// Collects the targets of quoted includes. Conditional blocks are not
+	// evaluated, so a file may list includes it never uses; that only
+	// widens what invalidates its entries.
+	void ParseIncludes(const std::vector<CHAR>& source, std::vector<std::string>& includes) {
+		size_t pos = 0;
+		const size_t End = source.size();
+
+		while (pos < End) {
+			size_t lineEnd = pos;
+			while (lineEnd < End && source[lineEnd] != '\n') ++lineEnd;
+
+			size_t cur = pos;
+			while (cur < lineEnd && (source[cur] == ' ' || source[cur] == '\t')) ++cur;
+
+			static const CHAR Directive[] = "#include";
+			const size_t DirectiveLen = sizeof(Directive) - 1;
+
+			if (lineEnd - cur > DirectiveLen && std::memcmp(&source[cur], Directive, DirectiveLen) == 0) {
+				cur += DirectiveLen;
+				while (cur < lineEnd && source[cur] != '"' && source[cur] != '<') ++cur;
+
+				if (cur < lineEnd && source[cur] == '"') {
+					const size_t Begin = ++cur;
+					while (cur < lineEnd && source[cur] != '"') ++cur;
+					if (cur < lineEnd) includes.emplace_back(&source[Begin], cur - Begin);
+				}
+			}
+
+			pos = lineEnd + 1;
+		}
+	}
+}
+
+BOOL ShaderCache::Initialize(Common::Debug::LogFile* const pLogFile, LPCWSTR cacheDir, UINT workerCount) {
+	mpLogFile = pLogFile;
+	mCacheDir = cacheDir;
+	mSourceFiles.resize(workerCount);
+
+	std::error_code ec{};
+	if (!std::filesystem::exists(mCacheDir, ec)) {
+		std::filesystem::create_directories(mCacheDir, ec);
+		if (ec) {
+			std::wstring msg(L"Failed to create shader cache directory: ");
+			msg.append(mCacheDir.wstring());
+			ReturnFalse(mpLogFile, msg);
+		}
+	}
+
+	return TRUE;
+}
+
+void ShaderCache::CleanUp() {
+	mSourceFiles.clear();
+	mpLogFile = nullptr;
+}
+
+void ShaderCache::ResetCounters() {
+	mHitCount = 0;
+	mMissCount = 0;
+}
+
+BOOL ShaderCache::HashSource(
+		UINT worker,
+		const std::filesystem::path& filePath,
+		Common::Foundation::Hash& hash,
+		std::vector<Dependency>& deps) {
+	hash = 0;
+
+	std::set<std::wstring> visited{};
+	std::vector<std::filesystem::path> pending{ filePath.lexically_normal() };
+
+	while (!pending.empty()) {
+		const auto path = std::move(pending.back());
+		pending.pop_back();
+
+		if (!visited.insert(path.wstring()).second) continue;
+
+		SourceFile file{};
+		CheckReturn(mpLogFile, ReadSourceFile(worker, path, file));
+
+		hash = Common::Util::HashUtil::HashCombine(hash, file.ContentHash);
+		deps.push_back({ path, file.WriteTime });
+
+		// Reverse so includes are visited in source order.
+		for (auto iter = file.Includes.rbegin(); iter != file.Includes.rend(); ++iter)
+			pending.push_back(*iter);
+	}
+
+	return TRUE;
+}
+
+BOOL ShaderCache::Load(
+		Common::Foundation::Hash key,
+		IDxcUtils* const pUtils,
+		ComPtr<IDxcBlob>& blob) {
+	blob.Reset();
+
+	std::ifstream fin(EntryPath(key), std::ios::binary);
+	if (!fin.is_open()) {
+		++mMissCount;
+		return TRUE;
+	}
+
+	EntryHeader header{};
+	fin.read(reinterpret_cast<CHAR*>(&header), sizeof(EntryHeader));
+	if (!fin || header.Magic != EntryMagic || header.Version != EntryVersion || header.Key != key || header.Size == 0) {
+		++mMissCount;
+		return TRUE;
+	}
+
+	std::vector<CHAR> data(static_cast<size_t>(header.Size));
+	fin.read(data.data(), data.size());
+	if (!fin) {
+		++mMissCount;
+		return TRUE;
+	}
+
+	ComPtr<IDxcBlobEncoding> encoding{};
+	CheckHRESULT(mpLogFile, pUtils->CreateBlob(data.data(), static_cast<UINT32>(data.size()), 0, &encoding));
+	CheckHRESULT(mpLogFile, encoding.As(&blob));
+
+	++mHitCount;
+
+	return TRUE;
+}
+
+BOOL ShaderCache::Store(Common::Foundation::Hash key, IDxcBlob* const pBlob) {
+	const auto path = EntryPath(key);
+
+	// Written aside and renamed so a crash never leaves a truncated entry
+	// under a valid name.
+	std::wstringstream wsstream{};
+	wsstream << path.wstring() << L'.' << std::this_thread::get_id() << L".tmp";
+	const std::filesystem::path tempPath(wsstream.str());
+
+	{
+		std::ofstream fout(tempPath, std::ios::binary | std::ios::trunc);
+		if (!fout.is_open()) {
+			std::wstring msg(L"Failed to open shader cache entry: ");
+			msg.append(tempPath.wstring());
+			ReturnFalse(mpLogFile, msg);
+		}
+
+		EntryHeader header{};
+		header.Magic = EntryMagic;
+		header.Version = EntryVersion;
+		header.Key = static_cast<UINT64>(key);
+		header.Size = static_cast<UINT64>(pBlob->GetBufferSize());
+
+		fout.write(reinterpret_cast<const CHAR*>(&header), sizeof(EntryHeader));
+		fout.write(reinterpret_cast<const CHAR*>(pBlob->GetBufferPointer()), pBlob->GetBufferSize());
+	}
+
+	std::error_code ec{};
+	std::filesystem::rename(tempPath, path, ec);
+	if (ec) {
+		std::filesystem::remove(tempPath, ec);
+
+		std::wstring msg(L"Failed to write shader cache entry: ");
+		msg.append(path.wstring());
+		ReturnFalse(mpLogFile, msg);
+	}
+
+	return TRUE;
+}
+
+BOOL ShaderCache::ReadSourceFile(UINT worker, const std::filesystem::path& filePath, SourceFile& file) {
+	std::error_code ec{};
+	const auto WriteTime = std::filesystem::last_write_time(filePath, ec);
+	if (ec) {
+		std::wstring msg(L"Failed to open shader file: ");
+		msg.append(filePath.wstring());
+		ReturnFalse(mpLogFile, msg);
+	}
+
+	auto& sourceFiles = mSourceFiles[worker];
+
+	// Shared includes are read once per modification, not once per shader.
+	const auto iter = sourceFiles.find(filePath.wstring());
+	if (iter != sourceFiles.end() && iter->second.WriteTime == WriteTime) {
+		file = iter->second;
+		return TRUE;
+	}
+
+	std::ifstream fin(filePath, std::ios::ate | std::ios::binary);
+	if (!fin.is_open()) {
+		std::wstring msg(L"Failed to open shader file: ");
+		msg.append(filePath.wstring());
+		ReturnFalse(mpLogFile, msg);
+	}
+
+	const size_t FileSize = static_cast<size_t>(fin.tellg());
+	std::vector<CHAR> data(FileSize);
+
+	fin.seekg(0);
+	fin.read(data.data(), FileSize);
+	fin.close();
+
+	file.WriteTime = WriteTime;
+	file.ContentHash = Common::Util::HashUtil::HashBytes(data.data(), data.size());
+	file.Includes.clear();
+
+	std::vector<std::string> includes{};
+	ParseIncludes(data, includes);
+
+	// The compiler resolves includes against the working directory first
+	// and then against the including file.
+	for (const auto& include : includes) {
+		const std::filesystem::path Relative(include);
+		const std::filesystem::path Candidates[] = { Relative, filePath.parent_path() / Relative };
+
+		for (const auto& candidate : Candidates) {
+			if (std::filesystem::exists(candidate, ec)) {
+				file.Includes.push_back(candidate.lexically_normal());
+				break;
+			}
+		}
+	}
+
+	sourceFiles[filePath.wstring()] = file;
+
+	return TRUE;
+}
+
+std::filesystem::path ShaderCache::EntryPath(Common::Foundation::Hash key) const {
+	return mCacheDir / std::format(L"{:016x}.bin", static_cast<UINT64>(key));
+}
\ No newline at end of file
@@ -2,235 +2,477 @@
 #include "Render/DX/Shading/Util/ShaderManager.hpp"
 #include "Common/Debug/Logger.hpp"
 #include "Common/Util/StringUtil.hpp"
-#include "Common/Util/TaskQueue.hpp"
+
+#include <future>
 
 using namespace Render::DX::Shading::Util;
 using namespace Microsoft::WRL;
 
-ShaderManager::D3D12ShaderInfo::D3D12ShaderInfo(LPCWSTR fileName, LPCWSTR entryPoint, LPCWSTR profile) {
-	FileName = fileName;
-	EntryPoint = entryPoint;
-	TargetProfile = profile;
+namespace {
+	const UINT32 ArchiveMagic = 0x41534D44; // "DMSA"
+	const UINT32 ArchiveVersion = 1;
+
+	struct ArchiveHeader {
+		UINT32 Magic;
+		UINT32 Version;
+		UINT64 EntryCount;
+	};
+
+	struct ArchiveRecord {
+		UINT64 ArchiveKey;
+		UINT64 ContentKey;
+		UINT64 Offset;
+		UINT64 Size;
+	};
 }
 
+ShaderManager::D3D12ShaderInfo::D3D12ShaderInfo(LPCWSTR fileName, LPCWSTR entryPoint, LPCWSTR profile) 
+	: D3D12ShaderInfo(fileName, entryPoint, profile, nullptr, 0) {}
+
 ShaderManager::D3D12ShaderInfo::D3D12ShaderInfo(
-		LPCWSTR fileName, LPCWSTR entryPoint, LPCWSTR profile, DxcDefine* defines, UINT32 defCount) {
-	FileName = fileName;
-	EntryPoint = entryPoint;
-	TargetProfile = profile;
-	DefineCount = defCount;
-	
-	Defines = new DxcDefine[defCount];
+		LPCWSTR fileName, LPCWSTR entryPoint, LPCWSTR profile, const DxcDefine* defines, UINT32 defCount) {
+	const auto Append = [&](LPCWSTR str) -> size_t {
+		const size_t Offset = mStrings.size();
+		mStrings.insert(mStrings.end(), str, str + wcslen(str) + 1);
+		return Offset;
+	};
+
+	// Offsets first; the buffer may grow while it is being filled.
+	const size_t FileNameOffset = Append(fileName);
+	const size_t EntryPointOffset = Append(entryPoint);
+	const size_t ProfileOffset = Append(profile);
+
+	const size_t NoValue = SIZE_MAX;
+	std::vector<std::pair<size_t, size_t>> offsets(defCount);
 	for (UINT32 i = 0; i < defCount; ++i) {
-		{
-			const auto Name = defines[i].Name;
-			const auto NameLen = wcslen(Name) + 1;
+		offsets[i].first = Append(defines[i].Name);
+		offsets[i].second = defines[i].Value != nullptr ? Append(defines[i].Value) : NoValue;
+	}
 
-			auto newName = new WCHAR[NameLen];
-			wcscpy_s(newName, NameLen, Name);
+	FileName = mStrings.data() + FileNameOffset;
+	EntryPoint = mStrings.data() + EntryPointOffset;
+	TargetProfile = mStrings.data() + ProfileOffset;
 
-			Defines[i].Name = newName;
-		}
+	mDefines.resize(defCount);
+	for (UINT32 i = 0; i < defCount; ++i) {
+		mDefines[i].Name = mStrings.data() + offsets[i].first;
+		mDefines[i].Value = offsets[i].second != NoValue ? mStrings.data() + offsets[i].second : nullptr;
+	}
+
+	Defines = mDefines.data();
+	DefineCount = defCount;
+}
+
+ShaderManager::ShaderManager() {}
+
+ShaderManager::~ShaderManager() { CleanUp(); }
+
+BOOL ShaderManager::Initialize(
+		Common::Debug::LogFile* const pLogFile, 
+		UINT numThreads, 
+		LPCWSTR cacheDir, 
+		BOOL bCompileSources) {
+	mpLogFile = pLogFile;
+	mThreadCount = numThreads;
+	mbCompileSources = bCompileSources;
+
+	// Each compile worker owns one slot of these for its whole run.
+	mUtils.resize(numThreads);
+	mStagingShaders.resize(numThreads);
+	mCompileErrors.resize(numThreads);
+
+	for (UINT i = 0; i < numThreads; ++i) 
+		CheckHRESULT(mpLogFile, DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&mUtils[i])));
 
-		if (defines[i].Value != nullptr) {
-			const auto Value = defines[i].Value;
-			const auto ValueLen = wcslen(Value) + 1;
+	if (!mbCompileSources) return TRUE;
 
-			auto newValue = new WCHAR[ValueLen];
-			wcscpy_s(newValue, ValueLen, Value);
+	mCompilers.resize(numThreads);
+	for (UINT i = 0; i < numThreads; ++i) 
+		CheckHRESULT(mpLogFile, DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&mCompilers[i])));
+
+	// Cached bytecode is only valid for the compiler build that produced it.
+	{
+		ComPtr<IDxcVersionInfo> versionInfo{};
+		CheckHRESULT(mpLogFile, mCompilers[0].As(&versionInfo));
+
+		UINT32 major{}, minor{};
+		CheckHRESULT(mpLogFile, versionInfo->GetVersion(&major, &minor));
+
+		mCompilerHash = Common::Util::HashUtil::HashCombine(major, minor);
 
-			Defines[i].Value = newValue;
+		ComPtr<IDxcVersionInfo2> versionInfo2{};
+		if (SUCCEEDED(versionInfo.As(&versionInfo2))) {
+			UINT32 commitCount{};
+			CHAR* commitHash{};
+			CheckHRESULT(mpLogFile, versionInfo2->GetCommitInfo(&commitCount, &commitHash));
+
+			mCompilerHash = Common::Util::HashUtil::HashCombine(mCompilerHash, commitCount);
+			mCompilerHash = Common::Util::HashUtil::HashCombine(
+				mCompilerHash, Common::Util::HashUtil::HashBytes(commitHash, std::strlen(commitHash)));
+
+			CoTaskMemFree(commitHash);
 		}
 	}
+
+	mShaderCache = std::make_unique<ShaderCache>();
+	CheckReturn(mpLogFile, mShaderCache->Initialize(mpLogFile, cacheDir, numThreads));
+
+	return TRUE;
 }
 
-ShaderManager::D3D12ShaderInfo::D3D12ShaderInfo(const D3D12ShaderInfo& ref) {
-	FileName = ref.FileName;
-	EntryPoint = ref.EntryPoint;
-	TargetProfile = ref.TargetProfile;
-	DefineCount = ref.DefineCount;
+void ShaderManager::CleanUp() {
+	if (mbCleanedUp) return;
 
-	if (ref.Defines != nullptr) {
-		Defines = new DxcDefine[ref.DefineCount];
+	for (auto& compiler : mCompilers) 
+		if (compiler) compiler.Reset();
 
-		for (UINT32 i = 0; i < ref.DefineCount; ++i) {
-			{
-				const auto Name = ref.Defines[i].Name;
-				const auto NameLen = wcslen(Name) + 1;
+	for (auto& util : mUtils) 
+		if (util) util.Reset();
 
-				auto newName = new WCHAR[NameLen];
-				wcscpy_s(newName, NameLen, Name);
+	if (mShaderCache) {
+		mShaderCache->CleanUp();
+		mShaderCache.reset();
+	}
 
-				Defines[i].Name = newName;
-			}
+	mShaderKeys.clear();
+	mArchiveEntries.clear();
+	mArchiveData.clear();
+	mDependencies.clear();
+	mCompileErrors.clear();
+	mStagingShaders.clear();
+	mShaderInfos.clear();
+	mShaders.clear();
+	mCompilers.clear();
+	mUtils.clear();
+
+	mpLogFile = nullptr;
+	mbCleanedUp = TRUE;
+}
+
+BOOL ShaderManager::LoadManifest(LPCWSTR filePath) {
+	std::wifstream fin(filePath);
+	if (!fin.is_open()) {
+		std::wstring msg(L"Failed to open shader manifest: ");
+		msg.append(filePath);
+		ReturnFalse(mpLogFile, msg);
+	}
 
-			if (ref.Defines[i].Value != nullptr) {
-				const auto Value = ref.Defines[i].Value;
-				const auto ValueLen = wcslen(Value) + 1;
+	std::wstring line{};
+	for (UINT lineNumber = 1; std::getline(fin, line); ++lineNumber) {
+		const auto Comment = line.find(L'#');
+		if (Comment != std::wstring::npos) line.erase(Comment);
 
-				auto newValue = new WCHAR[ValueLen];
-				wcscpy_s(newValue, ValueLen, Value);
+		std::wstringstream wsstream(line);
 
-				Defines[i].Value = newValue;
+		ShaderPermutations permutations{};
+		if (!(wsstream >> permutations.Name)) continue;
+
+		if (!(wsstream >> permutations.FileName >> permutations.EntryPoint >> permutations.TargetProfile)) {
+			std::wstringstream msg{};
+			msg << L"Shader manifest line " << lineNumber << L" is missing fields: " << permutations.Name;
+			ReturnFalse(mpLogFile, msg.str());
+		}
+
+		if (permutations.EntryPoint == L"-") permutations.EntryPoint.clear();
+
+		std::wstring define{};
+		while (wsstream >> define) {
+			const auto Assign = define.find(L'=');
+			if (Assign == std::wstring::npos || Assign == 0 || Assign + 1 == define.size()) {
+				std::wstringstream msg{};
+				msg << L"Shader manifest line " << lineNumber << L" has a malformed define: " << define;
+				ReturnFalse(mpLogFile, msg.str());
 			}
+
+			ShaderPermutations::DefineAxis axis{};
+			axis.Name = define.substr(0, Assign);
+
+			std::wstringstream values(define.substr(Assign + 1));
+			for (std::wstring value{}; std::getline(values, value, L',');) 
+				axis.Values.push_back(value);
+
+			permutations.Axes.push_back(std::move(axis));
 		}
+
+		CheckReturn(mpLogFile, AddShaders(permutations));
 	}
+
+	return TRUE;
 }
 
-ShaderManager::D3D12ShaderInfo::~D3D12ShaderInfo() {
-	if (Defines != nullptr) {
-		for (UINT32 i = 0; i < DefineCount; ++i) {
-	
-			delete[] Defines[i].Name;
-			if (Defines[i].Value != nullptr) delete[] Defines[i].Value;
+BOOL ShaderManager::AddShaders(const ShaderPermutations& permutations) {
+	UINT count = 1;
+	for (const auto& axis : permutations.Axes) 
+		count *= static_cast<UINT>(axis.Values.size());
+
+	const UINT AxisCount = static_cast<UINT>(permutations.Axes.size());
+	std::vector<DxcDefine> defines(AxisCount);
+
+	for (UINT index = 0; index < count; ++index) {
+		UINT remainder = index;
+		for (UINT axis = AxisCount; axis-- > 0;) {
+			const auto& Values = permutations.Axes[axis].Values;
+			const UINT ValueCount = static_cast<UINT>(Values.size());
+
+			defines[axis].Name = permutations.Axes[axis].Name.c_str();
+			defines[axis].Value = Values[remainder % ValueCount].c_str();
+			remainder /= ValueCount;
 		}
-	
-		delete[] Defines;
+
+		const auto shaderInfo = D3D12ShaderInfo(
+			permutations.FileName.c_str(), 
+			permutations.EntryPoint.c_str(), 
+			permutations.TargetProfile.c_str(), 
+			defines.data(), 
+			AxisCount);
+		CheckReturn(mpLogFile, AddShader(NameKey(permutations.Name.c_str(), index), shaderInfo));
 	}
+
+	return TRUE;
+}
+
+BOOL ShaderManager::CompileShaders(LPCWSTR baseDir) {
+	std::vector<Common::Foundation::Hash> hashes{};
+	for (const auto& shaderInfo : mShaderInfos) 
+		hashes.push_back(shaderInfo.first);
+
+	CheckReturn(mpLogFile, CompileShaders(hashes, baseDir));
+
+	return TRUE;
 }
 
-Render::DX::Shading::Util::ShaderManager::D3D12ShaderInfo& ShaderManager::D3D12ShaderInfo::operator=(
-		const D3D12ShaderInfo& ref) {
-	if (this != &ref) {
-		FileName = ref.FileName;
-		EntryPoint = ref.EntryPoint;
-		TargetProfile = ref.TargetProfile;
-		DefineCount = ref.DefineCount;
-
-		if (ref.Defines != nullptr) {
-			Defines = new DxcDefine[ref.DefineCount];
-			for (UINT32 i = 0; i < ref.DefineCount; ++i) {
-				{
-					const auto Name = ref.Defines[i].Name;
-					const auto NameLen = wcslen(Name) + 1;
-
-					auto newName = new WCHAR[NameLen];
-					wcscpy_s(newName, NameLen, Name);
-
-					Defines[i].Name = newName;
-				}
-				if (ref.Defines[i].Value != nullptr) {
-					const auto Value = ref.Defines[i].Value;
-					const auto ValueLen = wcslen(Value) + 1;
-
-					auto newValue = new WCHAR[ValueLen];
-					wcscpy_s(newValue, ValueLen, Value);
-
-					Defines[i].Value = newValue;
-				}
+BOOL ShaderManager::ReloadModifiedShaders(LPCWSTR baseDir, std::vector<Common::Foundation::Hash>& reloaded) {
+	reloaded.clear();
+
+	for (const auto& dependency : mDependencies) {
+		for (const auto& file : dependency.second) {
+			std::error_code ec{};
+			if (std::filesystem::last_write_time(file.Path, ec) != file.WriteTime) {
+				reloaded.push_back(dependency.first);
+				break;
 			}
 		}
 	}
 
-	return *this;
+	if (reloaded.empty()) return TRUE;
+
+	CheckReturn(mpLogFile, CompileShaders(reloaded, baseDir));
+
+	return TRUE;
 }
 
-ShaderManager::ShaderManager() {}
+BOOL ShaderManager::CompileShaders(const std::vector<Common::Foundation::Hash>& hashes, LPCWSTR baseDir) {
+	const auto Begin = std::chrono::steady_clock::now();
+	if (mShaderCache) mShaderCache->ResetCounters();
+	mArchiveHitCount = 0;
+
+	// Workers claim shaders through a shared counter and each uses only its
+	// own compiler, so nothing on the compile path takes a lock. A failing
+	// shader does not stop its worker.
+	const UINT ShaderCount = static_cast<UINT>(hashes.size());
+	const UINT WorkerCount = std::min(mThreadCount, ShaderCount);
+
+	std::atomic<UINT> next{};
+	std::vector<std::future<BOOL>> workers{};
+
+	for (UINT worker = 0; worker < WorkerCount; ++worker) {
+		workers.emplace_back(std::async(std::launch::async, [&, worker]() -> BOOL {
+			BOOL status = TRUE;
+			for (UINT index = next++; index < ShaderCount; index = next++) 
+				status = CompileShader(worker, hashes[index], baseDir) && status;
+			return status;
+		}));
+	}
 
-ShaderManager::~ShaderManager() { CleanUp(); }
+	BOOL status = TRUE;
+	for (auto& worker : workers) 
+		status = worker.get() && status;
 
-BOOL ShaderManager::Initialize(Common::Debug::LogFile* const pLogFile, UINT numThreads) {
-	mpLogFile = pLogFile;
-	mThreadCount = numThreads;
+	CheckReturn(mpLogFile, ReportCompileErrors());
+	if (!status) ReturnFalse(mpLogFile, L"Failed to compile shaders");
 
-	mUtils.resize(numThreads);
-	mCompilers.resize(numThreads);
-	mCompileMutexes.resize(numThreads);
-	mStagingShaders.resize(numThreads);
+	CheckReturn(mpLogFile, CommitShaders());
 
-	for (UINT i = 0; i < numThreads; ++i) {
-		CheckHRESULT(mpLogFile, DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&mUtils[i])));
-		CheckHRESULT(mpLogFile, DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&mCompilers[i])));
-		mCompileMutexes[i] = std::make_unique<std::mutex>();
+	const auto Elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - Begin).count();
+	if (mShaderCache) {
+		Logln(mpLogFile, std::format("Shaders: {} loaded from archive, {} from cache, {} compiled in {} ms", 
+			mArchiveHitCount.load(), mShaderCache->HitCount(), mShaderCache->MissCount(), Elapsed));
+	}
+	else {
+		Logln(mpLogFile, std::format("Shaders: {} loaded from archive in {} ms", mArchiveHitCount.load(), Elapsed));
 	}
 
 	return TRUE;
 }
 
-void ShaderManager::CleanUp() {
-	if (mbCleanedUp) return;
+BOOL ShaderManager::LoadArchive(LPCWSTR filePath) {
+	mArchiveData.clear();
+	mArchiveEntries.clear();
 
-	for (UINT i = 0; i < mThreadCount; ++i) {
-		mCompileMutexes[i].reset();
+	std::ifstream fin(filePath, std::ios::ate | std::ios::binary);
+	if (!fin.is_open()) return TRUE;
 
-		auto& compiler = mCompilers[i];
-		if (compiler) compiler.Reset();
+	const size_t FileSize = static_cast<size_t>(fin.tellg());
+	std::vector<CHAR> data(FileSize);
 
-		auto& util = mUtils[i];
-		if (util) util.Reset();
-	}	
+	fin.seekg(0);
+	fin.read(data.data(), FileSize);
+	fin.close();
 
-	mStagingShaders.clear();
-	mShaderInfos.clear();
-	mShaders.clear();
-	mCompileMutexes.clear();
-	mCompilers.clear();
-	mUtils.clear();
+	if (FileSize < sizeof(ArchiveHeader)) ReturnFalse(mpLogFile, L"Shader archive is truncated");
 
-	mpLogFile = nullptr;
-	mbCleanedUp = TRUE;
-}
+	ArchiveHeader header{};
+	std::memcpy(&header, data.data(), sizeof(ArchiveHeader));
 
-BOOL ShaderManager::AddShader(const D3D12ShaderInfo& shaderInfo, Common::Foundation::Hash& hash) {
-	std::hash<D3D12ShaderInfo> hasher{};
-	hash = hasher(shaderInfo);
+	// An archive from an older layout is simply rebuilt, which only a
+	// build that compiles sources can do.
+	if (header.Magic != ArchiveMagic || header.Version != ArchiveVersion) {
+		if (!mbCompileSources) ReturnFalse(mpLogFile, L"Shader archive is out of date; rebuild the ShaderCooker project");
+		return TRUE;
+	}
 
-	if (mShaders.find(hash) != mShaders.end())
-		ReturnFalse(mpLogFile, L"The shader is already existed or hash collision occured");
+	const size_t DataOffset = sizeof(ArchiveHeader) + static_cast<size_t>(header.EntryCount) * sizeof(ArchiveRecord);
+	if (FileSize < DataOffset) ReturnFalse(mpLogFile, L"Shader archive is truncated");
 
-	mShaderInfos[hash] = shaderInfo;
+	const auto Records = reinterpret_cast<const ArchiveRecord*>(data.data() + sizeof(ArchiveHeader));
+	for (UINT64 i = 0; i < header.EntryCount; ++i) {
+		const auto& record = Records[i];
+		if (DataOffset + record.Offset + record.Size > FileSize) ReturnFalse(mpLogFile, L"Shader archive is truncated");
+
+		ArchiveEntry entry{};
+		entry.ContentKey = static_cast<Common::Foundation::Hash>(record.ContentKey);
+		entry.Offset = DataOffset + record.Offset;
+		entry.Size = record.Size;
+
+		mArchiveEntries[static_cast<Common::Foundation::Hash>(record.ArchiveKey)] = entry;
+	}
+
+	mArchiveData = std::move(data);
 
 	return TRUE;
 }
 
-BOOL ShaderManager::CompileShaders(LPCWSTR baseDir) {
-	Common::Util::TaskQueue taskQueue{};
+BOOL ShaderManager::WriteArchive(LPCWSTR filePath) {
+	std::vector<ArchiveRecord> records{};
+	records.reserve(mShaders.size());
 
-	for (const auto& shaderInfo : mShaderInfos) 
-		taskQueue.AddTask([&]() -> BOOL { return CompileShader(shaderInfo.first, baseDir); });
+	UINT64 offset = 0;
+	for (const auto& shader : mShaders) {
+		const auto iter = mShaderKeys.find(shader.first);
+		if (iter == mShaderKeys.end() || !shader.second) continue;
 
-	CheckReturn(mpLogFile, taskQueue.ExecuteTasks(mpLogFile, mThreadCount));
+		ArchiveRecord record{};
+		record.ArchiveKey = static_cast<UINT64>(iter->second.ArchiveKey);
+		record.ContentKey = static_cast<UINT64>(iter->second.ContentKey);
+		record.Offset = offset;
+		record.Size = static_cast<UINT64>(shader.second->GetBufferSize());
 
-	CheckReturn(mpLogFile, CommitShaders());
+		records.push_back(record);
+		offset += record.Size;
+	}
+
+	std::ofstream fout(filePath, std::ios::binary | std::ios::trunc);
+	if (!fout.is_open()) {
+		std::wstring msg(L"Failed to open shader archive: ");
+		msg.append(filePath);
+		ReturnFalse(mpLogFile, msg);
+	}
+
+	ArchiveHeader header{};
+	header.Magic = ArchiveMagic;
+	header.Version = ArchiveVersion;
+	header.EntryCount = static_cast<UINT64>(records.size());
+
+	fout.write(reinterpret_cast<const CHAR*>(&header), sizeof(ArchiveHeader));
+	fout.write(reinterpret_cast<const CHAR*>(records.data()), records.size() * sizeof(ArchiveRecord));
+
+	for (const auto& shader : mShaders) {
+		if (mShaderKeys.find(shader.first) == mShaderKeys.end() || !shader.second) continue;
+
+		fout.write(reinterpret_cast<const CHAR*>(shader.second->GetBufferPointer()), shader.second->GetBufferSize());
+	}
+
+	WLogln(mpLogFile, L"Shader archive written: ", filePath);
 
 	return TRUE;
 }
 
-BOOL ShaderManager::CompileShader(Common::Foundation::Hash hash, LPCWSTR baseDir) {
-	const auto shaderInfo = mShaderInfos[hash];
+BOOL ShaderManager::CompileShader(UINT worker, Common::Foundation::Hash hash, LPCWSTR baseDir) {
+	const auto& shaderInfo = mShaderInfos.at(hash);
+
+	StagedShader staged{};
+	staged.Hash = hash;
+	staged.Key.ArchiveKey = BuildArchiveKey(shaderInfo);
+
+	// Shipped builds never look at the sources; the cook step keeps the
+	// archive in step with them.
+	if (!mbCompileSources) {
+		CheckReturn(mpLogFile, LoadFromArchive(mUtils[worker].Get(), staged.Key, FALSE, staged.Blob));
+		if (!staged.Blob) {
+			std::wstringstream msg{};
+			msg << L"Shader is missing from the archive: " << shaderInfo.FileName << L' ' << shaderInfo.EntryPoint 
+				<< L" (rebuild the ShaderCooker project)";
+			ReturnFalse(mpLogFile, msg.str());
+		}
+
+		mStagingShaders[worker].push_back(std::move(staged));
+		return TRUE;
+	}
 
 	std::wstringstream wsstream{};
 	wsstream << baseDir << shaderInfo.FileName;
 	std::wstring filePath = wsstream.str();
 
-	std::ifstream fin(filePath.c_str(), std::ios::ate | std::ios::binary);
-	if (!fin.is_open()) { 
-		std::wstring msg(L"Failed to open shader file: ");
-		msg.append(filePath.c_str());
-		ReturnFalse(mpLogFile, msg);
+	std::error_code ec{};
+	const BOOL SourceExists = std::filesystem::exists(filePath, ec);
+
+	if (SourceExists) {
+		Common::Foundation::Hash sourceHash{};
+		CheckReturn(mpLogFile, mShaderCache->HashSource(worker, filePath, sourceHash, staged.Dependencies));
+
+		staged.Key.ContentKey = BuildCacheKey(staged.Key.ArchiveKey, sourceHash);
 	}
-	
-	size_t fileSize = static_cast<size_t>(fin.tellg());
-	if (fileSize == 0) ReturnFalse(mpLogFile, "Shader file is empty");
 
-	std::vector<CHAR> data(fileSize);
-	
-	fin.seekg(0);
-	fin.read(data.data(), fileSize);
-	fin.close();
+	auto& staging = mStagingShaders[worker];
 
 	ComPtr<IDxcResult> result{};
 	{
-		UINT tid = 0;
-		std::unique_lock<std::mutex> compileLock;
-		for (; tid < mThreadCount; ++tid) {
-			compileLock = std::unique_lock<std::mutex>(*mCompileMutexes[tid], std::defer_lock);
-			if (compileLock.try_lock()) break;
+		const auto& utils = mUtils[worker];
+		const auto& compiler = mCompilers[worker];
+
+		CheckReturn(mpLogFile, LoadFromArchive(utils.Get(), staged.Key, SourceExists, staged.Blob));
+		if (staged.Blob) {
+			staging.push_back(std::move(staged));
+			return TRUE;
+		}
+		if (!SourceExists) {
+			std::wstring msg(L"Shader is neither archived nor found on disk: ");
+			msg.append(filePath);
+			ReturnFalse(mpLogFile, msg);
+		}
+
+		CheckReturn(mpLogFile, mShaderCache->Load(staged.Key.ContentKey, utils.Get(), staged.Blob));
+		if (staged.Blob) {
+			staging.push_back(std::move(staged));
+			return TRUE;
+		}
+
+		std::ifstream fin(filePath.c_str(), std::ios::ate | std::ios::binary);
+		if (!fin.is_open()) { 
+			std::wstring msg(L"Failed to open shader file: ");
+			msg.append(filePath.c_str());
+			ReturnFalse(mpLogFile, msg);
 		}
-		if (tid == mThreadCount) ReturnFalse(mpLogFile, L"Failed to acquire shader compile mutex");
+	
+		size_t fileSize = static_cast<size_t>(fin.tellg());
+		if (fileSize == 0) ReturnFalse(mpLogFile, "Shader file is empty");
 
-		const auto& utils = mUtils[tid];
-		const auto& compiler = mCompilers[tid];
+		std::vector<CHAR> data(fileSize);
+	
+		fin.seekg(0);
+		fin.read(data.data(), fileSize);
+		fin.close();
 
 		ComPtr<IDxcBlobEncoding> shaderText{};
 		CheckHRESULT(mpLogFile, utils->CreateBlob(data.data(), static_cast<UINT32>(fileSize), 0, &shaderText));
@@ -272,7 +514,7 @@ BOOL ShaderManager::CompileShader(Common::Foundation::Hash hash, LPCWSTR baseDir
 		HRESULT hr{};
 		CheckHRESULT(mpLogFile, result->GetStatus(&hr));
 		if (FAILED(hr)) {
-			IDxcBlobEncoding* error{};
+			ComPtr<IDxcBlobEncoding> error{};
 			CheckHRESULT(mpLogFile, result->GetErrorBuffer(&error));
 
 			auto bufferSize = error->GetBufferSize();
@@ -280,23 +522,27 @@ BOOL ShaderManager::CompileShader(Common::Foundation::Hash hash, LPCWSTR baseDir
 			std::memcpy(infoLog.data(), error->GetBufferPointer(), bufferSize);
 			infoLog[bufferSize] = 0;
 
-			std::string errorMsg = "Shader Compiler Error:\n";
-			errorMsg.append(infoLog.data());
+			std::string errorMsg(infoLog.data());
+
+			std::wstring errorMsgW(filePath);
+			errorMsgW.append(L":\n");
+			errorMsgW.append(errorMsg.begin(), errorMsg.end());
 
-			std::wstring errorMsgW{};
-			errorMsgW.assign(errorMsg.begin(), errorMsg.end());
+			// Reported together with every other failure once all workers finish.
+			mCompileErrors[worker].push_back(std::move(errorMsgW));
 
-			ReturnFalse(mpLogFile, errorMsgW);
+			return FALSE;
 		}
 
 #ifdef _DEBUG
 		CheckReturn(mpLogFile, BuildPdb(result.Get(), filePath.c_str()));
 #endif
 
-		ComPtr<IDxcBlob> newShader{};
-		CheckHRESULT(mpLogFile, result->GetResult(&newShader));
+		CheckHRESULT(mpLogFile, result->GetResult(&staged.Blob));
 
-		mStagingShaders[tid].emplace_back(hash, std::move(newShader));
+		CheckReturn(mpLogFile, mShaderCache->Store(staged.Key.ContentKey, staged.Blob.Get()));
+
+		staging.push_back(std::move(staged));
 	}
 
 	return TRUE;
@@ -306,13 +552,114 @@ BOOL ShaderManager::CommitShaders() {
 	for (UINT i = 0; i < mThreadCount; ++i) {
 		auto& shaders = mStagingShaders[i];
 
-		for (auto& shader : shaders) 
-			mShaders[shader.first] = shader.second;
+		for (auto& shader : shaders) {
+			mShaders[shader.Hash] = std::move(shader.Blob);
+			mShaderKeys[shader.Hash] = shader.Key;
+			if (!shader.Dependencies.empty()) mDependencies[shader.Hash] = std::move(shader.Dependencies);
+		}
+
+		shaders.clear();
 	}
 
 	return TRUE;
 }
 
+BOOL ShaderManager::ReportCompileErrors() {
+	UINT errorCount = 0;
+	std::wstringstream wsstream{};
+
+	for (auto& errors : mCompileErrors) {
+		for (const auto& error : errors) {
+			wsstream << L'\n' << error;
+			++errorCount;
+		}
+		errors.clear();
+	}
+
+	if (errorCount == 0) return TRUE;
+
+	std::wstringstream msg{};
+	msg << L"Shader Compiler Error: " << errorCount << L" shader(s) failed to compile" << wsstream.str();
+	ReturnFalse(mpLogFile, msg.str());
+}
+
+BOOL ShaderManager::LoadFromArchive(
+		IDxcUtils* const pUtils,
+		ShaderKey& key,
+		BOOL bCheckContent,
+		ComPtr<IDxcBlob>& blob) {
+	blob.Reset();
+
+	const auto iter = mArchiveEntries.find(key.ArchiveKey);
+	if (iter == mArchiveEntries.end()) return TRUE;
+
+	const auto& entry = iter->second;
+	if (bCheckContent && entry.ContentKey != key.ContentKey) return TRUE;
+
+	ComPtr<IDxcBlobEncoding> encoding{};
+	CheckHRESULT(mpLogFile, pUtils->CreateBlob(
+		mArchiveData.data() + entry.Offset, static_cast<UINT32>(entry.Size), 0, &encoding));
+	CheckHRESULT(mpLogFile, encoding.As(&blob));
+
+	// Keeps the entry valid when the archive is rewritten without sources.
+	key.ContentKey = entry.ContentKey;
+	++mArchiveHitCount;
+
+	return TRUE;
+}
+
+Common::Foundation::Hash ShaderManager::NameKey(LPCWSTR name, UINT permutation) {
+	const auto Key = Common::Util::HashUtil::HashBytes(name, wcslen(name) * sizeof(WCHAR));
+	return Common::Util::HashUtil::HashCombine(Key, permutation);
+}
+
+BOOL ShaderManager::AddShader(Common::Foundation::Hash hash, const D3D12ShaderInfo& shaderInfo) {
+	if (mShaderInfos.find(hash) != mShaderInfos.end())
+		ReturnFalse(mpLogFile, L"The shader is already existed or hash collision occured");
+
+	// The registry owns its own copy of the strings; compiling only ever
+	// reads it.
+	mShaderInfos.insert_or_assign(hash, D3D12ShaderInfo(
+		shaderInfo.FileName, 
+		shaderInfo.EntryPoint, 
+		shaderInfo.TargetProfile, 
+		shaderInfo.Defines, 
+		shaderInfo.DefineCount));
+
+	return TRUE;
+}
+
+Common::Foundation::Hash ShaderManager::BuildArchiveKey(const D3D12ShaderInfo& shaderInfo) const {
+	// Hashes string contents so the key is stable across runs and tools.
+	const auto HashString = [](LPCWSTR str) -> Common::Foundation::Hash {
+		if (str == nullptr) return 0;
+		return Common::Util::HashUtil::HashBytes(str, wcslen(str) * sizeof(WCHAR));
+	};
+
+	auto key = HashString(shaderInfo.FileName);
+	key = Common::Util::HashUtil::HashCombine(key, HashString(shaderInfo.EntryPoint));
+	key = Common::Util::HashUtil::HashCombine(key, HashString(shaderInfo.TargetProfile));
+	for (UINT32 i = 0; i < shaderInfo.DefineCount; ++i) {
+		key = Common::Util::HashUtil::HashCombine(key, HashString(shaderInfo.Defines[i].Name));
+		key = Common::Util::HashUtil::HashCombine(key, HashString(shaderInfo.Defines[i].Value));
+	}
+	key = Common::Util::HashUtil::HashCombine(key, shaderInfo.DefineCount);
+
+	return key;
+}
+
+Common::Foundation::Hash ShaderManager::BuildCacheKey(
+		Common::Foundation::Hash archiveKey, Common::Foundation::Hash sourceHash) const {
+	auto key = Common::Util::HashUtil::HashCombine(archiveKey, sourceHash);
+	key = Common::Util::HashUtil::HashCombine(key, mCompilerHash);
+
+#ifdef _DEBUG
+	key = Common::Util::HashUtil::HashCombine(key, 1);
+#endif
+
+	return key;
+}
+
 BOOL ShaderManager::BuildPdb(IDxcResult* const result, LPCWSTR fileName) {
 	ComPtr<IDxcBlob> pdbBlob{};
 	ComPtr<IDxcBlobUtf16> debugDataPath{};
@@ -1,7 +1,9 @@
 #include "Render/DX/Foundation/Core/pch_d3d12.h"
 #include "Render/DX/Shading/Util/ShadingObjectManager.hpp"
 #include "Common/Debug/Logger.hpp"
-#include "Render/DX/Shading/Util/ShaderManager.hpp"
+
+#include <atomic>
+#include <future>
 
 using namespace Render::DX::Shading::Util;
 
@@ -52,15 +54,6 @@ UINT ShadingObjectManager::DsvDescCount() const {
 	return count;
 }
 
-BOOL ShadingObjectManager::CompileShaders(Shading::Util::ShaderManager* const pShaderManager, LPCWSTR baseDir) {
-	for (const auto& object : mShadingObjects)
-		CheckReturn(mpLogFile, object->CompileShaders());
-
-	CheckReturn(mpLogFile, pShaderManager->CompileShaders(baseDir));
-
-	return TRUE;
-}
-
 BOOL ShadingObjectManager::BuildRootSignatures() {
 	for (const auto& object : mShadingObjects)
 		CheckReturn(mpLogFile, object->BuildRootSignatures());
@@ -68,9 +61,27 @@ BOOL ShadingObjectManager::BuildRootSignatures() {
 	return TRUE;
 }
 
-BOOL ShadingObjectManager::BuildPipelineStates() {
-	for (const auto& object : mShadingObjects)
-		CheckReturn(mpLogFile, object->BuildPipelineStates());
+BOOL ShadingObjectManager::BuildPipelineStates(UINT numThreads) {
+	const UINT ObjectCount = static_cast<UINT>(mShadingObjects.size());
+	const UINT WorkerCount = std::max(std::min(numThreads, ObjectCount), 1u);
+
+	std::atomic<UINT> next{};
+	std::vector<std::future<BOOL>> workers{};
+
+	for (UINT i = 0; i < WorkerCount; ++i) {
+		workers.emplace_back(std::async(std::launch::async, [&]() -> BOOL {
+			BOOL status = TRUE;
+			for (UINT index = next++; index < ObjectCount; index = next++) 
+				status = mShadingObjects[index]->BuildPipelineStates() && status;
+			return status;
+		}));
+	}
+
+	BOOL status = TRUE;
+	for (auto& worker : workers) 
+		status = worker.get() && status;
+
+	if (!status) ReturnFalse(mpLogFile, L"Failed to build pipeline states");
 
 	return TRUE;
 }
@@ -101,4 +112,9 @@ BOOL ShadingObjectManager::Update() {
 		CheckReturn(mpLogFile, object->Update());
 
 	return TRUE;
+}
+
+void ShadingObjectManager::SetRenderArea(UINT width, UINT height, const DirectX::XMFLOAT2& uvScale) {
+	for (const auto& object : mShadingObjects)
+		object->SetRenderArea(width, height, uvScale);
 }
\ No newline at end of file
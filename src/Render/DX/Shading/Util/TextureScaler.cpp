@@ -12,10 +12,6 @@
 
 using namespace Render::DX::Shading::Util;
 
-namespace {
-	const WCHAR* const HLSL_DownSample2Nx2N = L"DownSample2Nx2N.hlsl";
-}
-
 TextureScaler::InitDataPtr TextureScaler::MakeInitData() {
 	return std::unique_ptr<TextureScalerClass::InitData>(new TextureScalerClass::InitData());
 }
@@ -51,35 +47,6 @@ void TextureScaler::TextureScalerClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL TextureScaler::TextureScalerClass::CompileShaders() {
-	// DownSample2x2
-	{
-		DxcDefine defines[] = { { L"KERNEL_RADIUS", L"1" } };
-
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_DownSample2Nx2N, L"CS", L"cs_6_5", defines, _countof(defines));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_DownSample2x2]));
-	}
-	// DownSample4x4
-	{
-		DxcDefine defines[] = { { L"KERNEL_RADIUS", L"2" } };
-
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_DownSample2Nx2N, L"CS", L"cs_6_5", defines, _countof(defines));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_DownSample4x4]));
-	}
-	// DownSample6x6
-	{
-		DxcDefine defines[] = { { L"KERNEL_RADIUS", L"3" } };
-
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(
-			HLSL_DownSample2Nx2N, L"CS", L"cs_6_5", defines, _countof(defines));
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_DownSample6x6]));
-	}
-
-	return TRUE;
-}
-
 BOOL TextureScaler::TextureScalerClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
@@ -122,7 +89,7 @@ BOOL TextureScaler::TextureScalerClass::BuildPipelineStates() {
 		// 2x2
 		{
 			{
-				const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_DownSample2x2]);
+				const auto CS = mInitData.ShaderManager->GetShader(L"TextureScaler.CS_DownSample2x2");
 				NullCheck(mpLogFile, CS);
 				psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 			}
@@ -136,7 +103,7 @@ BOOL TextureScaler::TextureScalerClass::BuildPipelineStates() {
 		// 4x4
 		{
 			{
-				const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_DownSample4x4]);
+				const auto CS = mInitData.ShaderManager->GetShader(L"TextureScaler.CS_DownSample4x4");
 				NullCheck(mpLogFile, CS);
 				psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 			}
@@ -150,7 +117,7 @@ BOOL TextureScaler::TextureScalerClass::BuildPipelineStates() {
 		// 6x6
 		{
 			{
-				const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_DownSample6x6]);
+				const auto CS = mInitData.ShaderManager->GetShader(L"TextureScaler.CS_DownSample6x6");
 				NullCheck(mpLogFile, CS);
 				psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 			}
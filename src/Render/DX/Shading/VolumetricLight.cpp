@@ -13,13 +13,6 @@
 
 using namespace Render::DX::Shading;
 
-namespace {
-	const WCHAR* const HLSL_CalculateScatteringAndDensity = L"CalculateScatteringAndDensity.hlsl";
-	const WCHAR* const HLSL_AccumulateSacttering = L"AccumulateSacttering.hlsl";
-	const WCHAR* const HLSL_BlendScattering = L"BlendScattering.hlsl";
-	const WCHAR* const HLSL_ApplyFog = L"ApplyFog.hlsl";
-}
-
 VolumetricLight::InitDataPtr VolumetricLight::MakeInitData() {
 	return std::unique_ptr<VolumetricLightClass::InitData>(new VolumetricLightClass::InitData());
 }
@@ -69,53 +62,13 @@ void VolumetricLight::VolumetricLightClass::CleanUp() {
 	mbCleanedUp = TRUE;
 }
 
-BOOL VolumetricLight::VolumetricLightClass::CompileShaders() {
-	// CalculateScatteringAndDensity
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_CalculateScatteringAndDensity, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_CalculateScatteringAndDensity]));
-	}
-	// AccumulateScattering
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_AccumulateSacttering, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_AccumulateScattering]));
-	}
-	// BlendScattering
-	{
-		const auto CS = Util::ShaderManager::D3D12ShaderInfo(HLSL_BlendScattering, L"CS", L"cs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(CS, mShaderHashes[Shader::CS_BlendScattering]));
-	}
-	// ApplyFog
-	{
-		const auto VS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ApplyFog, L"VS", L"vs_6_5");
-		CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(VS, mShaderHashes[Shader::VS_ApplyFog]));
-
-		// Default
-		{
-			const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ApplyFog, L"PS", L"ps_6_5");
-			CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ApplyFog]));
-		}
-		// Tricubic Sampling
-		{
-			DxcDefine defines[] = {
-				{ L"TriCubicSampling", L"1" },
-			};
-			const auto PS = Util::ShaderManager::D3D12ShaderInfo(HLSL_ApplyFog, L"PS", L"ps_6_5", defines, _countof(defines));
-			CheckReturn(mpLogFile, mInitData.ShaderManager->AddShader(PS, mShaderHashes[Shader::PS_ApplyFog_Tricubic]));
-		}
-	}
-
-	return TRUE;
-}
-
 BOOL VolumetricLight::VolumetricLightClass::BuildRootSignatures() {
 	decltype(auto) samplers = Util::SamplerUtil::GetStaticSamplers();
 
 	// CalculateScatteringAndDensity
 	{
-		CD3DX12_DESCRIPTOR_RANGE texTables[3]{}; UINT index = 0;
-		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, MaxLights, 0, 0);
-		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, MaxLights, 0, 1);
+		CD3DX12_DESCRIPTOR_RANGE texTables[2]{}; UINT index = 0;
+		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
 		texTables[index++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0, 0);
 
 		index = 0;
@@ -125,8 +78,7 @@ BOOL VolumetricLight::VolumetricLightClass::BuildRootSignatures() {
 		slotRootParameter[RootSignature::CalculateScatteringAndDensity::CB_Light].InitAsConstantBufferView(1);
 		slotRootParameter[RootSignature::CalculateScatteringAndDensity::RC_Consts].InitAsConstants(
 			ShadingConvention::VolumetricLight::RootConstant::CalculateScatteringAndDensity::Count, 2);
-		slotRootParameter[RootSignature::CalculateScatteringAndDensity::SI_ZDepthMaps].InitAsDescriptorTable(1, &texTables[index++]);
-		slotRootParameter[RootSignature::CalculateScatteringAndDensity::SI_ZDepthCubeMaps].InitAsDescriptorTable(1, &texTables[index++]);
+		slotRootParameter[RootSignature::CalculateScatteringAndDensity::SI_ZDepthAtlas].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::CalculateScatteringAndDensity::UO_FrustumVolumeMap].InitAsDescriptorTable(1, &texTables[index++]);
 
 		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
@@ -171,6 +123,8 @@ BOOL VolumetricLight::VolumetricLightClass::BuildRootSignatures() {
 		index = 0;
 
 		CD3DX12_ROOT_PARAMETER slotRootParameter[RootSignature::BlendScattering::Count]{};
+		slotRootParameter[RootSignature::BlendScattering::RC_Consts].InitAsConstants(
+			ShadingConvention::VolumetricLight::RootConstant::BlendScattering::Count, 0);
 		slotRootParameter[RootSignature::BlendScattering::SI_PreviousScattering].InitAsDescriptorTable(1, &texTables[index++]);
 		slotRootParameter[RootSignature::BlendScattering::UIO_CurrentScattering].InitAsDescriptorTable(1, &texTables[index++]);
 
@@ -221,7 +175,7 @@ BOOL VolumetricLight::VolumetricLightClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_CalculateScatteringAndDensity].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_CalculateScatteringAndDensity]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"VolumetricLight.CS_CalculateScatteringAndDensity");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -238,7 +192,7 @@ BOOL VolumetricLight::VolumetricLightClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_AccumulateScattering].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_AccumulateScattering]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"VolumetricLight.CS_AccumulateScattering");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -255,7 +209,7 @@ BOOL VolumetricLight::VolumetricLightClass::BuildPipelineStates() {
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_BlendScattering].Get();
 		psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 		{
-			const auto CS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::CS_BlendScattering]);
+			const auto CS = mInitData.ShaderManager->GetShader(L"VolumetricLight.CS_BlendScattering");
 			NullCheck(mpLogFile, CS);
 			psoDesc.CS = { reinterpret_cast<BYTE*>(CS->GetBufferPointer()), CS->GetBufferSize() };
 		}
@@ -271,7 +225,7 @@ BOOL VolumetricLight::VolumetricLightClass::BuildPipelineStates() {
 		D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = Foundation::Util::D3D12Util::FitToScreenPsoDesc();
 		psoDesc.pRootSignature = mRootSignatures[RootSignature::GR_ApplyFog].Get();
 		{
-			const auto VS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::VS_ApplyFog]);
+			const auto VS = mInitData.ShaderManager->GetShader(L"VolumetricLight.VS_ApplyFog");
 			NullCheck(mpLogFile, VS);
 			psoDesc.VS = { reinterpret_cast<BYTE*>(VS->GetBufferPointer()), VS->GetBufferSize() };
 		}
@@ -296,7 +250,7 @@ BOOL VolumetricLight::VolumetricLightClass::BuildPipelineStates() {
 		// Default
 		{
 			{
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ApplyFog]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"VolumetricLight.PS_ApplyFog");
 				NullCheck(mpLogFile, PS);
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
 			}
@@ -309,7 +263,7 @@ BOOL VolumetricLight::VolumetricLightClass::BuildPipelineStates() {
 		// Tricubic Sampling
 		{
 			{
-				const auto PS = mInitData.ShaderManager->GetShader(mShaderHashes[Shader::PS_ApplyFog_Tricubic]);
+				const auto PS = mInitData.ShaderManager->GetShader(L"VolumetricLight.PS_ApplyFog_Tricubic");
 				NullCheck(mpLogFile, PS);
 				psoDesc.PS = { reinterpret_cast<BYTE*>(PS->GetBufferPointer()), PS->GetBufferSize() };
 			}
@@ -339,21 +293,22 @@ BOOL VolumetricLight::VolumetricLightClass::BuildDescriptors(Foundation::Core::D
 
 BOOL VolumetricLight::VolumetricLightClass::BuildFog(
 		Foundation::Resource::FrameResource* const pFrameResource,
-		Foundation::Resource::GpuResource* ppDepthMaps[],
-		D3D12_GPU_DESCRIPTOR_HANDLE si_depthMaps,
+		Foundation::Resource::GpuResource* const pZDepthAtlas,
+		D3D12_GPU_DESCRIPTOR_HANDLE si_zDepthAtlas,
 		FLOAT nearZ, FLOAT farZ, FLOAT depth_exp,
 		FLOAT uniformDensity, FLOAT densityScale, 
 		FLOAT anisotropicCoeff,
-		UINT numLights) {
+		UINT numLights,
+		BOOL bCheckerboardEnabled) {
 	mCurrentFrame = ++mFrameCount % 2 != 0;
 	mPreviousFrame = (mCurrentFrame + 1) % 2;
 
 	CheckReturn(mpLogFile, CalculateScatteringAndDensity(
-		pFrameResource, ppDepthMaps, si_depthMaps, 
-		nearZ, farZ, depth_exp, uniformDensity, anisotropicCoeff, numLights));
+		pFrameResource, pZDepthAtlas, si_zDepthAtlas, 
+		nearZ, farZ, depth_exp, uniformDensity, anisotropicCoeff, numLights, bCheckerboardEnabled));
 	CheckReturn(mpLogFile, AccumulateScattering(
-		pFrameResource, nearZ, farZ, depth_exp, densityScale));
-	CheckReturn(mpLogFile, BlendScattering(pFrameResource));
+		pFrameResource, nearZ, farZ, depth_exp, densityScale, bCheckerboardEnabled));
+	CheckReturn(mpLogFile, BlendScattering(pFrameResource, bCheckerboardEnabled));
 
 	return TRUE;
 }
@@ -477,11 +432,12 @@ BOOL VolumetricLight::VolumetricLightClass::BuildDescriptors() {
 
 BOOL VolumetricLight::VolumetricLightClass::CalculateScatteringAndDensity(
 		Foundation::Resource::FrameResource* const pFrameResource,
-		Foundation::Resource::GpuResource* ppDepthMaps[],
-		D3D12_GPU_DESCRIPTOR_HANDLE si_depthMaps,
+		Foundation::Resource::GpuResource* const pZDepthAtlas,
+		D3D12_GPU_DESCRIPTOR_HANDLE si_zDepthAtlas,
 		FLOAT nearZ, FLOAT farZ, FLOAT depth_exp,
 		FLOAT uniformDensity, FLOAT anisotropicCoeff,
-		UINT numLights) {
+		UINT numLights,
+		BOOL bCheckerboardEnabled) {
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
 		0,
@@ -493,8 +449,7 @@ BOOL VolumetricLight::VolumetricLightClass::CalculateScatteringAndDensity(
 	{
 		CmdList->SetComputeRootSignature(mRootSignatures[RootSignature::GR_CalculateScatteringAndDensity].Get());
 	
-		for (UINT i = 0; i < numLights; ++i) 
-			ppDepthMaps[i]->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		pZDepthAtlas->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
 		mFrustumVolumeMaps[mPreviousFrame]->Transite(CmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
@@ -508,9 +463,7 @@ BOOL VolumetricLight::VolumetricLightClass::CalculateScatteringAndDensity(
 			RootSignature::CalculateScatteringAndDensity::CB_Light, 
 			pFrameResource->LightCB.CBAddress());
 		CmdList->SetComputeRootDescriptorTable(
-			RootSignature::CalculateScatteringAndDensity::SI_ZDepthMaps, si_depthMaps);
-		CmdList->SetComputeRootDescriptorTable(
-			RootSignature::CalculateScatteringAndDensity::SI_ZDepthCubeMaps, si_depthMaps);
+			RootSignature::CalculateScatteringAndDensity::SI_ZDepthAtlas, si_zDepthAtlas);
 		CmdList->SetComputeRootDescriptorTable(
 			RootSignature::CalculateScatteringAndDensity::UO_FrustumVolumeMap, mhFrustumVolumeMapGpus[Descriptor::E_Uav][mCurrentFrame]);
 		
@@ -521,6 +474,8 @@ BOOL VolumetricLight::VolumetricLightClass::CalculateScatteringAndDensity(
 		rc.gAnisotropicCoefficient = anisotropicCoeff;
 		rc.gUniformDensity = uniformDensity;
 		rc.gFrameCount = mFrameCount;
+		rc.gCheckerboardEnabled = bCheckerboardEnabled;
+		rc.gEvenColumnsActivated = (mFrameCount & 1) == 0;
 		
 		Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::VolumetricLight::RootConstant::CalculateScatteringAndDensity::Struct>(
 			RootSignature::CalculateScatteringAndDensity::RC_Consts,
@@ -530,9 +485,12 @@ BOOL VolumetricLight::VolumetricLightClass::CalculateScatteringAndDensity(
 			CmdList,
 			TRUE);
 	
+		const UINT ActiveWidth = bCheckerboardEnabled ?
+			Foundation::Util::D3D12Util::CeilDivide(mInitData.TextureWidth, 2) : mInitData.TextureWidth;
+	
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
-				mInitData.TextureWidth, 
+				ActiveWidth, 
 				ShadingConvention::VolumetricLight::ThreadGroup::CalculateScatteringAndDensity::Width),
 			Foundation::Util::D3D12Util::D3D12Util::CeilDivide(
 				mInitData.TextureHeight, 
@@ -549,7 +507,8 @@ BOOL VolumetricLight::VolumetricLightClass::CalculateScatteringAndDensity(
 
 BOOL VolumetricLight::VolumetricLightClass::AccumulateScattering(
 		Foundation::Resource::FrameResource* const pFrameResource,
-		FLOAT nearZ, FLOAT farZ, FLOAT depth_exp, FLOAT densityScale) {
+		FLOAT nearZ, FLOAT farZ, FLOAT depth_exp, FLOAT densityScale,
+		BOOL bCheckerboardEnabled) {
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
 		0,
@@ -569,6 +528,8 @@ BOOL VolumetricLight::VolumetricLightClass::AccumulateScattering(
 		rc.gFarZ = farZ;
 		rc.gDepthExponent = depth_exp;
 		rc.gDensityScale = densityScale;
+		rc.gCheckerboardEnabled = bCheckerboardEnabled;
+		rc.gEvenColumnsActivated = (mFrameCount & 1) == 0;
 
 		Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::VolumetricLight::RootConstant::AccumulateScattering::Struct>(
 			RootSignature::AccumulateScattering::RC_Consts,
@@ -580,9 +541,12 @@ BOOL VolumetricLight::VolumetricLightClass::AccumulateScattering(
 
 		CmdList->SetComputeRootDescriptorTable(RootSignature::AccumulateScattering::UIO_FrustumVolumeMap, mhFrustumVolumeMapGpus[Descriptor::E_Uav][mCurrentFrame]);
 
+		const UINT ActiveWidth = bCheckerboardEnabled ?
+			Foundation::Util::D3D12Util::CeilDivide(mInitData.TextureWidth, 2) : mInitData.TextureWidth;
+
 		CmdList->Dispatch(
 			Foundation::Util::D3D12Util::CeilDivide(
-				static_cast<UINT>(mInitData.TextureWidth), 
+				ActiveWidth, 
 				ShadingConvention::VolumetricLight::ThreadGroup::AccumulateScattering::Width),
 			Foundation::Util::D3D12Util::CeilDivide(
 				static_cast<UINT>(mInitData.TextureHeight), 
@@ -595,7 +559,9 @@ BOOL VolumetricLight::VolumetricLightClass::AccumulateScattering(
 	return TRUE;
 }
 
-BOOL VolumetricLight::VolumetricLightClass::BlendScattering(Foundation::Resource::FrameResource* const pFrameResource) {
+BOOL VolumetricLight::VolumetricLightClass::BlendScattering(
+		Foundation::Resource::FrameResource* const pFrameResource,
+		BOOL bCheckerboardEnabled) {
 	CheckReturn(mpLogFile, mInitData.CommandObject->ResetCommandList(
 		pFrameResource->CommandAllocator(0),
 		0,
@@ -612,6 +578,18 @@ BOOL VolumetricLight::VolumetricLightClass::BlendScattering(Foundation::Resource
 		mFrustumVolumeMaps[mCurrentFrame]->Transite(CmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		Foundation::Util::D3D12Util::UavBarrier(CmdList, mFrustumVolumeMaps[mCurrentFrame].get());
 
+		ShadingConvention::VolumetricLight::RootConstant::BlendScattering::Struct rc;
+		rc.gCheckerboardEnabled = bCheckerboardEnabled;
+		rc.gEvenColumnsActivated = (mFrameCount & 1) == 0;
+
+		Foundation::Util::D3D12Util::SetRoot32BitConstants<ShadingConvention::VolumetricLight::RootConstant::BlendScattering::Struct>(
+			RootSignature::BlendScattering::RC_Consts,
+			ShadingConvention::VolumetricLight::RootConstant::BlendScattering::Count,
+			&rc,
+			0,
+			CmdList,
+			TRUE);
+
 		CmdList->SetComputeRootDescriptorTable(
 			RootSignature::BlendScattering::SI_PreviousScattering, 
 			mhFrustumVolumeMapGpus[Descriptor::E_Srv][mPreviousFrame]);
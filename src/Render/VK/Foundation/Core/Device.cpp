@@ -6,6 +6,10 @@
 
 using namespace Render::VK::Foundation::Core;
 
+namespace {
+	const WCHAR* const PipelineCachePath = L".\\PipelineCache.vk";
+}
+
 Device::Device() {}
 
 Device::~Device() {	CleanUp(); }
@@ -22,7 +26,15 @@ BOOL Device::Initialize(
 }
 
 void Device::CleanUp() {
-	if (mDevice != VK_NULL_HANDLE) vkDestroyDevice(mDevice, nullptr);
+	if (mPipelineCache != VK_NULL_HANDLE) {
+		SavePipelineCache();
+		vkDestroyPipelineCache(mDevice, mPipelineCache, nullptr);
+		mPipelineCache = VK_NULL_HANDLE;
+	}
+	if (mDevice != VK_NULL_HANDLE) {
+		vkDestroyDevice(mDevice, nullptr);
+		mDevice = VK_NULL_HANDLE;
+	}
 }
 
 BOOL Device::SortPhysicalDevices() {
@@ -124,5 +136,82 @@ BOOL Device::CreateLogicalDevice() {
 	if (vkCreateDevice(mPhysicalDevice, &createInfo, nullptr, &mDevice) != VK_SUCCESS)
 		ReturnFalse(mpLogFile, L"Failed to create logical device");
 
+	CheckReturn(mpLogFile, CreatePipelineCache());
+
 	return TRUE;
+}
+
+BOOL Device::CreatePipelineCache() {
+	std::vector<CHAR> data{};
+
+	std::ifstream fin(PipelineCachePath, std::ios::ate | std::ios::binary);
+	if (fin.is_open()) {
+		const size_t FileSize = static_cast<size_t>(fin.tellg());
+		data.resize(FileSize);
+
+		fin.seekg(0);
+		fin.read(data.data(), FileSize);
+		fin.close();
+	}
+
+	// Drivers reject foreign data themselves, but checking the header first
+	// keeps a cache from another GPU or driver out of the log as an error.
+	if (!data.empty()) {
+		VkPhysicalDeviceProperties deviceProperties{};
+		vkGetPhysicalDeviceProperties(mPhysicalDevice, &deviceProperties);
+
+		VkPipelineCacheHeaderVersionOne header{};
+		if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne)) data.clear();
+		else {
+			std::memcpy(&header, data.data(), sizeof(VkPipelineCacheHeaderVersionOne));
+
+			if (header.headerSize < sizeof(VkPipelineCacheHeaderVersionOne)
+				|| header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+				|| header.vendorID != deviceProperties.vendorID
+				|| header.deviceID != deviceProperties.deviceID
+				|| std::memcmp(header.pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+				Logln(mpLogFile, "Discarding pipeline cache built for a different device or driver");
+				data.clear();
+			}
+		}
+	}
+
+	VkPipelineCacheCreateInfo createInfo{};
+	createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	createInfo.initialDataSize = data.size();
+	createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+	if (vkCreatePipelineCache(mDevice, &createInfo, nullptr, &mPipelineCache) != VK_SUCCESS) {
+		// Retry empty; a bad file should cost a warm start, not the device.
+		createInfo.initialDataSize = 0;
+		createInfo.pInitialData = nullptr;
+
+		if (vkCreatePipelineCache(mDevice, &createInfo, nullptr, &mPipelineCache) != VK_SUCCESS)
+			ReturnFalse(mpLogFile, L"Failed to create pipeline cache");
+	}
+
+	return TRUE;
+}
+
+void Device::SavePipelineCache() {
+	size_t size = 0;
+	if (vkGetPipelineCacheData(mDevice, mPipelineCache, &size, nullptr) != VK_SUCCESS || size == 0) return;
+
+	std::vector<CHAR> data(size);
+	if (vkGetPipelineCacheData(mDevice, mPipelineCache, &size, data.data()) != VK_SUCCESS) return;
+
+	const std::filesystem::path path(PipelineCachePath);
+	std::filesystem::path tempPath(path);
+	tempPath += L".tmp";
+
+	{
+		std::ofstream fout(tempPath, std::ios::binary | std::ios::trunc);
+		if (!fout.is_open()) return;
+
+		fout.write(data.data(), size);
+	}
+
+	std::error_code ec{};
+	std::filesystem::rename(tempPath, path, ec);
+	if (ec) std::filesystem::remove(tempPath, ec);
 }
\ No newline at end of file
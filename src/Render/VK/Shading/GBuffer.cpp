@@ -452,7 +452,7 @@ BOOL GBuffer::GBufferClass::BuildPipelineStates() {
 
 	if (vkCreateGraphicsPipelines(
 			mInitData.Device->LogicalDevice(), 
-			VK_NULL_HANDLE, 
+			mInitData.Device->PipelineCache(), 
 			1, 
 			&pipelineInfo,
 			nullptr, 
@@ -0,0 +1,133 @@
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <random>
+
+#include "Common/AccelerationStructure/BVH.h"
+
+using namespace Common::AccelerationStructure;
+
+namespace {
+	struct Soup {
+		std::vector<Vertex> Vertices;
+		std::vector<Triangle> Triangles;
+	};
+
+	// Small triangles scattered through a cube, three unshared vertices each.
+	Soup ScatterTriangles(std::uint32_t count, float extent, float size, std::uint32_t seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> centre(-extent, extent);
+		std::uniform_real_distribution<float> offset(-size, size);
+
+		Soup soup;
+		soup.Vertices.reserve(count * 3);
+		soup.Triangles.resize(count);
+
+		for (std::uint32_t i = 0; i < count; ++i) {
+			const float cx = centre(rng), cy = centre(rng), cz = centre(rng);
+			for (std::uint32_t v = 0; v < 3; ++v)
+				soup.Vertices.emplace_back(cx + offset(rng), cy + offset(rng), cz + offset(rng), 0.f, 1.f, 0.f);
+
+			auto& triangle = soup.Triangles[i];
+			triangle.Index1 = i * 3;
+			triangle.Index2 = i * 3 + 1;
+			triangle.Index3 = i * 3 + 2;
+		}
+
+		return soup;
+	}
+
+	std::vector<std::uint32_t> BruteForceQuery(const Soup& soup, const Vector3Df& bottom, const Vector3Df& top) {
+		std::vector<std::uint32_t> result;
+
+		for (std::uint32_t i = 0, end = static_cast<std::uint32_t>(soup.Triangles.size()); i < end; ++i) {
+			const auto& triangle = soup.Triangles[i];
+			const Vector3Df* corners[] = {
+				&soup.Vertices[triangle.Index1], &soup.Vertices[triangle.Index2], &soup.Vertices[triangle.Index3] };
+
+			Vector3Df b(FLT_MAX, FLT_MAX, FLT_MAX);
+			Vector3Df t(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+			for (const auto* pCorner : corners) {
+				b = Vector3Df(std::min(b.x, pCorner->x), std::min(b.y, pCorner->y), std::min(b.z, pCorner->z));
+				t = Vector3Df(std::max(t.x, pCorner->x), std::max(t.y, pCorner->y), std::max(t.z, pCorner->z));
+			}
+
+			if (b.x <= top.x && t.x >= bottom.x
+				&& b.y <= top.y && t.y >= bottom.y
+				&& b.z <= top.z && t.z >= bottom.z) result.push_back(i);
+		}
+
+		return result;
+	}
+}
+
+TEST_CASE(CacheFriendlyBVH, QueryMatchesBruteForce) {
+	auto soup = ScatterTriangles(3000, 20.f, 0.5f, 5);
+
+	CacheFriendlyBVH bvh;
+	bvh.Build(soup.Vertices.data(), soup.Triangles.data(), static_cast<std::uint32_t>(soup.Triangles.size()));
+
+	std::mt19937 rng(9);
+	std::uniform_real_distribution<float> centre(-22.f, 22.f);
+	std::uniform_real_distribution<float> halfSize(0.f, 6.f);
+
+	std::uint32_t hitCount = 0;
+	std::uint32_t mismatches = 0;
+
+	for (std::uint32_t query = 0; query < 500; ++query) {
+		const float cx = centre(rng), cy = centre(rng), cz = centre(rng);
+		const float h = halfSize(rng);
+		const Vector3Df bottom(cx - h, cy - h, cz - h);
+		const Vector3Df top(cx + h, cy + h, cz + h);
+
+		std::vector<std::uint32_t> found;
+		bvh.Query(bottom, top, found);
+		std::sort(found.begin(), found.end());
+
+		const auto expected = BruteForceQuery(soup, bottom, top);
+		if (found != expected) ++mismatches;
+		hitCount += static_cast<std::uint32_t>(expected.size());
+	}
+
+	CHECK(hitCount > 0);
+	CHECK(mismatches == 0);
+}
+
+TEST_CASE(CacheFriendlyBVH, QueryReportsEachTriangleOnce) {
+	auto soup = ScatterTriangles(1000, 5.f, 0.5f, 21);
+
+	CacheFriendlyBVH bvh;
+	bvh.Build(soup.Vertices.data(), soup.Triangles.data(), static_cast<std::uint32_t>(soup.Triangles.size()));
+
+	std::vector<std::uint32_t> found;
+	bvh.Query(Vector3Df(-100.f, -100.f, -100.f), Vector3Df(100.f, 100.f, 100.f), found);
+	std::sort(found.begin(), found.end());
+
+	REQUIRE(found.size() == soup.Triangles.size());
+	for (std::uint32_t i = 0; i < found.size(); ++i) CHECK(found[i] == i);
+}
+
+TEST_CASE(CacheFriendlyBVH, RebuildReplacesHierarchy) {
+	auto first = ScatterTriangles(200, 5.f, 0.5f, 1);
+	auto second = ScatterTriangles(300, 5.f, 0.5f, 2);
+
+	CacheFriendlyBVH bvh;
+	bvh.Build(first.Vertices.data(), first.Triangles.data(), static_cast<std::uint32_t>(first.Triangles.size()));
+	bvh.Build(second.Vertices.data(), second.Triangles.data(), static_cast<std::uint32_t>(second.Triangles.size()));
+
+	const Vector3Df bottom(-2.f, -2.f, -2.f);
+	const Vector3Df top(2.f, 2.f, 2.f);
+
+	std::vector<std::uint32_t> found;
+	bvh.Query(bottom, top, found);
+	std::sort(found.begin(), found.end());
+
+	CHECK(found == BruteForceQuery(second, bottom, top));
+
+	// An empty build leaves nothing to query.
+	bvh.Build(second.Vertices.data(), second.Triangles.data(), 0);
+	found.clear();
+	bvh.Query(bottom, top, found);
+	CHECK(found.empty());
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <format>
+#include <numeric>
+#include <random>
+
+#include "Common/Util/DrawBatcher.hpp"
+
+using namespace Common::Util;
+
+namespace {
+	UINT64 Bits(UINT64 key, UINT shift, UINT bits) {
+		return (key >> shift) & ((1ull << bits) - 1);
+	}
+}
+
+TEST_CASE(DrawBatcher, PacksFieldsFromPassDown) {
+	const UINT DepthShift = 0;
+	const UINT GeometryShift = DepthShift + DrawBatcher::DepthBits;
+	const UINT MaterialShift = GeometryShift + DrawBatcher::GeometryBits;
+	const UINT PipelineShift = MaterialShift + DrawBatcher::MaterialBits;
+	const UINT PassShift = PipelineShift + DrawBatcher::PipelineBits;
+	CHECK(PassShift + DrawBatcher::PassBits == 64);
+
+	const UINT64 Key = DrawBatcher::MakeKey(3, 200, 4000, 60000, 0.5f);
+	CHECK(Bits(Key, PassShift, DrawBatcher::PassBits) == 3);
+	CHECK(Bits(Key, PipelineShift, DrawBatcher::PipelineBits) == 200);
+	CHECK(Bits(Key, MaterialShift, DrawBatcher::MaterialBits) == 4000);
+	CHECK(Bits(Key, GeometryShift, DrawBatcher::GeometryBits) == 60000);
+
+	const UINT64 DepthMax = (1ull << DrawBatcher::DepthBits) - 1;
+	CHECK(Bits(Key, DepthShift, DrawBatcher::DepthBits) == DepthMax / 2);
+
+	// Out of range fields are truncated and never spill into their neighbours.
+	const UINT64 Wide = DrawBatcher::MakeKey(0x13, 0x1AB, 0x1ABCD, 0x1BCDE, 1.f);
+	CHECK(Bits(Wide, PassShift, DrawBatcher::PassBits) == 0x3);
+	CHECK(Bits(Wide, PipelineShift, DrawBatcher::PipelineBits) == 0xAB);
+	CHECK(Bits(Wide, MaterialShift, DrawBatcher::MaterialBits) == 0xABCD);
+	CHECK(Bits(Wide, GeometryShift, DrawBatcher::GeometryBits) == 0xBCDE);
+	CHECK(Bits(Wide, DepthShift, DrawBatcher::DepthBits) == DepthMax);
+
+	// Depth is clamped to [0, 1].
+	CHECK(DrawBatcher::MakeKey(1, 2, 3, 4, -5.f) == DrawBatcher::MakeKey(1, 2, 3, 4, 0.f));
+	CHECK(DrawBatcher::MakeKey(1, 2, 3, 4, 5.f) == DrawBatcher::MakeKey(1, 2, 3, 4, 1.f));
+
+	// A costlier state outranks every cheaper one.
+	CHECK(DrawBatcher::MakeKey(0, 1, 0, 0, 0.f) > DrawBatcher::MakeKey(0, 0, 0xFFFF, 0xFFFF, 1.f));
+	CHECK(DrawBatcher::MakeKey(0, 0, 1, 0, 0.f) > DrawBatcher::MakeKey(0, 0, 0, 0xFFFF, 1.f));
+}
+
+TEST_CASE(DrawBatcher, SortsLikeAStableSort) {
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<UINT> state(0, 3);
+	std::uniform_real_distribution<FLOAT> depth(0.f, 1.f);
+
+	std::vector<UINT64> keys{};
+	DrawBatcher batcher;
+	for (UINT i = 0; i < 5000; ++i) {
+		// Few distinct states, so many keys tie and stability matters.
+		const UINT64 Key = DrawBatcher::MakeKey(state(rng), state(rng), state(rng), state(rng), std::floor(depth(rng) * 8.f) / 8.f);
+		keys.push_back(Key);
+		batcher.Add(Key, i);
+	}
+	batcher.Build();
+
+	std::vector<UINT> expected(keys.size());
+	std::iota(expected.begin(), expected.end(), 0u);
+	std::stable_sort(expected.begin(), expected.end(), [&](UINT a, UINT b) { return keys[a] < keys[b]; });
+
+	REQUIRE(batcher.DrawCount() == keys.size());
+	CHECK(batcher.SortedPayloads() == expected);
+}
+
+TEST_CASE(DrawBatcher, SkipsDigitsEveryKeyShares) {
+	// Keys differ only in depth; the remaining passes must leave them in place.
+	DrawBatcher batcher;
+	const FLOAT Depths[] = { 0.9f, 0.1f, 0.5f, 0.3f };
+	for (UINT i = 0; i < 4; ++i) batcher.Add(DrawBatcher::MakeKey(5, 17, 300, 9, Depths[i]), i);
+	batcher.Build();
+
+	CHECK((batcher.SortedPayloads() == std::vector<UINT>{ 1, 3, 2, 0 }));
+	REQUIRE(batcher.Batches().size() == 1);
+	CHECK(batcher.Batches()[0].First == 0);
+	CHECK(batcher.Batches()[0].Count == 4);
+
+	// A single draw and an empty list.
+	batcher.Clear();
+	batcher.Add(DrawBatcher::MakeKey(1, 1, 1, 1, 0.f), 42);
+	batcher.Build();
+	CHECK((batcher.SortedPayloads() == std::vector<UINT>{ 42 }));
+	CHECK(batcher.Batches().size() == 1);
+
+	batcher.Clear();
+	batcher.Build();
+	CHECK(batcher.DrawCount() == 0);
+	CHECK(batcher.Batches().empty());
+}
+
+TEST_CASE(DrawBatcher, BatchesDrawsThatDifferOnlyInDepth) {
+	DrawBatcher batcher;
+	batcher.Add(DrawBatcher::MakeKey(0, 1, 2, 3, 0.7f), 0);
+	batcher.Add(DrawBatcher::MakeKey(0, 1, 2, 4, 0.2f), 1);
+	batcher.Add(DrawBatcher::MakeKey(0, 1, 2, 3, 0.1f), 2);
+	batcher.Add(DrawBatcher::MakeKey(0, 0, 9, 9, 0.9f), 3);
+	batcher.Add(DrawBatcher::MakeKey(0, 1, 2, 3, 0.4f), 4);
+	batcher.Build();
+
+	CHECK((batcher.SortedPayloads() == std::vector<UINT>{ 3, 2, 4, 0, 1 }));
+
+	const auto& batches = batcher.Batches();
+	REQUIRE(batches.size() == 3);
+	CHECK(batches[0].First == 0);
+	CHECK(batches[0].Count == 1);
+	CHECK(batches[1].First == 1);
+	CHECK(batches[1].Count == 3);
+	CHECK(batches[2].First == 4);
+	CHECK(batches[2].Count == 1);
+}
+
+BENCHMARK_CASE(DrawBatcher, Build50k) {
+	const UINT count = 50000;
+
+	// A scene-like spread: draws are instances of a thousand mesh and
+	// material pairs over a few passes and pipelines, each at its own depth.
+	struct Prototype {
+		UINT Pipeline;
+		UINT Material;
+		UINT Geometry;
+	};
+
+	std::mt19937 rng(40);
+	std::uniform_int_distribution<UINT> pipeline(0, 15);
+	std::uniform_int_distribution<UINT> material(0, 511);
+	std::uniform_int_distribution<UINT> geometry(0, 2047);
+
+	std::vector<Prototype> prototypes(1000);
+	for (auto& proto : prototypes) proto = { pipeline(rng), material(rng), geometry(rng) };
+
+	std::uniform_int_distribution<UINT> pass(0, 2);
+	std::uniform_int_distribution<size_t> pick(0, prototypes.size() - 1);
+	std::uniform_real_distribution<FLOAT> depth(0.f, 1.f);
+
+	std::vector<UINT64> keys(count);
+	for (auto& key : keys) {
+		const auto& proto = prototypes[pick(rng)];
+		key = DrawBatcher::MakeKey(pass(rng), proto.Pipeline, proto.Material, proto.Geometry, depth(rng));
+	}
+
+	DrawBatcher batcher;
+	const double BuildMs = UnitTest::MeasureMs(20, [&]() {
+		batcher.Clear();
+		for (UINT i = 0; i < count; ++i) batcher.Add(keys[i], i);
+		batcher.Build();
+	});
+
+	// Baseline: the comparison sort the batcher replaces, without merging.
+	std::vector<UINT> order(count);
+	const double StableSortMs = UnitTest::MeasureMs(20, [&]() {
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(order.begin(), order.end(), [&](UINT a, UINT b) { return keys[a] < keys[b]; });
+	});
+	CHECK(batcher.SortedPayloads() == order);
+
+	UnitTest::ReportTime(std::format("Radix sort and merge, {} draws, {} batches", 
+		count, batcher.Batches().size()).c_str(), BuildMs);
+	UnitTest::ReportTime(std::format("std::stable_sort, {} draws", count).c_str(), StableSortMs);
+}
\ No newline at end of file
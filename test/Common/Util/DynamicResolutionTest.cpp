@@ -0,0 +1,97 @@
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "Common/Util/DynamicResolution.hpp"
+
+using namespace Common::Util;
+
+namespace {
+	const FLOAT TargetFrameTime = 1.f / 60.f;
+
+	// A frame costs a fixed part plus one following its pixel count, with a
+	// few percent of repeatable noise on top.
+	struct GpuModel {
+		FLOAT FixedTime;
+		FLOAT FullResTime;
+
+		FLOAT FrameTime(FLOAT scale, UINT frame) const {
+			const FLOAT Noise = 1.f + 0.015f * static_cast<FLOAT>(static_cast<INT>((frame * 7919u) % 5u) - 2);
+			return (FixedTime + FullResTime * scale * scale) * Noise;
+		}
+	};
+
+	// Runs the controller against the model and returns the scale it picked
+	// for every frame.
+	std::vector<FLOAT> Run(DynamicResolution& resolution, const GpuModel& gpu, UINT frameCount) {
+		std::vector<FLOAT> scales{};
+		for (UINT frame = 0; frame < frameCount; ++frame)
+			scales.push_back(resolution.Update(gpu.FrameTime(resolution.Scale(), frame)));
+		return scales;
+	}
+
+	UINT CountChanges(const std::vector<FLOAT>& scales, size_t begin) {
+		UINT changes = 0;
+		for (size_t i = std::max<size_t>(begin, 1); i < scales.size(); ++i)
+			if (scales[i] != scales[i - 1]) ++changes;
+		return changes;
+	}
+}
+
+TEST_CASE(DynamicResolution, ConvergesOnTheTargetFrameTime) {
+	// Twice the budget at full resolution; the target is met near 0.7.
+	const GpuModel Gpu{ 0.002f, 0.030f };
+
+	DynamicResolution resolution;
+	resolution.Initialize(0.25f, 1.f, TargetFrameTime);
+	CHECK(resolution.Scale() == 1.f);
+
+	const auto Scales = Run(resolution, Gpu, 1000);
+
+	// Settles within the first few hundred frames and then holds.
+	CHECK(CountChanges(Scales, 300) == 0);
+
+	const FLOAT Settled = Scales.back();
+	CHECK(Settled >= 0.6f && Settled <= 0.75f);
+	CHECK(Gpu.FixedTime + Gpu.FullResTime * Settled * Settled <= TargetFrameTime * 1.05f);
+
+	// Never dips below where the budget is met in the first place.
+	CHECK(*std::min_element(Scales.begin(), Scales.end()) >= 0.6f);
+}
+
+TEST_CASE(DynamicResolution, ClimbsBackWithHeadroom) {
+	DynamicResolution resolution;
+	resolution.Initialize(0.25f, 1.f, TargetFrameTime);
+
+	const auto Heavy = Run(resolution, GpuModel{ 0.002f, 0.060f }, 500);
+	CHECK(Heavy.back() < 0.6f);
+
+	// The load drops, so full resolution fits again; it comes back a step
+	// at a time without overshooting downwards.
+	const auto Light = Run(resolution, GpuModel{ 0.002f, 0.010f }, 2000);
+	CHECK(Light.back() == 1.f);
+
+	for (size_t i = 1; i < Light.size(); ++i) CHECK(Light[i] >= Light[i - 1]);
+}
+
+TEST_CASE(DynamicResolution, RespectsItsBounds) {
+	DynamicResolution resolution;
+	resolution.Initialize(0.5f, 0.9f, TargetFrameTime);
+	CHECK(resolution.Scale() == 0.9f);
+
+	// Far over budget at any scale.
+	const auto Scales = Run(resolution, GpuModel{ 0.020f, 0.100f }, 500);
+	CHECK(*std::min_element(Scales.begin(), Scales.end()) >= 0.5f);
+	CHECK(Scales.back() == 0.5f);
+
+	// Tighter bounds pull the scale in on the next update.
+	resolution.SetBounds(0.6f, 0.8f);
+	CHECK(resolution.Update(TargetFrameTime) == 0.6f);
+
+	resolution.Reset(2.f);
+	CHECK(resolution.Scale() == 0.8f);
+
+	CHECK(resolution.ScaledWidth(1920) == 1536);
+	CHECK(resolution.ScaledHeight(1) == 1);
+}
\ No newline at end of file
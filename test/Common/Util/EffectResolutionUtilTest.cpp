@@ -0,0 +1,190 @@
+#include "UnitTest.hpp"
+
+#include <set>
+#include <utility>
+
+#include "Common/Util/EffectResolutionUtil.hpp"
+
+using namespace Common::Util;
+using namespace Common::Render;
+using namespace DirectX;
+
+namespace {
+	using Sample = EffectResolutionUtil::UpsampleSample;
+	using Pixel = std::pair<UINT, UINT>;
+
+	// Odd sizes, so the last column and row have no partner.
+	const UINT Width = 9;
+	const UINT Height = 7;
+
+	std::set<Pixel> EvaluatedPixels(EffectResolution type, BOOL bEvenPixelsActivated) {
+		const auto Dim = EffectResolutionUtil::EvaluatedDim(type, Width, Height);
+
+		std::set<Pixel> pixels{};
+		for (UINT y = 0; y < Dim.y; ++y) {
+			for (UINT x = 0; x < Dim.x; ++x) {
+				const auto Mapped = EffectResolutionUtil::EvaluatedPixel(type, { x, y }, bEvenPixelsActivated);
+				// Threads past the edge write nowhere.
+				if (Mapped.x >= Width || Mapped.y >= Height) continue;
+
+				CHECK(pixels.insert({ Mapped.x, Mapped.y }).second);
+			}
+		}
+		return pixels;
+	}
+
+	Sample FlatSample(FLOAT depth) {
+		return { depth, XMFLOAT3(0.f, 0.f, -1.f), TRUE };
+	}
+
+	FLOAT Sum(const FLOAT (&weights)[4]) {
+		return weights[0] + weights[1] + weights[2] + weights[3];
+	}
+}
+
+TEST_CASE(EffectResolutionUtil, EvaluatedDimRoundsUp) {
+	const auto Full = EffectResolutionUtil::EvaluatedDim(E_FullResolution, Width, Height);
+	CHECK(Full.x == Width);
+	CHECK(Full.y == Height);
+
+	const auto Checkerboard = EffectResolutionUtil::EvaluatedDim(E_Checkerboard, Width, Height);
+	CHECK(Checkerboard.x == 5);
+	CHECK(Checkerboard.y == Height);
+
+	const auto Half = EffectResolutionUtil::EvaluatedDim(E_HalfResolution, Width, Height);
+	CHECK(Half.x == 5);
+	CHECK(Half.y == 4);
+}
+
+TEST_CASE(EffectResolutionUtil, CheckerboardAlternatesAndCoversTwoFrames) {
+	const auto Even = EvaluatedPixels(E_Checkerboard, TRUE);
+	const auto Odd = EvaluatedPixels(E_Checkerboard, FALSE);
+
+	// Each frame takes every other pixel of every row, shifted row to row,
+	// so no two active pixels share an edge.
+	for (const auto& set : { Even, Odd }) {
+		for (const auto& pixel : set) {
+			CHECK(!set.count({ pixel.first + 1, pixel.second }));
+			CHECK(!set.count({ pixel.first, pixel.second + 1 }));
+		}
+	}
+
+	// The active parity is the parity of the pixel sum in even mode.
+	for (const auto& pixel : Even) CHECK((pixel.first + pixel.second) % 2 == 0);
+
+	// Two frames together cover the image exactly once.
+	CHECK(Even.size() + Odd.size() == Width * Height);
+	for (const auto& pixel : Even) CHECK(!Odd.count(pixel));
+}
+
+TEST_CASE(EffectResolutionUtil, HalfResolutionTakesQuadTopLeft) {
+	const auto Pixels = EvaluatedPixels(E_HalfResolution, FALSE);
+
+	CHECK(Pixels.size() == 5 * 4);
+	for (const auto& pixel : Pixels) {
+		CHECK(pixel.first % 2 == 0);
+		CHECK(pixel.second % 2 == 0);
+	}
+
+	// Full resolution is the identity.
+	const auto Mapped = EffectResolutionUtil::EvaluatedPixel(E_FullResolution, { 3, 4 }, TRUE);
+	CHECK(Mapped.x == 3);
+	CHECK(Mapped.y == 4);
+}
+
+TEST_CASE(EffectResolutionUtil, UpsampleFootprintBracketsPixel) {
+	const auto LowResDim = EffectResolutionUtil::EvaluatedDim(E_HalfResolution, Width, Height);
+
+	for (UINT y = 0; y < Height; ++y) {
+		for (UINT x = 0; x < Width; ++x) {
+			XMUINT2 src[4];
+			XMFLOAT2 offset;
+			EffectResolutionUtil::UpsampleFootprint({ x, y }, LowResDim, src, offset);
+
+			// The top-left texel was evaluated at the quad's top-left pixel.
+			const auto TopLeftPixel = EffectResolutionUtil::EvaluatedPixel(E_HalfResolution, src[0], FALSE);
+			CHECK(TopLeftPixel.x + offset.x * 2.f == static_cast<FLOAT>(x));
+			CHECK(TopLeftPixel.y + offset.y * 2.f == static_cast<FLOAT>(y));
+
+			for (const auto& index : src) {
+				CHECK(index.x < LowResDim.x);
+				CHECK(index.y < LowResDim.y);
+			}
+		}
+	}
+}
+
+TEST_CASE(EffectResolutionUtil, FlatSurfaceUpsamplesBilinearly) {
+	const auto LowResDim = EffectResolutionUtil::EvaluatedDim(E_HalfResolution, Width, Height);
+	const EffectResolutionUtil::UpsampleParams Params{};
+
+	// A value linear in the pixel position is reproduced exactly inside the
+	// image; the last pixel of each odd side only has clamped texels.
+	const auto Value = [](const XMUINT2& pixel) { return 0.25f * pixel.x + 0.5f * pixel.y; };
+
+	for (UINT y = 0; y + 1 < Height; ++y) {
+		for (UINT x = 0; x + 1 < Width; ++x) {
+			XMUINT2 src[4];
+			XMFLOAT2 offset;
+			EffectResolutionUtil::UpsampleFootprint({ x, y }, LowResDim, src, offset);
+
+			const Sample Samples[4] = { FlatSample(10.f), FlatSample(10.f), FlatSample(10.f), FlatSample(10.f) };
+
+			FLOAT weights[4];
+			EffectResolutionUtil::BilateralUpsampleWeights(
+				10.f, XMFLOAT3(0.f, 0.f, -1.f), offset, XMFLOAT2(0.f, 0.f), Samples, Params, weights);
+			CHECK_NEAR(Sum(weights), 1.f, 1e-5f);
+
+			FLOAT result = 0.f;
+			for (UINT i = 0; i < 4; ++i)
+				result += weights[i] * Value(EffectResolutionUtil::EvaluatedPixel(E_HalfResolution, src[i], FALSE));
+
+			CHECK_NEAR(result / Sum(weights), Value({ x, y }), 1e-4f);
+		}
+	}
+}
+
+TEST_CASE(EffectResolutionUtil, WeightsRejectDepthAndNormalEdges) {
+	const EffectResolutionUtil::UpsampleParams Params{};
+	const XMFLOAT3 Normal(0.f, 0.f, -1.f);
+	const XMFLOAT2 Center(0.5f, 0.5f);
+
+	FLOAT weights[4];
+
+	// A sloped surface keeps samples that follow its slope.
+	{
+		const Sample Samples[4] = { FlatSample(10.f), FlatSample(10.2f), FlatSample(10.f), FlatSample(10.2f) };
+		EffectResolutionUtil::BilateralUpsampleWeights(10.1f, Normal, Center, XMFLOAT2(0.05f, 0.f), Samples, Params, weights);
+		for (const auto weight : weights) CHECK(weight > 0.2f);
+	}
+	// Samples across a depth discontinuity drop out.
+	{
+		const Sample Samples[4] = { FlatSample(10.f), FlatSample(30.f), FlatSample(10.f), FlatSample(30.f) };
+		EffectResolutionUtil::BilateralUpsampleWeights(10.f, Normal, Center, XMFLOAT2(0.f, 0.f), Samples, Params, weights);
+		CHECK(weights[0] > 0.f);
+		CHECK(weights[1] == 0.f);
+		CHECK(weights[2] > 0.f);
+		CHECK(weights[3] == 0.f);
+	}
+	// So do samples facing another way, and ones off the geometry.
+	{
+		Sample samples[4] = { FlatSample(10.f), FlatSample(10.f), FlatSample(10.f), FlatSample(10.f) };
+		samples[1].Normal = XMFLOAT3(1.f, 0.f, 0.f);
+		samples[2].Valid = FALSE;
+
+		EffectResolutionUtil::BilateralUpsampleWeights(10.f, Normal, Center, XMFLOAT2(0.f, 0.f), samples, Params, weights);
+		CHECK(weights[0] > 0.f);
+		CHECK(weights[1] == 0.f);
+		CHECK(weights[2] == 0.f);
+		CHECK(weights[3] > 0.f);
+	}
+	// With nothing left the closest valid depth stands in.
+	{
+		Sample samples[4] = { FlatSample(50.f), FlatSample(12.f), FlatSample(10.5f), FlatSample(40.f) };
+		samples[2].Valid = FALSE;
+
+		EffectResolutionUtil::BilateralUpsampleWeights(10.f, Normal, Center, XMFLOAT2(0.f, 0.f), samples, Params, weights);
+		CHECK(Sum(weights) == 0.f);
+		CHECK(EffectResolutionUtil::NearestDepthSample(10.f, samples) == 1);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include "Common/Util/EnvironmentBaker.hpp"
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	using Radiance = std::function<XMFLOAT4(const XMFLOAT3&)>;
+
+	struct Cube {
+		std::vector<XMFLOAT4> Faces[6];
+
+		const XMFLOAT4* Pointers[6];
+	};
+
+	// Direction through texel (u, v) in [-1, 1] of a face, following the
+	// D3D cube map layout with v running down the face.
+	XMFLOAT3 FaceDirection(UINT face, FLOAT u, FLOAT v) {
+		XMFLOAT3 dir;
+		switch (face) {
+		case 0: dir = XMFLOAT3(1.f, -v, -u); break;
+		case 1: dir = XMFLOAT3(-1.f, -v, u); break;
+		case 2: dir = XMFLOAT3(u, 1.f, v); break;
+		case 3: dir = XMFLOAT3(u, -1.f, -v); break;
+		case 4: dir = XMFLOAT3(u, -v, 1.f); break;
+		default: dir = XMFLOAT3(-u, -v, -1.f); break;
+		}
+
+		const FLOAT InvLen = 1.f / sqrtf(dir.x * dir.x + dir.y * dir.y + dir.z * dir.z);
+		return XMFLOAT3(dir.x * InvLen, dir.y * InvLen, dir.z * InvLen);
+	}
+
+	void FillCube(UINT faceSize, const Radiance& radiance, Cube& cube) {
+		for (UINT face = 0; face < 6; ++face) {
+			auto& texels = cube.Faces[face];
+			texels.resize(static_cast<size_t>(faceSize) * faceSize);
+
+			for (UINT y = 0; y < faceSize; ++y) {
+				for (UINT x = 0; x < faceSize; ++x) {
+					const FLOAT u = (x + 0.5f) * 2.f / faceSize - 1.f;
+					const FLOAT v = (y + 0.5f) * 2.f / faceSize - 1.f;
+					texels[static_cast<size_t>(y) * faceSize + x] = radiance(FaceDirection(face, u, v));
+				}
+			}
+
+			cube.Pointers[face] = texels.data();
+		}
+	}
+
+	std::vector<XMFLOAT3> TestNormals() {
+		std::vector<XMFLOAT3> normals = {
+			{ 1.f, 0.f, 0.f }, { -1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f },
+			{ 0.f, -1.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f, -1.f } };
+
+		const FLOAT d = 1.f / sqrtf(3.f);
+		normals.emplace_back(d, d, d);
+		normals.emplace_back(-d, d, -d);
+
+		return normals;
+	}
+
+	// Port of IntegrateBRDF in IntegrateBrdf.hlsl, in double precision and
+	// with the full tangent frame, as the reference for the LUT.
+	void IntegrateReference(double NdotV, double roughness, UINT sampleCount, double& A, double& B) {
+		const double Pi = 3.14159265358979323846;
+
+		roughness = std::max(roughness, 0.04);
+		const double a = roughness * roughness;
+		const double k = roughness * roughness / 2.0;
+
+		const double Vx = sqrt(1.0 - NdotV * NdotV), Vz = NdotV;
+
+		A = B = 0.0;
+		for (UINT i = 0; i < sampleCount; ++i) {
+			UINT bits = i;
+			bits = (bits << 16u) | (bits >> 16u);
+			bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+			bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+			bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+			bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+			const double Xi0 = static_cast<double>(i) / sampleCount;
+			const double Xi1 = bits * 2.3283064365386963e-10;
+
+			const double Phi = 2.0 * Pi * Xi0;
+			const double CosTheta = sqrt((1.0 - Xi1) / (1.0 + (a * a - 1.0) * Xi1));
+			const double SinTheta = sqrt(1.0 - CosTheta * CosTheta);
+
+			// Tangent (0, -1, 0) and bitangent (1, 0, 0) for N = +Z.
+			const double Hx = sin(Phi) * SinTheta, Hy = -cos(Phi) * SinTheta, Hz = CosTheta;
+
+			const double VdotH = Vx * Hx + Vz * Hz;
+			const double Lx = 2.0 * VdotH * Hx - Vx, Ly = 2.0 * VdotH * Hy, Lz = 2.0 * VdotH * Hz - Vz;
+			const double NdotL = std::max(Lz / sqrt(Lx * Lx + Ly * Ly + Lz * Lz), 0.0);
+			if (NdotL <= 0.0) continue;
+
+			const double G = NdotV / (NdotV * (1.0 - k) + k) * NdotL / (NdotL * (1.0 - k) + k);
+			const double GVis = G * std::max(VdotH, 0.0) / (std::max(Hz, 0.0) * NdotV);
+			const double Fc = pow(1.0 - std::max(VdotH, 0.0), 5.0);
+
+			A += (1.0 - Fc) * GVis;
+			B += Fc * GVis;
+		}
+
+		A /= sampleCount;
+		B /= sampleCount;
+	}
+}
+
+TEST_CASE(EnvironmentBaker, UniformSkyGivesItsRadiance) {
+	Cube cube;
+	FillCube(32, [](const XMFLOAT3&) { return XMFLOAT4(0.2f, 0.5f, 1.f, 1.f); }, cube);
+
+	EnvironmentBaker baker;
+	baker.Initialize(FALSE, 4);
+
+	EnvironmentBaker::IrradianceSH sh;
+	baker.ProjectIrradianceSH(cube.Pointers, 32, sh);
+
+	for (const auto& normal : TestNormals()) {
+		const auto Value = EnvironmentBaker::EvaluateSH(sh, normal);
+		CHECK_NEAR(Value.x, 0.2f, 1e-3f);
+		CHECK_NEAR(Value.y, 0.5f, 1e-3f);
+		CHECK_NEAR(Value.z, 1.f, 2e-3f);
+	}
+}
+
+TEST_CASE(EnvironmentBaker, ConvolvesALinearSkyWithTheCosineLobe) {
+	// Radiance a + b.d has irradiance over pi of a + 2/3 b.n, which order 2
+	// represents exactly.
+	const XMFLOAT3 Gradient(0.1f, 0.5f, -0.3f);
+	const auto Sky = [&](const XMFLOAT3& d) {
+		const FLOAT Value = 1.f + Gradient.x * d.x + Gradient.y * d.y + Gradient.z * d.z;
+		return XMFLOAT4(Value, 2.f * Value, 0.5f * Value, 1.f);
+	};
+
+	Cube cube;
+	FillCube(64, Sky, cube);
+
+	EnvironmentBaker baker;
+	baker.Initialize(FALSE, 1);
+
+	EnvironmentBaker::IrradianceSH sh;
+	baker.ProjectIrradianceSH(cube.Pointers, 64, sh);
+
+	for (const auto& n : TestNormals()) {
+		const FLOAT Expected = 1.f + 2.f / 3.f * (Gradient.x * n.x + Gradient.y * n.y + Gradient.z * n.z);
+		const auto Value = EnvironmentBaker::EvaluateSH(sh, n);
+
+		CHECK_NEAR(Value.x, Expected, 1e-2f * Expected);
+		CHECK_NEAR(Value.y, 2.f * Expected, 2e-2f * Expected);
+		CHECK_NEAR(Value.z, 0.5f * Expected, 0.5e-2f * Expected);
+	}
+}
+
+TEST_CASE(EnvironmentBaker, AvxProjectionMatchesScalar) {
+	if (!UnitTest::Avx2Supported()) return;
+
+	// A sharp lobe exercises every coefficient; 12 texels leave a scalar tail.
+	const auto Sun = [](const XMFLOAT3& d) {
+		const FLOAT Lobe = powf(std::max(0.6f * d.x + 0.8f * d.y, 0.f), 16.f);
+		return XMFLOAT4(0.1f + 5.f * Lobe, 0.2f + 4.f * Lobe, 0.4f + 3.f * Lobe, 1.f);
+	};
+
+	for (const UINT FaceSize : { 12u, 32u }) {
+		Cube cube;
+		FillCube(FaceSize, Sun, cube);
+
+		EnvironmentBaker scalar, avx;
+		scalar.Initialize(FALSE, 1);
+		avx.Initialize(TRUE, 3);
+
+		EnvironmentBaker::IrradianceSH expected, actual;
+		scalar.ProjectIrradianceSH(cube.Pointers, FaceSize, expected);
+		avx.ProjectIrradianceSH(cube.Pointers, FaceSize, actual);
+
+		for (UINT i = 0; i < EnvironmentBaker::SHCoeffCount; ++i) {
+			CHECK_NEAR(actual.Coeffs[i].x, expected.Coeffs[i].x, 1e-5f);
+			CHECK_NEAR(actual.Coeffs[i].y, expected.Coeffs[i].y, 1e-5f);
+			CHECK_NEAR(actual.Coeffs[i].z, expected.Coeffs[i].z, 1e-5f);
+		}
+	}
+}
+
+TEST_CASE(EnvironmentBaker, BrdfLutMatchesTheShader) {
+	const UINT Size = 16;
+	const UINT SampleCount = 1024;
+
+	for (const BOOL bAvx2 : { FALSE, TRUE }) {
+		if (bAvx2 && !UnitTest::Avx2Supported()) continue;
+
+		EnvironmentBaker baker;
+		baker.Initialize(bAvx2, 4);
+
+		std::vector<XMFLOAT2> lut{};
+		baker.BakeBrdfLut(Size, SampleCount, lut);
+		REQUIRE(lut.size() == Size * Size);
+
+		FLOAT maxError = 0.f;
+		for (UINT y = 0; y < Size; ++y) {
+			for (UINT x = 0; x < Size; ++x) {
+				const auto& Texel = lut[y * Size + x];
+
+				double A, B;
+				IntegrateReference((x + 0.5) / Size, (y + 0.5) / Size, SampleCount, A, B);
+
+				maxError = std::max({
+					maxError,
+					std::abs(Texel.x - static_cast<FLOAT>(A)),
+					std::abs(Texel.y - static_cast<FLOAT>(B)) });
+
+				// The split-sum never reflects more than comes in.
+				CHECK(Texel.x >= 0.f && Texel.y >= 0.f);
+				CHECK(Texel.x + Texel.y <= 1.f + 1e-3f);
+			}
+		}
+		CHECK(maxError < 1e-4f);
+
+		// A smooth surface seen head on reflects almost everything.
+		const auto& Smooth = lut[Size - 1];
+		CHECK(Smooth.x + Smooth.y > 0.95f);
+	}
+}
\ No newline at end of file
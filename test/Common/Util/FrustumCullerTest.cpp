@@ -0,0 +1,246 @@
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <format>
+#include <random>
+#include <thread>
+
+#include "Common/Util/FrustumCuller.hpp"
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	FrustumCuller::Frustum CameraFrustum() {
+		XMFLOAT4X4 view, proj;
+		XMStoreFloat4x4(&view, XMMatrixLookAtLH(
+			XMVectorSet(0.f, 0.f, -10.f, 1.f), XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 1.f, 0.f, 0.f)));
+		XMStoreFloat4x4(&proj, XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.f / 9.f, 0.1f, 100.f));
+
+		FrustumCuller::Frustum frustum;
+		FrustumCuller::BuildFrustum(view, proj, frustum);
+		return frustum;
+	}
+
+	FLOAT PlaneDistance(const XMFLOAT4& plane, const XMFLOAT3& p) {
+		return plane.x * p.x + plane.y * p.y + plane.z * p.z + plane.w;
+	}
+
+	// A box is culled only when all eight corners lie behind one plane.
+	BOOL BoxVisible(const FrustumCuller::Frustum& frustum, const BoundingBox& box) {
+		XMFLOAT3 corners[BoundingBox::CORNER_COUNT];
+		box.GetCorners(corners);
+
+		for (const auto& plane : frustum.Planes) {
+			BOOL anyInside = FALSE;
+			for (const auto& corner : corners) anyInside |= PlaneDistance(plane, corner) >= 0.f;
+			if (!anyInside) return FALSE;
+		}
+		return TRUE;
+	}
+
+	BOOL SphereVisible(const FrustumCuller::Frustum& frustum, const BoundingSphere& sphere) {
+		for (const auto& plane : frustum.Planes)
+			if (PlaneDistance(plane, sphere.Center) < -sphere.Radius) return FALSE;
+		return TRUE;
+	}
+
+	struct Scene {
+		std::vector<BoundingBox> Boxes;
+		std::vector<BoundingSphere> Spheres;
+	};
+
+	Scene ScatterBounds(UINT count, UINT seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> position(-120.f, 120.f);
+		std::uniform_real_distribution<float> size(0.05f, 4.f);
+
+		Scene scene;
+		for (UINT i = 0; i < count; ++i) {
+			scene.Boxes.emplace_back(
+				XMFLOAT3(position(rng), position(rng), position(rng)), XMFLOAT3(size(rng), size(rng), size(rng)));
+			scene.Spheres.emplace_back(XMFLOAT3(position(rng), position(rng), position(rng)), size(rng));
+		}
+		return scene;
+	}
+
+	void CheckAgainstReference(BOOL bAvx2, UINT numThreads, UINT count) {
+		const auto frustum = CameraFrustum();
+		const auto scene = ScatterBounds(count, count + numThreads);
+
+		FrustumCuller culler;
+		culler.Initialize(bAvx2, numThreads);
+		for (UINT i = 0; i < count; ++i) {
+			culler.AddBox(scene.Boxes[i]);
+			culler.AddSphere(scene.Spheres[i]);
+		}
+
+		std::vector<UINT> expectedBoxes, expectedSpheres;
+		for (UINT i = 0; i < count; ++i) {
+			if (BoxVisible(frustum, scene.Boxes[i])) expectedBoxes.push_back(i);
+			if (SphereVisible(frustum, scene.Spheres[i])) expectedSpheres.push_back(i);
+		}
+
+		std::vector<UINT> visible;
+		culler.CullBoxes(frustum, visible);
+		CHECK(!expectedBoxes.empty());
+		CHECK(visible == expectedBoxes);
+
+		culler.CullSpheres(frustum, visible);
+		CHECK(!expectedSpheres.empty());
+		CHECK(visible == expectedSpheres);
+	}
+}
+
+TEST_CASE(FrustumCuller, BuildFrustumFromCamera) {
+	const auto frustum = CameraFrustum();
+
+	const auto inside = [&](const XMFLOAT3& p) {
+		return SphereVisible(frustum, BoundingSphere(p, 0.f));
+	};
+
+	CHECK(inside({ 0.f, 0.f, 0.f }));
+	CHECK(inside({ 0.f, 0.f, 80.f }));
+	CHECK(!inside({ 0.f, 0.f, -10.5f }));	// Behind the camera
+	CHECK(!inside({ 0.f, 0.f, 95.f }));		// Past the far plane
+	CHECK(!inside({ 30.f, 0.f, 0.f }));		// Off to the right
+	CHECK(!inside({ 0.f, -30.f, 0.f }));	// Below
+
+	// Planes come out normalized, so distances are in world units.
+	for (const auto& plane : frustum.Planes)
+		CHECK_NEAR(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z, 1.f, 1e-4f);
+}
+
+TEST_CASE(FrustumCuller, ScalarMatchesReference) {
+	CheckAgainstReference(FALSE, 1, 1003);
+}
+
+TEST_CASE(FrustumCuller, Avx2MatchesReference) {
+	if (!UnitTest::Avx2Supported()) return;
+
+	// A count that is not a multiple of the batch size exercises the scalar tail.
+	CheckAgainstReference(TRUE, 1, 1003);
+}
+
+TEST_CASE(FrustumCuller, ParallelChunksKeepOrder) {
+	const UINT count = FrustumCuller::ParallelThreshold * 2 + 5;
+
+	CheckAgainstReference(FALSE, 4, count);
+	if (UnitTest::Avx2Supported()) CheckAgainstReference(TRUE, 4, count);
+}
+
+TEST_CASE(FrustumCuller, IntersectsBoxAgreesWithBatch) {
+	const auto frustum = CameraFrustum();
+	const auto scene = ScatterBounds(257, 7);
+
+	FrustumCuller culler;
+	culler.Initialize(FALSE, 1);
+	for (const auto& box : scene.Boxes) culler.AddBox(box);
+
+	// Move a few boxes, as the renderer does between batches.
+	culler.UpdateBox(3, BoundingBox(XMFLOAT3(0.f, 0.f, 5.f), XMFLOAT3(1.f, 1.f, 1.f)));
+	culler.UpdateBox(4, BoundingBox(XMFLOAT3(0.f, 0.f, -50.f), XMFLOAT3(1.f, 1.f, 1.f)));
+
+	std::vector<UINT> visible;
+	culler.CullBoxes(frustum, visible);
+
+	std::vector<UINT> single;
+	for (UINT i = 0, end = static_cast<UINT>(scene.Boxes.size()); i < end; ++i)
+		if (culler.IntersectsBox(frustum, i)) single.push_back(i);
+
+	CHECK(single == visible);
+	CHECK(culler.IntersectsBox(frustum, 3));
+	CHECK(!culler.IntersectsBox(frustum, 4));
+}
+
+TEST_CASE(FrustumCuller, SphereIntersectsCone) {
+	const XMFLOAT3 apex(0.f, 0.f, 0.f);
+	const XMFLOAT3 direction(0.f, 0.f, 2.f);	// Need not be normalized
+	const FLOAT halfAngle = XM_PIDIV4 * 0.5f;
+	const FLOAT range = 10.f;
+
+	const auto hits = [&](const XMFLOAT3& center, FLOAT radius) {
+		return FrustumCuller::SphereIntersectsCone(BoundingSphere(center, radius), apex, direction, halfAngle, range);
+	};
+
+	CHECK(hits({ 0.f, 0.f, 5.f }, 0.5f));		// On the axis
+	CHECK(hits({ 0.f, 0.f, -0.5f }, 1.f));		// Straddles the apex
+	CHECK(!hits({ 0.f, 0.f, -2.f }, 1.f));		// Behind the apex
+	CHECK(!hits({ 0.f, 0.f, 12.f }, 1.f));		// Past the range
+	CHECK(hits({ 0.f, 0.f, 10.5f }, 1.f));		// Overlaps the far cap
+
+	// At distance 5 the cone's radius is 5 * tan(22.5deg), about 2.07.
+	CHECK(hits({ 2.f, 0.f, 5.f }, 0.1f));		// Just inside the side
+	CHECK(!hits({ 4.f, 0.f, 5.f }, 0.5f));		// Outside the side
+	CHECK(hits({ 0.f, 4.f, 5.f }, 2.f));		// Grazes the side
+
+	// Inside the spot frustum's corner but outside the cone itself.
+	CHECK(!hits({ 1.9f, 1.9f, 5.f }, 0.3f));
+}
+
+TEST_CASE(FrustumCuller, TransformBoxEnclosesCorners) {
+	const BoundingBox local(XMFLOAT3(1.f, 2.f, 3.f), XMFLOAT3(0.5f, 1.f, 2.f));
+
+	XMFLOAT4X4 world;
+	XMStoreFloat4x4(&world,
+		XMMatrixScaling(2.f, 1.f, 0.5f) * XMMatrixRotationY(0.7f) * XMMatrixTranslation(-4.f, 5.f, 6.f));
+
+	const auto box = FrustumCuller::TransformBox(local, world);
+
+	XMFLOAT3 corners[BoundingBox::CORNER_COUNT];
+	local.GetCorners(corners);
+
+	FLOAT maxX = -FLT_MAX;
+	for (const auto& corner : corners) {
+		XMFLOAT3 p;
+		XMStoreFloat3(&p, XMVector3Transform(XMLoadFloat3(&corner), XMLoadFloat4x4(&world)));
+
+		CHECK(std::abs(p.x - box.Center.x) <= box.Extents.x + 1e-4f);
+		CHECK(std::abs(p.y - box.Center.y) <= box.Extents.y + 1e-4f);
+		CHECK(std::abs(p.z - box.Center.z) <= box.Extents.z + 1e-4f);
+
+		maxX = std::max(maxX, p.x);
+	}
+
+	// The box is tight along each axis for an affine transform.
+	CHECK_NEAR(maxX, box.Center.x + box.Extents.x, 1e-4f);
+}
+
+BENCHMARK_CASE(FrustumCuller, CullBoxes100k) {
+	const UINT count = 100000;
+	const auto frustum = CameraFrustum();
+	const auto scene = ScatterBounds(count, 29);
+	const UINT numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	struct Config {
+		const char* Name;
+		BOOL Avx2;
+		UINT Threads;
+	};
+	const Config configs[] = {
+		{ "Scalar, 1 thread", FALSE, 1 },
+		{ "AVX2, 1 thread", TRUE, 1 },
+		{ "Scalar, all threads", FALSE, numThreads },
+		{ "AVX2, all threads", TRUE, numThreads },
+	};
+
+	std::vector<UINT> reference;
+	for (const auto& config : configs) {
+		if (config.Avx2 && !UnitTest::Avx2Supported()) continue;
+
+		FrustumCuller culler;
+		culler.Initialize(config.Avx2, config.Threads);
+		for (const auto& box : scene.Boxes) culler.AddBox(box);
+
+		std::vector<UINT> visible;
+		const double Ms = UnitTest::MeasureMs(20, [&]() { culler.CullBoxes(frustum, visible); });
+
+		// Every configuration must keep the same objects.
+		if (reference.empty()) reference = visible;
+		CHECK(visible == reference);
+
+		UnitTest::ReportTime(std::format("CullBoxes, {} objects, {}, {} visible", 
+			count, config.Name, visible.size()).c_str(), Ms);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <format>
+#include <random>
+#include <thread>
+
+#include "Common/Util/LightClusterer.hpp"
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	const LightClusterer::Grid Grid{ 16, 9, 24, 0.1f, 200.f };
+
+	struct Camera {
+		XMFLOAT4X4 View;
+		XMFLOAT4X4 Proj;
+	};
+
+	// Looks off the axes, so the view matrix mixes every component.
+	Camera MakeCamera() {
+		Camera camera;
+		XMStoreFloat4x4(&camera.View, XMMatrixLookAtLH(
+			XMVectorSet(3.f, 5.f, -20.f, 1.f), XMVectorSet(-4.f, 1.f, 30.f, 1.f), XMVectorSet(0.f, 1.f, 0.f, 0.f)));
+		XMStoreFloat4x4(&camera.Proj, XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.f / 9.f, Grid.NearZ, Grid.FarZ));
+		return camera;
+	}
+
+	std::vector<BoundingSphere> ScatterLights(UINT count, UINT seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<FLOAT> xy(-80.f, 80.f);
+		std::uniform_real_distribution<FLOAT> z(-40.f, 220.f);
+		std::uniform_real_distribution<FLOAT> radius(0.2f, 12.f);
+
+		std::vector<BoundingSphere> lights{};
+		for (UINT i = 0; i < count; ++i)
+			lights.emplace_back(XMFLOAT3(xy(rng), xy(rng), z(rng)), radius(rng));
+
+		return lights;
+	}
+
+	void Build(LightClusterer& clusterer, BOOL bAvx2, UINT numThreads, const std::vector<BoundingSphere>& lights, const Camera& camera) {
+		clusterer.Initialize(bAvx2, numThreads);
+		for (const auto& light : lights) clusterer.AddLight(light);
+		clusterer.Build(Grid, camera.View, camera.Proj);
+	}
+
+	std::vector<UINT> ClusterLights(const LightClusterer& clusterer, UINT cluster) {
+		const auto& range = clusterer.Clusters()[cluster];
+		const auto begin = clusterer.LightIndices().begin() + range.Offset;
+		return std::vector<UINT>(begin, begin + range.Count);
+	}
+
+	// Cluster a view-space point falls in, or -1 outside the grid.
+	INT ClusterOf(const XMFLOAT3& p, const Camera& camera) {
+		if (p.z < Grid.NearZ || p.z >= Grid.FarZ) return -1;
+
+		const FLOAT NdcX = p.x * camera.Proj._11 / p.z;
+		const FLOAT NdcY = p.y * camera.Proj._22 / p.z;
+		if (NdcX < -1.f || NdcX >= 1.f || NdcY <= -1.f || NdcY > 1.f) return -1;
+
+		const INT x = static_cast<INT>(floorf((NdcX * 0.5f + 0.5f) * Grid.CountX));
+		const INT y = static_cast<INT>(floorf((0.5f - NdcY * 0.5f) * Grid.CountY));
+
+		INT z = 0;
+		while (z + 1 < static_cast<INT>(Grid.CountZ)
+			&& Grid.NearZ * powf(Grid.FarZ / Grid.NearZ, static_cast<FLOAT>(z + 1) / Grid.CountZ) <= p.z) ++z;
+
+		return (z * static_cast<INT>(Grid.CountY) + y) * static_cast<INT>(Grid.CountX) + x;
+	}
+}
+
+TEST_CASE(LightClusterer, AvxMatchesScalar) {
+	if (!UnitTest::Avx2Supported()) return;
+
+	const auto Cam = MakeCamera();
+	// Not a multiple of the batch size, so the scalar tail runs as well.
+	const auto Lights = ScatterLights(1003, 42);
+
+	LightClusterer scalar, avx;
+	Build(scalar, FALSE, 1, Lights, Cam);
+	Build(avx, TRUE, 1, Lights, Cam);
+
+	REQUIRE(avx.ClusterCount() == Grid.CountX * Grid.CountY * Grid.CountZ);
+	REQUIRE(avx.ClusterCount() == scalar.ClusterCount());
+	CHECK(avx.LightIndices() == scalar.LightIndices());
+
+	UINT mismatches = 0;
+	for (UINT c = 0; c < avx.ClusterCount(); ++c)
+		if (avx.Clusters()[c].Offset != scalar.Clusters()[c].Offset
+			|| avx.Clusters()[c].Count != scalar.Clusters()[c].Count) ++mismatches;
+	CHECK(mismatches == 0);
+	CHECK(!scalar.LightIndices().empty());
+}
+
+TEST_CASE(LightClusterer, ParallelBuildMatchesSingleThreaded) {
+	const auto Cam = MakeCamera();
+	const auto Lights = ScatterLights(LightClusterer::ParallelThreshold + 77, 7);
+
+	LightClusterer serial, parallel;
+	Build(serial, UnitTest::Avx2Supported(), 1, Lights, Cam);
+	Build(parallel, UnitTest::Avx2Supported(), 4, Lights, Cam);
+
+	CHECK(parallel.LightIndices() == serial.LightIndices());
+	for (UINT c = 0; c < serial.ClusterCount(); ++c)
+		CHECK(parallel.Clusters()[c].Count == serial.Clusters()[c].Count);
+}
+
+TEST_CASE(LightClusterer, ListsEveryClusterALightTouches) {
+	const auto Cam = MakeCamera();
+	const auto Lights = ScatterLights(300, 3);
+
+	const XMMATRIX View = XMLoadFloat4x4(&Cam.View);
+
+	for (const BOOL bAvx2 : { FALSE, TRUE }) {
+		if (bAvx2 && !UnitTest::Avx2Supported()) continue;
+
+		LightClusterer clusterer;
+		Build(clusterer, bAvx2, 1, Lights, Cam);
+
+		// Lists are sorted, so membership is a binary search.
+		for (UINT c = 0; c < clusterer.ClusterCount(); ++c) {
+			const auto List = ClusterLights(clusterer, c);
+			CHECK(std::is_sorted(List.begin(), List.end()));
+		}
+
+		std::mt19937 rng(11);
+		std::uniform_real_distribution<FLOAT> unit(-1.f, 1.f);
+
+		UINT missing = 0;
+		UINT sampled = 0;
+		for (UINT i = 0; i < Lights.size(); ++i) {
+			XMFLOAT3 center;
+			XMStoreFloat3(&center, XMVector3TransformCoord(XMLoadFloat3(&Lights[i].Center), View));
+
+			// Points strictly inside the sphere, so rounding at its surface does not count.
+			for (UINT s = 0; s < 64; ++s) {
+				XMFLOAT3 offset(unit(rng), unit(rng), unit(rng));
+				const FLOAT Length = sqrtf(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+				if (Length > 1.f || Length == 0.f) continue;
+
+				const FLOAT Scale = Lights[i].Radius * 0.98f;
+				const XMFLOAT3 Point(center.x + offset.x * Scale, center.y + offset.y * Scale, center.z + offset.z * Scale);
+
+				const INT Cluster = ClusterOf(Point, Cam);
+				if (Cluster < 0) continue;
+
+				++sampled;
+				const auto List = ClusterLights(clusterer, static_cast<UINT>(Cluster));
+				if (!std::binary_search(List.begin(), List.end(), i)) ++missing;
+			}
+		}
+
+		CHECK(sampled > 0);
+		CHECK(missing == 0);
+	}
+}
+
+TEST_CASE(LightClusterer, SkipsLightsOutsideTheFrustum) {
+	const auto Cam = MakeCamera();
+
+	// Behind the camera, past the far plane and far off to the side.
+	const std::vector<BoundingSphere> Lights = {
+		BoundingSphere(XMFLOAT3(3.f, 5.f, -40.f), 2.f),
+		BoundingSphere(XMFLOAT3(-4.f, 1.f, 400.f), 5.f),
+		BoundingSphere(XMFLOAT3(500.f, 5.f, 10.f), 5.f) };
+
+	for (const BOOL bAvx2 : { FALSE, TRUE }) {
+		if (bAvx2 && !UnitTest::Avx2Supported()) continue;
+
+		LightClusterer clusterer;
+		Build(clusterer, bAvx2, 1, Lights, Cam);
+		CHECK(clusterer.LightIndices().empty());
+	}
+}
+
+TEST_CASE(LightClusterer, SlicesDepthExponentially) {
+	FLOAT scale, bias;
+	LightClusterer::DepthSliceParams(Grid, scale, bias);
+
+	// Every slice boundary maps onto its own index.
+	for (UINT k = 0; k <= Grid.CountZ; ++k) {
+		const FLOAT Z = Grid.NearZ * powf(Grid.FarZ / Grid.NearZ, static_cast<FLOAT>(k) / Grid.CountZ);
+		CHECK_NEAR(log2f(Z) * scale + bias, static_cast<FLOAT>(k), 1e-3f);
+	}
+}
+
+BENCHMARK_CASE(LightClusterer, BuildScaling) {
+	const auto Cam = MakeCamera();
+	const UINT numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	struct Config {
+		const char* Name;
+		BOOL Avx2;
+		UINT Threads;
+	};
+	const Config configs[] = {
+		{ "Scalar, 1 thread", FALSE, 1 },
+		{ "AVX2, 1 thread", TRUE, 1 },
+		{ "Scalar, all threads", FALSE, numThreads },
+		{ "AVX2, all threads", TRUE, numThreads },
+	};
+
+	for (UINT count : { 1000u, 10000u }) {
+		const auto Lights = ScatterLights(count, count);
+
+		std::vector<UINT> reference{};
+		for (const auto& config : configs) {
+			if (config.Avx2 && !UnitTest::Avx2Supported()) continue;
+
+			LightClusterer clusterer;
+			clusterer.Initialize(config.Avx2, config.Threads);
+			for (const auto& light : Lights) clusterer.AddLight(light);
+
+			const double Ms = UnitTest::MeasureMs(10, [&]() { clusterer.Build(Grid, Cam.View, Cam.Proj); });
+
+			// Every configuration must produce the same lists.
+			if (reference.empty()) reference = clusterer.LightIndices();
+			CHECK(clusterer.LightIndices() == reference);
+
+			UnitTest::ReportTime(std::format("Build, {} lights, {}, {} entries", 
+				count, config.Name, clusterer.LightIndices().size()).c_str(), Ms);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "UnitTest.hpp"
+
+#include "Common/Util/MaskedOcclusionCuller.hpp"
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	// With identity matrices world space is NDC, so occluders are placed
+	// directly on screen.
+	XMFLOAT4X4 Identity() {
+		XMFLOAT4X4 identity;
+		XMStoreFloat4x4(&identity, XMMatrixIdentity());
+		return identity;
+	}
+
+	// Two triangles over the NDC rectangle at a constant depth.
+	void RenderRect(MaskedOcclusionCuller& culler, FLOAT x0, FLOAT y0, FLOAT x1, FLOAT y1, FLOAT z) {
+		const XMFLOAT3 Vertices[] = { { x0, y0, z }, { x1, y0, z }, { x1, y1, z }, { x0, y1, z } };
+		const UINT Indices[] = { 0, 1, 2, 0, 2, 3 };
+
+		culler.RenderOccluder(Vertices, sizeof(XMFLOAT3), Indices, 6, Identity());
+	}
+
+	BoundingBox Box(FLOAT x, FLOAT y, FLOAT zNear, FLOAT zFar, FLOAT halfSize) {
+		return BoundingBox(XMFLOAT3(x, y, 0.5f * (zNear + zFar)), XMFLOAT3(halfSize, halfSize, 0.5f * (zFar - zNear)));
+	}
+
+	std::vector<BOOL> Paths() {
+		return UnitTest::Avx2Supported() ? std::vector<BOOL>{ FALSE, TRUE } : std::vector<BOOL>{ FALSE };
+	}
+}
+
+TEST_CASE(MaskedOcclusionCuller, HidesOccludeesBehindAnOccluder) {
+	for (const BOOL bAvx2 : Paths()) {
+		MaskedOcclusionCuller culler;
+		culler.Initialize(bAvx2, 128, 64);
+		culler.Clear(Identity());
+
+		// Nothing drawn yet, so everything on screen is visible.
+		CHECK(culler.TestBox(Box(0.f, 0.f, 0.8f, 0.9f, 0.1f)));
+
+		// Covers the left half of the screen.
+		RenderRect(culler, -1.f, -1.f, 0.f, 1.f, 0.5f);
+
+		CHECK(!culler.TestBox(Box(-0.5f, 0.f, 0.6f, 0.9f, 0.2f)));
+		// In front of the occluder.
+		CHECK(culler.TestBox(Box(-0.5f, 0.f, 0.2f, 0.3f, 0.2f)));
+		// Straddling its depth.
+		CHECK(culler.TestBox(Box(-0.5f, 0.f, 0.4f, 0.6f, 0.2f)));
+		// Beside it.
+		CHECK(culler.TestBox(Box(0.5f, 0.f, 0.6f, 0.9f, 0.2f)));
+		// Partly past its edge.
+		CHECK(culler.TestBox(Box(0.f, 0.f, 0.6f, 0.9f, 0.2f)));
+		// Off screen or crossing the near plane.
+		CHECK(!culler.TestBox(Box(3.f, 0.f, 0.6f, 0.9f, 0.2f)));
+		CHECK(culler.TestBox(Box(-0.5f, 0.f, -0.5f, 0.9f, 0.2f)));
+	}
+}
+
+TEST_CASE(MaskedOcclusionCuller, MergesOccludersSharingTiles) {
+	for (const BOOL bAvx2 : Paths()) {
+		MaskedOcclusionCuller culler;
+		culler.Initialize(bAvx2, 64, 32);
+		culler.Clear(Identity());
+
+		// Two halves of the screen split along the diagonal, so every tile on
+		// it is covered only by both together.
+		const XMFLOAT3 Vertices[] = {
+			{ -1.f, -1.f, 0.3f }, { 1.f, 1.f, 0.3f }, { -1.f, 1.f, 0.3f },
+			{ -1.f, -1.f, 0.6f }, { 1.f, -1.f, 0.6f }, { 1.f, 1.f, 0.6f } };
+		const UINT Indices[] = { 0, 1, 2, 3, 4, 5 };
+		culler.RenderOccluder(Vertices, sizeof(XMFLOAT3), Indices, 6, Identity());
+
+		CHECK(!culler.TestBox(Box(0.f, 0.f, 0.7f, 0.9f, 0.9f)));
+		CHECK(culler.TestBox(Box(0.f, 0.f, 0.5f, 0.9f, 0.9f)));
+
+		std::vector<FLOAT> depth{};
+		culler.ResolveDepth(depth);
+		REQUIRE(depth.size() == 64 * 32);
+
+		for (const auto d : depth) CHECK(d <= 0.6f + 1e-5f);
+	}
+}
+
+TEST_CASE(MaskedOcclusionCuller, RestartsTheWorkingLayerForDistantOccluders) {
+	// One tile: NDC x covers 8 pixels, 0.25 each.
+	const auto ColumnX = [](UINT column) { return -1.f + 0.25f * column; };
+
+	for (const BOOL bAvx2 : Paths()) {
+		MaskedOcclusionCuller culler;
+		culler.Initialize(bAvx2, MaskedOcclusionCuller::TileWidth, MaskedOcclusionCuller::TileHeight);
+
+		std::vector<FLOAT> depth{};
+
+		// A near sliver and a far block covering half the tile: the block is
+		// nearer the reference in pixel-weighted distance, so it starts a new
+		// layer and the sliver falls back to the far plane.
+		culler.Clear(Identity());
+		RenderRect(culler, ColumnX(0), -1.f, ColumnX(1), 1.f, 0.2f);
+		RenderRect(culler, ColumnX(2), -1.f, ColumnX(6), 1.f, 0.95f);
+		culler.ResolveDepth(depth);
+
+		CHECK_NEAR(depth[0], 1.f, 1e-5f);
+		CHECK_NEAR(depth[3], 0.95f, 1e-5f);
+		CHECK_NEAR(depth[7], 1.f, 1e-5f);
+
+		// The same block close to the sliver joins its layer instead.
+		culler.Clear(Identity());
+		RenderRect(culler, ColumnX(0), -1.f, ColumnX(1), 1.f, 0.2f);
+		RenderRect(culler, ColumnX(2), -1.f, ColumnX(6), 1.f, 0.4f);
+		culler.ResolveDepth(depth);
+
+		CHECK_NEAR(depth[0], 0.4f, 1e-5f);
+		CHECK_NEAR(depth[3], 0.4f, 1e-5f);
+		CHECK_NEAR(depth[7], 1.f, 1e-5f);
+
+		// Covering the rest of the tile promotes the layer to the reference.
+		RenderRect(culler, ColumnX(0), -1.f, ColumnX(8), 1.f, 0.5f);
+		CHECK(!culler.TestBox(Box(0.f, 0.f, 0.6f, 0.7f, 0.5f)));
+		CHECK(culler.TestBox(Box(0.f, 0.f, 0.45f, 0.7f, 0.5f)));
+	}
+}
\ No newline at end of file
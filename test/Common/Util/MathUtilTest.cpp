@@ -0,0 +1,29 @@
+#include "UnitTest.hpp"
+
+#include "Common/Util/MathUtil.hpp"
+
+using namespace Common::Util;
+using namespace DirectX;
+
+TEST_CASE(MathUtil, WrapAngle) {
+	CHECK_NEAR(MathUtil::WrapAngle(0.5f), 0.5f, 1e-5f);
+	CHECK_NEAR(MathUtil::WrapAngle(XM_2PI + 0.5f), 0.5f, 1e-5f);
+	CHECK_NEAR(MathUtil::WrapAngle(-XM_2PI - 0.5f), -0.5f, 1e-5f);
+	CHECK_NEAR(MathUtil::WrapAngle(XM_PI + 0.25f), -XM_PI + 0.25f, 1e-5f);
+}
+
+TEST_CASE(MathUtil, LerpAngleTakesShortArc) {
+	CHECK_NEAR(MathUtil::LerpAngle(0.f, 1.f, 0.5f), 0.5f, 1e-5f);
+	CHECK_NEAR(MathUtil::LerpAngle(1.f, 0.f, 0.25f), 0.75f, 1e-5f);
+
+	// Across the seam: from just below PI to just above -PI is a 0.2 rad turn.
+	const float a = XM_PI - 0.1f;
+	const float b = -XM_PI + 0.1f;
+	const float mid = MathUtil::LerpAngle(a, b, 0.5f);
+	CHECK(std::abs(std::abs(mid) - XM_PI) < 1e-4f);
+	CHECK_NEAR(MathUtil::LerpAngle(a, b, 0.25f), XM_PI - 0.05f, 1e-4f);
+	CHECK_NEAR(MathUtil::LerpAngle(a, b, 0.75f), -XM_PI + 0.05f, 1e-4f);
+
+	CHECK_NEAR(MathUtil::LerpAngle(a, b, 0.f), a, 1e-5f);
+	CHECK_NEAR(MathUtil::LerpAngle(a, b, 1.f), b, 1e-5f);
+}
\ No newline at end of file
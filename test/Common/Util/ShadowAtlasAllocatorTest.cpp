@@ -0,0 +1,122 @@
+#include "UnitTest.hpp"
+
+#include <random>
+
+#include "Common/Util/ShadowAtlasAllocator.hpp"
+
+using namespace Common::Util;
+
+namespace {
+	BOOL Overlap(const ShadowAtlasAllocator::Page& a, const ShadowAtlasAllocator::Page& b) {
+		return a.X < b.X + b.Size && b.X < a.X + a.Size && a.Y < b.Y + b.Size && b.Y < a.Y + a.Size;
+	}
+
+	BOOL AnyOverlap(const std::vector<ShadowAtlasAllocator::Page>& pages) {
+		for (size_t i = 0; i < pages.size(); ++i)
+			for (size_t j = i + 1; j < pages.size(); ++j)
+				if (Overlap(pages[i], pages[j])) return TRUE;
+		return FALSE;
+	}
+}
+
+TEST_CASE(ShadowAtlasAllocator, RoundsSizesToPowersOfTwo) {
+	ShadowAtlasAllocator allocator;
+	allocator.Initialize(1000, 100);
+	CHECK(allocator.AtlasSize() == 1024);
+	CHECK(allocator.MinPageSize() == 128);
+
+	ShadowAtlasAllocator::Page page;
+	REQUIRE(allocator.Allocate(300, page));
+	CHECK(ShadowAtlasAllocator::IsAllocated(page));
+	CHECK(page.Size == 512);
+	allocator.Free(page);
+	CHECK(!ShadowAtlasAllocator::IsAllocated(page));
+
+	// Clamped to the minimum page and to the atlas.
+	REQUIRE(allocator.Allocate(1, page));
+	CHECK(page.Size == 128);
+	allocator.Free(page);
+
+	REQUIRE(allocator.Allocate(5000, page));
+	CHECK(page.Size == 1024);
+	CHECK(page.X == 0);
+	CHECK(page.Y == 0);
+}
+
+TEST_CASE(ShadowAtlasAllocator, FillsTheAtlasWithoutOverlap) {
+	ShadowAtlasAllocator allocator;
+	allocator.Initialize(1024, 256);
+
+	std::vector<ShadowAtlasAllocator::Page> pages{};
+	ShadowAtlasAllocator::Page page;
+	while (allocator.Allocate(256, page)) pages.push_back(page);
+
+	CHECK(pages.size() == 16);
+	CHECK(!AnyOverlap(pages));
+	for (const auto& p : pages) CHECK(p.X + p.Size <= 1024 && p.Y + p.Size <= 1024);
+
+	// A failed allocation leaves the page invalid.
+	CHECK(!ShadowAtlasAllocator::IsAllocated(page));
+	CHECK(!allocator.Allocate(512, page));
+}
+
+TEST_CASE(ShadowAtlasAllocator, MergesQuadrantsOnceAllAreFree) {
+	ShadowAtlasAllocator allocator;
+	allocator.Initialize(1024, 256);
+
+	ShadowAtlasAllocator::Page small[4];
+	for (auto& page : small) REQUIRE(allocator.Allocate(256, page));
+
+	// The four smallest pages share one quadrant, so the other three stay whole.
+	ShadowAtlasAllocator::Page large[3];
+	for (auto& page : large) REQUIRE(allocator.Allocate(512, page));
+
+	ShadowAtlasAllocator::Page page;
+	CHECK(!allocator.Allocate(256, page));
+
+	// Three of the four free leave the quadrant split.
+	for (UINT i = 0; i < 3; ++i) allocator.Free(small[i]);
+	CHECK(!allocator.Allocate(512, page));
+
+	allocator.Free(small[3]);
+	REQUIRE(allocator.Allocate(512, page));
+	allocator.Free(page);
+
+	for (auto& p : large) allocator.Free(p);
+	REQUIRE(allocator.Allocate(1024, page));
+
+	// Reset frees everything regardless of outstanding pages.
+	allocator.Reset();
+	REQUIRE(allocator.Allocate(1024, page));
+}
+
+TEST_CASE(ShadowAtlasAllocator, RandomAllocateFreeKeepsPagesDisjoint) {
+	ShadowAtlasAllocator allocator;
+	allocator.Initialize(8192, 256);
+
+	std::mt19937 rng(41);
+	std::uniform_int_distribution<UINT> sizeShift(0, 3);
+	std::uniform_int_distribution<UINT> coin(0, 2);
+
+	std::vector<ShadowAtlasAllocator::Page> pages{};
+	for (UINT step = 0; step < 2000; ++step) {
+		if (!pages.empty() && coin(rng) == 0) {
+			const size_t Index = rng() % pages.size();
+			allocator.Free(pages[Index]);
+			pages[Index] = pages.back();
+			pages.pop_back();
+			continue;
+		}
+
+		ShadowAtlasAllocator::Page page;
+		if (allocator.Allocate(256u << sizeShift(rng), page)) pages.push_back(page);
+	}
+
+	CHECK(!AnyOverlap(pages));
+
+	// Every page back means the whole atlas is free again.
+	for (auto& page : pages) allocator.Free(page);
+
+	ShadowAtlasAllocator::Page whole;
+	CHECK(allocator.Allocate(8192, whole));
+}
\ No newline at end of file
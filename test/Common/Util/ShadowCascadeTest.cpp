@@ -0,0 +1,159 @@
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/Util/ShadowCascade.hpp"
+
+using namespace Common::Util;
+using namespace DirectX;
+
+namespace {
+	const FLOAT NearZ = 0.1f;
+	const FLOAT FarZ = 500.f;
+	const UINT CascadeCount = 4;
+
+	XMFLOAT4X4 Projection() {
+		XMFLOAT4X4 proj;
+		XMStoreFloat4x4(&proj, XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.f / 9.f, NearZ, FarZ));
+		return proj;
+	}
+
+	// The eight view-space corners of the camera frustum between two depths.
+	void SliceCorners(const XMFLOAT4X4& proj, FLOAT sliceNear, FLOAT sliceFar, XMFLOAT3 corners[8]) {
+		const FLOAT TanX = 1.f / proj._11;
+		const FLOAT TanY = 1.f / proj._22;
+
+		for (UINT i = 0; i < 8; ++i) {
+			const FLOAT z = (i & 4) ? sliceFar : sliceNear;
+			corners[i] = XMFLOAT3((i & 1 ? 1.f : -1.f) * TanX * z, (i & 2 ? 1.f : -1.f) * TanY * z, z);
+		}
+	}
+
+	FLOAT Distance(const XMFLOAT3& a, const XMFLOAT3& b) {
+		return XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&a), XMLoadFloat3(&b))));
+	}
+
+	XMFLOAT3 Project(const XMFLOAT4X4& viewProj, const XMFLOAT3& p) {
+		XMFLOAT3 ndc;
+		XMStoreFloat3(&ndc, XMVector3TransformCoord(XMLoadFloat3(&p), XMLoadFloat4x4(&viewProj)));
+		return ndc;
+	}
+}
+
+TEST_CASE(ShadowCascade, BlendsUniformAndLogarithmicSplits) {
+	FLOAT uniform[CascadeCount], logarithmic[CascadeCount], blended[CascadeCount];
+	ShadowCascade::ComputeSplits(NearZ, FarZ, 0.f, CascadeCount, uniform);
+	ShadowCascade::ComputeSplits(NearZ, FarZ, 1.f, CascadeCount, logarithmic);
+	ShadowCascade::ComputeSplits(NearZ, FarZ, 0.75f, CascadeCount, blended);
+
+	for (UINT i = 0; i < CascadeCount; ++i) {
+		const FLOAT p = static_cast<FLOAT>(i + 1) / CascadeCount;
+
+		CHECK_NEAR(uniform[i], NearZ + (FarZ - NearZ) * p, 1e-3f);
+		CHECK_NEAR(logarithmic[i], NearZ * powf(FarZ / NearZ, p), 1e-3f * logarithmic[i]);
+		CHECK_NEAR(blended[i], 0.75f * logarithmic[i] + 0.25f * uniform[i], 1e-3f * blended[i]);
+
+		// Log splits keep the near cascades tight.
+		CHECK(logarithmic[i] <= blended[i] + 1e-4f);
+		CHECK(blended[i] <= uniform[i] + 1e-4f);
+
+		if (i > 0) CHECK(blended[i] > blended[i - 1]);
+	}
+
+	// The last split is the far plane exactly.
+	CHECK(uniform[CascadeCount - 1] == FarZ);
+	CHECK(logarithmic[CascadeCount - 1] == FarZ);
+	CHECK(blended[CascadeCount - 1] == FarZ);
+}
+
+TEST_CASE(ShadowCascade, SliceSphereBoundsTheSlice) {
+	const auto Proj = Projection();
+
+	FLOAT splits[CascadeCount];
+	ShadowCascade::ComputeSplits(NearZ, FarZ, 0.75f, CascadeCount, splits);
+
+	FLOAT sliceNear = NearZ;
+	for (UINT i = 0; i < CascadeCount; ++i) {
+		const auto Sphere = ShadowCascade::FitSliceSphere(Proj, sliceNear, splits[i]);
+		CHECK(Sphere.Center.x == 0.f);
+		CHECK(Sphere.Center.y == 0.f);
+
+		XMFLOAT3 corners[8];
+		SliceCorners(Proj, sliceNear, splits[i], corners);
+
+		FLOAT farthest = 0.f;
+		for (const auto& corner : corners) farthest = std::max(farthest, Distance(Sphere.Center, corner));
+
+		// Contains every corner and touches at least one, so it is no larger than needed.
+		CHECK(farthest <= Sphere.Radius * (1.f + 1e-5f));
+		CHECK(farthest >= Sphere.Radius * (1.f - 1e-4f));
+
+		sliceNear = splits[i];
+	}
+}
+
+TEST_CASE(ShadowCascade, CascadeCoversTheSlice) {
+	const UINT Resolution = 2048;
+	const BoundingSphere Slice(XMFLOAT3(30.f, 4.f, -12.f), 25.f);
+	const BoundingSphere Scene(XMFLOAT3(0.f, 0.f, 0.f), 300.f);
+	const XMFLOAT3 LightDir(0.3f, -0.8f, 0.5f);
+
+	const auto ViewProj = ShadowCascade::FitCascade(Slice, LightDir, Scene, Resolution);
+
+	// Points on the sphere along each axis land inside the map.
+	const XMFLOAT3 Offsets[] = {
+		{ 1.f, 0.f, 0.f }, { -1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f },
+		{ 0.f, -1.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f, -1.f } };
+	for (const auto& offset : Offsets) {
+		const XMFLOAT3 Point(
+			Slice.Center.x + offset.x * Slice.Radius,
+			Slice.Center.y + offset.y * Slice.Radius,
+			Slice.Center.z + offset.z * Slice.Radius);
+
+		const auto Ndc = Project(ViewProj, Point);
+		CHECK(Ndc.x >= -1.f && Ndc.x <= 1.f);
+		CHECK(Ndc.y >= -1.f && Ndc.y <= 1.f);
+		CHECK(Ndc.z >= 0.f && Ndc.z <= 1.f);
+	}
+
+	// A caster inside the scene, far out between the light and the slice,
+	// is still in depth range.
+	XMFLOAT3 dir;
+	XMStoreFloat3(&dir, XMVector3Normalize(XMLoadFloat3(&LightDir)));
+	const FLOAT Back = 200.f;
+	const XMFLOAT3 Caster(Slice.Center.x - dir.x * Back, Slice.Center.y - dir.y * Back, Slice.Center.z - dir.z * Back);
+	const auto CasterNdc = Project(ViewProj, Caster);
+	CHECK(CasterNdc.z >= 0.f);
+}
+
+TEST_CASE(ShadowCascade, MovesTheWindowInWholeTexels) {
+	const UINT Resolution = 1024;
+	const BoundingSphere Scene(XMFLOAT3(0.f, 0.f, 0.f), 300.f);
+	const XMFLOAT3 LightDir(-0.4f, -0.7f, 0.2f);
+	const XMFLOAT3 Anchor(5.f, 2.f, 7.f);
+
+	BoundingSphere slice(XMFLOAT3(0.f, 0.f, 0.f), 40.f);
+	const auto Reference = ShadowCascade::FitCascade(slice, LightDir, Scene, Resolution);
+	const auto AnchorNdc = Project(Reference, Anchor);
+
+	// A fixed world point keeps its position within a texel as the slice
+	// slides, so static shadows do not shimmer.
+	const FLOAT TexelNdc = 2.f / Resolution;
+	for (UINT step = 1; step <= 50; ++step) {
+		slice.Center = XMFLOAT3(step * 0.137f, step * -0.051f, step * 0.093f);
+
+		const auto ViewProj = ShadowCascade::FitCascade(slice, LightDir, Scene, Resolution);
+		const auto Ndc = Project(ViewProj, Anchor);
+
+		const FLOAT ShiftX = (Ndc.x - AnchorNdc.x) / TexelNdc;
+		const FLOAT ShiftY = (Ndc.y - AnchorNdc.y) / TexelNdc;
+		CHECK_NEAR(ShiftX, std::round(ShiftX), 1e-2f);
+		CHECK_NEAR(ShiftY, std::round(ShiftY), 1e-2f);
+	}
+
+	// The same input gives the same matrix bit for bit.
+	slice.Center = XMFLOAT3(0.f, 0.f, 0.f);
+	const auto Again = ShadowCascade::FitCascade(slice, LightDir, Scene, Resolution);
+	CHECK(std::memcmp(&Again, &Reference, sizeof(XMFLOAT4X4)) == 0);
+}
\ No newline at end of file
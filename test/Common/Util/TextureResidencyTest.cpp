@@ -0,0 +1,247 @@
+#include "UnitTest.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include "Common/Util/TextureResidency.hpp"
+
+using namespace Common::Util;
+
+namespace {
+	using Change = TextureResidency::Change;
+
+	// Five mips of a 16x16 texture at one byte per texel; the last two are
+	// the resident tail.
+	const UINT64 MipSizes[] = { 256, 64, 16, 4, 1 };
+	const UINT MipCount = _countof(MipSizes);
+	const UINT TailMip = 3;
+	const UINT64 TailBytes = MipSizes[3] + MipSizes[4];
+
+	UINT64 BytesFrom(UINT mip) {
+		UINT64 bytes = 0;
+		for (UINT i = mip; i < MipCount; ++i) bytes += MipSizes[i];
+		return bytes;
+	}
+
+	BOOL Contains(const std::vector<Change>& changes, UINT texture) {
+		return std::any_of(changes.begin(), changes.end(), [&](const Change& change) { return change.Texture == texture; });
+	}
+
+	// Runs frames of the same requests, landing every load right away, until
+	// no more loads are handed out. Evictions of all frames are collected.
+	UINT64 Settle(
+			TextureResidency& residency,
+			UINT64 frame,
+			const std::vector<std::pair<UINT, UINT>>& requests,
+			std::vector<Change>& evictions) {
+		std::vector<Change> loads, frameEvictions;
+		evictions.clear();
+
+		for (;; ++frame) {
+			for (const auto& request : requests) residency.Request(request.first, request.second, frame);
+			residency.Update(frame, loads, frameEvictions);
+			evictions.insert(evictions.end(), frameEvictions.begin(), frameEvictions.end());
+
+			if (loads.empty()) return frame;
+			for (const auto& load : loads) residency.OnLoaded(load.Texture, TRUE);
+		}
+	}
+}
+
+TEST_CASE(TextureResidency, LoadsOneMipPerUpdate) {
+	TextureResidency residency;
+	residency.Initialize(1 << 20, 4);
+
+	const UINT Texture = residency.AddTexture(MipSizes, MipCount, TailMip);
+	CHECK(residency.ResidentMip(Texture) == TailMip);
+	CHECK(residency.ResidentBytes() == TailBytes);
+
+	std::vector<Change> loads, evictions;
+	for (UINT expected = TailMip; expected-- > 0;) {
+		residency.Request(Texture, 0, 1);
+		residency.Update(1, loads, evictions);
+		REQUIRE(loads.size() == 1);
+		CHECK(loads[0].Texture == Texture);
+		CHECK(loads[0].TopMip == expected);
+		CHECK(residency.ResidentBytes() == BytesFrom(expected));
+
+		// Nothing more for the texture while its load is in flight.
+		residency.Update(1, loads, evictions);
+		CHECK(loads.empty());
+		CHECK(residency.LoadsInFlight() == 1);
+
+		residency.OnLoaded(Texture, TRUE);
+		CHECK(residency.ResidentMip(Texture) == expected);
+		CHECK(residency.LoadsInFlight() == 0);
+	}
+
+	residency.Update(1, loads, evictions);
+	CHECK(loads.empty());
+	CHECK(evictions.empty());
+}
+
+TEST_CASE(TextureResidency, LargestShortfallLoadsFirst) {
+	TextureResidency residency;
+	residency.Initialize(1 << 20, 1);
+
+	const UINT Near = residency.AddTexture(MipSizes, MipCount, TailMip);
+	const UINT Far = residency.AddTexture(MipSizes, MipCount, TailMip);
+
+	std::vector<Change> loads, evictions;
+	residency.Request(Far, 2, 1);
+	residency.Request(Near, 0, 1);
+	// A later request of the same frame for less detail does not lower it.
+	residency.Request(Near, 2, 1);
+	residency.Update(1, loads, evictions);
+
+	REQUIRE(loads.size() == 1);
+	CHECK(loads[0].Texture == Near);
+}
+
+TEST_CASE(TextureResidency, EvictsLeastRecentlyUsedUnderBudget) {
+	TextureResidency residency;
+	// Room for the tails and exactly two fully resident textures.
+	residency.Initialize(3 * TailBytes + 2 * (BytesFrom(0) - TailBytes), 2);
+
+	const UINT A = residency.AddTexture(MipSizes, MipCount, TailMip);
+	const UINT B = residency.AddTexture(MipSizes, MipCount, TailMip);
+	const UINT C = residency.AddTexture(MipSizes, MipCount, TailMip);
+
+	std::vector<Change> evictions;
+	UINT64 frame = Settle(residency, 1, { { A, 0 }, { B, 0 } }, evictions);
+	CHECK(evictions.empty());
+	CHECK(residency.ResidentMip(A) == 0);
+	CHECK(residency.ResidentMip(B) == 0);
+	CHECK(residency.ResidentBytes() == residency.Budget());
+
+	// B stays in use a while longer, so A is the one to go.
+	frame = Settle(residency, frame + 1, { { B, 0 } }, evictions);
+	frame = Settle(residency, frame + 1, { { C, 1 } }, evictions);
+
+	CHECK(residency.ResidentMip(C) == 1);
+	CHECK(residency.ResidentMip(B) == 0);
+	CHECK(Contains(evictions, A));
+	CHECK(!Contains(evictions, B));
+	// Only as much of A as C needed: its top mip makes room for both loads.
+	CHECK(residency.ResidentMip(A) == 1);
+	CHECK(residency.ResidentBytes() <= residency.Budget());
+}
+
+TEST_CASE(TextureResidency, ShrinkingBudgetEvictsUnusedFirst) {
+	TextureResidency residency;
+	residency.Initialize(1 << 20, 4);
+
+	const UINT A = residency.AddTexture(MipSizes, MipCount, TailMip);
+	const UINT B = residency.AddTexture(MipSizes, MipCount, TailMip);
+
+	std::vector<Change> loads, evictions;
+	const UINT64 Frame = Settle(residency, 1, { { A, 0 }, { B, 0 } }, evictions) + 1;
+	CHECK(residency.ResidentBytes() == 2 * BytesFrom(0));
+
+	// A is still in use this frame and keeps what it asks for; B is not and
+	// goes down to its tail.
+	residency.SetBudget(BytesFrom(0) + TailBytes);
+	residency.Request(A, 0, Frame);
+	residency.Update(Frame, loads, evictions);
+
+	CHECK(loads.empty());
+	REQUIRE(evictions.size() == 1);
+	CHECK(evictions[0].Texture == B);
+	CHECK(evictions[0].TopMip == TailMip);
+	CHECK(residency.ResidentMip(A) == 0);
+	CHECK(residency.ResidentBytes() == residency.Budget());
+
+	// Used textures give up the detail they no longer ask for, but never
+	// their tail.
+	residency.SetBudget(0);
+	residency.Request(A, 2, Frame + 1);
+	residency.Update(Frame + 1, loads, evictions);
+
+	REQUIRE(evictions.size() == 1);
+	CHECK(evictions[0].Texture == A);
+	CHECK(evictions[0].TopMip == 2);
+	CHECK(residency.ResidentBytes() == BytesFrom(2) + TailBytes);
+}
+
+TEST_CASE(TextureResidency, FailedLoadCapsTexture) {
+	TextureResidency residency;
+	residency.Initialize(1 << 20, 4);
+
+	const UINT Texture = residency.AddTexture(MipSizes, MipCount, TailMip);
+
+	std::vector<Change> loads, evictions;
+	residency.Request(Texture, 0, 1);
+	residency.Update(1, loads, evictions);
+	REQUIRE(loads.size() == 1);
+	CHECK(residency.ResidentBytes() == BytesFrom(2));
+
+	// The bytes come back and the texture is not asked for again.
+	residency.OnLoaded(Texture, FALSE);
+	CHECK(residency.ResidentMip(Texture) == TailMip);
+	CHECK(residency.ResidentBytes() == TailBytes);
+	CHECK(residency.LoadsInFlight() == 0);
+
+	residency.Request(Texture, 0, 2);
+	residency.Update(2, loads, evictions);
+	CHECK(loads.empty());
+
+	// A late or repeated completion is ignored.
+	residency.OnLoaded(Texture, TRUE);
+	CHECK(residency.ResidentMip(Texture) == TailMip);
+}
+
+TEST_CASE(TextureResidency, RandomRequestsKeepAccounting) {
+	const UINT TextureCount = 32;
+	const UINT MaxLoads = 3;
+
+	TextureResidency residency;
+	residency.Initialize(TextureCount * TailBytes + 2000, MaxLoads);
+	for (UINT i = 0; i < TextureCount; ++i) residency.AddTexture(MipSizes, MipCount, TailMip);
+
+	std::mt19937 rng(47);
+	std::uniform_int_distribution<UINT> texture(0, TextureCount - 1);
+	std::uniform_int_distribution<UINT> mip(0, MipCount - 1);
+	std::uniform_int_distribution<UINT> percent(0, 99);
+
+	std::vector<INT> inFlight(TextureCount, -1);
+	std::vector<Change> loads, evictions;
+
+	for (UINT64 frame = 1; frame <= 500; ++frame) {
+		if (frame % 50 == 0)
+			residency.SetBudget(TextureCount * TailBytes + 500 + percent(rng) * 30);
+
+		for (UINT i = 0; i < 12; ++i) residency.Request(texture(rng), mip(rng), frame);
+		residency.Update(frame, loads, evictions);
+
+		for (const auto& eviction : evictions) {
+			CHECK(inFlight[eviction.Texture] < 0);
+			CHECK(eviction.TopMip <= TailMip);
+		}
+
+		// Loads go past the budget neither alone nor together.
+		if (!loads.empty()) CHECK(residency.ResidentBytes() <= residency.Budget());
+		CHECK(residency.LoadsInFlight() <= MaxLoads);
+
+		for (const auto& load : loads) {
+			CHECK(inFlight[load.Texture] < 0);
+			CHECK(load.TopMip + 1 == residency.ResidentMip(load.Texture));
+			inFlight[load.Texture] = static_cast<INT>(load.TopMip);
+		}
+
+		// Some loads take a few frames and a few fail.
+		for (UINT i = 0; i < TextureCount; ++i) {
+			if (inFlight[i] < 0 || percent(rng) < 40) continue;
+
+			residency.OnLoaded(i, percent(rng) >= 10);
+			inFlight[i] = -1;
+		}
+
+		// Resident bytes are the resident mips plus the loads in flight.
+		UINT64 expected = 0;
+		for (UINT i = 0; i < TextureCount; ++i) {
+			expected += BytesFrom(residency.ResidentMip(i));
+			if (inFlight[i] >= 0) expected += MipSizes[inFlight[i]];
+		}
+		CHECK(residency.ResidentBytes() == expected);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "UnitTest.hpp"
+
+#include "GameWorld/Foundation/Core/pch_world.h"
+#include "GameWorld/Foundation/Core/SimulationClock.hpp"
+
+using namespace GameWorld::Foundation::Core;
+
+TEST_CASE(SimulationClock, StepsMatchElapsedTime) {
+	SimulationClock clock(1.f / 60.f, 8);
+
+	// At 144 Hz no frame is due more than one 60 Hz step, and one second
+	// of frames adds up to 60 of them.
+	UINT total = 0;
+	for (UINT frame = 0; frame < 144; ++frame) {
+		const UINT steps = clock.Advance(1.f / 144.f);
+		CHECK(steps <= 1);
+		CHECK(clock.Alpha() >= 0.f && clock.Alpha() < 1.f);
+		total += steps;
+	}
+
+	// Rounding may leave the final step a hair short of due.
+	CHECK(total == 59 || total == 60);
+}
+
+TEST_CASE(SimulationClock, AlphaIsLeftoverFraction) {
+	SimulationClock clock(0.1f, 8);
+
+	CHECK(clock.Advance(0.025f) == 0);
+	CHECK_NEAR(clock.Alpha(), 0.25f, 1e-4f);
+
+	CHECK(clock.Advance(0.1f) == 1);
+	CHECK_NEAR(clock.Alpha(), 0.25f, 1e-4f);
+
+	CHECK(clock.Advance(0.2f) == 2);
+	CHECK_NEAR(clock.Alpha(), 0.25f, 1e-4f);
+}
+
+TEST_CASE(SimulationClock, BacklogBeyondCapIsDropped) {
+	SimulationClock clock(0.1f, 4);
+
+	// A one-second hitch is capped at four steps and does not carry over.
+	CHECK(clock.Advance(1.05f) == 4);
+	CHECK_NEAR(clock.Alpha(), 0.5f, 1e-3f);
+
+	CHECK(clock.Advance(0.08f) == 1);
+	CHECK_NEAR(clock.Alpha(), 0.3f, 1e-3f);
+}
+
+TEST_CASE(SimulationClock, ResetAndNegativeDelta) {
+	SimulationClock clock(0.1f, 8);
+
+	clock.Advance(0.05f);
+	clock.Reset();
+	CHECK(clock.Alpha() == 0.f);
+
+	CHECK(clock.Advance(-1.f) == 0);
+	CHECK(clock.Alpha() == 0.f);
+
+	clock.SetMaxSubsteps(0);
+	CHECK(clock.MaxSubsteps() == 1);
+	CHECK(clock.Advance(0.5f) == 1);
+}
\ No newline at end of file
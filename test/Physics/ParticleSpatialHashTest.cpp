@@ -0,0 +1,202 @@
+#include "UnitTest.hpp"
+
+#include <format>
+
+#include "Physics/pch_cyclone.h"
+#include "Physics/ParticleSpatialHash.hpp"
+#include "Physics/ParticleForceRegistry.hpp"
+#include "Physics/ParticlePairForceGenerator.hpp"
+#include "Physics/Particle.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX;
+
+namespace {
+	using Pair = ParticleSpatialHash::Pair;
+
+	std::vector<Particle> ScatterParticles(UINT count, float extent, UINT seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> dist(-extent, extent);
+
+		std::vector<Particle> particles(count);
+		for (auto& particle : particles)
+			particle.SetPosition({ dist(rng), dist(rng), dist(rng) });
+
+		return particles;
+	}
+
+	std::vector<Pair> BruteForcePairs(const std::vector<Particle>& particles, float radius) {
+		std::vector<Pair> pairs;
+
+		const UINT count = static_cast<UINT>(particles.size());
+		for (UINT i = 0; i < count; ++i) {
+			for (UINT j = i + 1; j < count; ++j) {
+				const auto diff = particles[i].GetPosition() - particles[j].GetPosition();
+				if (diff.LengthSquared() < radius * radius) pairs.push_back({ i, j });
+			}
+		}
+
+		return pairs;
+	}
+
+	BOOL SamePairs(const std::vector<Pair>& a, const std::vector<Pair>& b) {
+		if (a.size() != b.size()) return FALSE;
+		for (size_t i = 0; i < a.size(); ++i) {
+			if (a[i].First != b[i].First || a[i].Second != b[i].Second) return FALSE;
+		}
+		return TRUE;
+	}
+
+	// Records the neighbours each particle was visited with. The registry
+	// calls this from several workers, but each call only touches the slot
+	// of the particle being updated.
+	class NeighbourRecorder : public ParticlePairForceGenerator {
+	public:
+		NeighbourRecorder(const Particle* pBase, UINT count, float range)
+			: mpBase{ pBase }, mRange{ range }, mNeighbours(count) {}
+
+	public:
+		virtual float Range() const override { return mRange; }
+
+		virtual void UpdateForce(Particle* pParticle, const Particle* pOther, float) override {
+			mNeighbours[pParticle - mpBase].push_back(static_cast<UINT>(pOther - mpBase));
+		}
+
+	public:
+		const Particle* mpBase;
+		float mRange;
+		std::vector<std::vector<UINT>> mNeighbours;
+	};
+}
+
+TEST_CASE(ParticleSpatialHash, GatherPairsMatchesBruteForce) {
+	const float radius = 0.5f;
+
+	// Once below and once above the threshold where the work is split across threads.
+	for (UINT count : { 500u, ParticleSpatialHash::ParallelThreshold + 1000u }) {
+		auto particles = ScatterParticles(count, 8.f, count);
+
+		ParticleSpatialHash grid;
+		grid.Build(particles.data(), count, radius);
+
+		std::vector<Pair> pairs;
+		grid.GatherPairs(radius, pairs);
+
+		const auto expected = BruteForcePairs(particles, radius);
+		CHECK(!expected.empty());
+		CHECK(SamePairs(pairs, expected));
+	}
+}
+
+TEST_CASE(ParticleSpatialHash, GatherPairsIsDeterministic) {
+	const UINT count = ParticleSpatialHash::ParallelThreshold * 2;
+	const float radius = 0.4f;
+
+	auto particles = ScatterParticles(count, 6.f, 7);
+
+	ParticleSpatialHash grid;
+	grid.Build(particles.data(), count, radius);
+
+	std::vector<Pair> first;
+	grid.GatherPairs(radius, first);
+
+	for (UINT run = 0; run < 8; ++run) {
+		std::vector<Pair> pairs;
+		grid.GatherPairs(radius, pairs);
+		CHECK(SamePairs(pairs, first));
+	}
+}
+
+TEST_CASE(ParticleSpatialHash, GatherPairsKeepsExistingPairs) {
+	std::vector<Particle> particles(3);
+	particles[0].SetPosition({ 0.f, 0.f, 0.f });
+	particles[1].SetPosition({ 0.1f, 0.f, 0.f });
+	particles[2].SetPosition({ 5.f, 0.f, 0.f });
+
+	ParticleSpatialHash grid;
+	grid.Build(particles.data(), 3, 1.f);
+
+	std::vector<Pair> pairs = { { 7, 9 } };
+	grid.GatherPairs(1.f, pairs);
+
+	REQUIRE(pairs.size() == 2);
+	CHECK(pairs[0].First == 7 && pairs[0].Second == 9);
+	CHECK(pairs[1].First == 0 && pairs[1].Second == 1);
+}
+
+TEST_CASE(ParticleSpatialHash, SmallCellsWidenTheSearch) {
+	// Cells a quarter of the radius wide: neighbours up to four cells away
+	// must still be found.
+	const UINT count = 800;
+	const float radius = 1.f;
+
+	auto particles = ScatterParticles(count, 5.f, 3);
+
+	ParticleSpatialHash grid;
+	grid.Build(particles.data(), count, radius * 0.25f);
+
+	std::vector<Pair> pairs;
+	grid.GatherPairs(radius, pairs);
+
+	CHECK(SamePairs(pairs, BruteForcePairs(particles, radius)));
+}
+
+TEST_CASE(ParticleForceRegistry, PairGeneratorVisitsEveryContact) {
+	const UINT count = ParticleSpatialHash::ParallelThreshold + 500;
+	const float range = 0.5f;
+
+	auto particles = ScatterParticles(count, 8.f, 11);
+
+	NeighbourRecorder recorder(particles.data(), count, range);
+
+	ParticleForceRegistry registry;
+	registry.Add(particles.data(), count, &recorder);
+	registry.UpdateForces(1.f / 60.f);
+
+	std::vector<std::vector<UINT>> expected(count);
+	for (const auto& pair : BruteForcePairs(particles, range)) {
+		expected[pair.First].push_back(pair.Second);
+		expected[pair.Second].push_back(pair.First);
+	}
+
+	UINT mismatches = 0;
+	for (UINT i = 0; i < count; ++i) {
+		auto& visited = recorder.mNeighbours[i];
+		std::sort(visited.begin(), visited.end());
+		std::sort(expected[i].begin(), expected[i].end());
+		if (visited != expected[i]) ++mismatches;
+	}
+	CHECK(mismatches == 0);
+
+	// Removing the registration stops the generator from being driven.
+	registry.Remove(particles.data(), &recorder);
+	for (auto& visited : recorder.mNeighbours) visited.clear();
+	registry.UpdateForces(1.f / 60.f);
+
+	UINT calls = 0;
+	for (const auto& visited : recorder.mNeighbours) calls += static_cast<UINT>(visited.size());
+	CHECK(calls == 0);
+}
+
+BENCHMARK_CASE(ParticleSpatialHash, RebuildAndGatherScaling) {
+	const float radius = 0.5f;
+
+	for (UINT count : { 10000u, 100000u, 1000000u }) {
+		// One particle per unit volume at every size, so each particle has
+		// the same neighbourhood and only the scaling shows.
+		auto particles = ScatterParticles(count, 0.5f * std::cbrt(static_cast<float>(count)), count);
+
+		ParticleSpatialHash grid;
+		const double BuildMs = UnitTest::MeasureMs(5, [&]() { grid.Build(particles.data(), count, radius); });
+
+		std::vector<Pair> pairs;
+		const double GatherMs = UnitTest::MeasureMs(5, [&]() {
+			pairs.clear();
+			grid.GatherPairs(radius, pairs);
+		});
+		CHECK(!pairs.empty());
+
+		UnitTest::ReportTime(std::format("Build, {} particles", count).c_str(), BuildMs);
+		UnitTest::ReportTime(std::format("GatherPairs, {} particles, {} pairs", count, pairs.size()).c_str(), GatherMs);
+	}
+}
\ No newline at end of file
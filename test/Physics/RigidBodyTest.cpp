@@ -0,0 +1,388 @@
+#include "UnitTest.hpp"
+
+#include <format>
+
+#include "Physics/pch_cyclone.h"
+#include "Physics/RigidBody.hpp"
+#include "Physics/RigidBodyWorld.hpp"
+#include "Physics/CollisionDetector.hpp"
+#include "Physics/CollisionSphere.hpp"
+#include "Physics/CollisionBox.hpp"
+#include "Physics/CollisionConvex.hpp"
+#include "Physics/CollisionTriangleMesh.hpp"
+
+using namespace Physics::Cyclone;
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace {
+	const float TimeStep = 1.f / 60.f;
+	const Vector3 Gravity{ 0.f, -9.81f, 0.f };
+
+	void MakeSphereBody(RigidBody& body, const Vector3& position, float radius, float mass = 1.f) {
+		body.SetMass(mass);
+		body.SetInertiaTensor(RigidBody::SphereInertiaTensor(mass, radius));
+		body.SetPosition(position);
+		body.CalculateDerivedData();
+	}
+
+	void MakeBoxBody(RigidBody& body, const Vector3& position, const Vector3& halfExtents, float mass = 1.f) {
+		body.SetMass(mass);
+		body.SetInertiaTensor(RigidBody::BoxInertiaTensor(mass, halfExtents));
+		body.SetPosition(position);
+		body.CalculateDerivedData();
+	}
+
+	void MakeStaticBody(RigidBody& body, const Vector3& position) {
+		body.SetInverseMass(0.f);
+		body.SetPosition(position);
+		body.CalculateDerivedData();
+	}
+
+	// Two triangles facing +y, spanning [-size, size] on x and z at height zero.
+	void BuildFloor(CollisionTriangleMesh& mesh, float size) {
+		const XMFLOAT3 positions[] = {
+			{ -size, 0.f, -size },
+			{ -size, 0.f,  size },
+			{  size, 0.f,  size },
+			{  size, 0.f, -size } };
+		const UINT indices[] = { 0, 1, 2, 0, 2, 3 };
+
+		mesh.Build(positions, sizeof(XMFLOAT3), 4, indices, 6, Matrix::Identity);
+	}
+
+	std::vector<Vector3> CubeVertices(float halfExtent) {
+		std::vector<Vector3> vertices;
+		for (UINT i = 0; i < 8; ++i) {
+			vertices.push_back({
+				(i & 1) ? halfExtent : -halfExtent,
+				(i & 2) ? halfExtent : -halfExtent,
+				(i & 4) ? halfExtent : -halfExtent });
+		}
+		return vertices;
+	}
+
+	// Every contact normal must point from the second body toward the first.
+	BOOL NormalsFaceFirstBody(const std::vector<Contact>& contacts, const Vector3& firstToSecond) {
+		for (const auto& contact : contacts) {
+			if (contact.Normal.Dot(firstToSecond) >= 0.f) return FALSE;
+		}
+		return TRUE;
+	}
+
+	// Exposes the islands of the last solve.
+	class IslandResolver : public ContactResolver {
+	public:
+		UINT IslandCount() const { return static_cast<UINT>(mIslands.size()); }
+
+		std::set<RigidBody*> IslandBodies(UINT island) const {
+			std::set<RigidBody*> bodies;
+			for (UINT i = mIslands[island].first; i < mIslands[island].second; ++i) {
+				for (auto pBody : mConstraints[i].Bodies) {
+					if (pBody != nullptr && pBody->HasFiniteMass()) bodies.insert(pBody);
+				}
+			}
+			return bodies;
+		}
+	};
+
+	Contact MakeTouch(RigidBody* pFirst, RigidBody* pSecond) {
+		Contact contact{};
+		contact.Bodies[0] = pFirst;
+		contact.Bodies[1] = pSecond;
+		contact.Point = pFirst->GetPosition();
+		contact.Normal = Vector3::UnitY;
+		contact.Penetration = 0.f;
+		contact.Friction = 0.5f;
+		return contact;
+	}
+
+	// Columns of unit boxes standing on a static ground slab.
+	struct StackScene {
+		RigidBody Ground;
+		std::unique_ptr<CollisionBox> GroundBox;
+
+		std::vector<RigidBody> Bodies;
+		std::vector<std::unique_ptr<CollisionBox>> Boxes;
+
+		RigidBodyWorld World{ 10 };
+
+		StackScene(UINT columnsX, UINT columnsZ, UINT height) {
+			const float spacing = 1.5f;
+			const Vector3 halfExtents{ 0.5f, 0.5f, 0.5f };
+
+			const float extent = spacing * std::max(columnsX, columnsZ);
+			MakeStaticBody(Ground, { 0.f, -0.5f, 0.f });
+			GroundBox = std::make_unique<CollisionBox>(&Ground, Vector3{ extent, 0.5f, extent });
+			World.AddPrimitive(GroundBox.get());
+
+			// Reserved up front; primitives keep pointers into the vector.
+			Bodies.resize(static_cast<size_t>(columnsX) * columnsZ * height);
+
+			UINT index = 0;
+			for (UINT x = 0; x < columnsX; ++x) {
+				for (UINT z = 0; z < columnsZ; ++z) {
+					for (UINT y = 0; y < height; ++y) {
+						auto& body = Bodies[index++];
+
+						const Vector3 position{
+							(static_cast<float>(x) - 0.5f * columnsX) * spacing,
+							0.5f + static_cast<float>(y),
+							(static_cast<float>(z) - 0.5f * columnsZ) * spacing };
+						MakeBoxBody(body, position, halfExtents);
+						body.SetAcceleration(Gravity);
+
+						Boxes.push_back(std::make_unique<CollisionBox>(&body, halfExtents));
+						World.AddBody(&body);
+						World.AddPrimitive(Boxes.back().get());
+					}
+				}
+			}
+		}
+
+		void Step() {
+			World.StartFrame();
+			World.RunPhysics(TimeStep);
+		}
+	};
+}
+
+TEST_CASE(CollisionDetector, SphereAndSphere) {
+	RigidBody first, second;
+	MakeSphereBody(first, { 0.f, 1.5f, 0.f }, 1.f);
+	MakeSphereBody(second, { 0.f, 0.f, 0.f }, 1.f);
+
+	CollisionSphere a(&first, 1.f), b(&second, 1.f);
+
+	std::vector<Contact> contacts;
+	REQUIRE(CollisionDetector::Collide(&a, &b, contacts) == 1);
+	CHECK(contacts[0].Bodies[0] == &first && contacts[0].Bodies[1] == &second);
+	CHECK_NEAR(contacts[0].Normal.y, 1.f, 1e-5f);
+	CHECK_NEAR(contacts[0].Penetration, 0.5f, 1e-5f);
+
+	// Separated spheres produce nothing.
+	second.SetPosition({ 0.f, -1.f, 0.f });
+	second.CalculateDerivedData();
+
+	contacts.clear();
+	CHECK(CollisionDetector::Collide(&a, &b, contacts) == 0);
+	CHECK(contacts.empty());
+}
+
+TEST_CASE(CollisionDetector, SphereAndBox) {
+	RigidBody sphereBody, boxBody;
+	MakeSphereBody(sphereBody, { 0.2f, 1.4f, -0.1f }, 0.5f);
+	MakeBoxBody(boxBody, { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f });
+
+	CollisionSphere sphere(&sphereBody, 0.5f);
+	CollisionBox box(&boxBody, { 1.f, 1.f, 1.f });
+
+	// The box is passed first; the detector reorders the pair, so the
+	// normal follows whichever body ends up first.
+	std::vector<Contact> contacts;
+	REQUIRE(CollisionDetector::Collide(&box, &sphere, contacts) == 1);
+
+	const auto& contact = contacts[0];
+	const Vector3 toSecond = contact.Bodies[1]->GetPosition() - contact.Bodies[0]->GetPosition();
+	CHECK(NormalsFaceFirstBody(contacts, toSecond));
+	CHECK_NEAR(std::abs(contact.Normal.y), 1.f, 1e-5f);
+	CHECK_NEAR(contact.Penetration, 0.1f, 1e-4f);
+	CHECK_NEAR(contact.Point.y, 1.f, 1e-4f);
+}
+
+TEST_CASE(CollisionDetector, BoxAndBoxBuildsFaceManifold) {
+	RigidBody upper, lower;
+	MakeBoxBody(upper, { 0.1f, 0.95f, 0.f }, { 0.5f, 0.5f, 0.5f });
+	MakeBoxBody(lower, { 0.f, 0.f, 0.f }, { 0.5f, 0.5f, 0.5f });
+
+	CollisionBox a(&upper, { 0.5f, 0.5f, 0.5f }), b(&lower, { 0.5f, 0.5f, 0.5f });
+
+	std::vector<Contact> contacts;
+	const UINT count = CollisionDetector::Collide(&a, &b, contacts);
+
+	// A face resting on a face needs at least the four corners of the
+	// overlap, or stacks start rocking.
+	CHECK(count >= 4);
+	CHECK(count == contacts.size());
+	CHECK(NormalsFaceFirstBody(contacts, lower.GetPosition() - upper.GetPosition()));
+
+	for (const auto& contact : contacts) {
+		CHECK_NEAR(contact.Normal.y, 1.f, 1e-3f);
+		CHECK_NEAR(contact.Penetration, 0.05f, 1e-3f);
+	}
+}
+
+TEST_CASE(CollisionDetector, ConvexAndConvex) {
+	RigidBody first, second;
+	MakeBoxBody(first, { 0.9f, 0.f, 0.f }, { 0.5f, 0.5f, 0.5f });
+	MakeBoxBody(second, { 0.f, 0.f, 0.f }, { 0.5f, 0.5f, 0.5f });
+
+	CollisionConvex a(&first, CubeVertices(0.5f)), b(&second, CubeVertices(0.5f));
+
+	std::vector<Contact> contacts;
+	REQUIRE(CollisionDetector::Collide(&a, &b, contacts) == 1);
+	CHECK_NEAR(contacts[0].Normal.x, 1.f, 1e-3f);
+	CHECK_NEAR(contacts[0].Penetration, 0.1f, 1e-3f);
+
+	// A sphere against a hull also goes through the generic path.
+	RigidBody sphereBody;
+	MakeSphereBody(sphereBody, { 0.f, 0.8f, 0.f }, 0.5f);
+	CollisionSphere sphere(&sphereBody, 0.5f);
+
+	contacts.clear();
+	REQUIRE(CollisionDetector::Collide(&b, &sphere, contacts) == 1);
+	CHECK(contacts[0].Bodies[0] == &sphereBody);
+	CHECK_NEAR(contacts[0].Normal.y, 1.f, 1e-3f);
+	CHECK_NEAR(contacts[0].Penetration, 0.2f, 1e-3f);
+
+	// Hulls that only share an axis range do not touch.
+	first.SetPosition({ 1.2f, 0.f, 0.f });
+	first.CalculateDerivedData();
+
+	contacts.clear();
+	CHECK(CollisionDetector::Collide(&a, &b, contacts) == 0);
+}
+
+TEST_CASE(CollisionDetector, PrimitiveAndTriangleMesh) {
+	CollisionTriangleMesh floor;
+	BuildFloor(floor, 10.f);
+	CHECK(floor.TriangleCount() == 2);
+	CHECK(floor.IsStatic());
+
+	RigidBody sphereBody;
+	MakeSphereBody(sphereBody, { 1.f, 0.4f, 2.f }, 0.5f);
+	CollisionSphere sphere(&sphereBody, 0.5f);
+
+	std::vector<Contact> contacts;
+	CHECK(CollisionDetector::Collide(&floor, &sphere, contacts) >= 1);
+	REQUIRE(!contacts.empty());
+	CHECK(contacts[0].Bodies[0] == &sphereBody && contacts[0].Bodies[1] == nullptr);
+	CHECK_NEAR(contacts[0].Normal.y, 1.f, 1e-5f);
+	CHECK_NEAR(contacts[0].Penetration, 0.1f, 1e-5f);
+
+	// A box sunk into the floor reports its four bottom corners.
+	RigidBody boxBody;
+	MakeBoxBody(boxBody, { -3.f, 0.45f, 1.f }, { 0.5f, 0.5f, 0.5f });
+	CollisionBox box(&boxBody, { 0.5f, 0.5f, 0.5f });
+
+	contacts.clear();
+	CHECK(CollisionDetector::Collide(&box, &floor, contacts) == 4);
+	for (const auto& contact : contacts) {
+		CHECK_NEAR(contact.Normal.y, 1.f, 1e-5f);
+		CHECK_NEAR(contact.Penetration, 0.05f, 1e-4f);
+	}
+
+	// Two static primitives never collide.
+	CollisionBox level(nullptr, { 1.f, 1.f, 1.f });
+	contacts.clear();
+	CHECK(CollisionDetector::Collide(&level, &floor, contacts) == 0);
+}
+
+TEST_CASE(RigidBodyWorld, RestingContactStaysAtRest) {
+	CollisionTriangleMesh floor;
+	BuildFloor(floor, 10.f);
+
+	RigidBody sphereBody, boxBody;
+	MakeSphereBody(sphereBody, { -2.f, 0.5f, 0.f }, 0.5f);
+	MakeBoxBody(boxBody, { 2.f, 0.5f, 0.f }, { 0.5f, 0.5f, 0.5f });
+	sphereBody.SetAcceleration(Gravity);
+	boxBody.SetAcceleration(Gravity);
+
+	CollisionSphere sphere(&sphereBody, 0.5f);
+	CollisionBox box(&boxBody, { 0.5f, 0.5f, 0.5f });
+
+	RigidBodyWorld world;
+	world.AddBody(&sphereBody);
+	world.AddBody(&boxBody);
+	world.AddPrimitive(&floor);
+	world.AddPrimitive(&sphere);
+	world.AddPrimitive(&box);
+
+	for (UINT step = 0; step < 180; ++step) {
+		world.StartFrame();
+		world.RunPhysics(TimeStep);
+	}
+
+	// Penetration settles within the solver slop and nothing drifts.
+	CHECK_NEAR(sphereBody.GetPosition().y, 0.5f, 0.02f);
+	CHECK_NEAR(boxBody.GetPosition().y, 0.5f, 0.02f);
+	CHECK_NEAR(sphereBody.GetPosition().x, -2.f, 1e-3f);
+	CHECK_NEAR(boxBody.GetPosition().x, 2.f, 1e-3f);
+
+	CHECK(sphereBody.GetVelocity().Length() < 0.05f);
+	CHECK(boxBody.GetVelocity().Length() < 0.05f);
+	CHECK(boxBody.GetRotation().Length() < 0.05f);
+}
+
+TEST_CASE(RigidBodyWorld, StackRemainsStable) {
+	const UINT height = 6;
+	StackScene scene(1, 1, height);
+
+	for (UINT step = 0; step < 300; ++step) scene.Step();
+
+	for (UINT i = 0; i < height; ++i) {
+		const auto& body = scene.Bodies[i];
+		const auto& position = body.GetPosition();
+
+		// Each box may sink by the slop per contact below it, no more.
+		CHECK_NEAR(position.y, 0.5f + static_cast<float>(i), 0.02f * (i + 1));
+		CHECK(std::abs(position.x - scene.Bodies[0].GetPosition().x) < 0.02f);
+		CHECK(std::abs(position.z - scene.Bodies[0].GetPosition().z) < 0.02f);
+		CHECK(body.GetVelocity().Length() < 0.05f);
+
+		// Still upright: the body up axis has not tipped.
+		const auto up = Vector3::TransformNormal(Vector3::UnitY, body.GetTransform());
+		CHECK(up.y > 0.999f);
+	}
+}
+
+TEST_CASE(ContactResolver, IslandsFollowDynamicBodies) {
+	std::array<RigidBody, 7> bodies;
+	for (UINT i = 0; i < bodies.size(); ++i)
+		MakeSphereBody(bodies[i], { static_cast<float>(i), 0.f, 0.f }, 0.5f);
+
+	RigidBody ground;
+	MakeStaticBody(ground, { 0.f, -1.f, 0.f });
+
+	// 0-1-2 chained, 3-4 touching, 5 and 6 only resting on the shared
+	// static ground, which must not merge them.
+	const std::vector<Contact> contacts = {
+		MakeTouch(&bodies[0], &bodies[1]),
+		MakeTouch(&bodies[3], &bodies[4]),
+		MakeTouch(&bodies[5], &ground),
+		MakeTouch(&bodies[2], &bodies[1]),
+		MakeTouch(&ground, &bodies[6]),
+		MakeTouch(&bodies[0], &ground),
+	};
+
+	IslandResolver resolver;
+	resolver.ResolveContacts(contacts, TimeStep);
+
+	REQUIRE(resolver.IslandCount() == 4);
+
+	std::vector<std::set<RigidBody*>> islands;
+	for (UINT i = 0; i < resolver.IslandCount(); ++i) islands.push_back(resolver.IslandBodies(i));
+
+	const auto contains = [&](const std::set<RigidBody*>& expected) {
+		return std::find(islands.begin(), islands.end(), expected) != islands.end();
+	};
+	CHECK(contains({ &bodies[0], &bodies[1], &bodies[2] }));
+	CHECK(contains({ &bodies[3], &bodies[4] }));
+	CHECK(contains({ &bodies[5] }));
+	CHECK(contains({ &bodies[6] }));
+}
+
+BENCHMARK_CASE(RigidBodyWorld, StackingScene10k) {
+	// 50 x 50 columns of four boxes.
+	StackScene scene(50, 50, 4);
+	CHECK(scene.Bodies.size() == 10000);
+
+	// Let the contacts form before timing the steady state.
+	for (UINT step = 0; step < 10; ++step) scene.Step();
+
+	const double StepMs = UnitTest::MeasureMs(10, [&]() { scene.Step(); });
+
+	UnitTest::ReportTime(
+		std::format("RunPhysics, {} bodies, {} contacts", scene.Bodies.size(), scene.World.Contacts().size()).c_str(),
+		StepMs);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "UnitTest.hpp"
+
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/AsyncComputeTracker.hpp"
+
+using namespace Render::DX::Foundation::Core;
+
+namespace {
+	const D3D12_RESOURCE_STATES Srv = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+	const D3D12_RESOURCE_STATES PixelSrv = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+	const D3D12_RESOURCE_STATES Uav = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+
+	// Resources of the frame the tests replay.
+	enum {
+		E_Input = 0,
+		E_Output,
+		E_Internal,
+		E_Untouched,
+		ResourceCount
+	};
+
+	// The async pass of RenderGraphTest: reads the input and writes the
+	// output. The internal resource is transitioned inside the pass.
+	void RecordAsyncPass(AsyncComputeTracker& tracker, BOOL transitionInternally) {
+		tracker.Use(E_Input, FALSE);
+		tracker.Use(E_Output, TRUE);
+		if (transitionInternally) tracker.Use(E_Internal, TRUE);
+		tracker.Fork();
+	}
+}
+
+TEST_CASE(AsyncComputeTracker, NothingInFlightNeverJoins) {
+	AsyncComputeTracker tracker;
+	tracker.Reset(ResourceCount);
+
+	CHECK(!tracker.InFlight());
+	// Uses recorded but not yet submitted do not hold back the direct queue.
+	tracker.Use(E_Input, TRUE);
+	CHECK(!tracker.NeedsJoin(E_Input, TRUE, Uav, Srv));
+}
+
+TEST_CASE(AsyncComputeTracker, OnlyReadsInTheCurrentStateOverlap) {
+	AsyncComputeTracker tracker;
+	tracker.Reset(ResourceCount);
+	RecordAsyncPass(tracker, FALSE);
+	REQUIRE(tracker.InFlight());
+
+	// Both queues read the input in the state it is in.
+	CHECK(!tracker.NeedsJoin(E_Input, FALSE, Srv, Srv));
+	// Reading it in another state takes a barrier on the direct queue.
+	CHECK(tracker.NeedsJoin(E_Input, FALSE, PixelSrv, Srv));
+	// So does writing it, in any state.
+	CHECK(tracker.NeedsJoin(E_Input, TRUE, Srv, Srv));
+
+	// Whatever the compute work writes is off limits until it is done.
+	CHECK(tracker.NeedsJoin(E_Output, FALSE, Uav, Uav));
+	CHECK(tracker.NeedsJoin(E_Output, TRUE, Uav, Uav));
+
+	// Resources the pass does not touch go ahead.
+	CHECK(!tracker.NeedsJoin(E_Internal, TRUE, Uav, Srv));
+	CHECK(!tracker.NeedsJoin(E_Untouched, FALSE, PixelSrv, Srv));
+}
+
+TEST_CASE(AsyncComputeTracker, UndeclaredTransitionCountsAsWrite) {
+	AsyncComputeTracker tracker;
+	tracker.Reset(ResourceCount);
+	RecordAsyncPass(tracker, TRUE);
+
+	// Even a read in the state the pass left it in waits, since the
+	// transition may not have run yet.
+	CHECK(tracker.NeedsJoin(E_Internal, FALSE, Srv, Srv));
+
+	tracker.Join();
+	CHECK(!tracker.InFlight());
+	for (UINT r = 0; r < ResourceCount; ++r)
+		CHECK(!tracker.NeedsJoin(r, TRUE, Uav, Srv));
+}
+
+TEST_CASE(AsyncComputeTracker, WritesOutrankReads) {
+	AsyncComputeTracker tracker;
+	tracker.Reset(ResourceCount);
+
+	// Read after write within the compute work stays a write.
+	tracker.Use(E_Input, TRUE);
+	tracker.Use(E_Input, FALSE);
+	// Write after read becomes one.
+	tracker.Use(E_Output, FALSE);
+	tracker.Use(E_Output, TRUE);
+	tracker.Fork();
+
+	CHECK(tracker.NeedsJoin(E_Input, FALSE, Srv, Srv));
+	CHECK(tracker.NeedsJoin(E_Output, FALSE, Srv, Srv));
+}
+
+TEST_CASE(AsyncComputeTracker, ForksAccumulateUntilJoined) {
+	AsyncComputeTracker tracker;
+	tracker.Reset(ResourceCount);
+
+	tracker.Use(E_Input, FALSE);
+	tracker.Fork();
+	tracker.Use(E_Output, TRUE);
+	tracker.Fork();
+
+	// The first fork's read is still tracked after the second.
+	CHECK(tracker.NeedsJoin(E_Input, FALSE, PixelSrv, Srv));
+	CHECK(tracker.NeedsJoin(E_Output, FALSE, Srv, Srv));
+
+	// A new frame starts clean.
+	tracker.Reset(ResourceCount);
+	CHECK(!tracker.InFlight());
+	CHECK(!tracker.NeedsJoin(E_Output, TRUE, Uav, Uav));
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "UnitTest.hpp"
+
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/CommandObject.hpp"
+#include "Render/DX/Foundation/Core/Device.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace Render::DX::Foundation::Core;
+using namespace Microsoft::WRL;
+
+namespace {
+	// One allocator per worker, as a frame resource holds them.
+	BOOL CreateAllocators(Device* const pDevice, UINT count, std::vector<ComPtr<ID3D12CommandAllocator>>& allocs) {
+		allocs.resize(count);
+		for (auto& alloc : allocs) {
+			if (!pDevice->CreateCommandAllocator(alloc)) return FALSE;
+		}
+
+		return TRUE;
+	}
+
+	std::vector<ID3D12CommandAllocator*> RawPointers(const std::vector<ComPtr<ID3D12CommandAllocator>>& allocs) {
+		std::vector<ID3D12CommandAllocator*> raw{};
+		for (const auto& alloc : allocs)
+			raw.push_back(alloc.Get());
+
+		return raw;
+	}
+
+	BOOL Submit(CommandObject* const pCmdObject, UINT count) {
+		return pCmdObject->ExecuteCommandLists(count) && pCmdObject->FlushCommandQueue();
+	}
+}
+
+TEST_CASE(CommandObject, RecordsEachListOnItsOwnWorker) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	const auto cmdObject = UnitTest::D3D12CommandObject();
+	const UINT Count = cmdObject->ThreadCount();
+	REQUIRE(Count > 1);
+
+	std::vector<ComPtr<ID3D12CommandAllocator>> allocs{};
+	REQUIRE(CreateAllocators(device, Count, allocs));
+	const auto RawAllocs = RawPointers(allocs);
+
+	std::mutex mutex{};
+	std::vector<UINT> workers{};
+	std::vector<std::thread::id> threads(Count);
+	std::vector<ID3D12GraphicsCommandList6*> lists(Count);
+
+	REQUIRE(cmdObject->RecordCommandLists(RawAllocs.data(), Count, nullptr,
+		[&](ID3D12GraphicsCommandList6* const pCmdList, UINT worker) -> BOOL {
+			std::lock_guard<std::mutex> lock(mutex);
+
+			workers.push_back(worker);
+			threads[worker] = std::this_thread::get_id();
+			lists[worker] = pCmdList;
+
+			return TRUE;
+		}));
+
+	std::sort(workers.begin(), workers.end());
+	REQUIRE(workers.size() == Count);
+	for (UINT i = 0; i < Count; ++i) {
+		CHECK(workers[i] == i);
+		CHECK(lists[i] == cmdObject->CommandList(i));
+	}
+
+	// Worker 0 is the calling thread; every other worker has a thread of its own.
+	CHECK(threads[0] == std::this_thread::get_id());
+	std::sort(threads.begin(), threads.end());
+	CHECK(std::adjacent_find(threads.begin(), threads.end()) == threads.end());
+
+	CHECK(cmdObject->LastRecordStats().WorkerCount == Count);
+	CHECK(Submit(cmdObject, Count));
+}
+
+TEST_CASE(CommandObject, ClampsWorkerCountToThreads) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	const auto cmdObject = UnitTest::D3D12CommandObject();
+	const UINT ThreadCount = cmdObject->ThreadCount();
+
+	std::vector<ComPtr<ID3D12CommandAllocator>> allocs{};
+	REQUIRE(CreateAllocators(device, ThreadCount, allocs));
+	const auto RawAllocs = RawPointers(allocs);
+
+	std::atomic<UINT> calls = 0;
+	const auto Count = [&](ID3D12GraphicsCommandList6* const, UINT) -> BOOL {
+		++calls;
+		return TRUE;
+	};
+
+	REQUIRE(cmdObject->RecordCommandLists(RawAllocs.data(), ThreadCount * 4, nullptr, Count));
+	CHECK(calls == ThreadCount);
+	CHECK(cmdObject->LastRecordStats().WorkerCount == ThreadCount);
+	CHECK(Submit(cmdObject, ThreadCount));
+
+	// No work still records list 0, which carries the pending barriers.
+	calls = 0;
+	REQUIRE(cmdObject->RecordCommandLists(RawAllocs.data(), 0, nullptr, Count));
+	CHECK(calls == 1);
+	CHECK(cmdObject->LastRecordStats().WorkerCount == 1);
+	CHECK(Submit(cmdObject, 1));
+}
+
+TEST_CASE(CommandObject, WaitsForEveryWorkerWhenOneFails) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	const auto cmdObject = UnitTest::D3D12CommandObject();
+	const UINT Count = cmdObject->ThreadCount();
+	REQUIRE(Count > 1);
+
+	std::vector<ComPtr<ID3D12CommandAllocator>> allocs{};
+	REQUIRE(CreateAllocators(device, Count, allocs));
+	const auto RawAllocs = RawPointers(allocs);
+
+	std::atomic<UINT> finished = 0;
+	CHECK(!cmdObject->RecordCommandLists(RawAllocs.data(), Count, nullptr,
+		[&](ID3D12GraphicsCommandList6* const, UINT worker) -> BOOL {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			++finished;
+			return worker != 1;
+		}));
+	CHECK(finished == Count);
+
+	// The lists are left open either way, so they can still be closed.
+	CHECK(Submit(cmdObject, Count));
+}
+
+TEST_CASE(CommandObject, ReportsRecordingTimes) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	const auto cmdObject = UnitTest::D3D12CommandObject();
+	const UINT Count = cmdObject->ThreadCount();
+	REQUIRE(Count > 1);
+
+	std::vector<ComPtr<ID3D12CommandAllocator>> allocs{};
+	REQUIRE(CreateAllocators(device, Count, allocs));
+	const auto RawAllocs = RawPointers(allocs);
+
+	const FLOAT SleepMs = 20.f;
+	REQUIRE(cmdObject->RecordCommandLists(RawAllocs.data(), Count, nullptr,
+		[&](ID3D12GraphicsCommandList6* const, UINT) -> BOOL {
+			std::this_thread::sleep_for(std::chrono::duration<FLOAT, std::milli>(SleepMs));
+			return TRUE;
+		}));
+
+	// Sleeps overlap, so the busy time adds up while the wall time does not.
+	const auto& stats = cmdObject->LastRecordStats();
+	CHECK(stats.BusyTime >= SleepMs * Count * 0.9f);
+	CHECK(stats.WallTime >= SleepMs * 0.9f);
+	CHECK(stats.WallTime < stats.BusyTime);
+
+	CHECK(Submit(cmdObject, Count));
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "UnitTest.hpp"
+
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/PipelineStateCache.hpp"
+#include "Render/DX/Foundation/Core/Device.hpp"
+
+#include <functional>
+#include <set>
+
+using namespace Render::DX::Foundation::Core;
+using namespace Microsoft::WRL;
+
+namespace {
+	const D3D12_INPUT_ELEMENT_DESC InputElements[] = {
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+	};
+
+	// Each description gets its own copy of the bytecode, so equal keys
+	// come from equal contents and not from shared pointers.
+	struct GraphicsDesc {
+		std::vector<BYTE> VS{ 0x44, 0x58, 0x42, 0x43, 0x01, 0x02 };
+		std::vector<BYTE> PS{ 0x44, 0x58, 0x42, 0x43, 0x03, 0x04 };
+		std::vector<D3D12_INPUT_ELEMENT_DESC> Elements{ std::begin(InputElements), std::end(InputElements) };
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC Desc{};
+
+		GraphicsDesc() {
+			Desc.InputLayout = { Elements.data(), static_cast<UINT>(Elements.size()) };
+			Desc.VS = { VS.data(), VS.size() };
+			Desc.PS = { PS.data(), PS.size() };
+			Desc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+			Desc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
+			Desc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+			Desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+			Desc.SampleMask = UINT_MAX;
+			Desc.SampleDesc.Count = 1;
+			Desc.NumRenderTargets = 1;
+			Desc.RTVFormats[0] = DXGI_FORMAT_R16G16B16A16_FLOAT;
+			Desc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
+		}
+
+		GraphicsDesc(const GraphicsDesc&) = delete;
+		GraphicsDesc& operator=(const GraphicsDesc&) = delete;
+	};
+
+	struct ComputeDesc {
+		std::vector<BYTE> CS{ 0x44, 0x58, 0x42, 0x43, 0x05, 0x06 };
+		D3D12_COMPUTE_PIPELINE_STATE_DESC Desc{};
+
+		ComputeDesc() { Desc.CS = { CS.data(), CS.size() }; }
+
+		ComputeDesc(const ComputeDesc&) = delete;
+		ComputeDesc& operator=(const ComputeDesc&) = delete;
+	};
+
+	BOOL CreateRootSignature(Device* const pDevice, UINT numConstants, ComPtr<ID3D12RootSignature>& rootSig) {
+		CD3DX12_ROOT_PARAMETER params[1]{};
+		params[0].InitAsConstants(numConstants, 0);
+
+		const CD3DX12_ROOT_SIGNATURE_DESC Desc(_countof(params), params);
+
+		return pDevice->CreateRootSignature(Desc, IID_PPV_ARGS(&rootSig), L"PipelineStateCacheTest");
+	}
+}
+
+TEST_CASE(PipelineStateCache, IdenticalDescsShareKey) {
+	GraphicsDesc graphicsA, graphicsB;
+	CHECK(PipelineStateCache::PipelineKey(graphicsA.Desc, L"Opaque") == PipelineStateCache::PipelineKey(graphicsB.Desc, L"Opaque"));
+
+	ComputeDesc computeA, computeB;
+	CHECK(PipelineStateCache::PipelineKey(computeA.Desc, L"Blur") == PipelineStateCache::PipelineKey(computeB.Desc, L"Blur"));
+
+	// The key is a pure function of the description.
+	CHECK(PipelineStateCache::PipelineKey(graphicsA.Desc, L"Opaque") == PipelineStateCache::PipelineKey(graphicsA.Desc, L"Opaque"));
+}
+
+TEST_CASE(PipelineStateCache, DescChangesChangeKey) {
+	const std::vector<std::function<void(GraphicsDesc&)>> Changes = {
+		[](GraphicsDesc& d) { d.VS.back() ^= 0xff; },
+		[](GraphicsDesc& d) { d.PS.push_back(0x00); d.Desc.PS = { d.PS.data(), d.PS.size() }; },
+		[](GraphicsDesc& d) { d.Desc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE; },
+		[](GraphicsDesc& d) { d.Desc.RasterizerState.DepthBias = 1; },
+		[](GraphicsDesc& d) { d.Desc.BlendState.RenderTarget[0].BlendEnable = TRUE; },
+		[](GraphicsDesc& d) { d.Desc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_GREATER; },
+		[](GraphicsDesc& d) { d.Desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM; },
+		[](GraphicsDesc& d) { d.Desc.NumRenderTargets = 2; d.Desc.RTVFormats[1] = DXGI_FORMAT_R8G8B8A8_UNORM; },
+		[](GraphicsDesc& d) { d.Desc.DSVFormat = DXGI_FORMAT_D32_FLOAT; },
+		[](GraphicsDesc& d) { d.Desc.SampleDesc.Count = 4; },
+		[](GraphicsDesc& d) { d.Desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE; },
+		[](GraphicsDesc& d) { d.Elements[1].SemanticName = "TEXCOORD"; },
+		[](GraphicsDesc& d) { d.Elements[1].AlignedByteOffset = 16; },
+		[](GraphicsDesc& d) { d.Desc.InputLayout.NumElements = 1; },
+		[](GraphicsDesc& d) { d.Desc.pRootSignature = reinterpret_cast<ID3D12RootSignature*>(&d); },
+	};
+
+	GraphicsDesc base;
+	const auto BaseKey = PipelineStateCache::PipelineKey(base.Desc, L"Opaque");
+
+	std::set<std::wstring> keys{ BaseKey };
+	for (const auto& change : Changes) {
+		GraphicsDesc changed;
+		change(changed);
+
+		const auto Key = PipelineStateCache::PipelineKey(changed.Desc, L"Opaque");
+		CHECK(Key != BaseKey);
+		keys.insert(Key);
+	}
+	// No two changes collide with each other either.
+	CHECK(keys.size() == Changes.size() + 1);
+
+	CHECK(PipelineStateCache::PipelineKey(base.Desc, L"Transparent") != BaseKey);
+
+	ComputeDesc compute, changedCompute;
+	changedCompute.CS[0] ^= 0xff;
+	CHECK(PipelineStateCache::PipelineKey(compute.Desc, L"Blur") != PipelineStateCache::PipelineKey(changedCompute.Desc, L"Blur"));
+}
+
+TEST_CASE(PipelineStateCache, RootSignatureKeyedByBlob) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	ComPtr<ID3D12RootSignature> rootSigA{}, rootSigB{}, rootSigOther{};
+	REQUIRE(CreateRootSignature(device, 4, rootSigA));
+	REQUIRE(CreateRootSignature(device, 4, rootSigB));
+	REQUIRE(CreateRootSignature(device, 8, rootSigOther));
+
+	// Separate objects from the same blob share a key, as the root
+	// signatures of two runs do.
+	ComputeDesc a, b, other;
+	a.Desc.pRootSignature = rootSigA.Get();
+	b.Desc.pRootSignature = rootSigB.Get();
+	other.Desc.pRootSignature = rootSigOther.Get();
+
+	CHECK(PipelineStateCache::PipelineKey(a.Desc, L"Blur") == PipelineStateCache::PipelineKey(b.Desc, L"Blur"));
+	CHECK(PipelineStateCache::PipelineKey(a.Desc, L"Blur") != PipelineStateCache::PipelineKey(other.Desc, L"Blur"));
+
+	GraphicsDesc graphicsA, graphicsOther;
+	graphicsA.Desc.pRootSignature = rootSigA.Get();
+	graphicsOther.Desc.pRootSignature = rootSigOther.Get();
+	CHECK(PipelineStateCache::PipelineKey(graphicsA.Desc, L"Opaque") != PipelineStateCache::PipelineKey(graphicsOther.Desc, L"Opaque"));
+}
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "UnitTest.hpp"
+
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Core/RenderGraph.hpp"
+#include "Render/DX/Foundation/Core/CommandObject.hpp"
+#include "Render/DX/Foundation/Resource/GpuResource.hpp"
+
+using namespace Render::DX::Foundation::Core;
+using namespace Render::DX::Foundation::Resource;
+
+namespace {
+	BOOL Nop() { return TRUE; }
+
+	D3D12_RESOURCE_DESC RenderTargetDesc(UINT size) {
+		return CD3DX12_RESOURCE_DESC::Tex2D(
+			DXGI_FORMAT_R8G8B8A8_UNORM, size, size, 1, 1, 1, 0, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+	}
+
+	D3D12_RESOURCE_DESC UavBufferDesc() {
+		return CD3DX12_RESOURCE_DESC::Buffer(1024, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	}
+
+	BOOL CreateUavBuffer(Device* const pDevice, GpuResource& buffer) {
+		const CD3DX12_HEAP_PROPERTIES HeapProp(D3D12_HEAP_TYPE_DEFAULT);
+		const auto Desc = UavBufferDesc();
+
+		return buffer.Initialize(
+			pDevice,
+			&HeapProp,
+			D3D12_HEAP_FLAG_NONE,
+			&Desc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			L"RenderGraphTest_Buffer");
+	}
+}
+
+// Only declarations; culling touches no D3D12 object.
+TEST_CASE(RenderGraph, CullsPassesThatReachNoOutput) {
+	RenderGraph graph;
+	REQUIRE(graph.Initialize(UnitTest::Log(), nullptr, nullptr));
+
+	GpuResource gbuffer, shadow, lit, debug, debugOverlay, capture, backBuffer;
+
+	graph.AddPass(L"GBuffer", Nop).Write(&gbuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	graph.AddPass(L"Shadow", Nop).Write(&shadow, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+	graph.AddPass(L"Lighting", Nop)
+		.Read(&gbuffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		.Read(&shadow, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		.Write(&lit, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	// Nothing consumes the debug chain.
+	graph.AddPass(L"Debug", Nop)
+		.Read(&gbuffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		.Write(&debug, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	graph.AddPass(L"DebugOverlay", Nop)
+		.Read(&debug, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		.Write(&debugOverlay, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	// Writes nothing anyone reads, but is kept on request.
+	graph.AddPass(L"Capture", Nop)
+		.Read(&lit, D3D12_RESOURCE_STATE_COPY_SOURCE)
+		.Write(&capture, D3D12_RESOURCE_STATE_COPY_DEST)
+		.SideEffect();
+	graph.AddPass(L"Present", Nop)
+		.Read(&lit, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		.Write(&backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	// Only reads, so it contributes to nothing.
+	graph.AddPass(L"Inspect", Nop).Read(&backBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+	graph.MarkOutput(&backBuffer);
+	REQUIRE(graph.Compile());
+
+	const auto& stats = graph.FrameStats();
+	CHECK(stats.PassCount == 8);
+	CHECK(stats.CulledPassCount == 3);
+	CHECK(stats.AsyncPassCount == 0);
+	CHECK(stats.TransientCount == 0);
+
+	// Declarations start over every frame.
+	graph.Reset();
+	graph.AddPass(L"Capture", Nop).Write(&capture, D3D12_RESOURCE_STATE_COPY_DEST).SideEffect();
+	REQUIRE(graph.Compile());
+
+	CHECK(graph.FrameStats().PassCount == 1);
+	CHECK(graph.FrameStats().CulledPassCount == 0);
+}
+
+TEST_CASE(RenderGraph, AliasesTransientsWithDisjointLifetimes) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	GpuResource transients[3], unused, output;
+
+	RenderGraph graph;
+	REQUIRE(graph.Initialize(UnitTest::Log(), device, UnitTest::D3D12CommandObject()));
+
+	const auto Desc = RenderTargetDesc(256);
+
+	// T0 lives in passes 0-1, T1 in 1-2 and T2 in 2-3, so T0 and T2 can share memory.
+	graph.AddPass(L"Pass0", Nop)
+		.Transient(&transients[0], Desc, D3D12_RESOURCE_STATE_RENDER_TARGET, L"T0", nullptr);
+	graph.AddPass(L"Pass1", Nop)
+		.Read(&transients[0], D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		.Transient(&transients[1], Desc, D3D12_RESOURCE_STATE_RENDER_TARGET, L"T1", nullptr);
+	graph.AddPass(L"Pass2", Nop)
+		.Read(&transients[1], D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		.Transient(&transients[2], Desc, D3D12_RESOURCE_STATE_RENDER_TARGET, L"T2", nullptr);
+	graph.AddPass(L"Pass3", Nop)
+		.Read(&transients[2], D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		.Write(&output, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	// Culled, so its transient takes no memory.
+	graph.AddPass(L"Unused", Nop)
+		.Read(&transients[1], D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		.Transient(&unused, Desc, D3D12_RESOURCE_STATE_RENDER_TARGET, L"Unused", nullptr);
+
+	graph.MarkOutput(&output);
+	REQUIRE(graph.Compile());
+
+	const auto& stats = graph.FrameStats();
+	CHECK(stats.CulledPassCount == 1);
+	CHECK(stats.TransientCount == 3);
+	REQUIRE(stats.TransientBytes > 0);
+	CHECK(stats.TransientBytes % 3 == 0);
+	CHECK(stats.HeapBytes == stats.TransientBytes / 3 * 2);
+}
+
+TEST_CASE(RenderGraph, RejectsTransientsOnAsyncCompute) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	GpuResource scratch, output;
+
+	RenderGraph graph;
+	REQUIRE(graph.Initialize(UnitTest::Log(), device, UnitTest::D3D12CommandObject()));
+
+	graph.AddPass(L"AsyncPass", Nop)
+		.AsyncCompute()
+		.Transient(&scratch, UavBufferDesc(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, L"Scratch", nullptr)
+		.Write(&output, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	graph.MarkOutput(&output);
+	CHECK(!graph.Compile());
+}
+
+TEST_CASE(RenderGraph, JoinsAsyncComputeBeforeTouchingItsWork) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	GpuResource input, output, internal;
+	REQUIRE(CreateUavBuffer(device, input));
+	REQUIRE(CreateUavBuffer(device, output));
+	REQUIRE(CreateUavBuffer(device, internal));
+
+	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> directAlloc, computeAlloc;
+	REQUIRE(device->CreateCommandAllocator(directAlloc));
+	REQUIRE(device->CreateCommandAllocator(computeAlloc, D3D12_COMMAND_LIST_TYPE_COMPUTE));
+
+	const auto cmdObject = UnitTest::D3D12CommandObject();
+
+	RenderGraph graph;
+	REQUIRE(graph.Initialize(UnitTest::Log(), device, cmdObject));
+
+	UINT joinsBeforeInternal = 0;
+	const auto Frame = [&](BOOL transitionInternally) {
+		graph.Reset();
+		graph.AddPass(L"Produce", Nop)
+			.Write(&input, D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+			.Write(&internal, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		// Transitions a resource it does not declare, as shading objects do.
+		graph.AddPass(L"Async", [&, transitionInternally]() {
+			if (!transitionInternally) return TRUE;
+
+			if (!cmdObject->ResetCommandList(nullptr, 0)) return FALSE;
+			internal.Transite(cmdObject->CommandList(0), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+			return cmdObject->ExecuteCommandList(0);
+		})
+			.AsyncCompute()
+			.Read(&input, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.Write(&output, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		graph.AddPass(L"ReadInternal", [&]() {
+			joinsBeforeInternal = graph.FrameStats().JoinCount;
+			return TRUE;
+		})
+			.Read(&internal, D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+			.SideEffect();
+		// Same state as the async pass reads it in, so no barrier is needed.
+		graph.AddPass(L"SameRead", Nop)
+			.Read(&input, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+			.SideEffect();
+		graph.AddPass(L"OtherRead", Nop)
+			.Read(&input, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+			.SideEffect();
+
+		graph.MarkOutput(&output);
+		return graph.Compile()
+			&& graph.Execute(directAlloc.Get(), computeAlloc.Get())
+			&& UnitTest::D3D12Submit();
+	};
+
+	// Only the read that needs a barrier waits.
+	REQUIRE(Frame(FALSE));
+	CHECK(graph.FrameStats().AsyncPassCount == 1);
+	CHECK(graph.FrameStats().JoinCount == 1);
+	CHECK(joinsBeforeInternal == 0);
+
+	// A resource the pass left in another state counts as written by it, so
+	// the first pass using it waits, and the later reads go ahead.
+	REQUIRE(Frame(TRUE));
+	CHECK(graph.FrameStats().JoinCount == 1);
+	CHECK(joinsBeforeInternal == 1);
+	CHECK(internal.State() == D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+}
+
+TEST_CASE(RenderGraph, QueuesOneBarrierPerStateChange) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	GpuResource buffer;
+	REQUIRE(CreateUavBuffer(device, buffer));
+
+	RenderGraph graph;
+	REQUIRE(graph.Initialize(UnitTest::Log(), device, UnitTest::D3D12CommandObject()));
+
+	std::vector<std::wstring> executed{};
+	const auto Record = [&](LPCWSTR name) {
+		return [&executed, name]() { executed.push_back(name); return TRUE; };
+	};
+
+	graph.AddPass(L"Clear", Record(L"Clear")).Write(&buffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	graph.AddPass(L"Sample0", Record(L"Sample0"))
+		.Read(&buffer, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+		.SideEffect();
+	graph.AddPass(L"Sample1", Record(L"Sample1"))
+		.Read(&buffer, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+		.SideEffect();
+	graph.AddPass(L"Accumulate", Record(L"Accumulate")).Write(&buffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	graph.MarkOutput(&buffer);
+	REQUIRE(graph.Compile());
+	REQUIRE(graph.Execute(nullptr, nullptr));
+
+	// Common to UAV, UAV to SRV and back; the second read needs none.
+	CHECK(graph.FrameStats().BarrierCount == 3);
+	CHECK(buffer.State() == D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	CHECK((executed == std::vector<std::wstring>{ L"Clear", L"Sample0", L"Sample1", L"Accumulate" }));
+
+	CHECK(UnitTest::D3D12Submit());
+}
+
+TEST_CASE(RenderGraph, KeepsPlacementWhileTransientsDoNotChange) {
+	const auto device = UnitTest::D3D12Device();
+	if (device == nullptr) return;
+
+	GpuResource transient;
+
+	RenderGraph graph;
+	REQUIRE(graph.Initialize(UnitTest::Log(), device, UnitTest::D3D12CommandObject()));
+
+	UINT realizeCount = 0;
+	const auto Frame = [&](UINT size) {
+		graph.Reset();
+		graph.AddPass(L"Draw", Nop)
+			.Transient(&transient, RenderTargetDesc(size), D3D12_RESOURCE_STATE_RENDER_TARGET, L"Transient",
+				[&realizeCount]() { ++realizeCount; return TRUE; })
+			.SideEffect();
+
+		return graph.Compile() && graph.Execute(nullptr, nullptr) && UnitTest::D3D12Submit();
+	};
+
+	REQUIRE(Frame(128));
+	CHECK(realizeCount == 1);
+	const auto Placed = transient.Resource();
+	REQUIRE(Placed != nullptr);
+
+	REQUIRE(Frame(128));
+	CHECK(realizeCount == 1);
+	CHECK(transient.Resource() == Placed);
+
+	REQUIRE(Frame(256));
+	CHECK(realizeCount == 2);
+	CHECK(transient.Resource()->GetDesc().Width == 256);
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "UnitTest.hpp"
+
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Foundation/Util/TextureCooker.hpp"
+
+#include <functional>
+
+using namespace Render::DX::Foundation::Util;
+using namespace DirectX;
+
+namespace {
+	const UINT ImageSize = 64;
+	// 64, 32, ..., 1.
+	const UINT FullMipCount = 7;
+
+	using Texel = std::function<XMFLOAT4(FLOAT, FLOAT)>;
+
+	BOOL Initialize() {
+		// WIC needs COM on the calling thread.
+		static const BOOL initialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED))
+			&& TextureCooker::Initialize(UnitTest::Log());
+		return initialized;
+	}
+
+	std::filesystem::path ScratchDir(const char* name) {
+		const auto dir = std::filesystem::temp_directory_path() / L"TextureCookerTest" / name;
+
+		std::error_code ec{};
+		std::filesystem::remove_all(dir, ec);
+		std::filesystem::create_directories(dir, ec);
+
+		return dir;
+	}
+
+	// Smooth content, which every block format is expected to keep above
+	// the PSNR floor. Texel coordinates are in [0, 1].
+	BOOL MakeImage(UINT width, UINT height, DXGI_FORMAT format, const Texel& texel, ScratchImage& image) {
+		ScratchImage source{};
+		if (FAILED(source.Initialize2D(DXGI_FORMAT_R32G32B32A32_FLOAT, width, height, 1, 1))) return FALSE;
+
+		const Image& Top = *source.GetImage(0, 0, 0);
+		for (UINT y = 0; y < height; ++y) {
+			auto row = reinterpret_cast<XMFLOAT4*>(Top.pixels + y * Top.rowPitch);
+			for (UINT x = 0; x < width; ++x)
+				row[x] = texel((x + 0.5f) / width, (y + 0.5f) / height);
+		}
+
+		if (format == DXGI_FORMAT_R32G32B32A32_FLOAT) {
+			image = std::move(source);
+			return TRUE;
+		}
+
+		return SUCCEEDED(Convert(Top, format, TEX_FILTER_DEFAULT, TEX_THRESHOLD_DEFAULT, image));
+	}
+
+	XMFLOAT4 Opaque(FLOAT u, FLOAT v) {
+		return XMFLOAT4(u, v, 0.5f + 0.5f * sinf(6.f * u) * cosf(4.f * v), 1.f);
+	}
+
+	XMFLOAT4 Translucent(FLOAT u, FLOAT v) {
+		return XMFLOAT4(u, 1.f - v, 0.25f, 0.2f + 0.6f * u * v);
+	}
+
+	// Tangent-space normals of a gentle bump, encoded into [0, 1].
+	XMFLOAT4 Normal(FLOAT u, FLOAT v) {
+		const FLOAT nx = 0.4f * sinf(XM_2PI * u), ny = 0.4f * cosf(XM_2PI * v);
+		const FLOAT nz = sqrtf(1.f - nx * nx - ny * ny);
+		return XMFLOAT4(nx * 0.5f + 0.5f, ny * 0.5f + 0.5f, nz * 0.5f + 0.5f, 1.f);
+	}
+
+	XMFLOAT4 Mask(FLOAT u, FLOAT v) {
+		const FLOAT Value = 0.5f + 0.5f * sinf(5.f * u + 3.f * v);
+		return XMFLOAT4(Value, Value, Value, 1.f);
+	}
+
+	XMFLOAT4 Radiance(FLOAT u, FLOAT v) {
+		return XMFLOAT4(8.f * u, 2.f * v, 0.5f + u * v, 1.f);
+	}
+
+	struct CompressCase {
+		TextureUsage::Type Usage;
+		DXGI_FORMAT SourceFormat;
+		Texel Content;
+		DXGI_FORMAT Expected;
+	};
+}
+
+TEST_CASE(TextureCooker, CompressesByUsage) {
+	REQUIRE(Initialize());
+
+	const CompressCase Cases[] = {
+		{ TextureUsage::E_Color, DXGI_FORMAT_R8G8B8A8_UNORM, Opaque, DXGI_FORMAT_BC1_UNORM },
+		{ TextureUsage::E_Color, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, Opaque, DXGI_FORMAT_BC1_UNORM_SRGB },
+		{ TextureUsage::E_Color, DXGI_FORMAT_R8G8B8A8_UNORM, Translucent, DXGI_FORMAT_BC7_UNORM },
+		{ TextureUsage::E_Normal, DXGI_FORMAT_R8G8B8A8_UNORM, Normal, DXGI_FORMAT_BC5_UNORM },
+		{ TextureUsage::E_Mask, DXGI_FORMAT_R8G8B8A8_UNORM, Mask, DXGI_FORMAT_BC4_UNORM },
+		{ TextureUsage::E_HDR, DXGI_FORMAT_R16G16B16A16_FLOAT, Radiance, DXGI_FORMAT_BC6H_UF16 } };
+
+	for (const auto& test : Cases) {
+		ScratchImage source{};
+		REQUIRE(MakeImage(ImageSize, ImageSize, test.SourceFormat, test.Content, source));
+
+		ScratchImage cooked{};
+		REQUIRE(SUCCEEDED(cooked.InitializeFromImage(*source.GetImage(0, 0, 0))));
+		REQUIRE(TextureCooker::Compress(cooked, test.Usage));
+
+		const auto& Metadata = cooked.GetMetadata();
+		CHECK(Metadata.format == test.Expected);
+		CHECK(Metadata.mipLevels == FullMipCount);
+		CHECK(Metadata.width == ImageSize && Metadata.height == ImageSize);
+
+		if (test.Usage == TextureUsage::E_HDR) continue;
+
+		FLOAT psnr = 0.f;
+		REQUIRE(TextureCooker::ComputePSNR(*source.GetImage(0, 0, 0), *cooked.GetImage(0, 0, 0), test.Usage, psnr));
+		CHECK(psnr >= 30.f);
+	}
+}
+
+TEST_CASE(TextureCooker, CookedFileRoundTrips) {
+	REQUIRE(Initialize());
+
+	const auto dir = ScratchDir("RoundTrip");
+	const auto SrcPath = dir / L"Albedo.png";
+
+	ScratchImage source{};
+	REQUIRE(MakeImage(ImageSize, ImageSize, DXGI_FORMAT_R8G8B8A8_UNORM, Opaque, source));
+	REQUIRE(SUCCEEDED(SaveToWICFile(*source.GetImage(0, 0, 0), WIC_FLAGS_NONE, GetWICCodec(WIC_CODEC_PNG), SrcPath.c_str())));
+
+	std::wstring cookedPath{};
+	REQUIRE(TextureCooker::CookTexture(SrcPath.c_str(), TextureUsage::E_Color, cookedPath));
+	CHECK(cookedPath == (dir / L"Albedo.bc.dds").wstring());
+	REQUIRE(std::filesystem::exists(cookedPath));
+
+	// What the renderer uploads: a full BC1 chain matching the source.
+	TexMetadata metadata{};
+	ScratchImage cooked{};
+	REQUIRE(SUCCEEDED(LoadFromDDSFile(cookedPath.c_str(), DDS_FLAGS_NONE, &metadata, cooked)));
+	CHECK(MakeTypeless(metadata.format) == DXGI_FORMAT_BC1_TYPELESS);
+	CHECK(metadata.mipLevels == FullMipCount);
+	CHECK(metadata.width == ImageSize && metadata.height == ImageSize);
+
+	FLOAT psnr = 0.f;
+	REQUIRE(TextureCooker::ComputePSNR(*source.GetImage(0, 0, 0), *cooked.GetImage(0, 0, 0), TextureUsage::E_Color, psnr));
+	CHECK(psnr >= 30.f);
+
+	// Reused while the source is older, cooked again once it is newer.
+	const auto CookedTime = std::filesystem::last_write_time(cookedPath);
+	REQUIRE(TextureCooker::CookTexture(SrcPath.c_str(), TextureUsage::E_Color, cookedPath));
+	CHECK(std::filesystem::last_write_time(cookedPath) == CookedTime);
+
+	std::filesystem::last_write_time(SrcPath, CookedTime + std::chrono::seconds(2));
+	REQUIRE(TextureCooker::CookTexture(SrcPath.c_str(), TextureUsage::E_Color, cookedPath));
+	CHECK(std::filesystem::last_write_time(cookedPath) != CookedTime);
+}
+
+TEST_CASE(TextureCooker, LeavesUncookableSourcesAlone) {
+	REQUIRE(Initialize());
+
+	const auto dir = ScratchDir("Uncookable");
+
+	// Not made of whole 4x4 blocks.
+	const auto OddPath = dir / L"Odd.png";
+	ScratchImage odd{};
+	REQUIRE(MakeImage(6, 10, DXGI_FORMAT_R8G8B8A8_UNORM, Opaque, odd));
+	REQUIRE(SUCCEEDED(SaveToWICFile(*odd.GetImage(0, 0, 0), WIC_FLAGS_NONE, GetWICCodec(WIC_CODEC_PNG), OddPath.c_str())));
+
+	std::wstring cookedPath{};
+	REQUIRE(TextureCooker::CookTexture(OddPath.c_str(), TextureUsage::E_Color, cookedPath));
+	CHECK(cookedPath == OddPath.wstring());
+	CHECK(!std::filesystem::exists(dir / L"Odd.bc.dds"));
+
+	// Already a DDS.
+	const auto DdsPath = dir / L"Cooked.dds";
+	ScratchImage dds{};
+	REQUIRE(MakeImage(ImageSize, ImageSize, DXGI_FORMAT_R8G8B8A8_UNORM, Opaque, dds));
+	REQUIRE(SUCCEEDED(SaveToDDSFile(*dds.GetImage(0, 0, 0), DDS_FLAGS_NONE, DdsPath.c_str())));
+
+	REQUIRE(TextureCooker::CookTexture(DdsPath.c_str(), TextureUsage::E_Color, cookedPath));
+	CHECK(cookedPath == DdsPath.wstring());
+}
\ No newline at end of file
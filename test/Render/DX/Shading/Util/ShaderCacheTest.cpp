@@ -0,0 +1,168 @@
+#include "UnitTest.hpp"
+
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Render/DX/Shading/Util/ShaderCache.hpp"
+
+using namespace Render::DX::Shading::Util;
+using namespace Microsoft::WRL;
+
+namespace {
+	// Each test works in its own directory under the system temp folder.
+	std::filesystem::path ScratchDir(const char* name) {
+		const auto dir = std::filesystem::temp_directory_path() / L"ShaderCacheTest" / name;
+
+		std::error_code ec{};
+		std::filesystem::remove_all(dir, ec);
+		std::filesystem::create_directories(dir, ec);
+
+		return dir;
+	}
+
+	// Rewrites the file and moves its timestamp forward, since two writes
+	// in quick succession can share one on coarse file systems.
+	void WriteSource(const std::filesystem::path& path, const std::string& text) {
+		const BOOL existed = std::filesystem::exists(path);
+		const auto before = existed ? std::filesystem::last_write_time(path) : std::filesystem::file_time_type{};
+
+		{
+			std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+			fout << text;
+		}
+
+		if (existed) std::filesystem::last_write_time(path, before + std::chrono::seconds(2));
+	}
+
+	ComPtr<IDxcBlob> MakeBlob(IDxcUtils* const pUtils, const std::string& bytes) {
+		ComPtr<IDxcBlobEncoding> encoding{};
+		pUtils->CreateBlob(bytes.data(), static_cast<UINT32>(bytes.size()), 0, &encoding);
+
+		ComPtr<IDxcBlob> blob{};
+		encoding.As(&blob);
+		return blob;
+	}
+
+	std::string BlobBytes(IDxcBlob* const pBlob) {
+		return std::string(static_cast<const CHAR*>(pBlob->GetBufferPointer()), pBlob->GetBufferSize());
+	}
+}
+
+TEST_CASE(ShaderCache, HashSourceFollowsIncludes) {
+	const auto dir = ScratchDir("Includes");
+
+	// Include names are unique so they never resolve against the working directory.
+	WriteSource(dir / L"ShaderCacheTest_Main.hlsl", "#include \"ShaderCacheTest_A.hlsli\"\nfloat4 main() : SV_Target { return A(); }\n");
+	WriteSource(dir / L"ShaderCacheTest_A.hlsli", "  #include \"ShaderCacheTest_B.hlsli\"\nfloat4 A() { return B(); }\n");
+	WriteSource(dir / L"ShaderCacheTest_B.hlsli", "float4 B() { return 0; }\n");
+	WriteSource(dir / L"ShaderCacheTest_Unused.hlsli", "float4 C() { return 1; }\n");
+
+	ShaderCache cache;
+	REQUIRE(cache.Initialize(UnitTest::Log(), (dir / L"Cache").c_str(), 1));
+
+	Common::Foundation::Hash original{};
+	std::vector<ShaderCache::Dependency> deps{};
+	REQUIRE(cache.HashSource(0, dir / L"ShaderCacheTest_Main.hlsl", original, deps));
+
+	// The shader and both transitive includes, each once.
+	CHECK(deps.size() == 3);
+
+	Common::Foundation::Hash hash{};
+	deps.clear();
+	REQUIRE(cache.HashSource(0, dir / L"ShaderCacheTest_Main.hlsl", hash, deps));
+	CHECK(hash == original);
+
+	// Editing a file that is not included leaves the key alone.
+	WriteSource(dir / L"ShaderCacheTest_Unused.hlsli", "float4 C() { return 2; }\n");
+	deps.clear();
+	REQUIRE(cache.HashSource(0, dir / L"ShaderCacheTest_Main.hlsl", hash, deps));
+	CHECK(hash == original);
+
+	// Editing the nested include changes it.
+	WriteSource(dir / L"ShaderCacheTest_B.hlsli", "float4 B() { return 0.5; }\n");
+	deps.clear();
+	REQUIRE(cache.HashSource(0, dir / L"ShaderCacheTest_Main.hlsl", hash, deps));
+	CHECK(hash != original);
+
+	cache.CleanUp();
+}
+
+TEST_CASE(ShaderCache, HashSourceVisitsSharedIncludesOnce) {
+	const auto dir = ScratchDir("Diamond");
+
+	WriteSource(dir / L"ShaderCacheTest_Top.hlsl", "#include \"ShaderCacheTest_Left.hlsli\"\n#include \"ShaderCacheTest_Right.hlsli\"\n");
+	WriteSource(dir / L"ShaderCacheTest_Left.hlsli", "#include \"ShaderCacheTest_Common.hlsli\"\n");
+	WriteSource(dir / L"ShaderCacheTest_Right.hlsli", "#include \"ShaderCacheTest_Common.hlsli\"\n");
+	WriteSource(dir / L"ShaderCacheTest_Common.hlsli", "#include \"ShaderCacheTest_Top.hlsl\"\n");
+
+	ShaderCache cache;
+	REQUIRE(cache.Initialize(UnitTest::Log(), (dir / L"Cache").c_str(), 1));
+
+	Common::Foundation::Hash hash{};
+	std::vector<ShaderCache::Dependency> deps{};
+	REQUIRE(cache.HashSource(0, dir / L"ShaderCacheTest_Top.hlsl", hash, deps));
+
+	// A diamond and a cycle back to the top still list every file once.
+	CHECK(deps.size() == 4);
+
+	cache.CleanUp();
+}
+
+TEST_CASE(ShaderCache, StoreThenLoadRoundTrips) {
+	const auto dir = ScratchDir("RoundTrip");
+
+	ComPtr<IDxcUtils> utils{};
+	REQUIRE(SUCCEEDED(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils))));
+
+	ShaderCache cache;
+	REQUIRE(cache.Initialize(UnitTest::Log(), (dir / L"Cache").c_str(), 1));
+
+	const std::string bytes("DXBC\0\x01\x02\x03 bytecode", 17);
+	const auto stored = MakeBlob(utils.Get(), bytes);
+	REQUIRE(stored);
+	REQUIRE(cache.Store(0x1234, stored.Get()));
+
+	ComPtr<IDxcBlob> loaded{};
+	REQUIRE(cache.Load(0x1234, utils.Get(), loaded));
+	REQUIRE(loaded);
+	CHECK(BlobBytes(loaded.Get()) == bytes);
+
+	REQUIRE(cache.Load(0x5678, utils.Get(), loaded));
+	CHECK(!loaded);
+
+	CHECK(cache.HitCount() == 1);
+	CHECK(cache.MissCount() == 1);
+
+	// A second cache over the same directory sees the entry, as on the next run.
+	ShaderCache reopened;
+	REQUIRE(reopened.Initialize(UnitTest::Log(), (dir / L"Cache").c_str(), 1));
+	REQUIRE(reopened.Load(0x1234, utils.Get(), loaded));
+	CHECK(loaded && BlobBytes(loaded.Get()) == bytes);
+
+	reopened.CleanUp();
+	cache.CleanUp();
+}
+
+TEST_CASE(ShaderCache, DamagedEntryIsAMiss) {
+	const auto dir = ScratchDir("Damaged");
+
+	ComPtr<IDxcUtils> utils{};
+	REQUIRE(SUCCEEDED(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils))));
+
+	ShaderCache cache;
+	REQUIRE(cache.Initialize(UnitTest::Log(), (dir / L"Cache").c_str(), 1));
+
+	const auto stored = MakeBlob(utils.Get(), std::string(64, 'x'));
+	REQUIRE(cache.Store(42, stored.Get()));
+
+	// Cut the only entry short, as if the process had died while writing it.
+	std::vector<std::filesystem::path> entries{};
+	for (const auto& entry : std::filesystem::directory_iterator(dir / L"Cache")) entries.push_back(entry.path());
+	REQUIRE(entries.size() == 1);
+	std::filesystem::resize_file(entries[0], std::filesystem::file_size(entries[0]) - 8);
+
+	ComPtr<IDxcBlob> loaded{};
+	REQUIRE(cache.Load(42, utils.Get(), loaded));
+	CHECK(!loaded);
+	CHECK(cache.MissCount() == 1);
+
+	cache.CleanUp();
+}
\ No newline at end of file
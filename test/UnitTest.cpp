@@ -0,0 +1,79 @@
+#include "UnitTest.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <intrin.h>
+
+#include "Common/Debug/Logger.hpp"
+
+namespace {
+	unsigned gFailureCount = 0;
+}
+
+std::vector<UnitTest::TestCase>& UnitTest::Registry() {
+	static std::vector<TestCase> registry;
+	return registry;
+}
+
+UnitTest::Registrar::Registrar(const char* suite, const char* name, TestFunc func, bool benchmark) {
+	Registry().push_back({ suite, name, func, benchmark });
+}
+
+void UnitTest::ReportFailure(const char* file, int line, const char* expr) {
+	std::printf("%s(%d): CHECK(%s) failed\n", file, line, expr);
+	++gFailureCount;
+}
+
+void UnitTest::ReportTime(const char* label, double milliseconds) {
+	std::printf("           %-48s %10.3f ms\n", label, milliseconds);
+}
+
+bool UnitTest::Avx2Supported() {
+	int info[4] = {};
+	__cpuidex(info, 7, 0);
+
+	return (info[1] & (1 << 5)) != 0;
+}
+
+Common::Debug::LogFile* UnitTest::Log() {
+	static Common::Debug::LogFile logFile;
+	static const BOOL initialized = Common::Debug::Logger::Initialize(&logFile, L"UnitTests.log");
+
+	return &logFile;
+}
+
+// Runs every registered test, or only the suites whose name starts with
+// the first argument. With --benchmark first, runs the benchmarks instead.
+// Returns non-zero when any check failed so that the post-build step fails
+// the build.
+int main(int argc, char* argv[]) {
+	const bool benchmark = argc > 1 && std::strcmp(argv[1], "--benchmark") == 0;
+	const int filterArg = benchmark ? 2 : 1;
+	const char* filter = argc > filterArg ? argv[filterArg] : nullptr;
+
+	unsigned runCount = 0;
+	unsigned failedCount = 0;
+
+	for (const auto& test : UnitTest::Registry()) {
+		if (test.Benchmark != benchmark) continue;
+		if (filter != nullptr && std::strncmp(test.Suite, filter, std::strlen(filter)) != 0) continue;
+
+		std::printf("[ RUN    ] %s.%s\n", test.Suite, test.Name);
+
+		const unsigned before = gFailureCount;
+		test.Func();
+		++runCount;
+
+		if (gFailureCount == before) {
+			std::printf("[     OK ] %s.%s\n", test.Suite, test.Name);
+		}
+		else {
+			std::printf("[ FAILED ] %s.%s\n", test.Suite, test.Name);
+			++failedCount;
+		}
+	}
+
+	std::printf("%u tests, %u failed\n", runCount, failedCount);
+
+	return failedCount == 0 ? 0 : 1;
+}
\ No newline at end of file
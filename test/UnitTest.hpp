@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace Common::Debug {
+	struct LogFile;
+}
+
+namespace Render::DX::Foundation::Core {
+	class Device;
+	class CommandObject;
+}
+
+namespace UnitTest {
+	using TestFunc = void(*)();
+
+	struct TestCase {
+		const char* Suite;
+		const char* Name;
+		TestFunc Func;
+		bool Benchmark;
+	};
+
+	std::vector<TestCase>& Registry();
+
+	// Appends a test to the registry during static initialization.
+	struct Registrar {
+		Registrar(const char* suite, const char* name, TestFunc func, bool benchmark = false);
+	};
+
+	void ReportFailure(const char* file, int line, const char* expr);
+
+	// Prints one timing line of a benchmark.
+	void ReportTime(const char* label, double milliseconds);
+
+	// Best of a few runs in milliseconds, so a run the scheduler interrupted
+	// does not skew the figure.
+	template <typename Func>
+	double MeasureMs(unsigned runs, Func&& func) {
+		double best = 0.0;
+		for (unsigned run = 0; run < runs; ++run) {
+			const auto Begin = std::chrono::steady_clock::now();
+			func();
+			const std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - Begin;
+
+			if (run == 0 || Elapsed.count() < best) best = Elapsed.count();
+		}
+		return best;
+	}
+
+	// Whether the CPU running the tests can take the AVX2 code paths.
+	bool Avx2Supported();
+
+	// Log shared by the code under test; written to UnitTests.log.
+	Common::Debug::LogFile* Log();
+
+	// Device on the first adapter that supports the renderer, shared by the
+	// tests that need the GPU, or on WARP when no adapter does. Null when
+	// neither works, so those tests skip.
+	Render::DX::Foundation::Core::Device* D3D12Device();
+	Render::DX::Foundation::Core::CommandObject* D3D12CommandObject();
+
+	// Submits what was queued on the direct list and waits for the GPU.
+	bool D3D12Submit();
+}
+
+#define TEST_CASE(suite, name)																	\
+	static void suite##_##name();																\
+	static UnitTest::Registrar suite##_##name##_Registrar(#suite, #name, suite##_##name);		\
+	static void suite##_##name()
+
+// Timed run that is skipped by default and only runs with --benchmark,
+// since it takes far longer than the post-build step should.
+#define BENCHMARK_CASE(suite, name)																\
+	static void suite##_##name();																\
+	static UnitTest::Registrar suite##_##name##_Registrar(#suite, #name, suite##_##name, true);	\
+	static void suite##_##name()
+
+// Records the failure and keeps running the test.
+#define CHECK(expr)																				\
+	do { if (!(expr)) UnitTest::ReportFailure(__FILE__, __LINE__, #expr); } while (0)
+
+// Records the failure and leaves the test, for preconditions the rest depends on.
+#define REQUIRE(expr)																			\
+	do { if (!(expr)) { UnitTest::ReportFailure(__FILE__, __LINE__, #expr); return; } } while (0)
+
+#define CHECK_NEAR(a, b, eps) CHECK(std::abs((a) - (b)) <= (eps))
\ No newline at end of file
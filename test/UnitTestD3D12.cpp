@@ -0,0 +1,78 @@
+#include "UnitTest.hpp"
+
+#include "Render/DX/Foundation/Core/pch_d3d12.h"
+#include "Common/Debug/Logger.hpp"
+#include "Render/DX/Foundation/Core/Factory.hpp"
+#include "Render/DX/Foundation/Core/Device.hpp"
+#include "Render/DX/Foundation/Core/CommandObject.hpp"
+#include "Render/DX/Foundation/Resource/GpuResource.hpp"
+
+using namespace Render::DX::Foundation;
+
+namespace {
+	const UINT WorkerCount = 4;
+
+	struct D3D12Context {
+		Core::Factory Factory{};
+		Core::Device Device{};
+		Core::CommandObject CommandObject{};
+		BOOL Valid{};
+
+		BOOL Initialize() {
+			const auto pLogFile = UnitTest::Log();
+
+			CheckReturn(pLogFile, Resource::GpuResource::Initialize(pLogFile));
+			CheckReturn(pLogFile, Factory.Initialize(pLogFile));
+			CheckReturn(pLogFile, Factory.SortAdapters());
+			CheckReturn(pLogFile, Device.Initialize(pLogFile));
+
+			std::vector<std::wstring> adapters{};
+			CheckReturn(pLogFile, Factory.GetAdapters(adapters));
+
+			BOOL selected = FALSE;
+			BOOL bRaytracing = FALSE;
+			for (UINT i = 0, end = static_cast<UINT>(adapters.size()); i < end && !selected; ++i)
+				selected = Factory.SelectAdapter(&Device, i, bRaytracing);
+			// WARP keeps the GPU tests running where no hardware adapter does.
+			if (!selected) selected = Factory.SelectWarpAdapter(&Device, bRaytracing);
+			if (!selected) ReturnFalse(pLogFile, L"Neither an adapter nor WARP supports the renderer; skipping GPU tests");
+
+			CheckReturn(pLogFile, CommandObject.Initialize(pLogFile, &Device, WorkerCount));
+
+			return TRUE;
+		}
+	};
+
+	D3D12Context* Context() {
+		// Never destroyed: a command object that failed half way through
+		// initialization cannot be cleaned up, and the process exit
+		// releases the device anyway.
+		static D3D12Context* const context = [] {
+			const auto ctx = new D3D12Context();
+			ctx->Valid = ctx->Initialize();
+			return ctx;
+		}();
+
+		return context->Valid ? context : nullptr;
+	}
+}
+
+Core::Device* UnitTest::D3D12Device() {
+	const auto context = Context();
+	return context == nullptr ? nullptr : &context->Device;
+}
+
+Core::CommandObject* UnitTest::D3D12CommandObject() {
+	const auto context = Context();
+	return context == nullptr ? nullptr : &context->CommandObject;
+}
+
+bool UnitTest::D3D12Submit() {
+	const auto cmdObject = D3D12CommandObject();
+	if (cmdObject == nullptr) return false;
+
+	return cmdObject->ResetCommandListAllocator()
+		&& cmdObject->ResetDirectCommandList()
+		&& cmdObject->ExecuteDirectCommandList()
+		&& cmdObject->FlushCommandQueue();
+}
\ No newline at end of file